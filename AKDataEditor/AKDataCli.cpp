@@ -0,0 +1,716 @@
+﻿// akdata: 편집기 없이 솔루션 데이터를 다루는 명령줄 도구 (AKDataCli 프로젝트, Win32/ImGui 없이 빌드)
+//
+//   akdata <명령> --solution <경로> [옵션]
+//     validate                          참조 무결성 검사 (오류가 있으면 1)
+//     migrate [--dry-run]               옛 버전 파일을 마이그레이션해 저장 (--dry-run 은 바뀔 값만 보고)
+//     stats                             테이블 열 / 레벨 분포
+//     query "<질의>"                     데이터 질의 (QueryEngine 문법)
+//     export <enemies|operators|skills|levels> [--out <파일>]
+//     diff <다른 솔루션>                  레코드 단위 비교 (다르면 1)
+//     sweep <레벨 id> <spec.json> [--seed <N>] [--out <보고서.jsonl>]
+//                                       섭동 몬테카를로 시뮬레이션 (PerturbationSpec, --out 은 배치별 누적 통계)
+//     bench [--repeat <N>] [--query "<질의>"]
+//   공통 옵션: --compact (한 줄 JSON)
+//
+// 결과는 stdout 에 JSON 하나, 로드 중 로그는 stderr
+// 종료 코드: 0 = 성공, 1 = 검사 실패 (무결성 오류 / 차이 있음 / 저장 실패 / 질의 오류), 2 = 사용법 또는 읽기 오류
+//
+// 읽기/마이그레이션/저장은 편집기와 같은 ReadDataFile / WriteDataFile 을 씀
+
+#include "BalanceSweep.h"
+#include "ContentHash.h"
+#include "DataFiles.h"
+#include "EnemyUsageIndex.h"
+#include "EnemyVariants.h"
+#include "GameTables.h"
+#include "IntegrityChecker.h"
+#include "LevelGrid.h"
+#include "Migration.h"
+#include "MigrationDryRun.h"
+#include "Parallel.h"
+#include "ProjectStats.h"
+#include "QueryEngine.h"
+#include "Utility.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	double MsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	struct CliArgs
+	{
+		std::string command;
+		std::string solution;
+		std::vector<std::string> positional;
+		std::string out;
+		std::string query;
+		int repeat = 3;
+		uint64_t seed = 0;
+		bool hasSeed = false;
+		bool dryRun = false;
+		bool compact = false;
+	};
+
+	// 결과 JSON 과 종료 코드
+	struct CliResult
+	{
+		json output;
+		int exitCode = 0;
+	};
+
+	CliResult Fail(int exitCode, const std::string& error)
+	{
+		CliResult result;
+		result.output["ok"] = false;
+		result.output["error"] = error;
+		result.exitCode = exitCode;
+		return result;
+	}
+
+	json DistributionToJson(const StatDistribution& d)
+	{
+		json out;
+		out["count"] = d.Count();
+		if (d.Count() == 0)
+			return out;
+
+		out["min"] = d.Min();
+		out["mean"] = d.Mean();
+		out["p50"] = d.Percentile(0.5);
+		out["p90"] = d.Percentile(0.9);
+		out["p99"] = d.Percentile(0.99);
+		out["max"] = d.Max();
+		return out;
+	}
+
+	json StatTableToJson(const RecordStatTable& table)
+	{
+		json out;
+		out["records"] = table.RecordCount();
+		out["columns"] = json::object();
+		for (int c = 0; c < table.ColumnCount(); ++c)
+			out["columns"][table.ColumnName(c)] = DistributionToJson(table.Column(c));
+		return out;
+	}
+
+	const json& RecordsOf(const json& table, const char* key)
+	{
+		static const json empty = json::array();
+		auto found = table.find(key);
+		return (found != table.end() && found->is_array()) ? *found : empty;
+	}
+
+	int64_t RecordCount(const QueryProject& project)
+	{
+		return (int64_t)RecordsOf(project.enemyTable, "enemies").size()
+			+ (int64_t)RecordsOf(project.operatorTable, "operators").size()
+			+ (int64_t)project.skills.size() + (int64_t)project.levels.size();
+	}
+
+	// ===== validate =====
+
+	json RunValidate(const QueryProject& project, int& errorCount)
+	{
+		auto start = Clock::now();
+
+		std::vector<const json*> levelData(project.levels.size());
+		std::vector<std::string> levelIds(project.levels.size());
+		IntegrityInput input;
+		input.enemies = &RecordsOf(project.enemyTable, "enemies");
+		input.enemyRevision = 1;
+		input.operators = &RecordsOf(project.operatorTable, "operators");
+		input.operatorRevision = 1;
+		input.skills = &project.skills;
+		input.skillRevision = 1;
+		input.levels.resize(project.levels.size());
+		for (size_t i = 0; i < project.levels.size(); ++i)
+		{
+			levelData[i] = &project.levels[i].data;
+			levelIds[i] = project.levels[i].levelId;
+			input.levels[i] = { levelIds[i], levelData[i], i + 1 };
+		}
+
+		EnemyUsageIndex usage;
+		usage.Build(levelData, levelIds);
+		input.usage = &usage;
+
+		IntegrityChecker checker;
+		checker.Update(input);
+
+		json out;
+		out["errors"] = checker.ErrorCount();
+		out["warnings"] = (int)checker.Issues().size() - checker.ErrorCount();
+		out["categories"] = json::object();
+		for (int c = 0; c < (int)IntegrityCategory::MAX; ++c)
+			out["categories"][IntegrityCategoryName((IntegrityCategory)c)] = checker.CategoryCount((IntegrityCategory)c);
+
+		out["issues"] = json::array();
+		for (const IntegrityIssue& issue : checker.Issues())
+		{
+			out["issues"].push_back({
+				{"severity", issue.severity == IntegritySeverity::Error ? "error" : "warning"},
+				{"category", IntegrityCategoryName(issue.category)},
+				{"source", issue.source}, {"location", issue.location}, {"message", issue.message} });
+		}
+		out["ms"] = MsSince(start);
+
+		errorCount = checker.ErrorCount();
+		return out;
+	}
+
+	// ===== stats =====
+
+	json RunStats(const QueryProject& project)
+	{
+		auto start = Clock::now();
+
+		// 편집기 GetStats 와 같은 값 (적 = value[0] 기본 변형, 오퍼레이터 = 마지막 정예화 최대 레벨)
+		const json& enemies = RecordsOf(project.enemyTable, "enemies");
+		EnemyVariantTable variants;
+		variants.Build(enemies);
+		std::vector<std::vector<double>> enemyRows(enemies.size());
+		ParallelFor(enemies.size(), 256, [&](size_t begin, size_t end, unsigned)
+			{
+				for (size_t i = begin; i < end; ++i)
+					enemyRows[i] = EnemyStatValues(variants.Get((int)i, 0));
+			});
+		RecordStatTable enemyStats(EnemyStatColumns());
+		enemyStats.Build(enemyRows);
+
+		const json& operators = RecordsOf(project.operatorTable, "operators");
+		std::vector<std::vector<double>> operatorRows(operators.size());
+		ParallelFor(operators.size(), 256, [&](size_t begin, size_t end, unsigned)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					OperatorStats stats;
+					bool valid = ParseOperatorStats(operators[i], stats);
+					operatorRows[i] = OperatorStatValues(valid ? &stats : nullptr);
+				}
+			});
+		RecordStatTable operatorStats(OperatorStatColumns());
+		operatorStats.Build(operatorRows);
+
+		std::vector<std::vector<double>> skillRows(project.skills.size());
+		ParallelFor(project.skills.size(), 256, [&](size_t begin, size_t end, unsigned)
+			{
+				for (size_t i = begin; i < end; ++i)
+					skillRows[i] = SkillStatValues(project.skills[i]);
+			});
+		RecordStatTable skillStats(SkillStatColumns());
+		skillStats.Build(skillRows);
+
+		std::vector<const json*> levelData(project.levels.size());
+		std::vector<uint64_t> revisions(project.levels.size());
+		for (size_t i = 0; i < project.levels.size(); ++i)
+		{
+			levelData[i] = &project.levels[i].data;
+			revisions[i] = i + 1;
+		}
+		LevelStatTable levelStats;
+		levelStats.Sync(levelData, revisions);
+
+		json out;
+		out["enemies"] = StatTableToJson(enemyStats);
+		out["operators"] = StatTableToJson(operatorStats);
+		out["skills"] = StatTableToJson(skillStats);
+		out["levels"] = {
+			{"levels", levelStats.LevelCount()},
+			{"spawns", DistributionToJson(levelStats.Spawns())},
+			{"durations", DistributionToJson(levelStats.Durations())},
+			{"waveCounts", DistributionToJson(levelStats.WaveCounts())},
+			{"waveDurations", DistributionToJson(levelStats.WaveDurations())} };
+		out["ms"] = MsSince(start);
+		return out;
+	}
+
+	// ===== query =====
+
+	json QueryResultToJson(const QueryResult& result)
+	{
+		json out;
+		out["columns"] = result.columns;
+		out["rows"] = json::array();
+		for (size_t r = 0; r < result.rowCount; ++r)
+		{
+			json row = json::array();
+			for (size_t c = 0; c < result.columns.size(); ++c)
+			{
+				double value = result.values[c][r];
+				if (result.isString[c])
+					row.push_back(result.CellText(r, c));
+				else if (std::isnan(value))
+					row.push_back(nullptr);
+				else
+					row.push_back(value);
+			}
+			out["rows"].push_back(std::move(row));
+		}
+
+		out["rowCount"] = result.rowCount;
+		out["plan"] = result.plan;
+		out["scannedRows"] = result.scannedRows;
+		out["matchedRows"] = result.matchedRows;
+		out["ms"] = { {"parse", result.parseMs}, {"extract", result.extractMs}, {"scan", result.scanMs},
+			{"finish", result.finishMs}, {"total", result.totalMs} };
+		return out;
+	}
+
+	// ===== migrate =====
+
+	// 편집기가 로드 직후 저장하는 것과 같은 출력 (테이블은 version + 레코드 배열)
+	json MakeTableOutput(const char* key, json records)
+	{
+		json output;
+		output["version"] = VERSION;
+		output[key] = std::move(records);
+		return output;
+	}
+
+	CliResult RunMigrate(const QueryProject& project)
+	{
+		auto start = Clock::now();
+
+		json migrated = json::array();
+		json failed = json::array();
+
+		// 오퍼레이터/스킬은 같은 범위 테이블을 다시 쓰므로 테이블은 차례로
+		auto writeTable = [&](bool needed, Migration::DataType type, const char* key, json records)
+			{
+				if (!needed)
+					return;
+				std::string path = DataFilePath(project.solutionPath, type);
+				std::string fileName = path.substr(path.find_last_of('/') + 1);
+				if (WriteDataFile(type, path, MakeTableOutput(key, std::move(records))))
+					migrated.push_back(fileName);
+				else
+					failed.push_back(fileName);
+			};
+		writeTable(project.enemyMigrated, Migration::DataType::Enemy, "enemies", RecordsOf(project.enemyTable, "enemies"));
+		writeTable(project.operatorMigrated, Migration::DataType::Operator, "operators", RecordsOf(project.operatorTable, "operators"));
+		writeTable(project.skillMigrated, Migration::DataType::Skill, "skills", json(project.skills));
+
+		// 레벨은 파일마다 독립이므로 병렬
+		std::string levelPath = DataFilePath(project.solutionPath, Migration::DataType::Level);
+		std::vector<uint8_t> written(project.levels.size(), 0);
+		ParallelFor(project.levels.size(), 4, [&](size_t begin, size_t end, unsigned)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					const QueryProject::Level& level = project.levels[i];
+					if (level.migrated)
+						written[i] = WriteDataFile(Migration::DataType::Level, levelPath + level.fileName, level.data) ? 1 : 2;
+				}
+			});
+		for (size_t i = 0; i < project.levels.size(); ++i)
+		{
+			if (written[i] == 1)
+				migrated.push_back(project.levels[i].fileName);
+			else if (written[i] == 2)
+				failed.push_back(project.levels[i].fileName);
+		}
+
+		CliResult result;
+		result.output["ok"] = failed.empty();
+		result.output["version"] = VERSION;
+		result.output["migrated"] = std::move(migrated);
+		result.output["failed"] = std::move(failed);
+		result.output["ms"] = MsSince(start);
+		result.exitCode = result.output["failed"].empty() ? 0 : 1;
+		return result;
+	}
+
+	// ===== export =====
+
+	CliResult RunExport(const QueryProject& project, const CliArgs& args)
+	{
+		if (args.positional.empty())
+			return Fail(2, "export 대상이 필요합니다 (enemies / operators / skills / levels)");
+
+		const std::string& target = args.positional[0];
+		json data;
+		if (target == "enemies")
+			data = RecordsOf(project.enemyTable, "enemies");
+		else if (target == "operators")
+			data = RecordsOf(project.operatorTable, "operators");
+		else if (target == "skills")
+			data = project.skills;
+		else if (target == "levels")
+		{
+			data = json::object();
+			for (const QueryProject::Level& level : project.levels)
+				data[level.levelId] = level.data;
+		}
+		else
+			return Fail(2, "알 수 없는 export 대상: " + target);
+
+		CliResult result;
+		if (args.out.empty())
+		{
+			result.output = std::move(data);
+			return result;
+		}
+
+		std::ofstream file(args.out);
+		if (!file.is_open())
+			return Fail(1, "파일을 쓸 수 없습니다: " + args.out);
+		file << data.dump(2);
+
+		result.output["ok"] = true;
+		result.output["target"] = target;
+		result.output["records"] = data.size();
+		result.output["out"] = args.out;
+		return result;
+	}
+
+	// ===== diff =====
+
+	// 레코드 키 + 내용 해시 (편집기의 저장 안 됨 요약과 같은 RecordHashTable 로 비교)
+	void HashRecords(const json& records, const char* keyField, std::vector<std::string>& keys, std::vector<uint64_t>& hashes)
+	{
+		keys.assign(records.size(), std::string());
+		hashes.assign(records.size(), 0);
+		ParallelFor(records.size(), 256, [&](size_t begin, size_t end, unsigned)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					keys[i] = records[i].value(keyField, "");
+					hashes[i] = HashJson(records[i]);
+				}
+			});
+	}
+
+	json DiffRecords(const json& before, const json& after, const char* keyField, int& changes)
+	{
+		std::vector<std::string> keys;
+		std::vector<uint64_t> hashes;
+
+		RecordHashTable table;
+		HashRecords(before, keyField, keys, hashes);
+		table.Build(std::move(keys), std::move(hashes));
+		table.MarkSaved();
+		HashRecords(after, keyField, keys, hashes);
+		table.Build(std::move(keys), std::move(hashes));
+
+		RecordChangeSummary summary = table.Diff();
+		changes += summary.Count();
+		return { {"changed", summary.changed}, {"added", summary.added}, {"removed", summary.removed} };
+	}
+
+	json LevelRecords(const QueryProject& project)
+	{
+		json records = json::array();
+		for (const QueryProject::Level& level : project.levels)
+			records.push_back({ {"levelId", level.levelId}, {"data", level.data} });
+		return records;
+	}
+
+	CliResult RunDiff(const QueryProject& project, const CliArgs& args)
+	{
+		if (args.positional.empty())
+			return Fail(2, "비교할 솔루션 경로가 필요합니다");
+
+		auto start = Clock::now();
+		QueryProject other;
+		std::string error;
+		if (!other.Load(args.positional[0], error))
+			return Fail(2, error);
+		double loadMs = MsSince(start);
+
+		int changes = 0;
+		CliResult result;
+		result.output["ok"] = true;
+		result.output["from"] = project.solutionPath;
+		result.output["to"] = other.solutionPath;
+		result.output["enemies"] = DiffRecords(RecordsOf(project.enemyTable, "enemies"), RecordsOf(other.enemyTable, "enemies"), "key", changes);
+		result.output["operators"] = DiffRecords(RecordsOf(project.operatorTable, "operators"), RecordsOf(other.operatorTable, "operators"), "charId", changes);
+		result.output["skills"] = DiffRecords(json(project.skills), json(other.skills), "skillId", changes);
+		result.output["levels"] = DiffRecords(LevelRecords(project), LevelRecords(other), "levelId", changes);
+		result.output["changes"] = changes;
+		result.output["identical"] = changes == 0;
+		result.output["ms"] = { {"loadOther", loadMs}, {"total", MsSince(start)} };
+		result.exitCode = changes == 0 ? 0 : 1;
+		return result;
+	}
+
+	// ===== sweep =====
+
+	CliResult RunSweep(const QueryProject& project, const CliArgs& args)
+	{
+		if (args.positional.size() < 2)
+			return Fail(2, "레벨 id 와 섭동 설정 파일이 필요합니다 (sweep <레벨 id> <spec.json>)");
+
+		const std::string& levelId = args.positional[0];
+		auto level = std::find_if(project.levels.begin(), project.levels.end(),
+			[&](const QueryProject::Level& l) { return l.levelId == levelId; });
+		if (level == project.levels.end())
+			return Fail(2, "레벨 없음: " + levelId);
+
+		LevelGrid grid;
+		if (!BuildLevelGrid(level->data, grid))
+			return Fail(2, "레벨 맵/경로가 불완전합니다: " + levelId);
+
+		json specData;
+		if (!LoadJsonFile(args.positional[1], specData))
+			return Fail(2, "섭동 설정을 읽을 수 없습니다: " + args.positional[1]);
+
+		PerturbationSpec spec;
+		if (!ParsePerturbationSpec(specData, spec))
+			return Fail(2, "잘못된 섭동 설정: " + args.positional[1]);
+		if (args.hasSeed)
+			spec.seed = args.seed;
+
+		// 편집기 레벨 시뮬레이션과 같은 스탯 (적은 기본 변형)
+		EnemyVariantTable variants;
+		if (project.enemyTable.contains("enemies"))
+			variants.Build(project.enemyTable["enemies"]);
+
+		BattleSimulator simulator(grid, variants.Snapshot(), ParseOperatorTable(project.operatorTable));
+
+		auto start = Clock::now();
+		SweepReport report = BalanceSweep(simulator).Run(spec, args.out);
+
+		CliResult result;
+		result.output = report.ToJson();
+		result.output["ok"] = true;
+		result.output["levelId"] = levelId;
+		result.output["seed"] = spec.seed;
+		result.output["sweepMs"] = MsSince(start);
+		return result;
+	}
+
+	// ===== bench =====
+
+	json Timing(const std::vector<double>& samples)
+	{
+		double sum = 0.0;
+		double best = samples.empty() ? 0.0 : samples[0];
+		for (double ms : samples)
+		{
+			sum += ms;
+			best = std::min(best, ms);
+		}
+		return { {"min", best}, {"mean", samples.empty() ? 0.0 : sum / samples.size()} };
+	}
+
+	CliResult RunBench(const CliArgs& args)
+	{
+		std::string query = args.query.empty()
+			? "from actions group by levelId select levelId, sum(count) as spawns order by spawns desc"
+			: args.query;
+
+		std::vector<double> loadMs, validateMs, statsMs, queryMs, dryRunMs;
+		int64_t records = 0;
+		for (int r = 0; r < std::max(1, args.repeat); ++r)
+		{
+			auto start = Clock::now();
+			QueryProject project;
+			std::string error;
+			if (!project.Load(args.solution, error))
+				return Fail(2, error);
+			loadMs.push_back(MsSince(start));
+			records = RecordCount(project);
+
+			int errorCount = 0;
+			start = Clock::now();
+			RunValidate(project, errorCount);
+			validateMs.push_back(MsSince(start));
+
+			start = Clock::now();
+			RunStats(project);
+			statsMs.push_back(MsSince(start));
+
+			// 매번 새 엔진 (열 캐시 없이)
+			start = Clock::now();
+			QueryEngine engine;
+			QueryResult result = engine.Run(project.MakeInput(), query);
+			if (!result.ok)
+				return Fail(1, "질의 오류: " + result.error);
+			queryMs.push_back(MsSince(start));
+
+			start = Clock::now();
+			RunMigrationDryRun(args.solution);
+			dryRunMs.push_back(MsSince(start));
+		}
+
+		CliResult result;
+		result.output["ok"] = true;
+		result.output["workers"] = GetWorkerCount();
+		result.output["repeat"] = (int)loadMs.size();
+		result.output["records"] = records;
+		result.output["query"] = query;
+		result.output["ms"] = {
+			{"load", Timing(loadMs)}, {"validate", Timing(validateMs)}, {"stats", Timing(statsMs)},
+			{"query", Timing(queryMs)}, {"migrateDryRun", Timing(dryRunMs)} };
+
+		double bestLoad = result.output["ms"]["load"]["min"].get<double>();
+		result.output["loadRecordsPerSecond"] = bestLoad > 0.0 ? records * 1000.0 / bestLoad : 0.0;
+		return result;
+	}
+
+	// ===== 명령 나누기 =====
+
+	bool ParseArgs(int argc, char** argv, CliArgs& args, std::string& error)
+	{
+		if (argc < 2)
+		{
+			error = "명령이 필요합니다 (validate / migrate / stats / query / export / diff / sweep / bench)";
+			return false;
+		}
+
+		args.command = argv[1];
+		for (int i = 2; i < argc; ++i)
+		{
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+			if (arg == "--solution" && hasValue)
+				args.solution = argv[++i];
+			else if (arg == "--out" && hasValue)
+				args.out = argv[++i];
+			else if (arg == "--query" && hasValue)
+				args.query = argv[++i];
+			else if (arg == "--repeat" && hasValue)
+				args.repeat = std::atoi(argv[++i]);
+			else if (arg == "--seed" && hasValue)
+			{
+				args.seed = std::strtoull(argv[++i], nullptr, 10);
+				args.hasSeed = true;
+			}
+			else if (arg == "--dry-run")
+				args.dryRun = true;
+			else if (arg == "--compact")
+				args.compact = true;
+			else if (arg.starts_with("--"))
+			{
+				error = "알 수 없는 옵션: " + arg;
+				return false;
+			}
+			else
+				args.positional.push_back(arg);
+		}
+
+		if (args.solution.empty())
+		{
+			error = "--solution <경로> 가 필요합니다";
+			return false;
+		}
+		return true;
+	}
+
+	CliResult RunCommand(const CliArgs& args)
+	{
+		auto start = Clock::now();
+
+		// 미리보기는 파일을 직접 읽음 (읽으면서 마이그레이션하지 않음)
+		if (args.command == "migrate" && args.dryRun)
+		{
+			MigrationDryRunReport report = RunMigrationDryRun(args.solution);
+			CliResult result;
+			result.output = report.ToJson();
+			result.output["ok"] = report.failed == 0;
+			result.exitCode = report.failed == 0 ? 0 : 1;
+			return result;
+		}
+		if (args.command == "bench")
+			return RunBench(args);
+
+		static const char* commands[] = { "validate", "migrate", "stats", "query", "export", "diff", "sweep" };
+		if (std::find(std::begin(commands), std::end(commands), args.command) == std::end(commands))
+			return Fail(2, "알 수 없는 명령: " + args.command);
+
+		QueryProject project;
+		std::string error;
+		if (!project.Load(args.solution, error))
+			return Fail(2, error);
+		double loadMs = MsSince(start);
+
+		CliResult result;
+		if (args.command == "validate")
+		{
+			int errorCount = 0;
+			result.output = RunValidate(project, errorCount);
+			result.output["ok"] = errorCount == 0;
+			result.exitCode = errorCount == 0 ? 0 : 1;
+		}
+		else if (args.command == "migrate")
+		{
+			result = RunMigrate(project);
+		}
+		else if (args.command == "stats")
+		{
+			result.output = RunStats(project);
+			result.output["ok"] = true;
+		}
+		else if (args.command == "query")
+		{
+			std::string query = !args.query.empty() ? args.query : (args.positional.empty() ? "" : args.positional[0]);
+			if (query.empty())
+				return Fail(2, "질의가 필요합니다");
+
+			QueryEngine engine;
+			QueryResult queryResult = engine.Run(project.MakeInput(), query);
+			if (!queryResult.ok)
+				return Fail(1, queryResult.error);
+			result.output = QueryResultToJson(queryResult);
+			result.output["ok"] = true;
+		}
+		else if (args.command == "export")
+		{
+			return RunExport(project, args);
+		}
+		else if (args.command == "sweep")
+		{
+			result = RunSweep(project, args);
+		}
+		else
+		{
+			result = RunDiff(project, args);
+		}
+
+		result.output["loadMs"] = loadMs;
+		return result;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	// 로드 중 로그가 결과 JSON 에 섞이지 않도록 결과만 원래 stdout 으로
+	std::streambuf* stdoutBuffer = std::cout.rdbuf(std::cerr.rdbuf());
+	std::ostream output(stdoutBuffer);
+
+	CliArgs args;
+	std::string error;
+	CliResult result;
+	if (!ParseArgs(argc, argv, args, error))
+	{
+		result = Fail(2, error);
+	}
+	else
+	{
+		RegisterAllMigrations();
+		try
+		{
+			result = RunCommand(args);
+		}
+		catch (const std::exception& e)
+		{
+			result = Fail(2, e.what());
+		}
+	}
+
+	output << result.output.dump(args.compact ? -1 : 2) << "\n";
+	output.flush();
+	std::cout.rdbuf(stdoutBuffer);
+	return result.exitCode;
+}
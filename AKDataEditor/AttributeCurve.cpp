@@ -0,0 +1,332 @@
+﻿#include "AttributeCurve.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ATTRIBUTE_CURVE_SSE 1
+#endif
+
+namespace
+{
+	constexpr int SIMD_WIDTH = 4;
+
+	const char* FIELD_KEYS[ATTRIBUTE_FIELD_COUNT] = {
+		"maxHp", "atk", "def", "magicResistance", "cost", "blockCnt", "baseAttackTime", "respawnTime"
+	};
+
+	double RoundIfInteger(AttributeField field, double value)
+	{
+		return IsIntegerAttribute(field) ? std::nearbyint(value) : value;
+	}
+}
+
+const char* AttributeFieldKey(AttributeField field)
+{
+	return FIELD_KEYS[(int)field];
+}
+
+bool IsIntegerAttribute(AttributeField field)
+{
+	return field != AttributeField::MagicResistance && field != AttributeField::BaseAttackTime;
+}
+
+AttributeBlock AttributeBlock::FromJson(const json& data)
+{
+	AttributeBlock block;
+	for (int f = 0; f < ATTRIBUTE_FIELD_COUNT; ++f)
+	{
+		if (data.contains(FIELD_KEYS[f]) && data[FIELD_KEYS[f]].is_number())
+			block.values[f] = data[FIELD_KEYS[f]].get<double>();
+	}
+	return block;
+}
+
+void AttributeBlock::WriteJson(json& data) const
+{
+	for (int f = 0; f < ATTRIBUTE_FIELD_COUNT; ++f)
+	{
+		if (IsIntegerAttribute((AttributeField)f))
+			data[FIELD_KEYS[f]] = (int)std::lround(values[f]);
+		else
+			data[FIELD_KEYS[f]] = values[f];
+	}
+}
+
+AttributeBlock OperatorPhase::Evaluate(int level) const
+{
+	if (keyFrames.empty())
+		return AttributeBlock();
+
+	if (level <= keyFrames.front().level)
+		return keyFrames.front().data;
+	if (level >= keyFrames.back().level)
+		return keyFrames.back().data;
+
+	size_t hi = 1;
+	while (hi < keyFrames.size() && keyFrames[hi].level < level)
+		++hi;
+
+	const AttributeKeyFrame& a = keyFrames[hi - 1];
+	const AttributeKeyFrame& b = keyFrames[hi];
+	double t = (b.level > a.level) ? (double)(level - a.level) / (b.level - a.level) : 0.0;
+
+	AttributeBlock out;
+	for (int f = 0; f < ATTRIBUTE_FIELD_COUNT; ++f)
+		out.values[f] = RoundIfInteger((AttributeField)f, a.data.values[f] + (b.data.values[f] - a.data.values[f]) * t);
+	return out;
+}
+
+bool OperatorAttributeCurve::FromJson(const json& op, OperatorAttributeCurve& out)
+{
+	out.charId = op.value("charId", "");
+	out.phases.clear();
+
+	if (!op.contains("phases") || !op["phases"].is_array())
+		return false;
+
+	for (const auto& phaseData : op["phases"])
+	{
+		OperatorPhase phase;
+		if (phaseData.contains("attributesKeyFrames"))
+		{
+			for (const auto& keyFrame : phaseData["attributesKeyFrames"])
+			{
+				AttributeKeyFrame frame;
+				frame.level = keyFrame.value("level", 1);
+				frame.data = AttributeBlock::FromJson(keyFrame.value("data", json::object()));
+				phase.keyFrames.push_back(frame);
+			}
+		}
+
+		std::stable_sort(phase.keyFrames.begin(), phase.keyFrames.end(),
+			[](const AttributeKeyFrame& a, const AttributeKeyFrame& b) { return a.level < b.level; });
+
+		int lastLevel = phase.keyFrames.empty() ? 1 : phase.keyFrames.back().level;
+		phase.maxLevel = phaseData.value("maxLevel", lastLevel);
+		out.phases.push_back(std::move(phase));
+	}
+
+	return !out.phases.empty();
+}
+
+int OperatorAttributeCurve::LastPhase() const
+{
+	for (int p = (int)phases.size() - 1; p >= 0; --p)
+	{
+		if (!phases[p].keyFrames.empty())
+			return p;
+	}
+	return -1;
+}
+
+bool OperatorAttributeCurve::Evaluate(int phase, int level, AttributeBlock& out) const
+{
+	if (phase == LAST_PHASE)
+		phase = LastPhase();
+	if (!HasPhase(phase))
+		return false;
+
+	const OperatorPhase& selected = phases[phase];
+	out = selected.Evaluate(level == MAX_LEVEL ? selected.keyFrames.back().level : level);
+	return true;
+}
+
+std::vector<OperatorAttributeCurve> ParseOperatorCurves(const json& operators)
+{
+	std::vector<OperatorAttributeCurve> curves;
+	if (!operators.is_array())
+		return curves;
+
+	curves.resize(operators.size());
+	for (size_t i = 0; i < operators.size(); ++i)
+		OperatorAttributeCurve::FromJson(operators[i], curves[i]);
+	return curves;
+}
+
+void AttributeCurveTable::ResizePhase(PhaseColumns& columns) const
+{
+	columns.baseLevel.assign(_stride, 0.0f);
+	columns.maxLevel.assign(_stride, 0.0f);
+	columns.invSpan.assign(_stride, 0.0f);
+	for (int f = 0; f < ATTRIBUTE_FIELD_COUNT; ++f)
+	{
+		columns.base[f].assign(_stride, 0.0f);
+		columns.delta[f].assign(_stride, 0.0f);
+	}
+	columns.available.assign(_stride, 0);
+	columns.multiSegment.clear();
+}
+
+void AttributeCurveTable::Build(const std::vector<OperatorAttributeCurve>& curves)
+{
+	_curves = curves;
+	_stride = (int)((_curves.size() + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH);
+
+	size_t phaseCount = 0;
+	for (const auto& curve : _curves)
+		phaseCount = std::max(phaseCount, curve.phases.size());
+
+	_phases.assign(phaseCount, PhaseColumns());
+	for (auto& columns : _phases)
+		ResizePhase(columns);
+
+	for (int i = 0; i < (int)_curves.size(); ++i)
+		WriteOperator(i);
+}
+
+void AttributeCurveTable::UpdateOperator(int index, const OperatorAttributeCurve& curve)
+{
+	if (index < 0 || index >= (int)_curves.size())
+		return;
+
+	// 정예화 단계 수가 늘어나면 열을 새로 만들어야 하므로 전체 재구성
+	if (curve.phases.size() > _phases.size())
+	{
+		std::vector<OperatorAttributeCurve> curves = std::move(_curves);
+		curves[index] = curve;
+		Build(curves);
+		return;
+	}
+
+	for (auto& columns : _phases)
+	{
+		auto it = std::find(columns.multiSegment.begin(), columns.multiSegment.end(), index);
+		if (it != columns.multiSegment.end())
+			columns.multiSegment.erase(it);
+	}
+
+	_curves[index] = curve;
+	WriteOperator(index);
+}
+
+void AttributeCurveTable::WriteOperator(int index)
+{
+	const OperatorAttributeCurve& curve = _curves[index];
+
+	for (int p = 0; p < (int)_phases.size(); ++p)
+	{
+		PhaseColumns& columns = _phases[p];
+		if (!curve.HasPhase(p))
+		{
+			columns.available[index] = 0;
+			columns.baseLevel[index] = columns.maxLevel[index] = columns.invSpan[index] = 0.0f;
+			for (int f = 0; f < ATTRIBUTE_FIELD_COUNT; ++f)
+				columns.base[f][index] = columns.delta[f][index] = 0.0f;
+			continue;
+		}
+
+		const auto& keyFrames = curve.phases[p].keyFrames;
+		const AttributeKeyFrame& first = keyFrames.front();
+		const AttributeKeyFrame& last = keyFrames.back();
+
+		columns.available[index] = 1;
+		columns.baseLevel[index] = (float)first.level;
+		columns.maxLevel[index] = (float)last.level;
+		columns.invSpan[index] = (last.level > first.level) ? 1.0f / (float)(last.level - first.level) : 0.0f;
+		for (int f = 0; f < ATTRIBUTE_FIELD_COUNT; ++f)
+		{
+			columns.base[f][index] = (float)first.data.values[f];
+			columns.delta[f][index] = (float)(last.data.values[f] - first.data.values[f]);
+		}
+
+		if (keyFrames.size() > 2)
+			columns.multiSegment.push_back(index);
+	}
+}
+
+void AttributeCurveTable::Evaluate(int phase, int level, AttributeBatchResult& out) const
+{
+	const int count = (int)_curves.size();
+	out.count = count;
+	for (auto& column : out.columns)
+		column.resize(_stride);
+	out.available.assign(count, 0);
+
+	if (phase == LAST_PHASE)
+	{
+		EvaluateLastPhase(level, out);
+		return;
+	}
+
+	if (phase < 0 || phase >= (int)_phases.size())
+	{
+		for (auto& column : out.columns)
+			std::fill(column.begin(), column.end(), 0.0f);
+		return;
+	}
+
+	const PhaseColumns& columns = _phases[phase];
+	std::copy(columns.available.begin(), columns.available.begin() + count, out.available.begin());
+
+	// 오퍼레이터 2,000명 × 8열 정도는 한 코어로 수 마이크로초라 스레드를 나누지 않음
+	// (MAX_LEVEL 은 어떤 키프레임 레벨보다 크게 잡아 t = 1, 즉 마지막 키프레임)
+	const float fLevel = (level == MAX_LEVEL) ? std::numeric_limits<float>::max() : (float)level;
+
+#ifdef ATTRIBUTE_CURVE_SSE
+	const __m128 vLevel = _mm_set1_ps(fLevel);
+	const __m128 vZero = _mm_setzero_ps();
+	const __m128 vOne = _mm_set1_ps(1.0f);
+
+	for (int i = 0; i < _stride; i += SIMD_WIDTH)
+	{
+		// t = clamp((level - baseLevel) / span, 0, 1)
+		__m128 t = _mm_mul_ps(_mm_sub_ps(vLevel, _mm_loadu_ps(&columns.baseLevel[i])), _mm_loadu_ps(&columns.invSpan[i]));
+		t = _mm_min_ps(_mm_max_ps(t, vZero), vOne);
+
+		for (int f = 0; f < ATTRIBUTE_FIELD_COUNT; ++f)
+		{
+			__m128 value = _mm_add_ps(_mm_loadu_ps(&columns.base[f][i]), _mm_mul_ps(_mm_loadu_ps(&columns.delta[f][i]), t));
+			if (IsIntegerAttribute((AttributeField)f))
+				value = _mm_cvtepi32_ps(_mm_cvtps_epi32(value));	// 가장 가까운 정수
+			_mm_storeu_ps(&out.columns[f][i], value);
+		}
+	}
+#else
+	std::vector<float> t(_stride);
+	for (int i = 0; i < _stride; ++i)
+		t[i] = std::clamp((fLevel - columns.baseLevel[i]) * columns.invSpan[i], 0.0f, 1.0f);
+
+	for (int f = 0; f < ATTRIBUTE_FIELD_COUNT; ++f)
+	{
+		const bool integer = IsIntegerAttribute((AttributeField)f);
+		const float* base = columns.base[f].data();
+		const float* delta = columns.delta[f].data();
+		float* dst = out.columns[f].data();
+		for (int i = 0; i < _stride; ++i)
+		{
+			float value = base[i] + delta[i] * t[i];
+			dst[i] = integer ? std::nearbyint(value) : value;
+		}
+	}
+#endif
+
+	// 중간 키프레임이 있는 단계는 구간을 찾아 다시 계산 (최대 레벨은 이미 마지막 키프레임)
+	for (int index : columns.multiSegment)
+	{
+		if (level == MAX_LEVEL)
+			break;
+
+		AttributeBlock block = _curves[index].phases[phase].Evaluate(level);
+		for (int f = 0; f < ATTRIBUTE_FIELD_COUNT; ++f)
+			out.columns[f][index] = (float)block.values[f];
+	}
+}
+
+void AttributeCurveTable::EvaluateLastPhase(int level, AttributeBatchResult& out) const
+{
+	for (auto& column : out.columns)
+		std::fill(column.begin(), column.end(), 0.0f);
+
+	for (int i = 0; i < (int)_curves.size(); ++i)
+	{
+		AttributeBlock block;
+		if (!_curves[i].Evaluate(LAST_PHASE, level, block))
+			continue;
+
+		out.available[i] = 1;
+		for (int f = 0; f < ATTRIBUTE_FIELD_COUNT; ++f)
+			out.columns[f][i] = (float)block.values[f];
+	}
+}
@@ -0,0 +1,118 @@
+﻿#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GameTables.h"
+
+// attributesKeyFrames[].data 의 필드 (열 순서 = 배치 결과 열 순서)
+enum class AttributeField
+{
+	MaxHp = 0,
+	Atk,
+	Def,
+	MagicResistance,
+	Cost,
+	BlockCnt,
+	BaseAttackTime,
+	RespawnTime,
+	COUNT
+};
+
+constexpr int ATTRIBUTE_FIELD_COUNT = (int)AttributeField::COUNT;
+
+const char* AttributeFieldKey(AttributeField field);	// JSON 키 (maxHp, atk, ...)
+bool IsIntegerAttribute(AttributeField field);			// 보간 후 반올림하는 필드
+
+// 한 키프레임의 스탯 묶음
+struct AttributeBlock
+{
+	std::array<double, ATTRIBUTE_FIELD_COUNT> values{};
+
+	double& operator[](AttributeField field) { return values[(int)field]; }
+	double operator[](AttributeField field) const { return values[(int)field]; }
+
+	static AttributeBlock FromJson(const json& data);
+	void WriteJson(json& data) const;
+};
+
+struct AttributeKeyFrame
+{
+	int level = 1;
+	AttributeBlock data;
+};
+
+// 정예화 단계 하나 (키프레임은 level 오름차순)
+struct OperatorPhase
+{
+	int maxLevel = 1;
+	std::vector<AttributeKeyFrame> keyFrames;
+
+	// 키프레임 사이는 선형 보간, 범위 밖은 양 끝 키프레임으로 고정
+	AttributeBlock Evaluate(int level) const;
+};
+
+// operators_table.json 의 phases[] 전체
+struct OperatorAttributeCurve
+{
+	std::string charId;
+	std::vector<OperatorPhase> phases;		// index = 정예화 단계
+
+	static bool FromJson(const json& op, OperatorAttributeCurve& out);
+
+	bool HasPhase(int phase) const { return phase >= 0 && phase < (int)phases.size() && !phases[phase].keyFrames.empty(); }
+	int LastPhase() const;		// 키프레임이 있는 마지막 단계 (없으면 -1)
+
+	// phase = LAST_PHASE 이면 마지막 단계, level = MAX_LEVEL 이면 그 단계의 마지막 키프레임 레벨
+	bool Evaluate(int phase, int level, AttributeBlock& out) const;
+};
+
+// 배치 평가 결과 (필드별 열, 오퍼레이터 순서 = 테이블 순서)
+struct AttributeBatchResult
+{
+	int count = 0;
+	std::array<std::vector<float>, ATTRIBUTE_FIELD_COUNT> columns;
+	std::vector<uint8_t> available;			// 해당 정예화 단계가 없으면 0
+
+	float Get(int index, AttributeField field) const { return columns[(int)field][index]; }
+};
+
+// 정예화 단계마다 (첫 키프레임, 마지막 키프레임) 을 SoA 열로 펼쳐 두고
+// 모든 오퍼레이터를 한 (phase, level) 에서 한 번에 평가
+// 키프레임이 셋 이상인 단계만 스칼라 경로로 따로 평가
+class AttributeCurveTable
+{
+public:
+	void Build(const std::vector<OperatorAttributeCurve>& curves);
+	void UpdateOperator(int index, const OperatorAttributeCurve& curve);
+
+	// phase = LAST_PHASE 이면 오퍼레이터마다 자기 마지막 단계 (level = MAX_LEVEL 이면 각자의 최대 레벨)
+	void Evaluate(int phase, int level, AttributeBatchResult& out) const;
+
+	int Count() const { return (int)_curves.size(); }
+	int MaxPhaseCount() const { return (int)_phases.size(); }
+
+private:
+	struct PhaseColumns
+	{
+		std::vector<float> baseLevel;		// 첫 키프레임 level
+		std::vector<float> maxLevel;		// 마지막 키프레임 level (레벨 상한)
+		std::vector<float> invSpan;			// 1 / (maxLevel - baseLevel), 같으면 0
+		std::array<std::vector<float>, ATTRIBUTE_FIELD_COUNT> base;
+		std::array<std::vector<float>, ATTRIBUTE_FIELD_COUNT> delta;	// 마지막 - 첫
+		std::vector<uint8_t> available;
+		std::vector<int> multiSegment;		// 키프레임이 셋 이상인 오퍼레이터
+	};
+
+	std::vector<OperatorAttributeCurve> _curves;
+	std::vector<PhaseColumns> _phases;
+	int _stride = 0;						// SIMD 폭으로 올림한 오퍼레이터 수
+
+	void ResizePhase(PhaseColumns& columns) const;
+	void EvaluateLastPhase(int level, AttributeBatchResult& out) const;
+	void WriteOperator(int index);
+};
+
+// operators 배열 전체 파싱 (형식이 잘못된 항목은 빈 곡선)
+std::vector<OperatorAttributeCurve> ParseOperatorCurves(const json& operators);
@@ -0,0 +1,184 @@
+﻿#include "BalanceOutlierWindow.h"
+#include "EnemyEditor.h"
+#include "OperatorEditor.h"
+#include <algorithm>
+#include <cmath>
+#include <imgui/imgui.h>
+
+#include "Utility.h"
+
+void BalanceOutlierWindow::RenderGUI(bool* p_open, EnemyEditor& enemyEditor, OperatorEditor& operatorEditor)
+{
+	if (_configDirty)
+	{
+		enemyEditor.SetOutlierConfig(_config);
+		operatorEditor.SetOutlierConfig(_config);
+		_configDirty = false;
+		_enemyRevision = 0;
+	}
+
+	if (enemyEditor.GetRevision() != _enemyRevision || operatorEditor.GetRevision() != _operatorRevision)
+		Refresh(enemyEditor, operatorEditor);
+
+	ImGui::SetNextWindowSize(ImVec2(900, 500), ImGuiCond_FirstUseEver);
+	ImGui::Begin("밸런스 이상치", p_open);
+
+	ImGui::SetNextItemWidth(120);
+	_configDirty |= ImGui::SliderFloat("z 임계값", &_config.zThreshold, 2.0f, 10.0f, "%.1f");
+	ImGui::SameLine();
+	ImGui::SetNextItemWidth(120);
+	_configDirty |= ImGui::SliderFloat("이웃 거리 임계값", &_config.nnThreshold, 0.0f, 10.0f, "%.1f");
+	ImGui::SameLine();
+	ImGui::SetNextItemWidth(120);
+	_configDirty |= ImGui::SliderInt("최소 그룹 크기", &_config.minGroupSize, 2, 20);
+
+	ImGui::TextColored(COLOR_GRAY, "그룹 = 적: 지상/비행 x 근거리/원거리, 오퍼레이터: 직군 x 레어도 (스탯은 로그 스케일, 중앙값/MAD 기준)");
+	ImGui::Text("적 %d / %d, 오퍼레이터 %d / %d 표시됨", _enemyCount, enemyEditor.GetOutliers().Count(), _operatorCount, operatorEditor.GetOutliers().Count());
+
+	ImGui::SameLine();
+	if (ImGui::SmallButton("보고서 복사 (JSON)"))
+		ImGui::SetClipboardText(BuildReport().c_str());
+
+	ImGui::Separator();
+
+	if (_rows.empty())
+	{
+		ImGui::TextColored(COLOR_GREEN, "이상치 없음");
+		ImGui::End();
+		return;
+	}
+
+	ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+	if (ImGui::BeginTable("OutlierTable", 9, flags))
+	{
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("종류");
+		ImGui::TableSetupColumn("ID");
+		ImGui::TableSetupColumn("그룹");
+		ImGui::TableSetupColumn("스탯");
+		ImGui::TableSetupColumn("값");
+		ImGui::TableSetupColumn("그룹 중앙값");
+		ImGui::TableSetupColumn("z");
+		ImGui::TableSetupColumn("이웃 거리");
+		ImGui::TableSetupColumn("가장 가까운 항목");
+		ImGui::TableHeadersRow();
+
+		ImGuiListClipper clipper;
+		clipper.Begin((int)_rows.size());
+		while (clipper.Step())
+		{
+			for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+			{
+				const Row& row = _rows[i];
+
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", row.isEnemy ? "적" : "오퍼레이터");
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", row.id.c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", row.group.c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", row.column);
+				ImGui::TableNextColumn();
+				ImGui::TextColored(COLOR_YELLOW, "%.2f", row.result.value);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", row.result.groupMedian);
+				ImGui::TableNextColumn();
+				ImGui::Text("%+.1f", row.result.zScore);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", row.result.nnDistance);
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", row.nearestId.c_str());
+			}
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
+void BalanceOutlierWindow::Refresh(EnemyEditor& enemyEditor, OperatorEditor& operatorEditor)
+{
+	_rows.clear();
+
+	const OutlierDetector& enemies = enemyEditor.GetOutliers();
+	const json& enemyList = enemyEditor.GetEnemyData()["enemies"];
+	auto enemyId = [&](int index)
+		{
+			return (index >= 0) ? enemyList[index].value("key", std::string()) : std::string();
+		};
+
+	std::vector<int> flagged = enemies.Flagged();
+	_enemyCount = (int)flagged.size();
+	for (int index : flagged)
+	{
+		Row row;
+		row.isEnemy = true;
+		row.index = index;
+		row.result = enemies.Result(index);
+		row.id = enemyId(index);
+		row.nearestId = enemyId(row.result.nearest);
+		row.group = enemies.GroupName(row.result.group);
+		row.column = EnemyOutlierColumn(row.result.column);
+		_rows.push_back(std::move(row));
+	}
+
+	const OutlierDetector& operators = operatorEditor.GetOutliers();
+	const json& operatorList = operatorEditor.GetOperatorData()["operators"];
+	auto operatorId = [&](int index)
+		{
+			return (index >= 0) ? operatorList[index].value("charId", std::string()) : std::string();
+		};
+
+	flagged = operators.Flagged();
+	_operatorCount = (int)flagged.size();
+	for (int index : flagged)
+	{
+		Row row;
+		row.isEnemy = false;
+		row.index = index;
+		row.result = operators.Result(index);
+		row.id = operatorId(index);
+		row.nearestId = operatorId(row.result.nearest);
+		row.group = operators.GroupName(row.result.group);
+		row.column = OperatorOutlierColumn(row.result.column);
+		_rows.push_back(std::move(row));
+	}
+
+	// 적/오퍼레이터를 섞어 |z| 가 큰 순서로
+	std::stable_sort(_rows.begin(), _rows.end(), [](const Row& a, const Row& b)
+		{
+			return std::fabs(a.result.zScore) > std::fabs(b.result.zScore);
+		});
+
+	_enemyRevision = enemyEditor.GetRevision();
+	_operatorRevision = operatorEditor.GetRevision();
+}
+
+std::string BalanceOutlierWindow::BuildReport() const
+{
+	json report = {
+		{"zThreshold", _config.zThreshold},
+		{"nnThreshold", _config.nnThreshold},
+		{"minGroupSize", _config.minGroupSize},
+		{"outliers", json::array()}
+	};
+
+	for (const Row& row : _rows)
+	{
+		report["outliers"].push_back({
+			{"type", row.isEnemy ? "enemy" : "operator"},
+			{"id", row.id},
+			{"group", row.group},
+			{"stat", row.column},
+			{"value", row.result.value},
+			{"groupMedian", row.result.groupMedian},
+			{"zScore", row.result.zScore},
+			{"nnDistance", row.result.nnDistance},
+			{"nearest", row.nearestId}
+		});
+	}
+
+	return report.dump(2);
+}
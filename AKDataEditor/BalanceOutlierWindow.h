@@ -0,0 +1,41 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "BalanceOutliers.h"
+
+class EnemyEditor;
+class OperatorEditor;
+
+// 적/오퍼레이터 밸런스 이상치 일괄 보고서
+// 검사는 각 편집기가 편집할 때마다 증분으로 갱신하고, 이 창은 결과만 모아 보여 줌
+class BalanceOutlierWindow
+{
+public:
+	void RenderGUI(bool* p_open, EnemyEditor& enemyEditor, OperatorEditor& operatorEditor);
+
+private:
+	struct Row
+	{
+		bool isEnemy = true;
+		int index = -1;
+		std::string id;
+		std::string nearestId;
+		OutlierResult result;
+		std::string group;
+		const char* column = "";
+	};
+
+	OutlierConfig _config;
+	bool _configDirty = false;
+
+	uint64_t _enemyRevision = 0;
+	uint64_t _operatorRevision = 0;
+	std::vector<Row> _rows;
+	int _enemyCount = 0;
+	int _operatorCount = 0;
+
+	void Refresh(EnemyEditor& enemyEditor, OperatorEditor& operatorEditor);
+	std::string BuildReport() const;
+};
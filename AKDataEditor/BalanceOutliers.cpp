@@ -0,0 +1,430 @@
+﻿#include "BalanceOutliers.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	constexpr float MAD_SCALE = 0.6745f;		// 정규분포에서 MAD -> 표준편차 환산
+	constexpr float MEAN_AD_SCALE = 0.7979f;	// MAD 가 0 일 때 평균 절대 편차 사용
+	constexpr float Z_LIMIT = 99.0f;			// 동료가 모두 같은 값인데 혼자 다른 경우
+
+	const char* ENEMY_COLUMNS[OUTLIER_COLUMN_COUNT] = {
+		"maxHp", "atk", "def", "magicResistance", "moveSpeed", "baseAttackTime"
+	};
+	const char* OPERATOR_COLUMNS[OUTLIER_COLUMN_COUNT] = {
+		"maxHp", "atk", "def", "magicResistance", "cost", "baseAttackTime"
+	};
+
+	float Median(std::vector<float>& values)
+	{
+		size_t mid = values.size() / 2;
+		std::nth_element(values.begin(), values.begin() + mid, values.end());
+		float upper = values[mid];
+		if (values.size() % 2 == 1)
+			return upper;
+
+		float lower = *std::max_element(values.begin(), values.begin() + mid);
+		return (lower + upper) * 0.5f;
+	}
+}
+
+OutlierSample MakeEnemySample(const EnemyStats* stats)
+{
+	OutlierSample sample;
+	if (!stats)
+		return sample;
+
+	sample.valid = true;
+	sample.group = std::string(stats->isFlying ? "FLYING" : "GROUND") + "/" + (stats->rangeRadius > 0.0 ? "RANGED" : "MELEE");
+	sample.values = {
+		(float)stats->maxHp, (float)stats->atk, (float)stats->def,
+		(float)stats->magicResistance, (float)stats->moveSpeed, (float)stats->baseAttackTime
+	};
+	return sample;
+}
+
+const char* EnemyOutlierColumn(int column)
+{
+	return ENEMY_COLUMNS[column];
+}
+
+OutlierSample MakeOperatorSample(const OperatorStats* stats)
+{
+	OutlierSample sample;
+	if (!stats)
+		return sample;
+
+	sample.valid = true;
+	sample.group = stats->profession + "/R" + std::to_string(stats->rarity);
+	sample.values = {
+		(float)stats->maxHp, (float)stats->atk, (float)stats->def,
+		(float)stats->magicResistance, (float)stats->cost, (float)stats->baseAttackTime
+	};
+	return sample;
+}
+
+const char* OperatorOutlierColumn(int column)
+{
+	return OPERATOR_COLUMNS[column];
+}
+
+void OutlierDetector::SetConfig(const OutlierConfig& config)
+{
+	_config = config;
+	for (int g = 0; g < (int)_groups.size(); ++g)
+		ComputeGroup(g);
+	_hasStale = false;
+}
+
+int OutlierDetector::GroupIndex(const std::string& name)
+{
+	auto it = _groupLookup.find(name);
+	if (it != _groupLookup.end())
+		return it->second;
+
+	int group = (int)_groupNames.size();
+	_groupNames.push_back(name);
+	_groups.emplace_back();
+	_groupLookup.emplace(name, group);
+	return group;
+}
+
+void OutlierDetector::WriteValues(int index, const OutlierSample& sample)
+{
+	// 스탯은 0 이상이고 자릿수 차이가 커서 로그 스케일에서 비교 (10배 = 약 +2.3)
+	for (int c = 0; c < OUTLIER_COLUMN_COUNT; ++c)
+		_columns[c][index] = std::log1p(std::max(0.0f, sample.values[c]));
+}
+
+void OutlierDetector::WriteSample(int index, const OutlierSample& sample)
+{
+	WriteValues(index, sample);
+
+	int group = sample.valid ? GroupIndex(sample.group) : -1;
+	_groupOf[index] = group;
+	_position[index] = -1;
+	if (group >= 0)
+	{
+		_position[index] = (int)_groups[group].members.size();
+		_groups[group].members.push_back(index);
+	}
+}
+
+void OutlierDetector::RemoveMember(int index)
+{
+	// 그룹 안 순서는 결과에 영향이 없음 (인덱스로 보고) -> 마지막 항목과 바꿔서 뺌
+	std::vector<int>& members = _groups[_groupOf[index]].members;
+	int position = _position[index];
+	members[position] = members.back();
+	_position[members[position]] = position;
+	members.pop_back();
+	_position[index] = -1;
+}
+
+void OutlierDetector::MarkStale(int group)
+{
+	_groups[group].stale = true;
+	_hasStale = true;
+}
+
+void OutlierDetector::Build(const std::vector<OutlierSample>& samples)
+{
+	const size_t count = samples.size();
+	for (auto& column : _columns)
+		column.assign(count, 0.0f);
+	_groupOf.assign(count, -1);
+	_position.assign(count, -1);
+	_groupNames.clear();
+	_groupLookup.clear();
+	_groups.clear();
+	_results.assign(count, OutlierResult());
+
+	for (size_t i = 0; i < count; ++i)
+		WriteSample((int)i, samples[i]);
+
+	for (int g = 0; g < (int)_groups.size(); ++g)
+		ComputeGroup(g);
+	_hasStale = false;
+}
+
+void OutlierDetector::Update(int index, const OutlierSample& sample)
+{
+	if (index < 0 || index >= Count())
+		return;
+
+	int oldGroup = _groupOf[index];
+	if (sample.valid && oldGroup >= 0 && _groupNames[oldGroup] == sample.group)
+	{
+		// 같은 그룹 안에서 값만 바뀜 (키 입력마다 오는 일반적인 경우)
+		WriteValues(index, sample);
+		UpdateMember(oldGroup, index);
+		return;
+	}
+
+	if (oldGroup >= 0)
+		RemoveMember(index);
+
+	WriteSample(index, sample);
+	int newGroup = _groupOf[index];
+
+	if (newGroup < 0)
+		_results[index] = OutlierResult();
+	else
+		_results[index].group = newGroup;
+
+	// 구성원이 바뀐 그룹은 척도와 최근접이 모두 바뀔 수 있음
+	if (oldGroup >= 0)
+		MarkStale(oldGroup);
+	if (newGroup >= 0)
+		MarkStale(newGroup);
+}
+
+void OutlierDetector::Flush()
+{
+	if (!_hasStale)
+		return;
+
+	for (int g = 0; g < (int)_groups.size(); ++g)
+	{
+		if (_groups[g].stale)
+			ComputeGroup(g);
+	}
+	_hasStale = false;
+}
+
+bool OutlierDetector::ComputeScale(const Group& group, std::array<float, OUTLIER_COLUMN_COUNT>& median,
+	std::array<float, OUTLIER_COLUMN_COUNT>& invScale, std::array<bool, OUTLIER_COLUMN_COUNT>& constant) const
+{
+	const std::vector<int>& members = group.members;
+	const int n = (int)members.size();
+	if (n < std::max(2, _config.minGroupSize))
+		return false;
+
+	std::vector<float> local(n);
+	std::vector<float> scratch(n);
+	for (int c = 0; c < OUTLIER_COLUMN_COUNT; ++c)
+	{
+		for (int k = 0; k < n; ++k)
+			local[k] = _columns[c][members[k]];
+
+		scratch = local;
+		median[c] = Median(scratch);
+
+		for (int k = 0; k < n; ++k)
+			scratch[k] = std::fabs(local[k] - median[c]);
+
+		double meanAbs = 0.0;
+		for (float d : scratch)
+			meanAbs += d;
+		meanAbs /= n;
+
+		float mad = Median(scratch);
+		float scale = (mad > 0.0f) ? mad / MAD_SCALE : (float)meanAbs / MEAN_AD_SCALE;
+
+		constant[c] = !(scale > 0.0f);
+		invScale[c] = constant[c] ? 0.0f : 1.0f / scale;
+	}
+	return true;
+}
+
+float OutlierDetector::Standardize(const Group& group, int column, float value) const
+{
+	const float median = group.median[column];
+	if (group.constant[column])
+		return (value == median) ? 0.0f : std::copysign(Z_LIMIT, value - median);
+	return std::clamp((value - median) * group.invScale[column], -Z_LIMIT, Z_LIMIT);
+}
+
+float OutlierDetector::DistanceSq(const Group& group, int a, int b) const
+{
+	float sum = 0.0f;
+	for (int c = 0; c < OUTLIER_COLUMN_COUNT; ++c)
+	{
+		float d = group.z[c][a] - group.z[c][b];
+		sum += d * d;
+	}
+	return sum;
+}
+
+void OutlierDetector::FindNearest(int group, int position)
+{
+	const Group& g = _groups[group];
+	const int n = (int)g.members.size();
+
+	int nearest = -1;
+	float best = std::numeric_limits<float>::infinity();
+	for (int k = 0; k < n; ++k)
+	{
+		if (k == position)
+			continue;
+		float d = DistanceSq(g, position, k);
+		if (d < best)
+		{
+			best = d;
+			nearest = k;
+		}
+	}
+	SetNearest(group, position, nearest, best);
+}
+
+void OutlierDetector::SetNearest(int group, int position, int nearestPosition, float distanceSq)
+{
+	Group& g = _groups[group];
+	g.nearestSq[position] = distanceSq;
+
+	OutlierResult& result = _results[g.members[position]];
+	result.nearest = g.members[nearestPosition];
+	result.nnDistance = std::sqrt(distanceSq / OUTLIER_COLUMN_COUNT);
+	result.flagged = std::fabs(result.zScore) > _config.zThreshold && result.nnDistance > _config.nnThreshold;
+}
+
+void OutlierDetector::ScoreMember(int group, int position)
+{
+	const Group& g = _groups[group];
+	const int member = g.members[position];
+	OutlierResult& result = _results[member];
+	result.group = group;
+	result.column = -1;
+
+	float worst = 0.0f;
+	for (int c = 0; c < OUTLIER_COLUMN_COUNT; ++c)
+	{
+		if (std::fabs(g.z[c][position]) > std::fabs(worst) || result.column < 0)
+		{
+			worst = g.z[c][position];
+			result.column = c;
+		}
+	}
+	result.zScore = worst;
+	result.value = std::expm1(_columns[result.column][member]);
+	result.groupMedian = std::expm1(g.median[result.column]);
+	result.flagged = std::fabs(worst) > _config.zThreshold && result.nnDistance > _config.nnThreshold;
+}
+
+void OutlierDetector::ComputeGroup(int group)
+{
+	Group& g = _groups[group];
+	const std::vector<int>& members = g.members;
+	const int n = (int)members.size();
+	g.stale = false;
+
+	for (int index : members)
+	{
+		_results[index] = OutlierResult();
+		_results[index].group = group;
+	}
+
+	// 열별 중앙값/척도
+	if (!ComputeScale(g, g.median, g.invScale, g.constant))
+	{
+		for (auto& column : g.z)
+			column.clear();
+		g.nearestSq.clear();
+		return;
+	}
+
+	// 표준화 좌표 (열마다 연속 배열이라 아래 루프가 그대로 벡터화됨)
+	for (int c = 0; c < OUTLIER_COLUMN_COUNT; ++c)
+	{
+		g.z[c].resize(n);
+		for (int k = 0; k < n; ++k)
+			g.z[c][k] = Standardize(g, c, _columns[c][members[k]]);
+	}
+	g.nearestSq.assign(n, 0.0f);
+
+	// 최근접 이웃 (그룹 내 O(n^2), 항목 블록 단위로 모든 코어 사용)
+	ParallelFor((size_t)n, 64, [&](size_t begin, size_t end, unsigned)
+		{
+			std::vector<float> distance(n);
+			for (size_t i = begin; i < end; ++i)
+			{
+				std::fill(distance.begin(), distance.end(), 0.0f);
+				for (int c = 0; c < OUTLIER_COLUMN_COUNT; ++c)
+				{
+					const float zi = g.z[c][i];
+					const float* column = g.z[c].data();
+					float* dist = distance.data();
+					for (int k = 0; k < n; ++k)
+					{
+						float d = column[k] - zi;
+						dist[k] += d * d;
+					}
+				}
+				distance[i] = std::numeric_limits<float>::infinity();
+
+				auto nearest = std::min_element(distance.begin(), distance.end());
+				ScoreMember(group, (int)i);
+				SetNearest(group, (int)i, (int)(nearest - distance.begin()), *nearest);
+			}
+		});
+}
+
+void OutlierDetector::UpdateMember(int group, int index)
+{
+	Group& g = _groups[group];
+	if (g.stale)
+		return;
+
+	std::array<float, OUTLIER_COLUMN_COUNT> median{};
+	std::array<float, OUTLIER_COLUMN_COUNT> invScale{};
+	std::array<bool, OUTLIER_COLUMN_COUNT> constant{};
+	if (!ComputeScale(g, median, invScale, constant))
+		return;		// 판정하지 않는 작은 그룹 (결과는 이미 비어 있음)
+
+	if (median != g.median || invScale != g.invScale || constant != g.constant)
+	{
+		// 척도가 바뀌면 모든 좌표가 움직임
+		MarkStale(group);
+		return;
+	}
+
+	// 척도가 그대로면 다른 항목의 좌표/z 는 그대로이고 바뀐 항목과의 거리만 달라짐
+	const int n = (int)g.members.size();
+	const int position = _position[index];
+	for (int c = 0; c < OUTLIER_COLUMN_COUNT; ++c)
+		g.z[c][position] = Standardize(g, c, _columns[c][index]);
+	ScoreMember(group, position);
+
+	std::vector<int> rescan;
+	for (int k = 0; k < n; ++k)
+	{
+		if (k == position)
+			continue;
+
+		float d = DistanceSq(g, k, position);
+		if (_results[g.members[k]].nearest == index)
+		{
+			// 최근접이던 항목이 멀어졌으면 다른 항목이 더 가까울 수 있음
+			if (d <= g.nearestSq[k])
+				SetNearest(group, k, position, d);
+			else
+				rescan.push_back(k);
+		}
+		else if (d < g.nearestSq[k])
+		{
+			SetNearest(group, k, position, d);
+		}
+	}
+
+	FindNearest(group, position);
+	for (int k : rescan)
+		FindNearest(group, k);
+}
+
+std::vector<int> OutlierDetector::Flagged() const
+{
+	std::vector<int> flagged;
+	for (int i = 0; i < Count(); ++i)
+	{
+		if (_results[i].flagged)
+			flagged.push_back(i);
+	}
+
+	std::sort(flagged.begin(), flagged.end(), [&](int a, int b)
+		{
+			return std::fabs(_results[a].zScore) > std::fabs(_results[b].zScore);
+		});
+	return flagged;
+}
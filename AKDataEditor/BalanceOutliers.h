@@ -0,0 +1,111 @@
+﻿#pragma once
+#include <array>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "GameTables.h"
+
+constexpr int OUTLIER_COLUMN_COUNT = 6;
+
+// 검사 대상 하나 (그룹 안에서만 비교)
+struct OutlierSample
+{
+	bool valid = false;
+	std::string group;
+	std::array<float, OUTLIER_COLUMN_COUNT> values{};
+};
+
+// 적: 지상/비행 × 근거리/원거리 그룹, (maxHp, atk, def, magicResistance, moveSpeed, baseAttackTime)
+OutlierSample MakeEnemySample(const EnemyStats* stats);
+const char* EnemyOutlierColumn(int column);
+
+// 오퍼레이터: 직군 × 레어도 그룹, (maxHp, atk, def, magicResistance, cost, baseAttackTime)
+OutlierSample MakeOperatorSample(const OperatorStats* stats);
+const char* OperatorOutlierColumn(int column);
+
+struct OutlierResult
+{
+	bool flagged = false;
+	int group = -1;
+	int column = -1;			// |z| 가 가장 큰 열
+	float zScore = 0.0f;		// 해당 열의 robust z (부호 = 방향)
+	float value = 0.0f;			// 해당 열의 원래 값
+	float groupMedian = 0.0f;	// 해당 열의 그룹 중앙값 (원래 단위)
+	float nnDistance = 0.0f;	// 표준화 공간에서 가장 가까운 같은 그룹 항목까지 RMS 거리
+	int nearest = -1;
+};
+
+struct OutlierConfig
+{
+	float zThreshold = 3.5f;	// Iglewicz-Hoaglin 기준
+	float nnThreshold = 2.0f;	// 가까운 이웃이 있으면 (보스 무리 등) 의도된 값으로 보고 제외
+	int minGroupSize = 5;		// 비교할 동료가 너무 적으면 판정하지 않음
+};
+
+// 스탯을 log1p 로 펴서 그룹별 중앙값/MAD 로 robust z 를 구하고,
+// |z| 가 크면서 표준화 공간의 최근접 이웃도 먼 항목만 이상치로 표시
+// 값이 바뀌어도 그룹의 중앙값/척도가 그대로면 바뀐 항목과 그 항목을 최근접으로 둔 항목만 다시 계산 (O(n))
+// 척도가 바뀌거나 그룹을 옮기면 그룹 전체 재계산(O(n^2))을 Flush 까지 미룸 (그동안 결과는 이전 값)
+class OutlierDetector
+{
+public:
+	void SetConfig(const OutlierConfig& config);
+	const OutlierConfig& GetConfig() const { return _config; }
+
+	void Build(const std::vector<OutlierSample>& samples);
+	void Update(int index, const OutlierSample& sample);
+
+	// 미뤄 둔 그룹 재계산 (편집 동작이 끝났을 때 호출)
+	void Flush();
+	bool HasPending() const { return _hasStale; }
+
+	int Count() const { return (int)_results.size(); }
+	const OutlierResult& Result(int index) const { return _results[index]; }
+	const std::string& GroupName(int group) const { return _groupNames[group]; }
+	int GroupSize(int group) const { return (int)_groups[group].members.size(); }
+
+	// 표시된 항목 인덱스 (|z| 내림차순)
+	std::vector<int> Flagged() const;
+
+private:
+	// 그룹별 캐시 (z/nearestSq 는 members 와 같은 순서)
+	struct Group
+	{
+		std::vector<int> members;
+		std::array<std::vector<float>, OUTLIER_COLUMN_COUNT> z;		// 표준화 좌표 (SoA)
+		std::vector<float> nearestSq;									// 최근접 이웃까지 거리 제곱 합
+		std::array<float, OUTLIER_COLUMN_COUNT> median{};
+		std::array<float, OUTLIER_COLUMN_COUNT> invScale{};
+		std::array<bool, OUTLIER_COLUMN_COUNT> constant{};
+		bool stale = true;												// 전체 재계산 대기
+	};
+
+	OutlierConfig _config;
+
+	std::array<std::vector<float>, OUTLIER_COLUMN_COUNT> _columns;	// log1p 값 (SoA)
+	std::vector<int> _groupOf;										// -1 = 제외
+	std::vector<int> _position;										// 그룹 members 안 위치
+	std::vector<std::string> _groupNames;
+	std::unordered_map<std::string, int> _groupLookup;
+	std::vector<Group> _groups;
+	std::vector<OutlierResult> _results;
+	bool _hasStale = false;
+
+	int GroupIndex(const std::string& name);
+	void WriteValues(int index, const OutlierSample& sample);
+	void WriteSample(int index, const OutlierSample& sample);
+	void RemoveMember(int index);
+	void MarkStale(int group);
+
+	bool ComputeScale(const Group& group, std::array<float, OUTLIER_COLUMN_COUNT>& median,
+		std::array<float, OUTLIER_COLUMN_COUNT>& invScale, std::array<bool, OUTLIER_COLUMN_COUNT>& constant) const;
+	float Standardize(const Group& group, int column, float value) const;
+	float DistanceSq(const Group& group, int a, int b) const;
+	void FindNearest(int group, int position);
+	void SetNearest(int group, int position, int nearestPosition, float distanceSq);
+	void ScoreMember(int group, int position);
+
+	void ComputeGroup(int group);
+	void UpdateMember(int group, int index);
+};
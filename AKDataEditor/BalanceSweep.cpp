@@ -0,0 +1,376 @@
+﻿#include "BalanceSweep.h"
+#include "Parallel.h"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// 런마다 독립적인 난수 스트림 (플랫폼과 무관하게 같은 수열)
+	struct SplitMix64
+	{
+		uint64_t state;
+
+		explicit SplitMix64(uint64_t seed) : state(seed) {}
+
+		uint64_t Next()
+		{
+			uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+
+		// [0, 1)
+		double NextDouble()
+		{
+			return (Next() >> 11) * (1.0 / 9007199254740992.0);
+		}
+
+		// [-1, 1)
+		double NextSigned()
+		{
+			return NextDouble() * 2.0 - 1.0;
+		}
+	};
+
+	constexpr int CLEAR_TIME_BINS = 4096;		// 클리어 시간 구간 수 (maxTime 900초면 약 0.2초 단위)
+}
+
+bool ParsePerturbationSpec(const json& spec, PerturbationSpec& out)
+{
+	try
+	{
+		out.runs = spec.value("runs", out.runs);
+		out.seed = spec.value("seed", out.seed);
+		out.enemyHpJitter = spec.value("enemyHpJitter", out.enemyHpJitter);
+		out.spawnIntervalJitter = spec.value("spawnIntervalJitter", out.spawnIntervalJitter);
+		out.histogramBins = spec.value("histogramBins", out.histogramBins);
+		out.reportBatch = spec.value("reportBatch", out.reportBatch);
+		out.baseConfig.timeStep = spec.value("timeStep", out.baseConfig.timeStep);
+		out.baseConfig.maxTime = spec.value("maxTime", out.baseConfig.maxTime);
+
+		out.deploymentScripts.clear();
+		if (spec.contains("deploymentScripts"))
+		{
+			for (const auto& script : spec["deploymentScripts"])
+			{
+				std::vector<Deployment> plan;
+				if (!ParseDeploymentScript(script, plan))
+					return false;
+				out.deploymentScripts.push_back(std::move(plan));
+			}
+		}
+	}
+	catch (const json::exception& e)
+	{
+		std::cout << "[Sweep] Invalid perturbation spec: " << e.what() << "\n";
+		return false;
+	}
+
+	return out.runs > 0;
+}
+
+json Distribution::ToJson() const
+{
+	return {
+		{"count", count},
+		{"mean", mean},
+		{"min", min},
+		{"max", max},
+		{"p50", p50},
+		{"p90", p90},
+		{"p99", p99},
+		{"histogram", histogram}
+	};
+}
+
+json SweepReport::ToJson() const
+{
+	return {
+		{"runsCompleted", runsCompleted},
+		{"clearRate", clearRate},
+		{"defeatRate", defeatRate},
+		{"leaks", leaks.ToJson()},
+		{"lifePointsLost", lifePointsLost.ToJson()},
+		{"clearTime", clearTime.ToJson()}
+	};
+}
+
+SweepMetric::SweepMetric(double binWidth, int maxBins)
+	: _binWidth(binWidth > 0.0 ? binWidth : 1.0), _maxBins(maxBins)
+{
+	if (_maxBins > 0)
+		_bins.assign(_maxBins, 0);
+}
+
+void SweepMetric::Add(double value)
+{
+	if (_count == 0)
+	{
+		_min = value;
+		_max = value;
+	}
+	else
+	{
+		_min = std::min(_min, value);
+		_max = std::max(_max, value);
+	}
+
+	++_count;
+	_sumMicros += std::llround(value * 1e6);
+
+	// 구간 중심이 binWidth 의 배수가 되도록 반올림 (폭 1 이면 정수 값 그대로)
+	long long bin = std::max(0LL, std::llround(value / _binWidth));
+	if (_maxBins > 0)
+		bin = std::min<long long>(bin, _maxBins - 1);
+	else if ((size_t)bin >= _bins.size())
+		_bins.resize((size_t)bin + 1, 0);
+
+	++_bins[(size_t)bin];
+}
+
+void SweepMetric::Merge(const SweepMetric& other)
+{
+	if (other._count == 0)
+		return;
+
+	if (_count == 0)
+	{
+		_min = other._min;
+		_max = other._max;
+	}
+	else
+	{
+		_min = std::min(_min, other._min);
+		_max = std::max(_max, other._max);
+	}
+
+	_count += other._count;
+	_sumMicros += other._sumMicros;
+
+	if (_bins.size() < other._bins.size())
+		_bins.resize(other._bins.size(), 0);
+	for (size_t i = 0; i < other._bins.size(); ++i)
+		_bins[i] += other._bins[i];
+}
+
+void SweepMetric::Clear()
+{
+	_count = 0;
+	_sumMicros = 0;
+	_min = 0.0;
+	_max = 0.0;
+	std::fill(_bins.begin(), _bins.end(), 0);
+}
+
+double SweepMetric::BinValue(size_t bin) const
+{
+	return std::clamp(bin * _binWidth, _min, _max);
+}
+
+double SweepMetric::Quantile(double p) const
+{
+	if (_count == 0)
+		return 0.0;
+
+	int64_t rank = (int64_t)std::ceil(p * _count);
+	rank = std::clamp<int64_t>(rank, 1, _count);
+
+	int64_t seen = 0;
+	for (size_t i = 0; i < _bins.size(); ++i)
+	{
+		seen += _bins[i];
+		if (seen >= rank)
+			return BinValue(i);
+	}
+	return _max;
+}
+
+Distribution SweepMetric::ToDistribution(int bins) const
+{
+	Distribution dist;
+	dist.count = (int)_count;
+	dist.histogram.assign(std::max(1, bins), 0);
+
+	if (_count == 0)
+		return dist;
+
+	dist.mean = (double)_sumMicros / 1e6 / _count;
+	dist.min = _min;
+	dist.max = _max;
+	dist.p50 = Quantile(0.50);
+	dist.p90 = Quantile(0.90);
+	dist.p99 = Quantile(0.99);
+
+	double width = (dist.max - dist.min) / dist.histogram.size();
+	for (size_t i = 0; i < _bins.size(); ++i)
+	{
+		if (_bins[i] == 0)
+			continue;
+
+		int bin = (width > 0.0) ? (int)((BinValue(i) - dist.min) / width) : 0;
+		bin = std::clamp(bin, 0, (int)dist.histogram.size() - 1);
+		dist.histogram[bin] += (int)_bins[i];
+	}
+
+	return dist;
+}
+
+SweepAccumulator::SweepAccumulator(double maxTime)
+	: clearTime(std::max(maxTime, 1.0) / CLEAR_TIME_BINS, CLEAR_TIME_BINS + 1)
+{
+}
+
+void SweepAccumulator::Merge(const SweepAccumulator& other)
+{
+	runs += other.runs;
+	cleared += other.cleared;
+	defeated += other.defeated;
+	leaks.Merge(other.leaks);
+	lifePointsLost.Merge(other.lifePointsLost);
+	clearTime.Merge(other.clearTime);
+}
+
+void SweepAccumulator::Clear()
+{
+	runs = 0;
+	cleared = 0;
+	defeated = 0;
+	leaks.Clear();
+	lifePointsLost.Clear();
+	clearTime.Clear();
+}
+
+SweepReport SweepAccumulator::ToReport(int bins) const
+{
+	SweepReport report;
+	report.runsCompleted = (int)runs;
+	if (runs > 0)
+	{
+		report.clearRate = (double)cleared / runs;
+		report.defeatRate = (double)defeated / runs;
+	}
+
+	report.leaks = leaks.ToDistribution(bins);
+	report.lifePointsLost = lifePointsLost.ToDistribution(bins);
+	report.clearTime = clearTime.ToDistribution(bins);
+	return report;
+}
+
+BalanceSweep::BalanceSweep(const BattleSimulator& simulator)
+	: _simulator(simulator)
+{
+}
+
+BalanceSweep::RunOutcome BalanceSweep::RunSingle(const PerturbationSpec& spec, int runIndex) const
+{
+	SplitMix64 rng(spec.seed ^ (0xD1B54A32D192ED03ull * (uint64_t)(runIndex + 1)));
+
+	SimConfig config = spec.baseConfig;
+	config.enemyHpScale = 1.0 + spec.enemyHpJitter * rng.NextSigned();
+
+	// 스폰 사이 간격을 하나씩 따로 흔듦 (같은 시각의 스폰은 같이 나오고 순서는 바뀌지 않음)
+	if (spec.spawnIntervalJitter > 0.0)
+	{
+		const auto& spawns = _simulator.GetLevel().spawns;
+		config.spawnTimes.resize(spawns.size());
+		double previous = 0.0;
+		double shifted = 0.0;
+		for (size_t i = 0; i < spawns.size(); ++i)
+		{
+			double interval = spawns[i].time - previous;
+			previous = spawns[i].time;
+			if (interval > 0.0)
+				shifted += interval * std::max(0.0, 1.0 + spec.spawnIntervalJitter * rng.NextSigned());
+			config.spawnTimes[i] = shifted;
+		}
+	}
+	config.dpSampleInterval = config.maxTime;	// 스윕에서는 DP 타임라인 불필요
+
+	// 랜덤 스폰 그룹은 런마다 가중치에 따라 추첨
+	const auto& groups = _simulator.GetLevel().randomGroups;
+	config.randomChoices.resize(groups.size());
+	for (size_t g = 0; g < groups.size(); ++g)
+		config.randomChoices[g] = groups[g].Pick(rng.NextDouble());
+
+	static const std::vector<Deployment> emptyPlan;
+	const std::vector<Deployment>* plan = &emptyPlan;
+	if (!spec.deploymentScripts.empty())
+	{
+		size_t pick = (size_t)(rng.NextDouble() * spec.deploymentScripts.size());
+		plan = &spec.deploymentScripts[std::min(pick, spec.deploymentScripts.size() - 1)];
+	}
+
+	SimResult result = _simulator.Run(*plan, config);
+
+	RunOutcome outcome;
+	outcome.cleared = result.cleared ? 1 : 0;
+	outcome.defeated = result.defeated ? 1 : 0;
+	outcome.leaks = result.enemiesLeaked;
+	outcome.lifePointsLost = result.lifePointsLost;
+	outcome.endTime = result.endTime;
+	return outcome;
+}
+
+SweepReport BalanceSweep::Run(const PerturbationSpec& spec, const std::string& reportPath) const
+{
+	std::ofstream reportFile;
+	if (!reportPath.empty())
+	{
+		reportFile.open(reportPath, std::ios::trunc);
+		if (!reportFile.is_open())
+			std::cout << "[Sweep] Failed to open report file: " << reportPath << "\n";
+	}
+
+	size_t runs = (size_t)std::max(0, spec.runs);
+	size_t batch = (size_t)std::max(1, spec.reportBatch);
+
+	// 작업 스레드별 누적기를 배치마다 전체에 한 번 병합
+	SweepAccumulator total(spec.baseConfig.maxTime);
+	std::vector<SweepAccumulator> workers(GetWorkerCount(), total);
+	SweepReport report;
+
+	for (size_t begin = 0; begin < runs; begin += batch)
+	{
+		size_t end = std::min(runs, begin + batch);
+
+		ParallelFor(end - begin, 1, [&](size_t first, size_t last, unsigned worker)
+			{
+				SweepAccumulator& acc = workers[worker];
+				for (size_t i = first; i < last; ++i)
+				{
+					RunOutcome outcome = RunSingle(spec, (int)(begin + i));
+					++acc.runs;
+					acc.cleared += outcome.cleared;
+					acc.defeated += outcome.defeated;
+					acc.leaks.Add(outcome.leaks);
+					acc.lifePointsLost.Add(outcome.lifePointsLost);
+					if (outcome.cleared)
+						acc.clearTime.Add(outcome.endTime);
+				}
+			});
+
+		for (SweepAccumulator& acc : workers)
+		{
+			total.Merge(acc);
+			acc.Clear();
+		}
+
+		report = total.ToReport(spec.histogramBins);
+
+		if (reportFile.is_open())
+		{
+			json line = report.ToJson();
+			line["final"] = (end == runs);
+			reportFile << line.dump() << "\n";
+			reportFile.flush();
+		}
+	}
+
+	std::cout << "[Sweep] " << report.runsCompleted << " runs, clear rate "
+		<< report.clearRate * 100.0 << "%, mean leaks " << report.leaks.mean << "\n";
+
+	return report;
+}
@@ -0,0 +1,122 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+
+#include "BattleSimulator.h"
+
+using json = nlohmann::ordered_json;
+
+// 몬테카를로 스윕 섭동 설정
+struct PerturbationSpec
+{
+	int runs = 1000;
+	uint64_t seed = 1;
+	double enemyHpJitter = 0.0;			// ±비율 (0.1 = 적 HP ±10%)
+	double spawnIntervalJitter = 0.0;	// ±비율 (스폰 사이 간격마다 따로, 순서는 유지)
+	std::vector<std::vector<Deployment>> deploymentScripts;	// 런마다 하나를 균등 선택
+	int histogramBins = 20;
+	int reportBatch = 256;				// 이 수만큼 런이 끝날 때마다 누적 통계를 기록
+	SimConfig baseConfig;
+};
+
+// {"runs", "seed", "enemyHpJitter", "spawnIntervalJitter", "deploymentScripts": [{"deployments": [...]}], ...}
+bool ParsePerturbationSpec(const json& spec, PerturbationSpec& out);
+
+struct Distribution
+{
+	int count = 0;
+	double mean = 0.0;
+	double min = 0.0;
+	double max = 0.0;
+	double p50 = 0.0;
+	double p90 = 0.0;
+	double p99 = 0.0;
+	std::vector<int> histogram;			// [min, max] 균등 구간
+
+	json ToJson() const;
+};
+
+struct SweepReport
+{
+	int runsCompleted = 0;
+	double clearRate = 0.0;
+	double defeatRate = 0.0;
+	Distribution leaks;
+	Distribution lifePointsLost;
+	Distribution clearTime;				// 클리어한 런만
+
+	json ToJson() const;
+};
+
+// 한 지표의 누적 통계 (개수, 합, 최소/최대, 고정 폭 구간 히스토그램)
+// 작업 스레드마다 하나씩 채우고 배치마다 한 번 병합하므로 런 결과를 따로 보관하지 않음
+// 분위수는 구간 경계 단위로 근사 (폭 1 인 정수 지표는 정확)
+class SweepMetric
+{
+public:
+	// maxBins == 0 이면 값이 커질 때 구간을 늘림, 아니면 마지막 구간에 모음
+	explicit SweepMetric(double binWidth = 1.0, int maxBins = 0);
+
+	void Add(double value);
+	void Merge(const SweepMetric& other);
+	void Clear();						// 구간 메모리는 유지
+
+	// 출력 히스토그램은 [min, max] 를 bins 개로 나눠 세밀한 구간을 다시 묶음
+	Distribution ToDistribution(int bins) const;
+
+private:
+	double _binWidth;
+	int _maxBins;
+	int64_t _count = 0;
+	int64_t _sumMicros = 0;				// 병합 순서와 무관하게 같은 합이 나오도록 고정소수점
+	double _min = 0.0;
+	double _max = 0.0;
+	std::vector<int64_t> _bins;
+
+	double Quantile(double p) const;
+	double BinValue(size_t bin) const;
+};
+
+struct SweepAccumulator
+{
+	int64_t runs = 0;
+	int64_t cleared = 0;
+	int64_t defeated = 0;
+	SweepMetric leaks;
+	SweepMetric lifePointsLost;
+	SweepMetric clearTime;				// 클리어한 런만
+
+	explicit SweepAccumulator(double maxTime = 900.0);
+
+	void Merge(const SweepAccumulator& other);
+	void Clear();
+	SweepReport ToReport(int bins) const;
+};
+
+// 레벨 하나에 대해 섭동된 시뮬레이션을 모든 코어에서 실행
+// 런 i 의 난수는 (seed, i) 로만 결정되므로 스레드 수와 무관하게 재현 가능
+class BalanceSweep
+{
+public:
+	explicit BalanceSweep(const BattleSimulator& simulator);
+
+	// reportPath 가 비어 있지 않으면 배치마다 누적 통계를 JSON Lines 로 기록
+	// 배치 보고 비용은 배치 크기에만 비례 (지금까지의 런 수와 무관)
+	SweepReport Run(const PerturbationSpec& spec, const std::string& reportPath = "") const;
+
+private:
+	struct RunOutcome
+	{
+		uint8_t cleared = 0;
+		uint8_t defeated = 0;
+		int leaks = 0;
+		int lifePointsLost = 0;
+		double endTime = 0.0;
+	};
+
+	const BattleSimulator& _simulator;
+
+	RunOutcome RunSingle(const PerturbationSpec& spec, int runIndex) const;
+};
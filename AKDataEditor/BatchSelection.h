@@ -0,0 +1,210 @@
+﻿#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// 목록 다중 선택 (인덱스별 플래그 + Shift 범위 선택 기준점)
+class MultiSelection
+{
+public:
+	// 목록 길이가 바뀌면 호출 (남는 선택은 버리고 새 항목은 선택 안 됨)
+	void Resize(size_t count)
+	{
+		if (count < _flags.size())
+		{
+			for (size_t i = count; i < _flags.size(); ++i)
+				_count -= _flags[i];
+			if (_anchor >= (int)count)
+				_anchor = -1;
+		}
+		_flags.resize(count, 0);
+	}
+
+	size_t Size() const { return _flags.size(); }
+	int Count() const { return _count; }
+	bool Empty() const { return _count == 0; }
+	bool IsSelected(int index) const { return index >= 0 && index < (int)_flags.size() && _flags[index]; }
+	const std::vector<uint8_t>& Flags() const { return _flags; }
+
+	void Set(int index, bool selected)
+	{
+		if (index < 0 || index >= (int)_flags.size() || (bool)_flags[index] == selected)
+			return;
+
+		_flags[index] = selected ? 1 : 0;
+		_count += selected ? 1 : -1;
+	}
+
+	// 클릭 한 번 (range = Shift, 기준점부터 index 까지 같은 상태로)
+	void Click(int index, bool range)
+	{
+		if (range && _anchor >= 0)
+		{
+			bool selected = !IsSelected(index);
+			int lo = std::min(_anchor, index);
+			int hi = std::max(_anchor, index);
+			for (int i = lo; i <= hi; ++i)
+				Set(i, selected);
+		}
+		else
+		{
+			Set(index, !IsSelected(index));
+		}
+		_anchor = index;
+	}
+
+	void SelectAll()
+	{
+		std::fill(_flags.begin(), _flags.end(), 1);
+		_count = (int)_flags.size();
+	}
+
+	void Clear()
+	{
+		std::fill(_flags.begin(), _flags.end(), 0);
+		_count = 0;
+		_anchor = -1;
+	}
+
+	std::vector<int> Indices() const
+	{
+		std::vector<int> indices;
+		indices.reserve(_count);
+		for (int i = 0; i < (int)_flags.size(); ++i)
+		{
+			if (_flags[i])
+				indices.push_back(i);
+		}
+		return indices;
+	}
+
+	// 목록이 압축/복제된 뒤 old -> new 인덱스로 옮김 (-1 = 사라짐)
+	void Remap(const std::vector<int>& remap, size_t newCount)
+	{
+		std::vector<uint8_t> flags(newCount, 0);
+		int count = 0;
+		for (size_t i = 0; i < _flags.size() && i < remap.size(); ++i)
+		{
+			if (_flags[i] && remap[i] >= 0)
+			{
+				flags[remap[i]] = 1;
+				++count;
+			}
+		}
+		_flags = std::move(flags);
+		_count = count;
+		_anchor = -1;
+	}
+
+private:
+	std::vector<uint8_t> _flags;
+	int _count = 0;
+	int _anchor = -1;
+};
+
+// remove[i] 가 1 인 원소를 한 번의 순회로 앞으로 당겨 지움 (O(n))
+// 반환: old -> new 인덱스 (-1 = 삭제됨)
+template <typename T>
+std::vector<int> CompactRemove(std::vector<T>& items, const std::vector<uint8_t>& remove)
+{
+	std::vector<int> remap(items.size(), -1);
+
+	size_t out = 0;
+	for (size_t i = 0; i < items.size(); ++i)
+	{
+		if (i < remove.size() && remove[i])
+			continue;
+
+		if (out != i)
+			items[out] = std::move(items[i]);
+		remap[i] = (int)out++;
+	}
+
+	items.erase(items.begin() + out, items.end());
+	return remap;
+}
+
+// 선택한 원소마다 바로 뒤에 makeCopy(원본) 을 넣음 (한 번에 다시 만들어 O(n))
+// 반환: old -> new 인덱스 (복제본은 remap[i] + 1)
+template <typename T, typename Func>
+std::vector<int> DuplicateSelected(std::vector<T>& items, const std::vector<uint8_t>& selected, Func&& makeCopy)
+{
+	std::vector<int> remap(items.size(), -1);
+
+	size_t extra = 0;
+	for (size_t i = 0; i < items.size() && i < selected.size(); ++i)
+		extra += selected[i];
+
+	std::vector<T> result;
+	result.reserve(items.size() + extra);
+	for (size_t i = 0; i < items.size(); ++i)
+	{
+		remap[i] = (int)result.size();
+		bool copy = i < selected.size() && selected[i];
+
+		if (copy)
+		{
+			T duplicate = makeCopy(items[i]);
+			result.push_back(std::move(items[i]));
+			result.push_back(std::move(duplicate));
+		}
+		else
+		{
+			result.push_back(std::move(items[i]));
+		}
+	}
+
+	items = std::move(result);
+	return remap;
+}
+
+// CompactRemove 의 반대: indices(오름차순, 삽입 후 위치) 에 inserted 를 한 번에 끼워 넣음 (O(n))
+// 반환: old -> new 인덱스
+template <typename T>
+std::vector<int> InsertAt(std::vector<T>& items, const std::vector<int>& indices, std::vector<T> inserted)
+{
+	std::vector<int> remap(items.size(), -1);
+	std::vector<T> result;
+	result.reserve(items.size() + inserted.size());
+
+	size_t source = 0;
+	size_t next = 0;
+	while (source < items.size() || next < inserted.size())
+	{
+		if (next < inserted.size() && (size_t)indices[next] == result.size())
+		{
+			result.push_back(std::move(inserted[next++]));
+		}
+		else if (source < items.size())
+		{
+			remap[source] = (int)result.size();
+			result.push_back(std::move(items[source++]));
+		}
+		else
+		{
+			result.push_back(std::move(inserted[next++]));	// 범위를 넘은 위치는 끝에 붙임
+		}
+	}
+
+	items = std::move(result);
+	return remap;
+}
+
+inline int RemapIndex(const std::vector<int>& remap, int index)
+{
+	return (index >= 0 && index < (int)remap.size()) ? remap[index] : -1;
+}
+
+// base_copy, base_copy2, ... 중 아직 쓰이지 않은 키 (used 에 추가됨)
+inline std::string MakeUniqueKey(const std::string& base, std::unordered_set<std::string>& used)
+{
+	std::string key = base + "_copy";
+	for (int n = 2; used.count(key); ++n)
+		key = base + "_copy" + std::to_string(n);
+
+	used.insert(key);
+	return key;
+}
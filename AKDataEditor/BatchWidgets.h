@@ -0,0 +1,150 @@
+﻿#pragma once
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <imgui/imgui.h>
+
+#include "BatchSelection.h"
+#include "BulkEdit.h"
+#include "ContentHash.h"
+#include "Utility.h"
+
+enum class BatchAction
+{
+	None = 0,
+	Delete,
+	Duplicate,
+	SetField,
+};
+
+// 목록 행의 선택 체크박스 (Shift+클릭 = 기준점부터 범위 선택)
+inline void SelectionCheckbox(MultiSelection& selection, int index)
+{
+	bool selected = selection.IsSelected(index);
+	if (ImGui::Checkbox("##select", &selected))
+		selection.Click(index, ImGui::GetIO().KeyShift);
+}
+
+// 목록 위 일괄 작업 버튼 (눌린 작업을 반환)
+inline BatchAction RenderBatchToolbar(MultiSelection& selection, bool canSetField)
+{
+	BatchAction action = BatchAction::None;
+
+	ImGui::Text("선택 %d개", selection.Count());
+	ImGui::SameLine();
+	if (ImGui::SmallButton("전체 선택"))
+		selection.SelectAll();
+	ImGui::SameLine();
+	if (ImGui::SmallButton("선택 해제"))
+		selection.Clear();
+
+	if (selection.Empty()) ImGui::BeginDisabled();
+
+	ImGui::SameLine();
+	if (ImGui::SmallButton("선택 복제"))
+		action = BatchAction::Duplicate;
+	ImGui::SameLine();
+	if (ImGui::SmallButton("선택 삭제"))
+		action = BatchAction::Delete;
+
+	if (canSetField)
+	{
+		ImGui::SameLine();
+		if (ImGui::SmallButton("선택 필드 설정..."))
+			action = BatchAction::SetField;
+	}
+
+	if (selection.Empty()) ImGui::EndDisabled();
+
+	return action;
+}
+
+// 선택한 레코드에 "필드 = 값/식" 하나를 적용하는 팝업 (일괄 편집 엔진으로 계산)
+struct FieldSetPopup
+{
+	int field = 0;
+	char expression[256] = "";
+	std::string error;
+
+	void Open()
+	{
+		error.clear();
+		ImGui::OpenPopup("선택 필드 설정");
+	}
+
+	bool IsOpen() const { return ImGui::IsPopupOpen("선택 필드 설정"); }
+
+	// 적용 버튼을 누르고 계산에 성공하면 out 을 채우고 true
+	bool Render(BulkEditTarget target, const json& records, const std::vector<uint8_t>& mask, BulkEditResult& out)
+	{
+		bool done = false;
+		if (!ImGui::BeginPopupModal("선택 필드 설정", NULL, ImGuiWindowFlags_AlwaysAutoResize))
+			return false;
+
+		std::vector<std::string> fields = BulkEditWritableFields(target);
+		field = std::clamp(field, 0, std::max(0, (int)fields.size() - 1));
+
+		ImGui::SetNextItemWidth(200);
+		if (ImGui::BeginCombo("필드", fields.empty() ? "" : fields[field].c_str()))
+		{
+			for (int i = 0; i < (int)fields.size(); ++i)
+			{
+				if (ImGui::Selectable(fields[i].c_str(), i == field))
+					field = i;
+			}
+			ImGui::EndCombo();
+		}
+
+		ImGui::SetNextItemWidth(300);
+		ImGui::InputTextWithHint("값 / 식", "1200, maxHp * 1.1, \"FLYING\"", expression, sizeof(expression));
+
+		if (!error.empty())
+			ImGui::TextColored(COLOR_RED, "%s", error.c_str());
+
+		if (ImGui::Button("적용", ImVec2(120, 0)) && !fields.empty())
+		{
+			BulkEditProgram program;
+			error.clear();
+			if (BulkEditProgram::Compile(target, fields[field] + " = " + expression, program, error))
+			{
+				out = program.Run(records, &mask);
+				done = out.ok;
+				if (done)
+					ImGui::CloseCurrentPopup();
+				else
+					error = out.error;
+			}
+		}
+
+		ImGui::SameLine();
+
+		if (ImGui::Button("취소", ImVec2(120, 0)))
+			ImGui::CloseCurrentPopup();
+
+		ImGui::EndPopup();
+		return done;
+	}
+};
+
+// 저장된 상태와 다른 레코드 목록 툴팁 (종류별로 앞쪽 몇 개만)
+inline void RenderChangeSummaryTooltip(const RecordChangeSummary& summary)
+{
+	if (!ImGui::BeginTooltip())
+		return;
+
+	ImGui::Text("바뀜 %d, 추가 %d, 삭제 %d", (int)summary.changed.size(), (int)summary.added.size(), (int)summary.removed.size());
+
+	auto list = [](const char* label, const std::vector<std::string>& keys, const ImVec4& color)
+		{
+			const int shown = 12;
+			for (int i = 0; i < (int)keys.size() && i < shown; ++i)
+				ImGui::TextColored(color, "%s %s", label, keys[i].c_str());
+			if ((int)keys.size() > shown)
+				ImGui::TextColored(COLOR_GRAY, "  ... 외 %d개", (int)keys.size() - shown);
+		};
+	list("~", summary.changed, COLOR_YELLOW);
+	list("+", summary.added, COLOR_GREEN);
+	list("-", summary.removed, COLOR_RED);
+
+	ImGui::EndTooltip();
+}
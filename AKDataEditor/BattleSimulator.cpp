@@ -0,0 +1,606 @@
+﻿#include "BattleSimulator.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	constexpr float MIN_DAMAGE_RATIO = 0.05f;	// 방어/저항으로 깎여도 최소 5%
+
+	// 적 엔티티 (SoA)
+	struct EnemyPool
+	{
+		std::vector<int> statIndex;
+		std::vector<int> spawnIndex;
+		std::vector<int> routeIndex;
+		std::vector<int> nextNode;			// 경로 상 다음 목표 타일
+		std::vector<float> x;				// col
+		std::vector<float> y;				// row
+		std::vector<float> hp;
+		std::vector<float> progress;		// 이동한 거리 (타겟 우선순위)
+		std::vector<float> attackCooldown;
+		std::vector<int> blocker;			// 저지 중인 오퍼레이터 (-1 = 없음)
+		std::vector<uint8_t> alive;
+
+		size_t Size() const { return statIndex.size(); }
+
+		void Add(int stat, int spawn, int route, float px, float py, float startHp)
+		{
+			statIndex.push_back(stat);
+			spawnIndex.push_back(spawn);
+			routeIndex.push_back(route);
+			nextNode.push_back(1);
+			x.push_back(px);
+			y.push_back(py);
+			hp.push_back(startHp);
+			progress.push_back(0.0f);
+			attackCooldown.push_back(0.0f);
+			blocker.push_back(-1);
+			alive.push_back(1);
+		}
+
+		// 죽거나 빠져나간 적 제거 (swap-remove)
+		void Compact()
+		{
+			size_t i = 0;
+			while (i < Size())
+			{
+				if (alive[i])
+				{
+					++i;
+					continue;
+				}
+
+				size_t last = Size() - 1;
+				if (i != last)
+				{
+					statIndex[i] = statIndex[last];
+					spawnIndex[i] = spawnIndex[last];
+					routeIndex[i] = routeIndex[last];
+					nextNode[i] = nextNode[last];
+					x[i] = x[last];
+					y[i] = y[last];
+					hp[i] = hp[last];
+					progress[i] = progress[last];
+					attackCooldown[i] = attackCooldown[last];
+					blocker[i] = blocker[last];
+					alive[i] = alive[last];
+				}
+
+				statIndex.pop_back();
+				spawnIndex.pop_back();
+				routeIndex.pop_back();
+				nextNode.pop_back();
+				x.pop_back();
+				y.pop_back();
+				hp.pop_back();
+				progress.pop_back();
+				attackCooldown.pop_back();
+				blocker.pop_back();
+				alive.pop_back();
+			}
+		}
+	};
+
+	// 배치된 오퍼레이터 (SoA, 인덱스는 배치 순서로 고정)
+	struct OperatorPool
+	{
+		std::vector<int> statIndex;
+		std::vector<int> tile;
+		std::vector<uint8_t> direction;
+		std::vector<float> hp;
+		std::vector<float> attackCooldown;
+		std::vector<int> blockedCount;
+		std::vector<uint8_t> alive;
+
+		size_t Size() const { return statIndex.size(); }
+	};
+
+	// 타일 단위 공간 해시 (카운팅 정렬로 매 스텝 재구성)
+	class SpatialHash
+	{
+	public:
+		void Resize(int cellCount)
+		{
+			_cellStart.assign(cellCount + 1, 0);
+		}
+
+		void Build(const EnemyPool& enemies, const LevelGrid& level)
+		{
+			std::fill(_cellStart.begin(), _cellStart.end(), 0);
+			_cellOf.resize(enemies.Size());
+
+			for (size_t i = 0; i < enemies.Size(); ++i)
+			{
+				int cell = -1;
+				if (enemies.alive[i])
+				{
+					int row = (int)std::lround(enemies.y[i]);
+					int col = (int)std::lround(enemies.x[i]);
+					if (level.InBounds(row, col))
+						cell = level.TileIndex(row, col);
+				}
+
+				_cellOf[i] = cell;
+				if (cell >= 0)
+					++_cellStart[cell + 1];
+			}
+
+			for (size_t c = 1; c < _cellStart.size(); ++c)
+				_cellStart[c] += _cellStart[c - 1];
+
+			_items.resize(_cellStart.back());
+			_cursor.assign(_cellStart.begin(), _cellStart.end() - 1);
+
+			for (size_t i = 0; i < enemies.Size(); ++i)
+			{
+				if (_cellOf[i] >= 0)
+					_items[_cursor[_cellOf[i]]++] = (int)i;
+			}
+		}
+
+		int CellOf(size_t enemy) const { return _cellOf[enemy]; }
+
+		template <typename Func>
+		void ForEachInCell(int cell, Func&& func) const
+		{
+			for (int k = _cellStart[cell]; k < _cellStart[cell + 1]; ++k)
+				func(_items[k]);
+		}
+
+	private:
+		std::vector<int> _cellStart;
+		std::vector<int> _cursor;
+		std::vector<int> _items;
+		std::vector<int> _cellOf;
+	};
+
+	float ComputeDamage(float atk, float def, float resistance, bool isArts)
+	{
+		float damage = isArts ? atk * (1.0f - resistance) : atk - def;
+		return std::max(damage, atk * MIN_DAMAGE_RATIO);
+	}
+}
+
+bool ParseDeploymentScript(const json& script, std::vector<Deployment>& out)
+{
+	out.clear();
+
+	if (!script.contains("deployments") || !script["deployments"].is_array())
+	{
+		std::cout << "[Sim] Deployment script has no 'deployments' array\n";
+		return false;
+	}
+
+	try
+	{
+		for (const auto& entry : script["deployments"])
+		{
+			Deployment deployment;
+			deployment.time = entry.value("time", 0.0);
+			deployment.charId = entry.at("charId").get<std::string>();
+			deployment.tile.row = entry.at("row").get<int>();
+			deployment.tile.col = entry.at("col").get<int>();
+			deployment.direction = StringToDirection(entry.value("direction", "RIGHT"));
+			out.push_back(deployment);
+		}
+	}
+	catch (const json::exception& e)
+	{
+		std::cout << "[Sim] Invalid deployment script: " << e.what() << "\n";
+		return false;
+	}
+
+	return true;
+}
+
+BattleSimulator::BattleSimulator(const LevelGrid& level,
+	const std::vector<EnemyStats>& enemies,
+	const std::vector<OperatorStats>& operators)
+	: _level(level), _enemies(enemies), _operators(operators)
+{
+	std::unordered_map<std::string, int> enemyLookup;
+	for (int i = 0; i < (int)_enemies.size(); ++i)
+		enemyLookup[_enemies[i].key] = i;
+
+	for (int i = 0; i < (int)_operators.size(); ++i)
+		_operatorLookup[_operators[i].charId] = i;
+
+	_spawnEnemyIndex.reserve(_level.spawns.size());
+	for (const auto& spawn : _level.spawns)
+	{
+		auto it = enemyLookup.find(spawn.enemyKey);
+		bool routeOk = spawn.routeIndex >= 0 && spawn.routeIndex < (int)_level.routes.size()
+			&& !_level.routes[spawn.routeIndex].path.empty();
+
+		_spawnEnemyIndex.push_back((it != enemyLookup.end() && routeOk) ? it->second : -1);
+	}
+
+	for (const auto& group : _level.randomGroups)
+		_defaultRandomChoices.push_back(group.HeaviestOption());
+}
+
+int BattleSimulator::GetOperatorIndex(const std::string& charId) const
+{
+	auto it = _operatorLookup.find(charId);
+	return (it != _operatorLookup.end()) ? it->second : -1;
+}
+
+SimResult BattleSimulator::Run(const std::vector<Deployment>& plan, const SimConfig& config) const
+{
+	SimResult result;
+	result.killTimes.assign(_level.spawns.size(), -1.0);
+	result.leakTimes.assign(_level.spawns.size(), -1.0);
+	result.deployTimes.assign(plan.size(), -1.0);
+
+	// 스윕이 간격을 흔든 시각이 있으면 그것을 씀
+	const bool customSpawnTimes = config.spawnTimes.size() == _level.spawns.size();
+	auto spawnTime = [&](size_t index)
+		{
+			return (customSpawnTimes ? config.spawnTimes[index] : _level.spawns[index].time) * config.spawnTimeScale;
+		};
+
+	const float dt = (float)config.timeStep;
+	const int cellCount = _level.rows * _level.cols;
+	const LevelOptions& opts = _level.options;
+
+	EnemyPool enemies;
+	OperatorPool ops;
+	SpatialHash hash;
+	hash.Resize(cellCount);
+
+	std::vector<int> operatorAtTile(cellCount, -1);
+	std::vector<uint8_t> deployedChar(_operators.size(), 0);
+
+	int dp = opts.initialCost;
+	double dpAccum = 0.0;
+	double nextDpSample = 0.0;
+	size_t nextSpawn = 0;
+	size_t nextPlan = 0;
+	int deployedCount = 0;
+	double time = 0.0;
+
+	const std::vector<int>& randomChoices = (config.randomChoices.size() == _level.randomGroups.size())
+		? config.randomChoices : _defaultRandomChoices;
+
+	while (time < config.maxTime)
+	{
+		// ===== DP =====
+		if (opts.costIncreaseTime > 0.0)
+		{
+			dpAccum += dt;
+			while (dpAccum >= opts.costIncreaseTime)
+			{
+				dpAccum -= opts.costIncreaseTime;
+				dp = std::min(opts.maxCost, dp + 1);
+			}
+		}
+
+		if (time >= nextDpSample)
+		{
+			result.dpTimeline.push_back({ time, dp });
+			nextDpSample += config.dpSampleInterval;
+		}
+
+		// ===== 배치 (스크립트 순서 유지, DP 부족 시 대기) =====
+		while (nextPlan < plan.size() && plan[nextPlan].time <= time)
+		{
+			const Deployment& entry = plan[nextPlan];
+			int opIndex = GetOperatorIndex(entry.charId);
+
+			bool valid = opIndex >= 0
+				&& !deployedChar[opIndex]
+				&& _level.InBounds(entry.tile.row, entry.tile.col);
+
+			int tile = valid ? _level.TileIndex(entry.tile.row, entry.tile.col) : -1;
+			if (valid)
+			{
+				int required = _operators[opIndex].IsMelee() ? 1 : 2;
+				valid = _level.buildable[tile] == required && operatorAtTile[tile] < 0;
+			}
+
+			if (!valid)
+			{
+				++nextPlan;
+				continue;
+			}
+
+			if (dp < _operators[opIndex].cost || deployedCount >= opts.characterLimit)
+				break;
+
+			const OperatorStats& stats = _operators[opIndex];
+			dp -= stats.cost;
+
+			ops.statIndex.push_back(opIndex);
+			ops.tile.push_back(tile);
+			ops.direction.push_back((uint8_t)entry.direction);
+			ops.hp.push_back((float)stats.maxHp);
+			ops.attackCooldown.push_back(0.0f);
+			ops.blockedCount.push_back(0);
+			ops.alive.push_back(1);
+
+			operatorAtTile[tile] = (int)ops.Size() - 1;
+			deployedChar[opIndex] = 1;
+			++deployedCount;
+
+			result.deployTimes[nextPlan] = time;
+			++nextPlan;
+		}
+
+		// ===== 스폰 =====
+		while (nextSpawn < _level.spawns.size() && spawnTime(nextSpawn) <= time)
+		{
+			const SpawnEvent& spawn = _level.spawns[nextSpawn];
+			int stat = _spawnEnemyIndex[nextSpawn];
+
+			if (spawn.randomGroup >= 0 && randomChoices[spawn.randomGroup] != spawn.randomOption)
+				stat = -1;
+
+			if (stat >= 0)
+			{
+				const GridPos& start = _level.routes[spawn.routeIndex].path.front();
+				float hp = (float)(_enemies[stat].maxHp * config.enemyHpScale);
+
+				enemies.Add(stat, (int)nextSpawn, spawn.routeIndex, (float)start.col, (float)start.row, hp);
+				++result.enemiesSpawned;
+			}
+			++nextSpawn;
+		}
+
+		hash.Build(enemies, _level);
+
+		// ===== 저지 판정 =====
+		for (size_t e = 0; e < enemies.Size(); ++e)
+		{
+			if (!enemies.alive[e] || enemies.blocker[e] >= 0 || _enemies[enemies.statIndex[e]].isFlying)
+				continue;
+
+			int cell = hash.CellOf(e);
+			if (cell < 0)
+				continue;
+
+			int op = operatorAtTile[cell];
+			if (op < 0 || !ops.alive[op])
+				continue;
+
+			const OperatorStats& stats = _operators[ops.statIndex[op]];
+			if (stats.IsMelee() && ops.blockedCount[op] < stats.blockCnt)
+			{
+				enemies.blocker[e] = op;
+				++ops.blockedCount[op];
+			}
+		}
+
+		// ===== 이동 =====
+		for (size_t e = 0; e < enemies.Size(); ++e)
+		{
+			if (!enemies.alive[e] || enemies.blocker[e] >= 0)
+				continue;
+
+			const std::vector<GridPos>& path = _level.routes[enemies.routeIndex[e]].path;
+			float remaining = (float)(_enemies[enemies.statIndex[e]].moveSpeed * opts.moveMultiplier) * dt;
+
+			while (remaining > 0.0f && enemies.nextNode[e] < (int)path.size())
+			{
+				const GridPos& target = path[enemies.nextNode[e]];
+				float dx = target.col - enemies.x[e];
+				float dy = target.row - enemies.y[e];
+				float dist = std::sqrt(dx * dx + dy * dy);
+
+				if (dist <= remaining)
+				{
+					enemies.x[e] = (float)target.col;
+					enemies.y[e] = (float)target.row;
+					enemies.progress[e] += dist;
+					remaining -= dist;
+					++enemies.nextNode[e];
+				}
+				else
+				{
+					enemies.x[e] += dx / dist * remaining;
+					enemies.y[e] += dy / dist * remaining;
+					enemies.progress[e] += remaining;
+					remaining = 0.0f;
+				}
+			}
+
+			if (enemies.nextNode[e] >= (int)path.size())
+			{
+				// 종료 지점 도달
+				enemies.alive[e] = 0;
+				result.leakTimes[enemies.spawnIndex[e]] = time;
+				result.lifePointsLost += _enemies[enemies.statIndex[e]].lifePointReduce;
+				++result.enemiesLeaked;
+			}
+		}
+
+		hash.Build(enemies, _level);
+
+		// ===== 오퍼레이터 공격 / 치유 =====
+		for (size_t o = 0; o < ops.Size(); ++o)
+		{
+			if (!ops.alive[o])
+				continue;
+
+			ops.attackCooldown[o] -= dt;
+			if (ops.attackCooldown[o] > 0.0f)
+				continue;
+
+			const OperatorStats& stats = _operators[ops.statIndex[o]];
+			int originRow = ops.tile[o] / _level.cols;
+			int originCol = ops.tile[o] % _level.cols;
+			Direction dir = (Direction)ops.direction[o];
+
+			if (stats.IsHealer())
+			{
+				// 범위 내 체력 비율이 가장 낮은 아군
+				int healTarget = -1;
+				float lowestRatio = 1.0f;
+
+				for (const auto& offset : stats.range)
+				{
+					GridOffset rotated = RotateOffset(offset, dir);
+					int row = originRow + rotated.row;
+					int col = originCol + rotated.col;
+					if (!_level.InBounds(row, col))
+						continue;
+
+					int ally = operatorAtTile[_level.TileIndex(row, col)];
+					if (ally < 0 || !ops.alive[ally])
+						continue;
+
+					float ratio = ops.hp[ally] / (float)std::max(1, _operators[ops.statIndex[ally]].maxHp);
+					if (ratio < lowestRatio)
+					{
+						lowestRatio = ratio;
+						healTarget = ally;
+					}
+				}
+
+				if (healTarget >= 0)
+				{
+					float maxHp = (float)_operators[ops.statIndex[healTarget]].maxHp;
+					ops.hp[healTarget] = std::min(maxHp, ops.hp[healTarget] + (float)stats.atk);
+					ops.attackCooldown[o] = (float)stats.baseAttackTime;
+				}
+				continue;
+			}
+
+			// 저지 중인 적 우선, 없으면 범위 내에서 가장 많이 전진한 적
+			int target = -1;
+			float bestProgress = -1.0f;
+
+			for (size_t e = 0; e < enemies.Size(); ++e)
+			{
+				if (enemies.alive[e] && enemies.blocker[e] == (int)o && enemies.progress[e] > bestProgress)
+				{
+					bestProgress = enemies.progress[e];
+					target = (int)e;
+				}
+			}
+
+			if (target < 0)
+			{
+				for (const auto& offset : stats.range)
+				{
+					GridOffset rotated = RotateOffset(offset, dir);
+					int row = originRow + rotated.row;
+					int col = originCol + rotated.col;
+					if (!_level.InBounds(row, col))
+						continue;
+
+					hash.ForEachInCell(_level.TileIndex(row, col), [&](int e)
+						{
+							if (!enemies.alive[e])
+								return;
+							if (stats.IsMelee() && _enemies[enemies.statIndex[e]].isFlying)
+								return;
+							if (enemies.progress[e] > bestProgress)
+							{
+								bestProgress = enemies.progress[e];
+								target = e;
+							}
+						});
+				}
+			}
+
+			if (target < 0)
+				continue;
+
+			const EnemyStats& enemyStats = _enemies[enemies.statIndex[target]];
+			enemies.hp[target] -= ComputeDamage((float)stats.atk, (float)enemyStats.def,
+				(float)enemyStats.magicResistance, stats.DealsArtsDamage());
+			ops.attackCooldown[o] = (float)stats.baseAttackTime;
+
+			if (enemies.hp[target] <= 0.0f)
+			{
+				enemies.alive[target] = 0;
+				result.killTimes[enemies.spawnIndex[target]] = time;
+				++result.enemiesKilled;
+
+				if (enemies.blocker[target] >= 0)
+				{
+					--ops.blockedCount[enemies.blocker[target]];
+					enemies.blocker[target] = -1;
+				}
+			}
+		}
+
+		// ===== 적 공격 =====
+		for (size_t e = 0; e < enemies.Size(); ++e)
+		{
+			if (!enemies.alive[e])
+				continue;
+
+			enemies.attackCooldown[e] -= dt;
+			if (enemies.attackCooldown[e] > 0.0f)
+				continue;
+
+			const EnemyStats& enemyStats = _enemies[enemies.statIndex[e]];
+			int target = enemies.blocker[e];
+
+			if (target < 0 && enemyStats.rangeRadius > 0.0)
+			{
+				float bestDist = (float)(enemyStats.rangeRadius * enemyStats.rangeRadius);
+				for (size_t o = 0; o < ops.Size(); ++o)
+				{
+					if (!ops.alive[o])
+						continue;
+
+					float dx = (float)(ops.tile[o] % _level.cols) - enemies.x[e];
+					float dy = (float)(ops.tile[o] / _level.cols) - enemies.y[e];
+					float dist = dx * dx + dy * dy;
+					if (dist <= bestDist)
+					{
+						bestDist = dist;
+						target = (int)o;
+					}
+				}
+			}
+
+			if (target < 0)
+				continue;
+
+			const OperatorStats& opStats = _operators[ops.statIndex[target]];
+			ops.hp[target] -= ComputeDamage((float)enemyStats.atk, (float)opStats.def,
+				(float)opStats.magicResistance, false);
+			enemies.attackCooldown[e] = (float)enemyStats.baseAttackTime;
+
+			if (ops.hp[target] <= 0.0f)
+			{
+				// 오퍼레이터 퇴각: 저지하던 적 해제
+				ops.alive[target] = 0;
+				operatorAtTile[ops.tile[target]] = -1;
+				--deployedCount;
+
+				for (size_t k = 0; k < enemies.Size(); ++k)
+				{
+					if (enemies.blocker[k] == target)
+						enemies.blocker[k] = -1;
+				}
+				ops.blockedCount[target] = 0;
+			}
+		}
+
+		enemies.Compact();
+
+		time += dt;
+
+		if (result.lifePointsLost >= opts.maxLifePoint)
+		{
+			result.defeated = true;
+			break;
+		}
+
+		if (nextSpawn >= _level.spawns.size() && enemies.Size() == 0)
+		{
+			result.cleared = true;
+			break;
+		}
+	}
+
+	result.endTime = time;
+	result.dpTimeline.push_back({ time, dp });
+
+	return result;
+}
@@ -0,0 +1,81 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+
+#include "GameTables.h"
+#include "LevelGrid.h"
+
+using json = nlohmann::ordered_json;
+
+// 배치 스크립트 한 줄 (time 이후 DP가 충분해지면 순서대로 배치)
+struct Deployment
+{
+	double time = 0.0;
+	std::string charId;
+	GridPos tile;
+	Direction direction = Direction::Right;
+};
+
+struct SimConfig
+{
+	double timeStep = 1.0 / 30.0;		// 고정 스텝 (초)
+	double maxTime = 900.0;
+	double enemyHpScale = 1.0;
+	double spawnTimeScale = 1.0;
+	std::vector<double> spawnTimes;		// 스폰 이벤트별 시각 (비어 있으면 레벨의 시각), spawnTimeScale 은 그 위에 곱함
+	double dpSampleInterval = 1.0;
+	std::vector<int> randomChoices;		// 랜덤 그룹별 선택 옵션 (비어 있으면 가중치가 가장 큰 옵션)
+};
+
+struct DpSample
+{
+	double time = 0.0;
+	int dp = 0;
+};
+
+struct SimResult
+{
+	bool cleared = false;
+	bool defeated = false;
+	double endTime = 0.0;
+
+	int lifePointsLost = 0;
+	int enemiesSpawned = 0;
+	int enemiesKilled = 0;
+	int enemiesLeaked = 0;
+
+	std::vector<double> killTimes;		// 스폰 이벤트 순서, 처치되지 않으면 -1
+	std::vector<double> leakTimes;		// 스폰 이벤트 순서, 새어나가지 않으면 -1
+	std::vector<double> deployTimes;	// 배치 스크립트 순서, 배치 실패 시 -1
+	std::vector<DpSample> dpTimeline;
+};
+
+// {"deployments": [{"time", "charId", "row", "col", "direction"}]}
+bool ParseDeploymentScript(const json& script, std::vector<Deployment>& out);
+
+// 헤드리스 고정 스텝 전투 시뮬레이터
+// 생성 후에는 읽기 전용이므로 여러 스레드에서 Run 을 동시에 호출해도 안전
+class BattleSimulator
+{
+public:
+	BattleSimulator(const LevelGrid& level,
+		const std::vector<EnemyStats>& enemies,
+		const std::vector<OperatorStats>& operators);
+
+	SimResult Run(const std::vector<Deployment>& plan, const SimConfig& config = SimConfig()) const;
+
+	const LevelGrid& GetLevel() const { return _level; }
+	int GetOperatorIndex(const std::string& charId) const;
+	const OperatorStats& GetOperator(int index) const { return _operators[index]; }
+
+private:
+	LevelGrid _level;
+	std::vector<EnemyStats> _enemies;
+	std::vector<OperatorStats> _operators;
+	std::unordered_map<std::string, int> _operatorLookup;
+
+	std::vector<int> _spawnEnemyIndex;	// 스폰 이벤트 -> _enemies 인덱스 (-1 = 테이블에 없음)
+	std::vector<int> _defaultRandomChoices;
+};
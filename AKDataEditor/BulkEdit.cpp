@@ -0,0 +1,1180 @@
+﻿#include "BulkEdit.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+namespace
+{
+	constexpr size_t BLOCK_SIZE = 512;
+	constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+	enum class FieldScope
+	{
+		Record,		// 레코드 루트 기준
+		KeyFrame,	// phases[p].attributesKeyFrames[k] 기준
+		Phase,		// 정예화 단계 번호 (읽기 전용 가상 필드)
+	};
+
+	struct FieldDef
+	{
+		const char* name;
+		FieldScope scope;
+		std::vector<std::string> tokens;
+		bool isString;
+		bool isInteger;
+		bool wrapped;		// { m_defined, m_value } 로 감싼 값
+		bool readOnly;
+	};
+
+	const std::vector<FieldDef>& FieldDefs(BulkEditTarget target)
+	{
+		static const std::vector<FieldDef> enemy = {
+			{ "key", FieldScope::Record, { "key" }, true, false, false, true },
+			{ "name", FieldScope::Record, { "value", "0", "enemyData", "name" }, true, false, true, false },
+			{ "type", FieldScope::Record, { "value", "0", "enemyData", "type" }, true, false, true, false },
+			{ "maxHp", FieldScope::Record, { "value", "0", "enemyData", "attributes", "maxHp" }, false, true, true, false },
+			{ "atk", FieldScope::Record, { "value", "0", "enemyData", "attributes", "atk" }, false, true, true, false },
+			{ "def", FieldScope::Record, { "value", "0", "enemyData", "attributes", "def" }, false, true, true, false },
+			{ "magicResistance", FieldScope::Record, { "value", "0", "enemyData", "attributes", "magicResistance" }, false, false, true, false },
+			{ "moveSpeed", FieldScope::Record, { "value", "0", "enemyData", "attributes", "moveSpeed" }, false, false, true, false },
+			{ "baseAttackTime", FieldScope::Record, { "value", "0", "enemyData", "attributes", "baseAttackTime" }, false, false, true, false },
+			{ "rangeRadius", FieldScope::Record, { "value", "0", "enemyData", "rangeRadius" }, false, false, true, false },
+			{ "lifePointReduce", FieldScope::Record, { "value", "0", "enemyData", "lifePointReduce" }, false, true, true, false },
+		};
+
+		static const std::vector<FieldDef> op = {
+			{ "charId", FieldScope::Record, { "charId" }, true, false, false, true },
+			{ "name", FieldScope::Record, { "name" }, true, false, false, false },
+			{ "profession", FieldScope::Record, { "profession" }, true, false, false, true },
+			{ "position", FieldScope::Record, { "position" }, true, false, false, true },
+			{ "rarity", FieldScope::Record, { "rarity" }, false, true, false, false },
+			{ "phase", FieldScope::Phase, {}, false, true, false, true },
+			{ "level", FieldScope::KeyFrame, { "level" }, false, true, false, true },
+			{ "maxHp", FieldScope::KeyFrame, { "data", "maxHp" }, false, true, false, false },
+			{ "atk", FieldScope::KeyFrame, { "data", "atk" }, false, true, false, false },
+			{ "def", FieldScope::KeyFrame, { "data", "def" }, false, true, false, false },
+			{ "magicResistance", FieldScope::KeyFrame, { "data", "magicResistance" }, false, false, false, false },
+			{ "cost", FieldScope::KeyFrame, { "data", "cost" }, false, true, false, false },
+			{ "blockCnt", FieldScope::KeyFrame, { "data", "blockCnt" }, false, true, false, false },
+			{ "baseAttackTime", FieldScope::KeyFrame, { "data", "baseAttackTime" }, false, false, false, false },
+			{ "respawnTime", FieldScope::KeyFrame, { "data", "respawnTime" }, false, true, false, false },
+		};
+
+		static const std::vector<FieldDef> skill = {
+			{ "skillId", FieldScope::Record, { "skillId" }, true, false, false, true },
+			{ "operatorId", FieldScope::Record, { "operatorId" }, true, false, false, true },
+			{ "name", FieldScope::Record, { "name" }, true, false, false, false },
+			{ "skillType", FieldScope::Record, { "skillType" }, false, true, false, false },
+			{ "duration", FieldScope::Record, { "duration" }, false, false, false, false },
+			{ "spType", FieldScope::Record, { "spData", "spType" }, false, true, false, false },
+			{ "spCost", FieldScope::Record, { "spData", "spCost" }, false, true, false, false },
+			{ "initSp", FieldScope::Record, { "spData", "initSp" }, false, true, false, false },
+		};
+
+		switch (target)
+		{
+		case BulkEditTarget::Operator: return op;
+		case BulkEditTarget::Skill: return skill;
+		default: return enemy;
+		}
+	}
+
+	struct RowRef
+	{
+		int record = -1;
+		int phase = -1;
+		int keyFrame = -1;
+	};
+
+	std::vector<RowRef> EnumerateRows(BulkEditTarget target, const json& records)
+	{
+		std::vector<RowRef> rows;
+		if (!records.is_array())
+			return rows;
+
+		for (int r = 0; r < (int)records.size(); ++r)
+		{
+			if (target != BulkEditTarget::Operator)
+			{
+				rows.push_back({ r, -1, -1 });
+				continue;
+			}
+
+			auto phases = records[r].find("phases");
+			if (phases == records[r].end() || !phases->is_array())
+				continue;
+
+			for (int p = 0; p < (int)phases->size(); ++p)
+			{
+				auto keyFrames = (*phases)[p].find("attributesKeyFrames");
+				if (keyFrames == (*phases)[p].end() || !keyFrames->is_array())
+					continue;
+
+				for (int k = 0; k < (int)keyFrames->size(); ++k)
+					rows.push_back({ r, p, k });
+			}
+		}
+		return rows;
+	}
+
+	const json* Walk(const json* node, const std::vector<std::string>& tokens)
+	{
+		for (const std::string& token : tokens)
+		{
+			if (!node)
+				return nullptr;
+
+			if (node->is_object())
+			{
+				auto it = node->find(token);
+				node = (it != node->end()) ? &*it : nullptr;
+			}
+			else if (node->is_array())
+			{
+				size_t index = (size_t)std::atoi(token.c_str());
+				node = (index < node->size()) ? &(*node)[index] : nullptr;
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+		return node;
+	}
+
+	const json* Unwrap(const json* node)
+	{
+		if (!node || !node->is_object())
+			return nullptr;
+
+		auto it = node->find("m_value");
+		return (it != node->end()) ? &*it : nullptr;
+	}
+
+	json::json_pointer KeyFramePointer(const RowRef& row)
+	{
+		return json::json_pointer("/phases/" + std::to_string(row.phase) + "/attributesKeyFrames/" + std::to_string(row.keyFrame));
+	}
+
+	std::string RowLabel(BulkEditTarget target, const json& record, const RowRef& row)
+	{
+		switch (target)
+		{
+		case BulkEditTarget::Operator:
+		{
+			const json& keyFrame = record["phases"][row.phase]["attributesKeyFrames"][row.keyFrame];
+			return record.value("charId", std::string()) + " E" + std::to_string(row.phase) + " Lv" + std::to_string(keyFrame.value("level", 1));
+		}
+		case BulkEditTarget::Skill:
+			return record.value("skillId", std::string());
+		default:
+			return record.value("key", std::string());
+		}
+	}
+
+	// 실행 중 문자열 <-> id (컴파일 때 상수를 먼저 넣고, 데이터의 문자열을 이어서 추가)
+	struct StringPool
+	{
+		std::vector<std::string> strings;
+		std::unordered_map<std::string, int> ids;
+
+		int Intern(const std::string& str)
+		{
+			auto it = ids.find(str);
+			if (it != ids.end())
+				return it->second;
+
+			int id = (int)strings.size();
+			strings.push_back(str);
+			ids.emplace(str, id);
+			return id;
+		}
+	};
+
+	double SnapValue(double value, bool isInteger)
+	{
+		// 부동소수점 찌꺼기 (1.15 배 등) 가 JSON 에 남지 않도록
+		return isInteger ? std::nearbyint(value) : std::nearbyint(value * 10000.0) / 10000.0;
+	}
+}
+
+const char* BulkEditTargetName(BulkEditTarget target)
+{
+	switch (target)
+	{
+	case BulkEditTarget::Operator: return "operators";
+	case BulkEditTarget::Skill: return "skills";
+	default: return "enemies";
+	}
+}
+
+std::vector<std::string> BulkEditFieldNames(BulkEditTarget target)
+{
+	std::vector<std::string> names;
+	for (const FieldDef& def : FieldDefs(target))
+		names.push_back(std::string(def.name) + (def.readOnly ? " (읽기 전용)" : ""));
+
+	if (target == BulkEditTarget::Skill)
+		names.push_back("bb.<key>");
+	return names;
+}
+
+std::vector<std::string> BulkEditWritableFields(BulkEditTarget target)
+{
+	std::vector<std::string> names;
+	for (const FieldDef& def : FieldDefs(target))
+	{
+		if (!def.readOnly)
+			names.push_back(def.name);
+	}
+	return names;
+}
+
+// ---------------------------------------------------------------------------
+// 컴파일 (재귀 하강 파서가 바로 레지스터 명령을 생성)
+// ---------------------------------------------------------------------------
+
+class BulkEditCompiler
+{
+public:
+	BulkEditCompiler(BulkEditTarget target, const std::string& source, BulkEditProgram& out)
+		: _target(target), _src(source), _out(out)
+	{
+		_out = BulkEditProgram();
+		_out._target = target;
+	}
+
+	bool Compile(std::string& error)
+	{
+		try
+		{
+			Next();
+			SkipSeparators();
+
+			if (IsIdent("where"))
+			{
+				Next();
+				Value filter = ParseExpr();
+				if (filter.isString)
+					Fail("where 조건은 숫자/비교식이어야 합니다");
+
+				_out._filterReg = filter.reg;
+				_out._filterEnd = (int)_out._code.size();
+				ExpectSeparator();
+			}
+
+			while (_token.kind != TokenKind::End)
+			{
+				ParseAssignment();
+				ExpectSeparator();
+			}
+
+			if (_out._assignments.empty())
+				Fail("대입문이 없습니다");
+		}
+		catch (const CompileError& e)
+		{
+			error = e.message;
+			return false;
+		}
+
+		return true;
+	}
+
+private:
+	enum class TokenKind { Number, String, Ident, Symbol, Separator, End };
+
+	struct Token
+	{
+		TokenKind kind = TokenKind::End;
+		std::string text;
+		double number = 0.0;
+		size_t pos = 0;
+	};
+
+	struct Value
+	{
+		int reg = -1;
+		bool isString = false;
+	};
+
+	struct CompileError
+	{
+		std::string message;
+	};
+
+	BulkEditTarget _target;
+	const std::string& _src;
+	BulkEditProgram& _out;
+	size_t _pos = 0;
+	Token _token;
+	std::unordered_map<std::string, int> _fieldSlots;
+	std::unordered_map<std::string, int> _stringIds;
+
+	// 값이 행 (정예화 단계 / 키프레임) 마다 다를 수 있는지: 레지스터별, 필드 슬롯별 (행 기준 필드이거나 그런 값을 대입받음)
+	std::vector<uint8_t> _rowDependent;
+	std::vector<uint8_t> _slotRowDependent;
+
+	[[noreturn]] void Fail(const std::string& message) const
+	{
+		throw CompileError{ "위치 " + std::to_string(_token.pos + 1) + ": " + message };
+	}
+
+	void Next()
+	{
+		while (_pos < _src.size() && (_src[_pos] == ' ' || _src[_pos] == '\t' || _src[_pos] == '\r'))
+			++_pos;
+
+		_token = Token();
+		_token.pos = _pos;
+
+		if (_pos >= _src.size())
+			return;
+
+		char ch = _src[_pos];
+
+		// 줄바꿈도 문장 구분
+		if (ch == ';' || ch == '\n')
+		{
+			_token.kind = TokenKind::Separator;
+			++_pos;
+			return;
+		}
+
+		if (std::isdigit((unsigned char)ch) || (ch == '.' && _pos + 1 < _src.size() && std::isdigit((unsigned char)_src[_pos + 1])))
+		{
+			char* end = nullptr;
+			_token.kind = TokenKind::Number;
+			_token.number = std::strtod(_src.c_str() + _pos, &end);
+			_pos = end - _src.c_str();
+			return;
+		}
+
+		if (std::isalpha((unsigned char)ch) || ch == '_')
+		{
+			size_t start = _pos;
+			while (_pos < _src.size() && (std::isalnum((unsigned char)_src[_pos]) || _src[_pos] == '_' || _src[_pos] == '.'))
+				++_pos;
+
+			_token.kind = TokenKind::Ident;
+			_token.text = _src.substr(start, _pos - start);
+			return;
+		}
+
+		if (ch == '"' || ch == '\'')
+		{
+			size_t end = _src.find(ch, _pos + 1);
+			if (end == std::string::npos)
+				Fail("문자열이 닫히지 않았습니다");
+
+			_token.kind = TokenKind::String;
+			_token.text = _src.substr(_pos + 1, end - _pos - 1);
+			_pos = end + 1;
+			return;
+		}
+
+		static const char* symbols[] = {
+			"==", "!=", "<=", ">=", "+=", "-=", "*=", "/=", "&&", "||",
+			"=", "<", ">", "+", "-", "*", "/", "%", "(", ")", ",", "!"
+		};
+		for (const char* symbol : symbols)
+		{
+			size_t length = std::strlen(symbol);
+			if (_src.compare(_pos, length, symbol) == 0)
+			{
+				_token.kind = TokenKind::Symbol;
+				_token.text = symbol;
+				_pos += length;
+				return;
+			}
+		}
+
+		Fail(std::string("알 수 없는 문자 '") + ch + "'");
+	}
+
+	bool IsSymbol(const char* symbol) const
+	{
+		return _token.kind == TokenKind::Symbol && _token.text == symbol;
+	}
+
+	bool IsIdent(const char* ident) const
+	{
+		return _token.kind == TokenKind::Ident && _token.text == ident;
+	}
+
+	void Expect(const char* symbol)
+	{
+		if (!IsSymbol(symbol))
+			Fail(std::string("'") + symbol + "' 가 필요합니다");
+		Next();
+	}
+
+	void SkipSeparators()
+	{
+		while (_token.kind == TokenKind::Separator)
+			Next();
+	}
+
+	void ExpectSeparator()
+	{
+		if (_token.kind != TokenKind::Separator && _token.kind != TokenKind::End)
+			Fail("';' 또는 줄바꿈이 필요합니다");
+		SkipSeparators();
+	}
+
+	int NewRegister()
+	{
+		return _out._registerCount++;
+	}
+
+	int Emit(BulkEditProgram::OpCode op, int a = -1, int b = -1, int c = -1, double constant = 0.0)
+	{
+		BulkEditProgram::Instruction inst;
+		inst.op = op;
+		inst.dst = NewRegister();
+		inst.a = a;
+		inst.b = b;
+		inst.c = c;
+		inst.constant = constant;
+		_out._code.push_back(inst);
+
+		bool rowDependent = false;
+		if (op == BulkEditProgram::OpCode::Field)
+			rowDependent = _slotRowDependent[a];
+		else if (op != BulkEditProgram::OpCode::Const)
+			rowDependent = (a >= 0 && _rowDependent[a]) || (b >= 0 && _rowDependent[b]) || (c >= 0 && _rowDependent[c]);
+		_rowDependent.push_back(rowDependent ? 1 : 0);
+		return inst.dst;
+	}
+
+	int StringId(const std::string& str)
+	{
+		auto it = _stringIds.find(str);
+		if (it != _stringIds.end())
+			return it->second;
+
+		int id = (int)_out._strings.size();
+		_out._strings.push_back(str);
+		_stringIds.emplace(str, id);
+		return id;
+	}
+
+	int FieldSlot(const std::string& name)
+	{
+		auto it = _fieldSlots.find(name);
+		if (it != _fieldSlots.end())
+			return it->second;
+
+		BulkEditProgram::FieldRef ref;
+		ref.name = name;
+
+		if (_target == BulkEditTarget::Skill && name.rfind("bb.", 0) == 0 && name.size() > 3)
+		{
+			ref.blackboardKey = name.substr(3);
+		}
+		else
+		{
+			const auto& defs = FieldDefs(_target);
+			auto def = std::find_if(defs.begin(), defs.end(), [&](const FieldDef& d) { return name == d.name; });
+			if (def == defs.end())
+				Fail("알 수 없는 필드 '" + name + "'");
+
+			ref.def = (int)(def - defs.begin());
+			ref.isString = def->isString;
+			ref.isInteger = def->isInteger;
+			ref.readOnly = def->readOnly;
+		}
+
+		int slot = (int)_out._fields.size();
+		_out._fields.push_back(ref);
+		_slotRowDependent.push_back(IsRowField(ref) ? 1 : 0);
+		_fieldSlots.emplace(name, slot);
+		return slot;
+	}
+
+	void ParseAssignment()
+	{
+		if (_token.kind != TokenKind::Ident)
+			Fail("대입할 필드 이름이 필요합니다");
+
+		std::string name = _token.text;
+		int slot = FieldSlot(name);
+		const auto& field = _out._fields[slot];
+		if (field.readOnly)
+			Fail("'" + name + "' 는 읽기 전용입니다");
+
+		Next();
+
+		static const char* ops[] = { "=", "+=", "-=", "*=", "/=" };
+		static const BulkEditProgram::OpCode codes[] = {
+			BulkEditProgram::OpCode::Const, BulkEditProgram::OpCode::Add, BulkEditProgram::OpCode::Sub,
+			BulkEditProgram::OpCode::Mul, BulkEditProgram::OpCode::Div
+		};
+
+		int opIndex = -1;
+		for (int i = 0; i < 5; ++i)
+		{
+			if (IsSymbol(ops[i]))
+				opIndex = i;
+		}
+		if (opIndex < 0)
+			Fail("대입 연산자 (= += -= *= /=) 가 필요합니다");
+		Next();
+
+		Value value = ParseExpr();
+		if (value.isString != field.isString)
+			Fail("'" + name + "' 에 " + (field.isString ? "숫자" : "문자열") + "를 대입할 수 없습니다");
+
+		int reg = value.reg;
+		if (opIndex > 0)
+		{
+			if (field.isString)
+				Fail("문자열 필드에는 = 만 쓸 수 있습니다");
+
+			int current = Emit(BulkEditProgram::OpCode::Field, slot);
+			reg = Emit(codes[opIndex], current, value.reg);
+		}
+
+		// 레코드 필드는 레코드의 모든 행이 같은 값을 써야 함 (행마다 다르면 어느 행 값이 남을지 정해지지 않음)
+		bool rowField = IsRowField(_out._fields[slot]);
+		if (!rowField && _rowDependent[reg])
+			Fail("'" + name + "' 는 레코드 필드이므로 phase / level 등 행마다 다른 값으로 계산할 수 없습니다");
+		_slotRowDependent[slot] = (rowField || _rowDependent[reg]) ? 1 : 0;
+
+		BulkEditProgram::Assignment assignment;
+		assignment.field = slot;
+		assignment.reg = reg;
+		assignment.codeEnd = (int)_out._code.size();
+		_out._assignments.push_back(assignment);
+	}
+
+	Value ParseExpr()
+	{
+		Value lhs = ParseAnd();
+		while (IsIdent("or") || IsSymbol("||"))
+		{
+			Next();
+			Value rhs = ParseAnd();
+			lhs = { Emit(BulkEditProgram::OpCode::Or, RequireNumber(lhs), RequireNumber(rhs)), false };
+		}
+		return lhs;
+	}
+
+	Value ParseAnd()
+	{
+		Value lhs = ParseNot();
+		while (IsIdent("and") || IsSymbol("&&"))
+		{
+			Next();
+			Value rhs = ParseNot();
+			lhs = { Emit(BulkEditProgram::OpCode::And, RequireNumber(lhs), RequireNumber(rhs)), false };
+		}
+		return lhs;
+	}
+
+	Value ParseNot()
+	{
+		if (IsIdent("not") || IsSymbol("!"))
+		{
+			Next();
+			Value operand = ParseNot();
+			return { Emit(BulkEditProgram::OpCode::Not, RequireNumber(operand)), false };
+		}
+		return ParseCompare();
+	}
+
+	Value ParseCompare()
+	{
+		Value lhs = ParseAdd();
+
+		static const char* ops[] = { "==", "!=", "<", "<=", ">", ">=" };
+		static const BulkEditProgram::OpCode codes[] = {
+			BulkEditProgram::OpCode::Eq, BulkEditProgram::OpCode::Ne, BulkEditProgram::OpCode::Lt,
+			BulkEditProgram::OpCode::Le, BulkEditProgram::OpCode::Gt, BulkEditProgram::OpCode::Ge
+		};
+
+		for (int i = 0; i < 6; ++i)
+		{
+			if (!IsSymbol(ops[i]))
+				continue;
+
+			Next();
+			Value rhs = ParseAdd();
+			if (lhs.isString != rhs.isString)
+				Fail("문자열과 숫자는 비교할 수 없습니다");
+			if (lhs.isString && i >= 2)
+				Fail("문자열은 == / != 로만 비교할 수 있습니다");
+
+			return { Emit(codes[i], lhs.reg, rhs.reg), false };
+		}
+		return lhs;
+	}
+
+	Value ParseAdd()
+	{
+		Value lhs = ParseMul();
+		while (IsSymbol("+") || IsSymbol("-"))
+		{
+			auto op = IsSymbol("+") ? BulkEditProgram::OpCode::Add : BulkEditProgram::OpCode::Sub;
+			Next();
+			Value rhs = ParseMul();
+			lhs = { Emit(op, RequireNumber(lhs), RequireNumber(rhs)), false };
+		}
+		return lhs;
+	}
+
+	Value ParseMul()
+	{
+		Value lhs = ParseUnary();
+		while (IsSymbol("*") || IsSymbol("/") || IsSymbol("%"))
+		{
+			auto op = IsSymbol("*") ? BulkEditProgram::OpCode::Mul
+				: IsSymbol("/") ? BulkEditProgram::OpCode::Div : BulkEditProgram::OpCode::Mod;
+			Next();
+			Value rhs = ParseUnary();
+			lhs = { Emit(op, RequireNumber(lhs), RequireNumber(rhs)), false };
+		}
+		return lhs;
+	}
+
+	Value ParseUnary()
+	{
+		if (IsSymbol("-"))
+		{
+			Next();
+			Value operand = ParseUnary();
+			return { Emit(BulkEditProgram::OpCode::Neg, RequireNumber(operand)), false };
+		}
+		return ParsePrimary();
+	}
+
+	Value ParsePrimary()
+	{
+		if (_token.kind == TokenKind::Number)
+		{
+			double number = _token.number;
+			Next();
+			return { Emit(BulkEditProgram::OpCode::Const, -1, -1, -1, number), false };
+		}
+
+		if (_token.kind == TokenKind::String)
+		{
+			int id = StringId(_token.text);
+			Next();
+			return { Emit(BulkEditProgram::OpCode::Const, -1, -1, -1, id), true };
+		}
+
+		if (IsSymbol("("))
+		{
+			Next();
+			Value inner = ParseExpr();
+			Expect(")");
+			return inner;
+		}
+
+		if (_token.kind != TokenKind::Ident)
+			Fail("값이 필요합니다");
+
+		std::string name = _token.text;
+		Next();
+
+		if (!IsSymbol("("))
+		{
+			int slot = FieldSlot(name);
+			return { Emit(BulkEditProgram::OpCode::Field, slot), _out._fields[slot].isString };
+		}
+
+		// 함수 호출
+		Next();
+		std::vector<int> args;
+		if (!IsSymbol(")"))
+		{
+			args.push_back(RequireNumber(ParseExpr()));
+			while (IsSymbol(","))
+			{
+				Next();
+				args.push_back(RequireNumber(ParseExpr()));
+			}
+		}
+		Expect(")");
+
+		struct Function { const char* name; BulkEditProgram::OpCode op; size_t minArgs; size_t maxArgs; };
+		static const Function functions[] = {
+			{ "round", BulkEditProgram::OpCode::Round, 1, 2 },
+			{ "floor", BulkEditProgram::OpCode::Floor, 1, 1 },
+			{ "ceil", BulkEditProgram::OpCode::Ceil, 1, 1 },
+			{ "abs", BulkEditProgram::OpCode::Abs, 1, 1 },
+			{ "min", BulkEditProgram::OpCode::Min, 2, 2 },
+			{ "max", BulkEditProgram::OpCode::Max, 2, 2 },
+			{ "clamp", BulkEditProgram::OpCode::Clamp, 3, 3 },
+		};
+
+		for (const Function& function : functions)
+		{
+			if (name != function.name)
+				continue;
+
+			if (args.size() < function.minArgs || args.size() > function.maxArgs)
+				Fail("'" + name + "' 의 인자 개수가 맞지 않습니다");
+
+			// round(x) 는 round(x, 1)
+			if (function.op == BulkEditProgram::OpCode::Round && args.size() == 1)
+				args.push_back(Emit(BulkEditProgram::OpCode::Const, -1, -1, -1, 1.0));
+
+			args.resize(3, -1);
+			return { Emit(function.op, args[0], args[1], args[2]), false };
+		}
+
+		Fail("알 수 없는 함수 '" + name + "'");
+	}
+
+	bool IsRowField(const BulkEditProgram::FieldRef& field) const
+	{
+		return field.def >= 0 && FieldDefs(_target)[field.def].scope != FieldScope::Record;
+	}
+
+	int RequireNumber(const Value& value)
+	{
+		if (value.isString)
+			Fail("문자열은 계산식에 쓸 수 없습니다");
+		return value.reg;
+	}
+};
+
+bool BulkEditProgram::Compile(BulkEditTarget target, const std::string& source, BulkEditProgram& out, std::string& error)
+{
+	BulkEditCompiler compiler(target, source, out);
+	return compiler.Compile(error);
+}
+
+// ---------------------------------------------------------------------------
+// 실행
+// ---------------------------------------------------------------------------
+
+BulkEditResult BulkEditProgram::Run(const json& records, const std::vector<uint8_t>* recordMask) const
+{
+	using Clock = std::chrono::steady_clock;
+	auto start = Clock::now();
+
+	BulkEditResult result;
+	const auto& defs = FieldDefs(_target);
+	const std::vector<RowRef> rows = EnumerateRows(_target, records);
+	const size_t rowCount = rows.size();
+	result.rows = (int)rowCount;
+
+	// 1) 필드별 열 추출 (문자열은 id 로 바꿔 숫자 열로 다룸)
+	StringPool pool;
+	for (const std::string& str : _strings)
+		pool.Intern(str);
+
+	std::vector<std::vector<double>> columns(_fields.size(), std::vector<double>(rowCount, NaN));
+	for (size_t f = 0; f < _fields.size(); ++f)
+	{
+		const FieldRef& field = _fields[f];
+		std::vector<double>& column = columns[f];
+
+		if (field.isString)
+		{
+			// 경로 탐색은 병렬, id 부여는 풀을 공유하므로 순차
+			const FieldDef& def = defs[field.def];
+			std::vector<const json*> nodes(rowCount, nullptr);
+			ParallelFor(rowCount, 1024, [&](size_t begin, size_t end, unsigned)
+				{
+					for (size_t i = begin; i < end; ++i)
+					{
+						const json* node = Walk(&records[rows[i].record], def.tokens);
+						if (def.wrapped)
+							node = Unwrap(node);
+						nodes[i] = (node && node->is_string()) ? node : nullptr;
+					}
+				});
+
+			for (size_t i = 0; i < rowCount; ++i)
+			{
+				if (nodes[i])
+					column[i] = pool.Intern(nodes[i]->get_ref<const std::string&>());
+			}
+			continue;
+		}
+
+		ParallelFor(rowCount, 1024, [&](size_t begin, size_t end, unsigned)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					const RowRef& row = rows[i];
+					const json& record = records[row.record];
+					const json* node = nullptr;
+
+					if (field.def < 0)
+					{
+						auto blackboard = record.find("blackboard");
+						if (blackboard == record.end() || !blackboard->is_array())
+							continue;
+
+						for (const auto& entry : *blackboard)
+						{
+							if (entry.value("key", std::string()) == field.blackboardKey)
+							{
+								auto value = entry.find("value");
+								node = (value != entry.end()) ? &*value : nullptr;
+								break;
+							}
+						}
+					}
+					else
+					{
+						const FieldDef& def = defs[field.def];
+						if (def.scope == FieldScope::Phase)
+						{
+							column[i] = row.phase;
+							continue;
+						}
+
+						const json* base = &record;
+						if (def.scope == FieldScope::KeyFrame)
+							base = &record["phases"][row.phase]["attributesKeyFrames"][row.keyFrame];
+
+						node = Walk(base, def.tokens);
+						if (def.wrapped)
+							node = Unwrap(node);
+					}
+
+					if (node && node->is_number())
+						column[i] = node->get<double>();
+					else if (node && node->is_boolean())
+						column[i] = node->get<bool>() ? 1.0 : 0.0;
+				}
+			});
+	}
+
+	const std::vector<std::vector<double>> original = columns;
+
+	auto extracted = Clock::now();
+	result.extractMs = std::chrono::duration<double, std::milli>(extracted - start).count();
+
+	// 2) 블록 단위 실행 (명령 하나가 블록의 모든 행을 처리)
+	std::atomic<int> matched{ 0 };
+	ParallelFor(rowCount, BLOCK_SIZE, [&](size_t begin, size_t end, unsigned)
+		{
+			const size_t n = end - begin;
+			std::vector<double> registers((size_t)std::max(1, _registerCount) * BLOCK_SIZE);
+			auto R = [&](int reg) { return registers.data() + (size_t)reg * BLOCK_SIZE; };
+
+			auto run = [&](int from, int to)
+				{
+					for (int pc = from; pc < to; ++pc)
+					{
+						const Instruction& inst = _code[pc];
+						double* d = R(inst.dst);
+						const double* a = (inst.a >= 0 && inst.op != OpCode::Field) ? R(inst.a) : nullptr;
+						const double* b = (inst.b >= 0) ? R(inst.b) : nullptr;
+						const double* c = (inst.c >= 0) ? R(inst.c) : nullptr;
+
+						switch (inst.op)
+						{
+						case OpCode::Field:
+							std::copy(columns[inst.a].begin() + begin, columns[inst.a].begin() + end, d);
+							break;
+						case OpCode::Const:
+							std::fill(d, d + n, inst.constant);
+							break;
+						case OpCode::Add: for (size_t i = 0; i < n; ++i) d[i] = a[i] + b[i]; break;
+						case OpCode::Sub: for (size_t i = 0; i < n; ++i) d[i] = a[i] - b[i]; break;
+						case OpCode::Mul: for (size_t i = 0; i < n; ++i) d[i] = a[i] * b[i]; break;
+						case OpCode::Div: for (size_t i = 0; i < n; ++i) d[i] = a[i] / b[i]; break;
+						case OpCode::Mod: for (size_t i = 0; i < n; ++i) d[i] = std::fmod(a[i], b[i]); break;
+						case OpCode::Neg: for (size_t i = 0; i < n; ++i) d[i] = -a[i]; break;
+						case OpCode::Eq: for (size_t i = 0; i < n; ++i) d[i] = (a[i] == b[i]) ? 1.0 : 0.0; break;
+						case OpCode::Ne: for (size_t i = 0; i < n; ++i) d[i] = (a[i] != b[i]) ? 1.0 : 0.0; break;
+						case OpCode::Lt: for (size_t i = 0; i < n; ++i) d[i] = (a[i] < b[i]) ? 1.0 : 0.0; break;
+						case OpCode::Le: for (size_t i = 0; i < n; ++i) d[i] = (a[i] <= b[i]) ? 1.0 : 0.0; break;
+						case OpCode::Gt: for (size_t i = 0; i < n; ++i) d[i] = (a[i] > b[i]) ? 1.0 : 0.0; break;
+						case OpCode::Ge: for (size_t i = 0; i < n; ++i) d[i] = (a[i] >= b[i]) ? 1.0 : 0.0; break;
+						case OpCode::And: for (size_t i = 0; i < n; ++i) d[i] = (a[i] != 0.0 && b[i] != 0.0) ? 1.0 : 0.0; break;
+						case OpCode::Or: for (size_t i = 0; i < n; ++i) d[i] = (a[i] != 0.0 || b[i] != 0.0) ? 1.0 : 0.0; break;
+						case OpCode::Not: for (size_t i = 0; i < n; ++i) d[i] = (a[i] == 0.0) ? 1.0 : 0.0; break;
+						case OpCode::Round: for (size_t i = 0; i < n; ++i) d[i] = std::nearbyint(a[i] / b[i]) * b[i]; break;
+						case OpCode::Floor: for (size_t i = 0; i < n; ++i) d[i] = std::floor(a[i]); break;
+						case OpCode::Ceil: for (size_t i = 0; i < n; ++i) d[i] = std::ceil(a[i]); break;
+						case OpCode::Abs: for (size_t i = 0; i < n; ++i) d[i] = std::fabs(a[i]); break;
+						case OpCode::Min: for (size_t i = 0; i < n; ++i) d[i] = std::min(a[i], b[i]); break;
+						case OpCode::Max: for (size_t i = 0; i < n; ++i) d[i] = std::max(a[i], b[i]); break;
+						case OpCode::Clamp: for (size_t i = 0; i < n; ++i) d[i] = std::min(std::max(a[i], b[i]), c[i]); break;
+						}
+					}
+				};
+
+			run(0, _filterEnd);
+
+			// NaN (없는 필드) 비교는 항상 거짓이므로 조건도 거짓
+			std::vector<uint8_t> mask(n, 1);
+			if (_filterReg >= 0)
+			{
+				const double* filter = R(_filterReg);
+				for (size_t i = 0; i < n; ++i)
+					mask[i] = (filter[i] != 0.0 && filter[i] == filter[i]) ? 1 : 0;
+			}
+
+			if (recordMask)
+			{
+				for (size_t i = 0; i < n; ++i)
+				{
+					size_t record = (size_t)rows[begin + i].record;
+					mask[i] &= (record < recordMask->size()) ? (*recordMask)[record] : 0;
+				}
+			}
+
+			int blockMatched = 0;
+			for (size_t i = 0; i < n; ++i)
+				blockMatched += mask[i];
+			matched.fetch_add(blockMatched, std::memory_order_relaxed);
+
+			int from = _filterEnd;
+			for (const Assignment& assignment : _assignments)
+			{
+				run(from, assignment.codeEnd);
+				from = assignment.codeEnd;
+
+				const FieldRef& field = _fields[assignment.field];
+				const double* value = R(assignment.reg);
+				double* column = columns[assignment.field].data() + begin;
+				const bool canCreate = field.def >= 0;	// blackboard 항목은 새로 만들지 않음
+
+				// 결과가 NaN/무한대인 행 (원래 없던 필드로 계산 등) 은 그대로 둠
+				for (size_t i = 0; i < n; ++i)
+				{
+					double v = field.isString ? value[i] : SnapValue(value[i], field.isInteger);
+					bool write = mask[i] && std::isfinite(v) && (canCreate || !std::isnan(column[i]));
+					column[i] = write ? v : column[i];
+				}
+			}
+		});
+
+	result.matched = matched.load();
+
+	auto evaluated = Clock::now();
+	result.evaluateMs = std::chrono::duration<double, std::milli>(evaluated - extracted).count();
+
+	// 3) 바뀐 칸만 변경 목록으로 (블록별로 모은 뒤 행 순서대로 이어 붙임)
+	std::vector<int> assignedFields;
+	for (const Assignment& assignment : _assignments)
+	{
+		if (std::find(assignedFields.begin(), assignedFields.end(), assignment.field) == assignedFields.end())
+			assignedFields.push_back(assignment.field);
+	}
+
+	// 레코드 기준 필드는 모든 행에서 경로가 같음
+	std::vector<json::json_pointer> recordPointers(_fields.size());
+	for (int f : assignedFields)
+	{
+		if (_fields[f].def < 0)
+			continue;
+
+		for (const std::string& token : defs[_fields[f].def].tokens)
+			recordPointers[f] /= token;
+	}
+
+	// 행이 여러 개인 레코드 (오퍼레이터) 의 레코드 필드는 행마다 같은 값이므로 (컴파일 때 행 값에 기대는 식은 막음)
+	// 레코드에서 처음 바뀐 행에서만 변경 하나로 (같은 경로를 여러 번 쓰지 않음)
+	auto changed = [&](int f, size_t i)
+		{
+			double before = original[f][i];
+			double after = columns[f][i];
+			return before != after && !(std::isnan(before) && std::isnan(after));
+		};
+
+	std::vector<std::vector<uint8_t>> recordOwner(_fields.size());
+	if (_target == BulkEditTarget::Operator)
+	{
+		for (int f : assignedFields)
+		{
+			if (_fields[f].def >= 0 && defs[_fields[f].def].scope != FieldScope::Record)
+				continue;
+
+			std::vector<uint8_t>& owner = recordOwner[f];
+			owner.assign(rowCount, 0);
+			int ownedRecord = -1;
+			for (size_t i = 0; i < rowCount; ++i)
+			{
+				if (rows[i].record != ownedRecord && changed(f, i))
+				{
+					owner[i] = 1;
+					ownedRecord = rows[i].record;
+				}
+			}
+		}
+	}
+
+	const size_t blockCount = (rowCount + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	std::vector<std::vector<BulkEditChange>> blockChanges(blockCount);
+	std::vector<int> blockChangedRows(blockCount, 0);
+
+	ParallelFor(rowCount, BLOCK_SIZE, [&](size_t begin, size_t end, unsigned)
+		{
+			std::vector<BulkEditChange>& out = blockChanges[begin / BLOCK_SIZE];
+
+			for (size_t i = begin; i < end; ++i)
+			{
+				const RowRef& row = rows[i];
+				const json& record = records[row.record];
+				std::string label;
+				bool rowChanged = false;
+
+				for (int f : assignedFields)
+				{
+					if (!changed(f, i) || (!recordOwner[f].empty() && !recordOwner[f][i]))
+						continue;
+					double after = columns[f][i];
+
+					const FieldRef& field = _fields[f];
+					json value = field.isString ? json(pool.strings[(size_t)after])
+						: field.isInteger ? json((int64_t)after) : json(after);
+
+					BulkEditChange change;
+					change.record = row.record;
+					change.row = (int)i;
+					change.field = field.name;
+
+					if (field.def < 0)
+					{
+						// blackboard 값은 있는 항목만 바꿈 (없으면 추출 단계에서 NaN 이라 여기까지 오지 않음)
+						const json& blackboard = record["blackboard"];
+						for (size_t e = 0; e < blackboard.size(); ++e)
+						{
+							if (blackboard[e].value("key", std::string()) == field.blackboardKey)
+							{
+								change.pointer = json::json_pointer("/blackboard/" + std::to_string(e) + "/value");
+								change.before = blackboard[e]["value"];
+								break;
+							}
+						}
+						change.after = value;
+					}
+					else
+					{
+						const FieldDef& def = defs[field.def];
+						const json* base = &record;
+						if (def.scope == FieldScope::KeyFrame)
+						{
+							base = &record["phases"][row.phase]["attributesKeyFrames"][row.keyFrame];
+							change.pointer = KeyFramePointer(row) / recordPointers[f];
+						}
+						else
+						{
+							change.pointer = recordPointers[f];
+						}
+
+						// 필드를 새로 만드는 건 바로 위 객체가 있을 때만 (value[0] 이 없는 적 등은 건너뜀)
+						const json* node = Walk(base, def.tokens);
+						if (!node)
+						{
+							std::vector<std::string> parentTokens(def.tokens.begin(), def.tokens.end() - 1);
+							const json* parent = Walk(base, parentTokens);
+							if (!parent || !parent->is_object())
+								continue;
+						}
+
+						change.before = node ? *node : json();
+						if (def.wrapped)
+						{
+							change.after = change.before.is_object() ? change.before : json::object();
+							change.after["m_defined"] = true;
+							change.after["m_value"] = value;
+						}
+						else
+						{
+							change.after = value;
+						}
+					}
+
+					if (label.empty())
+						label = RowLabel(_target, record, row);
+					change.label = label;
+
+					out.push_back(std::move(change));
+					rowChanged = true;
+				}
+
+				if (rowChanged)
+					++blockChangedRows[begin / BLOCK_SIZE];
+			}
+		});
+
+	size_t changeCount = 0;
+	for (const auto& changes : blockChanges)
+		changeCount += changes.size();
+
+	result.changes.reserve(changeCount);
+	for (size_t block = 0; block < blockCount; ++block)
+	{
+		std::move(blockChanges[block].begin(), blockChanges[block].end(), std::back_inserter(result.changes));
+		result.changedRows += blockChangedRows[block];
+	}
+
+	result.diffMs = std::chrono::duration<double, std::milli>(Clock::now() - evaluated).count();
+	result.ok = true;
+	return result;
+}
+
+void BulkEditResult::Apply(json& records) const
+{
+	for (const BulkEditChange& change : changes)
+		records[change.record][change.pointer] = change.after;
+}
+
+bool BulkEditResult::Matches(const json& records, bool applied) const
+{
+	for (const BulkEditChange& change : changes)
+	{
+		if (change.record < 0 || change.record >= (int)records.size())
+			return false;
+
+		const json& record = records[change.record];
+		const json& expected = applied ? change.after : change.before;
+		bool exists = record.contains(change.pointer);
+
+		if (expected.is_null() ? exists : (!exists || record.at(change.pointer) != expected))
+			return false;
+	}
+	return true;
+}
+
+void BulkEditResult::Revert(json& records) const
+{
+	for (auto it = changes.rbegin(); it != changes.rend(); ++it)
+	{
+		json& record = records[it->record];
+		if (it->before.is_null())
+			record[it->pointer.parent_pointer()].erase(it->pointer.back());
+		else
+			record[it->pointer] = it->before;
+	}
+}
+
+std::unique_ptr<EditCommand> MakeBulkEditCommand(RecordEditTarget* target, const BulkEditResult& edit, bool reverted, const std::string& label)
+{
+	// before 가 null 이면 새로 만든 필드 = 기록에서는 없는 값 (discarded)
+	std::vector<RecordValueChange> changes;
+	changes.reserve(edit.changes.size());
+	for (const BulkEditChange& change : edit.changes)
+	{
+		json before = change.before.is_null() ? json(json::value_t::discarded) : change.before;
+		json after = change.after;
+		if (reverted)
+			std::swap(before, after);
+		changes.push_back({ change.record, InternEditPath(change.pointer.to_string()), std::move(before), std::move(after) });
+	}
+
+	// 되돌릴 때는 적용 순서의 반대로 써야 하므로 뒤집어 둠
+	if (reverted)
+		std::reverse(changes.begin(), changes.end());
+
+	return std::make_unique<RecordValueCommand>(target, std::move(changes), label + " (값 " + std::to_string(edit.changes.size()) + "개)");
+}
@@ -0,0 +1,136 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "GameTables.h"
+#include "EditHistory.h"
+
+// 일괄 편집 대상 테이블 (행 단위)
+// Enemy    : enemies[] 의 value[0] (기본 스탯)
+// Operator : operators[] 의 phases[].attributesKeyFrames[] (키프레임 하나가 한 행)
+// Skill    : skills[]
+enum class BulkEditTarget
+{
+	Enemy = 0,
+	Operator,
+	Skill,
+	MAX
+};
+
+const char* BulkEditTargetName(BulkEditTarget target);
+
+// 대상별로 쓸 수 있는 필드 이름 (도움말 표시용, 스킬은 bb.<key> 로 blackboard 값도 사용 가능)
+std::vector<std::string> BulkEditFieldNames(BulkEditTarget target);
+std::vector<std::string> BulkEditWritableFields(BulkEditTarget target);
+
+// 바뀐 값 하나 (레코드 기준 JSON 포인터, before 가 null 이면 새로 만든 필드)
+struct BulkEditChange
+{
+	int record = -1;
+	int row = -1;
+	std::string label;		// 미리보기 표시용 (key / charId@phase.keyFrame / skillId)
+	std::string field;
+	json::json_pointer pointer;
+	json before;
+	json after;
+};
+
+// 하나의 트랜잭션 (Apply 로 적용, Revert 로 그대로 되돌림)
+struct BulkEditResult
+{
+	bool ok = false;
+	std::string error;
+
+	int rows = 0;
+	int matched = 0;		// where 를 통과한 행
+	int changedRows = 0;
+	std::vector<BulkEditChange> changes;
+
+	double extractMs = 0.0;		// JSON -> 열
+	double evaluateMs = 0.0;	// 열 단위 식 계산
+	double diffMs = 0.0;		// 변경 목록 생성
+
+	void Apply(json& records) const;
+	void Revert(json& records) const;
+
+	// 미리보기 이후 데이터가 바뀌지 않았는지 (applied = 적용 후 상태인지 확인)
+	bool Matches(const json& records, bool applied) const;
+};
+
+// 적용(reverted = false) 또는 되돌린(true) 일괄 편집을 실행 취소 기록 한 단계로
+std::unique_ptr<EditCommand> MakeBulkEditCommand(RecordEditTarget* target, const BulkEditResult& edit, bool reverted, const std::string& label);
+
+// 식 예시
+//   where type == "FLYING" and maxHp > 1000
+//   maxHp = round(maxHp * 1.15, 10); def += 20
+//
+// 문장은 ';' 또는 줄바꿈으로 구분하고, 첫 문장이 where 면 이후 대입은 조건을 만족하는 행에만 적용
+// 대입은 = += -= *= /=, 함수는 round(x[, step]) floor ceil abs min max clamp(x, lo, hi)
+// 문자열 필드는 == / != 비교와 문자열 대입만 가능
+// 오퍼레이터는 키프레임마다 한 행이지만 rarity / name 같은 레코드 필드는 레코드마다 한 번만 바뀌므로
+// phase / level 등 행마다 다른 값으로 계산할 수 없음 (where 조건에는 써도 됨)
+//
+// 컴파일하면 레지스터 기반 명령 목록이 되고, 실행은 필드별 열(double 배열)을 뽑아
+// 블록 단위로 명령마다 열 전체를 한 번에 계산 (분기 없는 단순 루프라 벡터화됨)
+class BulkEditProgram
+{
+public:
+	static bool Compile(BulkEditTarget target, const std::string& source, BulkEditProgram& out, std::string& error);
+
+	BulkEditTarget GetTarget() const { return _target; }
+
+	// records = 대상 배열 (enemies[] / operators[] / skills[]), 원본은 바꾸지 않음
+	// recordMask 가 있으면 값이 1 인 레코드의 행만 대상 (목록 다중 선택)
+	BulkEditResult Run(const json& records, const std::vector<uint8_t>* recordMask = nullptr) const;
+
+private:
+	enum class OpCode
+	{
+		Field, Const,
+		Add, Sub, Mul, Div, Mod, Neg,
+		Eq, Ne, Lt, Le, Gt, Ge,
+		And, Or, Not,
+		Round, Floor, Ceil, Abs, Min, Max, Clamp
+	};
+
+	struct Instruction
+	{
+		OpCode op = OpCode::Const;
+		int dst = 0;
+		int a = -1;
+		int b = -1;
+		int c = -1;
+		double constant = 0.0;
+	};
+
+	struct Assignment
+	{
+		int field = -1;		// _fields 인덱스
+		int reg = -1;		// 대입할 값이 들어 있는 레지스터
+		int codeEnd = 0;	// 이 대입 전까지 실행할 명령 끝
+	};
+
+	// 실행에 필요한 필드 (사용한 것만)
+	struct FieldRef
+	{
+		std::string name;
+		bool isString = false;
+		bool isInteger = false;
+		bool readOnly = false;
+		int def = -1;				// 필드 정의 인덱스 (-1 = blackboard)
+		std::string blackboardKey;
+	};
+
+	BulkEditTarget _target = BulkEditTarget::Enemy;
+	std::vector<FieldRef> _fields;
+	std::vector<Instruction> _code;
+	std::vector<Assignment> _assignments;
+	int _filterReg = -1;		// -1 = 모든 행
+	int _filterEnd = 0;
+	int _registerCount = 0;
+	std::vector<std::string> _strings;	// 문자열 상수 (id = 인덱스)
+
+	friend class BulkEditCompiler;
+};
@@ -0,0 +1,173 @@
+﻿#include "BulkEditWindow.h"
+#include "EnemyEditor.h"
+#include "OperatorEditor.h"
+#include "SkillEditor.h"
+#include <imgui/imgui.h>
+
+#include "Utility.h"
+
+namespace
+{
+	const char* TARGET_NAMES[] = { "적", "오퍼레이터 (키프레임)", "스킬" };
+
+	// { m_defined, m_value } 는 값만 표시
+	std::string FormatValue(const json& value)
+	{
+		if (value.is_null())
+			return "(없음)";
+		if (value.is_object() && value.contains("m_value"))
+			return value["m_value"].dump();
+		return value.dump();
+	}
+}
+
+void BulkEditWindow::RenderGUI(bool* p_open, EnemyEditor& enemyEditor, OperatorEditor& operatorEditor, SkillEditor& skillEditor)
+{
+	ImGui::SetNextWindowSize(ImVec2(800, 600), ImGuiCond_FirstUseEver);
+	ImGui::Begin("일괄 편집", p_open);
+
+	ImGui::SetNextItemWidth(200);
+	ImGui::Combo("대상", &_target, TARGET_NAMES, IM_ARRAYSIZE(TARGET_NAMES));
+
+	ImGui::InputTextMultiline("##BulkEditSource", _source, sizeof(_source), ImVec2(-1, ImGui::GetTextLineHeight() * 6));
+
+	if (ImGui::TreeNode("문법 / 필드"))
+	{
+		ImGui::TextWrapped("where <조건> 다음 줄부터 대입 (';' 또는 줄바꿈으로 구분). 대입: = += -= *= /=");
+		ImGui::TextWrapped("함수: round(x, 단위) floor ceil abs min max clamp(x, lo, hi), 논리: and or not, 문자열은 \"...\"");
+
+		std::string fields;
+		for (const std::string& name : BulkEditFieldNames((BulkEditTarget)_target))
+			fields += (fields.empty() ? "" : ", ") + name;
+		ImGui::TextColored(COLOR_GRAY, "필드: %s", fields.c_str());
+		ImGui::TreePop();
+	}
+
+	if (ImGui::Button("미리보기"))
+		Preview(enemyEditor, operatorEditor, skillEditor);
+
+	ImGui::SameLine();
+
+	bool canApply = _preview.ok && !_preview.changes.empty() && _previewTarget == _target;
+	if (!canApply) ImGui::BeginDisabled();
+	if (ImGui::Button("적용"))
+	{
+		int changes = (int)_preview.changes.size();
+		bool applied = false;
+		switch ((BulkEditTarget)_previewTarget)
+		{
+		case BulkEditTarget::Operator: applied = operatorEditor.ApplyBulkEdit(std::move(_preview)); break;
+		case BulkEditTarget::Skill: applied = skillEditor.ApplyBulkEdit(std::move(_preview)); break;
+		default: applied = enemyEditor.ApplyBulkEdit(std::move(_preview)); break;
+		}
+
+		_status = applied ? "값 " + std::to_string(changes) + "개 적용됨" : "미리보기 후 데이터가 바뀌었습니다. 다시 미리보기 하세요";
+		_preview = BulkEditResult();
+	}
+	if (!canApply) ImGui::EndDisabled();
+
+	ImGui::SameLine();
+
+	bool canUndo = false;
+	switch ((BulkEditTarget)_target)
+	{
+	case BulkEditTarget::Operator: canUndo = operatorEditor.CanUndoBulkEdit(); break;
+	case BulkEditTarget::Skill: canUndo = skillEditor.CanUndoBulkEdit(); break;
+	default: canUndo = enemyEditor.CanUndoBulkEdit(); break;
+	}
+
+	if (!canUndo) ImGui::BeginDisabled();
+	if (ImGui::Button("마지막 일괄 편집 되돌리기"))
+	{
+		bool undone = false;
+		switch ((BulkEditTarget)_target)
+		{
+		case BulkEditTarget::Operator: undone = operatorEditor.UndoBulkEdit(); break;
+		case BulkEditTarget::Skill: undone = skillEditor.UndoBulkEdit(); break;
+		default: undone = enemyEditor.UndoBulkEdit(); break;
+		}
+		_status = undone ? "되돌림" : "적용 후 같은 값을 다시 고쳐서 되돌릴 수 없습니다";
+		_preview = BulkEditResult();
+	}
+	if (!canUndo) ImGui::EndDisabled();
+
+	if (!_error.empty())
+		ImGui::TextColored(COLOR_RED, "%s", _error.c_str());
+	if (!_status.empty())
+		ImGui::TextColored(COLOR_GREEN, "%s", _status.c_str());
+
+	ImGui::Separator();
+
+	if (_preview.ok)
+		RenderPreviewTable();
+
+	ImGui::End();
+}
+
+void BulkEditWindow::Preview(EnemyEditor& enemyEditor, OperatorEditor& operatorEditor, SkillEditor& skillEditor)
+{
+	_error.clear();
+	_status.clear();
+	_preview = BulkEditResult();
+
+	BulkEditProgram program;
+	if (!BulkEditProgram::Compile((BulkEditTarget)_target, _source, program, _error))
+		return;
+
+	switch ((BulkEditTarget)_target)
+	{
+	case BulkEditTarget::Operator:
+		_preview = program.Run(operatorEditor.GetOperatorData()["operators"]);
+		break;
+	case BulkEditTarget::Skill:
+		_preview = program.Run(skillEditor.GetSkillData());
+		break;
+	default:
+		_preview = program.Run(enemyEditor.GetEnemyData()["enemies"]);
+		break;
+	}
+	_previewTarget = _target;
+}
+
+void BulkEditWindow::RenderPreviewTable()
+{
+	ImGui::Text("%d행 중 조건 일치 %d행, 변경 %d행 / 값 %d개",
+		_preview.rows, _preview.matched, _preview.changedRows, (int)_preview.changes.size());
+	ImGui::TextColored(COLOR_GRAY, "추출 %.2f ms / 계산 %.2f ms / 비교 %.2f ms",
+		_preview.extractMs, _preview.evaluateMs, _preview.diffMs);
+
+	if (_preview.changes.empty())
+		return;
+
+	ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+	if (ImGui::BeginTable("BulkEditPreview", 4, flags))
+	{
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("행");
+		ImGui::TableSetupColumn("필드");
+		ImGui::TableSetupColumn("이전");
+		ImGui::TableSetupColumn("이후");
+		ImGui::TableHeadersRow();
+
+		ImGuiListClipper clipper;
+		clipper.Begin((int)_preview.changes.size());
+		while (clipper.Step())
+		{
+			for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+			{
+				const BulkEditChange& change = _preview.changes[i];
+
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", change.label.c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", change.field.c_str());
+				ImGui::TableNextColumn();
+				ImGui::TextColored(COLOR_GRAY, "%s", FormatValue(change.before).c_str());
+				ImGui::TableNextColumn();
+				ImGui::TextColored(COLOR_YELLOW, "%s", FormatValue(change.after).c_str());
+			}
+		}
+		ImGui::EndTable();
+	}
+}
@@ -0,0 +1,28 @@
+﻿#pragma once
+#include <string>
+
+#include "BulkEdit.h"
+
+class EnemyEditor;
+class OperatorEditor;
+class SkillEditor;
+
+// 조건 + 대입식으로 여러 레코드를 한 번에 고치는 창
+// 미리보기에서 바뀌는 값을 모두 보여 주고, 적용은 편집기에 하나의 트랜잭션으로 넘김
+class BulkEditWindow
+{
+public:
+	void RenderGUI(bool* p_open, EnemyEditor& enemyEditor, OperatorEditor& operatorEditor, SkillEditor& skillEditor);
+
+private:
+	int _target = 0;				// BulkEditTarget
+	char _source[2048] = "where type == \"FLYING\"\nmaxHp = round(maxHp * 1.15, 10)";
+
+	BulkEditResult _preview;
+	int _previewTarget = -1;
+	std::string _error;
+	std::string _status;
+
+	void Preview(EnemyEditor& enemyEditor, OperatorEditor& operatorEditor, SkillEditor& skillEditor);
+	void RenderPreviewTable();
+};
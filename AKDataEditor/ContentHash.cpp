@@ -0,0 +1,438 @@
+﻿#include "ContentHash.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+namespace
+{
+	// 값 종류 태그 (타입이 다르면 같은 비트라도 다른 해시)
+	enum : uint64_t
+	{
+		TAG_NULL = 0x6e756c6c,
+		TAG_FALSE,
+		TAG_TRUE,
+		TAG_INT,
+		TAG_UINT,
+		TAG_FLOAT,
+		TAG_STRING,
+		TAG_ARRAY,
+		TAG_OBJECT,
+		TAG_BINARY,
+		TAG_EMPTY_TREE,
+	};
+
+	// splitmix64 마무리 단계
+	uint64_t Mix(uint64_t x)
+	{
+		x ^= x >> 30;
+		x *= 0xbf58476d1ce4e5b9ull;
+		x ^= x >> 27;
+		x *= 0x94d049bb133111ebull;
+		x ^= x >> 31;
+		return x;
+	}
+
+	uint64_t HashBytes(const char* data, size_t size)
+	{
+		// 8바이트씩 섞고 길이로 마무리
+		uint64_t hash = 0x243f6a8885a308d3ull;
+		size_t i = 0;
+		for (; i + 8 <= size; i += 8)
+		{
+			uint64_t chunk;
+			std::memcpy(&chunk, data + i, 8);
+			hash = (hash ^ chunk) * 0x9e3779b97f4a7c15ull;
+			hash ^= hash >> 29;
+		}
+
+		uint64_t tail = 0;
+		std::memcpy(&tail, data + i, size - i);
+		hash = (hash ^ tail) * 0x9e3779b97f4a7c15ull;
+		return Mix(hash ^ size);
+	}
+
+	uint64_t HashObject(const json& value, const char* skipA, const char* skipB)
+	{
+		uint64_t hash = TAG_OBJECT;
+		for (auto it = value.begin(); it != value.end(); ++it)
+		{
+			if ((skipA && it.key() == skipA) || (skipB && it.key() == skipB))
+				continue;
+			hash = HashCombine(hash, HashString(it.key()));
+			hash = HashCombine(hash, HashJson(it.value()));
+		}
+		return HashCombine(hash, value.size());
+	}
+
+	uint64_t LeafOf(const std::string& key, uint64_t hash)
+	{
+		return HashCombine(HashString(key), hash);
+	}
+}
+
+uint64_t HashCombine(uint64_t seed, uint64_t value)
+{
+	return Mix(seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)));
+}
+
+uint64_t HashString(const std::string& text)
+{
+	return HashBytes(text.data(), text.size());
+}
+
+uint64_t HashJson(const json& value)
+{
+	switch (value.type())
+	{
+	case json::value_t::null:
+		return Mix(TAG_NULL);
+	case json::value_t::boolean:
+		return Mix(value.get<bool>() ? TAG_TRUE : TAG_FALSE);
+	case json::value_t::number_integer:
+		return HashCombine(TAG_INT, (uint64_t)value.get<int64_t>());
+	case json::value_t::number_unsigned:
+		return HashCombine(TAG_UINT, value.get<uint64_t>());
+	case json::value_t::number_float:
+	{
+		double number = value.get<double>();
+		if (number == 0.0)
+			number = 0.0;		// -0 과 0 은 같은 값으로 저장됨
+		uint64_t bits;
+		std::memcpy(&bits, &number, sizeof(bits));
+		return HashCombine(TAG_FLOAT, bits);
+	}
+	case json::value_t::string:
+		return HashCombine(TAG_STRING, HashString(value.get_ref<const std::string&>()));
+	case json::value_t::array:
+	{
+		uint64_t hash = TAG_ARRAY;
+		for (const json& element : value)
+			hash = HashCombine(hash, HashJson(element));
+		return HashCombine(hash, value.size());
+	}
+	case json::value_t::object:
+		return HashObject(value, nullptr, nullptr);
+	case json::value_t::binary:
+	{
+		const auto& bytes = value.get_binary();
+		return HashCombine(TAG_BINARY, HashBytes((const char*)bytes.data(), bytes.size()));
+	}
+	default:
+		return Mix(TAG_NULL);
+	}
+}
+
+void MerkleTree::Build(const std::vector<uint64_t>& leaves)
+{
+	_count = leaves.size();
+	_nodes.assign(_count * 2, 0);
+	std::copy(leaves.begin(), leaves.end(), _nodes.begin() + _count);
+
+	for (size_t i = _count - 1; i >= 1 && i < _count; --i)
+		_nodes[i] = HashCombine(_nodes[i * 2], _nodes[i * 2 + 1]);
+}
+
+void MerkleTree::Set(int leaf, uint64_t hash)
+{
+	size_t node = _count + (size_t)leaf;
+	_nodes[node] = hash;
+
+	for (node >>= 1; node >= 1; node >>= 1)
+		_nodes[node] = HashCombine(_nodes[node * 2], _nodes[node * 2 + 1]);
+}
+
+uint64_t MerkleTree::Root() const
+{
+	if (_count == 0)
+		return Mix(TAG_EMPTY_TREE);
+	return HashCombine(_nodes[1], _count);
+}
+
+void RecordHashTable::Clear()
+{
+	_keys.clear();
+	_hashes.clear();
+	_tree.Build({});
+
+	_savedValid = false;
+	_savedKeys.clear();
+	_savedHashes.clear();
+	_savedTree.Build({});
+	_savedIndex.clear();
+}
+
+void RecordHashTable::Build(std::vector<std::string> keys, std::vector<uint64_t> hashes)
+{
+	_keys = std::move(keys);
+	_hashes = std::move(hashes);
+
+	std::vector<uint64_t> leaves(_keys.size());
+	for (size_t i = 0; i < _keys.size(); ++i)
+		leaves[i] = LeafOf(_keys[i], _hashes[i]);
+	_tree.Build(leaves);
+}
+
+void RecordHashTable::Set(int record, const std::string& key, uint64_t hash)
+{
+	if (record < 0 || record >= (int)_keys.size())
+		return;
+
+	_keys[record] = key;
+	_hashes[record] = hash;
+	_tree.Set(record, LeafOf(key, hash));
+}
+
+void RecordHashTable::MarkSaved()
+{
+	_savedValid = true;
+	_savedKeys = _keys;
+	_savedHashes = _hashes;
+	_savedTree = _tree;
+
+	_savedIndex.clear();
+	_savedIndex.reserve(_savedKeys.size());
+	for (int i = 0; i < (int)_savedKeys.size(); ++i)
+		_savedIndex[_savedKeys[i]] = i;
+}
+
+void RecordHashTable::SetSaved(const std::string& key, uint64_t hash)
+{
+	if (!_savedValid)
+		return;
+
+	auto found = _savedIndex.find(key);
+	if (found != _savedIndex.end())
+	{
+		_savedHashes[found->second] = hash;
+		_savedTree.Set(found->second, LeafOf(key, hash));
+		return;
+	}
+
+	_savedKeys.push_back(key);
+	_savedHashes.push_back(hash);
+	RebuildSaved();
+}
+
+void RecordHashTable::DropSaved(const std::string& key)
+{
+	auto found = _savedIndex.find(key);
+	if (!_savedValid || found == _savedIndex.end())
+		return;
+
+	_savedKeys.erase(_savedKeys.begin() + found->second);
+	_savedHashes.erase(_savedHashes.begin() + found->second);
+	RebuildSaved();
+}
+
+void RecordHashTable::RebuildSaved()
+{
+	std::vector<uint64_t> leaves(_savedKeys.size());
+	_savedIndex.clear();
+	_savedIndex.reserve(_savedKeys.size());
+	for (int i = 0; i < (int)_savedKeys.size(); ++i)
+	{
+		leaves[i] = LeafOf(_savedKeys[i], _savedHashes[i]);
+		_savedIndex[_savedKeys[i]] = i;
+	}
+	_savedTree.Build(leaves);
+}
+
+bool RecordHashTable::IsDirty() const
+{
+	return !_savedValid || _tree.Root() != _savedTree.Root();
+}
+
+bool RecordHashTable::IsRecordDirty(int record) const
+{
+	if (!_savedValid || record < 0 || record >= (int)_keys.size())
+		return true;
+
+	auto found = _savedIndex.find(_keys[record]);
+	return found == _savedIndex.end() || _savedHashes[found->second] != _hashes[record];
+}
+
+RecordChangeSummary RecordHashTable::Diff() const
+{
+	RecordChangeSummary summary;
+	if (!_savedValid)
+	{
+		summary.added = _keys;
+		return summary;
+	}
+
+	std::unordered_set<std::string> current;
+	current.reserve(_keys.size());
+	for (int i = 0; i < (int)_keys.size(); ++i)
+	{
+		current.insert(_keys[i]);
+
+		auto found = _savedIndex.find(_keys[i]);
+		if (found == _savedIndex.end())
+			summary.added.push_back(_keys[i]);
+		else if (_savedHashes[found->second] != _hashes[i])
+			summary.changed.push_back(_keys[i]);
+	}
+
+	for (const std::string& key : _savedKeys)
+	{
+		if (!current.count(key))
+			summary.removed.push_back(key);
+	}
+	return summary;
+}
+
+namespace
+{
+	// routes / waves 는 없음과 빈 배열을 구분
+	uint64_t HashLevelRest(const json& fullData)
+	{
+		auto routes = fullData.find("routes");
+		uint64_t rest = HashObject(fullData, "routes", "waves");
+		return HashCombine(rest, routes != fullData.end() ? (routes->is_array() ? 1 : HashJson(*routes)) : 0);
+	}
+
+	void ComposeLevelRoot(LevelContentHash& hash)
+	{
+		if (!hash.structured)
+		{
+			hash.root = HashCombine(hash.rest, hash.extra);
+			return;
+		}
+
+		uint64_t root = HashCombine(hash.rest, hash.routeTree.Root());
+		root = HashCombine(root, hash.waveShape);
+		root = HashCombine(root, hash.fragmentTree.Root());
+		hash.root = HashCombine(root, hash.extra);
+	}
+}
+
+LevelContentHash HashLevelContent(const json& fullData, uint64_t extra)
+{
+	LevelContentHash hash;
+	hash.extra = extra;
+	if (!fullData.is_object())
+	{
+		hash.rest = HashJson(fullData);
+		ComposeLevelRoot(hash);
+		return hash;
+	}
+	hash.structured = true;
+
+	auto routes = fullData.find("routes");
+	if (routes != fullData.end() && routes->is_array())
+	{
+		hash.routes.reserve(routes->size());
+		for (const json& route : *routes)
+			hash.routes.push_back(HashJson(route));
+	}
+
+	// 웨이브 자체 필드 + 웨이브별 Fragment 수, Fragment 는 따로 잎으로
+	uint64_t waveShape = TAG_ARRAY;
+	auto waves = fullData.find("waves");
+	if (waves != fullData.end() && waves->is_array())
+	{
+		for (const json& wave : *waves)
+		{
+			if (!wave.is_object())
+			{
+				waveShape = HashCombine(waveShape, HashJson(wave));
+				hash.waveFragments.push_back(-1);
+				continue;
+			}
+
+			waveShape = HashCombine(waveShape, HashObject(wave, "fragments", nullptr));
+
+			auto fragments = wave.find("fragments");
+			if (fragments == wave.end() || !fragments->is_array())
+			{
+				waveShape = HashCombine(waveShape, fragments == wave.end() ? Mix(TAG_NULL) : HashJson(*fragments));
+				hash.waveFragments.push_back(-1);
+				continue;
+			}
+
+			waveShape = HashCombine(waveShape, fragments->size());
+			hash.waveFragments.push_back((int)fragments->size());
+			for (const json& fragment : *fragments)
+				hash.fragments.push_back(HashJson(fragment));
+		}
+		waveShape = HashCombine(waveShape, waves->size());
+	}
+	else if (waves != fullData.end())
+	{
+		waveShape = HashJson(*waves);
+	}
+
+	hash.rest = HashLevelRest(fullData);
+	hash.waveShape = waveShape;
+	hash.routeTree.Build(hash.routes);
+	hash.fragmentTree.Build(hash.fragments);
+	ComposeLevelRoot(hash);
+	return hash;
+}
+
+bool RehashLevelRoute(LevelContentHash& hash, const json& fullData, int route)
+{
+	if (!hash.structured || !fullData.is_object())
+		return false;
+
+	auto routes = fullData.find("routes");
+	if (routes == fullData.end() || !routes->is_array() || routes->size() != hash.routes.size())
+		return false;
+	if (route < 0 || route >= (int)hash.routes.size())
+		return false;
+
+	hash.routes[route] = HashJson((*routes)[route]);
+	hash.routeTree.Set(route, hash.routes[route]);
+	ComposeLevelRoot(hash);
+	return true;
+}
+
+bool RehashLevelFragment(LevelContentHash& hash, const json& fullData, int wave, int fragment)
+{
+	if (!hash.structured || !fullData.is_object())
+		return false;
+
+	auto waves = fullData.find("waves");
+	if (waves == fullData.end() || !waves->is_array() || waves->size() != hash.waveFragments.size())
+		return false;
+	if (wave < 0 || wave >= (int)waves->size())
+		return false;
+
+	// 웨이브마다 Fragment 수가 캐시와 같아야 잎 하나만 바뀐 것 (추가/삭제는 waveShape 도 바뀌므로 다시 만듦)
+	for (size_t w = 0; w < waves->size(); ++w)
+	{
+		const json& item = (*waves)[w];
+		auto fragments = item.is_object() ? item.find("fragments") : item.end();
+		int count = (item.is_object() && fragments != item.end() && fragments->is_array()) ? (int)fragments->size() : -1;
+		if (count != hash.waveFragments[w])
+			return false;
+	}
+
+	// 앞 웨이브들의 Fragment 수만큼 밀린 위치
+	if (fragment < 0 || fragment >= hash.waveFragments[wave])
+		return false;
+	size_t flat = fragment;
+	for (int w = 0; w < wave; ++w)
+		flat += std::max(hash.waveFragments[w], 0);
+
+	hash.fragments[flat] = HashJson((*waves)[wave]["fragments"][fragment]);
+	hash.fragmentTree.Set((int)flat, hash.fragments[flat]);
+	ComposeLevelRoot(hash);
+	return true;
+}
+
+bool RehashLevelRest(LevelContentHash& hash, const json& fullData)
+{
+	if (!hash.structured || !fullData.is_object())
+		return false;
+
+	hash.rest = HashLevelRest(fullData);
+	ComposeLevelRoot(hash);
+	return true;
+}
+
+void RehashLevelExtra(LevelContentHash& hash, uint64_t extra)
+{
+	hash.extra = extra;
+	ComposeLevelRoot(hash);
+}
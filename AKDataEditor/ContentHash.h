@@ -0,0 +1,110 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::ordered_json;
+
+// 레코드 내용 해시 (키 순서와 값 타입까지 반영: 1 과 1.0 은 다름, 저장하면 파일 내용이 다르므로)
+uint64_t HashJson(const json& value);
+uint64_t HashString(const std::string& text);
+uint64_t HashCombine(uint64_t seed, uint64_t value);
+
+// 잎 해시 배열 위의 머클 트리 (노드 i 의 자식 = 2i, 2i+1, 잎 = [n, 2n))
+// 잎 하나를 바꾸면 뿌리까지의 노드만 다시 계산
+class MerkleTree
+{
+public:
+	void Build(const std::vector<uint64_t>& leaves);
+	void Set(int leaf, uint64_t hash);
+
+	// 잎 수까지 섞은 뿌리 (잎이 추가/삭제되면 바뀜)
+	uint64_t Root() const;
+	uint64_t Leaf(int leaf) const { return _nodes[_count + (size_t)leaf]; }
+	int Count() const { return (int)_count; }
+
+private:
+	std::vector<uint64_t> _nodes;
+	size_t _count = 0;
+};
+
+// 저장된 상태와 비교한 레코드 키 목록
+struct RecordChangeSummary
+{
+	std::vector<std::string> changed;
+	std::vector<std::string> added;
+	std::vector<std::string> removed;
+
+	int Count() const { return (int)(changed.size() + added.size() + removed.size()); }
+	bool Empty() const { return Count() == 0; }
+};
+
+// 테이블 하나의 현재 / 저장된 레코드 해시
+// 잎 = 레코드 키 + 내용 해시, "저장 안 됨" = 현재 뿌리와 저장된 뿌리가 다름 (값을 원래대로 고치면 다시 같아짐)
+class RecordHashTable
+{
+public:
+	// 저장된 상태를 모름 (다시 읽는 중 등): MarkSaved 전까지 항상 바뀜으로 봄
+	void Clear();
+
+	// 구조가 바뀜 (추가/삭제/일괄 편집): 처음부터 만듦
+	void Build(std::vector<std::string> keys, std::vector<uint64_t> hashes);
+	// 레코드 하나만 바뀜
+	void Set(int record, const std::string& key, uint64_t hash);
+
+	// 현재 상태 전체가 파일과 같음 (읽기/저장 직후)
+	void MarkSaved();
+	// 레코드 하나의 파일 상태 (0 = 파일과 다름, 마이그레이션 등) / 파일이 지워짐
+	void SetSaved(const std::string& key, uint64_t hash);
+	void DropSaved(const std::string& key);
+
+	bool IsDirty() const;
+	bool IsRecordDirty(int record) const;
+	uint64_t ContentHash(int record) const { return _hashes[(size_t)record]; }
+	int Count() const { return (int)_keys.size(); }
+
+	// 바뀐 / 새로 생긴 / 없어진 레코드 키 (O(n), 요약을 볼 때만)
+	RecordChangeSummary Diff() const;
+
+private:
+	std::vector<std::string> _keys;
+	std::vector<uint64_t> _hashes;
+	MerkleTree _tree;
+
+	bool _savedValid = false;
+	std::vector<std::string> _savedKeys;
+	std::vector<uint64_t> _savedHashes;
+	MerkleTree _savedTree;
+	std::unordered_map<std::string, int> _savedIndex;
+
+	void RebuildSaved();
+};
+
+// 레벨 하나의 해시 (경로 / Fragment 별 해시를 따로 들고 있어 어느 것이 바뀌었는지 알 수 있음)
+struct LevelContentHash
+{
+	uint64_t root = 0;
+	std::vector<uint64_t> routes;		// routes[i]
+	std::vector<uint64_t> fragments;	// waves[].fragments[] 를 순서대로 편 것
+	std::vector<int> waveFragments;		// 웨이브별 Fragment 수 (fragments 배열이 없는 웨이브는 -1)
+
+	// 뿌리를 이루는 부분 값 (잎 하나가 바뀌면 트리 경로와 이 값들로 뿌리만 다시 섞음)
+	bool structured = false;			// fullData 가 객체 (아니면 rest = 전체 해시)
+	uint64_t rest = 0;					// routes / waves 밖의 필드
+	uint64_t waveShape = 0;				// 웨이브 자체 필드 + 웨이브별 Fragment 수
+	uint64_t extra = 0;
+	MerkleTree routeTree;
+	MerkleTree fragmentTree;
+};
+
+// extra = fullData 밖에 있는 저장 값 (편집기 완성 상태 등)
+LevelContentHash HashLevelContent(const json& fullData, uint64_t extra);
+
+// 한 부분만 바뀐 경우: 그 잎/부분 값만 다시 해시하고 뿌리는 O(depth)
+// 배열 길이가 바뀌는 등 구조가 캐시와 맞지 않으면 false (HashLevelContent 로 다시 만들어야 함)
+bool RehashLevelRoute(LevelContentHash& hash, const json& fullData, int route);
+bool RehashLevelFragment(LevelContentHash& hash, const json& fullData, int wave, int fragment);
+bool RehashLevelRest(LevelContentHash& hash, const json& fullData);		// options / mapData 등
+void RehashLevelExtra(LevelContentHash& hash, uint64_t extra);
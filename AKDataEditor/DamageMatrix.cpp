@@ -0,0 +1,182 @@
+﻿#include "DamageMatrix.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DAMAGE_MATRIX_SSE 1
+#endif
+
+namespace
+{
+	constexpr int SIMD_WIDTH = 4;
+	constexpr float MIN_DAMAGE_RATIO = 0.05f;
+	constexpr float INF = std::numeric_limits<float>::infinity();
+	constexpr size_t ROW_BLOCK = 16;	// 스레드당 오퍼레이터 블록
+}
+
+void DamageMatrixEngine::SetOperators(const std::vector<OperatorStats>& operators)
+{
+	size_t count = operators.size();
+	_opAtk.resize(count);
+	_opInterval.resize(count);
+	_opArts.resize(count);
+	_opMelee.resize(count);
+	_opHealer.resize(count);
+
+	for (size_t i = 0; i < count; ++i)
+		WriteOperator((int)i, operators[i]);
+
+	_matrix.rows = (int)count;
+}
+
+void DamageMatrixEngine::SetEnemies(const std::vector<EnemyStats>& enemies)
+{
+	_enemyCount = (int)enemies.size();
+	size_t stride = (size_t)(_enemyCount + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+
+	_enemyDef.assign(stride, 0.0f);
+	_enemyRes.assign(stride, 0.0f);
+	_enemyHp.assign(stride, 0.0f);
+	_enemyFlying.assign(stride, 0.0f);
+
+	for (int i = 0; i < _enemyCount; ++i)
+		WriteEnemy(i, enemies[i]);
+
+	_matrix.cols = _enemyCount;
+	_matrix.stride = (int)stride;
+}
+
+void DamageMatrixEngine::WriteOperator(int index, const OperatorStats& stats)
+{
+	_opAtk[index] = (float)stats.atk;
+	_opInterval[index] = (float)std::max(0.01, stats.baseAttackTime);
+	_opArts[index] = stats.DealsArtsDamage() ? 1 : 0;
+	_opMelee[index] = stats.IsMelee() ? 1 : 0;
+	_opHealer[index] = stats.IsHealer() ? 1 : 0;
+}
+
+void DamageMatrixEngine::WriteEnemy(int index, const EnemyStats& stats)
+{
+	_enemyDef[index] = (float)stats.def;
+	_enemyRes[index] = (float)stats.magicResistance;
+	_enemyHp[index] = (float)stats.maxHp;
+	_enemyFlying[index] = stats.isFlying ? 1.0f : 0.0f;
+}
+
+void DamageMatrixEngine::Allocate()
+{
+	size_t size = (size_t)_matrix.rows * _matrix.stride;
+	_matrix.dps.resize(size);
+	_matrix.timeToKill.resize(size);
+	_matrix.effectiveHp.resize(size);
+}
+
+void DamageMatrixEngine::Compute()
+{
+	Allocate();
+
+	ParallelFor((size_t)_matrix.rows, ROW_BLOCK, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t row = begin; row < end; ++row)
+				ComputeRow((int)row);
+		});
+}
+
+void DamageMatrixEngine::UpdateOperator(int index, const OperatorStats& stats)
+{
+	if (index < 0 || index >= _matrix.rows)
+		return;
+
+	WriteOperator(index, stats);
+	ComputeRow(index);
+}
+
+void DamageMatrixEngine::UpdateEnemy(int index, const EnemyStats& stats)
+{
+	if (index < 0 || index >= _enemyCount)
+		return;
+
+	WriteEnemy(index, stats);
+	for (int row = 0; row < _matrix.rows; ++row)
+		ComputeCell(row, index);
+}
+
+void DamageMatrixEngine::ComputeCell(int row, int col)
+{
+	float atk = _opAtk[row];
+	float damage = _opArts[row] ? atk * (1.0f - _enemyRes[col]) : atk - _enemyDef[col];
+	damage = std::max(damage, atk * MIN_DAMAGE_RATIO);
+
+	bool canHit = !_opHealer[row] && !(_opMelee[row] && _enemyFlying[col] != 0.0f);
+	float dps = canHit ? damage / _opInterval[row] : 0.0f;
+
+	size_t cell = (size_t)row * _matrix.stride + col;
+	_matrix.dps[cell] = dps;
+	_matrix.timeToKill[cell] = (dps > 0.0f) ? _enemyHp[col] / dps : INF;
+	_matrix.effectiveHp[cell] = (damage > 0.0f) ? _enemyHp[col] * atk / damage : INF;
+}
+
+void DamageMatrixEngine::ComputeRow(int row)
+{
+	const int stride = _matrix.stride;
+	float* outDps = _matrix.dps.data() + (size_t)row * stride;
+	float* outTtk = _matrix.timeToKill.data() + (size_t)row * stride;
+	float* outEhp = _matrix.effectiveHp.data() + (size_t)row * stride;
+
+	const float atk = _opAtk[row];
+	const float invInterval = 1.0f / _opInterval[row];
+	const float floorDamage = atk * MIN_DAMAGE_RATIO;
+	const bool arts = _opArts[row] != 0;
+	const bool melee = _opMelee[row] != 0;
+	const float rowScale = _opHealer[row] ? 0.0f : invInterval;
+
+#ifdef DAMAGE_MATRIX_SSE
+	const __m128 vAtk = _mm_set1_ps(atk);
+	const __m128 vFloor = _mm_set1_ps(floorDamage);
+	const __m128 vScale = _mm_set1_ps(rowScale);
+	const __m128 vOne = _mm_set1_ps(1.0f);
+	const __m128 vZero = _mm_setzero_ps();
+	const __m128 vInf = _mm_set1_ps(INF);
+
+	for (int col = 0; col < stride; col += SIMD_WIDTH)
+	{
+		__m128 hp = _mm_loadu_ps(&_enemyHp[col]);
+
+		__m128 damage = arts
+			? _mm_mul_ps(vAtk, _mm_sub_ps(vOne, _mm_loadu_ps(&_enemyRes[col])))
+			: _mm_sub_ps(vAtk, _mm_loadu_ps(&_enemyDef[col]));
+		damage = _mm_max_ps(damage, vFloor);
+
+		__m128 dps = _mm_mul_ps(damage, vScale);
+		if (melee)
+			dps = _mm_mul_ps(dps, _mm_sub_ps(vOne, _mm_loadu_ps(&_enemyFlying[col])));
+
+		// 0 으로 나누는 칸은 inf 로 대체
+		__m128 hasDps = _mm_cmpgt_ps(dps, vZero);
+		__m128 ttk = _mm_div_ps(hp, _mm_or_ps(dps, _mm_andnot_ps(hasDps, vOne)));
+		ttk = _mm_or_ps(_mm_and_ps(hasDps, ttk), _mm_andnot_ps(hasDps, vInf));
+
+		__m128 hasDamage = _mm_cmpgt_ps(damage, vZero);
+		__m128 ehp = _mm_div_ps(_mm_mul_ps(hp, vAtk), _mm_or_ps(damage, _mm_andnot_ps(hasDamage, vOne)));
+		ehp = _mm_or_ps(_mm_and_ps(hasDamage, ehp), _mm_andnot_ps(hasDamage, vInf));
+
+		_mm_storeu_ps(outDps + col, dps);
+		_mm_storeu_ps(outTtk + col, ttk);
+		_mm_storeu_ps(outEhp + col, ehp);
+	}
+#else
+	// 분기 없는 형태로 작성해 컴파일러 자동 벡터화에 맡김
+	for (int col = 0; col < stride; ++col)
+	{
+		float damage = arts ? atk * (1.0f - _enemyRes[col]) : atk - _enemyDef[col];
+		damage = std::max(damage, floorDamage);
+
+		float dps = damage * rowScale * (melee ? 1.0f - _enemyFlying[col] : 1.0f);
+		outDps[col] = dps;
+		outTtk[col] = (dps > 0.0f) ? _enemyHp[col] / dps : INF;
+		outEhp[col] = (damage > 0.0f) ? _enemyHp[col] * atk / damage : INF;
+	}
+#endif
+}
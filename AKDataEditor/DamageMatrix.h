@@ -0,0 +1,61 @@
+﻿#pragma once
+#include <vector>
+
+#include "GameTables.h"
+
+// 오퍼레이터(행) × 적(열) 결과, 행 우선 저장 (stride = SIMD 폭으로 올림한 열 수)
+struct DamageMatrix
+{
+	int rows = 0;
+	int cols = 0;
+	int stride = 0;
+
+	std::vector<float> dps;				// 초당 피해 (공격 불가 = 0)
+	std::vector<float> timeToKill;		// maxHp / dps (공격 불가 = inf)
+	std::vector<float> effectiveHp;		// 오퍼레이터 공격력 기준 환산 HP (maxHp * atk / 1회 피해)
+
+	float Dps(int row, int col) const { return dps[(size_t)row * stride + col]; }
+	float TimeToKill(int row, int col) const { return timeToKill[(size_t)row * stride + col]; }
+	float EffectiveHp(int row, int col) const { return effectiveHp[(size_t)row * stride + col]; }
+};
+
+// 오퍼레이터/적 테이블을 SoA 열로 펼쳐 두고 전체 행렬 또는 행/열 단위로 다시 계산
+// 피해 공식은 BattleSimulator 와 동일 (물리: atk - def, 마법: atk * (1 - res), 최소 5%)
+class DamageMatrixEngine
+{
+public:
+	void SetOperators(const std::vector<OperatorStats>& operators);
+	void SetEnemies(const std::vector<EnemyStats>& enemies);
+
+	// 전체 재계산 (오퍼레이터 블록 단위로 모든 코어 사용)
+	void Compute();
+
+	// 한 항목만 바뀐 경우 해당 행/열만 다시 계산
+	void UpdateOperator(int index, const OperatorStats& stats);
+	void UpdateEnemy(int index, const EnemyStats& stats);
+
+	const DamageMatrix& GetMatrix() const { return _matrix; }
+
+private:
+	// 적 열 (stride 까지 0 으로 채움)
+	std::vector<float> _enemyDef;
+	std::vector<float> _enemyRes;
+	std::vector<float> _enemyHp;
+	std::vector<float> _enemyFlying;	// 1 = 비행
+
+	// 오퍼레이터 열
+	std::vector<float> _opAtk;
+	std::vector<float> _opInterval;
+	std::vector<uint8_t> _opArts;
+	std::vector<uint8_t> _opMelee;		// 근거리는 비행 적 공격 불가
+	std::vector<uint8_t> _opHealer;		// 의료는 피해 없음
+
+	int _enemyCount = 0;
+	DamageMatrix _matrix;
+
+	void WriteOperator(int index, const OperatorStats& stats);
+	void WriteEnemy(int index, const EnemyStats& stats);
+	void Allocate();
+	void ComputeRow(int row);
+	void ComputeCell(int row, int col);
+};
@@ -0,0 +1,512 @@
+﻿#include "DamageMatrixWindow.h"
+#include "EnemyEditor.h"
+#include "OperatorEditor.h"
+#include "Parallel.h"
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <imgui/imgui.h>
+
+#include "Utility.h"
+
+namespace
+{
+	const char* METRIC_NAMES[] = { "DPS", "처치 시간 (초)", "환산 HP" };
+	const char* SORT_NAMES[] = { "이름", "평균", "선택 기준" };
+
+	ImVec4 Lerp(const ImVec4& a, const ImVec4& b, float t)
+	{
+		return ImVec4(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, 1.0f);
+	}
+}
+
+void DamageMatrixWindow::RenderGUI(bool* p_open, const EnemyEditor& enemyEditor, const OperatorEditor& operatorEditor)
+{
+	if (enemyEditor.GetRevision() != _enemyRevision || operatorEditor.GetRevision() != _operatorRevision)
+		Refresh(enemyEditor, operatorEditor);
+
+	ImGui::SetNextWindowSize(ImVec2(900, 600), ImGuiCond_FirstUseEver);
+	ImGui::Begin("데미지 매트릭스", p_open);
+
+	RenderToolbar();
+	ImGui::Separator();
+
+	if (_orderDirty)
+		RebuildOrder();
+
+	RenderSelection();
+	RenderHeatmap();
+
+	ImGui::End();
+}
+
+void DamageMatrixWindow::Refresh(const EnemyEditor& enemyEditor, const OperatorEditor& operatorEditor)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	const EnemyVariantTable& resolved = enemyEditor.GetResolvedEnemies();
+	const json& operatorData = operatorEditor.GetOperatorData();
+
+	// 편집기에서 레코드 하나씩만 바꿨으면 해당 행/열만 다시 계산 (O(N + M))
+	// 인덱스가 그대로 맞으려면 건너뛴 (해석 실패한) 적/오퍼레이터가 없어야 함
+	std::vector<int> changedEnemies;
+	std::vector<int> changedOperators;
+	bool incremental = _enemyRevision != 0 && _operatorRevision != 0
+		&& enemyEditor.GetChangeLog().ChangedSince(_enemyRevision, enemyEditor.GetRevision(), changedEnemies)
+		&& operatorEditor.GetChangeLog().ChangedSince(_operatorRevision, operatorEditor.GetRevision(), changedOperators)
+		&& (int)_enemies.size() == resolved.EnemyCount()
+		&& operatorData.contains("operators") && _operators.size() == operatorData["operators"].size();
+
+	if (incremental)
+		incremental = ApplyRecordChanges(resolved, operatorData["operators"], changedEnemies, changedOperators);
+
+	if (!incremental)
+	{
+		_enemies = resolved.Snapshot(_enemyVariant);
+		_operators = ParseOperatorTable(operatorData);
+
+		_engine.SetOperators(_operators);
+		_engine.SetEnemies(_enemies);
+		_engine.Compute();
+	}
+
+	_enemyRevision = enemyEditor.GetRevision();
+	_operatorRevision = operatorEditor.GetRevision();
+
+	if (_selectedRow >= (int)_operators.size())
+		_selectedRow = -1;
+	if (_selectedCol >= (int)_enemies.size())
+		_selectedCol = -1;
+
+	if (incremental)
+		_orderDirty = true;
+	else
+		RebuildStatistics();
+
+	auto end = std::chrono::steady_clock::now();
+	_lastComputeMs = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+bool DamageMatrixWindow::ApplyRecordChanges(const EnemyVariantTable& enemies, const json& operators,
+	const std::vector<int>& changedEnemies, const std::vector<int>& changedOperators)
+{
+	const DamageMatrix& matrix = _engine.GetMatrix();
+	std::vector<float> previous;
+
+	for (int index : changedEnemies)
+	{
+		const EnemyStats* stats = (index < (int)_enemies.size()) ? enemies.Get(index, _enemyVariant) : nullptr;
+		if (!stats)
+			return false;
+
+		const std::vector<float>& values = MetricValues();
+		previous.resize(matrix.rows);
+		for (int row = 0; row < matrix.rows; ++row)
+			previous[row] = values[(size_t)row * matrix.stride + index];
+
+		_enemies[index] = *stats;
+		_engine.UpdateEnemy(index, *stats);
+		UpdateColumnStatistics(index, previous);
+	}
+
+	for (int index : changedOperators)
+	{
+		OperatorStats stats;
+		if (index >= (int)_operators.size() || !ParseOperatorStats(operators[index], stats))
+			return false;
+
+		const float* row = MetricValues().data() + (size_t)index * matrix.stride;
+		previous.assign(row, row + matrix.cols);
+
+		_operators[index] = std::move(stats);
+		_engine.UpdateOperator(index, _operators[index]);
+		UpdateRowStatistics(index, previous);
+	}
+
+	return true;
+}
+
+const std::vector<float>& DamageMatrixWindow::MetricValues() const
+{
+	const DamageMatrix& matrix = _engine.GetMatrix();
+	switch (_metric)
+	{
+	case Metric::TimeToKill:	return matrix.timeToKill;
+	case Metric::EffectiveHp:	return matrix.effectiveHp;
+	default:					return matrix.dps;
+	}
+}
+
+float DamageMatrixWindow::CellValue(int row, int col) const
+{
+	return MetricValues()[(size_t)row * _engine.GetMatrix().stride + col];
+}
+
+void DamageMatrixWindow::RebuildStatistics()
+{
+	const DamageMatrix& matrix = _engine.GetMatrix();
+	const std::vector<float>& values = MetricValues();
+	const int rows = matrix.rows;
+	const int cols = matrix.cols;
+	const size_t stride = matrix.stride;
+
+	_rowMean.assign(rows, 0.0f);
+	_colMean.assign(cols, 0.0f);
+	_rowSum.assign(rows, 0.0);
+	_colSum.assign(cols, 0.0);
+	_rowCount.assign(rows, 0);
+	_colCount.assign(cols, 0);
+
+	std::vector<float> rowMin(rows, INFINITY);
+	std::vector<float> rowMax(rows, 0.0f);
+
+	// 행 평균/범위 (inf 는 제외)
+	ParallelFor(rows, 64, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t r = begin; r < end; ++r)
+			{
+				const float* row = values.data() + r * stride;
+				double sum = 0.0;
+				int count = 0;
+				for (int c = 0; c < cols; ++c)
+				{
+					if (std::isfinite(row[c]))
+					{
+						sum += row[c];
+						++count;
+						rowMin[r] = std::min(rowMin[r], row[c]);
+						rowMax[r] = std::max(rowMax[r], row[c]);
+					}
+				}
+				_rowSum[r] = sum;
+				_rowCount[r] = count;
+				_rowMean[r] = count > 0 ? (float)(sum / count) : INFINITY;
+			}
+		});
+
+	// 열 평균 (열 블록 단위로 나눠 행을 훑음)
+	ParallelFor(cols, 256, [&](size_t begin, size_t end, unsigned)
+		{
+			std::vector<double> sum(end - begin, 0.0);
+			std::vector<int> count(end - begin, 0);
+			for (int r = 0; r < rows; ++r)
+			{
+				const float* row = values.data() + r * stride;
+				for (size_t c = begin; c < end; ++c)
+				{
+					if (std::isfinite(row[c]))
+					{
+						sum[c - begin] += row[c];
+						++count[c - begin];
+					}
+				}
+			}
+			for (size_t c = begin; c < end; ++c)
+			{
+				_colSum[c] = sum[c - begin];
+				_colCount[c] = count[c - begin];
+				_colMean[c] = count[c - begin] > 0 ? (float)(sum[c - begin] / count[c - begin]) : INFINITY;
+			}
+		});
+
+	_rangeMin = INFINITY;
+	_rangeMax = 0.0f;
+	for (int r = 0; r < rows; ++r)
+	{
+		_rangeMin = std::min(_rangeMin, rowMin[r]);
+		_rangeMax = std::max(_rangeMax, rowMax[r]);
+	}
+	if (!std::isfinite(_rangeMin))
+		_rangeMin = 0.0f;
+
+	_orderDirty = true;
+}
+
+// 바뀐 행 하나: 열 합계에서 이전 값을 빼고 새 값을 더함
+// 색 범위는 넓히기만 함 (좁히려면 전체를 훑어야 하므로 지표를 바꾸거나 전체 다시 계산할 때 맞춰짐)
+void DamageMatrixWindow::UpdateRowStatistics(int row, const std::vector<float>& previous)
+{
+	const DamageMatrix& matrix = _engine.GetMatrix();
+	const float* values = MetricValues().data() + (size_t)row * matrix.stride;
+
+	double sum = 0.0;
+	int count = 0;
+	for (int c = 0; c < matrix.cols; ++c)
+	{
+		if (std::isfinite(previous[c]))
+		{
+			_colSum[c] -= previous[c];
+			--_colCount[c];
+		}
+		if (std::isfinite(values[c]))
+		{
+			_colSum[c] += values[c];
+			++_colCount[c];
+			sum += values[c];
+			++count;
+			_rangeMin = std::min(_rangeMin, values[c]);
+			_rangeMax = std::max(_rangeMax, values[c]);
+		}
+		_colMean[c] = _colCount[c] > 0 ? (float)(_colSum[c] / _colCount[c]) : INFINITY;
+	}
+
+	_rowSum[row] = sum;
+	_rowCount[row] = count;
+	_rowMean[row] = count > 0 ? (float)(sum / count) : INFINITY;
+}
+
+// 바뀐 열 하나: 행 합계에서 이전 값을 빼고 새 값을 더함
+void DamageMatrixWindow::UpdateColumnStatistics(int col, const std::vector<float>& previous)
+{
+	const DamageMatrix& matrix = _engine.GetMatrix();
+	const std::vector<float>& values = MetricValues();
+
+	double sum = 0.0;
+	int count = 0;
+	for (int r = 0; r < matrix.rows; ++r)
+	{
+		float value = values[(size_t)r * matrix.stride + col];
+		if (std::isfinite(previous[r]))
+		{
+			_rowSum[r] -= previous[r];
+			--_rowCount[r];
+		}
+		if (std::isfinite(value))
+		{
+			_rowSum[r] += value;
+			++_rowCount[r];
+			sum += value;
+			++count;
+			_rangeMin = std::min(_rangeMin, value);
+			_rangeMax = std::max(_rangeMax, value);
+		}
+		_rowMean[r] = _rowCount[r] > 0 ? (float)(_rowSum[r] / _rowCount[r]) : INFINITY;
+	}
+
+	_colSum[col] = sum;
+	_colCount[col] = count;
+	_colMean[col] = count > 0 ? (float)(sum / count) : INFINITY;
+}
+
+void DamageMatrixWindow::RebuildOrder()
+{
+	_orderDirty = false;
+
+	_rowOrder.resize(_operators.size());
+	_colOrder.resize(_enemies.size());
+	for (int i = 0; i < (int)_rowOrder.size(); ++i) _rowOrder[i] = i;
+	for (int i = 0; i < (int)_colOrder.size(); ++i) _colOrder[i] = i;
+
+	bool descending = _sortDescending;
+	auto byKey = [descending](float a, float b)
+		{
+			return descending ? a > b : a < b;
+		};
+
+	switch (_rowSort)
+	{
+	case SortMode::Name:
+		std::stable_sort(_rowOrder.begin(), _rowOrder.end(), [&](int a, int b) { return _operators[a].charId < _operators[b].charId; });
+		break;
+	case SortMode::Mean:
+		std::stable_sort(_rowOrder.begin(), _rowOrder.end(), [&](int a, int b) { return byKey(_rowMean[a], _rowMean[b]); });
+		break;
+	case SortMode::Selected:
+		if (_selectedCol >= 0)
+			std::stable_sort(_rowOrder.begin(), _rowOrder.end(), [&](int a, int b) { return byKey(CellValue(a, _selectedCol), CellValue(b, _selectedCol)); });
+		break;
+	default:
+		break;
+	}
+
+	switch (_colSort)
+	{
+	case SortMode::Name:
+		std::stable_sort(_colOrder.begin(), _colOrder.end(), [&](int a, int b) { return _enemies[a].key < _enemies[b].key; });
+		break;
+	case SortMode::Mean:
+		std::stable_sort(_colOrder.begin(), _colOrder.end(), [&](int a, int b) { return byKey(_colMean[a], _colMean[b]); });
+		break;
+	case SortMode::Selected:
+		if (_selectedRow >= 0)
+			std::stable_sort(_colOrder.begin(), _colOrder.end(), [&](int a, int b) { return byKey(CellValue(_selectedRow, a), CellValue(_selectedRow, b)); });
+		break;
+	default:
+		break;
+	}
+}
+
+float DamageMatrixWindow::Normalize(float value) const
+{
+	if (!std::isfinite(value) || _rangeMax <= 0.0f)
+		return -1.0f;
+
+	// DPS 는 선형, 시간/HP 는 범위가 넓어 로그 스케일
+	if (_metric == Metric::Dps)
+		return std::clamp(value / _rangeMax, 0.0f, 1.0f);
+
+	float lo = std::log(std::max(_rangeMin, 1e-3f));
+	float hi = std::log(std::max(_rangeMax, 1e-3f));
+	if (hi <= lo)
+		return 0.0f;
+
+	return std::clamp((std::log(std::max(value, 1e-3f)) - lo) / (hi - lo), 0.0f, 1.0f);
+}
+
+std::string DamageMatrixWindow::FormatValue(float value) const
+{
+	if (!std::isfinite(value))
+		return "공격 불가";
+
+	char buffer[64];
+	snprintf(buffer, sizeof(buffer), _metric == Metric::TimeToKill ? "%.2f" : "%.0f", value);
+	return buffer;
+}
+
+void DamageMatrixWindow::RenderToolbar()
+{
+	ImGui::Text("오퍼레이터 %d × 적 %d", (int)_operators.size(), (int)_enemies.size());
+	ImGui::SameLine();
+	ImGui::TextColored(COLOR_GRAY, "(계산 %.1f ms)", _lastComputeMs);
+
+	ImGui::PushItemWidth(150);
+
+	int metric = (int)_metric;
+	if (ImGui::Combo("지표", &metric, METRIC_NAMES, IM_ARRAYSIZE(METRIC_NAMES)))
+	{
+		_metric = (Metric)metric;
+		RebuildStatistics();
+	}
+
+	ImGui::SameLine();
+	int rowSort = (int)_rowSort;
+	if (ImGui::Combo("행 정렬", &rowSort, SORT_NAMES, IM_ARRAYSIZE(SORT_NAMES)))
+	{
+		_rowSort = (SortMode)rowSort;
+		_orderDirty = true;
+	}
+
+	ImGui::SameLine();
+	int colSort = (int)_colSort;
+	if (ImGui::Combo("열 정렬", &colSort, SORT_NAMES, IM_ARRAYSIZE(SORT_NAMES)))
+	{
+		_colSort = (SortMode)colSort;
+		_orderDirty = true;
+	}
+
+	ImGui::SameLine();
+	if (ImGui::Checkbox("내림차순", &_sortDescending))
+		_orderDirty = true;
+
+	ImGui::SameLine();
+	ImGui::SliderFloat("칸 크기", &_cellSize, 3.0f, 24.0f, "%.0f");
+
+	ImGui::SameLine();
+	if (ImGui::InputInt("적 레벨 변형", &_enemyVariant))
+	{
+		_enemyVariant = std::max(0, _enemyVariant);
+		_enemyRevision = 0;		// 다음 프레임에 다시 계산
+	}
+
+	ImGui::PopItemWidth();
+}
+
+void DamageMatrixWindow::RenderSelection()
+{
+	if (_selectedRow >= 0 && _selectedCol >= 0)
+	{
+		const DamageMatrix& matrix = _engine.GetMatrix();
+		ImGui::Text("%s -> %s  |  DPS %.1f  처치 %.2fs  환산 HP %.0f",
+			_operators[_selectedRow].charId.c_str(), _enemies[_selectedCol].key.c_str(),
+			matrix.Dps(_selectedRow, _selectedCol),
+			matrix.TimeToKill(_selectedRow, _selectedCol),
+			matrix.EffectiveHp(_selectedRow, _selectedCol));
+	}
+	else
+	{
+		ImGui::TextColored(COLOR_GRAY, "칸을 클릭하면 해당 오퍼레이터/적이 선택됩니다. (선택 기준 정렬에 사용)");
+	}
+}
+
+void DamageMatrixWindow::RenderHeatmap()
+{
+	const int rows = (int)_rowOrder.size();
+	const int cols = (int)_colOrder.size();
+
+	if (rows == 0 || cols == 0)
+	{
+		ImGui::TextColored(COLOR_GRAY, "오퍼레이터 또는 적 데이터가 없습니다.");
+		return;
+	}
+
+	ImGui::BeginChild("Heatmap", ImVec2(0, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
+
+	const float cell = _cellSize;
+	ImVec2 origin = ImGui::GetCursorScreenPos();
+	ImDrawList* draw_list = ImGui::GetWindowDrawList();
+
+	// 보이는 영역만 그림
+	float scrollX = ImGui::GetScrollX();
+	float scrollY = ImGui::GetScrollY();
+	ImVec2 windowSize = ImGui::GetWindowSize();
+
+	int firstCol = std::max(0, (int)(scrollX / cell));
+	int lastCol = std::min(cols, (int)((scrollX + windowSize.x) / cell) + 1);
+	int firstRow = std::max(0, (int)(scrollY / cell));
+	int lastRow = std::min(rows, (int)((scrollY + windowSize.y) / cell) + 1);
+
+	const ImVec4 low = ImVec4(0.15f, 0.1f, 0.1f, 1.0f);
+	const ImVec4 high = COLOR_RED;
+	const ImU32 invalid = ImGui::GetColorU32(ImVec4(0.25f, 0.25f, 0.25f, 1.0f));
+
+	for (int r = firstRow; r < lastRow; ++r)
+	{
+		int op = _rowOrder[r];
+		for (int c = firstCol; c < lastCol; ++c)
+		{
+			int enemy = _colOrder[c];
+			float t = Normalize(CellValue(op, enemy));
+
+			ImVec2 p_min(origin.x + c * cell, origin.y + r * cell);
+			ImVec2 p_max(p_min.x + cell - 1, p_min.y + cell - 1);
+			draw_list->AddRectFilled(p_min, p_max, t < 0.0f ? invalid : ImGui::GetColorU32(Lerp(low, high, t)));
+
+			if (op == _selectedRow || enemy == _selectedCol)
+				draw_list->AddRect(p_min, p_max, ImGui::GetColorU32(COLOR_YELLOW));
+		}
+	}
+
+	ImGui::Dummy(ImVec2(cols * cell, rows * cell));
+
+	// 호버 / 클릭
+	if (ImGui::IsWindowHovered())
+	{
+		ImVec2 mouse = ImGui::GetIO().MousePos;
+		int c = (int)((mouse.x - origin.x) / cell);
+		int r = (int)((mouse.y - origin.y) / cell);
+
+		if (r >= 0 && r < rows && c >= 0 && c < cols)
+		{
+			int op = _rowOrder[r];
+			int enemy = _colOrder[c];
+
+			ImGui::BeginTooltip();
+			ImGui::Text("%s (%s)", _operators[op].charId.c_str(), _operators[op].name.c_str());
+			ImGui::Text("%s (%s)", _enemies[enemy].key.c_str(), _enemies[enemy].name.c_str());
+			ImGui::Separator();
+			ImGui::Text("%s: %s", METRIC_NAMES[(int)_metric], FormatValue(CellValue(op, enemy)).c_str());
+			ImGui::EndTooltip();
+
+			if (ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+			{
+				_selectedRow = op;
+				_selectedCol = enemy;
+				if (_rowSort == SortMode::Selected || _colSort == SortMode::Selected)
+					_orderDirty = true;
+			}
+		}
+	}
+
+	ImGui::EndChild();
+}
@@ -0,0 +1,82 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "GameTables.h"
+#include "DamageMatrix.h"
+
+class EnemyEditor;
+class EnemyVariantTable;
+class OperatorEditor;
+
+// 오퍼레이터 × 적 DPS / 처치 시간 / 환산 HP 히트맵
+class DamageMatrixWindow
+{
+public:
+	void RenderGUI(bool* p_open, const EnemyEditor& enemyEditor, const OperatorEditor& operatorEditor);
+
+private:
+	enum class Metric
+	{
+		Dps = 0,
+		TimeToKill,
+		EffectiveHp,
+		MAX
+	};
+
+	enum class SortMode
+	{
+		Name = 0,
+		Mean,
+		Selected,		// 선택한 행/열 값 기준
+		MAX
+	};
+
+	DamageMatrixEngine _engine;
+	std::vector<OperatorStats> _operators;
+	std::vector<EnemyStats> _enemies;
+
+	uint64_t _enemyRevision = 0;
+	uint64_t _operatorRevision = 0;
+	int _enemyVariant = 0;		// value[] 인덱스 (없는 적은 마지막 변형)
+	double _lastComputeMs = 0.0;
+
+	Metric _metric = Metric::Dps;
+	SortMode _rowSort = SortMode::Name;
+	SortMode _colSort = SortMode::Name;
+	bool _sortDescending = true;
+	float _cellSize = 8.0f;
+
+	int _selectedRow = -1;		// 오퍼레이터 인덱스
+	int _selectedCol = -1;		// 적 인덱스
+
+	std::vector<int> _rowOrder;
+	std::vector<int> _colOrder;
+	std::vector<float> _rowMean;
+	std::vector<float> _colMean;
+	std::vector<double> _rowSum;		// 유한한 값만 (평균 = 합 / 개수)
+	std::vector<double> _colSum;
+	std::vector<int> _rowCount;
+	std::vector<int> _colCount;
+	float _rangeMin = 0.0f;
+	float _rangeMax = 1.0f;
+	bool _orderDirty = true;
+
+	void Refresh(const EnemyEditor& enemyEditor, const OperatorEditor& operatorEditor);
+	bool ApplyRecordChanges(const EnemyVariantTable& enemies, const json& operators,
+		const std::vector<int>& changedEnemies, const std::vector<int>& changedOperators);
+	void RebuildStatistics();
+	void UpdateRowStatistics(int row, const std::vector<float>& previous);
+	void UpdateColumnStatistics(int col, const std::vector<float>& previous);
+	void RebuildOrder();
+
+	void RenderToolbar();
+	void RenderHeatmap();
+	void RenderSelection();
+
+	const std::vector<float>& MetricValues() const;
+	float CellValue(int row, int col) const;
+	float Normalize(float value) const;
+	std::string FormatValue(float value) const;
+};
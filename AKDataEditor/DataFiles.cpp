@@ -0,0 +1,137 @@
+﻿#include "DataFiles.h"
+#include "RangeTable.h"
+#include "Utility.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	// 같은 범위 테이블을 쓰는 다른 테이블 (오퍼레이터 <-> 스킬) 의 레코드 배열 (디스크에 저장된 rangeId 참조)
+	// 파일이 없으면 빈 배열, 읽지 못하면 false (이때는 범위를 지우지 않음)
+	bool LoadSiblingRecords(Migration::DataType type, const std::string& path, json& records)
+	{
+		Migration::DataType sibling = (type == Migration::DataType::Operator) ? Migration::DataType::Skill : Migration::DataType::Operator;
+		fs::path siblingPath = fs::path(path).parent_path() / fs::path(DataFilePath("", sibling)).filename();
+
+		records = json::array();
+		std::error_code ec;
+		if (!fs::exists(siblingPath, ec))
+			return !ec;
+
+		json table;
+		if (!LoadJsonFile(siblingPath.string(), table))
+			return false;
+
+		const char* key = Migration::RecordArrayKey(sibling);
+		if (table.contains(key))
+			records = std::move(table[key]);
+		return true;
+	}
+}
+
+std::string DataFilePath(const std::string& solutionPath, Migration::DataType type)
+{
+	switch (type)
+	{
+	case Migration::DataType::Enemy: return solutionPath + "/gamedata/tables/enemies_table.json";
+	case Migration::DataType::Operator: return solutionPath + "/gamedata/tables/operators_table.json";
+	case Migration::DataType::Skill: return solutionPath + "/gamedata/tables/skills_table.json";
+	default: return solutionPath + "/gamedata/levels/";
+	}
+}
+
+std::vector<std::string> ListLevelFiles(const std::string& levelPath)
+{
+	std::vector<std::string> fileNames;
+	std::error_code ec;
+	if (!fs::exists(levelPath, ec))
+		return fileNames;
+
+	for (const auto& entry : fs::directory_iterator(levelPath, ec))
+	{
+		std::string fileName = entry.path().filename().string();
+		if (entry.is_regular_file() && fileName.find("level_main_") == 0 && fileName.ends_with(".json"))
+			fileNames.push_back(fileName);
+	}
+
+	std::sort(fileNames.begin(), fileNames.end());
+	return fileNames;
+}
+
+std::string LevelIdFromFileName(const std::string& fileName)
+{
+	if (fileName.length() > 16)
+		return fileName.substr(11, fileName.length() - 16);
+	return fileName;
+}
+
+DataFileStatus ReadDataFile(Migration::DataType type, const std::string& path, json& data, std::string& error)
+{
+	std::ifstream file(path);
+	if (!file.is_open())
+	{
+		error = "파일 없음: " + path;
+		return DataFileStatus::Missing;
+	}
+
+	try
+	{
+		file >> data;
+
+		// rangeId 참조를 편집용 range 배열로 펼침
+		if (type == Migration::DataType::Operator || type == Migration::DataType::Skill)
+			ExpandRangeReferences(data, Migration::RecordArrayKey(type), path);
+
+		// 버전 체크 및 마이그레이션
+		if (Migration::CheckAndMigrate(type, data))
+			return DataFileStatus::Migrated;
+	}
+	catch (const json::exception& e)
+	{
+		error = e.what();
+		return DataFileStatus::ParseError;
+	}
+
+	return DataFileStatus::Loaded;
+}
+
+bool WriteDataFile(Migration::DataType type, const std::string& path, json data)
+{
+	fs::path filePath(path);
+	if (filePath.has_parent_path())
+		fs::create_directories(filePath.parent_path());
+
+	data["version"] = VERSION;  // 항상 현재 버전으로 저장
+
+	// 범위는 공유 범위 테이블에 모양별로 한 번만 저장하고 id 로 참조
+	// (테이블을 읽지 못하면 기존 id 를 잃지 않도록 range 배열 그대로 저장)
+	const char* recordKey = Migration::RecordArrayKey(type);
+	if ((type == Migration::DataType::Operator || type == Migration::DataType::Skill) && data.contains(recordKey))
+	{
+		RangeTable ranges;
+		std::string rangePath = RangeTable::PathFor(path);
+		if (ranges.Load(rangePath))
+		{
+			ranges.CompactRecords(data[recordKey]);
+
+			// 이 테이블과 다른 테이블 어디에서도 쓰지 않는 범위는 지움 (저장할 때마다 쌓이지 않도록)
+			json siblingRecords;
+			if (LoadSiblingRecords(type, path, siblingRecords))
+			{
+				bool isOperator = (type == Migration::DataType::Operator);
+				ranges.RemoveUnreferenced(isOperator ? data[recordKey] : siblingRecords, isOperator ? siblingRecords : data[recordKey]);
+			}
+			ranges.Save(rangePath);
+		}
+	}
+
+	std::ofstream file(path);
+	if (!file.is_open())
+		return false;
+
+	file << data.dump(2);
+	return file.good();
+}
@@ -0,0 +1,35 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "Migration.h"
+
+using json = nlohmann::ordered_json;
+
+// 솔루션 폴더 안의 데이터 파일 읽기/쓰기
+// 편집기와 명령줄 도구(akdata)가 같은 함수를 써서 같은 파일에서 같은 결과를 얻음
+
+// <솔루션>/gamedata/tables/enemies_table.json 등 (레벨은 레벨 폴더 "<솔루션>/gamedata/levels/")
+std::string DataFilePath(const std::string& solutionPath, Migration::DataType type);
+
+// level_main_*.json 파일 이름 (이름순), "level_main_00-01.json" -> "00-01"
+std::vector<std::string> ListLevelFiles(const std::string& levelPath);
+std::string LevelIdFromFileName(const std::string& fileName);
+
+enum class DataFileStatus
+{
+	Loaded = 0,
+	Migrated,		// 읽은 뒤 마이그레이션함 (저장 필요)
+	Missing,
+	ParseError,
+};
+
+// 편집기 로드와 같은 순서: 파싱 -> (오퍼레이터/스킬) rangeId 를 range 배열로 펼침 -> 버전 체크 및 마이그레이션
+// 실패하면 error 에 이유 (data 는 읽다 만 상태일 수 있음)
+DataFileStatus ReadDataFile(Migration::DataType type, const std::string& path, json& data, std::string& error);
+
+// 편집기 저장과 같은 출력: version 을 현재 버전으로, 오퍼레이터/스킬의 range 는 공유 범위 테이블 id 로 바꿔 dump(2)
+// 범위 테이블에서는 이 테이블과 다른 테이블 (디스크의 파일) 이 모두 쓰지 않는 범위를 지움
+// 오퍼레이터/스킬은 범위 테이블도 다시 쓰므로 두 테이블을 동시에 쓰면 안 됨
+bool WriteDataFile(Migration::DataType type, const std::string& path, json data);
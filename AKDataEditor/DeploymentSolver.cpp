@@ -0,0 +1,627 @@
+﻿#include "DeploymentSolver.h"
+#include "Parallel.h"
+#include "RangeBitboard.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace
+{
+	int PopCount(const uint64_t* words, int count)
+	{
+		int total = 0;
+		for (int i = 0; i < count; ++i)
+			total += std::popcount(words[i]);
+		return total;
+	}
+
+	// 합집합에 새로 더해지는 타일 수
+	int PopCountNew(const uint64_t* words, const uint64_t* covered, int count)
+	{
+		int total = 0;
+		for (int i = 0; i < count; ++i)
+			total += std::popcount(words[i] & ~covered[i]);
+		return total;
+	}
+
+	bool IsSubset(const uint64_t* a, const uint64_t* b, int count)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			if (a[i] & ~b[i])
+				return false;
+		}
+		return true;
+	}
+
+	// 탐색 단위 (선택한 배치 목록 + 다음에 볼 후보 위치)
+	struct SearchTask
+	{
+		std::vector<int> chosen;
+		int next = 0;
+	};
+
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<SearchTask> tasks;
+	};
+}
+
+std::vector<Deployment> DeploymentPlan::ToDeployments(const std::vector<OperatorStats>& roster) const
+{
+	std::vector<Deployment> deployments;
+	deployments.reserve(placements.size());
+	for (const auto& placed : placements)
+	{
+		Deployment deployment;
+		deployment.time = 0.0;
+		deployment.charId = roster[placed.operatorIndex].charId;
+		deployment.tile = placed.tile;
+		deployment.direction = placed.direction;
+		deployments.push_back(deployment);
+	}
+	return deployments;
+}
+
+DeploymentSolver::DeploymentSolver(const LevelGrid& level, const std::vector<EnemyStats>& enemies, const std::vector<OperatorStats>& roster)
+	: _level(level), _enemies(enemies), _roster(roster)
+{
+	LevelBitboard board = LevelBitboard::FromLevelGrid(level);
+	_stride = std::max(1, board.rows);
+	_pathTiles = PopCount(board.path.data(), board.rows);
+
+	// 범위 모양 + 배치 지형이 같은 오퍼레이터끼리 묶음
+	std::vector<RangeBitboard> classRanges;
+	std::vector<bool> classMelee;
+	std::unordered_multimap<uint64_t, int> classLookup;
+
+	for (int i = 0; i < (int)roster.size(); ++i)
+	{
+		RangeBitboard range = RangeBitboard::FromOffsets(roster[i].range);
+		bool melee = roster[i].IsMelee();
+		uint64_t key = range.Hash() ^ (melee ? 0x8000000000000000ull : 0);
+
+		int found = -1;
+		auto [first, last] = classLookup.equal_range(key);
+		for (auto it = first; it != last; ++it)
+		{
+			if (classMelee[it->second] == melee && classRanges[it->second] == range)
+			{
+				found = it->second;
+				break;
+			}
+		}
+
+		if (found < 0)
+		{
+			found = (int)classRanges.size();
+			classRanges.push_back(std::move(range));
+			classMelee.push_back(melee);
+			classLookup.emplace(key, found);
+			_classMembers.emplace_back();
+		}
+		_classMembers[found].push_back(i);
+	}
+
+	// (클래스, 타일, 방향) 후보 생성: 경로를 하나도 덮지 않거나, 같은 타일의 다른 방향에 포함되는 후보는 버림
+	std::vector<uint64_t> tileMasks((size_t)Direction::MAX * _stride);
+	for (int c = 0; c < (int)classRanges.size(); ++c)
+	{
+		std::array<RangeBitboard, (int)Direction::MAX> rotations;
+		for (int d = 0; d < (int)Direction::MAX; ++d)
+			rotations[d] = classRanges[c].Rotated((Direction)d);
+
+		for (int row = 0; row < board.rows; ++row)
+		{
+			uint64_t buildable = classMelee[c] ? board.ground[row] : board.highGround[row];
+			while (buildable)
+			{
+				int col = std::countr_zero(buildable);
+				buildable &= buildable - 1;
+
+				int coverage[(int)Direction::MAX];
+				for (int d = 0; d < (int)Direction::MAX; ++d)
+				{
+					BuildCoverageMask(board, rotations[d], row, col, &tileMasks[(size_t)d * _stride]);
+					coverage[d] = PopCount(&tileMasks[(size_t)d * _stride], board.rows);
+				}
+
+				for (int d = 0; d < (int)Direction::MAX; ++d)
+				{
+					if (coverage[d] == 0)
+						continue;
+
+					const uint64_t* mask = &tileMasks[(size_t)d * _stride];
+					bool dominated = false;
+					for (int other = 0; other < (int)Direction::MAX && !dominated; ++other)
+					{
+						if (other == d || coverage[other] < coverage[d])
+							continue;
+						// 같은 마스크면 앞 방향만 남김
+						if (coverage[other] == coverage[d] && other > d)
+							continue;
+						dominated = IsSubset(mask, &tileMasks[(size_t)other * _stride], board.rows);
+					}
+					if (dominated)
+						continue;
+
+					Placement placement;
+					placement.operatorClass = c;
+					placement.tileIndex = level.TileIndex(row, col);
+					placement.tile = { row, col };
+					placement.direction = (Direction)d;
+					placement.coverage = coverage[d];
+					_placements.push_back(placement);
+					_masks.insert(_masks.end(), mask, mask + _stride);
+				}
+			}
+		}
+	}
+
+	// 커버리지 내림차순 정렬 (마스크도 같은 순서로)
+	std::vector<int> order(_placements.size());
+	for (int i = 0; i < (int)order.size(); ++i)
+		order[i] = i;
+	std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return _placements[a].coverage > _placements[b].coverage; });
+
+	std::vector<Placement> sortedPlacements;
+	std::vector<uint64_t> sortedMasks;
+	sortedPlacements.reserve(order.size());
+	sortedMasks.reserve(_masks.size());
+	for (int index : order)
+	{
+		sortedPlacements.push_back(_placements[index]);
+		sortedMasks.insert(sortedMasks.end(), _masks.begin() + (size_t)index * _stride, _masks.begin() + (size_t)(index + 1) * _stride);
+	}
+	_placements = std::move(sortedPlacements);
+	_masks = std::move(sortedMasks);
+
+	const size_t count = _placements.size();
+	_prefixCoverage.assign(count + 1, 0);
+	for (size_t j = 0; j < count; ++j)
+		_prefixCoverage[j + 1] = _prefixCoverage[j] + _placements[j].coverage;
+
+	_suffixUnion.assign((count + 1) * _stride, 0);
+	for (size_t j = count; j-- > 0;)
+	{
+		for (int w = 0; w < _stride; ++w)
+			_suffixUnion[j * _stride + w] = _suffixUnion[(j + 1) * _stride + w] | _masks[j * _stride + w];
+	}
+}
+
+// 한 번의 Solve 동안 공유되는 탐색 상태
+class DeploymentSearch
+{
+public:
+	DeploymentSearch(const DeploymentSolver& solver, int characterLimit, int keep, const DeploymentSolverConfig& config,
+		DeploymentSolverProgress* progress)
+		: _solver(solver), _limit(characterLimit), _keep(std::max(1, keep)), _config(config), _progress(progress),
+		_start(std::chrono::steady_clock::now()), _queues(GetWorkerCount())
+	{
+	}
+
+	void Offer(const std::vector<int>& chosen, int value)
+	{
+		if (value <= _threshold.load(std::memory_order_relaxed))
+			return;
+
+		std::vector<int> sorted = chosen;
+		std::sort(sorted.begin(), sorted.end());
+
+		std::lock_guard<std::mutex> lock(_bestMutex);
+		for (const auto& [existingValue, existing] : _best)
+		{
+			if (existing == sorted)
+				return;
+		}
+
+		_best.push_back({ value, std::move(sorted) });
+		std::sort(_best.begin(), _best.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+		if ((int)_best.size() > _keep)
+			_best.pop_back();
+		if ((int)_best.size() == _keep)
+			_threshold.store(_best.back().first, std::memory_order_relaxed);
+
+		if (_progress && _best.front().first > _published)
+		{
+			_published = _best.front().first;
+			_progress->Publish(_solver.MakePlan(_best.front().first, _best.front().second));
+		}
+	}
+
+	// 단순 탐욕 배치로 초기 하한을 잡아 둠
+	void SeedGreedy()
+	{
+		const int stride = _solver._stride;
+		std::vector<uint64_t> covered(stride, 0);
+		std::vector<uint8_t> occupied(_solver._level.tiles.size(), 0);
+		std::vector<int> classUsed(_solver._classMembers.size(), 0);
+		std::vector<int> chosen;
+		int value = 0;
+
+		while ((int)chosen.size() < _limit)
+		{
+			int bestIndex = -1;
+			int bestGain = 0;
+			for (int j = 0; j < (int)_solver._placements.size(); ++j)
+			{
+				const auto& placement = _solver._placements[j];
+				if (placement.coverage <= bestGain)
+					break;
+				if (occupied[placement.tileIndex] || classUsed[placement.operatorClass] >= (int)_solver._classMembers[placement.operatorClass].size())
+					continue;
+
+				int gain = PopCountNew(&_solver._masks[(size_t)j * stride], covered.data(), stride);
+				if (gain > bestGain)
+				{
+					bestGain = gain;
+					bestIndex = j;
+				}
+			}
+
+			if (bestIndex < 0)
+				break;
+
+			const auto& placement = _solver._placements[bestIndex];
+			occupied[placement.tileIndex] = 1;
+			++classUsed[placement.operatorClass];
+			for (int w = 0; w < stride; ++w)
+				covered[w] |= _solver._masks[(size_t)bestIndex * stride + w];
+			value += bestGain;
+			chosen.push_back(bestIndex);
+			Offer(chosen, value);
+		}
+	}
+
+	void Run()
+	{
+		_queues[0].tasks.push_back({ {}, 0 });
+		_pending.store(1);
+
+		std::vector<std::thread> threads;
+		for (unsigned w = 1; w < (unsigned)_queues.size(); ++w)
+			threads.emplace_back([this, w]() { WorkerLoop(w); });
+		WorkerLoop(0);
+
+		for (auto& thread : threads)
+			thread.join();
+	}
+
+	std::vector<std::pair<int, std::vector<int>>> TakeBest() { return std::move(_best); }
+	uint64_t Nodes() const { return _nodes.load(); }
+	uint64_t Steals() const { return _steals.load(); }
+	bool Stopped() const { return _stop.load(); }
+
+private:
+	struct WorkerState
+	{
+		std::vector<int> chosen;
+		std::vector<uint64_t> covered;			// 깊이별 합집합 (_stride 워드씩)
+		std::vector<uint8_t> occupied;
+		std::vector<int> classUsed;
+		uint64_t localNodes = 0;
+	};
+
+	bool TryPop(unsigned worker, SearchTask& out)
+	{
+		// 자기 덱은 뒤(가장 최근, 작은 하위 트리)에서
+		{
+			WorkerQueue& own = _queues[worker];
+			std::lock_guard<std::mutex> lock(own.mutex);
+			if (!own.tasks.empty())
+			{
+				out = std::move(own.tasks.back());
+				own.tasks.pop_back();
+				return true;
+			}
+		}
+
+		// 다른 덱은 앞(가장 오래된, 큰 하위 트리)에서 훔침
+		for (size_t offset = 1; offset < _queues.size(); ++offset)
+		{
+			WorkerQueue& victim = _queues[(worker + offset) % _queues.size()];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (!victim.tasks.empty())
+			{
+				out = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				_steals.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void WorkerLoop(unsigned worker)
+	{
+		WorkerState state;
+		const int stride = _solver._stride;
+		state.covered.assign((size_t)(_limit + 1) * stride, 0);
+		state.occupied.assign(_solver._level.tiles.size(), 0);
+		state.classUsed.assign(_solver._classMembers.size(), 0);
+
+		bool idle = false;
+		while (true)
+		{
+			SearchTask task;
+			if (TryPop(worker, task))
+			{
+				if (idle)
+				{
+					_idle.fetch_sub(1);
+					idle = false;
+				}
+
+				if (!_stop.load(std::memory_order_relaxed))
+					RunTask(worker, state, task);
+				_pending.fetch_sub(1);
+				continue;
+			}
+
+			if (_pending.load() == 0)
+				break;
+
+			if (!idle)
+			{
+				_idle.fetch_add(1);
+				idle = true;
+			}
+			std::this_thread::yield();
+		}
+
+		if (idle)
+			_idle.fetch_sub(1);
+		_nodes.fetch_add(state.localNodes);
+	}
+
+	void RunTask(unsigned worker, WorkerState& state, const SearchTask& task)
+	{
+		const int stride = _solver._stride;
+
+		// 작업의 선택 상태를 다시 구성
+		std::fill(state.covered.begin(), state.covered.begin() + stride, 0ull);
+		for (int index : task.chosen)
+		{
+			const auto& placement = _solver._placements[index];
+			state.occupied[placement.tileIndex] = 1;
+			++state.classUsed[placement.operatorClass];
+			for (int w = 0; w < stride; ++w)
+				state.covered[w] |= _solver._masks[(size_t)index * stride + w];
+		}
+		std::copy(state.covered.begin(), state.covered.begin() + stride, state.covered.begin() + (size_t)task.chosen.size() * stride);
+		state.chosen = task.chosen;
+
+		Search(worker, state, task.next);
+
+		for (int index : task.chosen)
+		{
+			const auto& placement = _solver._placements[index];
+			state.occupied[placement.tileIndex] = 0;
+			--state.classUsed[placement.operatorClass];
+		}
+	}
+
+	void Search(unsigned worker, WorkerState& state, int next)
+	{
+		if (++state.localNodes % 4096 == 0)
+		{
+			uint64_t total = _nodes.fetch_add(4096) + 4096;
+			double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+			if (total >= _config.nodeLimit || elapsed >= _config.timeLimit)
+				_stop.store(true);
+			if (_progress)
+			{
+				_progress->_nodes.store(total, std::memory_order_relaxed);
+				if (_progress->Cancelled())
+					_stop.store(true);
+			}
+			state.localNodes -= 4096;
+		}
+
+		const int depth = (int)state.chosen.size();
+		const int remaining = _limit - depth;
+		if (remaining <= 0)
+			return;
+
+		const int stride = _solver._stride;
+		const uint64_t* covered = &state.covered[(size_t)depth * stride];
+		uint64_t* childCovered = &state.covered[(size_t)(depth + 1) * stride];
+		const int value = PopCount(covered, stride);
+		const int count = (int)_solver._placements.size();
+
+		for (int j = next; j < count; ++j)
+		{
+			if (_stop.load(std::memory_order_relaxed))
+				return;
+
+			// 상한은 j 가 커질수록 줄어들므로 넘지 못하면 이후 후보도 모두 못 넘음
+			int sumBound = _solver._prefixCoverage[std::min(count, j + remaining)] - _solver._prefixCoverage[j];
+			int unionBound = PopCountNew(&_solver._suffixUnion[(size_t)j * stride], covered, stride);
+			if (value + std::min(sumBound, unionBound) <= _threshold.load(std::memory_order_relaxed))
+				break;
+
+			const auto& placement = _solver._placements[j];
+			if (state.occupied[placement.tileIndex] || state.classUsed[placement.operatorClass] >= (int)_solver._classMembers[placement.operatorClass].size())
+				continue;
+
+			const uint64_t* mask = &_solver._masks[(size_t)j * stride];
+			int gain = PopCountNew(mask, covered, stride);
+			if (gain == 0)
+				continue;
+
+			state.chosen.push_back(j);
+			Offer(state.chosen, value + gain);
+
+			if (remaining > 1 && _idle.load(std::memory_order_relaxed) > 0)
+			{
+				// 노는 스레드가 있으면 하위 트리를 덱에 넘겨서 훔쳐 가게 함
+				// (작업이 보이기 전에 개수부터 늘려야 다른 스레드가 _pending == 0 을 보고 끝나지 않음)
+				WorkerQueue& own = _queues[worker];
+				_pending.fetch_add(1);
+				{
+					std::lock_guard<std::mutex> lock(own.mutex);
+					own.tasks.push_back({ state.chosen, j + 1 });
+				}
+			}
+			else if (remaining > 1)
+			{
+				for (int w = 0; w < stride; ++w)
+					childCovered[w] = covered[w] | mask[w];
+				state.occupied[placement.tileIndex] = 1;
+				++state.classUsed[placement.operatorClass];
+
+				Search(worker, state, j + 1);
+
+				state.occupied[placement.tileIndex] = 0;
+				--state.classUsed[placement.operatorClass];
+			}
+
+			state.chosen.pop_back();
+		}
+	}
+
+	const DeploymentSolver& _solver;
+	const int _limit;
+	const int _keep;
+	const DeploymentSolverConfig& _config;
+	DeploymentSolverProgress* const _progress;
+	const std::chrono::steady_clock::time_point _start;
+
+	std::vector<WorkerQueue> _queues;
+	std::atomic<int> _pending{ 0 };
+	std::atomic<int> _idle{ 0 };
+	std::atomic<bool> _stop{ false };
+	std::atomic<uint64_t> _nodes{ 0 };
+	std::atomic<uint64_t> _steals{ 0 };
+
+	std::mutex _bestMutex;
+	std::vector<std::pair<int, std::vector<int>>> _best;	// (커버리지, 정렬된 배치 인덱스) 내림차순
+	std::atomic<int> _threshold{ 0 };						// 이 값 이하의 배치는 보관할 필요 없음
+	int _published = 0;										// progress 에 알린 최선 커버리지 (_bestMutex)
+};
+
+bool DeploymentSolverProgress::GetBest(DeploymentPlan& out) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (!_hasBest)
+		return false;
+	out = _best;
+	return true;
+}
+
+void DeploymentSolverProgress::Publish(DeploymentPlan plan)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_best = std::move(plan);
+	_hasBest = true;
+}
+
+DeploymentPlan DeploymentSolver::MakePlan(int coverage, const std::vector<int>& chosen) const
+{
+	DeploymentPlan plan;
+	plan.coverage = coverage;
+
+	std::vector<int> classUsed(_classMembers.size(), 0);
+	for (int index : chosen)
+	{
+		const Placement& placement = _placements[index];
+		PlacedOperator placed;
+		placed.operatorIndex = _classMembers[placement.operatorClass][classUsed[placement.operatorClass]++];
+		placed.tile = placement.tile;
+		placed.direction = placement.direction;
+		placed.coverage = placement.coverage;
+		plan.placements.push_back(placed);
+	}
+	return plan;
+}
+
+DeploymentSolveResult DeploymentSolver::Solve(const DeploymentSolverConfig& config, DeploymentSolverProgress* progress) const
+{
+	auto start = std::chrono::steady_clock::now();
+
+	DeploymentSolveResult result;
+	result.pathTiles = _pathTiles;
+	result.placementCount = (int)_placements.size();
+	result.operatorClasses = (int)_classMembers.size();
+
+	int limit = config.characterLimit >= 0 ? config.characterLimit : _level.options.characterLimit;
+	limit = std::min(limit, (int)_roster.size());
+	int keep = config.objective == DeploymentObjective::Kills ? std::max(1, config.candidatePlans) : 1;
+
+	if (limit > 0 && !_placements.empty())
+	{
+		DeploymentSearch search(*this, limit, keep, config, progress);
+		search.SeedGreedy();
+		search.Run();
+
+		result.nodes = search.Nodes();
+		result.steals = search.Steals();
+		result.exhaustive = !search.Stopped();
+		result.cancelled = progress && progress->Cancelled();
+
+		for (auto& [value, chosen] : search.TakeBest())
+			result.candidates.push_back(MakePlan(value, chosen));
+	}
+
+	if (config.objective == DeploymentObjective::Kills && !result.candidates.empty())
+	{
+		BattleSimulator simulator(_level, _enemies, _roster);
+		ParallelFor(result.candidates.size(), 1, [&](size_t begin, size_t end, unsigned)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					DeploymentPlan& plan = result.candidates[i];
+					SimResult sim = simulator.Run(plan.ToDeployments(_roster), config.simConfig);
+					plan.simulated = true;
+					plan.cleared = sim.cleared;
+					plan.kills = sim.enemiesKilled;
+					plan.leaks = sim.enemiesLeaked;
+				}
+			});
+
+		std::stable_sort(result.candidates.begin(), result.candidates.end(), [](const DeploymentPlan& a, const DeploymentPlan& b)
+			{
+				if (a.cleared != b.cleared)
+					return a.cleared;
+				if (a.kills != b.kills)
+					return a.kills > b.kills;
+				if (a.leaks != b.leaks)
+					return a.leaks < b.leaks;
+				return a.coverage > b.coverage;
+			});
+	}
+
+	if (!result.candidates.empty())
+	{
+		result.best = result.candidates.front();
+
+		LevelBitboard board = LevelBitboard::FromLevelGrid(_level);
+		result.bestCovered.assign((size_t)_level.rows * _level.cols, 0);
+		std::vector<uint64_t> mask(_stride);
+		for (const auto& placed : result.best.placements)
+		{
+			RangeBitboard range = RangeBitboard::FromOffsets(_roster[placed.operatorIndex].range).Rotated(placed.direction);
+			BuildCoverageMask(board, range, placed.tile.row, placed.tile.col, mask.data());
+			for (int row = 0; row < board.rows; ++row)
+			{
+				for (uint64_t bits = mask[row]; bits; bits &= bits - 1)
+					result.bestCovered[_level.TileIndex(row, std::countr_zero(bits))] = 1;
+			}
+		}
+	}
+
+	result.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "[Solver] " << _placements.size() << " placements, " << result.nodes << " nodes, coverage "
+		<< result.best.coverage << "/" << _pathTiles << (result.cancelled ? " (cancelled)" : result.exhaustive ? " (optimal)" : " (limit reached)")
+		<< " in " << result.elapsedMs << " ms\n";
+
+	return result;
+}
@@ -0,0 +1,132 @@
+﻿#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "BattleSimulator.h"
+#include "GameTables.h"
+#include "LevelGrid.h"
+
+enum class DeploymentObjective
+{
+	Coverage = 0,		// 경로 타일 커버리지 (합집합) 최대
+	Kills				// 커버리지 상위 배치를 시뮬레이션해서 처치 수 최대
+};
+
+struct DeploymentSolverConfig
+{
+	DeploymentObjective objective = DeploymentObjective::Coverage;
+	int characterLimit = -1;			// -1 = 레벨 옵션의 characterLimit
+	int candidatePlans = 16;			// Kills: 시뮬레이션할 커버리지 상위 배치 수
+	uint64_t nodeLimit = 20000000;		// 탐색 노드 상한 (넘으면 그때까지의 최선)
+	double timeLimit = 10.0;			// 초
+	SimConfig simConfig;
+};
+
+struct PlacedOperator
+{
+	int operatorIndex = 0;				// 로스터 인덱스
+	GridPos tile;
+	Direction direction = Direction::Right;
+	int coverage = 0;					// 단독 커버리지
+};
+
+struct DeploymentPlan
+{
+	std::vector<PlacedOperator> placements;
+	int coverage = 0;					// 합집합 경로 타일 수
+
+	// Kills 목적일 때 시뮬레이션 결과
+	bool simulated = false;
+	bool cleared = false;
+	int kills = 0;
+	int leaks = 0;
+
+	// 시간 0 에 커버리지 순서대로 배치하는 스크립트 (DP 가 모자라면 시뮬레이터가 순서대로 대기)
+	std::vector<Deployment> ToDeployments(const std::vector<OperatorStats>& roster) const;
+};
+
+struct DeploymentSolveResult
+{
+	DeploymentPlan best;
+	std::vector<DeploymentPlan> candidates;	// 목적 기준 정렬
+	std::vector<uint8_t> bestCovered;		// best 가 덮는 경로 타일 (index = row * cols + col)
+
+	int pathTiles = 0;
+	int placementCount = 0;					// 가지치기 후 후보 (클래스, 타일, 방향) 수
+	int operatorClasses = 0;				// 범위 모양 + 근거리/원거리 가 같은 오퍼레이터 묶음 수
+	uint64_t nodes = 0;
+	uint64_t steals = 0;
+	bool exhaustive = true;					// 노드/시간 상한에 걸리지 않았으면 최적
+	bool cancelled = false;
+	double elapsedMs = 0.0;
+};
+
+// 다른 스레드에서 돌고 있는 Solve 와 UI 가 공유하는 상태
+// UI 는 Cancel 로 탐색을 멈추고 (다음 노드 확인 때 중단), GetBest 로 지금까지 찾은 최선 배치를 읽음
+class DeploymentSolverProgress
+{
+public:
+	void Cancel() { _cancel.store(true); }
+	bool Cancelled() const { return _cancel.load(std::memory_order_relaxed); }
+	uint64_t Nodes() const { return _nodes.load(std::memory_order_relaxed); }
+
+	// 커버리지 기준 최선 (아직 없으면 false, Kills 목적의 시뮬레이션 전 값)
+	bool GetBest(DeploymentPlan& out) const;
+
+private:
+	std::atomic<bool> _cancel{ false };
+	std::atomic<uint64_t> _nodes{ 0 };
+
+	mutable std::mutex _mutex;
+	DeploymentPlan _best;
+	bool _hasBest = false;
+
+	void Publish(DeploymentPlan plan);
+
+	friend class DeploymentSearch;
+};
+
+// 배치 타일/방향 분기 한정 탐색
+// 범위 모양과 근거리/원거리가 같은 오퍼레이터는 서로 바꿔도 결과가 같으므로 한 클래스로 묶고,
+// 후보 배치를 커버리지 내림차순으로 정렬해 (남은 후보 커버리지 합, 남은 후보 합집합) 중 작은 쪽을 상한으로 가지치기
+// 하위 트리는 작업 스레드마다의 덱에 쌓고, 일이 없는 스레드가 다른 덱의 앞쪽(큰 하위 트리)을 훔쳐 감
+class DeploymentSolver
+{
+public:
+	DeploymentSolver(const LevelGrid& level,
+		const std::vector<EnemyStats>& enemies,
+		const std::vector<OperatorStats>& roster);
+
+	// progress 가 있으면 탐색 중 최선 배치를 알리고 취소 요청을 확인
+	DeploymentSolveResult Solve(const DeploymentSolverConfig& config, DeploymentSolverProgress* progress = nullptr) const;
+
+private:
+	struct Placement
+	{
+		int operatorClass = 0;
+		int tileIndex = 0;
+		GridPos tile;
+		Direction direction = Direction::Right;
+		int coverage = 0;
+	};
+
+	LevelGrid _level;
+	std::vector<EnemyStats> _enemies;
+	std::vector<OperatorStats> _roster;
+
+	int _stride = 0;							// 마스크 하나의 워드 수 (= level rows)
+	int _pathTiles = 0;
+	std::vector<std::vector<int>> _classMembers;	// 클래스 -> 로스터 인덱스
+	std::vector<Placement> _placements;			// 커버리지 내림차순
+	std::vector<uint64_t> _masks;				// 배치별 경로 마스크 (_stride 워드씩)
+	std::vector<uint64_t> _suffixUnion;			// [j] = 배치 j.. 마스크 합집합
+	std::vector<int> _prefixCoverage;			// [j] = 배치 0..j-1 커버리지 합
+
+	// 배치 인덱스 -> 실제 오퍼레이터 (클래스 안에서 순서대로 배정)
+	DeploymentPlan MakePlan(int coverage, const std::vector<int>& chosen) const;
+
+	friend class DeploymentSearch;
+};
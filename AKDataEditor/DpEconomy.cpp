@@ -0,0 +1,128 @@
+﻿#include "DpEconomy.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+std::vector<DpPlanEntry> BuildDpPlan(const std::vector<Deployment>& plan, const std::vector<OperatorStats>& operators)
+{
+	std::unordered_map<std::string, int> costLookup;
+	for (const auto& op : operators)
+		costLookup[op.charId] = op.cost;
+
+	std::vector<DpPlanEntry> out;
+	out.reserve(plan.size());
+	for (const auto& deployment : plan)
+	{
+		auto it = costLookup.find(deployment.charId);
+		out.push_back({ (it != costLookup.end()) ? it->second : 0, deployment.time });
+	}
+	return out;
+}
+
+DpEconomy::DpEconomy(const LevelOptions& options)
+	: _options(options)
+{
+}
+
+long long DpEconomy::TicksUntil(double time) const
+{
+	if (_options.costIncreaseTime <= 0.0 || time <= 0.0)
+		return 0;
+
+	// 부동소수점 오차로 정확히 틱 시점인데 한 틱 덜 세는 경우 방지
+	return (long long)std::floor(time / _options.costIncreaseTime + 1e-9);
+}
+
+int DpEconomy::DpAt(double time) const
+{
+	long long dp = _options.initialCost + TicksUntil(time);
+	return (int)std::min<long long>(dp, std::max(_options.maxCost, _options.initialCost));
+}
+
+DpPlanResult DpEconomy::Evaluate(const std::vector<DpPlanEntry>& plan,
+	std::vector<DpSample>* timeline, double horizon) const
+{
+	DpPlanResult result;
+	result.deployTimes.assign(plan.size(), -1.0);
+
+	const int cap = std::max(_options.maxCost, _options.initialCost);
+	const bool hasIncome = _options.costIncreaseTime > 0.0;
+
+	double time = 0.0;
+	long long ticks = 0;		// time 까지 반영된 틱 수
+	int dp = _options.initialCost;
+
+	if (timeline)
+	{
+		timeline->clear();
+		timeline->push_back({ 0.0, dp });
+	}
+
+	// time -> target 까지 틱 반영 (maxCost 초과분은 버림)
+	auto advance = [&](double target)
+		{
+			long long targetTicks = TicksUntil(target);
+			if (targetTicks > ticks)
+			{
+				long long gained = targetTicks - ticks;
+				long long kept = std::min<long long>(gained, std::max(0, cap - dp));
+
+				if (timeline)
+				{
+					for (long long k = 1; k <= kept; ++k)
+						timeline->push_back({ TickTime(ticks + k), dp + (int)k });
+				}
+
+				dp += (int)kept;
+				result.wastedDp += (int)(gained - kept);
+				ticks = targetTicks;
+			}
+			time = std::max(time, target);
+		};
+
+	for (size_t i = 0; i < plan.size(); ++i)
+	{
+		const DpPlanEntry& entry = plan[i];
+
+		if (result.deployedCount >= _options.characterLimit || entry.cost > cap)
+			break;
+
+		advance(entry.requestTime);
+
+		if (dp < entry.cost)
+		{
+			if (!hasIncome)
+				break;
+
+			long long need = entry.cost - dp;
+			advance(TickTime(ticks + need));
+		}
+
+		dp -= entry.cost;
+		++result.deployedCount;
+		result.deployTimes[i] = time;
+		result.finishTime = time;
+
+		if (timeline)
+			timeline->push_back({ time, dp });
+	}
+
+	if (horizon > time)
+		advance(horizon);
+
+	result.feasible = (result.deployedCount == (int)plan.size());
+	return result;
+}
+
+void DpEconomy::EvaluateBatch(const std::vector<std::vector<DpPlanEntry>>& plans, std::vector<DpPlanResult>& out) const
+{
+	out.resize(plans.size());
+
+	// 계획 하나는 수 마이크로초 수준이라 블록을 크게 잡아 스레드 분배 비용을 줄임
+	ParallelFor(plans.size(), 256, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t i = begin; i < end; ++i)
+				out[i] = Evaluate(plans[i]);
+		});
+}
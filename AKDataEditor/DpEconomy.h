@@ -0,0 +1,50 @@
+﻿#pragma once
+#include <vector>
+
+#include "GameTables.h"
+#include "LevelGrid.h"
+#include "BattleSimulator.h"
+
+// DP 계획 한 줄 (requestTime 이후 DP가 충분해지는 즉시 배치)
+struct DpPlanEntry
+{
+	int cost = 0;
+	double requestTime = 0.0;
+};
+
+struct DpPlanResult
+{
+	std::vector<double> deployTimes;	// 계획 순서, 배치 불가 시 -1
+	int deployedCount = 0;
+	int wastedDp = 0;					// maxCost 에 막혀 버려진 DP (horizon 까지)
+	double finishTime = 0.0;			// 마지막으로 배치된 시각
+	bool feasible = false;				// 모든 항목이 배치되었는지
+};
+
+// 배치 스크립트를 오퍼레이터 코스트 계획으로 변환 (테이블에 없는 오퍼레이터는 cost 0)
+std::vector<DpPlanEntry> BuildDpPlan(const std::vector<Deployment>& plan, const std::vector<OperatorStats>& operators);
+
+// 레벨 옵션(initialCost, maxCost, costIncreaseTime, characterLimit)만으로 DP 흐름을 계산
+// 시뮬레이션 스텝 없이 틱 단위 닫힌 식으로 진행하므로 계획 하나가 O(항목 수)
+// 계획은 순서대로 처리되며, 배치할 수 없는 항목 이후는 모두 배치 불가 (BattleSimulator 와 동일)
+class DpEconomy
+{
+public:
+	explicit DpEconomy(const LevelOptions& options);
+
+	// timeline 이 주어지면 horizon 까지 DP 가 바뀌는 모든 시점을 기록
+	DpPlanResult Evaluate(const std::vector<DpPlanEntry>& plan,
+		std::vector<DpSample>* timeline = nullptr, double horizon = 0.0) const;
+
+	// 후보 계획 여러 개를 모든 코어에서 평가
+	void EvaluateBatch(const std::vector<std::vector<DpPlanEntry>>& plans, std::vector<DpPlanResult>& out) const;
+
+	// 아무것도 배치하지 않았을 때 time 시점의 DP
+	int DpAt(double time) const;
+
+private:
+	LevelOptions _options;
+
+	long long TicksUntil(double time) const;
+	double TickTime(long long tick) const { return tick * _options.costIncreaseTime; }
+};
@@ -0,0 +1,515 @@
+﻿#include "EditHistory.h"
+#include "EditJournal.h"
+#include <algorithm>
+#include <unordered_map>
+
+// ---------------------------------------------------------------------------
+// 경로 공유
+// ---------------------------------------------------------------------------
+
+namespace
+{
+	struct PathTable
+	{
+		std::unordered_map<std::string, uint32_t> ids;
+		std::deque<std::string> strings;
+		std::deque<json::json_pointer> pointers;
+	};
+
+	PathTable& Paths()
+	{
+		static PathTable table;
+		return table;
+	}
+
+	const std::string& PathString(uint32_t id)
+	{
+		return Paths().strings[id];
+	}
+
+	// a 가 b 의 조상이거나 자손이거나 같은 경로인지
+	bool PathsOverlap(uint32_t a, uint32_t b)
+	{
+		const std::string& x = PathString(a);
+		const std::string& y = PathString(b);
+		const std::string& shorter = (x.size() <= y.size()) ? x : y;
+		const std::string& longer = (x.size() <= y.size()) ? y : x;
+		if (longer.compare(0, shorter.size(), shorter) != 0)
+			return false;
+		return longer.size() == shorter.size() || longer[shorter.size()] == '/';
+	}
+
+	void AppendToken(std::string& path, const std::string& token)
+	{
+		path += '/';
+		for (char c : token)
+		{
+			if (c == '~')
+				path += "~0";
+			else if (c == '/')
+				path += "~1";
+			else
+				path += c;
+		}
+	}
+
+	json Missing()
+	{
+		return json(json::value_t::discarded);
+	}
+
+	void DiffValue(int record, const json& before, const json& after, std::string& path, std::vector<RecordValueChange>& out)
+	{
+		if (before.is_object() && after.is_object())
+		{
+			for (auto it = before.begin(); it != before.end(); ++it)
+			{
+				size_t length = path.size();
+				AppendToken(path, it.key());
+
+				auto found = after.find(it.key());
+				if (found != after.end())
+					DiffValue(record, it.value(), *found, path, out);
+				else
+					out.push_back({ record, InternEditPath(path), it.value(), Missing() });
+
+				path.resize(length);
+			}
+
+			for (auto it = after.begin(); it != after.end(); ++it)
+			{
+				if (before.contains(it.key()))
+					continue;
+
+				size_t length = path.size();
+				AppendToken(path, it.key());
+				out.push_back({ record, InternEditPath(path), Missing(), it.value() });
+				path.resize(length);
+			}
+			return;
+		}
+
+		if (before.is_array() && after.is_array() && before.size() == after.size())
+		{
+			for (size_t i = 0; i < before.size(); ++i)
+			{
+				size_t length = path.size();
+				path += '/';
+				path += std::to_string(i);
+				DiffValue(record, before[i], after[i], path, out);
+				path.resize(length);
+			}
+			return;
+		}
+
+		// 숫자는 정수/실수 표현이 달라도 값이 같으면 같은 것으로 봄
+		if (before == after)
+			return;
+
+		out.push_back({ record, InternEditPath(path), before, after });
+	}
+
+	// 문자열/배열/객체가 힙에 잡는 크기 (대략)
+	size_t JsonHeapBytes(const json& value)
+	{
+		switch (value.type())
+		{
+		case json::value_t::string:
+			return value.get_ref<const std::string&>().capacity();
+		case json::value_t::array:
+		{
+			size_t bytes = value.size() * sizeof(json);
+			for (const auto& item : value)
+				bytes += JsonHeapBytes(item);
+			return bytes;
+		}
+		case json::value_t::object:
+		{
+			size_t bytes = 0;
+			for (auto it = value.begin(); it != value.end(); ++it)
+				bytes += sizeof(std::pair<std::string, json>) + it.key().capacity() + JsonHeapBytes(it.value());
+			return bytes;
+		}
+		default:
+			return 0;
+		}
+	}
+}
+
+uint32_t InternEditPath(const std::string& path)
+{
+	PathTable& table = Paths();
+	auto it = table.ids.find(path);
+	if (it != table.ids.end())
+		return it->second;
+
+	uint32_t id = (uint32_t)table.strings.size();
+	table.strings.push_back(path);
+	table.pointers.emplace_back(path);
+	table.ids.emplace(path, id);
+	return id;
+}
+
+const json::json_pointer& EditPath(uint32_t id)
+{
+	return Paths().pointers[id];
+}
+
+void DiffRecord(int record, const json& before, const json& after, std::vector<RecordValueChange>& out, const std::string& path)
+{
+	// 없던 위치가 계속 없으면 바뀐 것 없음 (discarded 끼리는 같다고 비교되지 않음)
+	if (before.is_discarded() && after.is_discarded())
+		return;
+
+	std::string current = path;
+	DiffValue(record, before, after, current, out);
+}
+
+void SetJsonValue(json& root, const json::json_pointer& pointer, const json& value)
+{
+	if (!value.is_discarded())
+	{
+		root[pointer] = value;
+		return;
+	}
+
+	if (pointer.empty() || !root.contains(pointer.parent_pointer()))
+		return;
+
+	json& parent = root[pointer.parent_pointer()];
+	if (parent.is_object())
+		parent.erase(pointer.back());
+	else if (parent.is_array())
+	{
+		size_t index = std::stoul(pointer.back());
+		if (index < parent.size())
+			parent.erase(index);
+	}
+}
+
+// ---------------------------------------------------------------------------
+// RecordValueCommand
+// ---------------------------------------------------------------------------
+
+RecordValueCommand::RecordValueCommand(RecordEditTarget* target, std::vector<RecordValueChange> changes, std::string label)
+	: _target(target), _changes(std::move(changes)), _label(std::move(label))
+{
+}
+
+void RecordValueCommand::Undo()
+{
+	for (auto it = _changes.rbegin(); it != _changes.rend(); ++it)
+		_target->SetRecordValue(it->record, EditPath(it->path), it->before);
+}
+
+void RecordValueCommand::Redo()
+{
+	for (const RecordValueChange& change : _changes)
+		_target->SetRecordValue(change.record, EditPath(change.path), change.after);
+}
+
+void RecordValueCommand::Journal(EditJournal& journal, bool forward) const
+{
+	if (forward)
+	{
+		for (const RecordValueChange& change : _changes)
+			journal.WriteSet(_target, change.record, change.path, change.after);
+	}
+	else
+	{
+		for (auto it = _changes.rbegin(); it != _changes.rend(); ++it)
+			journal.WriteSet(_target, it->record, it->path, it->before);
+	}
+}
+
+bool RecordValueCommand::Merge(EditCommand& next)
+{
+	auto* other = dynamic_cast<RecordValueCommand*>(&next);
+	if (!other || other->_target != _target || !_label.empty() || !other->_label.empty())
+		return false;
+	if (_changes.empty() || other->_changes.empty() || _changes.front().record != other->_changes.front().record)
+		return false;
+
+	for (RecordValueChange& change : other->_changes)
+	{
+		// 같은 경로를 다시 고쳤고 그 뒤에 겹치는 경로가 없으면 after 만 바꿈 (아니면 뒤에 붙임)
+		bool merged = false;
+		for (size_t i = _changes.size(); i-- > 0;)
+		{
+			if (!PathsOverlap(_changes[i].path, change.path))
+				continue;
+
+			if (_changes[i].path == change.path && _changes[i].record == change.record)
+			{
+				_changes[i].after = std::move(change.after);
+				if (_changes[i].before == _changes[i].after)
+					_changes.erase(_changes.begin() + i);
+				merged = true;
+			}
+			break;
+		}
+
+		if (!merged)
+			_changes.push_back(std::move(change));
+	}
+	return true;
+}
+
+std::string RecordValueCommand::Label() const
+{
+	if (!_label.empty())
+		return _label;
+	if (_changes.empty())
+		return std::string(_target->EditTargetName()) + " 편집";
+
+	// 마지막으로 바꾼 필드 이름 (m_value 같은 래퍼는 건너뜀)
+	const json::json_pointer& pointer = EditPath(_changes.back().path);
+	std::string field;
+	for (json::json_pointer p = pointer; !p.empty(); p = p.parent_pointer())
+	{
+		field = p.back();
+		if (field != "m_value" && field != "m_defined")
+			break;
+	}
+
+	std::string label = std::string(_target->EditTargetName()) + " " + _target->EditRecordLabel(_changes.back().record);
+	if (!field.empty())
+		label += " (" + field + ")";
+	return label;
+}
+
+size_t RecordValueCommand::ByteSize() const
+{
+	size_t bytes = sizeof(*this) + _changes.capacity() * sizeof(RecordValueChange) + _label.capacity();
+	for (const RecordValueChange& change : _changes)
+		bytes += JsonHeapBytes(change.before) + JsonHeapBytes(change.after);
+	return bytes;
+}
+
+// ---------------------------------------------------------------------------
+// RecordStructureCommand
+// ---------------------------------------------------------------------------
+
+RecordStructureCommand::RecordStructureCommand(RecordEditTarget* target, bool inserted, std::vector<int> indices, std::vector<json> records, std::string label)
+	: _target(target), _inserted(inserted), _indices(std::move(indices)), _records(std::move(records)), _label(std::move(label))
+{
+	_bytes = sizeof(*this) + _indices.capacity() * sizeof(int) + _records.capacity() * sizeof(json) + _label.capacity();
+	for (const json& record : _records)
+		_bytes += JsonHeapBytes(record);
+}
+
+void RecordStructureCommand::Undo()
+{
+	if (_inserted)
+		_target->RemoveRecords(_indices);
+	else
+		_target->InsertRecords(_indices, _records);
+}
+
+void RecordStructureCommand::Redo()
+{
+	if (_inserted)
+		_target->InsertRecords(_indices, _records);
+	else
+		_target->RemoveRecords(_indices);
+}
+
+void RecordStructureCommand::Journal(EditJournal& journal, bool forward) const
+{
+	if (_inserted == forward)
+		journal.WriteInsert(_target, _indices, _records);
+	else
+		journal.WriteRemove(_target, _indices, _records);
+}
+
+// ---------------------------------------------------------------------------
+// EditHistory
+// ---------------------------------------------------------------------------
+
+EditHistory::EditHistory(size_t maxSteps)
+	: _maxSteps(std::max<size_t>(1, maxSteps))
+{
+}
+
+void EditHistory::Push(std::unique_ptr<EditCommand> command)
+{
+	if (_applying || !command || command->IsEmpty())
+		return;
+
+	if (_journal)
+		command->Journal(*_journal, true);
+
+	for (const auto& undone : _redo)
+		_bytes -= undone->ByteSize();
+	_redo.clear();
+
+	if (!_sealed && !_undo.empty())
+	{
+		EditCommand& top = *_undo.back();
+		size_t before = top.ByteSize();
+		if (top.Merge(*command))
+		{
+			_bytes -= before;
+			if (top.IsEmpty())
+				_undo.pop_back();	// 원래 값으로 돌아옴
+			else
+				_bytes += top.ByteSize();
+			return;
+		}
+	}
+
+	_bytes += command->ByteSize();
+	_undo.push_back(std::move(command));
+	_sealed = false;
+
+	while (_undo.size() > _maxSteps)
+	{
+		_bytes -= _undo.front()->ByteSize();
+		_undo.pop_front();
+	}
+}
+
+bool EditHistory::Undo()
+{
+	if (_undo.empty())
+		return false;
+
+	std::unique_ptr<EditCommand> command = std::move(_undo.back());
+	_undo.pop_back();
+
+	_applying = true;
+	command->Undo();
+	_applying = false;
+
+	if (_journal)
+		command->Journal(*_journal, false);
+
+	_redo.push_back(std::move(command));
+	_sealed = true;
+	return true;
+}
+
+bool EditHistory::Redo()
+{
+	if (_redo.empty())
+		return false;
+
+	std::unique_ptr<EditCommand> command = std::move(_redo.back());
+	_redo.pop_back();
+
+	_applying = true;
+	command->Redo();
+	_applying = false;
+
+	if (_journal)
+		command->Journal(*_journal, true);
+
+	_undo.push_back(std::move(command));
+	_sealed = true;
+	return true;
+}
+
+void EditHistory::Forget(const RecordEditTarget* target)
+{
+	ForgetSteps(target);
+
+	// 다시 읽었거나 기록하지 않는 구조 변경이므로 저널의 이전 편집도 맞지 않음
+	if (_journal)
+		_journal->WriteDrop(target);
+}
+
+void EditHistory::ForgetSteps(const RecordEditTarget* target, const std::vector<std::string>& removedSources)
+{
+	auto sameTarget = [target](const std::unique_ptr<EditCommand>& command) { return command->Target() == target; };
+	_undo.erase(std::remove_if(_undo.begin(), _undo.end(), sameTarget), _undo.end());
+	_redo.erase(std::remove_if(_redo.begin(), _redo.end(), sameTarget), _redo.end());
+	_sealed = true;
+	RecountBytes();
+
+	if (_journal)
+	{
+		for (const std::string& source : removedSources)
+			_journal->WriteDrop(target, source);
+	}
+}
+
+void EditHistory::MarkSaved(const RecordEditTarget* target)
+{
+	if (_journal)
+		_journal->Compact(target);
+}
+
+JournalReplayReport EditHistory::ReplayJournal(const std::vector<RecordEditTarget*>& targets)
+{
+	if (!_journal)
+		return {};
+
+	_applying = true;
+	JournalReplayReport report = _journal->Replay(targets);
+	_applying = false;
+
+	Clear();
+	return report;
+}
+
+void EditHistory::Clear()
+{
+	_undo.clear();
+	_redo.clear();
+	_sealed = true;
+	_bytes = 0;
+}
+
+void EditHistory::RecountBytes()
+{
+	_bytes = 0;
+	for (const auto& command : _undo)
+		_bytes += command->ByteSize();
+	for (const auto& command : _redo)
+		_bytes += command->ByteSize();
+}
+
+// ---------------------------------------------------------------------------
+// RecordEditTracker
+// ---------------------------------------------------------------------------
+
+void RecordEditTracker::Reset(int record, uint64_t revision, json base)
+{
+	Reset(record, revision, json::json_pointer(), std::move(base));
+}
+
+void RecordEditTracker::Reset(int record, uint64_t revision, const json::json_pointer& scope, json base)
+{
+	_record = record;
+	_revision = revision;
+	_scope = scope;
+	_base = std::move(base);
+}
+
+void RecordEditTracker::Commit(EditHistory* history, RecordEditTarget* target, int record, const json& current, uint64_t newRevision)
+{
+	if (!history || history->IsApplying() || _record != record)
+		return;
+
+	std::vector<RecordValueChange> changes;
+	if (_scope.empty())
+	{
+		DiffRecord(record, _base, current, changes);
+
+		// 기준 사본도 바뀐 값만 고쳐 다음 편집과 비교
+		for (const RecordValueChange& change : changes)
+			SetJsonValue(_base, EditPath(change.path), change.after);
+	}
+	else
+	{
+		// 하위 트리만 비교하고 기준도 그 하위 트리만 새로 잡음
+		json missing(json::value_t::discarded);
+		const json& now = current.contains(_scope) ? current.at(_scope) : missing;
+		DiffRecord(record, _base, now, changes, _scope.to_string());
+		_base = now;
+	}
+	_revision = newRevision;
+
+	if (!changes.empty())
+		history->Push(std::make_unique<RecordValueCommand>(target, std::move(changes)));
+}
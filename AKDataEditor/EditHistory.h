@@ -0,0 +1,200 @@
+﻿#pragma once
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::ordered_json;
+
+class EditJournal;
+struct JournalReplayReport;
+
+// 되돌리기 기록이 레코드 배열을 고칠 때 쓰는 통로 (각 편집기가 구현)
+// 레코드는 enemies[] / operators[] / skills[] / 레벨 fullData 하나
+class RecordEditTarget
+{
+public:
+	virtual ~RecordEditTarget() = default;
+
+	virtual const char* EditTargetName() const = 0;
+	virtual std::string EditRecordLabel(int record) const = 0;
+	virtual int EditRecordCount() const = 0;
+
+	// 레코드 하나의 pointer 위치를 value 로 바꿈 (value 가 discarded 면 그 필드를 지움)
+	// 편집기는 바꾼 레코드만 다시 해석 (파생 데이터 / revision 갱신)
+	virtual void SetRecordValue(int record, const json::json_pointer& pointer, const json& value) = 0;
+
+	// indices 는 오름차순, 삽입 후 각 레코드가 놓일 위치
+	// 구조 명령을 기록하지 않는 편집기 (레벨) 는 구현하지 않아도 됨
+	virtual void InsertRecords(const std::vector<int>& /*indices*/, const std::vector<json>& /*records*/) {}
+	virtual void RemoveRecords(const std::vector<int>& /*indices*/) {}
+
+	// 저널 복구용 레코드 id 와 레코드 안에서 id 가 있는 위치 (위치가 바뀌어도 같은 레코드를 찾음, 비면 위치만 믿음)
+	virtual std::string EditRecordKey(int /*record*/) const { return {}; }
+	virtual std::string EditRecordKeyPath() const { return {}; }
+
+	// 레코드를 읽어 온 파일 (모든 레코드가 한 파일이면 빈 문자열) 과 그 파일을 읽었을 때의 내용 해시
+	// 복구할 때 해시가 저널과 다르면 디스크 파일이 바뀐 것이므로 그 파일의 편집은 적용하지 않음
+	virtual std::string EditRecordSource(int /*record*/) const { return {}; }
+	virtual uint64_t EditSourceHash(const std::string& /*source*/) const { return 0; }
+};
+
+// 경로 문자열을 한 번만 저장하고 번호로 공유 (같은 필드를 만 번 고쳐도 경로는 하나)
+uint32_t InternEditPath(const std::string& path);
+const json::json_pointer& EditPath(uint32_t id);
+
+// 값 하나의 변경 (필드가 없던 쪽은 discarded)
+struct RecordValueChange
+{
+	int record = -1;
+	uint32_t path = 0;
+	json before;
+	json after;
+};
+
+// pointer 위치에 value 를 씀 (discarded 면 그 필드/원소를 지움)
+void SetJsonValue(json& root, const json::json_pointer& pointer, const json& value);
+
+// 두 레코드를 비교해 바뀐 값만 out 에 추가 (객체/길이가 같은 배열은 안으로 들어가고, 길이가 다른 배열은 통째로)
+// path = before/after 가 레코드 안에서 있는 위치 (하위 트리만 비교할 때)
+void DiffRecord(int record, const json& before, const json& after, std::vector<RecordValueChange>& out, const std::string& path = "");
+
+// 되돌리기 단위 하나 (이미 적용된 상태로 기록)
+class EditCommand
+{
+public:
+	virtual ~EditCommand() = default;
+
+	virtual void Undo() = 0;
+	virtual void Redo() = 0;
+
+	// 봉인 전에 이어서 들어온 편집을 합침 (슬라이더 드래그, 그리드 칠하기 한 번 = 한 단계)
+	virtual bool Merge(EditCommand& /*next*/) { return false; }
+	virtual bool IsEmpty() const { return false; }
+
+	virtual const RecordEditTarget* Target() const = 0;
+	virtual std::string Label() const = 0;
+	virtual size_t ByteSize() const = 0;
+
+	// 적용한 결과를 저널에 남김 (forward = Redo 방향, 아니면 Undo 방향)
+	virtual void Journal(EditJournal& journal, bool forward) const = 0;
+};
+
+// 값 변경 (레코드 하나 또는 일괄 편집의 여러 레코드)
+class RecordValueCommand : public EditCommand
+{
+public:
+	RecordValueCommand(RecordEditTarget* target, std::vector<RecordValueChange> changes, std::string label = "");
+
+	void Undo() override;
+	void Redo() override;
+	bool Merge(EditCommand& next) override;
+	bool IsEmpty() const override { return _changes.empty(); }
+
+	const RecordEditTarget* Target() const override { return _target; }
+	std::string Label() const override;
+	size_t ByteSize() const override;
+	void Journal(EditJournal& journal, bool forward) const override;
+
+private:
+	RecordEditTarget* _target;
+	std::vector<RecordValueChange> _changes;
+	std::string _label;		// 비어 있으면 대상/레코드 이름으로 만듦
+};
+
+// 레코드 추가/삭제 (바뀐 레코드만 보관)
+class RecordStructureCommand : public EditCommand
+{
+public:
+	RecordStructureCommand(RecordEditTarget* target, bool inserted, std::vector<int> indices, std::vector<json> records, std::string label);
+
+	void Undo() override;
+	void Redo() override;
+
+	const RecordEditTarget* Target() const override { return _target; }
+	std::string Label() const override { return _label; }
+	size_t ByteSize() const override { return _bytes; }
+	void Journal(EditJournal& journal, bool forward) const override;
+
+private:
+	RecordEditTarget* _target;
+	bool _inserted;
+	std::vector<int> _indices;
+	std::vector<json> _records;
+	std::string _label;
+	size_t _bytes = 0;
+};
+
+// 프로젝트 전체 실행 취소 / 다시 실행 기록
+// 명령은 바뀐 값만 들고 있으므로 되돌리기/다시 실행은 변경 크기에 비례
+class EditHistory
+{
+public:
+	explicit EditHistory(size_t maxSteps = 10000);
+
+	void Push(std::unique_ptr<EditCommand> command);
+
+	// 진행 중인 편집 동작이 끝남 (다음 Push 는 새 단계)
+	void Seal() { _sealed = true; }
+
+	// 기록/되돌리기/다시 실행으로 바뀐 값을 저널에도 남김 (비정상 종료 복구용)
+	void SetJournal(EditJournal* journal) { _journal = journal; }
+	void MarkSaved(const RecordEditTarget* target);		// 저장한 대상의 저널 편집을 버림
+
+	// 저널에 남은 편집을 기록 없이 적용 (복구한 상태가 새 기준)
+	JournalReplayReport ReplayJournal(const std::vector<RecordEditTarget*>& targets);
+
+	bool Undo();
+	bool Redo();
+	bool CanUndo() const { return !_undo.empty(); }
+	bool CanRedo() const { return !_redo.empty(); }
+	std::string UndoLabel() const { return _undo.empty() ? "" : _undo.back()->Label(); }
+	std::string RedoLabel() const { return _redo.empty() ? "" : _redo.back()->Label(); }
+
+	// 기록 없이 다시 읽거나 구조가 바뀐 대상의 명령을 버림 (저널의 편집도)
+	void Forget(const RecordEditTarget* target);
+	// 레코드 위치만 바뀐 구조 변경: 명령은 버리고, 저널은 레코드 id 로 찾으므로 없어진 파일의 편집만 버림
+	void ForgetSteps(const RecordEditTarget* target, const std::vector<std::string>& removedSources = {});
+	void Clear();
+
+	// 되돌리는 중에는 편집기가 새 명령을 만들지 않음
+	bool IsApplying() const { return _applying; }
+
+	size_t UndoCount() const { return _undo.size(); }
+	size_t RedoCount() const { return _redo.size(); }
+	size_t ByteSize() const { return _bytes; }
+
+private:
+	std::deque<std::unique_ptr<EditCommand>> _undo;
+	std::deque<std::unique_ptr<EditCommand>> _redo;
+	size_t _maxSteps;
+	size_t _bytes = 0;
+	bool _sealed = true;
+	bool _applying = false;
+	EditJournal* _journal = nullptr;
+
+	void RecountBytes();
+};
+
+// 편집 창이 보고 있는 레코드 하나의 기준 사본
+// 편집기는 값을 고친 뒤 Commit 만 부르면 기준과 다른 값만 골라 명령으로 기록
+class RecordEditTracker
+{
+public:
+	bool IsTracking(int record, uint64_t revision) const { return _record == record && _revision == revision; }
+	void Reset(int record, uint64_t revision, json base);
+	// 큰 레코드 (레벨): 고치기 직전에 바꿀 하위 트리만 기준으로 잡음 (Commit 은 scope 아래만 비교, 없던 위치면 base 는 discarded)
+	void Reset(int record, uint64_t revision, const json::json_pointer& scope, json base);
+	void Invalidate() { _record = -1; }
+
+	// 기준 레코드가 아니면 아무것도 기록하지 않음 (newRevision = 수정 후 revision)
+	void Commit(EditHistory* history, RecordEditTarget* target, int record, const json& current, uint64_t newRevision);
+
+private:
+	int _record = -1;
+	uint64_t _revision = 0;
+	json::json_pointer _scope;		// 비어 있으면 레코드 전체
+	json _base;
+};
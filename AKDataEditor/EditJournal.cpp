@@ -0,0 +1,937 @@
+﻿#include "EditJournal.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+// 파일: "AKJ1" + 버전(u32), 이후 프레임 [길이 u32][CRC32 u32][항목...]
+// 항목: [op u8] + op 별 본문 (정수는 리틀 엔디언, 문자열은 길이 u32 + 바이트)
+namespace
+{
+	constexpr char MAGIC[4] = { 'A', 'K', 'J', '1' };
+	constexpr uint32_t FORMAT_VERSION = 2;		// 2: 묶음별 파일 해시와 레코드 id (1 은 읽지 않고 새로 시작)
+	constexpr size_t HEADER_BYTES = 8;
+
+	constexpr size_t FLUSH_BYTES = 64 * 1024;
+	constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(200);
+
+	enum Op : uint8_t
+	{
+		DEFINE_STREAM = 1,	// id u32, 대상 이름, 파일, 파일 해시 u64
+		DEFINE_PATH,		// id u32, 길이 u32, JSON pointer
+		SET,				// 묶음 u32, 레코드 u32, id, 경로 u32, 값
+		INSERT,				// 묶음 u32, 개수 u32, (인덱스 u32, 값) * 개수
+		REMOVE,				// 묶음 u32, 개수 u32, (인덱스 u32, id) * 개수
+		DROP,				// 묶음 u32
+	};
+
+	// 값: [태그 u8] + 본문 (자주 쓰는 스칼라는 CBOR 을 거치지 않음)
+	enum ValueTag : uint8_t
+	{
+		VALUE_DISCARDED = 0,
+		VALUE_NULL,
+		VALUE_FALSE,
+		VALUE_TRUE,
+		VALUE_INT,			// i64
+		VALUE_UINT,			// u64
+		VALUE_FLOAT,		// f64
+		VALUE_STRING,		// 길이 u32, 바이트
+		VALUE_CBOR,			// 길이 u32, 바이트 (객체/배열)
+	};
+
+	uint32_t Crc32(const char* data, size_t size)
+	{
+		static const std::array<uint32_t, 256> table = []
+			{
+				std::array<uint32_t, 256> t{};
+				for (uint32_t i = 0; i < 256; ++i)
+				{
+					uint32_t c = i;
+					for (int k = 0; k < 8; ++k)
+						c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+					t[i] = c;
+				}
+				return t;
+			}();
+
+		uint32_t crc = 0xFFFFFFFFu;
+		for (size_t i = 0; i < size; ++i)
+			crc = table[(crc ^ (uint8_t)data[i]) & 0xFF] ^ (crc >> 8);
+		return crc ^ 0xFFFFFFFFu;
+	}
+
+	template <typename T>
+	void Put(std::string& out, T value)
+	{
+		out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	void PutBytes(std::string& out, const std::string& bytes)
+	{
+		Put<uint32_t>(out, (uint32_t)bytes.size());
+		out += bytes;
+	}
+
+	void PutValue(std::string& out, const json& value)
+	{
+		switch (value.type())
+		{
+		case json::value_t::discarded:
+			Put<uint8_t>(out, VALUE_DISCARDED);
+			break;
+		case json::value_t::null:
+			Put<uint8_t>(out, VALUE_NULL);
+			break;
+		case json::value_t::boolean:
+			Put<uint8_t>(out, value.get<bool>() ? VALUE_TRUE : VALUE_FALSE);
+			break;
+		case json::value_t::number_integer:
+			Put<uint8_t>(out, VALUE_INT);
+			Put<int64_t>(out, value.get<int64_t>());
+			break;
+		case json::value_t::number_unsigned:
+			Put<uint8_t>(out, VALUE_UINT);
+			Put<uint64_t>(out, value.get<uint64_t>());
+			break;
+		case json::value_t::number_float:
+			Put<uint8_t>(out, VALUE_FLOAT);
+			Put<double>(out, value.get<double>());
+			break;
+		case json::value_t::string:
+			Put<uint8_t>(out, VALUE_STRING);
+			PutBytes(out, value.get_ref<const std::string&>());
+			break;
+		default:
+		{
+			std::vector<uint8_t> cbor = json::to_cbor(value);
+			Put<uint8_t>(out, VALUE_CBOR);
+			Put<uint32_t>(out, (uint32_t)cbor.size());
+			out.append(reinterpret_cast<const char*>(cbor.data()), cbor.size());
+			break;
+		}
+		}
+	}
+
+	// 범위를 넘으면 ok = false 로 멈춤 (잘린 파일)
+	struct Reader
+	{
+		const char* data;
+		size_t size;
+		size_t pos = 0;
+		bool ok = true;
+
+		template <typename T>
+		T Get()
+		{
+			T value{};
+			if (!Need(sizeof(T)))
+				return value;
+			std::memcpy(&value, data + pos, sizeof(T));
+			pos += sizeof(T);
+			return value;
+		}
+
+		std::string GetBytes()
+		{
+			uint32_t length = Get<uint32_t>();
+			if (!Need(length))
+				return {};
+			std::string bytes(data + pos, length);
+			pos += length;
+			return bytes;
+		}
+
+		void Skip(size_t length)
+		{
+			if (Need(length))
+				pos += length;
+		}
+
+		bool Need(size_t length)
+		{
+			if (ok && size - pos >= length)
+				return true;
+			ok = false;
+			return false;
+		}
+	};
+
+	json GetValue(Reader& reader)
+	{
+		switch (reader.Get<uint8_t>())
+		{
+		case VALUE_DISCARDED: return json(json::value_t::discarded);
+		case VALUE_NULL: return json(nullptr);
+		case VALUE_FALSE: return json(false);
+		case VALUE_TRUE: return json(true);
+		case VALUE_INT: return json(reader.Get<int64_t>());
+		case VALUE_UINT: return json(reader.Get<uint64_t>());
+		case VALUE_FLOAT: return json(reader.Get<double>());
+		case VALUE_STRING: return json(reader.GetBytes());
+		case VALUE_CBOR:
+		{
+			uint32_t length = reader.Get<uint32_t>();
+			if (!reader.Need(length))
+				return json();
+			const char* begin = reader.data + reader.pos;
+			reader.pos += length;
+			return json::from_cbor(begin, begin + length, true, false);
+		}
+		default:
+			reader.ok = false;
+			return json();
+		}
+	}
+
+	void SkipValue(Reader& reader)
+	{
+		switch (reader.Get<uint8_t>())
+		{
+		case VALUE_DISCARDED: case VALUE_NULL: case VALUE_FALSE: case VALUE_TRUE: break;
+		case VALUE_INT: case VALUE_UINT: case VALUE_FLOAT: reader.Skip(8); break;
+		case VALUE_STRING: case VALUE_CBOR: reader.Skip(reader.Get<uint32_t>()); break;
+		default: reader.ok = false; break;
+		}
+	}
+
+	// 파일에서 읽은 편집 하나 (값/본문은 bytes 의 offset 부터, 적용할 때만 해석)
+	struct JournalOp
+	{
+		uint8_t op = 0;
+		uint32_t record = 0;
+		uint32_t path = 0;			// ParsedJournal::paths 인덱스
+		std::string key;			// SET 레코드 id
+		size_t offset = 0;
+	};
+
+	// (대상, 레코드를 읽어 온 파일) 하나의 편집
+	struct JournalStream
+	{
+		std::string target;
+		std::string source;
+		uint64_t hash = 0;			// 편집을 처음 쓸 때의 파일 해시
+		std::vector<JournalOp> ops;	// 마지막 Drop 이후만
+	};
+
+	struct ParsedJournal
+	{
+		bool valid = false;			// 헤더가 맞음
+		size_t validBytes = 0;		// 마지막 온전한 프레임 끝
+		std::vector<JournalStream> streams;
+		std::vector<std::string> paths;
+
+		int Entries() const
+		{
+			int count = 0;
+			for (const auto& stream : streams)
+				count += (int)stream.ops.size();
+			return count;
+		}
+	};
+
+	// 프레임 안의 항목 하나를 읽음 (정의는 표에 반영, 편집은 묶음별 목록에 추가)
+	bool ReadEntry(Reader& reader, ParsedJournal& parsed, std::unordered_map<uint32_t, int>& streamIndex,
+		std::vector<uint32_t>& pathIndex, std::unordered_map<std::string, uint32_t>& pathLookup)
+	{
+		uint8_t op = reader.Get<uint8_t>();
+		if (op == DEFINE_STREAM)
+		{
+			uint32_t id = reader.Get<uint32_t>();
+			std::string target = reader.GetBytes();
+			std::string source = reader.GetBytes();
+			uint64_t hash = reader.Get<uint64_t>();
+			if (!reader.ok)
+				return false;
+
+			auto it = std::find_if(parsed.streams.begin(), parsed.streams.end(), [&](const JournalStream& stream)
+				{
+					return stream.target == target && stream.source == source;
+				});
+			if (it == parsed.streams.end())
+			{
+				parsed.streams.push_back({ target, source, hash, {} });
+				it = parsed.streams.end() - 1;
+			}
+			it->hash = hash;
+			streamIndex[id] = (int)(it - parsed.streams.begin());
+			return true;
+		}
+		if (op == DEFINE_PATH)
+		{
+			uint32_t id = reader.Get<uint32_t>();
+			std::string path = reader.GetBytes();
+			if (!reader.ok)
+				return false;
+
+			auto [it, inserted] = pathLookup.emplace(path, (uint32_t)parsed.paths.size());
+			if (inserted)
+				parsed.paths.push_back(path);
+			if (id >= pathIndex.size())
+				pathIndex.resize((size_t)id + 1, UINT32_MAX);
+			pathIndex[id] = it->second;
+			return true;
+		}
+
+		auto found = streamIndex.find(reader.Get<uint32_t>());
+		if (!reader.ok || found == streamIndex.end())
+			return false;
+		JournalStream& stream = parsed.streams[found->second];
+
+		JournalOp entry;
+		entry.op = op;
+		switch (op)
+		{
+		case SET:
+		{
+			entry.record = reader.Get<uint32_t>();
+			entry.key = reader.GetBytes();
+			uint32_t id = reader.Get<uint32_t>();
+			if (!reader.ok || id >= pathIndex.size() || pathIndex[id] == UINT32_MAX)
+				return false;
+			entry.path = pathIndex[id];
+			entry.offset = reader.pos;
+			SkipValue(reader);
+			break;
+		}
+		case INSERT:
+		{
+			entry.offset = reader.pos;
+			uint32_t count = reader.Get<uint32_t>();
+			for (uint32_t i = 0; i < count && reader.ok; ++i)
+			{
+				reader.Skip(4);
+				SkipValue(reader);
+			}
+			break;
+		}
+		case REMOVE:
+		{
+			entry.offset = reader.pos;
+			uint32_t count = reader.Get<uint32_t>();
+			for (uint32_t i = 0; i < count && reader.ok; ++i)
+			{
+				reader.Skip(4);
+				reader.Skip(reader.Get<uint32_t>());
+			}
+			break;
+		}
+		case DROP:
+			stream.ops.clear();
+			return reader.ok;
+		default:
+			return false;
+		}
+
+		if (!reader.ok)
+			return false;
+		stream.ops.push_back(std::move(entry));
+		return true;
+	}
+
+	ParsedJournal Parse(const std::string& bytes)
+	{
+		ParsedJournal parsed;
+		if (bytes.size() < HEADER_BYTES || std::memcmp(bytes.data(), MAGIC, 4) != 0)
+			return parsed;
+
+		uint32_t version;
+		std::memcpy(&version, bytes.data() + 4, 4);
+		if (version != FORMAT_VERSION)
+			return parsed;
+
+		parsed.valid = true;
+		parsed.validBytes = HEADER_BYTES;
+
+		// 번호는 세션마다 다시 정의될 수 있으므로 나온 순서대로 덮어씀
+		std::unordered_map<uint32_t, int> streamIndex;
+		std::vector<uint32_t> pathIndex;
+		std::unordered_map<std::string, uint32_t> pathLookup;
+
+		Reader frames{ bytes.data(), bytes.size(), HEADER_BYTES };
+		while (frames.pos < bytes.size())
+		{
+			uint32_t length = frames.Get<uint32_t>();
+			uint32_t crc = frames.Get<uint32_t>();
+			if (!frames.Need(length) || Crc32(bytes.data() + frames.pos, length) != crc)
+				break;
+
+			// CRC 가 맞는 프레임 안에서 항목을 못 읽으면 형식이 다른 파일이므로 거기서 멈춤
+			Reader reader{ bytes.data(), frames.pos + length, frames.pos };
+			bool ok = true;
+			while (ok && reader.pos < reader.size)
+				ok = ReadEntry(reader, parsed, streamIndex, pathIndex, pathLookup);
+			if (!ok)
+				break;
+
+			frames.pos += length;
+			parsed.validBytes = frames.pos;
+		}
+
+		return parsed;
+	}
+
+	// 지운 레코드의 id (레코드 JSON 의 keyPath 위치, 없으면 빈 문자열)
+	std::string RecordKey(const json& record, const std::string& keyPath)
+	{
+		if (keyPath.empty())
+			return {};
+		json::json_pointer pointer(keyPath);
+		if (!record.contains(pointer) || !record.at(pointer).is_string())
+			return {};
+		return record.at(pointer).get<std::string>();
+	}
+
+	std::string ReadAll(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+			return {};
+		return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	std::string Header()
+	{
+		std::string header(MAGIC, 4);
+		Put<uint32_t>(header, FORMAT_VERSION);
+		return header;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// 열기 / 닫기
+// ---------------------------------------------------------------------------
+
+EditJournal::~EditJournal()
+{
+	Close();
+}
+
+std::string EditJournal::PathFor(const std::string& solutionPath)
+{
+	return (fs::path(solutionPath) / ".akdataeditor" / "edit_journal.bin").string();
+}
+
+bool EditJournal::Open(const std::string& path)
+{
+	Close();
+	_path = path;
+	_recoverable = 0;
+	_live.clear();
+
+	std::error_code ec;
+	fs::create_directories(fs::path(path).parent_path(), ec);
+
+	std::string bytes = ReadAll(path);
+	ParsedJournal parsed = Parse(bytes);
+
+	if (parsed.valid && parsed.Entries() > 0)
+	{
+		// 끝이 잘린 프레임은 잘라 내고 이어 씀
+		if (parsed.validBytes < bytes.size())
+			fs::resize_file(path, parsed.validBytes, ec);
+
+		for (const JournalStream& stream : parsed.streams)
+		{
+			if (!stream.ops.empty())
+				_live[{ stream.target, stream.source }] = (int)stream.ops.size();
+		}
+		_recoverable = parsed.Entries();
+
+		_file.open(path, std::ios::binary | std::ios::app);
+		_fileBytes = parsed.validBytes;
+		Reset();
+
+		std::cout << "[Journal] " << _recoverable << " unsaved edits found in " << path << "\n";
+	}
+	else
+	{
+		// 비었거나 모두 Drop 된 파일은 새로 시작
+		_file.open(path, std::ios::binary | std::ios::trunc);
+		_fileBytes = 0;
+		Reset();
+		if (_file.is_open())
+		{
+			std::string header = Header();
+			_file.write(header.data(), header.size());
+			_file.flush();
+			_fileBytes = header.size();
+		}
+	}
+
+	return _file.is_open();
+}
+
+void EditJournal::Close()
+{
+	if (!_file.is_open())
+		return;
+
+	Flush();
+	_file.close();
+}
+
+void EditJournal::Reset()
+{
+	_pending.clear();
+	_streamIds.clear();
+	_nextStreamId = 0;
+	_pathDefined.clear();
+}
+
+// ---------------------------------------------------------------------------
+// 쓰기
+// ---------------------------------------------------------------------------
+
+void EditJournal::MarkPending()
+{
+	if (_pending.empty())
+		_pendingSince = std::chrono::steady_clock::now();
+}
+
+uint32_t EditJournal::StreamId(const Stream& stream, uint64_t hash)
+{
+	auto it = _streamIds.find(stream);
+	if (it != _streamIds.end())
+		return it->second;
+
+	// 묶음의 첫 편집: 레코드를 읽어 온 파일의 해시를 같이 남김 (복구할 때 이 해시와 다르면 적용하지 않음)
+	uint32_t id = _nextStreamId++;
+	_streamIds.emplace(stream, id);
+
+	Put<uint8_t>(_pending, DEFINE_STREAM);
+	Put<uint32_t>(_pending, id);
+	PutBytes(_pending, stream.first);
+	PutBytes(_pending, stream.second);
+	Put<uint64_t>(_pending, hash);
+	return id;
+}
+
+void EditJournal::DefinePath(uint32_t path)
+{
+	if (path < _pathDefined.size() && _pathDefined[path])
+		return;
+
+	if (path >= _pathDefined.size())
+		_pathDefined.resize((size_t)path + 1, 0);
+	_pathDefined[path] = 1;
+
+	Put<uint8_t>(_pending, DEFINE_PATH);
+	Put<uint32_t>(_pending, path);
+	PutBytes(_pending, EditPath(path).to_string());
+}
+
+void EditJournal::BeginEntry(uint8_t op, const Stream& stream, uint64_t hash)
+{
+	MarkPending();
+	uint32_t id = StreamId(stream, hash);
+	Put<uint8_t>(_pending, op);
+	Put<uint32_t>(_pending, id);
+	++_live[stream];
+}
+
+void EditJournal::PutSet(const Stream& stream, uint64_t hash, int record, const std::string& key, uint32_t path, const json& value)
+{
+	MarkPending();
+	DefinePath(path);
+
+	BeginEntry(SET, stream, hash);
+	Put<uint32_t>(_pending, (uint32_t)record);
+	PutBytes(_pending, key);
+	Put<uint32_t>(_pending, path);
+	PutValue(_pending, value);
+}
+
+void EditJournal::PutInsert(const Stream& stream, uint64_t hash, const std::vector<int>& indices, const std::vector<json>& records)
+{
+	BeginEntry(INSERT, stream, hash);
+	size_t count = std::min(indices.size(), records.size());
+	Put<uint32_t>(_pending, (uint32_t)count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		Put<uint32_t>(_pending, (uint32_t)indices[i]);
+		PutValue(_pending, records[i]);
+	}
+}
+
+void EditJournal::PutRemove(const Stream& stream, uint64_t hash, const std::vector<int>& indices, const std::vector<std::string>& keys)
+{
+	BeginEntry(REMOVE, stream, hash);
+	Put<uint32_t>(_pending, (uint32_t)indices.size());
+	for (size_t i = 0; i < indices.size(); ++i)
+	{
+		Put<uint32_t>(_pending, (uint32_t)indices[i]);
+		PutBytes(_pending, i < keys.size() ? keys[i] : std::string());
+	}
+}
+
+void EditJournal::DropStream(const Stream& stream, uint64_t hash)
+{
+	if (!IsOpen() || _live.erase(stream) == 0)
+		return;		// 버릴 편집이 없음
+
+	MarkPending();
+	uint32_t id = StreamId(stream, hash);
+	Put<uint8_t>(_pending, DROP);
+	Put<uint32_t>(_pending, id);
+
+	// 다음 편집은 그때의 파일 해시로 다시 정의
+	_streamIds.erase(stream);
+}
+
+void EditJournal::WriteSet(const RecordEditTarget* target, int record, uint32_t path, const json& value)
+{
+	if (!IsOpen())
+		return;
+
+	Stream stream(target->EditTargetName(), target->EditRecordSource(record));
+	PutSet(stream, target->EditSourceHash(stream.second), record, target->EditRecordKey(record), path, value);
+}
+
+// 구조 변경은 레코드가 모두 한 파일에 있는 대상만 기록하므로 파일 이름이 빈 묶음
+void EditJournal::WriteInsert(const RecordEditTarget* target, const std::vector<int>& indices, const std::vector<json>& records)
+{
+	if (!IsOpen())
+		return;
+
+	PutInsert(Stream(target->EditTargetName(), ""), target->EditSourceHash(""), indices, records);
+}
+
+void EditJournal::WriteRemove(const RecordEditTarget* target, const std::vector<int>& indices, const std::vector<json>& records)
+{
+	if (!IsOpen())
+		return;
+
+	// 이미 지워진 뒤이므로 id 는 지운 레코드에서 읽음
+	std::string keyPath = target->EditRecordKeyPath();
+	std::vector<std::string> keys(indices.size());
+	for (size_t i = 0; i < keys.size() && i < records.size(); ++i)
+		keys[i] = RecordKey(records[i], keyPath);
+
+	PutRemove(Stream(target->EditTargetName(), ""), target->EditSourceHash(""), indices, keys);
+}
+
+void EditJournal::WriteDrop(const RecordEditTarget* target)
+{
+	std::string name = target->EditTargetName();
+	std::vector<std::string> sources;
+	for (auto it = _live.lower_bound(Stream(name, "")); it != _live.end() && it->first.first == name; ++it)
+		sources.push_back(it->first.second);
+
+	for (const std::string& source : sources)
+		DropStream(Stream(name, source), target->EditSourceHash(source));
+}
+
+void EditJournal::WriteDrop(const RecordEditTarget* target, const std::string& source)
+{
+	DropStream(Stream(target->EditTargetName(), source), target->EditSourceHash(source));
+}
+
+void EditJournal::Tick()
+{
+	if (_pending.empty())
+		return;
+
+	if (_pending.size() >= FLUSH_BYTES || std::chrono::steady_clock::now() - _pendingSince >= FLUSH_INTERVAL)
+		Flush();
+}
+
+void EditJournal::Flush()
+{
+	if (_pending.empty() || !IsOpen())
+		return;
+
+	std::string frame;
+	frame.reserve(8 + _pending.size());
+	Put<uint32_t>(frame, (uint32_t)_pending.size());
+	Put<uint32_t>(frame, Crc32(_pending.data(), _pending.size()));
+	frame += _pending;
+
+	_file.write(frame.data(), frame.size());
+	_file.flush();
+	_fileBytes += frame.size();
+	_pending.clear();
+}
+
+// ---------------------------------------------------------------------------
+// 압축 / 복구
+// ---------------------------------------------------------------------------
+
+void EditJournal::Compact(const RecordEditTarget* saved)
+{
+	if (!IsOpen())
+		return;
+
+	WriteDrop(saved);
+
+	if (_live.empty())
+	{
+		Discard();
+		return;
+	}
+
+	// 다른 대상의 편집이 남아 있으면 남은 것만 새 파일로 옮겨 씀
+	Flush();
+	_file.close();
+	std::string bytes = ReadAll(_path);
+	if (!Rewrite(bytes))
+		_file.open(_path, std::ios::binary | std::ios::app);
+}
+
+bool EditJournal::Rewrite(const std::string& bytes)
+{
+	ParsedJournal parsed = Parse(bytes);
+	if (!parsed.valid)
+		return false;
+
+	std::string tempPath = _path + ".tmp";
+	_file.open(tempPath, std::ios::binary | std::ios::trunc);
+	if (!_file.is_open())
+		return false;
+
+	std::string header = Header();
+	_file.write(header.data(), header.size());
+	_fileBytes = header.size();
+	Reset();
+	_live.clear();
+
+	// 파일 해시는 처음 기록한 값 그대로 옮김
+	for (const JournalStream& stream : parsed.streams)
+	{
+		Stream id(stream.target, stream.source);
+		for (const JournalOp& entry : stream.ops)
+		{
+			Reader reader{ bytes.data(), bytes.size(), entry.offset };
+			if (entry.op == SET)
+			{
+				PutSet(id, stream.hash, (int)entry.record, entry.key, InternEditPath(parsed.paths[entry.path]), GetValue(reader));
+			}
+			else if (entry.op == INSERT)
+			{
+				uint32_t count = reader.Get<uint32_t>();
+				std::vector<int> indices;
+				std::vector<json> records;
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					indices.push_back((int)reader.Get<uint32_t>());
+					records.push_back(GetValue(reader));
+				}
+				PutInsert(id, stream.hash, indices, records);
+			}
+			else if (entry.op == REMOVE)
+			{
+				uint32_t count = reader.Get<uint32_t>();
+				std::vector<int> indices(count);
+				std::vector<std::string> keys(count);
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					indices[i] = (int)reader.Get<uint32_t>();
+					keys[i] = reader.GetBytes();
+				}
+				PutRemove(id, stream.hash, indices, keys);
+			}
+		}
+		Flush();
+	}
+
+	Flush();
+	_file.close();
+	Reset();		// 옮기면서 정의한 번호는 버림 (다음 쓰기에서 다시 정의)
+
+	std::error_code ec;
+	fs::rename(tempPath, _path, ec);
+	if (ec)
+		return false;
+
+	_file.open(_path, std::ios::binary | std::ios::app);
+	return _file.is_open();
+}
+
+void EditJournal::Discard()
+{
+	if (_path.empty())
+		return;
+
+	_recoverable = 0;
+	_live.clear();
+	Reset();
+
+	_file.close();
+	_file.open(_path, std::ios::binary | std::ios::trunc);
+	if (!_file.is_open())
+		return;
+
+	std::string header = Header();
+	_file.write(header.data(), header.size());
+	_file.flush();
+	_fileBytes = header.size();
+}
+
+JournalReplayReport EditJournal::Replay(const std::vector<RecordEditTarget*>& targets)
+{
+	auto start = std::chrono::steady_clock::now();
+	JournalReplayReport report;
+
+	Flush();
+	std::string bytes = ReadAll(_path);
+	ParsedJournal parsed = Parse(bytes);
+	report.entries = parsed.Entries();
+
+	std::vector<const json::json_pointer*> pointers(parsed.paths.size(), nullptr);
+	std::vector<std::pair<Stream, uint64_t>> staleStreams;
+
+	for (const JournalStream& stream : parsed.streams)
+	{
+		const std::vector<JournalOp>& ops = stream.ops;
+		if (ops.empty())
+			continue;
+
+		auto found = std::find_if(targets.begin(), targets.end(), [&](const RecordEditTarget* target)
+			{
+				return target && stream.target == target->EditTargetName();
+			});
+		if (found == targets.end())
+		{
+			report.skipped += (int)ops.size();
+			continue;
+		}
+		RecordEditTarget* target = *found;
+
+		// 저널을 쓴 뒤 파일이 바뀌었으면 (다른 곳에서 고침, 체크아웃) 위치도 값도 맞지 않으므로 그 파일의 편집은 버림
+		uint64_t hash = target->EditSourceHash(stream.source);
+		if (hash != stream.hash)
+		{
+			report.stale += (int)ops.size();
+			report.staleFiles.push_back(stream.source.empty() ? stream.target : stream.target + " " + stream.source);
+			staleStreams.emplace_back(Stream(stream.target, stream.source), hash);
+			continue;
+		}
+
+		// id 가 있으면 그 위치의 레코드 id 가 같을 때만 위치를 믿고, 다르면 id 로 다시 찾음
+		auto findRecord = [&](int record, const std::string& key)
+			{
+				int count = target->EditRecordCount();
+				if (key.empty() || (record < count && target->EditRecordKey(record) == key))
+					return record < count ? record : -1;
+				for (int i = 0; i < count; ++i)
+				{
+					if (target->EditRecordKey(i) == key)
+						return i;
+				}
+				return -1;
+			};
+		std::string keyPath = target->EditRecordKeyPath();
+
+		auto applySet = [&](const JournalOp& entry)
+			{
+				// id 를 바꾼 편집은 저널에 바뀐 뒤의 id 가 있으므로 위치를 믿음
+				int record = (!keyPath.empty() && parsed.paths[entry.path] == keyPath && (int)entry.record < target->EditRecordCount())
+					? (int)entry.record : findRecord((int)entry.record, entry.key);
+				if (record < 0)
+				{
+					++report.skipped;
+					return;
+				}
+				if (!pointers[entry.path])
+					pointers[entry.path] = &EditPath(InternEditPath(parsed.paths[entry.path]));
+
+				try
+				{
+					Reader reader{ bytes.data(), bytes.size(), entry.offset };
+					target->SetRecordValue(record, *pointers[entry.path], GetValue(reader));
+					++report.applied;
+				}
+				catch (const json::exception&)
+				{
+					++report.skipped;
+				}
+			};
+
+		// 구조 변경 사이의 값 변경은 (레코드, 경로) 마다 마지막 값만 적용
+		// 같은 경로를 나중에 다시 쓰면 그 사이의 하위 경로 변경도 덮이므로 마지막 쓰기 순서대로 적용하면 결과가 같음
+		std::vector<size_t> run;
+		std::unordered_set<uint64_t> seen;
+		auto flushRun = [&]()
+			{
+				seen.clear();
+				std::vector<size_t> kept;
+				for (size_t i = run.size(); i-- > 0;)
+				{
+					const JournalOp& entry = ops[run[i]];
+					if (seen.insert(((uint64_t)entry.record << 32) | entry.path).second)
+						kept.push_back(run[i]);
+				}
+				for (size_t i = kept.size(); i-- > 0;)
+					applySet(ops[kept[i]]);
+				run.clear();
+			};
+
+		for (size_t i = 0; i < ops.size(); ++i)
+		{
+			const JournalOp& entry = ops[i];
+			if (entry.op == SET)
+			{
+				run.push_back(i);
+				continue;
+			}
+			flushRun();
+
+			Reader reader{ bytes.data(), bytes.size(), entry.offset };
+			uint32_t count = reader.Get<uint32_t>();
+			int recordCount = target->EditRecordCount();
+			std::vector<int> indices;
+			std::vector<json> records;
+			bool valid = true;
+
+			for (uint32_t k = 0; k < count && valid; ++k)
+			{
+				int index = (int)reader.Get<uint32_t>();
+				if (entry.op == INSERT)
+				{
+					// 오름차순이고 삽입 후 범위 안이어야 함
+					valid = index >= 0 && index <= recordCount + (int)k && (indices.empty() || index > indices.back());
+					records.push_back(GetValue(reader));
+				}
+				else
+				{
+					// 지울 레코드가 옮겨졌으면 id 로 찾음
+					index = findRecord(index, reader.GetBytes());
+					valid = index >= 0;
+				}
+				indices.push_back(index);
+			}
+
+			if (entry.op == REMOVE)
+			{
+				std::sort(indices.begin(), indices.end());
+				valid = valid && std::adjacent_find(indices.begin(), indices.end()) == indices.end();
+			}
+
+			if (!valid || !reader.ok)
+			{
+				++report.skipped;
+				continue;
+			}
+
+			if (entry.op == INSERT)
+				target->InsertRecords(indices, records);
+			else
+				target->RemoveRecords(indices);
+			++report.applied;
+		}
+		flushRun();
+	}
+
+	// 적용하지 않은 파일의 편집은 저널에서도 버림 (이후 편집은 지금 파일 해시로 새로 기록)
+	for (const auto& [stream, hash] : staleStreams)
+		DropStream(stream, hash);
+
+	_recoverable = 0;
+	report.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "[Journal] Replayed " << report.applied << " edits (" << report.entries << " journaled, "
+		<< report.skipped << " skipped, " << report.stale << " stale) in " << report.ms << " ms\n";
+	return report;
+}
@@ -0,0 +1,95 @@
+﻿#pragma once
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "EditHistory.h"
+
+// 복구 결과
+struct JournalReplayReport
+{
+	int entries = 0;		// 파일에 남아 있던 편집 수
+	int applied = 0;		// 같은 경로를 다시 쓴 편집을 합친 뒤 실제로 적용한 수
+	int skipped = 0;		// 대상이 없거나 레코드를 찾지 못해 버린 수
+	int stale = 0;			// 저널을 쓴 뒤 디스크 파일이 바뀌어 적용하지 않은 수
+	std::vector<std::string> staleFiles;	// 그 파일 ("대상" 또는 "대상 파일 이름")
+	double ms = 0.0;
+};
+
+// 저장하지 않은 편집을 덧붙이기만 하는 바이너리 파일 (비정상 종료 후 복구용)
+// 편집은 메모리에 모았다가 Tick 에서 프레임 하나로 한 번에 씀 (프레임마다 길이 + CRC32, 끝이 잘린 프레임은 읽을 때 버림)
+// 편집은 (대상, 레코드를 읽어 온 파일) 별로 모으고, 처음 쓸 때 그 파일의 내용 해시를 같이 기록
+// 레코드는 인덱스 + id 로, 필드는 경로 번호로 기록 (경로 문자열은 파일에 처음 나올 때 한 번만)
+class EditJournal
+{
+public:
+	~EditJournal();
+
+	// <솔루션>/.akdataeditor/edit_journal.bin
+	static std::string PathFor(const std::string& solutionPath);
+
+	// 기존 파일을 검사하고 이어 쓰기 위해 엶 (끝이 깨진 프레임은 잘라 냄)
+	bool Open(const std::string& path);
+	void Close();
+	bool IsOpen() const { return _file.is_open(); }
+
+	// Open 때 파일에 남아 있던 (이전 세션의) 편집 수, Replay / Discard 전까지 유지
+	int RecoverableCount() const { return _recoverable; }
+
+	void WriteSet(const RecordEditTarget* target, int record, uint32_t path, const json& value);
+	void WriteInsert(const RecordEditTarget* target, const std::vector<int>& indices, const std::vector<json>& records);
+	void WriteRemove(const RecordEditTarget* target, const std::vector<int>& indices, const std::vector<json>& records);
+	void WriteDrop(const RecordEditTarget* target);		// 대상의 이전 편집은 모두 무효 (다시 읽음, 저장함)
+	void WriteDrop(const RecordEditTarget* target, const std::string& source);	// 그 파일의 편집만 무효 (레벨 삭제)
+
+	// 묶음 쓰기: 첫 편집 후 일정 시간이 지났거나 쌓인 양이 크면 한 프레임으로 씀
+	void Tick();
+	void Flush();
+
+	// 대상이 저장됨: 그 대상의 편집을 버리고, 남은 편집이 없으면 파일을 비우고 있으면 남은 것만 다시 씀
+	void Compact(const RecordEditTarget* saved);
+
+	// 남은 편집을 대상 이름으로 찾아 순서대로 적용 (구조 변경 사이에서 같은 경로를 다시 쓴 값은 마지막 것만)
+	// 파일 해시가 저널과 다르면 그 파일의 편집은 건너뛰고 저널에서도 버림, 레코드는 id 로 다시 찾음
+	JournalReplayReport Replay(const std::vector<RecordEditTarget*>& targets);
+	void Discard();
+
+	size_t PendingBytes() const { return _pending.size(); }
+	uint64_t FileBytes() const { return _fileBytes; }
+
+private:
+	std::string _path;
+	std::ofstream _file;
+	uint64_t _fileBytes = 0;
+	int _recoverable = 0;
+
+	// 묶음 쓰기 버퍼
+	std::string _pending;
+	std::chrono::steady_clock::time_point _pendingSince;
+
+	// (대상 이름, 파일) 하나가 편집 묶음 하나
+	using Stream = std::pair<std::string, std::string>;
+
+	// 이 파일에 정의한 묶음 / 경로 번호
+	std::map<Stream, uint32_t> _streamIds;
+	uint32_t _nextStreamId = 0;
+	std::vector<uint8_t> _pathDefined;		// InternEditPath 번호별
+
+	// 묶음별 마지막 Drop 이후 편집 수 (Drop 하면 빠지고, 비면 압축 때 파일을 비움)
+	std::map<Stream, int> _live;
+
+	void MarkPending();
+	uint32_t StreamId(const Stream& stream, uint64_t hash);
+	void DefinePath(uint32_t path);
+	void BeginEntry(uint8_t op, const Stream& stream, uint64_t hash);
+	void DropStream(const Stream& stream, uint64_t hash);
+	void PutSet(const Stream& stream, uint64_t hash, int record, const std::string& key, uint32_t path, const json& value);
+	void PutInsert(const Stream& stream, uint64_t hash, const std::vector<int>& indices, const std::vector<json>& records);
+	void PutRemove(const Stream& stream, uint64_t hash, const std::vector<int>& indices, const std::vector<std::string>& keys);
+	void Reset();
+	bool Rewrite(const std::string& bytes);
+};
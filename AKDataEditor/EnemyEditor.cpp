@@ -1,13 +1,18 @@
 ﻿#include "EnemyEditor.h"
 #include "Migration.h"
+#include "DataFiles.h"
+#include <algorithm>
+#include <unordered_set>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <chrono>
 #include <imgui/imgui.h>
 #include <imgui/imgui_impl_win32.h>
 #include <imgui/imgui_impl_gdi.h>
 
 #include "Utility.h"
+#include "Parallel.h"
 
 namespace fs = std::filesystem;
 
@@ -19,8 +24,10 @@ EnemyEditor::EnemyEditor(const std::string& jsonPath)
 
 EnemyEditor::~EnemyEditor() {}
 
-void EnemyEditor::RenderGUI(bool* p_open)
+void EnemyEditor::RenderGUI(bool* p_open, const EnemyUsageIndex* usage)
 {
+	_usage = usage;
+
 	ImGui::Begin("적 편집기", p_open);
 
 	RenderToolbar();
@@ -39,48 +46,412 @@ void EnemyEditor::RenderGUI(bool* p_open)
 
 void EnemyEditor::LoadEnemies()
 {
-	std::ifstream file(_jsonPath);
-	if (file.is_open())
+	_revision = NextDataRevision();
+
+	// 마이그레이션 저장은 해시와 관계없이 써야 하므로 저장된 상태를 모름으로 둠
+	_contentHashes.Clear();
+	_contentHashesDirty = true;
+
+	// 읽기 + 버전 체크 및 마이그레이션 (명령줄 도구와 같은 경로)
+	std::string error;
+	DataFileStatus status = ReadDataFile(Migration::DataType::Enemy, _jsonPath, _enemyData, error);
+	if (status == DataFileStatus::Missing)
 	{
-		try
-		{
-			file >> _enemyData;
-			std::cout << "[Enemy] Loaded " << _jsonPath << '\n';
+		std::cout << "[Enemy] File not found, creating new: " << _jsonPath << "\n";
+		_enemyData = { {"version", VERSION}, {"enemies", json::array()} };
+	}
+	else if (status == DataFileStatus::ParseError)
+	{
+		std::cout << "[Enemy] JSON parse error: " << error << '\n';
+		_enemyData = { {"version", VERSION}, {"enemies", json::array()} };
+	}
+	else
+	{
+		std::cout << "[Enemy] Loaded " << _jsonPath << '\n';
+		if (status == DataFileStatus::Migrated)
+			SaveEnemies();
+	}
 
-			// 버전 체크 및 마이그레이션
-			if (Migration::CheckAndMigrate(Migration::DataType::Enemy, _enemyData))
-			{
-				SaveEnemies();
-			}
-		}
-		catch (json::exception& e)
+	_variants.Build(_enemyData["enemies"]);
+	_outliersDirty = true;
+	_statsDirty = true;
+	_selection.Clear();
+	_lastBulkEdit = BulkEditResult();
+
+	_pristine.Reset(_enemyData["enemies"]);
+	_fileStamps = { FileStamp::Of(_jsonPath) };
+	RefreshContentHashes();
+	_contentHashes.MarkSaved();
+
+	// 파일에서 다시 읽으면 이전 편집 기록은 맞지 않음
+	_undoTracker.Invalidate();
+	if (_history)
+		_history->Forget(this);
+}
+
+void EnemyEditor::DiscardChanges()
+{
+	json& enemies = _enemyData["enemies"];
+	std::vector<int> restored;
+
+	if (_pristine.Restore(enemies, restored))
+	{
+		// 바꾼 적만 다시 해석
+		for (int index : restored)
 		{
-			std::cout << "[Enemy] JSON parse error: " << e.what() << '\n';
-			_enemyData = { {"version", VERSION}, {"enemies", json::array()} };
+			_variants.UpdateEnemy(index, enemies[index]);
+			if (!_outliersDirty)
+				_outliers.Update(index, MakeEnemySample(_variants.Get(index, 0)));
+			if (!_statsDirty)
+				_stats.Set(index, EnemyStatValues(_variants.Get(index, 0)));
+			if (!_contentHashesDirty)
+				_contentHashes.Set(index, enemies[index].value("key", ""), HashJson(enemies[index]));
 		}
 	}
 	else
 	{
-		std::cout << "[Enemy] File not found, creating new: " << _jsonPath << "\n";
-		_enemyData = { {"version", VERSION}, {"enemies", json::array()} };
+		_variants.Build(enemies);
+		_outliersDirty = true;
+		_statsDirty = true;
+		_contentHashesDirty = true;
+		_selection.Clear();
+	}
+
+	_revision = NextDataRevision();
+	_hasUnsavedChanges = false;
+	_lastBulkEdit = BulkEditResult();
+
+	_undoTracker.Invalidate();
+	if (_history)
+		_history->Forget(this);
+
+	std::cout << "[Enemy] Changes discarded (" << (restored.empty() ? "all" : std::to_string(restored.size())) << " records)\n";
+}
+
+void EnemyEditor::RefreshFromDisk()
+{
+	if (FilesUnchanged(_fileStamps))
+		DiscardChanges();
+	else
+		LoadEnemies();
+}
+
+void EnemyEditor::MarkModified()
+{
+	_hasUnsavedChanges = true;
+	_revision = NextDataRevision();
+	_pristine.MarkAll();
+	_variants.Build(_enemyData["enemies"]);
+	_outliersDirty = true;
+	_statsDirty = true;
+	_contentHashesDirty = true;
+}
+
+void EnemyEditor::MarkEnemyModified(int index)
+{
+	_hasUnsavedChanges = true;
+	uint64_t previousRevision = _revision;
+	_revision = NextDataRevision();
+	_changeLog.Add(previousRevision, _revision, index);
+	_pristine.MarkRecord(index);
+	_variants.UpdateEnemy(index, _enemyData["enemies"][index]);
+	if (!_outliersDirty)
+		_outliers.Update(index, MakeEnemySample(_variants.Get(index, 0)));
+	if (!_statsDirty)
+		_stats.Set(index, EnemyStatValues(_variants.Get(index, 0)));
+	if (!_contentHashesDirty)
+		_contentHashes.Set(index, _enemyData["enemies"][index].value("key", ""), HashJson(_enemyData["enemies"][index]));
+
+	_undoTracker.Commit(_history, this, index, _enemyData["enemies"][index], _revision);
+}
+
+void EnemyEditor::RefreshContentHashes()
+{
+	if (!_contentHashesDirty)
+		return;
+
+	const json& enemies = _enemyData["enemies"];
+	std::vector<std::string> keys(enemies.size());
+	std::vector<uint64_t> hashes(enemies.size());
+	ParallelFor(enemies.size(), 256, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				keys[i] = enemies[i].value("key", "");
+				hashes[i] = HashJson(enemies[i]);
+			}
+		});
+
+	_contentHashes.Build(std::move(keys), std::move(hashes));
+	_contentHashesDirty = false;
+}
+
+bool EnemyEditor::HasUnsavedChanges()
+{
+	if (!_hasUnsavedChanges)
+		return false;
+
+	RefreshContentHashes();
+	return _contentHashes.IsDirty();
+}
+
+const RecordChangeSummary& EnemyEditor::GetChangeSummary()
+{
+	if (_changeSummaryRevision != _revision)
+	{
+		RefreshContentHashes();
+		_changeSummary = _contentHashes.Diff();
+		_changeSummaryRevision = _revision;
 	}
+	return _changeSummary;
+}
+
+const OutlierDetector& EnemyEditor::GetOutliers()
+{
+	if (_outliersDirty)
+		RebuildOutliers();
+	return _outliers;
+}
+
+const RecordStatTable& EnemyEditor::GetStats()
+{
+	if (_statsDirty)
+	{
+		std::vector<std::vector<double>> rows(_variants.EnemyCount());
+		for (int i = 0; i < (int)rows.size(); ++i)
+			rows[i] = EnemyStatValues(_variants.Get(i, 0));
+
+		_stats.Build(rows);
+		_statsDirty = false;
+	}
+	return _stats;
+}
+
+bool EnemyEditor::ApplyBulkEdit(BulkEditResult edit)
+{
+	json& enemies = _enemyData["enemies"];
+	if (!edit.ok || !edit.Matches(enemies, false))
+		return false;
+
+	edit.Apply(enemies);
+	MarkModified();
+	if (_history)
+		_history->Push(MakeBulkEditCommand(this, edit, false, "적 일괄 편집"));
+	_lastBulkEdit = std::move(edit);
+	std::cout << "[Enemy] Bulk edit applied: " << _lastBulkEdit.changes.size() << " values\n";
+	return true;
+}
+
+bool EnemyEditor::UndoBulkEdit()
+{
+	json& enemies = _enemyData["enemies"];
+	bool ok = _lastBulkEdit.ok && _lastBulkEdit.Matches(enemies, true);
+	if (ok)
+	{
+		_lastBulkEdit.Revert(enemies);
+		MarkModified();
+		if (_history)
+			_history->Push(MakeBulkEditCommand(this, _lastBulkEdit, true, "적 일괄 편집 되돌리기"));
+		std::cout << "[Enemy] Bulk edit reverted\n";
+	}
+
+	// 이후에 같은 칸을 다시 고쳤으면 되돌릴 수 없음
+	_lastBulkEdit = BulkEditResult();
+	return ok;
+}
+
+std::string EnemyEditor::EditRecordLabel(int record) const
+{
+	const json& enemies = _enemyData["enemies"];
+	return (record >= 0 && record < (int)enemies.size()) ? enemies[record].value("key", "") : "#" + std::to_string(record);
+}
+
+std::string EnemyEditor::EditRecordKey(int record) const
+{
+	const json& enemies = _enemyData["enemies"];
+	return (record >= 0 && record < (int)enemies.size()) ? enemies[record].value("key", "") : std::string();
+}
+
+uint64_t EnemyEditor::EditSourceHash(const std::string& /*source*/) const
+{
+	return _fileStamps.empty() ? 0 : _fileStamps[0].hash;
+}
+
+void EnemyEditor::SetRecordValue(int record, const json::json_pointer& pointer, const json& value)
+{
+	json& enemies = _enemyData["enemies"];
+	if (record < 0 || record >= (int)enemies.size())
+		return;
+
+	SetJsonValue(enemies[record], pointer, value);
+	MarkEnemyModified(record);
+}
+
+void EnemyEditor::InsertRecords(const std::vector<int>& indices, const std::vector<json>& records)
+{
+	json::array_t& enemies = _enemyData["enemies"].get_ref<json::array_t&>();
+
+	std::vector<int> remap = InsertAt(enemies, indices, json::array_t(records.begin(), records.end()));
+	_variants.InsertEnemies(indices, _enemyData["enemies"]);
+
+	_selectedEnemyIndex = RemapIndex(remap, _selectedEnemyIndex);
+	_deleteTargetIndex = -1;
+	_selection.Remap(remap, enemies.size());
+	_lastBulkEdit = BulkEditResult();
+
+	_hasUnsavedChanges = true;
+	_revision = NextDataRevision();
+	_outliersDirty = true;
+	_statsDirty = true;
+	_contentHashesDirty = true;
+	_pristine.MarkAll();
+}
+
+void EnemyEditor::RemoveRecords(const std::vector<int>& indices)
+{
+	std::vector<uint8_t> remove(_enemyData["enemies"].size(), 0);
+	for (int index : indices)
+	{
+		if (index >= 0 && index < (int)remove.size())
+			remove[index] = 1;
+	}
+	DeleteEnemies(remove);
+}
+
+void EnemyEditor::RebuildOutliers()
+{
+	std::vector<OutlierSample> samples(_variants.EnemyCount());
+	for (int i = 0; i < (int)samples.size(); ++i)
+		samples[i] = MakeEnemySample(_variants.Get(i, 0));
+
+	_outliers.Build(samples);
+	_outliersDirty = false;
+}
+
+void EnemyEditor::DeleteEnemies(const std::vector<uint8_t>& remove)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	json::array_t& enemies = _enemyData["enemies"].get_ref<json::array_t&>();
+	size_t before = enemies.size();
+
+	// 지울 적만 떼어 실행 취소 기록으로 넘김 (되돌리면 같은 위치에 다시 끼움)
+	std::vector<int> indices;
+	std::vector<json> removed;
+	for (size_t i = 0; i < enemies.size() && i < remove.size(); ++i)
+	{
+		if (!remove[i])
+			continue;
+		indices.push_back((int)i);
+		removed.push_back(std::move(enemies[i]));
+	}
+
+	// JSON 배열과 해석된 스탯을 같은 플래그로 한 번씩만 압축
+	std::vector<int> remap = CompactRemove(enemies, remove);
+	_variants.RemoveEnemies(remove);
+
+	_selectedEnemyIndex = RemapIndex(remap, _selectedEnemyIndex);
+	if (_selectedEnemyIndex < 0)
+		_showEditWindow = false;
+	_deleteTargetIndex = -1;
+	_selection.Remap(remap, enemies.size());
+	_lastBulkEdit = BulkEditResult();
+
+	_hasUnsavedChanges = true;
+	_revision = NextDataRevision();
+	_outliersDirty = true;
+	_statsDirty = true;
+	_contentHashesDirty = true;
+	_pristine.MarkAll();
+
+	if (_history)
+	{
+		std::string label = "적 " + std::to_string(indices.size()) + "개 삭제";
+		_history->Push(std::make_unique<RecordStructureCommand>(this, false, std::move(indices), std::move(removed), label));
+	}
+
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "[Enemy] Deleted " << (before - enemies.size()) << " enemies (" << ms << " ms)\n";
+}
+
+void EnemyEditor::DuplicateSelected()
+{
+	json::array_t& enemies = _enemyData["enemies"].get_ref<json::array_t&>();
+
+	std::unordered_set<std::string> usedKeys;
+	for (const auto& enemy : enemies)
+		usedKeys.insert(enemy.value("key", ""));
+
+	std::vector<int> remap = ::DuplicateSelected(enemies, _selection.Flags(), [&](const json& enemy)
+		{
+			json copy = enemy;
+			copy["key"] = MakeUniqueKey(enemy.value("key", "enemy"), usedKeys);
+			return copy;
+		});
+
+	// 새로 만든 복제본을 선택
+	std::vector<uint8_t> copies(enemies.size(), 0);
+	for (int index : _selection.Indices())
+		copies[remap[index] + 1] = 1;
+
+	int duplicated = _selection.Count();
+	_selection.Resize(enemies.size());
+	_selection.Clear();
+	for (size_t i = 0; i < copies.size(); ++i)
+		_selection.Set((int)i, copies[i]);
+
+	_selectedEnemyIndex = RemapIndex(remap, _selectedEnemyIndex);
+	_deleteTargetIndex = -1;
+	_lastBulkEdit = BulkEditResult();
+	MarkModified();
+
+	if (_history)
+	{
+		std::vector<int> indices;
+		std::vector<json> inserted;
+		for (size_t i = 0; i < copies.size(); ++i)
+		{
+			if (!copies[i])
+				continue;
+			indices.push_back((int)i);
+			inserted.push_back(enemies[i]);
+		}
+		_history->Push(std::make_unique<RecordStructureCommand>(this, true, std::move(indices), std::move(inserted), "적 " + std::to_string(duplicated) + "개 복제"));
+	}
+
+	std::cout << "[Enemy] Duplicated " << duplicated << " enemies\n";
 }
 
 
 void EnemyEditor::SaveEnemies()
 {
-	fs::path filePath(_jsonPath);
-	fs::create_directories(filePath.parent_path());
+	// 내용이 저장된 해시와 같고 파일도 그대로면 다시 쓰지 않음
+	RefreshContentHashes();
+	if (!_contentHashes.IsDirty() && FilesUnchanged(_fileStamps))
+	{
+		if (_history)
+			_history->MarkSaved(this);
+		_pristine.Commit(_enemyData["enemies"]);
+		std::cout << "[Enemy] Unchanged, save skipped\n";
+		return;
+	}
 
 	json output;
 	output["version"] = VERSION;  // 항상 현재 버전으로 저장
 	output["enemies"] = _enemyData["enemies"];
 
-	std::ofstream file(_jsonPath);
-	if (file.is_open())
+	// 파일을 닫은 뒤에 저널을 비움 (그 전에 죽으면 저널로 복구)
+	if (WriteDataFile(Migration::DataType::Enemy, _jsonPath, std::move(output)))
 	{
-		file << output.dump(2);
 		std::cout << "[Enemy] Saved to " << _jsonPath << "\n";
+
+		if (_history)
+			_history->MarkSaved(this);
+
+		_pristine.Commit(_enemyData["enemies"]);
+		_fileStamps = { FileStamp::Of(_jsonPath) };
+		_contentHashes.MarkSaved();
+		_changeSummaryRevision = 0;
 	}
 	else
 	{
@@ -91,12 +462,14 @@ void EnemyEditor::SaveEnemies()
 void EnemyEditor::RenderToolbar()
 {
 	// 저장 상태 표시
-	if (_hasUnsavedChanges)
+	if (HasUnsavedChanges())
 	{
 		// 노란색 경고 아이콘 + 텍스트
 		ImGui::PushStyleColor(ImGuiCol_Text, COLOR_YELLOW);
 		ImGui::Text("* 저장되지 않은 변경사항");
 		ImGui::PopStyleColor();
+		if (ImGui::IsItemHovered())
+			RenderChangeSummaryTooltip(GetChangeSummary());
 
 		ImGui::SameLine();
 
@@ -113,7 +486,7 @@ void EnemyEditor::RenderToolbar()
 		// Discard 버튼 (변경사항 취소)
 		if (ImGui::Button("되돌리기"))
 		{
-			LoadEnemies();  // 파일에서 다시 로드
+			DiscardChanges();  // 저장된 상태 사본에서 복사
 			_hasUnsavedChanges = false;
 			std::cout << "[Enemy] Changes discarded.\n";
 		}
@@ -153,7 +526,7 @@ void EnemyEditor::RenderToolbar()
 	// Refresh 버튼
 	if (ImGui::Button("새로고침"))
 	{
-		LoadEnemies();
+		RefreshFromDisk();
 		_hasUnsavedChanges = false;
 	}
 }
@@ -166,14 +539,36 @@ void EnemyEditor::RenderEnemyList()
 		return;
 	}
 
+	auto& enemies = _enemyData["enemies"];
+	_selection.Resize(enemies.size());
+
+	switch (RenderBatchToolbar(_selection, true))
+	{
+	case BatchAction::Delete:
+		_showBatchDeleteConfirm = true;
+		break;
+	case BatchAction::Duplicate:
+		DuplicateSelected();
+		break;
+	case BatchAction::SetField:
+		_fieldSetPopup.Open();
+		break;
+	default:
+		break;
+	}
+
+	RenderBatchPopups();
+
 	// 테이블 플래그
 	ImGuiTableFlags flags = ImGuiTableFlags_Borders |
 		ImGuiTableFlags_RowBg |
 		ImGuiTableFlags_Resizable |
 		ImGuiTableFlags_ScrollY;
 
-	if (ImGui::BeginTable("EnemyTable", 6, flags))
+	if (ImGui::BeginTable("EnemyTable", 7, flags))
 	{
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("##Select", ImGuiTableColumnFlags_WidthFixed, 24.0f);
 		ImGui::TableSetupColumn("Key", ImGuiTableColumnFlags_WidthFixed, 150.0f);
 		ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthFixed, 150.0f);
 		ImGui::TableSetupColumn("HP", ImGuiTableColumnFlags_WidthFixed, 60.0f);
@@ -182,79 +577,88 @@ void EnemyEditor::RenderEnemyList()
 		ImGui::TableSetupColumn("Actions", ImGuiTableColumnFlags_WidthFixed, 120.0f);
 		ImGui::TableHeadersRow();
 
-		int index = 0;
-		for (const auto& enemy : _enemyData["enemies"])
+		// 보이는 행만 그림 (수만 개 목록에서도 프레임 유지)
+		ImGuiListClipper clipper;
+		clipper.Begin((int)enemies.size());
+		while (clipper.Step())
 		{
-			ImGui::TableNextRow();
-
-			ImU32 bg = (index % 2 == 0)
-				? IM_COL32(25, 25, 25, 255)
-				: IM_COL32(40, 40, 40, 255);
-
-			ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg0, bg);
-
-			// Key
-			ImGui::TableNextColumn();
-			std::string key = enemy["key"];
-			ImGui::Text("%s", key.c_str());
-
-			// Name
-			ImGui::TableNextColumn();
-			std::string name = enemy["value"][0]["enemyData"]["name"]["m_value"];
-			ImGui::Text("%s", name.c_str());
-
-			// HP
-			ImGui::TableNextColumn();
-			int hp = enemy["value"][0]["enemyData"]["attributes"]["maxHp"]["m_value"];
-			ImGui::Text("%d", hp);
-
-			// ATK
-			ImGui::TableNextColumn();
-			int atk = enemy["value"][0]["enemyData"]["attributes"]["atk"]["m_value"];
-			ImGui::Text("%d", atk);
-
-			// Range
-			ImGui::TableNextColumn();
-			float range = enemy["value"][0]["enemyData"]["rangeRadius"]["m_value"];
-			ImGui::Text("%.1f", range);
-
-			// Actions
-			ImGui::TableNextColumn();
-
-			ImGui::PushID(index);
-
-			// Edit 버튼
-			if (ImGui::SmallButton("편집"))
-			{
-				_selectedEnemyIndex = index;
-				_showEditWindow = true;
-
-				// 현재 입력값 백버퍼 저장
-				strcpy_s(_inputEnemyKey, sizeof(_inputEnemyKey), key.c_str());
-				strcpy_s(_inputName, sizeof(_inputName), name.c_str());
-				_inputEnemyType = StringToEnemyType(enemy["value"][0]["enemyData"]["type"]["m_value"]);
-				_inputMaxHp = hp;
-				_inputAtk = atk;
-				_inputRangeRadius = range;
-				_inputDef = enemy["value"][0]["enemyData"]["attributes"]["def"]["m_value"];
-				_inputMagicRes = enemy["value"][0]["enemyData"]["attributes"]["magicResistance"]["m_value"];
-				_inputMoveSpeed = enemy["value"][0]["enemyData"]["attributes"]["moveSpeed"]["m_value"];
-				_inputBaseAttackTime = enemy["value"][0]["enemyData"]["attributes"]["baseAttackTime"]["m_value"];
-			}
-
-			ImGui::SameLine();
-
-			// 삭제 버튼
-			if (ImGui::SmallButton("삭제"))
+			for (int index = clipper.DisplayStart; index < clipper.DisplayEnd; ++index)
 			{
-				_deleteTargetIndex = index;      // 인덱스 저장
-				_deleteTargetName = name;         // 이름 저장
-				_showDeleteConfirm = true;        // 팝업 표시 플래그
+				const auto& enemy = enemies[index];
+
+				ImGui::TableNextRow();
+
+				ImU32 bg = (index % 2 == 0)
+					? IM_COL32(25, 25, 25, 255)
+					: IM_COL32(40, 40, 40, 255);
+
+				ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg0, bg);
+
+				ImGui::PushID(index);
+
+				// 선택
+				ImGui::TableNextColumn();
+				SelectionCheckbox(_selection, index);
+
+				// Key
+				ImGui::TableNextColumn();
+				std::string key = enemy["key"];
+				ImGui::Text("%s", key.c_str());
+
+				// Name
+				ImGui::TableNextColumn();
+				std::string name = enemy["value"][0]["enemyData"]["name"]["m_value"];
+				ImGui::Text("%s", name.c_str());
+
+				// HP
+				ImGui::TableNextColumn();
+				int hp = enemy["value"][0]["enemyData"]["attributes"]["maxHp"]["m_value"];
+				ImGui::Text("%d", hp);
+
+				// ATK
+				ImGui::TableNextColumn();
+				int atk = enemy["value"][0]["enemyData"]["attributes"]["atk"]["m_value"];
+				ImGui::Text("%d", atk);
+
+				// Range
+				ImGui::TableNextColumn();
+				float range = enemy["value"][0]["enemyData"]["rangeRadius"]["m_value"];
+				ImGui::Text("%.1f", range);
+
+				// Actions
+				ImGui::TableNextColumn();
+
+				// Edit 버튼
+				if (ImGui::SmallButton("편집"))
+				{
+					_selectedEnemyIndex = index;
+					_showEditWindow = true;
+
+					// 현재 입력값 백버퍼 저장
+					strcpy_s(_inputEnemyKey, sizeof(_inputEnemyKey), key.c_str());
+					strcpy_s(_inputName, sizeof(_inputName), name.c_str());
+					_inputEnemyType = StringToEnemyType(enemy["value"][0]["enemyData"]["type"]["m_value"]);
+					_inputMaxHp = hp;
+					_inputAtk = atk;
+					_inputRangeRadius = range;
+					_inputDef = enemy["value"][0]["enemyData"]["attributes"]["def"]["m_value"];
+					_inputMagicRes = enemy["value"][0]["enemyData"]["attributes"]["magicResistance"]["m_value"];
+					_inputMoveSpeed = enemy["value"][0]["enemyData"]["attributes"]["moveSpeed"]["m_value"];
+					_inputBaseAttackTime = enemy["value"][0]["enemyData"]["attributes"]["baseAttackTime"]["m_value"];
+				}
+
+				ImGui::SameLine();
+
+				// 삭제 버튼
+				if (ImGui::SmallButton("삭제"))
+				{
+					_deleteTargetIndex = index;      // 인덱스 저장
+					_deleteTargetName = name;         // 이름 저장
+					_showDeleteConfirm = true;        // 팝업 표시 플래그
+				}
+
+				ImGui::PopID();
 			}
-
-			ImGui::PopID();
-
-			++index;
 		}
 		ImGui::EndTable();
 	}
@@ -275,14 +679,18 @@ void EnemyEditor::RenderEnemyList()
 		ImGui::SameLine();
 		ImGui::TextColored(COLOR_YELLOW, "%s", _deleteTargetName.c_str());
 
+		if (_deleteTargetIndex >= 0 && _deleteTargetIndex < (int)_enemyData["enemies"].size())
+			RenderUsageSummary(_enemyData["enemies"][_deleteTargetIndex].value("key", ""));
+
 		ImGui::Separator();
 
 		if (ImGui::Button("예", ImVec2(120, 0)))
 		{
 			if (_deleteTargetIndex >= 0 && _deleteTargetIndex < (int)_enemyData["enemies"].size())
 			{
-				_enemyData["enemies"].erase(_enemyData["enemies"].begin() + _deleteTargetIndex);
-				_hasUnsavedChanges = true;
+				std::vector<uint8_t> remove(_enemyData["enemies"].size(), 0);
+				remove[_deleteTargetIndex] = 1;
+				DeleteEnemies(remove);
 				std::cout << "[Enemy] Deleted: " << _deleteTargetName << "\n";
 			}
 			_deleteTargetIndex = -1;
@@ -301,6 +709,141 @@ void EnemyEditor::RenderEnemyList()
 	}
 }
 
+void EnemyEditor::RenderBatchPopups()
+{
+	auto& enemies = _enemyData["enemies"];
+
+	if (_showBatchDeleteConfirm)
+	{
+		ImGui::OpenPopup("일괄 삭제 확인");
+		_showBatchDeleteConfirm = false;
+	}
+
+	if (ImGui::BeginPopupModal("일괄 삭제 확인", NULL, ImGuiWindowFlags_AlwaysAutoResize))
+	{
+		ImGui::TextColored(COLOR_RED, "선택한 적 %d개를 정말 삭제할까요?", _selection.Count());
+
+		// 레벨에서 쓰이는 적 수 (색인 조회라 선택이 많아도 바로 계산됨)
+		std::vector<int> indices = _selection.Indices();
+		if (_usage)
+		{
+			int usedEnemies = 0;
+			int usages = 0;
+			for (int index : indices)
+			{
+				int count = _usage->UsageCount(enemies[index].value("key", ""));
+				usedEnemies += count > 0;
+				usages += count;
+			}
+
+			if (usedEnemies > 0)
+				ImGui::TextColored(COLOR_RED, "이 중 %d개가 레벨 스폰 %d곳에서 사용 중입니다.", usedEnemies, usages);
+		}
+		ImGui::Separator();
+
+		// 앞쪽 몇 개만 표시
+		int shown = 0;
+		for (int index : indices)
+		{
+			if (shown++ == 10)
+			{
+				ImGui::TextColored(COLOR_GRAY, "... 외 %d개", _selection.Count() - 10);
+				break;
+			}
+
+			std::string key = enemies[index].value("key", "");
+			int count = _usage ? _usage->UsageCount(key) : 0;
+			if (count > 0)
+				ImGui::TextColored(COLOR_YELLOW, "%s (레벨 %d개 / %d곳)", key.c_str(), _usage->LevelCount(key), count);
+			else
+				ImGui::TextColored(COLOR_YELLOW, "%s", key.c_str());
+		}
+
+		ImGui::Separator();
+
+		if (ImGui::Button("예", ImVec2(120, 0)))
+		{
+			DeleteEnemies(_selection.Flags());
+			ImGui::CloseCurrentPopup();
+		}
+
+		ImGui::SameLine();
+
+		if (ImGui::Button("아니오", ImVec2(120, 0)))
+		{
+			ImGui::CloseCurrentPopup();
+		}
+
+		ImGui::EndPopup();
+	}
+
+	BulkEditResult edit;
+	if (_fieldSetPopup.Render(BulkEditTarget::Enemy, enemies, _selection.Flags(), edit))
+		ApplyBulkEdit(std::move(edit));
+}
+
+void EnemyEditor::RenderUsageSummary(const std::string& key)
+{
+	if (!_usage)
+		return;
+
+	int usages = _usage->UsageCount(key);
+	if (usages == 0)
+	{
+		ImGui::TextColored(COLOR_GRAY, "레벨에서 사용되지 않음");
+		return;
+	}
+
+	ImGui::TextColored(COLOR_YELLOW, "레벨 %d개 / 스폰 %d곳에서 사용 중 (총 %d마리)",
+		_usage->LevelCount(key), usages, _usage->SpawnCount(key));
+}
+
+void EnemyEditor::RenderUsageList(const std::string& key)
+{
+	if (!_usage)
+		return;
+
+	const std::vector<EnemyUsage>& usages = _usage->Find(key);
+	if (usages.empty() || !ImGui::CollapsingHeader("사용 위치"))
+		return;
+
+	ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+	float height = ImGui::GetTextLineHeightWithSpacing() * std::min<float>(10.0f, (float)usages.size() + 1.5f);
+
+	if (ImGui::BeginTable("UsageTable", 5, flags, ImVec2(0, height)))
+	{
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("Level");
+		ImGui::TableSetupColumn("Wave", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+		ImGui::TableSetupColumn("Fragment", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+		ImGui::TableSetupColumn("Action", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+		ImGui::TableSetupColumn("Count", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+		ImGui::TableHeadersRow();
+
+		ImGuiListClipper clipper;
+		clipper.Begin((int)usages.size());
+		while (clipper.Step())
+		{
+			for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+			{
+				const EnemyUsage& usage = usages[i];
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", _usage->LevelId(usage.level).c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%d", usage.wave);
+				ImGui::TableNextColumn();
+				ImGui::Text("%d", usage.fragment);
+				ImGui::TableNextColumn();
+				ImGui::Text("%d", usage.action);
+				ImGui::TableNextColumn();
+				ImGui::Text("%d", usage.count);
+			}
+		}
+		ImGui::EndTable();
+	}
+}
+
 void EnemyEditor::RenderCreateWindow()
 {
 	ImGui::Begin("새로운 적 생성", &_showCreateWindow);
@@ -350,7 +893,13 @@ void EnemyEditor::RenderCreateWindow()
 			_enemyData["enemies"].push_back(newEnemy);
 
 			// 플래그 설정
-			_hasUnsavedChanges = true;
+			MarkModified();
+
+			if (_history)
+			{
+				int index = (int)_enemyData["enemies"].size() - 1;
+				_history->Push(std::make_unique<RecordStructureCommand>(this, true, std::vector<int>{ index }, std::vector<json>{ newEnemy }, std::string("적 생성: ") + _inputEnemyKey));
+			}
 
 			std::cout << "[Enemy] Created: " << _inputName << " (not saved yet)\n";
 
@@ -379,11 +928,16 @@ void EnemyEditor::RenderEditWindow()
 	ImGui::Begin("적 편집", &_showEditWindow);
 
 	auto& enemy = _enemyData["enemies"][_selectedEnemyIndex];
+	if (!_undoTracker.IsTracking(_selectedEnemyIndex, _revision))
+		_undoTracker.Reset(_selectedEnemyIndex, _revision, enemy);
 	auto& enemyData = enemy["value"][0]["enemyData"];
 	auto& attrs = enemyData["attributes"];
 
 	// key (읽기 전용)
-	ImGui::Text("ID: %s", enemy["key"].get<std::string>().c_str());
+	std::string key = enemy["key"];
+	ImGui::Text("ID: %s", key.c_str());
+	RenderUsageSummary(key);
+	RenderUsageList(key);
 	ImGui::Separator();
 
 	// Name
@@ -394,14 +948,14 @@ void EnemyEditor::RenderEditWindow()
 	if (ImGui::InputText("이름", nameBuffer, 128))
 	{
 		enemyData["name"]["m_value"] = std::string(nameBuffer);
-		_hasUnsavedChanges = true;  // 변경 플래그
+		MarkEnemyModified(_selectedEnemyIndex);  // 변경 플래그
 	}
 
 	const char* enemyTypes[] = { "지상", "공중" };
 	if (ImGui::Combo("타입", (int*)&_inputEnemyType, enemyTypes, IM_ARRAYSIZE(enemyTypes)))
 	{
 		enemyData["type"]["m_value"] = EnemyTypeToString(_inputEnemyType);
-		_hasUnsavedChanges = true;
+		MarkEnemyModified(_selectedEnemyIndex);
 	}
 
 	// HP
@@ -409,7 +963,7 @@ void EnemyEditor::RenderEditWindow()
 	if (ImGui::InputInt("최대 HP", &hp))
 	{
 		attrs["maxHp"]["m_value"] = hp;
-		_hasUnsavedChanges = true;
+		MarkEnemyModified(_selectedEnemyIndex);
 	}
 
 	// ATK
@@ -417,7 +971,7 @@ void EnemyEditor::RenderEditWindow()
 	if (ImGui::InputInt("공격력", &atk))
 	{
 		attrs["atk"]["m_value"] = atk;
-		_hasUnsavedChanges = true;
+		MarkEnemyModified(_selectedEnemyIndex);
 	}
 
 	// Range
@@ -425,7 +979,7 @@ void EnemyEditor::RenderEditWindow()
 	if (ImGui::InputFloat("공격 범위", &range, 0.1f, 1.0f, "%.1f"))
 	{
 		enemyData["rangeRadius"]["m_value"] = Snap1(static_cast<double>(range));
-		_hasUnsavedChanges = true;
+		MarkEnemyModified(_selectedEnemyIndex);
 	}
 
 	// DEF
@@ -433,7 +987,7 @@ void EnemyEditor::RenderEditWindow()
 	if (ImGui::InputInt("방어력", &def))
 	{
 		attrs["def"]["m_value"] = def;
-		_hasUnsavedChanges = true;
+		MarkEnemyModified(_selectedEnemyIndex);
 	}
 
 	// Magic Resistance
@@ -441,7 +995,7 @@ void EnemyEditor::RenderEditWindow()
 	if (ImGui::SliderInt("마법 저항", &magicRes, 0, 100))
 	{
 		attrs["magicResistance"]["m_value"] = Snap2(magicRes / 100.0);
-		_hasUnsavedChanges = true;
+		MarkEnemyModified(_selectedEnemyIndex);
 	}
 	ImGui::SameLine();
 	ImGui::Text("%%");
@@ -451,7 +1005,7 @@ void EnemyEditor::RenderEditWindow()
 	if (ImGui::InputFloat("이동 속도", &moveSpeed, 0.1f, 1.0f, "%.1f"))
 	{
 		attrs["moveSpeed"]["m_value"] = Snap1(static_cast<double>(moveSpeed));
-		_hasUnsavedChanges = true;
+		MarkEnemyModified(_selectedEnemyIndex);
 	}
 
 	// Base Attack Time
@@ -459,9 +1013,12 @@ void EnemyEditor::RenderEditWindow()
 	if (ImGui::InputFloat("공격 속도 (초)", &baseAttackTime, 0.05f, 1.0f, "%.2f"))
 	{
 		attrs["baseAttackTime"]["m_value"] = Snap2(static_cast<double>(baseAttackTime));
-		_hasUnsavedChanges = true;
+		MarkEnemyModified(_selectedEnemyIndex);
 	}
 
+	RenderOutlierWarning(_selectedEnemyIndex);
+	RenderVariantTable(_selectedEnemyIndex);
+
 	ImGui::Separator();
 
 	if (ImGui::Button("완료"))
@@ -472,6 +1029,87 @@ void EnemyEditor::RenderEditWindow()
 	ImGui::End();
 }
 
+void EnemyEditor::RenderVariantTable(int enemyIndex)
+{
+	ImGui::SeparatorText("레벨 변형");
+
+	int count = _variants.VariantCount(enemyIndex);
+	if (count <= 1)
+	{
+		ImGui::TextColored(COLOR_GRAY, "레벨 변형 없음 (value[0] 만 존재)");
+		return;
+	}
+
+	// 기본값(value[0])과 다른 칸은 해당 레벨에서 m_defined 로 덮어쓴 값
+	const EnemyStats& base = *_variants.Get(enemyIndex, 0);
+	ImGui::TextColored(COLOR_GRAY, "노란색 = 이 레벨에서 재정의된 값, 나머지는 기본값 상속");
+
+	ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+	if (ImGui::BeginTable("EnemyVariants", 8, flags))
+	{
+		ImGui::TableSetupColumn("레벨");
+		ImGui::TableSetupColumn("HP");
+		ImGui::TableSetupColumn("ATK");
+		ImGui::TableSetupColumn("DEF");
+		ImGui::TableSetupColumn("RES");
+		ImGui::TableSetupColumn("이동");
+		ImGui::TableSetupColumn("공속");
+		ImGui::TableSetupColumn("범위");
+		ImGui::TableHeadersRow();
+
+		auto cell = [](bool overridden, const char* format, double value)
+			{
+				ImGui::TableNextColumn();
+				if (overridden)
+					ImGui::TextColored(COLOR_YELLOW, format, value);
+				else
+					ImGui::Text(format, value);
+			};
+
+		for (int v = 0; v < count; ++v)
+		{
+			const EnemyStats& stats = *_variants.Get(enemyIndex, v);
+			bool derived = v > 0;
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%d", stats.level);
+			cell(derived && stats.maxHp != base.maxHp, "%.0f", stats.maxHp);
+			cell(derived && stats.atk != base.atk, "%.0f", stats.atk);
+			cell(derived && stats.def != base.def, "%.0f", stats.def);
+			cell(derived && stats.magicResistance != base.magicResistance, "%.2f", stats.magicResistance);
+			cell(derived && stats.moveSpeed != base.moveSpeed, "%.1f", stats.moveSpeed);
+			cell(derived && stats.baseAttackTime != base.baseAttackTime, "%.2f", stats.baseAttackTime);
+			cell(derived && stats.rangeRadius != base.rangeRadius, "%.1f", stats.rangeRadius);
+		}
+		ImGui::EndTable();
+	}
+}
+
+void EnemyEditor::RenderOutlierWarning(int enemyIndex)
+{
+	if (enemyIndex >= _outliers.Count())
+		return;
+
+	const OutlierResult& result = _outliers.Result(enemyIndex);
+	if (!result.flagged)
+		return;
+
+	ImGui::Separator();
+	ImGui::TextColored(COLOR_YELLOW, "[!] 밸런스 이상치 의심 (%s 그룹 %d개 기준)",
+		_outliers.GroupName(result.group).c_str(), _outliers.GroupSize(result.group));
+
+	double ratio = (result.groupMedian > 0.0f) ? result.value / result.groupMedian : 0.0;
+	ImGui::TextColored(COLOR_YELLOW, "    %s = %.2f, 그룹 중앙값 %.2f (%.1f배, z = %+.1f)",
+		EnemyOutlierColumn(result.column), result.value, result.groupMedian, ratio, result.zScore);
+
+	if (result.nearest >= 0)
+	{
+		ImGui::TextColored(COLOR_GRAY, "    가장 가까운 적: %s (거리 %.2f)",
+			_enemyData["enemies"][result.nearest]["key"].get<std::string>().c_str(), result.nnDistance);
+	}
+}
+
 json EnemyEditor::CreateEnemyDataStructure(const std::string& key, const std::string& name, const std::string& type, int hp, int atk, float rangeRadius, int def, int magicRes, float moveSpeed, float baseAttackTime)
 {
 	return {
@@ -1,22 +1,70 @@
 ﻿#pragma once
 #include <string>
+#include <cstdint>
 #include <nlohmann/json.hpp>
 
+#include "EnemyVariants.h"
+#include "BalanceOutliers.h"
+#include "BulkEdit.h"
+#include "BatchWidgets.h"
+#include "EnemyUsageIndex.h"
+#include "ProjectStats.h"
+#include "EditHistory.h"
+#include "PristineSnapshot.h"
+#include "ContentHash.h"
+#include "Utility.h"
+
 using json = nlohmann::ordered_json;
 
-class EnemyEditor
+class EnemyEditor : public RecordEditTarget
 {
 public:
 	EnemyEditor(const std::string& jsonPath);
 	~EnemyEditor();
 
-	void RenderGUI(bool* p_open);
+	// usage = 레벨 편집기의 적 사용 위치 색인 (없으면 nullptr)
+	void RenderGUI(bool* p_open, const EnemyUsageIndex* usage);
 
 	void LoadEnemies();
 	void SaveEnemies();
 
-	bool HasUnsavedChanges() const { return _hasUnsavedChanges; }
+	// 마지막으로 읽거나 저장한 상태로 되돌림 (파일을 다시 읽지 않고 바꾼 적만 복사)
+	void DiscardChanges();
+	// 파일이 바뀌었을 때만 다시 읽고, 그대로면 DiscardChanges
+	void RefreshFromDisk();
+
+	// 값을 고쳤다가 원래대로 돌렸으면 저장된 해시와 같으므로 false
+	bool HasUnsavedChanges();
 	void ClearUnsavedFlag() { _hasUnsavedChanges = false; }
+	// 저장된 상태와 다른 적 키 목록
+	const RecordChangeSummary& GetChangeSummary();
+
+	// 분석 창에서 읽기 전용으로 사용 (데이터가 바뀌면 revision 이 바뀜)
+	const json& GetEnemyData() const { return _enemyData; }
+	uint64_t GetRevision() const { return _revision; }
+	const RecordChangeLog& GetChangeLog() const { return _changeLog; }
+	const EnemyVariantTable& GetResolvedEnemies() const { return _variants; }
+	const OutlierDetector& GetOutliers();
+	void SetOutlierConfig(const OutlierConfig& config) { _outliers.SetConfig(config); }
+	void FlushOutliers() { if (!_outliersDirty) _outliers.Flush(); }	// 편집 동작이 끝났을 때 미뤄 둔 그룹 재계산
+	const RecordStatTable& GetStats();
+
+	// 일괄 편집 (마지막 한 건만 되돌릴 수 있음)
+	bool ApplyBulkEdit(BulkEditResult edit);
+	bool UndoBulkEdit();
+	bool CanUndoBulkEdit() const { return _lastBulkEdit.ok; }
+
+	// 실행 취소 기록 (레코드 = enemies[] 의 적 하나)
+	void SetEditHistory(EditHistory* history) { _history = history; }
+	const char* EditTargetName() const override { return "적"; }
+	std::string EditRecordLabel(int record) const override;
+	std::string EditRecordKey(int record) const override;
+	std::string EditRecordKeyPath() const override { return "/key"; }
+	uint64_t EditSourceHash(const std::string& source) const override;
+	int EditRecordCount() const override { return _enemyData.contains("enemies") ? (int)_enemyData["enemies"].size() : 0; }
+	void SetRecordValue(int record, const json::json_pointer& pointer, const json& value) override;
+	void InsertRecords(const std::vector<int>& indices, const std::vector<json>& records) override;
+	void RemoveRecords(const std::vector<int>& indices) override;
 
 private:
 	enum class EnemyType
@@ -33,6 +81,41 @@ private:
 
 	// 변경 사항 추적
 	bool _hasUnsavedChanges = false;
+	uint64_t _revision = 0;
+	RecordChangeLog _changeLog;			// 적 하나만 바꾼 revision
+
+	// 레벨 변형까지 해석한 스탯 (구조가 바뀌면 전체, 값만 바뀌면 해당 적만 다시 해석)
+	EnemyVariantTable _variants;
+
+	// 같은 타입(지상/비행 × 근거리/원거리) 안에서 튀는 스탯 검사 (기본 변형 기준)
+	// 구조가 바뀌면 다음에 결과를 볼 때 다시 계산 (대량 삭제/복제 직후 바로 계산하지 않음)
+	OutlierDetector _outliers;
+	bool _outliersDirty = true;
+	void RebuildOutliers();
+
+	// 통계 대시보드용 열별 분포 (이상치와 같이 값만 바뀌면 해당 적만 갱신)
+	RecordStatTable _stats{ EnemyStatColumns() };
+	bool _statsDirty = true;
+
+	BulkEditResult _lastBulkEdit;
+
+	// 편집 창에서 고친 값은 기준 사본과 비교해 바뀐 값만 기록
+	EditHistory* _history = nullptr;
+	RecordEditTracker _undoTracker;
+
+	// 저장된 상태 사본과 읽은 파일
+	PristineSnapshot<json> _pristine;
+	std::vector<FileStamp> _fileStamps;
+
+	// 적별 내용 해시 (값만 바뀌면 해당 적만, 구조가 바뀌면 다음에 볼 때 전체 다시 계산)
+	RecordHashTable _contentHashes;
+	bool _contentHashesDirty = true;
+	RecordChangeSummary _changeSummary;
+	uint64_t _changeSummaryRevision = 0;
+	void RefreshContentHashes();
+
+	void MarkModified();
+	void MarkEnemyModified(int index);
 
 	// GUI state
 	bool _showCreateWindow = false;
@@ -54,11 +137,27 @@ private:
 	int _deleteTargetIndex = -1;
 	std::string _deleteTargetName;
 
+	// 이번 프레임에 받은 적 사용 위치 색인
+	const EnemyUsageIndex* _usage = nullptr;
+
+	// 목록 다중 선택 / 일괄 작업
+	MultiSelection _selection;
+	FieldSetPopup _fieldSetPopup;
+	bool _showBatchDeleteConfirm = false;
+
+	void DeleteEnemies(const std::vector<uint8_t>& remove);	// 선택 플래그와 같은 형식
+	void DuplicateSelected();
+
 	// GUI 헬퍼 함수
 	void RenderToolbar();
 	void RenderEnemyList();
+	void RenderBatchPopups();
+	void RenderUsageSummary(const std::string& key);
+	void RenderUsageList(const std::string& key);
 	void RenderCreateWindow();
 	void RenderEditWindow();
+	void RenderVariantTable(int enemyIndex);
+	void RenderOutlierWarning(int enemyIndex);
 
 	// 기본 헬퍼 함수
 	json CreateEnemyDataStructure(const std::string& key, const std::string& name, const std::string& type,
@@ -0,0 +1,255 @@
+﻿#include "EnemyUsageIndex.h"
+#include "Parallel.h"
+#include <algorithm>
+
+namespace
+{
+	using FoundUsage = std::pair<std::string, EnemyUsage>;
+
+	// waves[].fragments[].actions[].key 를 순서대로 모음
+	void ScanLevel(const json& levelData, int level, std::vector<FoundUsage>& out)
+	{
+		auto waves = levelData.find("waves");
+		if (waves == levelData.end() || !waves->is_array())
+			return;
+
+		for (int w = 0; w < (int)waves->size(); ++w)
+		{
+			const json& wave = (*waves)[w];
+			auto fragments = wave.find("fragments");
+			if (fragments == wave.end() || !fragments->is_array())
+				continue;
+
+			for (int f = 0; f < (int)fragments->size(); ++f)
+			{
+				const json& fragment = (*fragments)[f];
+				auto actions = fragment.find("actions");
+				if (actions == fragment.end() || !actions->is_array())
+					continue;
+
+				for (int a = 0; a < (int)actions->size(); ++a)
+				{
+					const json& action = (*actions)[a];
+					auto key = action.find("key");
+					if (key == action.end() || !key->is_string())
+						continue;
+
+					EnemyUsage usage;
+					usage.level = level;
+					usage.wave = w;
+					usage.fragment = f;
+					usage.action = a;
+					usage.count = action.value("count", 1);
+					out.push_back({ key->get<std::string>(), usage });
+				}
+			}
+		}
+	}
+
+	const std::vector<EnemyUsage> EMPTY_USAGES;
+	const std::string EMPTY_LEVEL_ID;
+}
+
+void EnemyUsageIndex::Build(const std::vector<const json*>& levels, const std::vector<std::string>& levelIds)
+{
+	++_revision;
+	_usages.clear();
+	_levelIds = levelIds;
+	_levelIds.resize(levels.size());
+	_levelKeys.assign(levels.size(), {});
+
+	// 파일마다 JSON 을 훑는 부분만 병렬, 해시 테이블 병합은 한 스레드에서
+	std::vector<std::vector<FoundUsage>> found(levels.size());
+	ParallelFor(levels.size(), 4, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				if (levels[i])
+					ScanLevel(*levels[i], (int)i, found[i]);
+			}
+		});
+
+	for (const auto& levelFound : found)
+	{
+		for (const auto& [key, usage] : levelFound)
+			Add(key, usage);
+	}
+}
+
+void EnemyUsageIndex::SetLevel(int level, const std::string& levelId, const json& levelData)
+{
+	++_revision;
+	if (level < 0)
+		return;
+
+	if (level >= (int)_levelIds.size())
+	{
+		_levelIds.resize(level + 1);
+		_levelKeys.resize(level + 1);
+	}
+	else
+	{
+		ClearLevel(level);
+	}
+	_levelIds[level] = levelId;
+
+	std::vector<FoundUsage> found;
+	ScanLevel(levelData, level, found);
+	for (const auto& [key, usage] : found)
+		Add(key, usage);
+}
+
+void EnemyUsageIndex::RemapLevels(const std::vector<int>& remap, size_t newCount)
+{
+	++_revision;
+	for (int i = 0; i < (int)remap.size() && i < (int)_levelIds.size(); ++i)
+	{
+		if (remap[i] < 0)
+			ClearLevel(i);
+	}
+
+	std::vector<std::string> levelIds(newCount);
+	std::vector<std::vector<std::string>> levelKeys(newCount);
+	for (int i = 0; i < (int)remap.size() && i < (int)_levelIds.size(); ++i)
+	{
+		if (remap[i] < 0 || remap[i] >= (int)newCount)
+			continue;
+
+		levelIds[remap[i]] = std::move(_levelIds[i]);
+		levelKeys[remap[i]] = std::move(_levelKeys[i]);
+	}
+	_levelIds = std::move(levelIds);
+	_levelKeys = std::move(levelKeys);
+
+	for (auto& [key, entry] : _usages)
+	{
+		for (auto& usage : entry.usages)
+			usage.level = remap[usage.level];
+	}
+}
+
+void EnemyUsageIndex::AddAction(int level, int wave, int fragment, int action, const std::string& key, int count)
+{
+	if (level < 0 || level >= (int)_levelIds.size())
+		return;
+
+	EnemyUsage usage;
+	usage.level = level;
+	usage.wave = wave;
+	usage.fragment = fragment;
+	usage.action = action;
+	usage.count = count;
+	Add(key, usage);
+	++_revision;
+}
+
+void EnemyUsageIndex::RemoveAction(int level, int wave, int fragment, int action)
+{
+	if (level < 0 || level >= (int)_levelKeys.size())
+		return;
+	++_revision;
+
+	// 이 레벨에서 쓰인 키만 찾아가서 지우고, 같은 fragment 의 뒤쪽 번호를 당김
+	for (const auto& key : _levelKeys[level])
+	{
+		auto it = _usages.find(key);
+		if (it == _usages.end())
+			continue;
+
+		Entry& entry = it->second;
+		size_t out = 0;
+		for (size_t i = 0; i < entry.usages.size(); ++i)
+		{
+			EnemyUsage usage = entry.usages[i];
+			bool sameFragment = usage.level == level && usage.wave == wave && usage.fragment == fragment;
+
+			if (sameFragment && usage.action == action)
+			{
+				entry.spawnCount -= usage.count;
+				continue;
+			}
+			if (sameFragment && usage.action > action)
+				--usage.action;
+
+			entry.usages[out++] = usage;
+		}
+		entry.usages.resize(out);
+
+		if (entry.usages.empty())
+			_usages.erase(it);
+	}
+}
+
+int EnemyUsageIndex::UsageCount(const std::string& key) const
+{
+	auto it = _usages.find(key);
+	return (it != _usages.end()) ? (int)it->second.usages.size() : 0;
+}
+
+int EnemyUsageIndex::SpawnCount(const std::string& key) const
+{
+	auto it = _usages.find(key);
+	return (it != _usages.end()) ? it->second.spawnCount : 0;
+}
+
+int EnemyUsageIndex::LevelCount(const std::string& key) const
+{
+	auto it = _usages.find(key);
+	if (it == _usages.end())
+		return 0;
+
+	std::vector<int> levels;
+	levels.reserve(it->second.usages.size());
+	for (const auto& usage : it->second.usages)
+		levels.push_back(usage.level);
+
+	std::sort(levels.begin(), levels.end());
+	return (int)(std::unique(levels.begin(), levels.end()) - levels.begin());
+}
+
+const std::vector<EnemyUsage>& EnemyUsageIndex::Find(const std::string& key) const
+{
+	auto it = _usages.find(key);
+	return (it != _usages.end()) ? it->second.usages : EMPTY_USAGES;
+}
+
+const std::string& EnemyUsageIndex::LevelId(int level) const
+{
+	return (level >= 0 && level < (int)_levelIds.size()) ? _levelIds[level] : EMPTY_LEVEL_ID;
+}
+
+void EnemyUsageIndex::ClearLevel(int level)
+{
+	for (const auto& key : _levelKeys[level])
+	{
+		auto it = _usages.find(key);
+		if (it == _usages.end())
+			continue;
+
+		Entry& entry = it->second;
+		size_t out = 0;
+		for (size_t i = 0; i < entry.usages.size(); ++i)
+		{
+			if (entry.usages[i].level == level)
+				entry.spawnCount -= entry.usages[i].count;
+			else
+				entry.usages[out++] = entry.usages[i];
+		}
+		entry.usages.resize(out);
+
+		if (entry.usages.empty())
+			_usages.erase(it);
+	}
+	_levelKeys[level].clear();
+}
+
+void EnemyUsageIndex::Add(const std::string& key, const EnemyUsage& usage)
+{
+	Entry& entry = _usages[key];
+	entry.usages.push_back(usage);
+	entry.spawnCount += usage.count;
+
+	auto& keys = _levelKeys[usage.level];
+	if (std::find(keys.begin(), keys.end(), key) == keys.end())
+		keys.push_back(key);
+}
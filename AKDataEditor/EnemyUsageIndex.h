@@ -0,0 +1,70 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::ordered_json;
+
+// 적 키 하나가 레벨에서 쓰인 위치 (waves[wave].fragments[fragment].actions[action])
+struct EnemyUsage
+{
+	int level = -1;
+	int wave = -1;
+	int fragment = -1;
+	int action = -1;
+	int count = 1;		// action 의 count (스폰 수)
+};
+
+// 적 키 -> 사용 위치 역색인 ("어디서 쓰이나")
+// 레벨 인덱스는 LevelEditor 의 _levels 순서와 같게 유지해야 함
+class EnemyUsageIndex
+{
+public:
+	// 모든 레벨을 병렬로 훑어 처음부터 만듦
+	void Build(const std::vector<const json*>& levels, const std::vector<std::string>& levelIds);
+
+	// 레벨 하나를 다시 색인 (새 레벨이면 levels 끝에 추가)
+	void SetLevel(int level, const std::string& levelId, const json& levelData);
+
+	// 레벨 목록이 압축/복제된 뒤 old -> new 로 옮김 (-1 = 삭제, 새로 생긴 레벨은 SetLevel 로 채움)
+	void RemapLevels(const std::vector<int>& remap, size_t newCount);
+
+	// actions[] 끝에 하나 추가 / 하나 삭제 (뒤쪽 action 번호는 앞으로 당겨짐)
+	void AddAction(int level, int wave, int fragment, int action, const std::string& key, int count);
+	void RemoveAction(int level, int wave, int fragment, int action);
+
+	int UsageCount(const std::string& key) const;	// action 수
+	int SpawnCount(const std::string& key) const;	// count 합
+	int LevelCount(const std::string& key) const;	// 서로 다른 레벨 수
+	const std::vector<EnemyUsage>& Find(const std::string& key) const;
+
+	int LevelCountTotal() const { return (int)_levelIds.size(); }
+	const std::string& LevelId(int level) const;
+	size_t KeyCount() const { return _usages.size(); }
+	uint64_t GetRevision() const { return _revision; }	// 색인이 바뀔 때마다 증가
+
+	// func(key, usages) 를 쓰인 키마다 한 번씩 호출
+	template <typename Func>
+	void ForEachKey(Func&& func) const
+	{
+		for (const auto& [key, entry] : _usages)
+			func(key, entry.usages);
+	}
+
+private:
+	struct Entry
+	{
+		std::vector<EnemyUsage> usages;
+		int spawnCount = 0;
+	};
+
+	std::unordered_map<std::string, Entry> _usages;
+	std::vector<std::string> _levelIds;
+	std::vector<std::vector<std::string>> _levelKeys;	// 레벨별로 쓰인 키 (지울 때 찾아갈 목록, 중복 없음)
+	uint64_t _revision = 0;
+
+	void ClearLevel(int level);
+	void Add(const std::string& key, const EnemyUsage& usage);
+};
@@ -0,0 +1,244 @@
+﻿#include "EnemyVariants.h"
+#include <algorithm>
+#include <iostream>
+
+void EnemyVariantTable::Resolve(const json& enemy, std::vector<EnemyStats>& out)
+{
+	out.clear();
+
+	EnemyStats base;
+	if (!ParseEnemyStats(enemy, base))
+		return;
+
+	const json& variants = enemy["value"];
+	out.reserve(variants.size());
+	out.push_back(base);
+
+	// 정의되지 않은 필드는 value[0] 에서 상속
+	for (size_t v = 1; v < variants.size(); ++v)
+	{
+		EnemyStats stats = base;
+		stats.level = variants[v].value("level", (int)v);
+
+		try
+		{
+			if (variants[v].contains("enemyData"))
+				ApplyEnemyOverrides(variants[v]["enemyData"], stats);
+		}
+		catch (const json::exception& e)
+		{
+			std::cout << "[Tables] Invalid enemy variant " << base.key << "[" << v << "]: " << e.what() << "\n";
+		}
+
+		out.push_back(std::move(stats));
+	}
+}
+
+void EnemyVariantTable::Build(const json& enemies)
+{
+	_stats.clear();
+	_offsets.assign(1, 0);
+	_keys.clear();
+	_lookup.clear();
+
+	if (!enemies.is_array())
+		return;
+
+	_offsets.reserve(enemies.size() + 1);
+	_keys.reserve(enemies.size());
+
+	std::vector<EnemyStats> resolved;
+	for (const auto& enemy : enemies)
+	{
+		Resolve(enemy, resolved);
+		_stats.insert(_stats.end(), std::make_move_iterator(resolved.begin()), std::make_move_iterator(resolved.end()));
+		_offsets.push_back((int)_stats.size());
+
+		std::string key = enemy.value("key", "");
+		if (!key.empty())
+			_lookup.emplace(key, (int)_keys.size());
+		_keys.push_back(std::move(key));
+	}
+}
+
+void EnemyVariantTable::UpdateEnemy(int index, const json& enemy)
+{
+	if (index < 0 || index >= EnemyCount())
+		return;
+
+	std::vector<EnemyStats> resolved;
+	Resolve(enemy, resolved);
+
+	const int begin = _offsets[index];
+	const int oldCount = VariantCount(index);
+	const int newCount = (int)resolved.size();
+
+	if (newCount == oldCount)
+	{
+		std::move(resolved.begin(), resolved.end(), _stats.begin() + begin);
+	}
+	else
+	{
+		// 변형 수가 바뀐 경우만 뒤쪽 구간을 밀고 오프셋 보정
+		_stats.erase(_stats.begin() + begin, _stats.begin() + begin + oldCount);
+		_stats.insert(_stats.begin() + begin, std::make_move_iterator(resolved.begin()), std::make_move_iterator(resolved.end()));
+		for (size_t i = index + 1; i < _offsets.size(); ++i)
+			_offsets[i] += newCount - oldCount;
+	}
+
+	std::string key = enemy.value("key", "");
+	if (key != _keys[index])
+	{
+		std::string oldKey = std::move(_keys[index]);
+		_keys[index] = std::move(key);
+
+		// Build 와 같이 같은 키의 첫 항목이 조회 대상 (옛 키는 남은 첫 항목으로 옮김)
+		auto it = _lookup.find(oldKey);
+		if (it != _lookup.end() && it->second == index)
+		{
+			auto remaining = std::find(_keys.begin(), _keys.end(), oldKey);
+			if (remaining != _keys.end())
+				it->second = (int)(remaining - _keys.begin());
+			else
+				_lookup.erase(it);
+		}
+
+		if (!_keys[index].empty())
+		{
+			auto [found, inserted] = _lookup.emplace(_keys[index], index);
+			if (!inserted && found->second > index)
+				found->second = index;
+		}
+	}
+}
+
+void EnemyVariantTable::RemoveEnemies(const std::vector<uint8_t>& remove)
+{
+	const int count = EnemyCount();
+	size_t outStat = 0;
+	int outEnemy = 0;
+
+	for (int i = 0; i < count; ++i)
+	{
+		if (i < (int)remove.size() && remove[i])
+		{
+			auto it = _lookup.find(_keys[i]);
+			if (it != _lookup.end() && it->second == i)
+				_lookup.erase(it);
+			continue;
+		}
+
+		const int begin = _offsets[i];
+		const int variants = VariantCount(i);
+		if ((size_t)begin != outStat)
+			std::move(_stats.begin() + begin, _stats.begin() + begin + variants, _stats.begin() + outStat);
+
+		_offsets[outEnemy] = (int)outStat;
+		if (outEnemy != i)
+		{
+			// 조회 테이블은 다시 만들지 않고 옮겨진 항목의 인덱스만 고침
+			// (같은 키의 앞 항목이 지워졌으면 남은 첫 항목이 조회 대상)
+			auto it = _lookup.find(_keys[i]);
+			if (it == _lookup.end())
+			{
+				if (!_keys[i].empty())
+					_lookup.emplace(_keys[i], outEnemy);
+			}
+			else if (it->second == i)
+			{
+				it->second = outEnemy;
+			}
+			_keys[outEnemy] = std::move(_keys[i]);
+		}
+
+		outStat += variants;
+		++outEnemy;
+	}
+
+	_stats.erase(_stats.begin() + outStat, _stats.end());
+	_offsets.resize(outEnemy + 1);
+	_offsets[outEnemy] = (int)outStat;
+	_keys.resize(outEnemy);
+}
+
+void EnemyVariantTable::InsertEnemies(const std::vector<int>& indices, const json& enemies)
+{
+	const int count = (int)enemies.size();
+	if (count != EnemyCount() + (int)indices.size())
+	{
+		Build(enemies);
+		return;
+	}
+
+	std::vector<EnemyStats> stats;
+	std::vector<int> offsets;
+	std::vector<std::string> keys;
+	stats.reserve(_stats.size() + indices.size());
+	offsets.reserve(count + 1);
+	offsets.push_back(0);
+	keys.reserve(count);
+
+	std::vector<EnemyStats> resolved;
+	size_t next = 0;
+	int source = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		if (next < indices.size() && indices[next] == i)
+		{
+			Resolve(enemies[i], resolved);
+			stats.insert(stats.end(), std::make_move_iterator(resolved.begin()), std::make_move_iterator(resolved.end()));
+			keys.push_back(enemies[i].value("key", ""));
+			++next;
+		}
+		else
+		{
+			stats.insert(stats.end(), std::make_move_iterator(_stats.begin() + _offsets[source]), std::make_move_iterator(_stats.begin() + _offsets[source + 1]));
+			keys.push_back(std::move(_keys[source]));
+			++source;
+		}
+		offsets.push_back((int)stats.size());
+	}
+
+	_stats = std::move(stats);
+	_offsets = std::move(offsets);
+	_keys = std::move(keys);
+
+	// 뒤쪽 인덱스가 모두 밀리므로 조회 테이블은 다시 만듦 (해석은 하지 않음)
+	_lookup.clear();
+	for (int i = 0; i < count; ++i)
+	{
+		if (!_keys[i].empty())
+			_lookup.emplace(_keys[i], i);
+	}
+}
+
+const EnemyStats* EnemyVariantTable::Get(int enemy, int variant) const
+{
+	if (enemy < 0 || enemy >= EnemyCount())
+		return nullptr;
+
+	int count = VariantCount(enemy);
+	if (count == 0)
+		return nullptr;
+
+	variant = std::max(0, std::min(variant, count - 1));
+	return &_stats[_offsets[enemy] + variant];
+}
+
+const EnemyStats* EnemyVariantTable::Find(const std::string& key, int variant) const
+{
+	auto it = _lookup.find(key);
+	return (it != _lookup.end()) ? Get(it->second, variant) : nullptr;
+}
+
+std::vector<EnemyStats> EnemyVariantTable::Snapshot(int variant) const
+{
+	std::vector<EnemyStats> out;
+	out.reserve(EnemyCount());
+	for (int i = 0; i < EnemyCount(); ++i)
+	{
+		if (const EnemyStats* stats = Get(i, variant))
+			out.push_back(*stats);
+	}
+	return out;
+}
@@ -0,0 +1,46 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "GameTables.h"
+
+// 모든 (적, 레벨 변형) 을 m_defined 상속까지 해석해 둔 스탯 뷰
+// 적 i 의 변형 j 는 연속 배열의 _stats[_offsets[i] + j] (j = value[] 순서, 0 = 기본)
+// 레벨 편집기/시뮬레이터/데미지 매트릭스는 오버라이드 체인을 따라가지 않고 여기서 바로 읽음
+class EnemyVariantTable
+{
+public:
+	// enemies_table.json 의 "enemies" 배열 (형식이 잘못된 적은 변형 0개로 자리만 유지)
+	void Build(const json& enemies);
+
+	// 적 하나만 다시 해석 (기본값이 바뀌면 상속받는 모든 변형이 함께 바뀜)
+	void UpdateEnemy(int index, const json& enemy);
+
+	// 일괄 삭제 (remove[i] = 1 인 적을 다시 해석하지 않고 한 번에 당김)
+	void RemoveEnemies(const std::vector<uint8_t>& remove);
+
+	// 일괄 삽입 (enemies = 삽입 후 전체 배열, indices = 새로 들어간 위치 오름차순, 들어간 적만 해석)
+	void InsertEnemies(const std::vector<int>& indices, const json& enemies);
+
+	int EnemyCount() const { return (int)_offsets.size() - 1; }
+	int VariantCount(int enemy) const { return _offsets[enemy + 1] - _offsets[enemy]; }
+
+	// 변형 인덱스가 범위를 넘으면 마지막 변형 (변형이 없으면 nullptr)
+	const EnemyStats* Get(int enemy, int variant) const;
+	const EnemyStats* Find(const std::string& key, int variant = 0) const;
+
+	const std::vector<EnemyStats>& All() const { return _stats; }
+
+	// 적마다 지정한 변형 하나씩 (변형이 없는 적은 건너뜀, variant = 0 이면 ParseEnemyTable 과 같은 결과)
+	std::vector<EnemyStats> Snapshot(int variant = 0) const;
+
+private:
+	std::vector<EnemyStats> _stats;
+	std::vector<int> _offsets = { 0 };
+	std::vector<std::string> _keys;
+	std::unordered_map<std::string, int> _lookup;
+
+	static void Resolve(const json& enemy, std::vector<EnemyStats>& out);
+};
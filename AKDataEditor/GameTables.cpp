@@ -0,0 +1,261 @@
+﻿#include "GameTables.h"
+#include "AttributeCurve.h"
+#include <cmath>
+#include <iostream>
+#include <fstream>
+
+namespace
+{
+	// {m_defined, m_value} 래핑 필드 읽기
+	template <typename T>
+	T ReadDefined(const json& node, const char* key, T fallback)
+	{
+		if (!node.contains(key))
+			return fallback;
+
+		const json& field = node[key];
+		if (field.is_object())
+		{
+			if (!field.contains("m_value") || field["m_value"].is_null())
+				return fallback;
+			return field["m_value"].get<T>();
+		}
+
+		if (field.is_null())
+			return fallback;
+		return field.get<T>();
+	}
+
+	// 레벨 변형용: m_defined 가 true 일 때만 값을 덮어씀
+	template <typename T>
+	void ReadOverride(const json& node, const char* key, T& inout)
+	{
+		if (!node.contains(key))
+			return;
+
+		const json& field = node[key];
+		if (field.is_object())
+		{
+			if (!field.value("m_defined", false) || !field.contains("m_value") || field["m_value"].is_null())
+				return;
+			inout = field["m_value"].get<T>();
+			return;
+		}
+
+		if (!field.is_null())
+			inout = field.get<T>();
+	}
+
+	// 마법 저항은 0~1 비율로 저장되지만 원본 데이터(0~100)도 허용
+	double NormalizeResistance(double value)
+	{
+		return (value > 1.0) ? value / 100.0 : value;
+	}
+}
+
+bool LoadJsonFile(const std::string& path, json& out)
+{
+	std::ifstream file(path);
+	if (!file.is_open())
+	{
+		std::cout << "[Tables] File not found: " << path << "\n";
+		return false;
+	}
+
+	try
+	{
+		file >> out;
+	}
+	catch (const json::exception& e)
+	{
+		std::cout << "[Tables] JSON parse error in " << path << ": " << e.what() << "\n";
+		return false;
+	}
+
+	return true;
+}
+
+bool ParseEnemyStats(const json& enemy, EnemyStats& out)
+{
+	if (!enemy.contains("key") || !enemy.contains("value") || enemy["value"].empty())
+		return false;
+
+	try
+	{
+		const json& enemyData = enemy["value"][0]["enemyData"];
+		const json& attrs = enemyData["attributes"];
+
+		out.key = enemy["key"].get<std::string>();
+		out.level = enemy["value"][0].value("level", 0);
+		out.name = ReadDefined<std::string>(enemyData, "name", out.key);
+		out.isFlying = ReadDefined<std::string>(enemyData, "type", "GROUND") == "FLYING";
+		out.maxHp = ReadDefined<int>(attrs, "maxHp", 0);
+		out.atk = ReadDefined<int>(attrs, "atk", 0);
+		out.def = ReadDefined<int>(attrs, "def", 0);
+		out.magicResistance = NormalizeResistance(ReadDefined<double>(attrs, "magicResistance", 0.0));
+		out.moveSpeed = ReadDefined<double>(attrs, "moveSpeed", 1.0);
+		out.baseAttackTime = ReadDefined<double>(attrs, "baseAttackTime", 1.0);
+		out.rangeRadius = ReadDefined<double>(enemyData, "rangeRadius", -1.0);
+		out.lifePointReduce = ReadDefined<int>(enemyData, "lifePointReduce", 1);
+	}
+	catch (const json::exception& e)
+	{
+		std::cout << "[Tables] Invalid enemy entry: " << e.what() << "\n";
+		return false;
+	}
+
+	return true;
+}
+
+void ApplyEnemyOverrides(const json& enemyData, EnemyStats& inout)
+{
+	ReadOverride<std::string>(enemyData, "name", inout.name);
+
+	std::string type = inout.isFlying ? "FLYING" : "GROUND";
+	ReadOverride<std::string>(enemyData, "type", type);
+	inout.isFlying = (type == "FLYING");
+
+	ReadOverride<double>(enemyData, "rangeRadius", inout.rangeRadius);
+	ReadOverride<int>(enemyData, "lifePointReduce", inout.lifePointReduce);
+
+	if (!enemyData.contains("attributes"))
+		return;
+
+	const json& attrs = enemyData["attributes"];
+	ReadOverride<int>(attrs, "maxHp", inout.maxHp);
+	ReadOverride<int>(attrs, "atk", inout.atk);
+	ReadOverride<int>(attrs, "def", inout.def);
+	ReadOverride<double>(attrs, "moveSpeed", inout.moveSpeed);
+	ReadOverride<double>(attrs, "baseAttackTime", inout.baseAttackTime);
+
+	double resistance = -1.0;
+	ReadOverride<double>(attrs, "magicResistance", resistance);
+	if (resistance >= 0.0)
+		inout.magicResistance = NormalizeResistance(resistance);
+}
+
+bool ParseOperatorStats(const json& op, OperatorStats& out, int phase, int level)
+{
+	if (!op.contains("charId") || !op.contains("phases") || op["phases"].empty())
+		return false;
+
+	try
+	{
+		OperatorAttributeCurve curve;
+		AttributeBlock data;
+		if (!OperatorAttributeCurve::FromJson(op, curve) || !curve.Evaluate(phase, level, data))
+			return false;
+
+		out.charId = op["charId"].get<std::string>();
+		out.name = op.value("name", out.charId);
+		out.profession = op.value("profession", "CASTER");
+		out.position = op.value("position", "RANGED");
+		out.rarity = op.value("rarity", 3);
+		out.maxHp = (int)std::lround(data[AttributeField::MaxHp]);
+		out.atk = (int)std::lround(data[AttributeField::Atk]);
+		out.def = (int)std::lround(data[AttributeField::Def]);
+		out.magicResistance = NormalizeResistance(data[AttributeField::MagicResistance]);
+		out.cost = (int)std::lround(data[AttributeField::Cost]);
+		out.blockCnt = (int)std::lround(data[AttributeField::BlockCnt]);
+		out.baseAttackTime = data[AttributeField::BaseAttackTime] > 0.0 ? data[AttributeField::BaseAttackTime] : 1.0;
+		out.respawnTime = (int)std::lround(data[AttributeField::RespawnTime]);
+
+		out.range.clear();
+		if (op.contains("range"))
+		{
+			for (const auto& cell : op["range"])
+			{
+				out.range.push_back({ cell.value("row", 0), cell.value("col", 0) });
+			}
+		}
+
+		out.skillIds.clear();
+		if (op.contains("skillIds"))
+		{
+			for (const auto& skillId : op["skillIds"])
+			{
+				out.skillIds.push_back(skillId.get<std::string>());
+			}
+		}
+	}
+	catch (const json::exception& e)
+	{
+		std::cout << "[Tables] Invalid operator entry: " << e.what() << "\n";
+		return false;
+	}
+
+	return true;
+}
+
+std::vector<EnemyStats> ParseEnemyTable(const json& table)
+{
+	std::vector<EnemyStats> enemies;
+
+	if (!table.contains("enemies") || !table["enemies"].is_array())
+		return enemies;
+
+	enemies.reserve(table["enemies"].size());
+	for (const auto& enemy : table["enemies"])
+	{
+		EnemyStats stats;
+		if (ParseEnemyStats(enemy, stats))
+		{
+			enemies.push_back(std::move(stats));
+		}
+	}
+
+	return enemies;
+}
+
+std::vector<OperatorStats> ParseOperatorTable(const json& table, int phase, int level)
+{
+	std::vector<OperatorStats> operators;
+
+	if (!table.contains("operators") || !table["operators"].is_array())
+		return operators;
+
+	operators.reserve(table["operators"].size());
+	for (const auto& op : table["operators"])
+	{
+		OperatorStats stats;
+		if (ParseOperatorStats(op, stats, phase, level))
+		{
+			operators.push_back(std::move(stats));
+		}
+	}
+
+	return operators;
+}
+
+GridOffset RotateOffset(const GridOffset& offset, Direction dir)
+{
+	// Right 기준 범위를 반시계 방향으로 회전
+	switch (dir)
+	{
+	case Direction::Up:		return { offset.col, -offset.row };
+	case Direction::Left:	return { -offset.row, -offset.col };
+	case Direction::Down:	return { -offset.col, offset.row };
+	case Direction::Right:
+	default:				return offset;
+	}
+}
+
+Direction StringToDirection(const std::string& str)
+{
+	if (str == "UP") return Direction::Up;
+	if (str == "LEFT") return Direction::Left;
+	if (str == "DOWN") return Direction::Down;
+	return Direction::Right;
+}
+
+const char* DirectionToString(Direction dir)
+{
+	switch (dir)
+	{
+	case Direction::Up: return "UP";
+	case Direction::Left: return "LEFT";
+	case Direction::Down: return "DOWN";
+	case Direction::Right:
+	default: return "RIGHT";
+	}
+}
@@ -0,0 +1,85 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::ordered_json;
+
+// 오퍼레이터 기준 상대 좌표 (row는 위쪽이 +, col은 오른쪽이 +)
+struct GridOffset
+{
+	int row = 0;
+	int col = 0;
+};
+
+// 오퍼레이터 방향 (범위는 Right 기준으로 저장됨)
+enum class Direction
+{
+	Right = 0,
+	Up,
+	Left,
+	Down,
+	MAX
+};
+
+// enemies_table.json 의 value[level] 을 평탄화한 스탯 (value[0] 이 기본값)
+struct EnemyStats
+{
+	std::string key;
+	std::string name;
+	int level = 0;
+	bool isFlying = false;
+	int maxHp = 0;
+	int atk = 0;
+	int def = 0;
+	double magicResistance = 0.0;	// 0.0 ~ 1.0
+	double moveSpeed = 1.0;
+	double baseAttackTime = 1.0;
+	double rangeRadius = -1.0;		// -1 = 근거리
+	int lifePointReduce = 1;
+};
+
+// 오퍼레이터 스탯을 읽을 정예화 단계 / 레벨 (phases[].attributesKeyFrames[] 곡선에서 평가)
+constexpr int LAST_PHASE = -1;		// 키프레임이 있는 마지막 정예화 단계
+constexpr int MAX_LEVEL = -1;		// 그 단계의 마지막 키프레임 레벨
+
+// operators_table.json 의 한 (정예화, 레벨) 스탯을 평탄화한 것
+struct OperatorStats
+{
+	std::string charId;
+	std::string name;
+	std::string profession;
+	std::string position;
+	int rarity = 3;
+	int maxHp = 0;
+	int atk = 0;
+	int def = 0;
+	double magicResistance = 0.0;	// 0.0 ~ 1.0
+	int cost = 0;
+	int blockCnt = 0;
+	double baseAttackTime = 1.0;
+	int respawnTime = 0;
+	std::vector<GridOffset> range;
+	std::vector<std::string> skillIds;
+
+	bool IsMelee() const { return position == "MELEE"; }
+	bool IsHealer() const { return profession == "MEDIC"; }
+	bool DealsArtsDamage() const { return profession == "CASTER" || profession == "SUPPORTER"; }
+};
+
+// 파일 로드 (실패 시 false, 로그 출력)
+bool LoadJsonFile(const std::string& path, json& out);
+
+// 테이블 파싱
+bool ParseEnemyStats(const json& enemy, EnemyStats& out);
+// 레벨 변형의 enemyData 에서 m_defined 가 true 인 필드만 덮어씀 (나머지는 inout 값 유지)
+void ApplyEnemyOverrides(const json& enemyData, EnemyStats& inout);
+// 기본은 마지막 정예화의 최대 레벨 (시뮬레이터/솔버/분석 창이 모두 같은 기준)
+bool ParseOperatorStats(const json& op, OperatorStats& out, int phase = LAST_PHASE, int level = MAX_LEVEL);
+std::vector<EnemyStats> ParseEnemyTable(const json& table);
+std::vector<OperatorStats> ParseOperatorTable(const json& table, int phase = LAST_PHASE, int level = MAX_LEVEL);
+
+// 범위 회전
+GridOffset RotateOffset(const GridOffset& offset, Direction dir);
+Direction StringToDirection(const std::string& str);
+const char* DirectionToString(Direction dir);
@@ -0,0 +1,309 @@
+﻿#include "IntegrityChecker.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+	std::string ActionLocation(int wave, int fragment, int action)
+	{
+		return "waves[" + std::to_string(wave) + "].fragments[" + std::to_string(fragment) +
+			"].actions[" + std::to_string(action) + "]";
+	}
+}
+
+const char* IntegrityCategoryName(IntegrityCategory category)
+{
+	switch (category)
+	{
+	case IntegrityCategory::EnemyKey: return "적 키";
+	case IntegrityCategory::RouteIndex: return "경로 번호";
+	case IntegrityCategory::SkillOperator: return "스킬 -> 오퍼레이터";
+	case IntegrityCategory::OperatorSkill: return "오퍼레이터 -> 스킬";
+	default: return "";
+	}
+}
+
+void IntegrityChecker::Invalidate()
+{
+	_valid = false;
+	_levelResults.clear();
+}
+
+bool IntegrityChecker::Update(const IntegrityInput& input)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	bool enemiesChanged = !_valid || input.enemyRevision != _enemyRevision;
+	bool usageChanged = !_valid || (input.usage != nullptr) != _hasUsage ||
+		(input.usage && input.usage->GetRevision() != _usageRevision);
+	bool skillsChanged = !_valid || input.skillRevision != _skillRevision || input.operatorRevision != _operatorRevision;
+
+	// revision 이 바뀐 레벨만 골라 병렬로 검사
+	std::vector<int> stale;
+	std::unordered_set<uint64_t> liveRevisions;
+	liveRevisions.reserve(input.levels.size());
+	for (int i = 0; i < (int)input.levels.size(); ++i)
+	{
+		const IntegrityLevel& level = input.levels[i];
+		liveRevisions.insert(level.revision);
+
+		if (!_levelResults.count(level.revision))
+			stale.push_back(i);
+	}
+
+	// 목록에서 사라졌거나 수정 전 상태인 레벨 결과
+	bool levelsRemoved = false;
+	for (auto it = _levelResults.begin(); it != _levelResults.end();)
+	{
+		if (!liveRevisions.count(it->first))
+		{
+			it = _levelResults.erase(it);
+			levelsRemoved = true;
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	if (!enemiesChanged && !usageChanged && !skillsChanged && stale.empty() && !levelsRemoved)
+	{
+		_lastUpdateMs = 0.0;
+		_lastLevelsChecked = 0;
+		_lastCheckedKeys = false;
+		_lastCheckedSkills = false;
+		return false;
+	}
+
+	if (enemiesChanged)
+	{
+		_enemyKeys.clear();
+		if (input.enemies && input.enemies->is_array())
+		{
+			_enemyKeys.reserve(input.enemies->size());
+			for (const auto& enemy : *input.enemies)
+			{
+				auto key = enemy.find("key");
+				if (key != enemy.end() && key->is_string())
+					_enemyKeys.insert(key->get<std::string>());
+			}
+		}
+		_enemyRevision = input.enemyRevision;
+	}
+
+	_lastCheckedKeys = enemiesChanged || usageChanged;
+	if (_lastCheckedKeys)
+	{
+		CheckEnemyKeys(input);
+		_hasUsage = input.usage != nullptr;
+		_usageRevision = input.usage ? input.usage->GetRevision() : 0;
+	}
+
+	_lastCheckedSkills = skillsChanged;
+	if (skillsChanged)
+	{
+		CheckSkills(input);
+		_skillRevision = input.skillRevision;
+		_operatorRevision = input.operatorRevision;
+	}
+
+	std::vector<std::vector<IntegrityIssue>> results(stale.size());
+	ParallelFor(stale.size(), 8, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t i = begin; i < end; ++i)
+				CheckLevelRoutes(input.levels[stale[i]], results[i]);
+		});
+
+	for (size_t i = 0; i < stale.size(); ++i)
+		_levelResults[input.levels[stale[i]].revision] = std::move(results[i]);
+
+	_lastLevelsChecked = (int)stale.size();
+	_valid = true;
+
+	Collect(input);
+
+	_lastUpdateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return true;
+}
+
+void IntegrityChecker::CheckEnemyKeys(const IntegrityInput& input)
+{
+	_keyIssues.clear();
+	if (!input.usage)
+		return;
+
+	input.usage->ForEachKey([&](const std::string& key, const std::vector<EnemyUsage>& usages)
+		{
+			if (_enemyKeys.count(key))
+				return;
+
+			for (const auto& usage : usages)
+			{
+				IntegrityIssue issue;
+				issue.severity = IntegritySeverity::Error;
+				issue.category = IntegrityCategory::EnemyKey;
+				issue.source = input.usage->LevelId(usage.level);
+				issue.location = ActionLocation(usage.wave, usage.fragment, usage.action);
+				issue.message = "적 '" + key + "' 이(가) enemies_table 에 없습니다";
+				_keyIssues.push_back(std::move(issue));
+			}
+		});
+}
+
+void IntegrityChecker::CheckLevelRoutes(const IntegrityLevel& level, std::vector<IntegrityIssue>& out)
+{
+	if (!level.data)
+		return;
+
+	const json& data = *level.data;
+	auto routes = data.find("routes");
+	int routeCount = (routes != data.end() && routes->is_array()) ? (int)routes->size() : 0;
+
+	auto waves = data.find("waves");
+	if (waves == data.end() || !waves->is_array())
+		return;
+
+	for (int w = 0; w < (int)waves->size(); ++w)
+	{
+		const json& wave = (*waves)[w];
+		auto fragments = wave.find("fragments");
+		if (fragments == wave.end() || !fragments->is_array())
+			continue;
+
+		for (int f = 0; f < (int)fragments->size(); ++f)
+		{
+			const json& fragment = (*fragments)[f];
+			auto actions = fragment.find("actions");
+			if (actions == fragment.end() || !actions->is_array())
+				continue;
+
+			for (int a = 0; a < (int)actions->size(); ++a)
+			{
+				const json& action = (*actions)[a];
+				auto route = action.find("routeIndex");
+				if (route == action.end() || !route->is_number_integer())
+					continue;
+
+				int routeIndex = route->get<int>();
+				if (routeIndex >= 0 && routeIndex < routeCount)
+					continue;
+
+				IntegrityIssue issue;
+				issue.severity = IntegritySeverity::Error;
+				issue.category = IntegrityCategory::RouteIndex;
+				issue.source = level.levelId;
+				issue.location = ActionLocation(w, f, a);
+				issue.message = "routeIndex " + std::to_string(routeIndex) + " 이(가) 경로 범위 [0, " +
+					std::to_string(routeCount) + ") 밖입니다";
+				out.push_back(std::move(issue));
+			}
+		}
+	}
+}
+
+void IntegrityChecker::CheckSkills(const IntegrityInput& input)
+{
+	_skillIssues.clear();
+
+	// skillId -> 스킬, charId 집합
+	std::unordered_map<std::string, const Skill*> skillById;
+	if (input.skills)
+	{
+		skillById.reserve(input.skills->size());
+		for (const auto& skill : *input.skills)
+			skillById.emplace(skill.skillId, &skill);
+	}
+
+	std::unordered_set<std::string> charIds;
+	std::unordered_set<std::string> listed;		// "charId\nskillId"
+	if (input.operators && input.operators->is_array())
+	{
+		charIds.reserve(input.operators->size());
+		for (const auto& op : *input.operators)
+		{
+			std::string charId = op.value("charId", "");
+			charIds.insert(charId);
+
+			auto skillIds = op.find("skillIds");
+			if (skillIds == op.end() || !skillIds->is_array())
+				continue;
+
+			for (int i = 0; i < (int)skillIds->size(); ++i)
+			{
+				if (!(*skillIds)[i].is_string())
+					continue;
+
+				std::string skillId = (*skillIds)[i].get<std::string>();
+				listed.insert(charId + '\n' + skillId);
+
+				IntegrityIssue issue;
+				issue.severity = IntegritySeverity::Error;
+				issue.category = IntegrityCategory::OperatorSkill;
+				issue.source = charId;
+				issue.location = "skillIds[" + std::to_string(i) + "]";
+
+				auto it = skillById.find(skillId);
+				if (it == skillById.end())
+				{
+					issue.message = "스킬 '" + skillId + "' 이(가) skills_table 에 없습니다";
+					_skillIssues.push_back(std::move(issue));
+				}
+				else if (it->second->operatorId != charId)
+				{
+					issue.message = "스킬 '" + skillId + "' 의 operatorId 가 '" + it->second->operatorId + "' 입니다";
+					_skillIssues.push_back(std::move(issue));
+				}
+			}
+		}
+	}
+
+	if (!input.skills)
+		return;
+
+	for (const auto& skill : *input.skills)
+	{
+		IntegrityIssue issue;
+		issue.category = IntegrityCategory::SkillOperator;
+		issue.source = skill.skillId;
+		issue.location = "operatorId";
+
+		if (!charIds.count(skill.operatorId))
+		{
+			issue.severity = IntegritySeverity::Error;
+			issue.message = "오퍼레이터 '" + skill.operatorId + "' 이(가) operators_table 에 없습니다";
+			_skillIssues.push_back(std::move(issue));
+		}
+		else if (!listed.count(skill.operatorId + '\n' + skill.skillId))
+		{
+			// 스킬 저장 시 skillIds 가 다시 채워지므로 경고
+			issue.severity = IntegritySeverity::Warning;
+			issue.message = "오퍼레이터 '" + skill.operatorId + "' 의 skillIds 에 없습니다 (스킬 저장 시 갱신)";
+			_skillIssues.push_back(std::move(issue));
+		}
+	}
+}
+
+void IntegrityChecker::Collect(const IntegrityInput& input)
+{
+	_issues.clear();
+	_issues.insert(_issues.end(), _keyIssues.begin(), _keyIssues.end());
+
+	// 레벨 목록 순서대로
+	for (const auto& level : input.levels)
+	{
+		auto it = _levelResults.find(level.revision);
+		if (it != _levelResults.end())
+			_issues.insert(_issues.end(), it->second.begin(), it->second.end());
+	}
+
+	_issues.insert(_issues.end(), _skillIssues.begin(), _skillIssues.end());
+
+	_errorCount = 0;
+	std::fill(std::begin(_categoryCounts), std::end(_categoryCounts), 0);
+	for (const auto& issue : _issues)
+	{
+		_errorCount += issue.severity == IntegritySeverity::Error;
+		++_categoryCounts[(int)issue.category];
+	}
+}
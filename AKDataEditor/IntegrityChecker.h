@@ -0,0 +1,109 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <nlohmann/json.hpp>
+
+#include "Skill.h"
+#include "EnemyUsageIndex.h"
+
+using json = nlohmann::ordered_json;
+
+enum class IntegritySeverity
+{
+	Error = 0,
+	Warning,
+};
+
+enum class IntegrityCategory
+{
+	EnemyKey = 0,		// 레벨 action.key -> enemies_table
+	RouteIndex,			// action.routeIndex -> 같은 레벨 routes[]
+	SkillOperator,		// Skill::operatorId -> operators_table
+	OperatorSkill,		// operator.skillIds[] <-> skills_table
+	MAX
+};
+
+const char* IntegrityCategoryName(IntegrityCategory category);
+
+struct IntegrityIssue
+{
+	IntegritySeverity severity = IntegritySeverity::Error;
+	IntegrityCategory category = IntegrityCategory::EnemyKey;
+	std::string source;		// levelId / skillId / charId
+	std::string location;	// waves[0].fragments[2].actions[5] 등
+	std::string message;
+};
+
+// 레벨 하나 (revision 은 내용이 바뀔 때마다 전역에서 겹치지 않는 새 값, 같으면 이전 검사 결과를 그대로 씀)
+struct IntegrityLevel
+{
+	std::string levelId;
+	const json* data = nullptr;
+	uint64_t revision = 0;
+};
+
+// 검사 대상 (각 편집기의 데이터와 revision)
+struct IntegrityInput
+{
+	const json* enemies = nullptr;			// enemies[]
+	uint64_t enemyRevision = 0;
+	const json* operators = nullptr;		// operators[]
+	uint64_t operatorRevision = 0;
+	const std::vector<Skill>* skills = nullptr;
+	uint64_t skillRevision = 0;
+	std::vector<IntegrityLevel> levels;
+	const EnemyUsageIndex* usage = nullptr;	// 레벨 -> 적 키 역색인
+};
+
+// 파일 사이 참조 검사
+// 처음에는 모든 레벨을 병렬로 검사하고, 이후에는 revision 이 바뀐 부분만 다시 검사
+//   적 키     : 역색인의 서로 다른 키만 적 키 해시 집합에서 찾음 (action 수가 아니라 키 수에 비례)
+//   경로 번호 : revision 이 바뀐 레벨만 다시 훑음
+//   스킬/오퍼 : 둘 중 하나가 바뀌면 charId / skillId 해시 집합으로 다시 맞춰 봄
+class IntegrityChecker
+{
+public:
+	// 바뀐 부분이 있으면 다시 검사하고 true
+	bool Update(const IntegrityInput& input);
+	void Invalidate();		// 다음 Update 에서 전부 다시 검사
+
+	const std::vector<IntegrityIssue>& Issues() const { return _issues; }
+	int ErrorCount() const { return _errorCount; }
+	int CategoryCount(IntegrityCategory category) const { return _categoryCounts[(int)category]; }
+
+	// 마지막 Update 통계
+	double LastUpdateMs() const { return _lastUpdateMs; }
+	int LastLevelsChecked() const { return _lastLevelsChecked; }
+	bool LastCheckedKeys() const { return _lastCheckedKeys; }
+	bool LastCheckedSkills() const { return _lastCheckedSkills; }
+
+private:
+	std::unordered_set<std::string> _enemyKeys;
+	uint64_t _enemyRevision = 0;
+	uint64_t _usageRevision = 0;
+	bool _hasUsage = false;
+	uint64_t _operatorRevision = 0;
+	uint64_t _skillRevision = 0;
+	bool _valid = false;
+
+	std::vector<IntegrityIssue> _keyIssues;
+	std::vector<IntegrityIssue> _skillIssues;
+	std::unordered_map<uint64_t, std::vector<IntegrityIssue>> _levelResults;	// 레벨 revision -> 경로 검사 결과
+
+	std::vector<IntegrityIssue> _issues;	// 위 결과를 합친 것 (표시용)
+	int _errorCount = 0;
+	int _categoryCounts[(int)IntegrityCategory::MAX] = {};
+
+	double _lastUpdateMs = 0.0;
+	int _lastLevelsChecked = 0;
+	bool _lastCheckedKeys = false;
+	bool _lastCheckedSkills = false;
+
+	void CheckEnemyKeys(const IntegrityInput& input);
+	void CheckSkills(const IntegrityInput& input);
+	static void CheckLevelRoutes(const IntegrityLevel& level, std::vector<IntegrityIssue>& out);
+	void Collect(const IntegrityInput& input);
+};
@@ -0,0 +1,155 @@
+﻿#include "IntegrityWindow.h"
+#include "EnemyEditor.h"
+#include "OperatorEditor.h"
+#include "SkillEditor.h"
+#include "LevelEditor.h"
+#include <imgui/imgui.h>
+
+#include "Utility.h"
+
+IntegrityInput IntegrityWindow::BuildInput(EnemyEditor& enemyEditor, OperatorEditor& operatorEditor, SkillEditor& skillEditor, LevelEditor& levelEditor) const
+{
+	IntegrityInput input;
+
+	const json& enemyData = enemyEditor.GetEnemyData();
+	auto enemies = enemyData.find("enemies");
+	input.enemies = (enemies != enemyData.end()) ? &*enemies : nullptr;
+	input.enemyRevision = enemyEditor.GetRevision();
+
+	const json& operatorData = operatorEditor.GetOperatorData();
+	auto operators = operatorData.find("operators");
+	input.operators = (operators != operatorData.end()) ? &*operators : nullptr;
+	input.operatorRevision = operatorEditor.GetRevision();
+
+	input.skills = &skillEditor.GetSkills();
+	input.skillRevision = skillEditor.GetRevision();
+
+	input.levels.resize(levelEditor.GetLevelCount());
+	for (int i = 0; i < levelEditor.GetLevelCount(); ++i)
+	{
+		input.levels[i].levelId = levelEditor.GetLevelId(i);
+		input.levels[i].data = &levelEditor.GetLevelData(i);
+		input.levels[i].revision = levelEditor.GetLevelRevision(i);
+	}
+	input.usage = &levelEditor.GetEnemyUsage();
+
+	return input;
+}
+
+void IntegrityWindow::RenderGUI(bool* p_open, EnemyEditor& enemyEditor, OperatorEditor& operatorEditor, SkillEditor& skillEditor, LevelEditor& levelEditor)
+{
+	if (_checker.Update(BuildInput(enemyEditor, operatorEditor, skillEditor, levelEditor)))
+	{
+		_lastCheckMs = _checker.LastUpdateMs();
+		_lastLevelsChecked = _checker.LastLevelsChecked();
+
+		_lastCheckScope.clear();
+		if (_checker.LastCheckedKeys())
+			_lastCheckScope += " 적 키";
+		if (_checker.LastCheckedSkills())
+			_lastCheckScope += " 스킬/오퍼레이터";
+
+		_visibleDirty = true;
+	}
+
+	if (_visibleDirty)
+		RebuildVisible();
+
+	ImGui::SetNextWindowSize(ImVec2(900, 500), ImGuiCond_FirstUseEver);
+	ImGui::Begin("참조 무결성", p_open);
+
+	const auto& issues = _checker.Issues();
+	if (_checker.ErrorCount() > 0)
+		ImGui::TextColored(COLOR_RED, "오류 %d개", _checker.ErrorCount());
+	else
+		ImGui::TextColored(COLOR_GREEN, "오류 없음");
+	ImGui::SameLine();
+	ImGui::Text("/ 경고 %d개", (int)issues.size() - _checker.ErrorCount());
+
+	ImGui::SameLine();
+	ImGui::TextColored(COLOR_GRAY, "| 마지막 검사 %.2f ms (레벨 %d개%s)", _lastCheckMs, _lastLevelsChecked, _lastCheckScope.c_str());
+
+	ImGui::SameLine();
+	if (ImGui::SmallButton("전체 다시 검사"))
+		_checker.Invalidate();
+
+	// 분류 필터
+	for (int c = 0; c < (int)IntegrityCategory::MAX; ++c)
+	{
+		if (c > 0)
+			ImGui::SameLine();
+
+		char label[64];
+		snprintf(label, sizeof(label), "%s (%d)", IntegrityCategoryName((IntegrityCategory)c), _checker.CategoryCount((IntegrityCategory)c));
+		_visibleDirty |= ImGui::Checkbox(label, &_showCategory[c]);
+	}
+	ImGui::SameLine();
+	_visibleDirty |= ImGui::Checkbox("경고 표시", &_showWarnings);
+
+	ImGui::Separator();
+
+	if (_visible.empty())
+	{
+		ImGui::TextColored(COLOR_GREEN, "표시할 문제가 없습니다.");
+		ImGui::End();
+		return;
+	}
+
+	ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+	if (ImGui::BeginTable("IntegrityTable", 5, flags))
+	{
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("심각도", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+		ImGui::TableSetupColumn("분류", ImGuiTableColumnFlags_WidthFixed, 130.0f);
+		ImGui::TableSetupColumn("대상", ImGuiTableColumnFlags_WidthFixed, 120.0f);
+		ImGui::TableSetupColumn("위치", ImGuiTableColumnFlags_WidthFixed, 220.0f);
+		ImGui::TableSetupColumn("내용");
+		ImGui::TableHeadersRow();
+
+		ImGuiListClipper clipper;
+		clipper.Begin((int)_visible.size());
+		while (clipper.Step())
+		{
+			for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+			{
+				const IntegrityIssue& issue = issues[_visible[i]];
+
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				if (issue.severity == IntegritySeverity::Error)
+					ImGui::TextColored(COLOR_RED, "오류");
+				else
+					ImGui::TextColored(COLOR_YELLOW, "경고");
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", IntegrityCategoryName(issue.category));
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", issue.source.c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", issue.location.c_str());
+				ImGui::TableNextColumn();
+				ImGui::TextWrapped("%s", issue.message.c_str());
+			}
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
+void IntegrityWindow::RebuildVisible()
+{
+	_visible.clear();
+
+	const auto& issues = _checker.Issues();
+	for (int i = 0; i < (int)issues.size(); ++i)
+	{
+		const IntegrityIssue& issue = issues[i];
+		if (!_showCategory[(int)issue.category])
+			continue;
+		if (!_showWarnings && issue.severity == IntegritySeverity::Warning)
+			continue;
+		_visible.push_back(i);
+	}
+
+	_visibleDirty = false;
+}
@@ -0,0 +1,34 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+
+#include "IntegrityChecker.h"
+
+class EnemyEditor;
+class OperatorEditor;
+class SkillEditor;
+class LevelEditor;
+
+// 파일 사이 참조 무결성 패널
+// 매 프레임 각 편집기의 revision 만 비교하고, 바뀐 부분만 다시 검사
+class IntegrityWindow
+{
+public:
+	void RenderGUI(bool* p_open, EnemyEditor& enemyEditor, OperatorEditor& operatorEditor, SkillEditor& skillEditor, LevelEditor& levelEditor);
+
+private:
+	IntegrityChecker _checker;
+	bool _showCategory[(int)IntegrityCategory::MAX] = { true, true, true, true };
+	bool _showWarnings = true;
+
+	std::vector<int> _visible;		// 필터를 통과한 문제 인덱스
+	bool _visibleDirty = true;
+
+	// 마지막으로 실제 검사가 돌았을 때의 통계
+	double _lastCheckMs = 0.0;
+	int _lastLevelsChecked = 0;
+	std::string _lastCheckScope;
+
+	IntegrityInput BuildInput(EnemyEditor& enemyEditor, OperatorEditor& operatorEditor, SkillEditor& skillEditor, LevelEditor& levelEditor) const;
+	void RebuildVisible();
+};
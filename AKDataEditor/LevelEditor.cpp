@@ -1,13 +1,20 @@
 ﻿#include "LevelEditor.h"
+#include "EnemyEditor.h"
 #include "Migration.h"
+#include "DataFiles.h"
+#include "RangeTable.h"
+#include <unordered_set>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <sstream>
+#include <chrono>
 #include <imgui/imgui.h>
 #include <imgui/imgui_impl_win32.h>
 #include <imgui/imgui_impl_gdi.h>
 
 #include "Utility.h"
+#include "Parallel.h"
 #include "ImGuiRAII.h"
 
 namespace fs = std::filesystem;
@@ -16,15 +23,23 @@ LevelEditor::LevelEditor(std::string jsonPath, std::string solutionPath)
 	: _jsonPath(jsonPath)
 {
 	LoadLevels();
-	LoadEnemyTable(solutionPath);
+	LoadRangeSources(solutionPath);
 }
 
 LevelEditor::~LevelEditor()
 {
+	// 탐색 스레드가 솔버를 쓰는 중이면 멈추고 기다림
+	if (_solverTask.valid())
+	{
+		_solverProgress->Cancel();
+		_solverTask.wait();
+	}
 }
 
-void LevelEditor::RenderGUI(bool* p_open)
+void LevelEditor::RenderGUI(bool* p_open, const EnemyEditor& enemyEditor)
 {
+	SyncEnemyTable(enemyEditor);
+
 	ImGui::Begin("레벨 편집기", p_open);
 
 	RenderToolbar();
@@ -46,37 +61,532 @@ void LevelEditor::LoadLevels()
 
 	std::vector<std::string> levelFiles = GetLevelFiles();
 
+	_pristineLevels.clear();
+	_levelStamps.clear();
+
+	// 읽기/파싱/마이그레이션은 레벨마다 독립이므로 모든 코어에서 (파일 스탬프도 같이)
+	auto start = std::chrono::steady_clock::now();
+	std::vector<FileStamp> stamps(levelFiles.size());
+	_levels.resize(levelFiles.size());
+	ParallelFor(levelFiles.size(), 4, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				_levels[i] = LoadLevelFromFile(levelFiles[i]);
+				stamps[i] = FileStamp::Of(_jsonPath + "/" + levelFiles[i]);
+			}
+		});
+
+	int migrated = 0;
+	for (size_t i = 0; i < _levels.size(); ++i)
+	{
+		_pristineLevels[_levels[i].fileName] = nullptr;
+		_levelStamps[_levels[i].fileName] = std::move(stamps[i]);
+		migrated += _levels[i].isModified ? 1 : 0;
+	}
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	_levelSelection.Clear();
+	_routeSelection.Clear();
+	_fragmentSelection.Clear();
+	RebuildEnemyUsage();
+	ResetLevelHashes();
+
+	_undoTracker.Invalidate();
+	if (_history)
+		_history->Forget(this);
+
+	std::cout << "[Level] Loaded: " << _levels.size() << " levels (" << migrated << " migrated, " << ms << " ms)\n";
+}
+
+void LevelEditor::RebuildEnemyUsage()
+{
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<const json*> levels;
+	std::vector<std::string> levelIds;
+	levels.reserve(_levels.size());
+	levelIds.reserve(_levels.size());
+	for (const auto& level : _levels)
+	{
+		levels.push_back(&level.fullData);
+		levelIds.push_back(level.levelId);
+	}
+
+	_enemyUsage.Build(levels, levelIds);
+
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "[Level] Enemy usage index: " << _enemyUsage.KeyCount() << " keys (" << ms << " ms)\n";
+}
+
+LevelEditScope LevelEditScope::Of(const json::json_pointer& pointer)
+{
+	// "/routes/<i>/..." / "/waves/<w>/fragments/<f>/..." / "/options/..." / "/mapData/..."
+	std::vector<std::string> tokens;
+	json::json_pointer rest = pointer;
+	while (!rest.empty())
+	{
+		tokens.insert(tokens.begin(), rest.back());
+		rest.pop_back();
+	}
+
+	auto index = [&](size_t token)
+		{
+			if (token >= tokens.size() || tokens[token].empty()
+				|| !std::all_of(tokens[token].begin(), tokens[token].end(), [](char c) { return c >= '0' && c <= '9'; }))
+				return -1;
+			return std::stoi(tokens[token]);
+		};
+
+	if (tokens.empty())
+		return LevelEditScope();
+	if (tokens[0] == "options")
+		return Options();
+	if (tokens[0] == "mapData")
+		return Map();
+	if (tokens[0] == "routes" && tokens.size() >= 3 && index(1) >= 0)
+		return Route(index(1));
+	if (tokens[0] == "waves" && tokens.size() >= 5 && tokens[2] == "fragments" && index(1) >= 0 && index(3) >= 0)
+		return Fragment(index(1), index(3));
+	return LevelEditScope();
+}
+
+json::json_pointer LevelEditScope::Pointer() const
+{
+	switch (part)
+	{
+	case Part::Options: return json::json_pointer("/options");
+	case Part::Map: return json::json_pointer("/mapData");
+	case Part::Route: return json::json_pointer("/routes/" + std::to_string(route));
+	case Part::Fragment: return json::json_pointer("/waves/" + std::to_string(wave) + "/fragments/" + std::to_string(fragment));
+	case Part::Fragments: return json::json_pointer("/waves/" + std::to_string(wave) + "/fragments");
+	default: return json::json_pointer();
+	}
+}
+
+void LevelEditor::BeginLevelEdit(LevelData& level, const LevelEditScope& scope)
+{
+	PreserveLevel(level);
+
+	int index = (int)(&level - _levels.data());
+	if (scope.part == LevelEditScope::Part::Flags || !_history || _history->IsApplying() || index < 0 || index >= (int)_levels.size())
+		return;
+
+	// 고치기 직전의 해당 하위 트리만 되돌리기 기준으로 복사 (새로 생길 위치면 discarded)
+	json::json_pointer pointer = scope.Pointer();
+	json base = level.fullData.contains(pointer) ? level.fullData.at(pointer) : json(json::value_t::discarded);
+	_undoTracker.Reset(index, level.revision, pointer, std::move(base));
+}
+
+void LevelEditor::MarkLevelModified(LevelData& level, const LevelEditScope& scope)
+{
+	level.isModified = true;
+	level.revision = NextDataRevision();
+	_hasUnsavedChanges = true;
+
+	// 편집 중인 레벨이면 BeginLevelEdit 로 잡아 둔 하위 트리와 비교해 바뀐 필드만 기록
+	int index = (int)(&level - _levels.data());
+	if (index >= 0 && index < (int)_levels.size())
+	{
+		// 옵션은 LevelData 필드를 고친 뒤 여기서 fullData 로 옮기므로 옮기기 전이 기준
+		if (scope.part == LevelEditScope::Part::Options)
+			BeginLevelEdit(level, scope);
+
+		SyncOptionsToJson(level);
+		UpdateLevelHash(level, scope);
+		if (!_levelHashesDirty)
+			_levelHashes.Set(index, level.fileName, level.contentHash.root);
+		_changeSummaryDirty = true;
+
+		_undoTracker.Commit(_history, this, index, level.fullData, level.revision);
+		_undoTracker.Invalidate();
+	}
+}
+
+void LevelEditor::SyncOptionsToJson(LevelData& level)
+{
+	json& opts = level.fullData["options"];
+	opts["characterLimit"] = level.characterLimit;
+	opts["maxLifePoint"] = level.maxLifePoint;
+	opts["initialCost"] = level.initialCost;
+	opts["maxCost"] = level.maxCost;
+	opts["costIncreaseTime"] = Snap1(static_cast<double>(level.costIncreaseTime));
+}
+
+void LevelEditor::SyncOptionsFromJson(LevelData& level)
+{
+	if (!level.fullData.contains("options"))
+		return;
+
+	auto& opts = level.fullData["options"];
+	level.characterLimit = opts.value("characterLimit", 8);
+	level.maxLifePoint = opts.value("maxLifePoint", 3);
+	level.initialCost = opts.value("initialCost", 10);
+	level.maxCost = opts.value("maxCost", 99);
+	level.costIncreaseTime = opts.value("costIncreaseTime", 1.0f);
+}
+
+void LevelEditor::ClearLevelSubSelection()
+{
+	_selectedRouteIndex = -1;
+	_editingCheckpointIndex = -1;
+	_selectedFragmentIndex = -1;
+	_selectedActionIndex = -1;
+	_routeSelection.Clear();
+	_fragmentSelection.Clear();
+}
+
+void LevelEditor::CaptureLevel(const LevelData& level)
+{
+	// 지금 레벨이 저장된 상태 (사본은 다음에 처음 고칠 때 PreserveLevel 이 만듦)
+	_pristineLevels[level.fileName] = nullptr;
+	_levelStamps[level.fileName] = FileStamp::Of(_jsonPath + "/" + level.fileName);
+}
+
+void LevelEditor::PreserveLevel(const LevelData& level)
+{
+	// 저장된 뒤 처음 고치기 직전: 이때의 레벨이 저장된 상태
+	auto it = _pristineLevels.find(level.fileName);
+	if (it != _pristineLevels.end() && !it->second)
+		it->second = std::make_unique<LevelData>(level);
+}
+
+void LevelEditor::UpdateLevelHash(LevelData& level, const LevelEditScope& scope)
+{
+	// fullData 밖에서 저장되는 값은 편집기 완성 상태뿐 (옵션은 SyncOptionsToJson 으로 fullData 에 있음)
+	uint64_t flags = (level.gridCompleted ? 1 : 0) | (level.routeCompleted ? 2 : 0) | (level.waveCompleted ? 4 : 0);
+
+	// 경로/Fragment 하나면 그 잎만, 옵션/맵이면 나머지 필드만 다시 해시 (구조가 바뀌었으면 전체)
+	bool updated = false;
+	switch (scope.part)
+	{
+	case LevelEditScope::Part::Route:
+		updated = RehashLevelRoute(level.contentHash, level.fullData, scope.route);
+		break;
+	case LevelEditScope::Part::Fragment:
+		updated = RehashLevelFragment(level.contentHash, level.fullData, scope.wave, scope.fragment);
+		break;
+	case LevelEditScope::Part::Options:
+	case LevelEditScope::Part::Map:
+		updated = RehashLevelRest(level.contentHash, level.fullData);
+		break;
+	case LevelEditScope::Part::Flags:
+		RehashLevelExtra(level.contentHash, flags);
+		updated = true;
+		break;
+	default:
+		break;
+	}
+
+	if (!updated)
+		level.contentHash = HashLevelContent(level.fullData, flags);
+}
+
+void LevelEditor::RefreshLevelHashes()
+{
+	if (!_levelHashesDirty)
+		return;
+
+	std::vector<std::string> keys(_levels.size());
+	std::vector<uint64_t> hashes(_levels.size());
+	for (size_t i = 0; i < _levels.size(); ++i)
+	{
+		keys[i] = _levels[i].fileName;
+		hashes[i] = _levels[i].contentHash.root;
+	}
+
+	_levelHashes.Build(std::move(keys), std::move(hashes));
+	_levelHashesDirty = false;
+}
+
+void LevelEditor::ResetLevelHashes()
+{
+	// 지금 레벨들이 파일과 같음 (읽기/되돌리기 직후), 마이그레이션했거나 읽지 못한 레벨만 파일과 다름
+	InvalidateLevelHashes();
+	RefreshLevelHashes();
+	_levelHashes.MarkSaved();
+	for (const auto& level : _levels)
+	{
+		if (level.isModified)
+			_levelHashes.SetSaved(level.fileName, 0);
+	}
+}
+
+bool LevelEditor::HasUnsavedChanges()
+{
+	if (!_hasUnsavedChanges)
+		return false;
+
+	RefreshLevelHashes();
+	return _levelHashes.IsDirty();
+}
+
+const RecordChangeSummary& LevelEditor::GetChangeSummary()
+{
+	if (!_changeSummaryDirty)
+		return _changeSummary;
+
+	RefreshLevelHashes();
+	_changeSummary = _levelHashes.Diff();
+	_changeSummaryDirty = false;
+
+	std::unordered_map<std::string, int> byFile;
+	for (size_t i = 0; i < _levels.size(); ++i)
+		byFile.emplace(_levels[i].fileName, (int)i);
+
+	// 바뀐 레벨은 저장된 사본과 경로/Fragment 해시를 비교해 몇 개가 다른지 붙임
+	auto countDiff = [](const std::vector<uint64_t>& a, const std::vector<uint64_t>& b)
+		{
+			size_t common = std::min(a.size(), b.size());
+			int count = (int)(std::max(a.size(), b.size()) - common);
+			for (size_t i = 0; i < common; ++i)
+				count += a[i] != b[i];
+			return count;
+		};
+
+	for (std::string& entry : _changeSummary.changed)
+	{
+		auto found = byFile.find(entry);
+		auto pristine = _pristineLevels.find(entry);
+		if (found == byFile.end() || pristine == _pristineLevels.end())
+			continue;
+
+		// 사본이 없으면 읽은 뒤 고치지 않은 레벨 (파일과 다른 것은 마이그레이션뿐)
+		const LevelContentHash& now = _levels[found->second].contentHash;
+		const LevelContentHash& saved = pristine->second ? pristine->second->contentHash : now;
+		int routes = countDiff(now.routes, saved.routes);
+		int fragments = countDiff(now.fragments, saved.fragments);
+
+		std::string detail;
+		if (now.root == saved.root)
+			detail = "마이그레이션";
+		else if (routes > 0 || fragments > 0)
+			detail = "경로 " + std::to_string(routes) + ", Fragment " + std::to_string(fragments);
+		else
+			detail = "옵션/맵";
+		entry = _levels[found->second].levelId + " (" + detail + ")";
+	}
+
+	for (std::string& entry : _changeSummary.added)
+		entry = ExtractLevelId(entry);
+	for (std::string& entry : _changeSummary.removed)
+		entry = ExtractLevelId(entry);
+
+	return _changeSummary;
+}
+
+void LevelEditor::DiscardChanges()
+{
+	int restored = 0;
+	std::vector<uint8_t> remove(_levels.size(), 0);
+	bool removing = false;
+
+	for (size_t i = 0; i < _levels.size(); ++i)
+	{
+		if (!_levels[i].isModified)
+			continue;
+
+		auto it = _pristineLevels.find(_levels[i].fileName);
+		if (it == _pristineLevels.end())
+		{
+			remove[i] = 1;		// 저장한 적 없는 새 레벨
+			removing = true;
+			continue;
+		}
+		if (!it->second)
+			continue;			// 읽은 뒤 고치지 않음 (마이그레이션만)
+
+		// 사본을 옮겨 오고 다음 편집 때 다시 만듦
+		// ImGui 가 사본을 만들기 전에 고친 옵션/그리드 필드는 fullData 에서 다시 읽음
+		_levels[i] = std::move(*it->second);
+		it->second.reset();
+		SyncOptionsFromJson(_levels[i]);
+		SyncGridFromJson(_levels[i]);
+		ReindexEnemyUsage((int)i);
+		if ((int)i == _selectedLevelIndex)
+			ClearLevelSubSelection();
+		++restored;
+	}
+
+	int removed = 0;
+	if (removing)
+	{
+		size_t before = _levels.size();
+		std::vector<int> remap = CompactRemove(_levels, remove);
+		_enemyUsage.RemapLevels(remap, _levels.size());
+		_selectedLevelIndex = RemapIndex(remap, _selectedLevelIndex);
+		if (_selectedLevelIndex < 0)
+		{
+			_showEditWindow = false;
+			ClearLevelSubSelection();
+		}
+		_deleteTargetIndex = -1;
+		_levelSelection.Remap(remap, _levels.size());
+		removed = (int)(before - _levels.size());
+	}
+
+	ResetLevelHashes();
+	_hasUnsavedChanges = false;
+
+	_undoTracker.Invalidate();
+	if (_history)
+		_history->Forget(this);
+
+	std::cout << "[Level] Changes discarded (" << restored << " restored, " << removed << " removed)\n";
+}
+
+void LevelEditor::RefreshFromDisk()
+{
+	DiscardChanges();
+
+	std::unordered_map<std::string, int> current;
+	for (size_t i = 0; i < _levels.size(); ++i)
+		current.emplace(_levels[i].fileName, (int)i);
+
+	bool hasSelection = _selectedLevelIndex >= 0 && _selectedLevelIndex < (int)_levels.size();
+	std::string selectedFile = hasSelection ? _levels[_selectedLevelIndex].fileName : "";
+
+	// 그대로인 파일은 메모리의 레벨을 옮겨 쓰고, 바뀌었거나 새로 생긴 파일만 다시 읽음
+	std::vector<std::string> levelFiles = GetLevelFiles();
+	std::vector<LevelData> levels;
+	levels.reserve(levelFiles.size());
+	int reloaded = 0;
+
 	for (const auto& fileName : levelFiles)
 	{
-		LevelData level = LoadLevelFromFile(fileName);
-		_levels.push_back(level);
+		auto found = current.find(fileName);
+		auto stamp = _levelStamps.find(fileName);
+		if (found != current.end() && stamp != _levelStamps.end() && stamp->second.Unchanged())
+		{
+			levels.push_back(std::move(_levels[found->second]));
+			continue;
+		}
+
+		levels.push_back(LoadLevelFromFile(fileName));
+		CaptureLevel(levels.back());
+		++reloaded;
+	}
+
+	bool sameList = reloaded == 0 && levels.size() == _levels.size();
+	for (size_t i = 0; sameList && i < levels.size(); ++i)
+		sameList = levels[i].fileName == _levels[i].fileName;
+
+	_levels = std::move(levels);
+
+	// 디스크에서 사라진 레벨의 사본은 버림
+	std::unordered_set<std::string> onDisk(levelFiles.begin(), levelFiles.end());
+	std::erase_if(_pristineLevels, [&](const auto& entry) { return !onDisk.count(entry.first); });
+	std::erase_if(_levelStamps, [&](const auto& entry) { return !onDisk.count(entry.first); });
+
+	if (!sameList)
+	{
+		_selectedLevelIndex = -1;
+		for (size_t i = 0; i < _levels.size(); ++i)
+		{
+			if (_levels[i].fileName == selectedFile)
+				_selectedLevelIndex = (int)i;
+		}
+		if (_selectedLevelIndex < 0)
+			_showEditWindow = false;
+
+		_levelSelection.Clear();
+		ClearLevelSubSelection();
+		RebuildEnemyUsage();
 	}
 
-	std::cout << "[Level] Loaded: " << _levels.size() << " levels.\n";
+	ResetLevelHashes();
+
+	std::cout << "[Level] Refreshed: " << reloaded << " reloaded, " << (_levels.size() - reloaded) << " unchanged\n";
+}
+
+std::string LevelEditor::EditRecordLabel(int record) const
+{
+	return (record >= 0 && record < (int)_levels.size()) ? _levels[record].levelId : std::string();
+}
+
+std::string LevelEditor::EditRecordSource(int record) const
+{
+	return (record >= 0 && record < (int)_levels.size()) ? _levels[record].fileName : std::string();
+}
+
+uint64_t LevelEditor::EditSourceHash(const std::string& source) const
+{
+	// 새로 만들거나 복제해 아직 저장하지 않은 레벨은 스탬프가 없음
+	auto it = _levelStamps.find(source);
+	return it != _levelStamps.end() ? it->second.hash : 0;
+}
+
+void LevelEditor::SetRecordValue(int record, const json::json_pointer& pointer, const json& value)
+{
+	if (record < 0 || record >= (int)_levels.size())
+		return;
+
+	LevelData& level = _levels[record];
+	PreserveLevel(level);
+	SetJsonValue(level.fullData, pointer, value);
+
+	// fullData 에서 파생된 값만 다시 읽음
+	SyncOptionsFromJson(level);
+	SyncGridFromJson(level);
+	ReindexEnemyUsage(record);
+
+	// 경로/웨이브 선택은 가리키던 항목이 없어졌을 수 있으므로 해제
+	if (record == _selectedLevelIndex)
+		ClearLevelSubSelection();
+
+	MarkLevelModified(level, LevelEditScope::Of(pointer));
+}
+
+void LevelEditor::ReindexEnemyUsage(int levelIndex)
+{
+	if (levelIndex >= 0 && levelIndex < (int)_levels.size())
+		_enemyUsage.SetLevel(levelIndex, _levels[levelIndex].levelId, _levels[levelIndex].fullData);
 }
 
 void LevelEditor::SaveAllLevels()
 {
-	for (auto& level : _levels)
+	RefreshLevelHashes();
+
+	int written = 0;
+	int unchanged = 0;
+	for (size_t i = 0; i < _levels.size(); ++i)
 	{
-		if (level.isModified)
+		LevelData& level = _levels[i];
+		if (!level.isModified)
+			continue;
+
+		// 고쳤다가 원래대로 돌린 레벨은 해시가 저장된 것과 같으므로 파일을 다시 쓰지 않음
+		if (_levelHashes.IsRecordDirty((int)i))
 		{
 			SaveLevelToFile(level);
-			level.isModified = false;
+			++written;
+		}
+		else
+		{
+			++unchanged;
 		}
+		level.isModified = false;
+		CaptureLevel(level);
 	}
 
-	std::cout << "[Level] All levels saved.\n";
+	_levelHashes.MarkSaved();
+	_changeSummaryDirty = true;
 
+	std::cout << "[Level] All levels saved (" << written << " written, " << unchanged << " unchanged)\n";
+
+	if (_history)
+		_history->MarkSaved(this);
 }
 
 void LevelEditor::RenderToolbar()
 {
-	if (_hasUnsavedChanges)
+	if (HasUnsavedChanges())
 	{
 		ImGui::PushStyleColor(ImGuiCol_Text, COLOR_YELLOW);
 		ImGui::Text("* 저장되지 않은 변경사항");
 		ImGui::PopStyleColor();
+		if (ImGui::IsItemHovered())
+			RenderChangeSummaryTooltip(GetChangeSummary());
 
 		ImGui::SameLine();
 
@@ -89,7 +599,7 @@ void LevelEditor::RenderToolbar()
 
 		if (ImGui::Button("되돌리기"))
 		{
-			LoadLevels();  // 파일에서 다시 로드
+			DiscardChanges();  // 수정한 레벨만 저장된 사본에서 복사
 			_hasUnsavedChanges = false;
 			std::cout << "[Level] Changes discarded.\n";
 		}
@@ -115,7 +625,7 @@ void LevelEditor::RenderToolbar()
 
 	if (ImGui::Button("새로고침"))
 	{
-		LoadLevels();
+		RefreshFromDisk();
 		_hasUnsavedChanges = false;
 	}
 }
@@ -128,13 +638,32 @@ void LevelEditor::RenderLevelsList()
 		return;
 	}
 
+	_levelSelection.Resize(_levels.size());
+	RefreshLevelHashes();
+
+	switch (RenderBatchToolbar(_levelSelection, false))
+	{
+	case BatchAction::Delete:
+		_showBatchDeleteConfirm = true;
+		break;
+	case BatchAction::Duplicate:
+		DuplicateSelectedLevels();
+		break;
+	default:
+		break;
+	}
+
+	RenderLevelBatchPopups();
+
 	ImGuiTableFlags flags = ImGuiTableFlags_Borders |
 		ImGuiTableFlags_RowBg |
 		ImGuiTableFlags_Resizable |
 		ImGuiTableFlags_ScrollY;
 
-	if (ImGui::BeginTable("LevelTable", 6, flags))
+	if (ImGui::BeginTable("LevelTable", 7, flags))
 	{
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("##Select", ImGuiTableColumnFlags_WidthFixed, 24.0f);
 		ImGui::TableSetupColumn("ID", ImGuiTableColumnFlags_WidthFixed, 100.0f);
 		ImGui::TableSetupColumn("Grid Size", ImGuiTableColumnFlags_WidthFixed, 100.0f);
 		ImGui::TableSetupColumn("Init DP", ImGuiTableColumnFlags_WidthFixed, 80.0f);
@@ -153,6 +682,12 @@ void LevelEditor::RenderLevelsList()
 				: IM_COL32(40, 40, 40, 255);
 			ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg0, bg);
 
+			ImGui::PushID(index);
+
+			// 선택
+			ImGui::TableNextColumn();
+			SelectionCheckbox(_levelSelection, index);
+
 			// id
 			ImGui::TableNextColumn();
 			ImGui::Text("%s", level.levelId.c_str());
@@ -169,9 +704,9 @@ void LevelEditor::RenderLevelsList()
 			ImGui::TableNextColumn();
 			ImGui::Text("%d", level.maxLifePoint);
 
-			// state
+			// state (파일과 실제로 다른 레벨만)
 			ImGui::TableNextColumn();
-			if (level.isModified)
+			if (level.isModified && _levelHashes.IsRecordDirty(index))
 			{
 				ImGui::TextColored(COLOR_YELLOW, "수정됨");
 			}
@@ -183,9 +718,13 @@ void LevelEditor::RenderLevelsList()
 			// action;
 			ImGui::TableNextColumn();
 
-			ImGui::PushID(index);
 			if (ImGui::SmallButton("편집"))
 			{
+				if (_selectedLevelIndex != index)
+				{
+					_routeSelection.Clear();
+					_fragmentSelection.Clear();
+				}
 				_selectedLevelIndex = index;
 				_editMode = EditMode::Grid;  // 항상 그리드부터 시작
 				_editModeChanged = true;
@@ -235,10 +774,9 @@ void LevelEditor::RenderLevelsList()
 		{
 			if (_deleteTargetIndex >= 0 && _deleteTargetIndex < (int)_levels.size())
 			{
-				std::string filePath = _jsonPath + "/" + _levels[_deleteTargetIndex].fileName;
-				fs::remove(filePath);
-
-				_levels.erase(_levels.begin() + _deleteTargetIndex);
+				std::vector<uint8_t> remove(_levels.size(), 0);
+				remove[_deleteTargetIndex] = 1;
+				DeleteLevels(remove);
 				std::cout << "[Level] Deleted: " << _deleteTargetName << "\n";
 			}
 			_deleteTargetIndex = -1;
@@ -257,6 +795,136 @@ void LevelEditor::RenderLevelsList()
 	}
 }
 
+void LevelEditor::RenderLevelBatchPopups()
+{
+	if (_showBatchDeleteConfirm)
+	{
+		ImGui::OpenPopup("일괄 삭제 확인");
+		_showBatchDeleteConfirm = false;
+	}
+
+	if (ImGui::BeginPopupModal("일괄 삭제 확인", NULL, ImGuiWindowFlags_AlwaysAutoResize))
+	{
+		ImGui::TextColored(COLOR_RED, "선택한 레벨 %d개를 정말 삭제할까요?", _levelSelection.Count());
+		ImGui::Text("레벨 파일도 함께 삭제됩니다.");
+		ImGui::Separator();
+
+		// 앞쪽 몇 개만 표시
+		int shown = 0;
+		for (int index : _levelSelection.Indices())
+		{
+			if (shown++ == 10)
+			{
+				ImGui::TextColored(COLOR_GRAY, "... 외 %d개", _levelSelection.Count() - 10);
+				break;
+			}
+			ImGui::TextColored(COLOR_YELLOW, "%s", _levels[index].levelId.c_str());
+		}
+
+		ImGui::Separator();
+
+		if (ImGui::Button("예", ImVec2(120, 0)))
+		{
+			DeleteLevels(_levelSelection.Flags());
+			ImGui::CloseCurrentPopup();
+		}
+
+		ImGui::SameLine();
+
+		if (ImGui::Button("아니요", ImVec2(120, 0)))
+		{
+			ImGui::CloseCurrentPopup();
+		}
+
+		ImGui::EndPopup();
+	}
+}
+
+void LevelEditor::DeleteLevels(const std::vector<uint8_t>& remove)
+{
+	auto start = std::chrono::steady_clock::now();
+	size_t before = _levels.size();
+	std::vector<std::string> removedFiles;
+
+	for (size_t i = 0; i < _levels.size() && i < remove.size(); ++i)
+	{
+		if (!remove[i])
+			continue;
+
+		removedFiles.push_back(_levels[i].fileName);
+		fs::remove(_jsonPath + "/" + _levels[i].fileName);
+		_pristineLevels.erase(_levels[i].fileName);
+		_levelStamps.erase(_levels[i].fileName);
+		_levelHashes.DropSaved(_levels[i].fileName);
+	}
+	InvalidateLevelHashes();
+
+	std::vector<int> remap = CompactRemove(_levels, remove);
+	_enemyUsage.RemapLevels(remap, _levels.size());
+
+	_selectedLevelIndex = RemapIndex(remap, _selectedLevelIndex);
+	if (_selectedLevelIndex < 0)
+	{
+		_showEditWindow = false;
+		_routeSelection.Clear();
+		_fragmentSelection.Clear();
+	}
+	_deleteTargetIndex = -1;
+	_levelSelection.Remap(remap, _levels.size());
+
+	// 파일까지 지우므로 레벨 삭제는 되돌리지 않음 (인덱스가 바뀐 기록도 버림)
+	// 저널은 레벨 id 로 다시 찾으므로 지운 레벨 파일의 편집만 버림
+	_undoTracker.Invalidate();
+	if (_history)
+		_history->ForgetSteps(this, removedFiles);
+
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "[Level] Deleted " << (before - _levels.size()) << " levels (" << ms << " ms)\n";
+}
+
+void LevelEditor::DuplicateSelectedLevels()
+{
+	std::unordered_set<std::string> usedIds;
+	for (const auto& level : _levels)
+		usedIds.insert(level.levelId);
+
+	std::vector<int> remap = DuplicateSelected(_levels, _levelSelection.Flags(), [&](const LevelData& level)
+		{
+			LevelData copy = level;
+			copy.levelId = MakeUniqueKey(level.levelId, usedIds);
+			copy.fileName = FormatLevelFileName(copy.levelId);
+			copy.isModified = true;
+			copy.revision = NextDataRevision();
+			return copy;
+		});
+
+	// 새로 만든 복제본을 선택하고 색인에 추가
+	_enemyUsage.RemapLevels(remap, _levels.size());
+	std::vector<uint8_t> copies(_levels.size(), 0);
+	for (int index : _levelSelection.Indices())
+	{
+		copies[remap[index] + 1] = 1;
+		ReindexEnemyUsage(remap[index] + 1);
+	}
+
+	int duplicated = _levelSelection.Count();
+	_levelSelection.Resize(_levels.size());
+	_levelSelection.Clear();
+	for (size_t i = 0; i < copies.size(); ++i)
+		_levelSelection.Set((int)i, copies[i]);
+
+	_selectedLevelIndex = RemapIndex(remap, _selectedLevelIndex);
+	_deleteTargetIndex = -1;
+	_hasUnsavedChanges = true;
+	InvalidateLevelHashes();
+
+	_undoTracker.Invalidate();
+	if (_history)
+		_history->ForgetSteps(this);
+
+	std::cout << "[Level] Duplicated " << duplicated << " levels\n";
+}
+
 void LevelEditor::RenderCreateWindow()
 {
 	ImGui::Begin("새로운 레벨 생성", &_showCreateWindow);
@@ -281,6 +949,7 @@ void LevelEditor::RenderCreateWindow()
 		{
 			LevelData newLevel;
 			InitializeEmptyLevel(newLevel, _inputLevelId);
+			UpdateLevelHash(newLevel);
 
 			_levels.push_back(newLevel);
 
@@ -289,9 +958,16 @@ void LevelEditor::RenderCreateWindow()
 					return a.levelId < b.levelId;
 				});
 
+			// 정렬로 레벨 인덱스가 바뀌므로 다시 만듦
+			RebuildEnemyUsage();
+			InvalidateLevelHashes();
 			_hasUnsavedChanges = true;
 			_showCreateWindow = false;
 
+			_undoTracker.Invalidate();
+			if (_history)
+				_history->ForgetSteps(this);
+
 			std::cout << "[Level] Created: " << newLevel.levelId << "\n";
 		}
 	}
@@ -398,6 +1074,10 @@ void LevelEditor::RenderEditWindow()
 			RenderOptionsPanel(level);
 			ImGui::Separator();
 			RenderTileInspector(level);
+			ImGui::Separator();
+			RenderCoveragePanel(level);
+			ImGui::Separator();
+			RenderDeploymentSolverPanel(level);
 			ImGui::EndChild();
 
 			ImGui::EndTabItem();
@@ -496,9 +1176,9 @@ void LevelEditor::RenderGridEditor(LevelData& level)
 			level.tiles.push_back(CreateTileData(TileType::None));
 		}
 
+		BeginLevelEdit(level, LevelEditScope::Map());
 		SyncJsonFromGrid(level);
-		level.isModified = true;
-		_hasUnsavedChanges = true;
+		MarkLevelModified(level, LevelEditScope::Map());
 	}
 	ImGui::SameLine();
 	if (ImGui::InputInt("열 (가로)", &level.gridCols, 1, 1))
@@ -516,9 +1196,9 @@ void LevelEditor::RenderGridEditor(LevelData& level)
 			level.tiles.push_back(CreateTileData(TileType::None));
 		}
 
+		BeginLevelEdit(level, LevelEditScope::Map());
 		SyncJsonFromGrid(level);
-		level.isModified = true;
-		_hasUnsavedChanges = true;
+		MarkLevelModified(level, LevelEditScope::Map());
 	}
 	ImGui::PopItemWidth();
 
@@ -592,6 +1272,9 @@ void LevelEditor::RenderGridEditor(LevelData& level)
 			ImU32 color = GetTileColor(tileType);
 			draw_list->AddRectFilled(p_min, p_max, color);
 
+			RenderCoverageOverlay(level, gameRow, col, p_min.x, p_min.y, cellSize);
+			RenderDeploymentOverlay(level, gameRow, col, p_min.x, p_min.y, cellSize);
+
 			// 그리드 선
 			draw_list->AddRect(p_min, p_max, IM_COL32(100, 100, 100, 255));
 
@@ -621,10 +1304,9 @@ void LevelEditor::RenderGridEditor(LevelData& level)
 					_selectedGridRow = gameRow;
 					_selectedGridCol = col;
 
-					level.isModified = true;
-					_hasUnsavedChanges = true;
-
+					BeginLevelEdit(level, LevelEditScope::Map());
 					SyncJsonFromGrid(level);
+					MarkLevelModified(level, LevelEditScope::Map());
 				}
 			}
 
@@ -647,9 +1329,9 @@ void LevelEditor::RenderGridEditor(LevelData& level)
 
 		if (ImGui::Button("그리드 편집 완료", ImVec2(120, 0)))
 		{
+			BeginLevelEdit(level, LevelEditScope::Flags());
 			level.gridCompleted = true;
-			level.isModified = true;
-			_hasUnsavedChanges = true;
+			MarkLevelModified(level, LevelEditScope::Flags());
 
 			std::cout << "[Level] Grid completed for " << level.levelId << "\n";
 
@@ -664,9 +1346,9 @@ void LevelEditor::RenderGridEditor(LevelData& level)
 
 		if (ImGui::Button("그리드 다시 편집", ImVec2(200, 0)))
 		{
+			BeginLevelEdit(level, LevelEditScope::Flags());
 			level.gridCompleted = false;
-			level.isModified = true;
-			_hasUnsavedChanges = true;
+			MarkLevelModified(level, LevelEditScope::Flags());
 		}
 	}
 }
@@ -738,45 +1420,161 @@ void LevelEditor::RenderOptionsPanel(LevelData& level)
 
 	if (ImGui::InputInt("오퍼레이터 최대 배치 수", &level.characterLimit))
 	{
-		level.isModified = true;
-		_hasUnsavedChanges = true;
+		MarkLevelModified(level, LevelEditScope::Options());
 	}
 
 	if (ImGui::InputInt("최대 라이프", &level.maxLifePoint))
 	{
-		level.isModified = true;
-		_hasUnsavedChanges = true;
+		MarkLevelModified(level, LevelEditScope::Options());
 	}
 
 	if (ImGui::InputInt("시작 DP", &level.initialCost))
 	{
-		level.isModified = true;
-		_hasUnsavedChanges = true;
+		MarkLevelModified(level, LevelEditScope::Options());
 	}
 
 	if (ImGui::InputInt("최대 DP", &level.maxCost))
 	{
-		level.isModified = true;
-		_hasUnsavedChanges = true;
+		MarkLevelModified(level, LevelEditScope::Options());
 	}
 
 	if (ImGui::InputFloat("DP 증가 속도", &level.costIncreaseTime, 0.1f, 1.0f, "%.1f"))
 	{
-		level.isModified = true;
-		_hasUnsavedChanges = true;
+		MarkLevelModified(level, LevelEditScope::Options());
 	}
 
 	ImGui::PopItemWidth();
+
+	RenderDpTimeline(level);
 }
 
-void LevelEditor::RenderRouteEditor(LevelData& level)
+void LevelEditor::RenderDpTimeline(LevelData& level)
 {
-	ImGui::SeparatorText("경로 편집");
+	if (!ImGui::CollapsingHeader("DP 시뮬레이션"))
+		return;
 
-	int routeCount = 0;
-	if (level.fullData.contains("routes"))
+	// "코스트@요청시각" 을 쉼표로 구분 (예: 10, 12@5, 18)
+	static char planInput[256] = "";
+	ImGui::SetNextItemWidth(-1);
+	ImGui::InputTextWithHint("##DpPlan", "배치 코스트 (예: 10, 12@5, 18)", planInput, sizeof(planInput));
+
+	std::vector<DpPlanEntry> plan;
 	{
-		routeCount = (int)level.fullData["routes"].size();
+		std::stringstream ss(planInput);
+		std::string token;
+		while (std::getline(ss, token, ','))
+		{
+			char* end = nullptr;
+			DpPlanEntry entry;
+			entry.cost = (int)std::strtol(token.c_str(), &end, 10);
+			if (end == token.c_str())
+				continue;
+
+			if (*end == '@')
+				entry.requestTime = std::strtod(end + 1, nullptr);
+			plan.push_back(entry);
+		}
+	}
+
+	LevelOptions options;
+	options.characterLimit = level.characterLimit;
+	options.initialCost = level.initialCost;
+	options.maxCost = level.maxCost;
+	options.costIncreaseTime = level.costIncreaseTime;
+
+	std::vector<SpawnEvent> spawns = BuildSpawnEvents(level.fullData);
+	double firstSpawn = spawns.empty() ? -1.0 : spawns.front().time;
+	double lastSpawn = spawns.empty() ? 0.0 : spawns.back().time;
+
+	DpEconomy economy(options);
+	std::vector<DpSample> timeline;
+	DpPlanResult result = economy.Evaluate(plan, nullptr);
+	double horizon = std::max({ 30.0, lastSpawn, result.finishTime }) + 5.0;
+	result = economy.Evaluate(plan, &timeline, horizon);
+
+	// ===== DP 곡선 + 스폰/배치 시각 =====
+	ImDrawList* draw_list = ImGui::GetWindowDrawList();
+	ImVec2 origin = ImGui::GetCursorScreenPos();
+	float width = std::max(100.0f, ImGui::GetContentRegionAvail().x);
+	float height = 120.0f;
+	float maxDp = (float)std::max(1, std::max(options.maxCost, options.initialCost));
+
+	auto toScreen = [&](double time, int dp)
+		{
+			return ImVec2(origin.x + (float)(time / horizon) * width,
+				origin.y + height - (dp / maxDp) * height);
+		};
+
+	draw_list->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + height), IM_COL32(25, 25, 25, 255));
+	draw_list->AddRect(origin, ImVec2(origin.x + width, origin.y + height), IM_COL32(100, 100, 100, 255));
+
+	ImU32 spawnColor = ImGui::GetColorU32(COLOR_RED);
+	for (const auto& spawn : spawns)
+	{
+		float x = toScreen(spawn.time, 0).x;
+		draw_list->AddLine(ImVec2(x, origin.y + height - 10), ImVec2(x, origin.y + height), spawnColor);
+	}
+
+	ImU32 dpColor = ImGui::GetColorU32(COLOR_YELLOW);
+	for (size_t i = 1; i < timeline.size(); ++i)
+	{
+		// 계단형: 이전 값 유지 후 수직 이동
+		ImVec2 prev = toScreen(timeline[i - 1].time, timeline[i - 1].dp);
+		ImVec2 step = toScreen(timeline[i].time, timeline[i - 1].dp);
+		ImVec2 next = toScreen(timeline[i].time, timeline[i].dp);
+		draw_list->AddLine(prev, step, dpColor);
+		draw_list->AddLine(step, next, dpColor);
+	}
+	if (!timeline.empty())
+	{
+		ImVec2 last = toScreen(timeline.back().time, timeline.back().dp);
+		draw_list->AddLine(last, toScreen(horizon, timeline.back().dp), dpColor);
+	}
+
+	ImU32 deployColor = ImGui::GetColorU32(COLOR_GREEN);
+	for (size_t i = 0; i < result.deployTimes.size(); ++i)
+	{
+		if (result.deployTimes[i] < 0.0)
+			continue;
+
+		float x = toScreen(result.deployTimes[i], 0).x;
+		draw_list->AddLine(ImVec2(x, origin.y), ImVec2(x, origin.y + height), deployColor);
+		draw_list->AddText(ImVec2(x + 2, origin.y + 2), deployColor, std::to_string(i).c_str());
+	}
+
+	ImGui::Dummy(ImVec2(width, height));
+	ImGui::TextColored(COLOR_GRAY, "0s ~ %.0fs  (노랑: DP, 초록: 배치, 빨강: 스폰)", horizon);
+
+	// ===== 배치별 가능 시각 =====
+	for (size_t i = 0; i < plan.size(); ++i)
+	{
+		double deployTime = result.deployTimes[i];
+		if (deployTime < 0.0)
+		{
+			ImGui::TextColored(COLOR_RED, "%d. 코스트 %d: 배치 불가", (int)i, plan[i].cost);
+		}
+		else
+		{
+			bool beforeFirstSpawn = firstSpawn < 0.0 || deployTime <= firstSpawn;
+			ImGui::TextColored(beforeFirstSpawn ? COLOR_GREEN : COLOR_YELLOW,
+				"%d. 코스트 %d: %.1fs", (int)i, plan[i].cost, deployTime);
+		}
+	}
+
+	if (firstSpawn >= 0.0)
+		ImGui::Text("첫 스폰: %.1fs", firstSpawn);
+	if (result.wastedDp > 0)
+		ImGui::TextColored(COLOR_YELLOW, "최대 DP 로 버려진 DP: %d", result.wastedDp);
+}
+
+void LevelEditor::RenderRouteEditor(LevelData& level)
+{
+	ImGui::SeparatorText("경로 편집");
+
+	int routeCount = 0;
+	if (level.fullData.contains("routes"))
+	{
+		routeCount = (int)level.fullData["routes"].size();
 	}
 
 	ImGui::Text("현재 경로 개수: %d", routeCount);
@@ -797,6 +1595,22 @@ void LevelEditor::RenderRouteEditor(LevelData& level)
 	ImGui::Text("경로 목록");
 	ImGui::Separator();
 
+	_routeSelection.Resize(routeCount);
+
+	switch (RenderBatchToolbar(_routeSelection, false))
+	{
+	case BatchAction::Delete:
+		_showRouteBatchDeleteConfirm = true;
+		break;
+	case BatchAction::Duplicate:
+		DuplicateSelectedRoutes(level);
+		routeCount = (int)level.fullData["routes"].size();
+		break;
+	default:
+		break;
+	}
+	ImGui::Separator();
+
 	if (routeCount == 0)
 	{
 		ImGui::TextColored(COLOR_GRAY, "경로가 없습니다.");
@@ -807,6 +1621,9 @@ void LevelEditor::RenderRouteEditor(LevelData& level)
 		{
 			ImGui::PushID(i);
 
+			SelectionCheckbox(_routeSelection, i);
+			ImGui::SameLine();
+
 			char routeName[32];
 			snprintf(routeName, sizeof(routeName), "Route %d", i);
 
@@ -848,11 +1665,11 @@ void LevelEditor::RenderRouteEditor(LevelData& level)
 			{"visitEveryCheckPoint", false}
 		};
 
+		BeginLevelEdit(level, LevelEditScope::Route(routeCount));
 		level.fullData["routes"].push_back(newRoute);
 		_selectedRouteIndex = routeCount;
 
-		level.isModified = true;
-		_hasUnsavedChanges = true;
+		MarkLevelModified(level, LevelEditScope::Route(routeCount));
 
 		std::cout << "[Route] Added new route (total: " << (routeCount + 1) << ")\n";
 	}
@@ -888,9 +1705,9 @@ void LevelEditor::RenderRouteEditor(LevelData& level)
 		ImGui::SameLine();
 		if (ImGui::Combo("##MotionMode", &motionModeIndex, motionModes, 2))
 		{
+			BeginLevelEdit(level, LevelEditScope::Route(_selectedRouteIndex));
 			route["motionMode"] = (motionModeIndex == 1) ? 2 : 0;
-			level.isModified = true;
-			_hasUnsavedChanges = true;
+			MarkLevelModified(level, LevelEditScope::Route(_selectedRouteIndex));
 		}
 
 		ImGui::Separator();
@@ -1000,7 +1817,7 @@ void LevelEditor::RenderRouteEditor(LevelData& level)
 		ImGui::Text("경로 미리보기");
 		ImGui::Separator();
 
-		RenderRouteOnGrid(level, route);
+		RenderRouteOnGrid(level, route, _selectedRouteIndex);
 	}
 	else
 	{
@@ -1024,9 +1841,9 @@ void LevelEditor::RenderRouteEditor(LevelData& level)
 				_routeEditMode = false;
 				_selectedRouteIndex = -1;
 
+				BeginLevelEdit(level, LevelEditScope::Flags());
 				level.routeCompleted = true;
-				level.isModified = true;
-				_hasUnsavedChanges = true;
+				MarkLevelModified(level, LevelEditScope::Flags());
 
 				std::cout << "[Level] Route Completed for " << level.levelId << '\n';
 
@@ -1050,9 +1867,9 @@ void LevelEditor::RenderRouteEditor(LevelData& level)
 
 		if (ImGui::Button("경로 다시 편집", ImVec2(200, 0)))
 		{
+			BeginLevelEdit(level, LevelEditScope::Flags());
 			level.routeCompleted = false;
-			level.isModified = true;
-			_hasUnsavedChanges = true;
+			MarkLevelModified(level, LevelEditScope::Flags());
 		}
 	}
 
@@ -1074,10 +1891,9 @@ void LevelEditor::RenderRouteEditor(LevelData& level)
 
 		if (ImGui::Button("예", ImVec2(120, 0)))
 		{
-			level.fullData["routes"].erase(level.fullData["routes"].begin() + _selectedRouteIndex);
-			_selectedRouteIndex = -1;
-			level.isModified = true;
-			_hasUnsavedChanges = true;
+			std::vector<uint8_t> remove(level.fullData["routes"].size(), 0);
+			remove[_selectedRouteIndex] = 1;
+			DeleteRoutes(level, remove);
 
 			std::cout << "[Route] Route deleted\n";
 			ImGui::CloseCurrentPopup();
@@ -1092,9 +1908,112 @@ void LevelEditor::RenderRouteEditor(LevelData& level)
 
 		ImGui::EndPopup();
 	}
+
+	if (_showRouteBatchDeleteConfirm)
+	{
+		ImGui::OpenPopup("경로 일괄 삭제 확인");
+		_showRouteBatchDeleteConfirm = false;
+	}
+
+	if (ImGui::BeginPopupModal("경로 일괄 삭제 확인", NULL, ImGuiWindowFlags_AlwaysAutoResize))
+	{
+		ImGui::TextColored(COLOR_RED, "선택한 경로 %d개를 정말 삭제할까요?", _routeSelection.Count());
+		ImGui::Text("삭제된 경로를 쓰던 스폰은 경로 -1 (없음) 이 되고, 뒤쪽 경로 번호는 앞으로 당겨집니다.");
+		ImGui::Separator();
+
+		if (ImGui::Button("예", ImVec2(120, 0)))
+		{
+			DeleteRoutes(level, _routeSelection.Flags());
+			ImGui::CloseCurrentPopup();
+		}
+
+		ImGui::SameLine();
+
+		if (ImGui::Button("아니요", ImVec2(120, 0)))
+		{
+			ImGui::CloseCurrentPopup();
+		}
+
+		ImGui::EndPopup();
+	}
+}
+
+void LevelEditor::DeleteRoutes(LevelData& level, const std::vector<uint8_t>& remove)
+{
+	// 경로 번호를 가리키는 action 도 다시 매기므로 레벨 전체가 기준
+	BeginLevelEdit(level, LevelEditScope());
+	json::array_t& routes = level.fullData["routes"].get_ref<json::array_t&>();
+	size_t before = routes.size();
+
+	std::vector<int> remap = CompactRemove(routes, remove);
+	RemapRouteIndices(level, remap);
+
+	_selectedRouteIndex = RemapIndex(remap, _selectedRouteIndex);
+	if (_selectedRouteIndex < 0)
+		_editingCheckpointIndex = -1;
+	_routeSelection.Remap(remap, routes.size());
+
+	MarkLevelModified(level);
+
+	std::cout << "[Route] Deleted " << (before - routes.size()) << " routes\n";
+}
+
+void LevelEditor::DuplicateSelectedRoutes(LevelData& level)
+{
+	// 경로 번호를 가리키는 action 도 다시 매기므로 레벨 전체가 기준
+	BeginLevelEdit(level, LevelEditScope());
+	json::array_t& routes = level.fullData["routes"].get_ref<json::array_t&>();
+
+	std::vector<int> remap = DuplicateSelected(routes, _routeSelection.Flags(), [](const json& route) { return route; });
+	RemapRouteIndices(level, remap);
+
+	// 새로 만든 복제본을 선택
+	std::vector<uint8_t> copies(routes.size(), 0);
+	for (int index : _routeSelection.Indices())
+		copies[remap[index] + 1] = 1;
+
+	int duplicated = _routeSelection.Count();
+	_routeSelection.Resize(routes.size());
+	_routeSelection.Clear();
+	for (size_t i = 0; i < copies.size(); ++i)
+		_routeSelection.Set((int)i, copies[i]);
+
+	_selectedRouteIndex = RemapIndex(remap, _selectedRouteIndex);
+	MarkLevelModified(level);
+
+	std::cout << "[Route] Duplicated " << duplicated << " routes\n";
 }
 
-void LevelEditor::RenderRouteOnGrid(LevelData& level, json& route)
+void LevelEditor::RemapRouteIndices(LevelData& level, const std::vector<int>& remap)
+{
+	if (!level.fullData.contains("waves"))
+		return;
+
+	// 스폰이 가리키는 경로 번호를 old -> new 로 한 번에 고침 (사라진 경로는 -1)
+	int orphaned = 0;
+	for (auto& wave : level.fullData["waves"])
+	{
+		for (auto& fragment : wave["fragments"])
+		{
+			for (auto& action : fragment["actions"])
+			{
+				int routeIndex = action.value("routeIndex", 0);
+				if (routeIndex < 0 || routeIndex >= (int)remap.size())
+					continue;
+
+				int mapped = remap[routeIndex];
+				if (mapped < 0)
+					++orphaned;
+				action["routeIndex"] = mapped;
+			}
+		}
+	}
+
+	if (orphaned > 0)
+		std::cout << "[Route] " << orphaned << " spawn actions lost their route (routeIndex = -1)\n";
+}
+
+void LevelEditor::RenderRouteOnGrid(LevelData& level, json& route, int routeIndex)
 {
 	ImDrawList* draw_list = ImGui::GetWindowDrawList();
 	ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
@@ -1153,10 +2072,10 @@ void LevelEditor::RenderRouteOnGrid(LevelData& level, json& route)
 					if (_routeEditStep == RouteEditStep::SetStart)
 					{
 						// 시작 위치 설정
+						BeginLevelEdit(level, LevelEditScope::Route(routeIndex));
 						route["startPosition"]["row"] = gameRow;
 						route["startPosition"]["col"] = col;
-						level.isModified = true;
-						_hasUnsavedChanges = true;
+						MarkLevelModified(level, LevelEditScope::Route(routeIndex));
 
 						std::cout << "[Route] Start position set to (" << col << ", " << gameRow << ")\n";
 						_routeEditStep = RouteEditStep::SetEnd;
@@ -1164,10 +2083,10 @@ void LevelEditor::RenderRouteOnGrid(LevelData& level, json& route)
 					else if (_routeEditStep == RouteEditStep::SetEnd)
 					{
 						// 종료 위치 설정
+						BeginLevelEdit(level, LevelEditScope::Route(routeIndex));
 						route["endPosition"]["row"] = gameRow;
 						route["endPosition"]["col"] = col;
-						level.isModified = true;
-						_hasUnsavedChanges = true;
+						MarkLevelModified(level, LevelEditScope::Route(routeIndex));
 
 						std::cout << "[Route] End position set to (" << col << ", " << gameRow << ")\n";
 						_routeEditStep = RouteEditStep::AddCheckpoints;
@@ -1184,9 +2103,9 @@ void LevelEditor::RenderRouteOnGrid(LevelData& level, json& route)
 							{"reachDistance", 0.0}
 						};
 
+						BeginLevelEdit(level, LevelEditScope::Route(routeIndex));
 						route["checkpoints"].push_back(newCheckpoint);
-						level.isModified = true;
-						_hasUnsavedChanges = true;
+						MarkLevelModified(level, LevelEditScope::Route(routeIndex));
 
 						std::cout << "[Route] Added checkpoint at (" << col << ", " << gameRow << ")\n";
 					}
@@ -1209,39 +2128,39 @@ void LevelEditor::RenderRouteOnGrid(LevelData& level, json& route)
 					if (_routeEditStep == RouteEditStep::AddCheckpoints && !route["checkpoints"].empty())
 					{
 						// 체크포인트 제거
+						BeginLevelEdit(level, LevelEditScope::Route(routeIndex));
 						route["checkpoints"].erase(route["checkpoints"].end() - 1);
-						level.isModified = true;
-						_hasUnsavedChanges = true;
+						MarkLevelModified(level, LevelEditScope::Route(routeIndex));
 						std::cout << "[Route] Undo - removed last checkpoint\n";
 					}
 					else if (_routeEditStep == RouteEditStep::AddCheckpoints && route["checkpoints"].empty())
 					{
 						// 체크포인트가 없으면 종료 위치 제거
+						BeginLevelEdit(level, LevelEditScope::Route(routeIndex));
 						route["endPosition"]["row"] = -1;
 						route["endPosition"]["col"] = -1;
 						_routeEditStep = RouteEditStep::SetEnd;
-						level.isModified = true;
-						_hasUnsavedChanges = true;
+						MarkLevelModified(level, LevelEditScope::Route(routeIndex));
 						std::cout << "[Route] Undo - removed end position\n";
 					}
 					else if (_routeEditStep == RouteEditStep::SetEnd)
 					{
 						// 종료 위치 단계에서는 시작 위치로 돌아감
+						BeginLevelEdit(level, LevelEditScope::Route(routeIndex));
 						route["endPosition"]["row"] = -1;
 						route["endPosition"]["col"] = -1;
 						_routeEditStep = RouteEditStep::SetStart;
-						level.isModified = true;
-						_hasUnsavedChanges = true;
+						MarkLevelModified(level, LevelEditScope::Route(routeIndex));
 						std::cout << "[Route] Undo - back to start position\n";
 					}
 					else if (_routeEditStep == RouteEditStep::SetStart &&
 						route["startPosition"]["row"].get<int>() != -1)
 					{
 						// 시작 위치 제거
+						BeginLevelEdit(level, LevelEditScope::Route(routeIndex));
 						route["startPosition"]["row"] = -1;
 						route["startPosition"]["col"] = -1;
-						level.isModified = true;
-						_hasUnsavedChanges = true;
+						MarkLevelModified(level, LevelEditScope::Route(routeIndex));
 						std::cout << "[Route] Undo - removed start position\n";
 					}
 				}
@@ -1373,6 +2292,9 @@ void LevelEditor::RenderWaveEditor(LevelData& level)
 		ImGui::TextColored(COLOR_GRAY, "Fragment를 선택하세요.");
 	}
 
+	ImGui::Separator();
+	RenderSpawnDistribution(level);
+
 	ImGui::EndChild();
 
 	ImGui::Separator();
@@ -1388,9 +2310,9 @@ void LevelEditor::RenderWaveEditor(LevelData& level)
 				_selectedFragmentIndex = -1;
 				_selectedActionIndex = -1;
 
+				BeginLevelEdit(level, LevelEditScope::Flags());
 				level.waveCompleted = true;
-				level.isModified = true;
-				_hasUnsavedChanges = true;
+				MarkLevelModified(level, LevelEditScope::Flags());
 
 				std::cout << "[Level] Wave completed for " << level.levelId << "\n";
 			}
@@ -1412,9 +2334,9 @@ void LevelEditor::RenderWaveEditor(LevelData& level)
 
 		if (ImGui::Button("적 스폰 다시 편집", ImVec2(200, 0)))
 		{
+			BeginLevelEdit(level, LevelEditScope::Flags());
 			level.waveCompleted = false;
-			level.isModified = true;
-			_hasUnsavedChanges = true;
+			MarkLevelModified(level, LevelEditScope::Flags());
 		}
 	}
 
@@ -1434,10 +2356,36 @@ void LevelEditor::RenderWaveEditor(LevelData& level)
 
 		if (ImGui::Button("예", ImVec2(120, 0)))
 		{
-			wave["fragments"].erase(wave["fragments"].begin() + _selectedFragmentIndex);
-			_selectedFragmentIndex = -1;
-			level.isModified = true;
-			_hasUnsavedChanges = true;
+			std::vector<uint8_t> remove(wave["fragments"].size(), 0);
+			remove[_selectedFragmentIndex] = 1;
+			DeleteFragments(level, remove);
+			ImGui::CloseCurrentPopup();
+		}
+
+		ImGui::SameLine();
+
+		if (ImGui::Button("아니요", ImVec2(120, 0)))
+		{
+			ImGui::CloseCurrentPopup();
+		}
+
+		ImGui::EndPopup();
+	}
+
+	if (_showFragmentBatchDeleteConfirm)
+	{
+		ImGui::OpenPopup("Fragment 일괄 삭제 확인");
+		_showFragmentBatchDeleteConfirm = false;
+	}
+
+	if (ImGui::BeginPopupModal("Fragment 일괄 삭제 확인", NULL, ImGuiWindowFlags_AlwaysAutoResize))
+	{
+		ImGui::TextColored(COLOR_RED, "선택한 Fragment %d개를 정말 삭제할까요?", _fragmentSelection.Count());
+		ImGui::Separator();
+
+		if (ImGui::Button("예", ImVec2(120, 0)))
+		{
+			DeleteFragments(level, _fragmentSelection.Flags());
 			ImGui::CloseCurrentPopup();
 		}
 
@@ -1452,6 +2400,55 @@ void LevelEditor::RenderWaveEditor(LevelData& level)
 	}
 }
 
+void LevelEditor::DeleteFragments(LevelData& level, const std::vector<uint8_t>& remove)
+{
+	BeginLevelEdit(level, LevelEditScope::Fragments(0));
+	json::array_t& fragments = level.fullData["waves"][0]["fragments"].get_ref<json::array_t&>();
+	size_t before = fragments.size();
+
+	std::vector<int> remap = CompactRemove(fragments, remove);
+	ReindexEnemyUsage(_selectedLevelIndex);
+
+	int selected = RemapIndex(remap, _selectedFragmentIndex);
+	if (selected != _selectedFragmentIndex)
+		_selectedActionIndex = -1;
+	_selectedFragmentIndex = selected;
+	_fragmentSelection.Remap(remap, fragments.size());
+
+	MarkLevelModified(level, LevelEditScope::Fragments(0));
+
+	std::cout << "[Wave] Deleted " << (before - fragments.size()) << " fragments\n";
+}
+
+void LevelEditor::DuplicateSelectedFragments(LevelData& level)
+{
+	BeginLevelEdit(level, LevelEditScope::Fragments(0));
+	json::array_t& fragments = level.fullData["waves"][0]["fragments"].get_ref<json::array_t&>();
+
+	std::vector<int> remap = DuplicateSelected(fragments, _fragmentSelection.Flags(), [](const json& fragment) { return fragment; });
+	ReindexEnemyUsage(_selectedLevelIndex);
+
+	// 새로 만든 복제본을 선택
+	std::vector<uint8_t> copies(fragments.size(), 0);
+	for (int index : _fragmentSelection.Indices())
+		copies[remap[index] + 1] = 1;
+
+	int duplicated = _fragmentSelection.Count();
+	_fragmentSelection.Resize(fragments.size());
+	_fragmentSelection.Clear();
+	for (size_t i = 0; i < copies.size(); ++i)
+		_fragmentSelection.Set((int)i, copies[i]);
+
+	int selected = RemapIndex(remap, _selectedFragmentIndex);
+	if (selected != _selectedFragmentIndex)
+		_selectedActionIndex = -1;
+	_selectedFragmentIndex = selected;
+
+	MarkLevelModified(level, LevelEditScope::Fragments(0));
+
+	std::cout << "[Wave] Duplicated " << duplicated << " fragments\n";
+}
+
 void LevelEditor::RenderFragmentList(LevelData& level)
 {
 	auto& wave = level.fullData["waves"][0];
@@ -1461,6 +2458,22 @@ void LevelEditor::RenderFragmentList(LevelData& level)
 	ImGui::Text("총 %d개", fragmentCount);
 	ImGui::Separator();
 
+	_fragmentSelection.Resize(fragmentCount);
+
+	switch (RenderBatchToolbar(_fragmentSelection, false))
+	{
+	case BatchAction::Delete:
+		_showFragmentBatchDeleteConfirm = true;
+		break;
+	case BatchAction::Duplicate:
+		DuplicateSelectedFragments(level);
+		fragmentCount = (int)wave["fragments"].size();
+		break;
+	default:
+		break;
+	}
+	ImGui::Separator();
+
 	ImGui::BeginChild("FragmentListScroll", ImVec2(0, -80), false);
 
 	if (fragmentCount == 0)
@@ -1473,6 +2486,9 @@ void LevelEditor::RenderFragmentList(LevelData& level)
 		{
 			ImGui::PushID(i);
 
+			SelectionCheckbox(_fragmentSelection, i);
+			ImGui::SameLine();
+
 			auto& frag = wave["fragments"][i];
 			int actionCount = (int)frag["actions"].size();
 			double fragDelay = frag.value("preDelay", 0.0);
@@ -1516,12 +2532,13 @@ void LevelEditor::RenderFragmentList(LevelData& level)
 			{"actions", json::array()}
 		};
 
+		// Fragment 수가 바뀌는 구조 변경이므로 웨이브의 Fragment 배열 전체로 (해시도 다시 만듦)
+		BeginLevelEdit(level, LevelEditScope::Fragments(0));
 		wave["fragments"].push_back(newFragment);
 		_selectedFragmentIndex = fragmentCount;
 		_selectedActionIndex = -1;
 
-		level.isModified = true;
-		_hasUnsavedChanges = true;
+		MarkLevelModified(level, LevelEditScope::Fragments(0));
 	}
 
 	if (_selectedFragmentIndex >= 0 && _selectedFragmentIndex < fragmentCount)
@@ -1543,9 +2560,9 @@ void LevelEditor::RenderFragmentEditor(LevelData& level, json& fragment)
 	ImGui::PushItemWidth(150);
 	if (ImGui::InputDouble("Fragment 시작 지연", &fragPreDelay, 0.1f, 1.0f, "%.1f"))
 	{
+		BeginLevelEdit(level, LevelEditScope::Fragment(0, _selectedFragmentIndex));
 		fragment["preDelay"] = Snap1(fragPreDelay);
-		level.isModified = true;
-		_hasUnsavedChanges = true;
+		MarkLevelModified(level, LevelEditScope::Fragment(0, _selectedFragmentIndex));
 	}
 	ImGui::SameLine();
 	// 텍스트 색상만 있는 버튼
@@ -1589,18 +2606,30 @@ void LevelEditor::RenderFragmentEditor(LevelData& level, json& fragment)
 			int count = action.value("count", 1);
 			int routeIndex = action.value("routeIndex", 0);
 
-			char actionText[128];
+			char actionText[256];
 			snprintf(actionText, sizeof(actionText), "%d. %s x%d (경로:%d)",
 				i, key.c_str(), count, routeIndex);
 
+			if (action.contains("randomSpawnGroupKey") && action["randomSpawnGroupKey"].is_string())
+			{
+				std::string groupKey = action["randomSpawnGroupKey"].get<std::string>();
+				std::string packKey = (action.contains("randomSpawnGroupPackKey") && action["randomSpawnGroupPackKey"].is_string())
+					? action["randomSpawnGroupPackKey"].get<std::string>() : "-";
+
+				size_t len = strlen(actionText);
+				snprintf(actionText + len, sizeof(actionText) - len, " [랜덤:%s/%s w=%g]",
+					groupKey.c_str(), packKey.c_str(), action.value("weight", 0.0));
+			}
+
 			ImGui::BulletText("%s", actionText);
 
 			ImGui::SameLine(400);
 			if (ImGui::SmallButton("삭제"))
 			{
+				BeginLevelEdit(level, LevelEditScope::Fragment(0, _selectedFragmentIndex));
 				fragment["actions"].erase(fragment["actions"].begin() + i);
-				level.isModified = true;
-				_hasUnsavedChanges = true;
+				_enemyUsage.RemoveAction(_selectedLevelIndex, 0, _selectedFragmentIndex, i);
+				MarkLevelModified(level, LevelEditScope::Fragment(0, _selectedFragmentIndex));
 				ImGui::PopID();
 				break;
 			}
@@ -1652,6 +2681,10 @@ void LevelEditor::RenderEnemySelector(LevelData& level, json& fragment)
 		static int inputRouteIndex = 0;
 		static double inputPreDelay = 0.0;
 		static double inputInterval = 0.0;
+		static char inputGroupKey[64] = "";
+		static char inputPackKey[64] = "";
+		static int inputRandomType = 0;
+		static double inputWeight = 1.0;
 
 		ImGui::PushItemWidth(150);
 		ImGui::InputInt("개수", &inputCount);
@@ -1702,6 +2735,16 @@ void LevelEditor::RenderEnemySelector(LevelData& level, json& fragment)
 			ImGui::InputDouble("스폰 간격", &inputInterval, 0.1, 1.0, "%.1f");
 		}
 
+		// 랜덤 스폰 그룹 (그룹 키가 비어 있으면 항상 스폰)
+		ImGui::InputText("랜덤 그룹 키", inputGroupKey, sizeof(inputGroupKey));
+		{
+			SCOPED_DISABLED(inputGroupKey[0] == '\0');
+			ImGui::InputText("팩 키", inputPackKey, sizeof(inputPackKey));
+			ImGui::InputInt("랜덤 타입", &inputRandomType);
+			ImGui::InputDouble("가중치", &inputWeight, 0.1, 1.0, "%.2f");
+			inputRandomType = std::max(0, inputRandomType);
+			inputWeight = std::max(0.0, inputWeight);
+		}
 
 		ImGui::PopItemWidth();
 
@@ -1730,11 +2773,11 @@ void LevelEditor::RenderEnemySelector(LevelData& level, json& fragment)
 					{"autoDisplayEnemyInfo", false},
 					{"isUnharmfulAndAlwaysCountAsKilled", false},
 					{"hiddenGroup", nullptr},
-					{"randomSpawnGroupKey", nullptr},
-					{"randomSpawnGroupPackKey", nullptr},
-					{"randomType", 0},
+					{"randomSpawnGroupKey", inputGroupKey[0] ? json(inputGroupKey) : json(nullptr)},
+					{"randomSpawnGroupPackKey", (inputGroupKey[0] && inputPackKey[0]) ? json(inputPackKey) : json(nullptr)},
+					{"randomType", inputGroupKey[0] ? inputRandomType : 0},
 					{"refreshType", 0},
-					{"weight", 0},
+					{"weight", inputGroupKey[0] ? json(inputWeight) : json(0)},
 					{"dontBlockWave", false},
 					{"forceBlockWaveInBranch", false},
 					{"isValid", false},
@@ -1743,9 +2786,11 @@ void LevelEditor::RenderEnemySelector(LevelData& level, json& fragment)
 					{"actionId", nullptr}
 				};
 
+				BeginLevelEdit(level, LevelEditScope::Fragment(0, _selectedFragmentIndex));
 				fragment["actions"].push_back(newAction);
-				level.isModified = true;
-				_hasUnsavedChanges = true;
+				_enemyUsage.AddAction(_selectedLevelIndex, 0, _selectedFragmentIndex,
+					(int)fragment["actions"].size() - 1, _enemyKeys[_selectedEnemyIndex], inputCount);
+				MarkLevelModified(level, LevelEditScope::Fragment(0, _selectedFragmentIndex));
 
 				// 입력 초기화
 				inputCount = 1;
@@ -1764,6 +2809,67 @@ void LevelEditor::RenderEnemySelector(LevelData& level, json& fragment)
 	}
 }
 
+void LevelEditor::RenderSpawnDistribution(LevelData& level)
+{
+	if (!ImGui::CollapsingHeader("랜덤 스폰 분포"))
+		return;
+
+	if (ImGui::Button("분포 계산", ImVec2(150, 0)))
+	{
+		LevelGrid grid;
+		if (BuildLevelGrid(level.fullData, grid))
+		{
+			SpawnDistributionEngine engine(_enemyStats);
+			_spawnDistribution = engine.Compute(grid);
+			_spawnDistributionLevelId = level.levelId;
+		}
+		else
+		{
+			_spawnDistributionLevelId.clear();
+		}
+	}
+
+	if (_spawnDistributionLevelId != level.levelId)
+	{
+		ImGui::TextColored(COLOR_GRAY, "분포 계산을 누르면 랜덤 그룹 조합 전체의 스폰 분포를 표시합니다.");
+		return;
+	}
+
+	const LevelSpawnDistribution& dist = _spawnDistribution;
+	ImGui::Text("랜덤 그룹: %d (고유 형태 %d)", dist.groupCount, dist.uniqueGroupShapes);
+	if (!dist.exact)
+		ImGui::TextColored(COLOR_YELLOW, "근사 분포 (구간 폭 %.1f)", dist.hpPool.resolution);
+
+	if (ImGui::BeginTable("SpawnDistTable", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("항목");
+		ImGui::TableSetupColumn("평균");
+		ImGui::TableSetupColumn("최소");
+		ImGui::TableSetupColumn("p50");
+		ImGui::TableSetupColumn("p90");
+		ImGui::TableSetupColumn("최대");
+		ImGui::TableHeadersRow();
+
+		auto row = [](const char* label, const DiscreteDistribution& d)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn(); ImGui::Text("%s", label);
+				ImGui::TableNextColumn(); ImGui::Text("%.1f", d.Mean());
+				ImGui::TableNextColumn(); ImGui::Text("%.0f", d.Min());
+				ImGui::TableNextColumn(); ImGui::Text("%.0f", d.Quantile(0.5));
+				ImGui::TableNextColumn(); ImGui::Text("%.0f", d.Quantile(0.9));
+				ImGui::TableNextColumn(); ImGui::Text("%.0f", d.Max());
+			};
+
+		row("적 수", dist.enemyCount);
+		row("총 HP", dist.hpPool);
+		ImGui::EndTable();
+	}
+
+	for (size_t r = 0; r < dist.expectedRouteLoad.size(); ++r)
+		ImGui::BulletText("경로 %d: 기대 %.2f / 최대 %d", (int)r, dist.expectedRouteLoad[r], dist.maxRouteLoad[r]);
+}
+
 void LevelEditor::RenderRoutePreview(LevelData& level, int routeIndex)
 {
 	if (!level.fullData.contains("routes"))
@@ -1799,7 +2905,7 @@ void LevelEditor::RenderRoutePreview(LevelData& level, int routeIndex)
 	ImGui::BeginChild("RoutePreviewChild", ImVec2(0, 220), ImGuiChildFlags_Border);
 
 	ImGui::PushID(routeIndex);
-	RenderRouteOnGrid(level, route);
+	RenderRouteOnGrid(level, route, routeIndex);
 	ImGui::PopID();
 
 	ImGui::EndChild();
@@ -1807,81 +2913,465 @@ void LevelEditor::RenderRoutePreview(LevelData& level, int routeIndex)
 
 std::vector<std::string> LevelEditor::GetLevelFiles() const
 {
-	std::vector<std::string> levelFiles;
+	// level_main_*.json 패턴, 오름차순 (명령줄 도구와 같은 목록)
+	return ListLevelFiles(_jsonPath);
+}
+
+std::string LevelEditor::FormatLevelFileName(const std::string& levelId) const
+{
+	// "00-01" → "level_main_00-01.json"
+	return "level_main_" + levelId + ".json";
+}
+
+std::string LevelEditor::ExtractLevelId(const std::string& fileName) const
+{
+	// "level_main_00-01.json" → "00-01"
+	return LevelIdFromFileName(fileName);
+}
+
+void LevelEditor::SyncEnemyTable(const EnemyEditor& enemyEditor)
+{
+	if (_enemyRevision == enemyEditor.GetRevision())
+		return;
+
+	_enemyKeys.clear();
+	const json& enemyData = enemyEditor.GetEnemyData();
+	if (enemyData.contains("enemies") && enemyData["enemies"].is_array())
+	{
+		for (const auto& enemy : enemyData["enemies"])
+		{
+			if (enemy.contains("key"))
+				_enemyKeys.push_back(enemy["key"].get<std::string>());
+		}
+	}
+
+	_enemyStats = enemyEditor.GetResolvedEnemies().Snapshot();
+	_enemyRevision = enemyEditor.GetRevision();
+}
+
+void LevelEditor::LoadRangeSources(std::string solutionPath)
+{
+	_operatorStats.clear();
+	_skills.clear();
+
+	std::string operatorPath = solutionPath + "/gamedata/tables/operators_table.json";
+	std::string skillPath = solutionPath + "/gamedata/tables/skills_table.json";
+
+	json operatorTable;
+	if (LoadJsonFile(operatorPath, operatorTable))
+	{
+		ExpandRangeReferences(operatorTable, "operators", operatorPath);
+		_operatorStats = ParseOperatorTable(operatorTable);
+	}
+
+	json skillTable;
+	if (LoadJsonFile(skillPath, skillTable) && skillTable.contains("skills"))
+	{
+		ExpandRangeReferences(skillTable, "skills", skillPath);
+
+		try
+		{
+			_skills = skillTable["skills"].get<std::vector<Skill>>();
+		}
+		catch (json::exception& e)
+		{
+			std::cout << "[Level] Failed to parse skills_table.json: " << e.what() << "\n";
+		}
+	}
+}
+
+void LevelEditor::RenderCoveragePanel(LevelData& level)
+{
+	ImGui::SeparatorText("범위 커버리지");
 
-	if (!fs::exists(_jsonPath))
-		return levelFiles;
+	const char* sources[] = { "끄기", "오퍼레이터", "스킬" };
+	ImGui::SetNextItemWidth(150);
+	if (ImGui::Combo("대상", &_coverageSource, sources, IM_ARRAYSIZE(sources)))
+		_coverageItemIndex = 0;
 
-	for (const auto& entry : fs::directory_iterator(_jsonPath))
+	if (_coverageSource == 0)
+	{
+		_coverageLevelId.clear();
+	}
+	else
 	{
-		if (entry.is_regular_file())
+		int itemCount = _coverageSource == 1 ? (int)_operatorStats.size() : (int)_skills.size();
+		if (itemCount == 0)
+		{
+			ImGui::TextColored(COLOR_RED, _coverageSource == 1 ? "operators_table.json을 로드할 수 없습니다!" : "skills_table.json을 로드할 수 없습니다!");
+			_coverageLevelId.clear();
+			return;
+		}
+
+		_coverageItemIndex = std::clamp(_coverageItemIndex, 0, itemCount - 1);
+		auto itemName = [&](int i)
+			{
+				return _coverageSource == 1 ? _operatorStats[i].charId : _skills[i].skillId;
+			};
+
+		ImGui::SetNextItemWidth(200);
+		if (ImGui::BeginCombo("##CoverageItem", itemName(_coverageItemIndex).c_str()))
+		{
+			for (int i = 0; i < itemCount; ++i)
+			{
+				if (ImGui::Selectable(itemName(i).c_str(), i == _coverageItemIndex))
+					_coverageItemIndex = i;
+			}
+			ImGui::EndCombo();
+		}
+
+		const char* directions[] = { "최적 방향", "오른쪽", "위", "왼쪽", "아래" };
+		int directionItem = _coverageDirection + 1;
+		ImGui::SetNextItemWidth(150);
+		if (ImGui::Combo("방향", &directionItem, directions, IM_ARRAYSIZE(directions)))
+			_coverageDirection = directionItem - 1;
+
+		// 레벨이 작아서 매 프레임 다시 계산해도 충분히 빠름
+		LevelGrid grid;
+		if (BuildLevelGrid(level.fullData, grid))
 		{
-			std::string filename = entry.path().filename().string();
+			RangeBitboard range;
+			BuildableFilter filter = BuildableFilter::Any;
 
-			// level_main_*.json 패턴 필터링
-			if (filename.find("level_main_") == 0 && filename.ends_with(".json"))
+			if (_coverageSource == 1)
 			{
-				levelFiles.push_back(filename);
+				const OperatorStats& op = _operatorStats[_coverageItemIndex];
+				range = RangeBitboard::FromOffsets(op.range);
+				filter = op.IsMelee() ? BuildableFilter::Ground : BuildableFilter::HighGround;
 			}
+			else
+			{
+				range = RangeBitboard::FromSkillRange(_skills[_coverageItemIndex].range);
+			}
+
+			_coverageMap = ComputeCoverage(LevelBitboard::FromLevelGrid(grid), range, filter);
+			_coverageLevelId = level.levelId;
+
+			ImGui::Text("범위 %d칸, 최대 커버리지 %d", range.Count(), _coverageMap.maxCoverage);
+		}
+		else
+		{
+			_coverageLevelId.clear();
+			ImGui::TextColored(COLOR_GRAY, "그리드/경로가 완성되지 않았습니다.");
 		}
 	}
 
-	// 오름차순 정렬
-	std::sort(levelFiles.begin(), levelFiles.end());
+	// ===== 프로젝트 전체 스윕 =====
+	if (ImGui::Button("전체 레벨 × 오퍼레이터 스윕", ImVec2(-1, 0)))
+		RunProjectCoverageSweep();
 
-	return levelFiles;
+	if (!_coverageSweepBest.empty())
+	{
+		ImGui::TextColored(COLOR_GRAY, "%.1f ms", _coverageSweepMs);
+		for (const auto& entry : _coverageSweepBest)
+		{
+			if (entry.levelIndex >= (int)_levels.size() || entry.operatorIndex >= (int)_operatorStats.size())
+				continue;
+
+			ImGui::BulletText("%s: %s (%d, %d) %s → %d칸",
+				_levels[entry.levelIndex].levelId.c_str(),
+				_operatorStats[entry.operatorIndex].charId.c_str(),
+				entry.bestTile.col, entry.bestTile.row,
+				DirectionToString(entry.bestDirection),
+				entry.bestCoverage);
+		}
+	}
 }
 
-std::string LevelEditor::FormatLevelFileName(const std::string& levelId) const
+void LevelEditor::RenderCoverageOverlay(const LevelData& level, int gameRow, int col, float x, float y, float cellSize)
 {
-	// "00-01" → "level_main_00-01.json"
-	return "level_main_" + levelId + ".json";
+	if (_coverageLevelId.empty() || _coverageLevelId != level.levelId)
+		return;
+
+	if (gameRow < 0 || gameRow >= _coverageMap.rows || col < 0 || col >= _coverageMap.cols)
+		return;
+
+	int index = _coverageMap.Index(gameRow, col);
+	int value = (_coverageDirection < 0) ? _coverageMap.best[index] : _coverageMap.byDirection[_coverageDirection][index];
+	if (value < 0)
+		return;
+
+	ImDrawList* draw_list = ImGui::GetWindowDrawList();
+	float t = _coverageMap.maxCoverage > 0 ? (float)value / _coverageMap.maxCoverage : 0.0f;
+
+	ImVec4 color = COLOR_RED;
+	color.w = 0.15f + 0.6f * t;
+	draw_list->AddRectFilled(ImVec2(x, y), ImVec2(x + cellSize, y + cellSize), ImGui::GetColorU32(color));
+
+	char text[16];
+	snprintf(text, sizeof(text), "%d", value);
+	draw_list->AddText(ImVec2(x + cellSize * 0.5f - 4, y + cellSize * 0.5f - 8), IM_COL32(255, 255, 255, 255), text);
 }
 
-std::string LevelEditor::ExtractLevelId(const std::string& fileName) const
+void LevelEditor::RunProjectCoverageSweep()
 {
-	// "level_main_00-01.json" → "00-01"
-	if (fileName.length() > 16)
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<LevelGrid> grids;
+	std::vector<int> levelIndices;
+	for (int i = 0; i < (int)_levels.size(); ++i)
+	{
+		LevelGrid grid;
+		if (BuildLevelGrid(_levels[i].fullData, grid))
+		{
+			grids.push_back(std::move(grid));
+			levelIndices.push_back(i);
+		}
+	}
+
+	std::vector<CoverageSweepEntry> results = RunCoverageSweep(grids, _operatorStats);
+
+	// 레벨별 최고 커버리지만 남김
+	_coverageSweepBest.clear();
+	for (const auto& entry : results)
 	{
-		return fileName.substr(11, fileName.length() - 16);
+		int levelIndex = levelIndices[entry.levelIndex];
+		if (_coverageSweepBest.empty() || _coverageSweepBest.back().levelIndex != levelIndex)
+		{
+			_coverageSweepBest.push_back(entry);
+			_coverageSweepBest.back().levelIndex = levelIndex;
+		}
+		else if (entry.bestCoverage > _coverageSweepBest.back().bestCoverage)
+		{
+			_coverageSweepBest.back() = entry;
+			_coverageSweepBest.back().levelIndex = levelIndex;
+		}
 	}
-	return fileName;
+
+	auto end = std::chrono::steady_clock::now();
+	_coverageSweepMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+	std::cout << "[Level] Coverage sweep: " << grids.size() << " levels x " << _operatorStats.size()
+		<< " operators in " << _coverageSweepMs << " ms\n";
 }
 
-void LevelEditor::LoadEnemyTable(std::string solutionPath)
+void LevelEditor::RenderDeploymentSolverPanel(LevelData& level)
 {
-	_enemyKeys.clear();
-
-	std::string enemyTablePath = solutionPath + "/gamedata/tables/enemies_table.json";
+	ImGui::SeparatorText("배치 솔버");
 
-	std::ifstream file(enemyTablePath);
-	if (!file.is_open())
+	if (_operatorStats.empty())
 	{
-		std::cout << "[Level] enemies_table.json not found at: " << enemyTablePath << "\n";
+		ImGui::TextColored(COLOR_RED, "operators_table.json을 로드할 수 없습니다!");
 		return;
 	}
 
-	try
+	if (_solverRoster.size() != _operatorStats.size())
+		_solverRoster.assign(_operatorStats.size(), 1);
+
+	// 끝난 탐색 결과 받기
+	if (_solverTask.valid() && _solverTask.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
 	{
-		json enemyTable;
-		file >> enemyTable;
+		_solverResult = _solverTask.get();
+		_solverLevelId = _solverTaskLevelId;
+		_solverProgress.reset();
+	}
+	bool solving = _solverTask.valid();
+
+	// ===== 후보 로스터 =====
+	ImGui::SetNextItemWidth(150);
+	ImGui::InputTextWithHint("##SolverFilter", "charId 검색", _solverFilter, sizeof(_solverFilter));
+	ImGui::SameLine();
+	if (ImGui::SmallButton("전체 선택"))
+		std::fill(_solverRoster.begin(), _solverRoster.end(), 1);
+	ImGui::SameLine();
+	if (ImGui::SmallButton("선택 해제"))
+		std::fill(_solverRoster.begin(), _solverRoster.end(), 0);
+
+	int selectedCount = 0;
+	for (uint8_t selected : _solverRoster)
+		selectedCount += selected;
 
-		if (enemyTable.contains("enemies") && enemyTable["enemies"].is_array())
+	if (ImGui::BeginListBox("##SolverRoster", ImVec2(-1, 120)))
+	{
+		for (int i = 0; i < (int)_operatorStats.size(); ++i)
 		{
-			for (auto& enemy : enemyTable["enemies"])
+			const OperatorStats& op = _operatorStats[i];
+			if (_solverFilter[0] != '\0' && op.charId.find(_solverFilter) == std::string::npos)
+				continue;
+
+			ImGui::PushID(i);
+			bool selected = _solverRoster[i] != 0;
+			if (ImGui::Checkbox("##Use", &selected))
+				_solverRoster[i] = selected ? 1 : 0;
+			ImGui::SameLine();
+			ImGui::Text("%s (%s, 범위 %d칸)", op.charId.c_str(), op.IsMelee() ? "근거리" : "원거리", (int)op.range.size());
+			ImGui::PopID();
+		}
+		ImGui::EndListBox();
+	}
+
+	// ===== 옵션 =====
+	const char* objectives[] = { "경로 커버리지", "처치 수 (시뮬레이션)" };
+	ImGui::SetNextItemWidth(150);
+	ImGui::Combo("목표", &_solverObjective, objectives, IM_ARRAYSIZE(objectives));
+
+	ImGui::SetNextItemWidth(150);
+	ImGui::InputInt("배치 수 (0 = 레벨 옵션)", &_solverCharacterLimit);
+	_solverCharacterLimit = std::max(0, _solverCharacterLimit);
+
+	ImGui::SetNextItemWidth(150);
+	ImGui::SliderFloat("시간 제한 (초)", &_solverTimeLimit, 0.5f, 60.0f, "%.1f");
+
+	ImGui::BeginDisabled(selectedCount == 0 || solving);
+	if (ImGui::Button("최적 배치 탐색", ImVec2(-1, 0)))
+	{
+		// 이전 결과는 이전 로스터 인덱스를 쓰므로 새 탐색을 시작하면 숨김
+		_solverLevelId.clear();
+
+		LevelGrid grid;
+		if (BuildLevelGrid(level.fullData, grid))
+		{
+			_solverRosterStats.clear();
+			for (int i = 0; i < (int)_operatorStats.size(); ++i)
 			{
-				if (enemy.contains("key"))
-				{
-					std::string key = enemy["key"].get<std::string>();
-					_enemyKeys.push_back(key);
-				}
+				if (_solverRoster[i])
+					_solverRosterStats.push_back(_operatorStats[i]);
 			}
+
+			DeploymentSolverConfig config;
+			config.objective = (DeploymentObjective)_solverObjective;
+			config.characterLimit = _solverCharacterLimit > 0 ? _solverCharacterLimit : level.characterLimit;
+			config.timeLimit = _solverTimeLimit;
+
+			// UI 스레드를 막지 않도록 작업 스레드에서 (솔버는 입력을 복사해 가짐)
+			auto progress = std::make_shared<DeploymentSolverProgress>();
+			_solverProgress = progress;
+			_solverTaskLevelId = level.levelId;
+			_solverTask = std::async(std::launch::async,
+				[grid = std::move(grid), enemies = _enemyStats, roster = _solverRosterStats, config, progress]()
+				{
+					DeploymentSolver solver(grid, enemies, roster);
+					return solver.Solve(config, progress.get());
+				});
+			solving = true;
 		}
-		std::cout << "[level] Loaded " << _enemyKeys.size() << " enemies from enemy_table.json\n";
+		else
+		{
+			std::cout << "[Level] Solver: grid/routes are incomplete\n";
+		}
+	}
+	ImGui::EndDisabled();
+
+	// ===== 탐색 중 =====
+	if (solving)
+	{
+		DeploymentPlan best;
+		bool hasBest = _solverProgress->GetBest(best);
+
+		ImGui::TextColored(COLOR_YELLOW, "%s 탐색 중... 노드 %llu, 현재 최선 커버리지 %d",
+			_solverTaskLevelId.c_str(), (unsigned long long)_solverProgress->Nodes(), hasBest ? best.coverage : 0);
+
+		ImGui::BeginDisabled(_solverProgress->Cancelled());
+		if (ImGui::Button("취소", ImVec2(-1, 0)))
+			_solverProgress->Cancel();
+		ImGui::EndDisabled();
+
+		if (hasBest)
+			RenderDeploymentPlanTable(best);
+		return;
+	}
+
+	if (_solverLevelId.empty() || _solverLevelId != level.levelId)
+		return;
+
+	// ===== 결과 =====
+	const DeploymentPlan& best = _solverResult.best;
+	if (best.placements.empty())
+	{
+		ImGui::TextColored(COLOR_GRAY, "경로를 덮을 수 있는 배치가 없습니다.");
+		return;
 	}
-	catch (json::exception& e)
+
+	ImGui::Text("커버리지 %d / %d 타일", best.coverage, _solverResult.pathTiles);
+	if (best.simulated)
+		ImGui::Text("처치 %d, 누출 %d%s", best.kills, best.leaks, best.cleared ? " (클리어)" : "");
+
+	ImGui::TextColored(_solverResult.exhaustive ? COLOR_GREEN : COLOR_YELLOW,
+		_solverResult.exhaustive ? "최적해 (전체 탐색 완료)" : _solverResult.cancelled ? "취소됨 - 탐색 중 최선" : "제한 도달 - 탐색 중 최선");
+	ImGui::TextColored(COLOR_GRAY, "후보 %d개, 클래스 %d개, 노드 %llu, 스틸 %llu, %.1f ms",
+		_solverResult.placementCount, _solverResult.operatorClasses,
+		(unsigned long long)_solverResult.nodes, (unsigned long long)_solverResult.steals, _solverResult.elapsedMs);
+
+	RenderDeploymentPlanTable(best);
+
+	// 밸런스 스윕/시뮬레이터에서 바로 쓸 수 있는 배치 스크립트 형식
+	if (ImGui::Button("배치 스크립트 복사", ImVec2(-1, 0)))
 	{
-		std::cout << "[level] Failed to parse enemies_table.json: " << e.what() << "\n";
+		json deployments = json::array();
+		for (const auto& deployment : best.ToDeployments(_solverRosterStats))
+		{
+			deployments.push_back({
+				{"time", deployment.time},
+				{"charId", deployment.charId},
+				{"row", deployment.tile.row},
+				{"col", deployment.tile.col},
+				{"direction", DirectionToString(deployment.direction)}
+			});
+		}
+		json script = { {"deployments", deployments} };
+		ImGui::SetClipboardText(script.dump(2).c_str());
+	}
+}
+
+void LevelEditor::RenderDeploymentPlanTable(const DeploymentPlan& plan)
+{
+	if (ImGui::BeginTable("SolverPlan", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("오퍼레이터");
+		ImGui::TableSetupColumn("타일");
+		ImGui::TableSetupColumn("방향");
+		ImGui::TableSetupColumn("단독");
+		ImGui::TableHeadersRow();
+
+		for (const auto& placed : plan.placements)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", _solverRosterStats[placed.operatorIndex].charId.c_str());
+			ImGui::TableNextColumn();
+			ImGui::Text("(%d, %d)", placed.tile.col, placed.tile.row);
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", DirectionToString(placed.direction));
+			ImGui::TableNextColumn();
+			ImGui::Text("%d", placed.coverage);
+		}
+		ImGui::EndTable();
+	}
+}
+
+void LevelEditor::RenderDeploymentOverlay(const LevelData& level, int gameRow, int col, float x, float y, float cellSize)
+{
+	if (_solverLevelId.empty() || _solverLevelId != level.levelId)
+		return;
+
+	int index = gameRow * level.gridCols + col;
+	if (gameRow < 0 || col < 0 || col >= level.gridCols || index >= (int)_solverResult.bestCovered.size())
+		return;
+
+	ImDrawList* draw_list = ImGui::GetWindowDrawList();
+
+	// 덮인 경로 타일
+	if (_solverResult.bestCovered[index])
+	{
+		ImVec4 color = COLOR_GREEN;
+		color.w = 0.35f;
+		draw_list->AddRectFilled(ImVec2(x, y), ImVec2(x + cellSize, y + cellSize), ImGui::GetColorU32(color));
+	}
+
+	// 배치된 오퍼레이터 (방향은 화살표 대신 글자로 표시)
+	for (const auto& placed : _solverResult.best.placements)
+	{
+		if (placed.tile.row != gameRow || placed.tile.col != col)
+			continue;
+
+		draw_list->AddRect(ImVec2(x + 2, y + 2), ImVec2(x + cellSize - 2, y + cellSize - 2), ImGui::GetColorU32(COLOR_YELLOW), 0.0f, 0, 3.0f);
+
+		const char* arrows[] = { ">", "^", "<", "v" };
+		char text[80];
+		snprintf(text, sizeof(text), "%s %s", arrows[(int)placed.direction], _solverRosterStats[placed.operatorIndex].charId.c_str());
+		draw_list->PushClipRect(ImVec2(x, y), ImVec2(x + cellSize, y + cellSize), true);
+		draw_list->AddText(ImVec2(x + 4, y + cellSize * 0.5f - 8), IM_COL32(255, 255, 255, 255), text);
+		draw_list->PopClipRect();
 	}
 }
 
@@ -1890,32 +3380,32 @@ LevelEditor::LevelData LevelEditor::LoadLevelFromFile(const std::string& fileNam
 	LevelData level;
 	level.fileName = fileName;
 	level.levelId = ExtractLevelId(fileName);
+	level.revision = NextDataRevision();
 
+	// 읽기 + 버전 체크 및 마이그레이션 (명령줄 도구와 같은 경로)
 	std::string filePath = _jsonPath + "/" + fileName;
-	std::ifstream file(filePath);
+	std::string error;
+	DataFileStatus status = ReadDataFile(Migration::DataType::Level, filePath, level.fullData, error);
 
-	if (file.is_open())
+	if (status == DataFileStatus::Missing)
 	{
+		std::cout << "[Level] File not found: " << filePath << "\n";
+		InitializeEmptyLevel(level, level.levelId);
+	}
+	else if (status == DataFileStatus::ParseError)
+	{
+		std::cout << "[Level] JSON parse error for " << fileName << ": " << error << "\n";
+		InitializeEmptyLevel(level, level.levelId);
+	}
+	else
+	{
+		if (status == DataFileStatus::Migrated)
+			level.isModified = true;  // 저장 필요 표시
+
 		try
 		{
-			file >> level.fullData;
-
-			// 버전 체크 및 마이그레이션
-			if (Migration::CheckAndMigrate(Migration::DataType::Level, level.fullData))
-			{
-				level.isModified = true;  // 저장 필요 표시
-			}
-
 			// 옵션 불러오기
-			if (level.fullData.contains("options"))
-			{
-				auto& opts = level.fullData["options"];
-				level.characterLimit = opts.value("characterLimit", 8);
-				level.maxLifePoint = opts.value("maxLifePoint", 3);
-				level.initialCost = opts.value("initialCost", 10);
-				level.maxCost = opts.value("maxCost", 99);
-				level.costIncreaseTime = opts.value("costIncreaseTime", 1.0f);
-			}
+			SyncOptionsFromJson(level);
 
 			// 커스텀 데이터 불러오기
 			if (level.fullData.contains("editorMetadata"))
@@ -1927,8 +3417,6 @@ LevelEditor::LevelData LevelEditor::LoadLevelFromFile(const std::string& fileNam
 			}
 
 			SyncGridFromJson(level);
-
-			std::cout << "[Level] Loaded: " << level.levelId << "\n";
 		}
 		catch (json::exception& e)
 		{
@@ -1936,12 +3424,10 @@ LevelEditor::LevelData LevelEditor::LoadLevelFromFile(const std::string& fileNam
 			InitializeEmptyLevel(level, level.levelId);
 		}
 	}
-	else
-	{
-		std::cout << "[Level] File not found: " << filePath << "\n";
-		InitializeEmptyLevel(level, level.levelId);
-	}
 
+	// 저장될 형태 (옵션은 fullData 에) 로 맞춘 뒤 해시
+	SyncOptionsToJson(level);
+	UpdateLevelHash(level);
 	return level;
 }
 
@@ -1950,8 +3436,6 @@ void LevelEditor::SaveLevelToFile(const LevelData& level)
 	// JSON 업데이트
 	json saveData = level.fullData;
 
-	saveData["version"] = VERSION;
-
 	// 옵션 업데이트
 	saveData["options"]["characterLimit"] = level.characterLimit;
 	saveData["options"]["maxLifePoint"] = level.maxLifePoint;
@@ -1969,15 +3453,10 @@ void LevelEditor::SaveLevelToFile(const LevelData& level)
 		{"waveCompleted", level.waveCompleted}
 	};
 
-	// 파일 저장
-	fs::create_directories(_jsonPath);
-
+	// 파일 저장 (version 은 현재 버전으로)
 	std::string filepath = _jsonPath + "/" + level.fileName;
-	std::ofstream file(filepath);
-
-	if (file.is_open())
+	if (WriteDataFile(Migration::DataType::Level, filepath, std::move(saveData)))
 	{
-		file << saveData.dump(2);
 		std::cout << "[LevelEditor] Saved: " << level.levelId << "\n";
 	}
 	else
@@ -1998,6 +3477,7 @@ void LevelEditor::InitializeEmptyLevel(LevelData& level, const std::string& leve
 	level.maxCost = 99;
 	level.costIncreaseTime = 1.0f;
 	level.isModified = true;
+	level.revision = NextDataRevision();
 
 	// JSON 기본 구조 생성
 	level.fullData = {
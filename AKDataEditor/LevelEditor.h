@@ -1,25 +1,93 @@
 ﻿#pragma once
+#include <future>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <nlohmann/json.hpp>
 
 #include "Level.h"
+#include "GameTables.h"
+#include "SpawnDistribution.h"
+#include "DpEconomy.h"
+#include "RangeBitboard.h"
+#include "DeploymentSolver.h"
+#include "EnemyVariants.h"
+#include "EnemyUsageIndex.h"
+#include "Skill.h"
+#include "BatchWidgets.h"
+#include "EditHistory.h"
+#include "PristineSnapshot.h"
+#include "ContentHash.h"
 
 using json = nlohmann::ordered_json;
 
-class LevelEditor
+class EnemyEditor;
+
+// 레벨에서 편집한 부분 (해시는 그 잎/부분 값만 다시 계산, 되돌리기는 그 하위 트리만 비교, Level 은 레벨 전체)
+struct LevelEditScope
+{
+	enum class Part { Level, Options, Map, Flags, Route, Fragment, Fragments };
+	Part part = Part::Level;
+	int route = -1;
+	int wave = -1;
+	int fragment = -1;
+
+	static LevelEditScope Options() { return { Part::Options }; }
+	static LevelEditScope Map() { return { Part::Map }; }
+	static LevelEditScope Flags() { return { Part::Flags }; }
+	static LevelEditScope Route(int route) { return { Part::Route, route }; }
+	static LevelEditScope Fragment(int wave, int fragment) { return { Part::Fragment, -1, wave, fragment }; }
+	static LevelEditScope Fragments(int wave) { return { Part::Fragments, -1, wave }; }
+
+	// 이 부분의 fullData 위치 (Level / Flags 는 레코드 전체)
+	json::json_pointer Pointer() const;
+
+	// 되돌리기로 바뀐 위치 ("/routes/<i>/..." 등) 가 속한 부분
+	static LevelEditScope Of(const json::json_pointer& pointer);
+};
+
+class LevelEditor : public RecordEditTarget
 {
 public:
 	LevelEditor(std::string jsonPath, std::string solutionPath);
 	~LevelEditor();
 
-	void RenderGUI(bool* p_open);
+	// 적 목록/스탯은 적 편집기가 해석해 둔 것을 그대로 씀 (revision 이 바뀌면 다시 복사)
+	void RenderGUI(bool* p_open, const EnemyEditor& enemyEditor);
 
 	void LoadLevels();
 	void SaveAllLevels();
 
-	bool HasUnsavedChanges() const { return _hasUnsavedChanges; }
+	// 수정한 레벨만 저장된 상태 사본으로 되돌림 (저장한 적 없는 새 레벨은 뺌)
+	void DiscardChanges();
+	// 바뀐 레벨 파일만 다시 읽고 나머지는 DiscardChanges 와 같게 되돌림
+	void RefreshFromDisk();
+
+	// 값을 고쳤다가 원래대로 돌렸으면 저장된 해시와 같으므로 false
+	bool HasUnsavedChanges();
 	void ClearUnsavedFlag() { _hasUnsavedChanges = false; }
+	// 저장된 상태와 다른 레벨 목록 (바뀐 레벨은 다른 경로/Fragment 수까지)
+	const RecordChangeSummary& GetChangeSummary();
+
+	// 적 키 -> 레벨 사용 위치 (적 편집기에서 읽기 전용으로 사용)
+	const EnemyUsageIndex& GetEnemyUsage() const { return _enemyUsage; }
+
+	// 무결성 검사 등에서 읽기 전용으로 사용
+	int GetLevelCount() const { return (int)_levels.size(); }
+	const std::string& GetLevelId(int index) const { return _levels[index].levelId; }
+	const json& GetLevelData(int index) const { return _levels[index].fullData; }
+	uint64_t GetLevelRevision(int index) const { return _levels[index].revision; }
+
+	// 되돌리기 기록 (레코드 = 레벨 fullData, 옵션 필드도 fullData["options"] 로 비교)
+	void SetEditHistory(EditHistory* history) { _history = history; }
+	const char* EditTargetName() const override { return "레벨"; }
+	std::string EditRecordLabel(int record) const override;
+	std::string EditRecordKey(int record) const override { return EditRecordLabel(record); }
+	std::string EditRecordSource(int record) const override;		// 레벨마다 파일 하나
+	uint64_t EditSourceHash(const std::string& source) const override;
+	int EditRecordCount() const override { return (int)_levels.size(); }
+	void SetRecordValue(int record, const json::json_pointer& pointer, const json& value) override;
 
 private:
     // 타일 타입
@@ -50,7 +118,9 @@ private:
         std::vector<json> tiles;                // 타일 정보
         json fullData;                          // 전체 JSON 데이터
 
-        bool isModified = false;                // 수정 여부
+        bool isModified = false;                // 수정 여부 (건드림, 실제로 다른지는 contentHash 로 판단)
+        uint64_t revision = 0;                  // 내용이 바뀔 때마다 새 값 (무결성 검사 캐시 키)
+        LevelContentHash contentHash;           // 저장될 내용의 해시 (경로/Fragment 별 해시 포함)
 
         // 완성 상태 추적
         bool gridCompleted = false;
@@ -82,6 +152,37 @@ private:
     // 레벨 목록
     std::vector<LevelData> _levels;
 
+    // 적 사용 위치 역색인 (레벨 인덱스 = _levels 인덱스, waves 가 바뀔 때마다 같이 고침)
+    EnemyUsageIndex _enemyUsage;
+    void RebuildEnemyUsage();
+    void BeginLevelEdit(LevelData& level, const LevelEditScope& scope);
+    void MarkLevelModified(LevelData& level, const LevelEditScope& scope = LevelEditScope());
+    void ReindexEnemyUsage(int levelIndex);
+
+    // 되돌리기 기록
+    EditHistory* _history = nullptr;
+    RecordEditTracker _undoTracker;
+    void SyncOptionsToJson(LevelData& level);
+    void SyncOptionsFromJson(LevelData& level);
+    void ClearLevelSubSelection();
+
+    // 파일 이름 -> 마지막으로 읽거나 저장한 레벨 / 그 파일
+    // 사본은 읽거나 저장한 뒤 처음 고치기 직전에만 만듦 (nullptr = 지금 레벨이 저장된 상태 그대로, 키 없음 = 저장한 적 없는 새 레벨)
+    std::unordered_map<std::string, std::unique_ptr<LevelData>> _pristineLevels;
+    std::unordered_map<std::string, FileStamp> _levelStamps;
+    void CaptureLevel(const LevelData& level);
+    void PreserveLevel(const LevelData& level);
+
+    // 레벨별 내용 해시 (파일 이름 -> 해시, 레벨 하나가 바뀌면 그 잎만, 목록이 바뀌면 다음에 볼 때 다시 만듦)
+    RecordHashTable _levelHashes;
+    bool _levelHashesDirty = true;
+    RecordChangeSummary _changeSummary;
+    bool _changeSummaryDirty = true;
+    void UpdateLevelHash(LevelData& level, const LevelEditScope& scope = LevelEditScope());
+    void RefreshLevelHashes();
+    void ResetLevelHashes();
+    void InvalidateLevelHashes() { _levelHashesDirty = true; _changeSummaryDirty = true; }
+
 	// 변경 사항 추적
 	bool _hasUnsavedChanges = false;
 
@@ -98,6 +199,14 @@ private:
     int _deleteTargetIndex = -1;
     std::string _deleteTargetName = "";
 
+    // 목록 다중 선택 / 일괄 작업 (경로/Fragment 선택은 편집 중인 레벨 기준)
+    MultiSelection _levelSelection;
+    MultiSelection _routeSelection;
+    MultiSelection _fragmentSelection;
+    bool _showBatchDeleteConfirm = false;
+    bool _showRouteBatchDeleteConfirm = false;
+    bool _showFragmentBatchDeleteConfirm = false;
+
     // 새 레벨 입력
     char _inputLevelId[64] = ""; // 00-01 형식
 
@@ -119,33 +228,82 @@ private:
     bool _showFragmentDeleteConfirm = false;
     char _inputEnemyKey[128] = "";  // 적 키 입력용
     std::vector<std::string> _enemyKeys;  // enemy_table의 적 목록
+    std::vector<EnemyStats> _enemyStats;  // 스폰 분포/솔버용 기본(value[0]) 스탯
+    uint64_t _enemyRevision = 0;          // _enemyKeys/_enemyStats 를 복사한 적 편집기 revision
     int _selectedEnemyIndex = 0;  // Combo 선택 인덱스
 
+    // 범위 커버리지 히트맵
+    std::vector<OperatorStats> _operatorStats;
+    std::vector<Skill> _skills;
+    int _coverageSource = 0;            // 0. 끄기, 1. 오퍼레이터, 2. 스킬
+    int _coverageItemIndex = 0;
+    int _coverageDirection = -1;        // -1 = 네 방향 중 최대
+    CoverageMap _coverageMap;
+    std::string _coverageLevelId = "";
+    std::vector<CoverageSweepEntry> _coverageSweepBest;   // 레벨별 최고 커버리지
+    double _coverageSweepMs = 0.0;
+
+    // 배치 솔버
+    std::vector<uint8_t> _solverRoster;             // _operatorStats 인덱스별 후보 포함 여부
+    char _solverFilter[64] = "";
+    int _solverObjective = 0;                       // 0. 커버리지, 1. 처치 수
+    int _solverCharacterLimit = 0;                  // 0 = 레벨 옵션 사용
+    float _solverTimeLimit = 5.0f;
+    std::vector<OperatorStats> _solverRosterStats;  // 마지막 실행에 사용한 로스터
+    DeploymentSolveResult _solverResult;
+    std::string _solverLevelId = "";
+    std::future<DeploymentSolveResult> _solverTask;                 // 작업 스레드에서 실행 중인 탐색 (없으면 invalid)
+    std::shared_ptr<DeploymentSolverProgress> _solverProgress;      // 실행 중 최선 배치 / 취소
+    std::string _solverTaskLevelId = "";
+
+    // 랜덤 스폰 그룹 분포
+    LevelSpawnDistribution _spawnDistribution;
+    std::string _spawnDistributionLevelId = "";
+
 	// gui render
 	void RenderToolbar();
 	void RenderLevelsList();
 	void RenderCreateWindow();
 	void RenderEditWindow();
+    void RenderLevelBatchPopups();
+
+    // 일괄 삭제/복제 (remove 는 선택 플래그와 같은 형식)
+    void DeleteLevels(const std::vector<uint8_t>& remove);
+    void DuplicateSelectedLevels();
+    void DeleteRoutes(LevelData& level, const std::vector<uint8_t>& remove);
+    void DuplicateSelectedRoutes(LevelData& level);
+    void RemapRouteIndices(LevelData& level, const std::vector<int>& remap);
+    void DeleteFragments(LevelData& level, const std::vector<uint8_t>& remove);
+    void DuplicateSelectedFragments(LevelData& level);
 
     // 편집 윈도우 서브 패널
     void RenderGridEditor(LevelData& level);
     void RenderTileInspector(LevelData& level);
     void RenderOptionsPanel(LevelData& level);
+    void RenderDpTimeline(LevelData& level);
+    void RenderCoveragePanel(LevelData& level);
+    void RenderCoverageOverlay(const LevelData& level, int gameRow, int col, float x, float y, float cellSize);
+    void RunProjectCoverageSweep();
+    void RenderDeploymentSolverPanel(LevelData& level);
+    void RenderDeploymentPlanTable(const DeploymentPlan& plan);
+    void RenderDeploymentOverlay(const LevelData& level, int gameRow, int col, float x, float y, float cellSize);
 
     void RenderRouteEditor(LevelData& level);
-    void RenderRouteOnGrid(LevelData& level, json& route);
+    void RenderRouteOnGrid(LevelData& level, json& route, int routeIndex);
 
     void RenderWaveEditor(LevelData& level);
     void RenderFragmentList(LevelData& level);
     void RenderFragmentEditor(LevelData& level, json& fragment);  
     void RenderEnemySelector(LevelData& level, json& fragment);  
     void RenderRoutePreview(LevelData& level, int routeIndex);
+    void RenderSpawnDistribution(LevelData& level);
 
     // 레벨 파일 관리
     std::vector<std::string> GetLevelFiles() const;
     std::string FormatLevelFileName(const std::string& levelId) const;
     std::string ExtractLevelId(const std::string& fileName) const;
-    void LoadEnemyTable(std::string solutionPath);
+    void SyncEnemyTable(const EnemyEditor& enemyEditor);
+    void LoadRangeSources(std::string solutionPath);
 
     // 레벨 데이터 처리
     LevelData LoadLevelFromFile(const std::string& fileName);
@@ -0,0 +1,427 @@
+﻿#include "LevelGrid.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <queue>
+
+namespace
+{
+	TileKind TileKeyToKind(const std::string& tileKey)
+	{
+		if (tileKey == "tile_road") return TileKind::Road;
+		if (tileKey == "tile_highground") return TileKind::HighGround;
+		if (tileKey == "tile_start") return TileKind::Start;
+		if (tileKey == "tile_end") return TileKind::End;
+		if (tileKey == "tile_forbidden") return TileKind::Forbidden;
+		return TileKind::Other;
+	}
+
+	GridPos ReadPosition(const json& node)
+	{
+		return { node.value("row", -1), node.value("col", -1) };
+	}
+
+	// 지상 경로: BFS 최단 경로 (대각선 이동 시 모서리 통과 금지)
+	bool FindGroundPath(const LevelGrid& grid, GridPos from, GridPos to, bool allowDiagonal, std::vector<GridPos>& out)
+	{
+		if (!grid.IsPassable(from.row, from.col) || !grid.IsPassable(to.row, to.col))
+			return false;
+
+		static const int dirs[8][2] = {
+			{ 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+			{ 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 }
+		};
+		const int dirCount = allowDiagonal ? 8 : 4;
+
+		std::vector<int> parent(grid.rows * grid.cols, -1);
+		std::queue<int> open;
+
+		int startIdx = grid.TileIndex(from.row, from.col);
+		int goalIdx = grid.TileIndex(to.row, to.col);
+		parent[startIdx] = startIdx;
+		open.push(startIdx);
+
+		while (!open.empty())
+		{
+			int current = open.front();
+			open.pop();
+
+			if (current == goalIdx)
+				break;
+
+			int row = current / grid.cols;
+			int col = current % grid.cols;
+
+			for (int d = 0; d < dirCount; ++d)
+			{
+				int nr = row + dirs[d][0];
+				int nc = col + dirs[d][1];
+
+				if (!grid.IsPassable(nr, nc))
+					continue;
+
+				if (d >= 4 && (!grid.IsPassable(row, nc) || !grid.IsPassable(nr, col)))
+					continue;
+
+				int next = grid.TileIndex(nr, nc);
+				if (parent[next] != -1)
+					continue;
+
+				parent[next] = current;
+				open.push(next);
+			}
+		}
+
+		if (parent[goalIdx] == -1)
+			return false;
+
+		std::vector<GridPos> reversed;
+		for (int idx = goalIdx; ; idx = parent[idx])
+		{
+			reversed.push_back({ idx / grid.cols, idx % grid.cols });
+			if (idx == startIdx)
+				break;
+		}
+
+		out.assign(reversed.rbegin(), reversed.rend());
+		return true;
+	}
+
+	// 비행 경로: 직선 (Bresenham)
+	void FindFlyingPath(GridPos from, GridPos to, std::vector<GridPos>& out)
+	{
+		out.clear();
+
+		int dr = std::abs(to.row - from.row);
+		int dc = std::abs(to.col - from.col);
+		int sr = (from.row < to.row) ? 1 : -1;
+		int sc = (from.col < to.col) ? 1 : -1;
+		int err = dc - dr;
+
+		GridPos current = from;
+		while (true)
+		{
+			out.push_back(current);
+			if (current == to)
+				break;
+
+			int e2 = err * 2;
+			if (e2 > -dr)
+			{
+				err -= dr;
+				current.col += sc;
+			}
+			if (e2 < dc)
+			{
+				err += dc;
+				current.row += sr;
+			}
+		}
+	}
+}
+
+LevelOptions ReadLevelOptions(const json& levelData)
+{
+	LevelOptions options;
+
+	if (levelData.contains("options"))
+	{
+		const json& opts = levelData["options"];
+		options.characterLimit = opts.value("characterLimit", 8);
+		options.maxLifePoint = opts.value("maxLifePoint", 3);
+		options.initialCost = opts.value("initialCost", 10);
+		options.maxCost = opts.value("maxCost", 99);
+		options.costIncreaseTime = opts.value("costIncreaseTime", 1.0);
+		options.moveMultiplier = opts.value("moveMultiplier", 0.5);
+	}
+
+	return options;
+}
+
+bool BuildLevelGrid(const json& levelData, LevelGrid& out)
+{
+	out = LevelGrid();
+	out.options = ReadLevelOptions(levelData);
+
+	if (levelData.contains("levelId") && levelData["levelId"].is_string())
+	{
+		out.levelId = levelData["levelId"].get<std::string>();
+	}
+
+	if (!levelData.contains("mapData") || !levelData["mapData"].contains("map"))
+		return false;
+
+	const json& mapArray = levelData["mapData"]["map"];
+	const json& tileArray = levelData["mapData"].contains("tiles") ? levelData["mapData"]["tiles"] : json::array();
+
+	if (mapArray.empty() || mapArray[0].empty())
+		return false;
+
+	out.rows = (int)mapArray.size();
+	out.cols = (int)mapArray[0].size();
+	out.tiles.assign(out.rows * out.cols, TileKind::Forbidden);
+	out.buildable.assign(out.rows * out.cols, 0);
+	out.passable.assign(out.rows * out.cols, 0);
+
+	for (int jsonRow = 0; jsonRow < out.rows; ++jsonRow)
+	{
+		int gameRow = (out.rows - 1) - jsonRow;
+
+		for (int col = 0; col < out.cols && col < (int)mapArray[jsonRow].size(); ++col)
+		{
+			int tileIndex = mapArray[jsonRow][col].get<int>();
+			if (tileIndex < 0 || tileIndex >= (int)tileArray.size())
+				continue;
+
+			const json& tile = tileArray[tileIndex];
+			int idx = out.TileIndex(gameRow, col);
+
+			TileKind kind = TileKeyToKind(tile.value("tileKey", "tile_forbidden"));
+			out.tiles[idx] = kind;
+			out.buildable[idx] = (uint8_t)tile.value("buildableType", 0);
+
+			if (tile.contains("passableMask"))
+			{
+				out.passable[idx] = (tile["passableMask"].get<int>() & 1) ? 1 : 0;
+			}
+			else
+			{
+				out.passable[idx] = (kind == TileKind::Road || kind == TileKind::Start || kind == TileKind::End) ? 1 : 0;
+			}
+		}
+	}
+
+	if (levelData.contains("routes"))
+	{
+		for (const auto& route : levelData["routes"])
+		{
+			out.routes.push_back(ResolveRoute(out, route));
+		}
+	}
+
+	out.spawns = BuildSpawnEvents(levelData, &out.randomGroups);
+
+	return true;
+}
+
+ResolvedRoute ResolveRoute(const LevelGrid& grid, const json& route)
+{
+	ResolvedRoute resolved;
+	resolved.isFlying = route.value("motionMode", 0) != 0;
+
+	resolved.waypoints.push_back(ReadPosition(route.value("startPosition", json::object())));
+	if (route.contains("checkpoints"))
+	{
+		for (const auto& cp : route["checkpoints"])
+		{
+			// type 0 = 이동 체크포인트, 나머지(대기 등)는 위치 변화 없음
+			if (cp.value("type", 0) != 0 || !cp.contains("position"))
+				continue;
+
+			resolved.waypoints.push_back(ReadPosition(cp["position"]));
+		}
+	}
+	resolved.waypoints.push_back(ReadPosition(route.value("endPosition", json::object())));
+
+	for (const auto& wp : resolved.waypoints)
+	{
+		if (!grid.InBounds(wp.row, wp.col))
+			return resolved;
+	}
+
+	bool allowDiagonal = route.value("allowDiagonalMove", true);
+	std::vector<GridPos> segment;
+
+	resolved.isValid = true;
+	resolved.path.push_back(resolved.waypoints.front());
+
+	for (size_t i = 1; i < resolved.waypoints.size(); ++i)
+	{
+		GridPos from = resolved.waypoints[i - 1];
+		GridPos to = resolved.waypoints[i];
+
+		bool found = true;
+		if (resolved.isFlying)
+		{
+			FindFlyingPath(from, to, segment);
+		}
+		else
+		{
+			found = FindGroundPath(grid, from, to, allowDiagonal, segment);
+		}
+
+		if (!found)
+		{
+			// 연결되지 않는 구간은 직선으로 대체하고 경로를 무효로 표시
+			resolved.isValid = false;
+			FindFlyingPath(from, to, segment);
+		}
+
+		resolved.path.insert(resolved.path.end(), segment.begin() + 1, segment.end());
+	}
+
+	return resolved;
+}
+
+double RandomSpawnGroup::Probability(int option) const
+{
+	double total = 0.0;
+	for (double w : weights)
+		total += std::max(0.0, w);
+
+	if (option < 0 || option >= (int)weights.size())
+		return 0.0;
+
+	// 가중치가 모두 0 이면 균등 확률
+	if (total <= 0.0)
+		return 1.0 / weights.size();
+
+	return std::max(0.0, weights[option]) / total;
+}
+
+int RandomSpawnGroup::HeaviestOption() const
+{
+	int best = 0;
+	for (int i = 1; i < (int)weights.size(); ++i)
+	{
+		if (weights[i] > weights[best])
+			best = i;
+	}
+	return best;
+}
+
+int RandomSpawnGroup::Pick(double u) const
+{
+	double acc = 0.0;
+	for (int i = 0; i < (int)weights.size(); ++i)
+	{
+		acc += Probability(i);
+		if (u < acc)
+			return i;
+	}
+	return (int)weights.size() - 1;
+}
+
+std::vector<SpawnEvent> BuildSpawnEvents(const json& levelData, std::vector<RandomSpawnGroup>* groups)
+{
+	std::vector<SpawnEvent> events;
+	std::vector<RandomSpawnGroup> localGroups;
+	std::vector<RandomSpawnGroup>& outGroups = groups ? *groups : localGroups;
+	outGroups.clear();
+
+	if (!levelData.contains("waves"))
+		return events;
+
+	// 웨이브는 순차 진행: 이전 웨이브의 마지막 스폰 + postDelay 이후 시작
+	double waveStart = 0.0;
+	int waveIndex = 0;
+
+	for (const auto& wave : levelData["waves"])
+	{
+		double waveBase = waveStart + wave.value("preDelay", 0.0);
+		double waveEnd = waveBase;
+
+		if (wave.contains("fragments"))
+		{
+			int fragmentIndex = 0;
+			for (const auto& fragment : wave["fragments"])
+			{
+				// Fragment preDelay 는 웨이브 시작 기준 (LevelEditor 툴팁과 동일)
+				double fragmentBase = waveBase + fragment.value("preDelay", 0.0);
+
+				if (fragment.contains("actions"))
+				{
+					int actionIndex = 0;
+					for (const auto& action : fragment["actions"])
+					{
+						if (action.value("actionType", 0) != 0)
+						{
+							++actionIndex;
+							continue;
+						}
+
+						std::string key = action.contains("key") && action["key"].is_string()
+							? action["key"].get<std::string>() : std::string();
+						int count = std::max(0, action.value("count", 1));
+						double interval = action.value("interval", 0.0);
+						double actionBase = fragmentBase + action.value("preDelay", 0.0);
+
+						// 랜덤 그룹 / 팩 등록
+						int groupIndex = -1;
+						int optionIndex = -1;
+						if (action.contains("randomSpawnGroupKey") && action["randomSpawnGroupKey"].is_string())
+						{
+							std::string groupKey = action["randomSpawnGroupKey"].get<std::string>();
+							for (int g = 0; g < (int)outGroups.size(); ++g)
+							{
+								if (outGroups[g].waveIndex == waveIndex && outGroups[g].key == groupKey)
+								{
+									groupIndex = g;
+									break;
+								}
+							}
+
+							if (groupIndex < 0)
+							{
+								RandomSpawnGroup group;
+								group.key = groupKey;
+								group.waveIndex = waveIndex;
+								group.randomType = action.value("randomType", 0);
+								outGroups.push_back(group);
+								groupIndex = (int)outGroups.size() - 1;
+							}
+
+							RandomSpawnGroup& group = outGroups[groupIndex];
+							std::string optionKey = (action.contains("randomSpawnGroupPackKey") && action["randomSpawnGroupPackKey"].is_string())
+								? action["randomSpawnGroupPackKey"].get<std::string>()
+								: "#" + std::to_string(fragmentIndex) + "/" + std::to_string(actionIndex);
+
+							auto it = std::find(group.optionKeys.begin(), group.optionKeys.end(), optionKey);
+							if (it == group.optionKeys.end())
+							{
+								group.optionKeys.push_back(optionKey);
+								group.weights.push_back(action.value("weight", 0.0));
+								optionIndex = (int)group.optionKeys.size() - 1;
+							}
+							else
+							{
+								// 팩의 가중치는 첫 액션 기준
+								optionIndex = (int)(it - group.optionKeys.begin());
+							}
+						}
+
+						for (int i = 0; i < count; ++i)
+						{
+							SpawnEvent ev;
+							ev.time = actionBase + interval * i;
+							ev.enemyKey = key;
+							ev.routeIndex = action.value("routeIndex", 0);
+							ev.waveIndex = waveIndex;
+							ev.fragmentIndex = fragmentIndex;
+							ev.actionIndex = actionIndex;
+							ev.randomGroup = groupIndex;
+							ev.randomOption = optionIndex;
+							events.push_back(ev);
+
+							waveEnd = std::max(waveEnd, ev.time);
+						}
+
+						++actionIndex;
+					}
+				}
+
+				++fragmentIndex;
+			}
+		}
+
+		waveStart = waveEnd + wave.value("postDelay", 0.0);
+		++waveIndex;
+	}
+
+	std::stable_sort(events.begin(), events.end(), [](const SpawnEvent& a, const SpawnEvent& b)
+		{
+			return a.time < b.time;
+		});
+
+	return events;
+}
@@ -0,0 +1,98 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::ordered_json;
+
+// 게임 좌표 (row 0 = 맨 아래)
+struct GridPos
+{
+	int row = -1;
+	int col = -1;
+
+	bool operator==(const GridPos& other) const { return row == other.row && col == other.col; }
+};
+
+enum class TileKind : uint8_t
+{
+	Forbidden = 0,
+	Road,
+	HighGround,
+	Start,
+	End,
+	Other
+};
+
+struct LevelOptions
+{
+	int characterLimit = 8;
+	int maxLifePoint = 3;
+	int initialCost = 10;
+	int maxCost = 99;
+	double costIncreaseTime = 1.0;
+	double moveMultiplier = 0.5;
+};
+
+// 체크포인트를 타일 경로로 풀어낸 경로
+struct ResolvedRoute
+{
+	bool isFlying = false;
+	bool isValid = false;				// 모든 구간이 연결되었는지
+	std::vector<GridPos> waypoints;		// 시작, 체크포인트..., 종료
+	std::vector<GridPos> path;			// 시작부터 종료까지 지나가는 타일
+};
+
+// waves[].fragments[].actions[] 를 시간순으로 펼친 스폰 이벤트
+struct SpawnEvent
+{
+	double time = 0.0;
+	std::string enemyKey;
+	int routeIndex = 0;
+	int waveIndex = 0;
+	int fragmentIndex = 0;
+	int actionIndex = 0;
+	int randomGroup = -1;				// LevelGrid::randomGroups 인덱스 (-1 = 항상 스폰)
+	int randomOption = -1;				// 그룹 내 옵션 인덱스
+};
+
+// randomSpawnGroupKey 가 같은 액션 묶음 (웨이브 단위)
+// 그룹마다 옵션 하나가 weight 비례 확률로 선택되며, 같은 randomSpawnGroupPackKey 를 가진 액션은 하나의 옵션으로 함께 스폰됨
+struct RandomSpawnGroup
+{
+	std::string key;
+	int waveIndex = 0;
+	int randomType = 0;
+	std::vector<std::string> optionKeys;	// 팩 키 (팩이 없으면 액션 위치)
+	std::vector<double> weights;			// 옵션별 가중치
+
+	double Probability(int option) const;
+	int HeaviestOption() const;
+	int Pick(double u) const;				// u in [0, 1)
+};
+
+struct LevelGrid
+{
+	std::string levelId;
+	int rows = 0;
+	int cols = 0;
+	std::vector<TileKind> tiles;		// index = row * cols + col (게임 좌표)
+	std::vector<uint8_t> buildable;		// 0. 불가, 1. 지상, 2. 고지대
+	std::vector<uint8_t> passable;		// 지상 유닛 통과 가능 여부
+	LevelOptions options;
+	std::vector<ResolvedRoute> routes;
+	std::vector<SpawnEvent> spawns;
+	std::vector<RandomSpawnGroup> randomGroups;
+
+	bool InBounds(int row, int col) const { return row >= 0 && row < rows && col >= 0 && col < cols; }
+	int TileIndex(int row, int col) const { return row * cols + col; }
+	bool IsPassable(int row, int col) const { return InBounds(row, col) && passable[TileIndex(row, col)] != 0; }
+};
+
+// 레벨 JSON (LevelEditor::LevelData::fullData 와 같은 형식)에서 그리드, 경로, 스폰을 구성
+bool BuildLevelGrid(const json& levelData, LevelGrid& out);
+
+ResolvedRoute ResolveRoute(const LevelGrid& grid, const json& route);
+std::vector<SpawnEvent> BuildSpawnEvents(const json& levelData, std::vector<RandomSpawnGroup>* groups = nullptr);
+LevelOptions ReadLevelOptions(const json& levelData);
@@ -1,63 +1,156 @@
 #include "Migration.h"
+#include "Parallel.h"
 #include "Utility.h"
 #include <iostream>
-#include <sstream>
 
-std::map<Migration::DataType, std::vector<std::tuple<std::string, std::string, MigrationFunc>>>&
-Migration::GetRegistry()
+MigrationVersion MigrationVersion::Parse(const std::string& text)
 {
-    static std::map<DataType, std::vector<std::tuple<std::string, std::string, MigrationFunc>>> registry;
+    //    4ڸ,  ڸ  ڸ (ڰ  0)
+    MigrationVersion version;
+    size_t part = 0;
+    size_t i = 0;
+    while (part < version.parts.size() && i <= text.size())
+    {
+        int value = 0;
+        while (i < text.size() && text[i] >= '0' && text[i] <= '9')
+            value = value * 10 + (text[i++] - '0');
+        version.parts[part++] = value;
+
+        while (i < text.size() && text[i] != '.')
+            ++i;
+        if (i >= text.size())
+            break;
+        ++i;
+    }
+    return version;
+}
+
+std::string MigrationVersion::ToString() const
+{
+    size_t count = parts.size();
+    while (count > 2 && parts[count - 1] == 0)
+        --count;
+
+    std::string text = std::to_string(parts[0]);
+    for (size_t i = 1; i < count; ++i)
+        text += "." + std::to_string(parts[i]);
+    return text;
+}
+
+Migration::Registry& Migration::GetRegistry()
+{
+    static Registry registry;
     return registry;
 }
 
+void Migration::Add(DataType type, const std::string& fromVersion,
+    const std::string& toVersion, MigrationFunc func, bool perRecord)
+{
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    // ȹ ܰ 迭 ŰǷ  ٲ 
+    registry.plans.clear();
+    registry.steps[type].push_back({ MigrationVersion::Parse(fromVersion), MigrationVersion::Parse(toVersion), std::move(func), perRecord });
+}
+
 void Migration::Register(DataType type, const std::string& fromVersion,
     const std::string& toVersion, MigrationFunc func)
 {
-    GetRegistry()[type].push_back({ fromVersion, toVersion, func });
+    Add(type, fromVersion, toVersion, std::move(func), false);
 }
 
-int Migration::CompareVersions(const std::string& a, const std::string& b)
+void Migration::RegisterRecord(DataType type, const std::string& fromVersion,
+    const std::string& toVersion, MigrationFunc func)
 {
-    auto parse = [](const std::string& v) -> std::vector<int> {
-        std::vector<int> parts;
-        std::stringstream ss(v);
-        std::string item;
-        while (std::getline(ss, item, '.')) {
-            try { parts.push_back(std::stoi(item)); }
-            catch (...) { parts.push_back(0); }
-        }
-        return parts;
-        };
+    Add(type, fromVersion, toVersion, std::move(func), true);
+}
+
+const MigrationPlan& Migration::BuildPlan(Registry& registry, DataType type, const MigrationVersion& fromVersion)
+{
+    MigrationPlan& plan = registry.plans[{ type, fromVersion }];
+    plan.fromVersion = fromVersion;
+
+    // fromVersion <= from, to <=   ܰ踦  
+    bool lastPerRecord = false;
+    for (const MigrationStep& step : registry.steps[type])
+    {
+        if (step.from < fromVersion || registry.current < step.to)
+            continue;
+
+        if (plan.runs.empty() || !step.perRecord || !lastPerRecord)
+            plan.runs.emplace_back();
+        plan.runs.back().push_back(&step);
+        lastPerRecord = step.perRecord;
+        ++plan.stepCount;
+    }
+
+    std::cout << "[Migration] Plan " << TypeName(type) << " v" << fromVersion.ToString() << " -> v" << registry.current.ToString()
+        << ": " << plan.stepCount << " steps\n";
+    return plan;
+}
 
-    auto va = parse(a);
-    auto vb = parse(b);
+void Migration::Compile()
+{
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
 
-    size_t maxLen = std::max(va.size(), vb.size());
-    va.resize(maxLen, 0);
-    vb.resize(maxLen, 0);
+    registry.current = MigrationVersion::Parse(VERSION);
+    registry.plans.clear();
 
-    for (size_t i = 0; i < maxLen; ++i) {
-        if (va[i] < vb[i]) return -1;
-        if (va[i] > vb[i]) return 1;
+    // ϵ   +    (0.0)
+    for (auto& [type, steps] : registry.steps)
+    {
+        BuildPlan(registry, type, MigrationVersion());
+        for (const MigrationStep& step : steps)
+        {
+            if (!registry.plans.count({ type, step.from }))
+                BuildPlan(registry, type, step.from);
+        }
     }
-    return 0;
 }
 
-void Migration::RunMigrations(DataType type, json& data,
-    const std::string& fromVersion,
-    const std::string& toVersion)
+const MigrationPlan& Migration::GetPlan(DataType type, const MigrationVersion& fromVersion)
+{
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    if (registry.current == MigrationVersion())
+        registry.current = MigrationVersion::Parse(VERSION);
+
+    auto found = registry.plans.find({ type, fromVersion });
+    if (found != registry.plans.end())
+        return found->second;
+    return BuildPlan(registry, type, fromVersion);
+}
+
+void Migration::Apply(DataType type, const MigrationPlan& plan, json& data)
 {
-    auto& registry = GetRegistry()[type];
+    const char* recordKey = RecordArrayKey(type);
 
-    for (auto& [from, to, func] : registry)
+    for (const auto& run : plan.runs)
     {
-        // fromVersion <= from < to <= toVersion   
-        if (CompareVersions(fromVersion, from) <= 0 &&
-            CompareVersions(to, toVersion) <= 0)
+        json* records = nullptr;
+        if (run.front()->perRecord && recordKey && data.contains(recordKey) && data[recordKey].is_array())
+            records = &data[recordKey];
+
+        if (!records)
         {
-            std::cout << "[Migration] Running: " << from << " -> " << to << "\n";
-            func(data);
+            for (const MigrationStep* step : run)
+                step->func(data);
+            continue;
         }
+
+        // ڵ ϳ  ܰ踦   (ڵ带   )
+        ParallelFor(records->size(), 256, [&](size_t begin, size_t end, unsigned)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    json& record = (*records)[i];
+                    for (const MigrationStep* step : run)
+                        step->func(record);
+                }
+            });
     }
 }
 
@@ -69,11 +162,8 @@ bool Migration::CheckAndMigrate(DataType type, json& data)
     if (dataVersion == currentVersion)
         return false;  // ̹ ֽ
 
-    std::cout << "[Migration] Upgrading from v" << dataVersion
-        << " to v" << currentVersion << "\n";
-
-    // ϵ ̱׷̼ 
-    RunMigrations(type, data, dataVersion, currentVersion);
+    // ϵ ̱׷̼  ( ȹ ó   )
+    Apply(type, GetPlan(type, MigrationVersion::Parse(dataVersion)), data);
 
     //  Ʈ
     data["version"] = currentVersion;
@@ -81,6 +171,29 @@ bool Migration::CheckAndMigrate(DataType type, json& data)
     return true;  //  ʿ
 }
 
+const char* Migration::RecordArrayKey(DataType type)
+{
+    switch (type)
+    {
+    case DataType::Operator: return "operators";
+    case DataType::Enemy: return "enemies";
+    case DataType::Skill: return "skills";
+    default: return nullptr;
+    }
+}
+
+const char* Migration::TypeName(DataType type)
+{
+    switch (type)
+    {
+    case DataType::Operator: return "Operator";
+    case DataType::Enemy: return "Enemy";
+    case DataType::Skill: return "Skill";
+    case DataType::Level: return "Level";
+    default: return "?";
+    }
+}
+
 // ===== ̱׷̼  =====
 void RegisterAllMigrations()
 {
@@ -93,6 +206,18 @@ void RegisterAllMigrations()
     //     }
     // );
 
+    // ڵ ϳ ٲٴ ȯ RegisterRecord (ڵ帶 ķ )
+    // Migration::RegisterRecord(
+    //     Migration::DataType::Enemy,
+    //     "2.1", "2.2",
+    //     [](json& enemy) {
+    //         // enemies[]  ϳ ȯ
+    //     }
+    // );
+
     //   ̱׷̼ (Ű  )
     // ߿ ʿ  ⿡ ߰
+
+    //   ȹ ̸ 
+    Migration::Compile();
 }
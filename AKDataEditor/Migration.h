@@ -1,13 +1,44 @@
 #pragma once
+#include <array>
 #include <string>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <vector>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::ordered_json;
 using MigrationFunc = std::function<void(json&)>;
 
+// "2.1" -> {2, 1, 0, 0} (/ȹ     а 񱳴 )
+struct MigrationVersion
+{
+    std::array<int, 4> parts{};
+
+    static MigrationVersion Parse(const std::string& text);
+    std::string ToString() const;
+
+    auto operator<=>(const MigrationVersion&) const = default;
+};
+
+// ̱׷̼  ܰ ( ü Ǵ ڵ ϳ)
+struct MigrationStep
+{
+    MigrationVersion from;
+    MigrationVersion to;
+    MigrationFunc func;
+    bool perRecord = false;     // true  ڵ 迭 Ҹ ȣ (  ϳ ڵ)
+};
+
+// (DataType,  )      
+// ̾ ڵ ܰ  , ڵ ϳ  ܰ踦     ڵ Ѿ
+struct MigrationPlan
+{
+    MigrationVersion fromVersion;
+    std::vector<std::vector<const MigrationStep*>> runs;     //  =  ܰ ϳ Ǵ ̾ ڵ ܰ
+    int stepCount = 0;
+};
+
 class Migration
 {
 public:
@@ -19,21 +50,43 @@ public:
         Level
     };
 
-    // ̱׷̼ 
+    // ̱׷̼  ( ü ȯ)
     static void Register(DataType type, const std::string& fromVersion,
         const std::string& toVersion, MigrationFunc func);
 
+    // ڵ ϳ ȯ (enemies[] / operators[] / skills[]  , ū 迭  ھ  ó)
+    static void RegisterRecord(DataType type, const std::string& fromVersion,
+        const std::string& toVersion, MigrationFunc func);
+
+    //     : ϵ  ȹ ̸  
+    static void Compile();
+
     //  üũ + ̱׷̼  +  Ʈ
     // ȯ: true  ʿ
+    // ȹ ĳô  Ƿ  忡 ÿ ҷ  ( Լ Է¸ ľ )
     static bool CheckAndMigrate(DataType type, json& data);
 
+    // fromVersion  Ͽ  ȹ (ó  ̸  ĳ)
+    static const MigrationPlan& GetPlan(DataType type, const MigrationVersion& fromVersion);
+    static void Apply(DataType type, const MigrationPlan& plan, json& data);
+
+    // ڵ 迭 Ű ( nullptr =  ü ڵ ϳ)
+    static const char* RecordArrayKey(DataType type);
+    static const char* TypeName(DataType type);
+
 private:
-    static int CompareVersions(const std::string& a, const std::string& b);
-    static void RunMigrations(DataType type, json& data,
-        const std::string& fromVersion,
-        const std::string& toVersion);
+    struct Registry
+    {
+        std::map<DataType, std::vector<MigrationStep>> steps;
+        std::map<std::pair<DataType, MigrationVersion>, MigrationPlan> plans;
+        MigrationVersion current;
+        std::mutex mutex;
+    };
 
-    static std::map<DataType, std::vector<std::tuple<std::string, std::string, MigrationFunc>>>& GetRegistry();
+    static void Add(DataType type, const std::string& fromVersion,
+        const std::string& toVersion, MigrationFunc func, bool perRecord);
+    static const MigrationPlan& BuildPlan(Registry& registry, DataType type, const MigrationVersion& fromVersion);
+    static Registry& GetRegistry();
 };
 
 //    ȣ
@@ -0,0 +1,412 @@
+﻿#include "MigrationDryRun.h"
+#include "Migration.h"
+#include "DataFiles.h"
+#include "GameTables.h"
+#include "RangeTable.h"
+#include "Parallel.h"
+#include "Utility.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	double MsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	struct DryRunDocument
+	{
+		Migration::DataType type = Migration::DataType::Level;
+		std::string file;
+		std::string path;
+		std::string levelId;		// 레벨만
+
+		json before;
+		json after;
+		const MigrationPlan* plan = nullptr;
+		bool outdated = false;
+		bool failed = false;
+		std::string error;
+
+		std::vector<MigrationRecordDiff> diffs;
+	};
+
+	// 스레드별 단계 시간 (단계 번호 순)
+	struct StepClock
+	{
+		int64_t calls = 0;
+		double ms = 0.0;
+	};
+	using StepIndex = std::unordered_map<const MigrationStep*, int>;
+
+	const char* RecordKeyField(Migration::DataType type)
+	{
+		switch (type)
+		{
+		case Migration::DataType::Enemy: return "key";
+		case Migration::DataType::Operator: return "charId";
+		case Migration::DataType::Skill: return "skillId";
+		default: return nullptr;
+		}
+	}
+
+	void RunTimed(const std::vector<const MigrationStep*>& run, json& target, StepClock* clocks, const StepIndex& stepIndex)
+	{
+		for (const MigrationStep* step : run)
+		{
+			auto start = Clock::now();
+			step->func(target);
+			StepClock& clock = clocks[stepIndex.at(step)];
+			clock.ms += MsSince(start);
+			++clock.calls;
+		}
+	}
+
+	// Migration::Apply 와 같은 순서로 적용하고 단계마다 시간을 잼
+	// parallelRecords = 테이블처럼 파일 하나의 레코드를 여러 코어에서 나눌지
+	void ApplyTimed(DryRunDocument& doc, bool parallelRecords, unsigned worker,
+		std::vector<std::vector<StepClock>>& clocks, const StepIndex& stepIndex)
+	{
+		const char* recordKey = Migration::RecordArrayKey(doc.type);
+
+		for (const auto& run : doc.plan->runs)
+		{
+			json* records = nullptr;
+			if (run.front()->perRecord && recordKey && doc.after.contains(recordKey) && doc.after[recordKey].is_array())
+				records = &doc.after[recordKey];
+
+			if (!records)
+			{
+				RunTimed(run, doc.after, clocks[worker].data(), stepIndex);
+				continue;
+			}
+
+			if (parallelRecords)
+			{
+				ParallelFor(records->size(), 256, [&](size_t begin, size_t end, unsigned recordWorker)
+					{
+						for (size_t i = begin; i < end; ++i)
+							RunTimed(run, (*records)[i], clocks[recordWorker].data(), stepIndex);
+					});
+			}
+			else
+			{
+				for (json& record : *records)
+					RunTimed(run, record, clocks[worker].data(), stepIndex);
+			}
+		}
+
+		doc.after["version"] = VERSION;
+	}
+
+	// before -> after 패치를 바뀔 값 목록으로 (version 은 모든 파일에서 바뀌므로 뺌)
+	void AppendChanges(const json& before, const json& after, std::vector<MigrationValueChange>& out, bool skipVersion)
+	{
+		json patch = json::diff(before, after);
+		for (const json& op : patch)
+		{
+			MigrationValueChange change;
+			change.op = op.value("op", "");
+			change.path = op.value("path", "");
+			if (skipVersion && change.path == "/version")
+				continue;
+
+			json::json_pointer pointer(change.path);
+			if (change.op != "add" && before.contains(pointer))
+				change.before = before.at(pointer);
+			if (op.contains("value"))
+				change.after = op["value"];
+			out.push_back(std::move(change));
+		}
+	}
+
+	std::string RecordLabel(const json& record, const char* keyField, size_t index)
+	{
+		if (keyField && record.is_object() && record.contains(keyField) && record[keyField].is_string())
+			return record[keyField].get<std::string>();
+		return "#" + std::to_string(index);
+	}
+
+	void DiffDocument(DryRunDocument& doc)
+	{
+		const char* recordKey = Migration::RecordArrayKey(doc.type);
+		bool hasRecords = recordKey && doc.before.contains(recordKey) && doc.before[recordKey].is_array()
+			&& doc.after.contains(recordKey) && doc.after[recordKey].is_array();
+
+		if (!hasRecords)
+		{
+			MigrationRecordDiff diff;
+			diff.file = doc.file;
+			diff.record = doc.levelId.empty() ? "(파일)" : doc.levelId;
+			AppendChanges(doc.before, doc.after, diff.changes, true);
+			if (!diff.changes.empty())
+				doc.diffs.push_back(std::move(diff));
+			return;
+		}
+
+		// 배열 밖 필드 (레코드 배열은 비워서 비교)
+		{
+			json beforeRest = doc.before;
+			json afterRest = doc.after;
+			beforeRest.erase(recordKey);
+			afterRest.erase(recordKey);
+
+			MigrationRecordDiff diff;
+			diff.file = doc.file;
+			diff.record = "(파일)";
+			AppendChanges(beforeRest, afterRest, diff.changes, true);
+			if (!diff.changes.empty())
+				doc.diffs.push_back(std::move(diff));
+		}
+
+		// 레코드는 같은 인덱스끼리, 개수가 달라지면 남는 쪽은 통째로 추가/삭제
+		const json& before = doc.before[recordKey];
+		const json& after = doc.after[recordKey];
+		const char* keyField = RecordKeyField(doc.type);
+		size_t count = std::max(before.size(), after.size());
+		for (size_t i = 0; i < count; ++i)
+		{
+			MigrationRecordDiff diff;
+			diff.file = doc.file;
+
+			if (i >= before.size())
+			{
+				diff.record = RecordLabel(after[i], keyField, i);
+				diff.changes.push_back({ "add", "", json(), after[i] });
+			}
+			else if (i >= after.size())
+			{
+				diff.record = RecordLabel(before[i], keyField, i);
+				diff.changes.push_back({ "remove", "", before[i], json() });
+			}
+			else
+			{
+				if (before[i] == after[i])
+					continue;
+				diff.record = RecordLabel(before[i], keyField, i);
+				AppendChanges(before[i], after[i], diff.changes, false);
+			}
+
+			if (!diff.changes.empty())
+				doc.diffs.push_back(std::move(diff));
+		}
+	}
+}
+
+MigrationDryRunReport RunMigrationDryRun(const std::string& solutionPath)
+{
+	MigrationDryRunReport report;
+	auto totalStart = Clock::now();
+
+	std::vector<DryRunDocument> docs;
+	auto addDoc = [&](Migration::DataType type, const std::string& path)
+		{
+			DryRunDocument doc;
+			doc.type = type;
+			doc.file = fs::path(path).filename().string();
+			doc.path = path;
+			docs.push_back(std::move(doc));
+		};
+
+	addDoc(Migration::DataType::Enemy, DataFilePath(solutionPath, Migration::DataType::Enemy));
+	addDoc(Migration::DataType::Operator, DataFilePath(solutionPath, Migration::DataType::Operator));
+	addDoc(Migration::DataType::Skill, DataFilePath(solutionPath, Migration::DataType::Skill));
+	size_t tableCount = docs.size();
+
+	std::string levelPath = DataFilePath(solutionPath, Migration::DataType::Level);
+	for (const std::string& fileName : ListLevelFiles(levelPath))
+	{
+		addDoc(Migration::DataType::Level, levelPath + fileName);
+		docs.back().levelId = LevelIdFromFileName(fileName);
+	}
+
+	// 1. 읽기 (파일마다 병렬)
+	auto loadStart = Clock::now();
+	ParallelFor(docs.size(), 1, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				DryRunDocument& doc = docs[i];
+				if (!LoadJsonFile(doc.path, doc.before))
+				{
+					doc.failed = true;
+					doc.error = doc.file + ": 읽을 수 없음";
+					continue;
+				}
+
+				try
+				{
+					// 편집기 로드와 같게 rangeId 를 range 배열로 펼친 뒤 비교
+					if (doc.type == Migration::DataType::Operator)
+						ExpandRangeReferences(doc.before, "operators", doc.path);
+					else if (doc.type == Migration::DataType::Skill)
+						ExpandRangeReferences(doc.before, "skills", doc.path);
+
+					std::string version = doc.before.value("version", std::string("0.0"));
+					doc.outdated = version != VERSION;
+				}
+				catch (const json::exception& e)
+				{
+					doc.failed = true;
+					doc.error = doc.file + ": " + e.what();
+				}
+			}
+		});
+	report.loadMs = MsSince(loadStart);
+
+	// 2. 계획과 단계 번호 (단계 시간은 스레드마다 따로 모아 합침)
+	StepIndex stepIndex;
+	std::vector<const MigrationStep*> steps;
+	std::vector<Migration::DataType> stepTypes;
+	std::vector<int> outdated;
+	for (int i = 0; i < (int)docs.size(); ++i)
+	{
+		DryRunDocument& doc = docs[i];
+		if (doc.failed || !doc.outdated)
+			continue;
+
+		doc.plan = &Migration::GetPlan(doc.type, MigrationVersion::Parse(doc.before.value("version", std::string("0.0"))));
+		for (const auto& run : doc.plan->runs)
+		{
+			for (const MigrationStep* step : run)
+			{
+				if (stepIndex.emplace(step, (int)steps.size()).second)
+				{
+					steps.push_back(step);
+					stepTypes.push_back(doc.type);
+				}
+			}
+		}
+		outdated.push_back(i);
+	}
+
+	std::vector<std::vector<StepClock>> clocks(GetWorkerCount(), std::vector<StepClock>(steps.size()));
+
+	// 3. 사본에 적용: 테이블은 레코드마다, 레벨은 파일마다 병렬
+	auto migrateStart = Clock::now();
+	auto migrate = [&](DryRunDocument& doc, bool parallelRecords, unsigned worker)
+		{
+			try
+			{
+				doc.after = doc.before;
+				ApplyTimed(doc, parallelRecords, worker, clocks, stepIndex);
+			}
+			catch (const std::exception& e)
+			{
+				doc.failed = true;
+				doc.error = doc.file + ": 마이그레이션 실패: " + e.what();
+			}
+		};
+
+	std::vector<int> levelDocs;
+	for (int index : outdated)
+	{
+		if ((size_t)index < tableCount)
+			migrate(docs[index], true, 0);
+		else
+			levelDocs.push_back(index);
+	}
+	ParallelFor(levelDocs.size(), 4, [&](size_t begin, size_t end, unsigned worker)
+		{
+			for (size_t i = begin; i < end; ++i)
+				migrate(docs[levelDocs[i]], false, worker);
+		});
+	report.migrateMs = MsSince(migrateStart);
+
+	// 4. 레코드별 비교 (파일마다 병렬)
+	auto diffStart = Clock::now();
+	ParallelFor(outdated.size(), 1, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				DryRunDocument& doc = docs[outdated[i]];
+				if (!doc.failed)
+					DiffDocument(doc);
+			}
+		});
+	report.diffMs = MsSince(diffStart);
+
+	// 5. 모으기
+	for (DryRunDocument& doc : docs)
+	{
+		++report.files;
+		if (doc.failed)
+		{
+			++report.failed;
+			report.errors.push_back(doc.error);
+			continue;
+		}
+		if (!doc.outdated)
+			continue;
+
+		++report.outdated;
+		const char* recordKey = Migration::RecordArrayKey(doc.type);
+		report.records += (recordKey && doc.before.contains(recordKey) && doc.before[recordKey].is_array())
+			? (int64_t)doc.before[recordKey].size() : 1;
+
+		for (MigrationRecordDiff& diff : doc.diffs)
+		{
+			++report.changedRecords;
+			report.changes += (int)diff.changes.size();
+			report.diffs.push_back(std::move(diff));
+		}
+	}
+
+	for (size_t s = 0; s < steps.size(); ++s)
+	{
+		MigrationStepReport step;
+		step.type = Migration::TypeName(stepTypes[s]);
+		step.from = steps[s]->from.ToString();
+		step.to = steps[s]->to.ToString();
+		step.perRecord = steps[s]->perRecord;
+		for (const auto& workerClocks : clocks)
+		{
+			step.calls += workerClocks[s].calls;
+			step.ms += workerClocks[s].ms;
+		}
+		report.steps.push_back(std::move(step));
+	}
+
+	report.totalMs = MsSince(totalStart);
+	return report;
+}
+
+json MigrationDryRunReport::ToJson() const
+{
+	json out;
+	out["files"] = files;
+	out["outdated"] = outdated;
+	out["failed"] = failed;
+	out["records"] = records;
+	out["changedRecords"] = changedRecords;
+	out["changes"] = changes;
+	out["ms"] = { {"load", loadMs}, {"migrate", migrateMs}, {"diff", diffMs}, {"total", totalMs} };
+	out["recordsPerSecond"] = RecordsPerSecond();
+
+	out["steps"] = json::array();
+	for (const MigrationStepReport& step : steps)
+	{
+		out["steps"].push_back({
+			{"type", step.type}, {"from", step.from}, {"to", step.to}, {"perRecord", step.perRecord},
+			{"calls", step.calls}, {"ms", step.ms}, {"callsPerSecond", step.CallsPerSecond()} });
+	}
+
+	out["diffs"] = json::array();
+	for (const MigrationRecordDiff& diff : diffs)
+	{
+		json changes = json::array();
+		for (const MigrationValueChange& change : diff.changes)
+			changes.push_back({ {"op", change.op}, {"path", change.path}, {"before", change.before}, {"after", change.after} });
+		out["diffs"].push_back({ {"file", diff.file}, {"record", diff.record}, {"changes", std::move(changes)} });
+	}
+
+	out["errors"] = errors;
+	return out;
+}
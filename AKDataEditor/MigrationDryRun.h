@@ -0,0 +1,64 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::ordered_json;
+
+// 레코드 안에서 바뀔 값 하나 (RFC 6902 패치 한 줄 + 이전 값)
+struct MigrationValueChange
+{
+	std::string op;			// add / remove / replace
+	std::string path;		// 레코드 기준 JSON 포인터
+	json before;
+	json after;
+};
+
+// 레코드 하나의 변경 (테이블 = 배열 원소 하나, 레벨 = 파일 하나)
+struct MigrationRecordDiff
+{
+	std::string file;		// enemies_table.json, level_main_00-01.json
+	std::string record;		// 적 키 / charId / skillId / 레벨 ID, 배열 밖 필드는 "(파일)"
+	std::vector<MigrationValueChange> changes;
+};
+
+// 등록된 단계 하나의 실행 시간 (모든 스레드 합)
+struct MigrationStepReport
+{
+	std::string type;
+	std::string from;
+	std::string to;
+	bool perRecord = false;
+	int64_t calls = 0;		// 함수 호출 수 (레코드 단계면 레코드 수)
+	double ms = 0.0;
+
+	double CallsPerSecond() const { return ms > 0.0 ? calls * 1000.0 / ms : 0.0; }
+};
+
+struct MigrationDryRunReport
+{
+	int files = 0;				// 읽은 파일
+	int outdated = 0;			// 버전이 달라 마이그레이션 대상인 파일
+	int failed = 0;				// 읽지 못했거나 단계에서 예외
+	int64_t records = 0;		// 대상 파일의 레코드 수
+	int changedRecords = 0;
+	int changes = 0;			// 바뀔 값 수 (version 필드 제외)
+
+	double loadMs = 0.0;
+	double migrateMs = 0.0;
+	double diffMs = 0.0;
+	double totalMs = 0.0;
+
+	std::vector<MigrationStepReport> steps;
+	std::vector<MigrationRecordDiff> diffs;		// 파일 순서, 파일 안에서는 레코드 순서
+	std::vector<std::string> errors;
+
+	double RecordsPerSecond() const { return migrateMs > 0.0 ? records * 1000.0 / migrateMs : 0.0; }
+	json ToJson() const;
+};
+
+// 솔루션의 테이블과 레벨을 읽어 메모리 사본에 등록된 마이그레이션을 적용해 보고, 바뀔 값만 모음
+// 파일은 쓰지 않음 (편집기의 로드와 같게 오퍼레이터/스킬 범위 참조는 펼친 뒤 적용)
+// 읽기/레벨 적용/비교는 파일마다, 테이블의 레코드 단계는 레코드마다 모든 코어에서 처리
+MigrationDryRunReport RunMigrationDryRun(const std::string& solutionPath);
@@ -0,0 +1,164 @@
+﻿#include "MigrationDryRunWindow.h"
+#include <imgui/imgui.h>
+
+#include "Utility.h"
+
+void MigrationDryRunWindow::RenderGUI(bool* p_open, const std::string& solutionPath)
+{
+	ImGui::SetNextWindowSize(ImVec2(1000, 550), ImGuiCond_FirstUseEver);
+	ImGui::Begin("마이그레이션 미리보기", p_open);
+
+	if (solutionPath.empty()) ImGui::BeginDisabled();
+	if (ImGui::Button("실행"))
+	{
+		_report = RunMigrationDryRun(solutionPath);
+		_hasReport = true;
+		_rowsDirty = true;
+	}
+	if (solutionPath.empty()) ImGui::EndDisabled();
+
+	ImGui::SameLine();
+	ImGui::TextColored(COLOR_GRAY, "현재 버전 v%s, 파일은 쓰지 않음", VERSION);
+
+	if (!_hasReport)
+	{
+		ImGui::End();
+		return;
+	}
+
+	// 요약
+	ImGui::Text("파일 %d개 / 대상 %d개 / 레코드 %lld개 -> 바뀔 레코드 %d개, 값 %d개",
+		_report.files, _report.outdated, (long long)_report.records, _report.changedRecords, _report.changes);
+	ImGui::TextColored(COLOR_GRAY, "읽기 %.1f ms | 적용 %.1f ms (%.0f 레코드/s) | 비교 %.1f ms | 전체 %.1f ms",
+		_report.loadMs, _report.migrateMs, _report.RecordsPerSecond(), _report.diffMs, _report.totalMs);
+
+	for (const std::string& error : _report.errors)
+		ImGui::TextColored(COLOR_RED, "%s", error.c_str());
+
+	// 단계별 시간
+	if (!_report.steps.empty() && ImGui::CollapsingHeader("단계", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+		if (ImGui::BeginTable("DryRunSteps", 6, flags))
+		{
+			ImGui::TableSetupColumn("종류");
+			ImGui::TableSetupColumn("버전");
+			ImGui::TableSetupColumn("단위");
+			ImGui::TableSetupColumn("호출");
+			ImGui::TableSetupColumn("ms");
+			ImGui::TableSetupColumn("호출/s");
+			ImGui::TableHeadersRow();
+
+			for (const MigrationStepReport& step : _report.steps)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", step.type.c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%s -> %s", step.from.c_str(), step.to.c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", step.perRecord ? "레코드" : "파일");
+				ImGui::TableNextColumn();
+				ImGui::Text("%lld", (long long)step.calls);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", step.ms);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.0f", step.CallsPerSecond());
+			}
+			ImGui::EndTable();
+		}
+	}
+	else if (_report.steps.empty())
+	{
+		ImGui::TextColored(COLOR_GREEN, "적용할 마이그레이션 단계가 없습니다.");
+	}
+
+	ImGui::Separator();
+
+	ImGui::SetNextItemWidth(250);
+	if (ImGui::InputTextWithHint("##DryRunFilter", "파일 / 레코드 / 경로 검색", _filter, sizeof(_filter)))
+		_rowsDirty = true;
+
+	if (_rowsDirty)
+		RebuildRows();
+
+	ImGui::SameLine();
+	ImGui::Text("%d / %d", (int)_rows.size(), _report.changes);
+
+	if (_rows.empty())
+	{
+		ImGui::TextColored(COLOR_GREEN, "바뀔 값이 없습니다.");
+		ImGui::End();
+		return;
+	}
+
+	ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+	if (ImGui::BeginTable("DryRunDiff", 6, flags))
+	{
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("파일", ImGuiTableColumnFlags_WidthFixed, 170.0f);
+		ImGui::TableSetupColumn("레코드", ImGuiTableColumnFlags_WidthFixed, 140.0f);
+		ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed, 55.0f);
+		ImGui::TableSetupColumn("경로", ImGuiTableColumnFlags_WidthFixed, 200.0f);
+		ImGui::TableSetupColumn("이전");
+		ImGui::TableSetupColumn("이후");
+		ImGui::TableHeadersRow();
+
+		ImGuiListClipper clipper;
+		clipper.Begin((int)_rows.size());
+		while (clipper.Step())
+		{
+			for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+			{
+				const MigrationRecordDiff& diff = _report.diffs[_rows[i].diff];
+				const MigrationValueChange& change = diff.changes[_rows[i].change];
+
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", diff.file.c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", diff.record.c_str());
+				ImGui::TableNextColumn();
+				if (change.op == "add")
+					ImGui::TextColored(COLOR_GREEN, "추가");
+				else if (change.op == "remove")
+					ImGui::TextColored(COLOR_RED, "삭제");
+				else
+					ImGui::TextColored(COLOR_YELLOW, "변경");
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", change.path.empty() ? "(전체)" : change.path.c_str());
+				ImGui::TableNextColumn();
+				if (!change.before.is_null())
+					ImGui::TextWrapped("%s", change.before.dump().c_str());
+				ImGui::TableNextColumn();
+				if (!change.after.is_null())
+					ImGui::TextWrapped("%s", change.after.dump().c_str());
+			}
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
+void MigrationDryRunWindow::RebuildRows()
+{
+	_rows.clear();
+
+	std::string filter = _filter;
+	for (int d = 0; d < (int)_report.diffs.size(); ++d)
+	{
+		const MigrationRecordDiff& diff = _report.diffs[d];
+		bool recordMatches = filter.empty()
+			|| diff.file.find(filter) != std::string::npos
+			|| diff.record.find(filter) != std::string::npos;
+
+		for (int c = 0; c < (int)diff.changes.size(); ++c)
+		{
+			if (recordMatches || diff.changes[c].path.find(filter) != std::string::npos)
+				_rows.push_back({ d, c });
+		}
+	}
+
+	_rowsDirty = false;
+}
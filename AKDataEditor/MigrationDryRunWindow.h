@@ -0,0 +1,29 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+
+#include "MigrationDryRun.h"
+
+// 마이그레이션 미리보기 패널
+// "실행" 을 누를 때만 솔루션을 다시 읽어 사본에 적용 (파일과 편집 중인 데이터는 건드리지 않음)
+class MigrationDryRunWindow
+{
+public:
+	void RenderGUI(bool* p_open, const std::string& solutionPath);
+
+private:
+	MigrationDryRunReport _report;
+	bool _hasReport = false;
+
+	// 바뀔 값 한 줄 = (diffs 인덱스, changes 인덱스)
+	struct ChangeRow
+	{
+		int diff;
+		int change;
+	};
+	std::vector<ChangeRow> _rows;
+	char _filter[128] = "";
+	bool _rowsDirty = true;
+
+	void RebuildRows();
+};
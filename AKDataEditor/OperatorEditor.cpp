@@ -1,11 +1,17 @@
 ﻿#include "OperatorEditor.h"
 #include "Migration.h"
+#include "DataFiles.h"
+#include "RangeTable.h"
+#include <unordered_set>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <chrono>
+#include <algorithm>
 #include <imgui/imgui.h>
 
 #include "Utility.h"
+#include "Parallel.h"
 
 namespace fs = std::filesystem;
 
@@ -36,52 +42,390 @@ void OperatorEditor::RenderGUI(bool* p_open)
 
     if (_showRangeEditor)
         RenderRangeGridEditor();
+
+    if (_showBatchQueryWindow)
+        RenderBatchQueryWindow();
 }
 
 void OperatorEditor::LoadOperators()
 {
-    std::ifstream file(_jsonPath);
-    if (file.is_open())
+    _revision = NextDataRevision();
+
+    // 마이그레이션 저장은 해시와 관계없이 써야 하므로 저장된 상태를 모름으로 둠
+    _contentHashes.Clear();
+    _contentHashesDirty = true;
+
+    // 읽기 + rangeId 참조를 편집용 range 배열로 펼침 + 버전 체크 및 마이그레이션 (명령줄 도구와 같은 경로)
+    std::string error;
+    DataFileStatus status = ReadDataFile(Migration::DataType::Operator, _jsonPath, _operatorData, error);
+    if (status == DataFileStatus::Missing)
     {
-        try
-        {
-            file >> _operatorData;
-            std::cout << "[Operator] Loaded " << _jsonPath << "\n";
+        std::cout << "[Operator] File not found, creating new: " << _jsonPath << "\n";
+        _operatorData = { {"version", VERSION}, {"operators", json::array()} };
+    }
+    else if (status == DataFileStatus::ParseError)
+    {
+        std::cout << "[Operator] JSON parse error: " << error << "\n";
+        _operatorData = { {"version", VERSION}, {"operators", json::array()} };
+    }
+    else
+    {
+        std::cout << "[Operator] Loaded " << _jsonPath << "\n";
+        if (status == DataFileStatus::Migrated)
+            SaveOperators();
+    }
 
-            // 버전 체크 및 마이그레이션
-            if (Migration::CheckAndMigrate(Migration::DataType::Operator, _operatorData))
-            {
-                SaveOperators();
-            }
-        }
-        catch (const json::exception& e)
+    _selection.Clear();
+    _lastBulkEdit = BulkEditResult();
+    RebuildOutliers();
+
+    _pristine.Reset(_operatorData["operators"]);
+    _fileStamps = { FileStamp::Of(_jsonPath), FileStamp::Of(RangeTable::PathFor(_jsonPath)) };
+    RefreshContentHashes();
+    _contentHashes.MarkSaved();
+
+    // 파일에서 다시 읽으면 이전 편집 기록은 맞지 않음
+    _undoTracker.Invalidate();
+    if (_history)
+        _history->Forget(this);
+}
+
+void OperatorEditor::DiscardChanges()
+{
+    json& operators = _operatorData["operators"];
+    std::vector<int> restored;
+
+    if (_pristine.Restore(operators, restored))
+    {
+        // 바꾼 오퍼레이터만 다시 해석
+        for (int index : restored)
         {
-            std::cout << "[Operator] JSON parse error: " << e.what() << "\n";
-            _operatorData = { {"version", VERSION}, {"operators", json::array()} };
+            OperatorStats stats;
+            bool valid = ParseOperatorStats(operators[index], stats);
+            _outliers.Update(index, MakeOperatorSample(valid ? &stats : nullptr));
+            _stats.Set(index, OperatorStatValues(valid ? &stats : nullptr));
+            if (!_contentHashesDirty)
+                _contentHashes.Set(index, operators[index].value("charId", ""), HashJson(operators[index]));
         }
     }
     else
     {
-        std::cout << "[Operator] File not found, creating new: " << _jsonPath << "\n";
-        _operatorData = { {"version", VERSION}, {"operators", json::array()} };
+        RebuildOutliers();
+        _selection.Clear();
+        _contentHashesDirty = true;
+    }
+
+    _revision = NextDataRevision();
+    _hasUnsavedChanges = false;
+    _lastBulkEdit = BulkEditResult();
+
+    _undoTracker.Invalidate();
+    if (_history)
+        _history->Forget(this);
+
+    std::cout << "[Operator] Changes discarded (" << (restored.empty() ? "all" : std::to_string(restored.size())) << " records)\n";
+}
+
+void OperatorEditor::RefreshFromDisk()
+{
+    if (FilesUnchanged(_fileStamps))
+        DiscardChanges();
+    else
+        LoadOperators();
+}
+
+void OperatorEditor::MarkModified()
+{
+    _hasUnsavedChanges = true;
+    _revision = NextDataRevision();
+    _pristine.MarkAll();
+    RebuildOutliers();
+    _contentHashesDirty = true;
+}
+
+void OperatorEditor::MarkOperatorModified(int index)
+{
+    _hasUnsavedChanges = true;
+    uint64_t previousRevision = _revision;
+    _revision = NextDataRevision();
+    _changeLog.Add(previousRevision, _revision, index);
+    _pristine.MarkRecord(index);
+
+    OperatorStats stats;
+    bool valid = ParseOperatorStats(_operatorData["operators"][index], stats);
+    _outliers.Update(index, MakeOperatorSample(valid ? &stats : nullptr));
+    _stats.Set(index, OperatorStatValues(valid ? &stats : nullptr));
+    if (!_contentHashesDirty)
+        _contentHashes.Set(index, _operatorData["operators"][index].value("charId", ""), HashJson(_operatorData["operators"][index]));
+
+    _undoTracker.Commit(_history, this, index, _operatorData["operators"][index], _revision);
+}
+
+void OperatorEditor::RefreshContentHashes()
+{
+    if (!_contentHashesDirty)
+        return;
+
+    const json& operators = _operatorData["operators"];
+    std::vector<std::string> keys(operators.size());
+    std::vector<uint64_t> hashes(operators.size());
+    ParallelFor(operators.size(), 256, [&](size_t begin, size_t end, unsigned)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                keys[i] = operators[i].value("charId", "");
+                hashes[i] = HashJson(operators[i]);
+            }
+        });
+
+    _contentHashes.Build(std::move(keys), std::move(hashes));
+    _contentHashesDirty = false;
+}
+
+bool OperatorEditor::HasUnsavedChanges()
+{
+    if (!_hasUnsavedChanges)
+        return false;
+
+    RefreshContentHashes();
+    return _contentHashes.IsDirty();
+}
+
+const RecordChangeSummary& OperatorEditor::GetChangeSummary()
+{
+    if (_changeSummaryRevision != _revision)
+    {
+        RefreshContentHashes();
+        _changeSummary = _contentHashes.Diff();
+        _changeSummaryRevision = _revision;
     }
+    return _changeSummary;
+}
+
+bool OperatorEditor::ApplyBulkEdit(BulkEditResult edit)
+{
+    json& operators = _operatorData["operators"];
+    if (!edit.ok || !edit.Matches(operators, false))
+        return false;
+
+    edit.Apply(operators);
+    MarkModified();
+    if (_history)
+        _history->Push(MakeBulkEditCommand(this, edit, false, "오퍼레이터 일괄 편집"));
+    _lastBulkEdit = std::move(edit);
+    std::cout << "[Operator] Bulk edit applied: " << _lastBulkEdit.changes.size() << " values\n";
+    return true;
+}
+
+bool OperatorEditor::UndoBulkEdit()
+{
+    json& operators = _operatorData["operators"];
+    bool ok = _lastBulkEdit.ok && _lastBulkEdit.Matches(operators, true);
+    if (ok)
+    {
+        _lastBulkEdit.Revert(operators);
+        MarkModified();
+        if (_history)
+            _history->Push(MakeBulkEditCommand(this, _lastBulkEdit, true, "오퍼레이터 일괄 편집 되돌리기"));
+        std::cout << "[Operator] Bulk edit reverted\n";
+    }
+
+    // 이후에 같은 칸을 다시 고쳤으면 되돌릴 수 없음
+    _lastBulkEdit = BulkEditResult();
+    return ok;
+}
+
+void OperatorEditor::RebuildOutliers()
+{
+    const auto& operators = _operatorData["operators"];
+    std::vector<OutlierSample> samples(operators.size());
+    std::vector<std::vector<double>> rows(operators.size());
+    for (size_t i = 0; i < operators.size(); ++i)
+    {
+        OperatorStats stats;
+        bool valid = ParseOperatorStats(operators[i], stats);
+        if (valid)
+            samples[i] = MakeOperatorSample(&stats);
+        rows[i] = OperatorStatValues(valid ? &stats : nullptr);
+    }
+
+    _outliers.Build(samples);
+    _stats.Build(rows);
+}
+
+std::string OperatorEditor::EditRecordLabel(int record) const
+{
+    const json& operators = _operatorData["operators"];
+    return (record >= 0 && record < (int)operators.size()) ? operators[record].value("charId", "") : "#" + std::to_string(record);
+}
+
+std::string OperatorEditor::EditRecordKey(int record) const
+{
+    const json& operators = _operatorData["operators"];
+    return (record >= 0 && record < (int)operators.size()) ? operators[record].value("charId", "") : std::string();
+}
+
+uint64_t OperatorEditor::EditSourceHash(const std::string& /*source*/) const
+{
+    // 레코드는 오퍼레이터 테이블에만 있음 (범위 테이블은 스킬 저장으로도 바뀌므로 보지 않음)
+    return _fileStamps.empty() ? 0 : _fileStamps[0].hash;
+}
+
+void OperatorEditor::SetRecordValue(int record, const json::json_pointer& pointer, const json& value)
+{
+    json& operators = _operatorData["operators"];
+    if (record < 0 || record >= (int)operators.size())
+        return;
+
+    SetJsonValue(operators[record], pointer, value);
+    MarkOperatorModified(record);
+}
+
+void OperatorEditor::InsertRecords(const std::vector<int>& indices, const std::vector<json>& records)
+{
+    json::array_t& operators = _operatorData["operators"].get_ref<json::array_t&>();
+
+    std::vector<int> remap = InsertAt(operators, indices, json::array_t(records.begin(), records.end()));
+
+    _selectedOperatorIndex = RemapIndex(remap, _selectedOperatorIndex);
+    _deleteTargetIndex = -1;
+    _selection.Remap(remap, operators.size());
+    _lastBulkEdit = BulkEditResult();
+    MarkModified();
+}
+
+void OperatorEditor::RemoveRecords(const std::vector<int>& indices)
+{
+    std::vector<uint8_t> remove(_operatorData["operators"].size(), 0);
+    for (int index : indices)
+    {
+        if (index >= 0 && index < (int)remove.size())
+            remove[index] = 1;
+    }
+    DeleteOperators(remove);
+}
+
+void OperatorEditor::DeleteOperators(const std::vector<uint8_t>& remove)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    json::array_t& operators = _operatorData["operators"].get_ref<json::array_t&>();
+    size_t before = operators.size();
+
+    // 지울 오퍼레이터만 떼어 실행 취소 기록으로 넘김
+    std::vector<int> indices;
+    std::vector<json> removed;
+    for (size_t i = 0; i < operators.size() && i < remove.size(); ++i)
+    {
+        if (!remove[i])
+            continue;
+        indices.push_back((int)i);
+        removed.push_back(std::move(operators[i]));
+    }
+
+    std::vector<int> remap = CompactRemove(operators, remove);
+
+    _selectedOperatorIndex = RemapIndex(remap, _selectedOperatorIndex);
+    if (_selectedOperatorIndex < 0)
+    {
+        _showEditWindow = false;
+        _showRangeEditor = false;
+    }
+    _deleteTargetIndex = -1;
+    _selection.Remap(remap, operators.size());
+    _lastBulkEdit = BulkEditResult();
+    MarkModified();
+
+    if (_history)
+    {
+        std::string label = "오퍼레이터 " + std::to_string(indices.size()) + "개 삭제";
+        _history->Push(std::make_unique<RecordStructureCommand>(this, false, std::move(indices), std::move(removed), label));
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[Operator] Deleted " << (before - operators.size()) << " operators (" << ms << " ms)\n";
+}
+
+void OperatorEditor::DuplicateSelected()
+{
+    json::array_t& operators = _operatorData["operators"].get_ref<json::array_t&>();
+
+    std::unordered_set<std::string> usedIds;
+    for (const auto& op : operators)
+        usedIds.insert(op.value("charId", ""));
+
+    std::vector<int> remap = ::DuplicateSelected(operators, _selection.Flags(), [&](const json& op)
+        {
+            json copy = op;
+            copy["charId"] = MakeUniqueKey(op.value("charId", "char"), usedIds);
+            return copy;
+        });
+
+    // 새로 만든 복제본을 선택
+    std::vector<uint8_t> copies(operators.size(), 0);
+    for (int index : _selection.Indices())
+        copies[remap[index] + 1] = 1;
+
+    int duplicated = _selection.Count();
+    _selection.Resize(operators.size());
+    _selection.Clear();
+    for (size_t i = 0; i < copies.size(); ++i)
+        _selection.Set((int)i, copies[i]);
+
+    _selectedOperatorIndex = RemapIndex(remap, _selectedOperatorIndex);
+    _deleteTargetIndex = -1;
+    _lastBulkEdit = BulkEditResult();
+    MarkModified();
+
+    if (_history)
+    {
+        std::vector<int> indices;
+        std::vector<json> inserted;
+        for (size_t i = 0; i < copies.size(); ++i)
+        {
+            if (!copies[i])
+                continue;
+            indices.push_back((int)i);
+            inserted.push_back(operators[i]);
+        }
+        _history->Push(std::make_unique<RecordStructureCommand>(this, true, std::move(indices), std::move(inserted), "오퍼레이터 " + std::to_string(duplicated) + "개 복제"));
+    }
+
+    std::cout << "[Operator] Duplicated " << duplicated << " operators\n";
 }
 
 
 void OperatorEditor::SaveOperators()
 {
-    fs::path filePath(_jsonPath);
-    fs::create_directories(filePath.parent_path());
+    // 내용이 저장된 해시와 같고 파일(범위 테이블 포함)도 그대로면 다시 쓰지 않음
+    RefreshContentHashes();
+    if (!_contentHashes.IsDirty() && FilesUnchanged(_fileStamps))
+    {
+        if (_history)
+            _history->MarkSaved(this);
+        _pristine.Commit(_operatorData["operators"]);
+        std::cout << "[Operator] Unchanged, save skipped\n";
+        return;
+    }
 
     json output;
     output["version"] = VERSION;  // 항상 현재 버전으로 저장
     output["operators"] = _operatorData["operators"];
 
-    std::ofstream file(_jsonPath);
-    if (file.is_open())
+    // 범위는 공유 범위 테이블의 id 로 바꿔 저장
+    // 파일을 닫은 뒤에 저널을 비움 (그 전에 죽으면 저널로 복구)
+    std::string rangePath = RangeTable::PathFor(_jsonPath);
+    if (WriteDataFile(Migration::DataType::Operator, _jsonPath, std::move(output)))
     {
-        file << output.dump(2);
         std::cout << "[Operator] Saved to " << _jsonPath << "\n";
+
+        if (_history)
+            _history->MarkSaved(this);
+
+        _pristine.Commit(_operatorData["operators"]);
+        _fileStamps = { FileStamp::Of(_jsonPath), FileStamp::Of(rangePath) };
+        _contentHashes.MarkSaved();
+        _changeSummaryRevision = 0;
     }
     else
     {
@@ -91,11 +435,13 @@ void OperatorEditor::SaveOperators()
 
 void OperatorEditor::RenderToolbar()
 {
-    if (_hasUnsavedChanges)
+    if (HasUnsavedChanges())
     {
         ImGui::PushStyleColor(ImGuiCol_Text, COLOR_YELLOW);
         ImGui::Text("* 저장되지 않은 변경사항");
         ImGui::PopStyleColor();
+        if (ImGui::IsItemHovered())
+            RenderChangeSummaryTooltip(GetChangeSummary());
 
         ImGui::SameLine();
 
@@ -110,7 +456,7 @@ void OperatorEditor::RenderToolbar()
 
         if (ImGui::Button("되돌리기"))
         {
-            LoadOperators();
+            DiscardChanges();
             _hasUnsavedChanges = false;
             std::cout << "[Operator] Changes discarded.\n";
         }
@@ -154,9 +500,14 @@ void OperatorEditor::RenderToolbar()
 
     if (ImGui::Button("새로고침"))
     {
-        LoadOperators();
+        RefreshFromDisk();
         _hasUnsavedChanges = false;
     }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("정예화/레벨 일괄 조회"))
+        _showBatchQueryWindow = true;
 }
 
 void OperatorEditor::RenderOperatorList()
@@ -167,22 +518,46 @@ void OperatorEditor::RenderOperatorList()
         return;
     }
 
+    _selection.Resize(_operatorData["operators"].size());
+
+    switch (RenderBatchToolbar(_selection, true))
+    {
+    case BatchAction::Delete:
+        _showBatchDeleteConfirm = true;
+        break;
+    case BatchAction::Duplicate:
+        DuplicateSelected();
+        break;
+    case BatchAction::SetField:
+        _fieldSetPopup.Open();
+        break;
+    default:
+        break;
+    }
+
+    RenderBatchPopups();
+
     ImGuiTableFlags flags = ImGuiTableFlags_Borders |
         ImGuiTableFlags_RowBg |
         ImGuiTableFlags_Resizable |
         ImGuiTableFlags_ScrollY;
 
-    if (ImGui::BeginTable("OperatorTable", 7, flags))
+    if (ImGui::BeginTable("OperatorTable", 8, flags))
     {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("##Select", ImGuiTableColumnFlags_WidthFixed, 24.0f);
         ImGui::TableSetupColumn("ID", ImGuiTableColumnFlags_WidthFixed, 120.0f);
         ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthFixed, 120.0f);
         ImGui::TableSetupColumn("Class", ImGuiTableColumnFlags_WidthFixed, 80.0f);
         ImGui::TableSetupColumn("Rarity", ImGuiTableColumnFlags_WidthFixed, 40.0f);
-        ImGui::TableSetupColumn("HP/ATK", ImGuiTableColumnFlags_WidthFixed, 100.0f);
-        ImGui::TableSetupColumn("Cost", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+        ImGui::TableSetupColumn("HP/ATK (Max)", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+        ImGui::TableSetupColumn("Cost (Max)", ImGuiTableColumnFlags_WidthFixed, 70.0f);
         ImGui::TableSetupColumn("Actions", ImGuiTableColumnFlags_WidthFixed, 120.0f);
         ImGui::TableHeadersRow();
 
+        // 목록 스탯은 마지막 정예화의 최대 레벨 (시뮬레이터/분석 창과 같은 기준)
+        const AttributeBatchResult& listStats = GetListAttributes();
+
         int index = 0;
         for (const auto& op : _operatorData["operators"])
         {
@@ -194,6 +569,12 @@ void OperatorEditor::RenderOperatorList()
 
             ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg0, bg);
 
+            ImGui::PushID(index);
+
+            // 선택
+            ImGui::TableNextColumn();
+            SelectionCheckbox(_selection, index);
+
             // ID
             ImGui::TableNextColumn();
             std::string id = op["charId"];
@@ -226,26 +607,29 @@ void OperatorEditor::RenderOperatorList()
             int rarity = op["rarity"];
             ImGui::TextColored(ImVec4(0.0f, 0.8f, 1.0f, 1.0f), "%d", rarity);
 
-            // HP/ATK
+            // HP/ATK, Cost
+            bool hasStats = index < listStats.count && listStats.available[index];
             ImGui::TableNextColumn();
-            int hp = op["phases"][0]["attributesKeyFrames"][0]["data"]["maxHp"];
-            int atk = op["phases"][0]["attributesKeyFrames"][0]["data"]["atk"];
-            ImGui::Text("%d/%d", hp, atk);
+            if (hasStats)
+                ImGui::Text("%.0f/%.0f", listStats.Get(index, AttributeField::MaxHp), listStats.Get(index, AttributeField::Atk));
+            else
+                ImGui::TextColored(COLOR_GRAY, "-");
 
-            // Cost
             ImGui::TableNextColumn();
-            int cost = op["phases"][0]["attributesKeyFrames"][0]["data"]["cost"];
-            ImGui::Text("%d", cost);
+            if (hasStats)
+                ImGui::Text("%.0f", listStats.Get(index, AttributeField::Cost));
+            else
+                ImGui::TextColored(COLOR_GRAY, "-");
 
             // Actions
             ImGui::TableNextColumn();
 
-            ImGui::PushID(index);
-
             if (ImGui::SmallButton("편집"))
             {
                 _selectedOperatorIndex = index;
                 _showEditWindow = true;
+                _editPhase = 0;
+                _editKeyFrame = 0;
 
                 // 백버퍼 로드
                 auto& attrs = op["phases"][0]["attributesKeyFrames"][0]["data"];
@@ -314,8 +698,9 @@ void OperatorEditor::RenderOperatorList()
         {
             if (_deleteTargetIndex >= 0 && _deleteTargetIndex < (int)_operatorData["operators"].size())
             {
-                _operatorData["operators"].erase(_operatorData["operators"].begin() + _deleteTargetIndex);
-                _hasUnsavedChanges = true;
+                std::vector<uint8_t> remove(_operatorData["operators"].size(), 0);
+                remove[_deleteTargetIndex] = 1;
+                DeleteOperators(remove);
                 std::cout << "[Operator] Deleted: " << _deleteTargetName << "\n";
             }
             _deleteTargetIndex = -1;
@@ -334,6 +719,57 @@ void OperatorEditor::RenderOperatorList()
     }
 }
 
+void OperatorEditor::RenderBatchPopups()
+{
+    auto& operators = _operatorData["operators"];
+
+    if (_showBatchDeleteConfirm)
+    {
+        ImGui::OpenPopup("일괄 삭제 확인");
+        _showBatchDeleteConfirm = false;
+    }
+
+    if (ImGui::BeginPopupModal("일괄 삭제 확인", NULL, ImGuiWindowFlags_AlwaysAutoResize))
+    {
+        ImGui::TextColored(COLOR_RED, "선택한 오퍼레이터 %d개를 정말 삭제할까요?", _selection.Count());
+        ImGui::Separator();
+
+        // 앞쪽 몇 개만 표시
+        int shown = 0;
+        for (int index : _selection.Indices())
+        {
+            if (shown++ == 10)
+            {
+                ImGui::TextColored(COLOR_GRAY, "... 외 %d개", _selection.Count() - 10);
+                break;
+            }
+            ImGui::TextColored(COLOR_YELLOW, "%s (%s)",
+                operators[index].value("charId", "").c_str(), operators[index].value("name", "").c_str());
+        }
+
+        ImGui::Separator();
+
+        if (ImGui::Button("예", ImVec2(120, 0)))
+        {
+            DeleteOperators(_selection.Flags());
+            ImGui::CloseCurrentPopup();
+        }
+
+        ImGui::SameLine();
+
+        if (ImGui::Button("아니오", ImVec2(120, 0)))
+        {
+            ImGui::CloseCurrentPopup();
+        }
+
+        ImGui::EndPopup();
+    }
+
+    BulkEditResult edit;
+    if (_fieldSetPopup.Render(BulkEditTarget::Operator, operators, _selection.Flags(), edit))
+        ApplyBulkEdit(std::move(edit));
+}
+
 void OperatorEditor::RenderCreateWindow()
 {
     ImGui::Begin("새 오퍼레이터 생성", &_showCreateWindow);
@@ -423,7 +859,13 @@ void OperatorEditor::RenderCreateWindow()
             );
 
             _operatorData["operators"].push_back(newOperator);
-            _hasUnsavedChanges = true;
+            MarkModified();
+
+            if (_history)
+            {
+                int index = (int)_operatorData["operators"].size() - 1;
+                _history->Push(std::make_unique<RecordStructureCommand>(this, true, std::vector<int>{ index }, std::vector<json>{ newOperator }, std::string("오퍼레이터 생성: ") + _inputCharId));
+            }
 
             std::cout << "[Operator] Created: " << _inputName << "\n";
             _showCreateWindow = false;
@@ -451,7 +893,8 @@ void OperatorEditor::RenderEditWindow()
     ImGui::Begin("오퍼레이터 편집", &_showEditWindow);
 
     auto& op = _operatorData["operators"][_selectedOperatorIndex];
-    auto& attrs = op["phases"][0]["attributesKeyFrames"][0]["data"];
+    if (!_undoTracker.IsTracking(_selectedOperatorIndex, _revision))
+        _undoTracker.Reset(_selectedOperatorIndex, _revision, op);
 
     // ID (읽기 전용)
     ImGui::Text("ID: %s", op["charId"].get<std::string>().c_str());
@@ -465,7 +908,7 @@ void OperatorEditor::RenderEditWindow()
     if (ImGui::InputText("이름", nameBuffer, 64))
     {
         op["name"] = std::string(nameBuffer);
-        _hasUnsavedChanges = true;
+        MarkOperatorModified(_selectedOperatorIndex);
     }
 
     // Profession
@@ -482,7 +925,7 @@ void OperatorEditor::RenderEditWindow()
         Profession newProf = static_cast<Profession>(profIndex);
         op["profession"] = ProfessionToString(newProf);
         op["position"] = PositionToString(GetPositionFromProfession(newProf));
-        _hasUnsavedChanges = true;
+        MarkOperatorModified(_selectedOperatorIndex);
     }
 
     // Position (Auto)
@@ -493,38 +936,41 @@ void OperatorEditor::RenderEditWindow()
     if (ImGui::SliderInt("레어도", &rarity, 3, 6))
     {
         op["rarity"] = rarity;
-        _hasUnsavedChanges = true;
+        MarkOperatorModified(_selectedOperatorIndex);
     }
 
     ImGui::SeparatorText("능력치");
 
+    RenderKeyFrameSelector(op);
+    auto& attrs = op["phases"][_editPhase]["attributesKeyFrames"][_editKeyFrame]["data"];
+
     // Stats
     int hp = attrs["maxHp"];
     if (ImGui::InputInt("최대 HP", &hp))
     {
         attrs["maxHp"] = hp;
-        _hasUnsavedChanges = true;
+        MarkOperatorModified(_selectedOperatorIndex);
     }
 
     int atk = attrs["atk"];
     if (ImGui::InputInt("공격력", &atk))
     {
         attrs["atk"] = atk;
-        _hasUnsavedChanges = true;
+        MarkOperatorModified(_selectedOperatorIndex);
     }
 
     int def = attrs["def"];
     if (ImGui::InputInt("방어력", &def))
     {
         attrs["def"] = def;
-        _hasUnsavedChanges = true;
+        MarkOperatorModified(_selectedOperatorIndex);
     }
 
     int magicResInt = static_cast<int>(attrs["magicResistance"].get<float>() * 100);
     if (ImGui::SliderInt("마법 저항", &magicResInt, 0, 100))
     {
         attrs["magicResistance"] = Snap2(magicResInt / 100.0);
-        _hasUnsavedChanges = true;
+        MarkOperatorModified(_selectedOperatorIndex);
     }
     ImGui::SameLine();
     ImGui::Text("%%");
@@ -533,30 +979,33 @@ void OperatorEditor::RenderEditWindow()
     if (ImGui::InputInt("배치 코스트", &cost))
     {
         attrs["cost"] = cost;
-        _hasUnsavedChanges = true;
+        MarkOperatorModified(_selectedOperatorIndex);
     }
 
     int blockCnt = attrs["blockCnt"];
     if (ImGui::InputInt("저지 가능 수", &blockCnt))
     {
         attrs["blockCnt"] = blockCnt;
-        _hasUnsavedChanges = true;
+        MarkOperatorModified(_selectedOperatorIndex);
     }
 
     float baseAttackTime = static_cast<float>(attrs["baseAttackTime"].get<double>());
     if (ImGui::InputFloat("공격 속도 (초)", &baseAttackTime, 0.1f, 1.0f, "%.2f"))
     {
         attrs["baseAttackTime"] = Snap2(baseAttackTime);
-        _hasUnsavedChanges = true;
+        MarkOperatorModified(_selectedOperatorIndex);
     }
 
     int respawnTime = attrs["respawnTime"];
     if (ImGui::InputInt("재배치 시간", &respawnTime))
     {
         attrs["respawnTime"] = respawnTime;
-        _hasUnsavedChanges = true;
+        MarkOperatorModified(_selectedOperatorIndex);
     }
 
+    RenderAttributeCurvePreview(op);
+    RenderOutlierWarning(_selectedOperatorIndex);
+
     ImGui::Separator();
 
     // Range Edit
@@ -584,14 +1033,291 @@ void OperatorEditor::RenderEditWindow()
 
     if (ImGui::Button("완료"))
     {
-        // Range 저장
-        op["range"] = GridToRangeJson();
+        // Range 저장 (바뀐 경우만 수정으로 기록)
+        json range = GridToRangeJson();
+        if (op["range"] != range)
+        {
+            op["range"] = std::move(range);
+            MarkOperatorModified(_selectedOperatorIndex);
+        }
         _showEditWindow = false;
     }
 
     ImGui::End();
 }
 
+void OperatorEditor::RenderKeyFrameSelector(json& op)
+{
+    auto& phases = op["phases"];
+
+    // 편집할 정예화 단계
+    _editPhase = std::clamp(_editPhase, 0, (int)phases.size() - 1);
+    char phaseLabel[16];
+    snprintf(phaseLabel, sizeof(phaseLabel), "E%d", _editPhase);
+
+    ImGui::SetNextItemWidth(80);
+    if (ImGui::BeginCombo("정예화", phaseLabel))
+    {
+        for (int p = 0; p < (int)phases.size(); ++p)
+        {
+            snprintf(phaseLabel, sizeof(phaseLabel), "E%d", p);
+            if (ImGui::Selectable(phaseLabel, p == _editPhase))
+            {
+                _editPhase = p;
+                _editKeyFrame = 0;
+            }
+        }
+        ImGui::EndCombo();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::SmallButton("정예화 추가"))
+    {
+        // 직전 단계의 마지막 키프레임을 1레벨 시작값으로 복사
+        json lastFrame = phases.back()["attributesKeyFrames"].back();
+        lastFrame["level"] = 1;
+
+        phases.push_back({
+            {"phase", (int)phases.size()},
+            {"attributesKeyFrames", json::array({ lastFrame })}
+        });
+        _editPhase = (int)phases.size() - 1;
+        _editKeyFrame = 0;
+        MarkOperatorModified(_selectedOperatorIndex);
+    }
+
+    ImGui::SameLine();
+
+    // 중간 단계를 지우면 정예화 번호가 밀리므로 마지막 단계만 삭제
+    ImGui::BeginDisabled(phases.size() <= 1 || _editPhase != (int)phases.size() - 1);
+    if (ImGui::SmallButton("정예화 삭제"))
+    {
+        phases.erase(phases.size() - 1);
+        _editPhase = (int)phases.size() - 1;
+        _editKeyFrame = 0;
+        MarkOperatorModified(_selectedOperatorIndex);
+    }
+    ImGui::EndDisabled();
+
+    // 편집할 키프레임
+    auto& keyFrames = phases[_editPhase]["attributesKeyFrames"];
+    _editKeyFrame = std::clamp(_editKeyFrame, 0, (int)keyFrames.size() - 1);
+
+    char frameLabel[32];
+    snprintf(frameLabel, sizeof(frameLabel), "Lv %d", keyFrames[_editKeyFrame].value("level", 0));
+
+    ImGui::SetNextItemWidth(80);
+    if (ImGui::BeginCombo("키프레임", frameLabel))
+    {
+        for (int k = 0; k < (int)keyFrames.size(); ++k)
+        {
+            ImGui::PushID(k);
+            snprintf(frameLabel, sizeof(frameLabel), "Lv %d", keyFrames[k].value("level", 0));
+            if (ImGui::Selectable(frameLabel, k == _editKeyFrame))
+                _editKeyFrame = k;
+            ImGui::PopID();
+        }
+        ImGui::EndCombo();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::SmallButton("키프레임 추가"))
+    {
+        json newFrame = keyFrames.back();
+        int lastLevel = newFrame.value("level", 0);
+        newFrame["level"] = std::max(lastLevel + 1, phases[_editPhase].value("maxLevel", 0));
+
+        keyFrames.push_back(newFrame);
+        _editKeyFrame = (int)keyFrames.size() - 1;
+        MarkOperatorModified(_selectedOperatorIndex);
+    }
+
+    ImGui::SameLine();
+
+    ImGui::BeginDisabled(keyFrames.size() <= 1);
+    if (ImGui::SmallButton("키프레임 삭제"))
+    {
+        keyFrames.erase(_editKeyFrame);
+        _editKeyFrame = std::max(0, _editKeyFrame - 1);
+        MarkOperatorModified(_selectedOperatorIndex);
+    }
+    ImGui::EndDisabled();
+
+    // 키프레임 레벨 (앞뒤 키프레임 사이로 제한해 순서 유지)
+    int level = keyFrames[_editKeyFrame].value("level", 0);
+    int minLevel = (_editKeyFrame > 0) ? keyFrames[_editKeyFrame - 1].value("level", 0) + 1 : 0;
+    int maxLevel = (_editKeyFrame + 1 < (int)keyFrames.size()) ? keyFrames[_editKeyFrame + 1].value("level", 0) - 1 : 999;
+
+    ImGui::SetNextItemWidth(150);
+    if (ImGui::InputInt("키프레임 레벨", &level))
+    {
+        keyFrames[_editKeyFrame]["level"] = std::clamp(level, minLevel, std::max(minLevel, maxLevel));
+        MarkOperatorModified(_selectedOperatorIndex);
+    }
+}
+
+void OperatorEditor::RenderOutlierWarning(int operatorIndex)
+{
+    if (operatorIndex >= _outliers.Count())
+        return;
+
+    const OutlierResult& result = _outliers.Result(operatorIndex);
+    if (!result.flagged)
+        return;
+
+    ImGui::TextColored(COLOR_YELLOW, "[!] 밸런스 이상치 의심 (%s 그룹 %d명 기준)",
+        _outliers.GroupName(result.group).c_str(), _outliers.GroupSize(result.group));
+
+    double ratio = (result.groupMedian > 0.0f) ? result.value / result.groupMedian : 0.0;
+    ImGui::TextColored(COLOR_YELLOW, "    %s = %.2f, 그룹 중앙값 %.2f (%.1f배, z = %+.1f)",
+        OperatorOutlierColumn(result.column), result.value, result.groupMedian, ratio, result.zScore);
+
+    if (result.nearest >= 0)
+    {
+        ImGui::TextColored(COLOR_GRAY, "    가장 가까운 오퍼레이터: %s (거리 %.2f)",
+            _operatorData["operators"][result.nearest]["charId"].get<std::string>().c_str(), result.nnDistance);
+    }
+}
+
+void OperatorEditor::RenderAttributeCurvePreview(const json& op)
+{
+    OperatorAttributeCurve curve;
+    if (!OperatorAttributeCurve::FromJson(op, curve))
+        return;
+
+    ImGui::SeparatorText("스탯 곡선");
+
+    const char* fields[] = {
+        "최대 HP", "공격력", "방어력", "마법 저항",
+        "배치 코스트", "저지 가능 수", "공격 속도", "재배치 시간"
+    };
+    ImGui::SetNextItemWidth(150);
+    ImGui::Combo("##CurveField", &_curveField, fields, IM_ARRAYSIZE(fields));
+
+    // 정예화 단계를 이어 붙여 레벨마다 한 점씩
+    AttributeField field = (AttributeField)_curveField;
+    std::vector<float> values;
+    std::string overlay;
+    for (int p = 0; p < (int)curve.phases.size(); ++p)
+    {
+        const OperatorPhase& phase = curve.phases[p];
+        if (phase.keyFrames.empty())
+            continue;
+
+        int firstLevel = phase.keyFrames.front().level;
+        int lastLevel = phase.keyFrames.back().level;
+        for (int level = firstLevel; level <= lastLevel; ++level)
+            values.push_back((float)phase.Evaluate(level)[field]);
+
+        char segment[48];
+        snprintf(segment, sizeof(segment), "%sE%d %d-%d", overlay.empty() ? "" : " | ", p, firstLevel, lastLevel);
+        overlay += segment;
+    }
+
+    if (values.empty())
+        return;
+
+    auto [minIt, maxIt] = std::minmax_element(values.begin(), values.end());
+    float padding = std::max(1e-3f, (*maxIt - *minIt) * 0.1f);
+    ImGui::PlotLines("##AttributeCurve", values.data(), (int)values.size(), 0, overlay.c_str(),
+        *minIt - padding, *maxIt + padding, ImVec2(-1, 100));
+
+    ImGui::TextColored(COLOR_GRAY, "최소 %.2f / 최대 %.2f", *minIt, *maxIt);
+}
+
+// 데이터가 바뀌었을 때만 열 재구성
+void OperatorEditor::UpdateCurveTable()
+{
+    if (_curveTableRevision == _revision)
+        return;
+
+    _curveTable.Build(ParseOperatorCurves(_operatorData["operators"]));
+    _curveTable.Evaluate(LAST_PHASE, MAX_LEVEL, _listStats);
+    _curveTableRevision = _revision;
+}
+
+const AttributeBatchResult& OperatorEditor::GetListAttributes()
+{
+    UpdateCurveTable();
+    return _listStats;
+}
+
+void OperatorEditor::RenderBatchQueryWindow()
+{
+    ImGui::SetNextWindowSize(ImVec2(900, 500), ImGuiCond_FirstUseEver);
+    ImGui::Begin("정예화/레벨 일괄 조회", &_showBatchQueryWindow);
+
+    UpdateCurveTable();
+
+    ImGui::SetNextItemWidth(100);
+    ImGui::SliderInt("정예화", &_batchPhase, 0, std::max(0, _curveTable.MaxPhaseCount() - 1), "E%d");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(100);
+    ImGui::InputInt("레벨", &_batchLevel);
+    _batchLevel = std::max(1, _batchLevel);
+
+    // 평가 자체가 수 마이크로초라 매 프레임 다시 계산
+    auto start = std::chrono::steady_clock::now();
+    _curveTable.Evaluate(_batchPhase, _batchLevel, _batchResult);
+    auto end = std::chrono::steady_clock::now();
+    _batchQueryUs = std::chrono::duration<double, std::micro>(end - start).count();
+
+    std::vector<int> rows;
+    rows.reserve(_batchResult.count);
+    for (int i = 0; i < _batchResult.count; ++i)
+    {
+        if (_batchResult.available[i])
+            rows.push_back(i);
+    }
+
+    ImGui::SameLine();
+    ImGui::TextColored(COLOR_GRAY, "%d / %d명, %.1f us", (int)rows.size(), _batchResult.count, _batchQueryUs);
+
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+    if (ImGui::BeginTable("BatchQueryTable", 2 + ATTRIBUTE_FIELD_COUNT, flags))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("ID");
+        ImGui::TableSetupColumn("Name");
+        for (int f = 0; f < ATTRIBUTE_FIELD_COUNT; ++f)
+            ImGui::TableSetupColumn(AttributeFieldKey((AttributeField)f));
+        ImGui::TableHeadersRow();
+
+        const auto& operators = _operatorData["operators"];
+
+        ImGuiListClipper clipper;
+        clipper.Begin((int)rows.size());
+        while (clipper.Step())
+        {
+            for (int r = clipper.DisplayStart; r < clipper.DisplayEnd; ++r)
+            {
+                int index = rows[r];
+                const auto& op = operators[index];
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%s", op.value("charId", "").c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%s", op.value("name", "").c_str());
+
+                for (int f = 0; f < ATTRIBUTE_FIELD_COUNT; ++f)
+                {
+                    ImGui::TableNextColumn();
+                    if (IsIntegerAttribute((AttributeField)f))
+                        ImGui::Text("%d", (int)_batchResult.Get(index, (AttributeField)f));
+                    else
+                        ImGui::Text("%.2f", _batchResult.Get(index, (AttributeField)f));
+                }
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
 void OperatorEditor::RenderRangeGridEditor()
 {
     ImGui::SetNextWindowSize(ImVec2(500, 550), ImGuiCond_Appearing);
@@ -699,12 +1425,51 @@ void OperatorEditor::RenderSkillList()
 }
 
 
+std::vector<int> OperatorEditor::PhaseMaxLevels(int rarity)
+{
+    // 정예화 단계별 최대 레벨 (레어도 3 은 1정예까지, 4 이상은 2정예까지)
+    switch (rarity)
+    {
+    case 1:
+    case 2: return { 30 };
+    case 3: return { 40, 55 };
+    case 4: return { 45, 60, 70 };
+    case 5: return { 50, 70, 80 };
+    default: return { 50, 80, 90 };
+    }
+}
+
 json OperatorEditor::OperatorDataStructure(const std::string& charId, const std::string& name,
     const std::string& profession, int rarity, const std::string& position,
     int hp, int atk, int def, int magicRes,
     int cost, int blockCnt, float baseAttackTime, int respawnTime,
     const json& range)
 {
+    json data = {
+        {"maxHp", hp},
+        {"atk", atk},
+        {"def", def},
+        {"magicResistance", Snap2(magicRes / 100.0)},
+        {"cost", cost},
+        {"blockCnt", blockCnt},
+        {"baseAttackTime", Snap2(baseAttackTime)},
+        {"respawnTime", respawnTime}
+    };
+
+    // 레어도가 허용하는 정예화 단계마다 최소/최대 레벨 키프레임 (처음에는 같은 값, 곡선은 편집 창에서)
+    json phases = json::array();
+    for (int maxLevel : PhaseMaxLevels(rarity))
+    {
+        phases.push_back({
+            {"phase", (int)phases.size()},
+            {"maxLevel", maxLevel},
+            {"attributesKeyFrames", json::array({
+                { {"level", 1}, {"data", data} },
+                { {"level", maxLevel}, {"data", data} }
+            })}
+        });
+    }
+
     return {
         {"charId", charId},
         {"name", name},
@@ -713,26 +1478,7 @@ json OperatorEditor::OperatorDataStructure(const std::string& charId, const std:
         {"rarity", rarity},
         {"position", position},
         {"range", range},
-        {"phases", json::array({
-            {
-                {"phase", 0},
-                {"attributesKeyFrames", json::array({
-                    {
-                        {"level", 0},
-                        {"data", {
-                            {"maxHp", hp},
-                            {"atk", atk},
-                            {"def", def},
-                            {"magicResistance", Snap2(magicRes / 100.0)},
-                            {"cost", cost},
-                            {"blockCnt", blockCnt},
-                            {"baseAttackTime", Snap2(baseAttackTime)},
-                            {"respawnTime", respawnTime}
-                        }}
-                    }
-                })}
-            }
-        })},
+        {"phases", phases},
         {"skills", json::array()}
     };
 }
@@ -1,23 +1,68 @@
 ﻿#pragma once
 #include <string>
+#include <cstdint>
 #include <vector>
 #include <nlohmann/json.hpp>
 
+#include "AttributeCurve.h"
+#include "BalanceOutliers.h"
+#include "BulkEdit.h"
+#include "BatchWidgets.h"
+#include "ProjectStats.h"
+#include "EditHistory.h"
+#include "PristineSnapshot.h"
+#include "ContentHash.h"
+#include "Utility.h"
+
 using json = nlohmann::ordered_json;
 
-class OperatorEditor
+class OperatorEditor : public RecordEditTarget
 {
 public:
     OperatorEditor(const std::string& jsonPath);
     ~OperatorEditor();
 
     void RenderGUI(bool* p_open);
-    bool HasUnsavedChanges() const { return _hasUnsavedChanges; }
+    // 값을 고쳤다가 원래대로 돌렸으면 저장된 해시와 같으므로 false
+    bool HasUnsavedChanges();
     void ClearUnsavedFlag() { _hasUnsavedChanges = false; }
+    // 저장된 상태와 다른 charId 목록
+    const RecordChangeSummary& GetChangeSummary();
+
+    // 분석 창에서 읽기 전용으로 사용 (데이터가 바뀌면 revision 이 바뀜)
+    const json& GetOperatorData() const { return _operatorData; }
+    uint64_t GetRevision() const { return _revision; }
+    const RecordChangeLog& GetChangeLog() const { return _changeLog; }
+    const OutlierDetector& GetOutliers() const { return _outliers; }
+    void SetOutlierConfig(const OutlierConfig& config) { _outliers.SetConfig(config); }
+    void FlushOutliers() { _outliers.Flush(); }  // 편집 동작이 끝났을 때 미뤄 둔 그룹 재계산
+    const RecordStatTable& GetStats() const { return _stats; }
+
+    // 일괄 편집 (마지막 한 건만 되돌릴 수 있음)
+    bool ApplyBulkEdit(BulkEditResult edit);
+    bool UndoBulkEdit();
+    bool CanUndoBulkEdit() const { return _lastBulkEdit.ok; }
+
+    // 실행 취소 기록 (레코드 = operators[] 의 오퍼레이터 하나)
+    void SetEditHistory(EditHistory* history) { _history = history; }
+    const char* EditTargetName() const override { return "오퍼레이터"; }
+    std::string EditRecordLabel(int record) const override;
+    std::string EditRecordKey(int record) const override;
+    std::string EditRecordKeyPath() const override { return "/charId"; }
+    uint64_t EditSourceHash(const std::string& source) const override;
+    int EditRecordCount() const override { return _operatorData.contains("operators") ? (int)_operatorData["operators"].size() : 0; }
+    void SetRecordValue(int record, const json::json_pointer& pointer, const json& value) override;
+    void InsertRecords(const std::vector<int>& indices, const std::vector<json>& records) override;
+    void RemoveRecords(const std::vector<int>& indices) override;
 
     void LoadOperators();
     void SaveOperators();
 
+    // 마지막으로 읽거나 저장한 상태로 되돌림 (파일을 다시 읽지 않고 바꾼 오퍼레이터만 복사)
+    void DiscardChanges();
+    // 오퍼레이터 테이블/범위 테이블이 바뀌었을 때만 다시 읽고, 그대로면 DiscardChanges
+    void RefreshFromDisk();
+
 private:
     std::string _jsonPath;
     json _operatorData;
@@ -43,6 +88,34 @@ private:
 
     // 변경 감지
     bool _hasUnsavedChanges = false;
+    uint64_t _revision = 0;
+    RecordChangeLog _changeLog;         // 오퍼레이터 하나만 바꾼 revision
+
+    void MarkModified();
+    void MarkOperatorModified(int index);
+
+    // 같은 직군 × 레어도 안에서 튀는 스탯 검사 (마지막 정예화 최대 레벨 기준)
+    // 통계 대시보드용 열별 분포도 같은 파싱 결과로 함께 갱신
+    OutlierDetector _outliers;
+    RecordStatTable _stats{ OperatorStatColumns() };
+    void RebuildOutliers();
+
+    BulkEditResult _lastBulkEdit;
+
+    // 편집 창에서 고친 값은 기준 사본과 비교해 바뀐 값만 기록
+    EditHistory* _history = nullptr;
+    RecordEditTracker _undoTracker;
+
+    // 저장된 상태 사본과 읽은 파일 (범위 테이블 포함)
+    PristineSnapshot<json> _pristine;
+    std::vector<FileStamp> _fileStamps;
+
+    // 오퍼레이터별 내용 해시 (값만 바뀌면 해당 오퍼레이터만, 구조가 바뀌면 다음에 볼 때 전체 다시 계산)
+    RecordHashTable _contentHashes;
+    bool _contentHashesDirty = true;
+    RecordChangeSummary _changeSummary;
+    uint64_t _changeSummaryRevision = 0;
+    void RefreshContentHashes();
 
     // GUI State
     bool _showCreateWindow = false;
@@ -50,11 +123,34 @@ private:
     bool _showRangeEditor = false;
     int _selectedOperatorIndex = -1;
 
+    // 정예화/레벨 키프레임 편집 상태
+    int _editPhase = 0;
+    int _editKeyFrame = 0;
+    int _curveField = 0;                    // AttributeField
+
+    // 일괄 조회 (모든 오퍼레이터를 한 정예화/레벨에서 평가)
+    bool _showBatchQueryWindow = false;
+    int _batchPhase = 0;
+    int _batchLevel = 1;
+    AttributeCurveTable _curveTable;
+    uint64_t _curveTableRevision = 0;
+    AttributeBatchResult _batchResult;
+    AttributeBatchResult _listStats;            // 목록 표시용 (마지막 정예화, 최대 레벨)
+    double _batchQueryUs = 0.0;
+
     // Delete 확인
     bool _showDeleteConfirm = false;
     int _deleteTargetIndex = -1;
     std::string _deleteTargetName;
 
+    // 목록 다중 선택 / 일괄 작업
+    MultiSelection _selection;
+    FieldSetPopup _fieldSetPopup;
+    bool _showBatchDeleteConfirm = false;
+
+    void DeleteOperators(const std::vector<uint8_t>& remove);   // 선택 플래그와 같은 형식
+    void DuplicateSelected();
+
     // 입력 버퍼
     char _inputCharId[64] = "";
     char _inputName[64] = "";
@@ -78,12 +174,20 @@ private:
     // GUI 서브 함수
     void RenderToolbar();
     void RenderOperatorList();
+    void RenderBatchPopups();
     void RenderCreateWindow();
     void RenderEditWindow();
     void RenderRangeGridEditor();
     void RenderSkillList();
+    void RenderKeyFrameSelector(json& op);
+    void RenderAttributeCurvePreview(const json& op);
+    void RenderBatchQueryWindow();
+    void UpdateCurveTable();
+    const AttributeBatchResult& GetListAttributes();
+    void RenderOutlierWarning(int operatorIndex);
 
     // 헬퍼 함수
+    static std::vector<int> PhaseMaxLevels(int rarity);
     json OperatorDataStructure(const std::string& charId, const std::string& name,
         const std::string& profession, int rarity, const std::string& position,
         int hp, int atk, int def, int magicRes,
@@ -0,0 +1,56 @@
+﻿#pragma once
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// 사용 가능한 작업 스레드 수
+inline unsigned GetWorkerCount()
+{
+	unsigned count = std::thread::hardware_concurrency();
+	return count > 0 ? count : 1;
+}
+
+// [0, count) 구간을 grain 크기 블록으로 나눠 모든 코어에서 처리
+// func(begin, end, workerIndex) 는 블록마다 호출되며, 블록 단위로 동적 분배됨
+template <typename Func>
+void ParallelFor(size_t count, size_t grain, Func&& func)
+{
+	if (count == 0)
+		return;
+
+	grain = std::max<size_t>(1, grain);
+	size_t blockCount = (count + grain - 1) / grain;
+	unsigned workerCount = (unsigned)std::min<size_t>(GetWorkerCount(), blockCount);
+
+	if (workerCount <= 1)
+	{
+		for (size_t begin = 0; begin < count; begin += grain)
+			func(begin, std::min(count, begin + grain), 0u);
+		return;
+	}
+
+	std::atomic<size_t> nextBlock{ 0 };
+	auto worker = [&](unsigned workerIndex)
+		{
+			while (true)
+			{
+				size_t block = nextBlock.fetch_add(1, std::memory_order_relaxed);
+				if (block >= blockCount)
+					break;
+
+				size_t begin = block * grain;
+				func(begin, std::min(count, begin + grain), workerIndex);
+			}
+		};
+
+	std::vector<std::thread> threads;
+	threads.reserve(workerCount - 1);
+	for (unsigned i = 1; i < workerCount; ++i)
+		threads.emplace_back(worker, i);
+
+	worker(0);
+
+	for (auto& thread : threads)
+		thread.join();
+}
@@ -0,0 +1,80 @@
+﻿#include "PristineSnapshot.h"
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	uint64_t HashFile(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+			return 0;
+
+		// FNV-1a 64
+		uint64_t hash = 1469598103934665603ull;
+		char buffer[64 * 1024];
+		while (file)
+		{
+			file.read(buffer, sizeof(buffer));
+			std::streamsize count = file.gcount();
+			for (std::streamsize i = 0; i < count; ++i)
+			{
+				hash ^= (uint8_t)buffer[i];
+				hash *= 1099511628211ull;
+			}
+		}
+		return hash;
+	}
+}
+
+FileStamp FileStamp::Of(const std::string& path)
+{
+	FileStamp stamp;
+	stamp.path = path;
+
+	std::error_code ec;
+	auto status = fs::status(path, ec);
+	if (ec || !fs::is_regular_file(status))
+		return stamp;
+
+	stamp.exists = true;
+	stamp.size = (uint64_t)fs::file_size(path, ec);
+	stamp.mtime = (int64_t)fs::last_write_time(path, ec).time_since_epoch().count();
+	stamp.hash = HashFile(path);
+	return stamp;
+}
+
+bool FileStamp::Unchanged()
+{
+	std::error_code ec;
+	bool existsNow = fs::is_regular_file(path, ec);
+	if (existsNow != exists)
+		return false;
+	if (!exists)
+		return true;
+
+	uint64_t sizeNow = (uint64_t)fs::file_size(path, ec);
+	int64_t mtimeNow = (int64_t)fs::last_write_time(path, ec).time_since_epoch().count();
+	if (ec || sizeNow != size)
+		return false;
+	if (mtimeNow == mtime)
+		return true;
+
+	// 시각만 바뀜 (다시 저장, 체크아웃 등): 내용이 같으면 그대로
+	if (HashFile(path) != hash)
+		return false;
+	mtime = mtimeNow;
+	return true;
+}
+
+bool FilesUnchanged(std::vector<FileStamp>& stamps)
+{
+	for (FileStamp& stamp : stamps)
+	{
+		if (!stamp.Unchanged())
+			return false;
+	}
+	return !stamps.empty();
+}
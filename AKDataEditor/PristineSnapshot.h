@@ -0,0 +1,187 @@
+﻿#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "ContentHash.h"
+
+// 사본을 같이 쓸지 가리는 내용 해시 (해시가 같으면 같은 내용으로 봄)
+inline uint64_t SnapshotHash(const json& record) { return HashJson(record); }
+template <typename Record>
+uint64_t SnapshotHash(const Record& record) { return HashJson(json(record)); }
+
+// 마지막으로 읽거나 저장한 레코드 배열의 사본 (되돌리기용, 파일을 다시 읽지 않음)
+// 레코드마다 공유 포인터로 들고 있어, 편집기가 바꾼 레코드만 표시해 두고 저장/되돌리기는 표시한 레코드만 복사
+// 구조가 바뀌었으면 (추가/삭제/일괄 편집) 내용 해시가 같은 레코드는 기존 사본(저장) / 현재 레코드(되돌리기)를 그대로 쓰고 나머지만 복사
+template <typename Records>
+class PristineSnapshot
+{
+	using Record = typename Records::value_type;
+
+public:
+	// 읽은 직후: 레코드마다 사본
+	void Reset(const Records& records)
+	{
+		_records.clear();
+		_hashes.clear();
+		_records.reserve(records.size());
+		_hashes.reserve(records.size());
+		for (const Record& record : records)
+		{
+			_records.push_back(std::make_shared<const Record>(record));
+			_hashes.push_back(SnapshotHash(record));
+		}
+		_valid = true;
+		ClearMarks();
+	}
+
+	// 저장 직후: 표시한 레코드만 사본에 반영
+	void Commit(const Records& records)
+	{
+		if (!_valid)
+		{
+			Reset(records);
+			return;
+		}
+
+		if (_all || records.size() != _records.size())
+		{
+			// 내용이 그대로인 레코드는 기존 사본을 같이 씀
+			std::unordered_map<uint64_t, size_t> saved;
+			saved.reserve(_hashes.size());
+			for (size_t i = 0; i < _hashes.size(); ++i)
+				saved.emplace(_hashes[i], i);
+
+			std::vector<std::shared_ptr<const Record>> next;
+			std::vector<uint64_t> hashes;
+			next.reserve(records.size());
+			hashes.reserve(records.size());
+			for (const Record& record : records)
+			{
+				uint64_t hash = SnapshotHash(record);
+				auto found = saved.find(hash);
+				next.push_back(found != saved.end() ? _records[found->second] : std::make_shared<const Record>(record));
+				hashes.push_back(hash);
+			}
+
+			_records.swap(next);
+			_hashes.swap(hashes);
+			ClearMarks();
+			return;
+		}
+
+		for (int record : _markedList)
+		{
+			_records[(size_t)record] = std::make_shared<const Record>(records[(size_t)record]);
+			_hashes[(size_t)record] = SnapshotHash(records[(size_t)record]);
+		}
+		ClearMarks();
+	}
+
+	void MarkRecord(int record)
+	{
+		if (_all)
+			return;
+		if (record < 0 || record >= (int)_records.size())
+		{
+			_all = true;
+			return;
+		}
+
+		if (_marked.size() != _records.size())
+			_marked.assign(_records.size(), 0);
+		if (!_marked[record])
+		{
+			_marked[record] = 1;
+			_markedList.push_back(record);
+		}
+	}
+
+	void MarkAll() { _all = true; }
+
+	bool IsValid() const { return _valid; }
+	bool IsDirty() const { return _all || !_markedList.empty(); }
+	int MarkedCount() const { return (int)_markedList.size(); }
+
+	// 저장된 상태로 되돌림
+	// 표시한 레코드만 복사했으면 그 인덱스를 restored 에 담고 true, 배열을 통째로 바꿨으면 false
+	bool Restore(Records& records, std::vector<int>& restored)
+	{
+		restored.clear();
+		if (!_valid)
+			return false;
+
+		if (_all || records.size() != _records.size())
+		{
+			// 저장된 것과 내용이 같은 현재 레코드는 옮겨 쓰고, 없는 것만 사본에서 복사
+			std::unordered_map<uint64_t, std::vector<size_t>> current;
+			current.reserve(records.size());
+			for (size_t i = 0; i < records.size(); ++i)
+				current[SnapshotHash(records[i])].push_back(i);
+
+			Records next{};
+			if constexpr (std::is_same_v<Records, json>)
+				next = json::array();
+
+			for (size_t i = 0; i < _records.size(); ++i)
+			{
+				auto found = current.find(_hashes[i]);
+				if (found != current.end() && !found->second.empty())
+				{
+					next.push_back(std::move(records[found->second.back()]));
+					found->second.pop_back();
+				}
+				else
+				{
+					next.push_back(*_records[i]);
+				}
+			}
+
+			records = std::move(next);
+			ClearMarks();
+			return false;
+		}
+
+		for (int record : _markedList)
+			records[(size_t)record] = *_records[(size_t)record];
+		restored.swap(_markedList);
+		ClearMarks();
+		return true;
+	}
+
+private:
+	std::vector<std::shared_ptr<const Record>> _records;
+	std::vector<uint64_t> _hashes;		// _records 의 SnapshotHash
+	bool _valid = false;
+	bool _all = false;
+	std::vector<uint8_t> _marked;
+	std::vector<int> _markedList;
+
+	void ClearMarks()
+	{
+		_all = false;
+		_marked.clear();
+		_markedList.clear();
+	}
+};
+
+// 디스크의 파일이 마지막으로 읽은 뒤 바뀌었는지 (크기/수정 시각이 같으면 그대로, 시각만 다르면 내용 해시로 확인)
+struct FileStamp
+{
+	std::string path;
+	bool exists = false;
+	uint64_t size = 0;
+	int64_t mtime = 0;
+	uint64_t hash = 0;
+
+	static FileStamp Of(const std::string& path);
+
+	// 내용이 같고 시각만 바뀌었으면 시각을 갱신하고 true
+	bool Unchanged();
+};
+
+// 여러 파일 중 하나라도 바뀌었으면 false
+bool FilesUnchanged(std::vector<FileStamp>& stamps);
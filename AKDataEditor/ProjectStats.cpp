@@ -0,0 +1,362 @@
+﻿#include "ProjectStats.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+namespace
+{
+	constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+}
+
+// ---------------------------------------------------------------------------
+// StatDistribution
+// ---------------------------------------------------------------------------
+
+void StatDistribution::Build(std::vector<double> values)
+{
+	values.erase(std::remove_if(values.begin(), values.end(), [](double v) { return v != v; }), values.end());
+	std::sort(values.begin(), values.end());
+
+	_sorted = std::move(values);
+	_sum = 0.0;
+	for (double value : _sorted)
+		_sum += value;
+	_histogramDirty = true;
+}
+
+void StatDistribution::Insert(double value)
+{
+	if (value != value)
+		return;
+
+	_sorted.insert(std::upper_bound(_sorted.begin(), _sorted.end(), value), value);
+	_sum += value;
+	_histogramDirty = true;
+}
+
+void StatDistribution::Erase(double value)
+{
+	if (value != value)
+		return;
+
+	auto it = std::lower_bound(_sorted.begin(), _sorted.end(), value);
+	if (it == _sorted.end() || *it != value)
+		return;
+
+	_sorted.erase(it);
+	_sum -= value;
+	_histogramDirty = true;
+}
+
+double StatDistribution::Min() const
+{
+	return _sorted.empty() ? NaN : _sorted.front();
+}
+
+double StatDistribution::Max() const
+{
+	return _sorted.empty() ? NaN : _sorted.back();
+}
+
+double StatDistribution::Mean() const
+{
+	return _sorted.empty() ? NaN : _sum / (double)_sorted.size();
+}
+
+double StatDistribution::Percentile(double p) const
+{
+	if (_sorted.empty())
+		return NaN;
+
+	double position = std::clamp(p, 0.0, 1.0) * (double)(_sorted.size() - 1);
+	size_t lower = (size_t)position;
+	size_t upper = std::min(lower + 1, _sorted.size() - 1);
+	double t = position - (double)lower;
+	return _sorted[lower] + (_sorted[upper] - _sorted[lower]) * t;
+}
+
+const std::vector<float>& StatDistribution::Histogram(int bins) const
+{
+	bins = std::max(1, bins);
+	if (!_histogramDirty && _histogramBins == bins)
+		return _histogram;
+
+	_histogram.assign(bins, 0.0f);
+	_histogramBins = bins;
+	_histogramDirty = false;
+
+	if (_sorted.empty())
+		return _histogram;
+
+	// 칸 경계마다 이진 탐색 (값 개수가 아니라 칸 수에 비례)
+	double low = _sorted.front();
+	double width = (_sorted.back() - low) / bins;
+	if (width <= 0.0)
+	{
+		_histogram[0] = (float)_sorted.size();
+		return _histogram;
+	}
+
+	auto begin = _sorted.begin();
+	for (int b = 0; b < bins; ++b)
+	{
+		auto end = (b == bins - 1) ? _sorted.end() : std::lower_bound(begin, _sorted.end(), low + width * (b + 1));
+		_histogram[b] = (float)(end - begin);
+		begin = end;
+	}
+	return _histogram;
+}
+
+// ---------------------------------------------------------------------------
+// RecordStatTable
+// ---------------------------------------------------------------------------
+
+RecordStatTable::RecordStatTable(std::vector<std::string> columns)
+	: _names(std::move(columns)), _columns(_names.size())
+{
+}
+
+void RecordStatTable::Build(const std::vector<std::vector<double>>& rows)
+{
+	const size_t columnCount = _names.size();
+	_recordCount = (int)rows.size();
+	_values.assign(rows.size() * columnCount, NaN);
+
+	for (size_t r = 0; r < rows.size(); ++r)
+	{
+		for (size_t c = 0; c < columnCount && c < rows[r].size(); ++c)
+			_values[r * columnCount + c] = rows[r][c];
+	}
+
+	// 열마다 따로 정렬
+	ParallelFor(columnCount, 1, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t c = begin; c < end; ++c)
+			{
+				std::vector<double> column(rows.size());
+				for (size_t r = 0; r < rows.size(); ++r)
+					column[r] = _values[r * columnCount + c];
+				_columns[c].Build(std::move(column));
+			}
+		});
+}
+
+void RecordStatTable::Set(int record, const std::vector<double>& values)
+{
+	if (record < 0 || record >= _recordCount)
+		return;
+
+	const size_t columnCount = _names.size();
+	for (size_t c = 0; c < columnCount; ++c)
+	{
+		double& current = _values[(size_t)record * columnCount + c];
+		double value = (c < values.size()) ? values[c] : NaN;
+		if (current == value || (current != current && value != value))
+			continue;
+
+		_columns[c].Erase(current);
+		_columns[c].Insert(value);
+		current = value;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// 테이블별 열
+// ---------------------------------------------------------------------------
+
+std::vector<std::string> EnemyStatColumns()
+{
+	return { "maxHp", "atk", "def", "magicResistance", "moveSpeed", "baseAttackTime", "rangeRadius", "isFlying" };
+}
+
+std::vector<double> EnemyStatValues(const EnemyStats* stats)
+{
+	if (!stats)
+		return std::vector<double>(EnemyStatColumns().size(), NaN);
+
+	return {
+		(double)stats->maxHp, (double)stats->atk, (double)stats->def, stats->magicResistance,
+		stats->moveSpeed, stats->baseAttackTime,
+		stats->rangeRadius >= 0.0 ? stats->rangeRadius : NaN,	// 근거리는 사거리 분포에서 제외
+		stats->isFlying ? 1.0 : 0.0
+	};
+}
+
+std::vector<std::string> OperatorStatColumns()
+{
+	return { "rarity", "maxHp", "atk", "def", "magicResistance", "cost", "blockCnt", "baseAttackTime", "respawnTime" };
+}
+
+std::vector<double> OperatorStatValues(const OperatorStats* stats)
+{
+	if (!stats)
+		return std::vector<double>(OperatorStatColumns().size(), NaN);
+
+	return {
+		(double)stats->rarity, (double)stats->maxHp, (double)stats->atk, (double)stats->def, stats->magicResistance,
+		(double)stats->cost, (double)stats->blockCnt, stats->baseAttackTime, (double)stats->respawnTime
+	};
+}
+
+std::vector<std::string> SkillStatColumns()
+{
+	return { "spCost", "initSp", "duration" };
+}
+
+std::vector<double> SkillStatValues(const Skill& skill)
+{
+	return { (double)skill.spData.spCost, (double)skill.spData.initSp, skill.duration };
+}
+
+// ---------------------------------------------------------------------------
+// 레벨
+// ---------------------------------------------------------------------------
+
+LevelSummary SummarizeLevel(const json& levelData)
+{
+	LevelSummary summary;
+
+	auto waves = levelData.find("waves");
+	if (waves == levelData.end() || !waves->is_array())
+		return summary;
+
+	// 웨이브는 순차 진행: 이전 웨이브의 마지막 스폰 + postDelay 이후 시작
+	double waveStart = 0.0;
+	for (const auto& wave : *waves)
+	{
+		double waveBase = waveStart + wave.value("preDelay", 0.0);
+		double waveEnd = waveBase;
+
+		auto fragments = wave.find("fragments");
+		if (fragments != wave.end() && fragments->is_array())
+		{
+			for (const auto& fragment : *fragments)
+			{
+				double fragmentBase = waveBase + fragment.value("preDelay", 0.0);
+
+				auto actions = fragment.find("actions");
+				if (actions == fragment.end() || !actions->is_array())
+					continue;
+
+				for (const auto& action : *actions)
+				{
+					++summary.actions;
+					if (action.value("actionType", 0) != 0)
+						continue;
+
+					int count = std::max(0, action.value("count", 1));
+					if (count == 0)
+						continue;
+
+					double actionBase = fragmentBase + action.value("preDelay", 0.0);
+					waveEnd = std::max(waveEnd, actionBase + action.value("interval", 0.0) * (count - 1));
+					summary.spawns += count;
+				}
+			}
+		}
+
+		summary.waveDurations.push_back(waveEnd - waveStart);
+		summary.duration = waveEnd;
+		waveStart = waveEnd + wave.value("postDelay", 0.0);
+	}
+
+	return summary;
+}
+
+int LevelStatTable::Sync(const std::vector<const json*>& levels, const std::vector<uint64_t>& revisions)
+{
+	if (_built && revisions == _revisions)
+		return 0;
+
+	// 순서/개수가 같으면 바뀐 레벨만 빼고 다시 넣음
+	if (_built && revisions.size() == _revisions.size())
+	{
+		int changed = 0;
+		for (size_t i = 0; i < revisions.size(); ++i)
+		{
+			if (revisions[i] == _revisions[i])
+				continue;
+
+			Remove(_summaries[i]);
+			_summaries[i] = levels[i] ? SummarizeLevel(*levels[i]) : LevelSummary();
+			Add(_summaries[i]);
+			_revisions[i] = revisions[i];
+			++changed;
+		}
+		return changed;
+	}
+
+	// 목록이 바뀌면 revision 이 같은 레벨의 요약은 옮겨 쓰고 나머지만 병렬로 요약
+	std::unordered_map<uint64_t, size_t> previous;
+	previous.reserve(_revisions.size());
+	for (size_t i = 0; i < _revisions.size(); ++i)
+		previous.emplace(_revisions[i], i);
+
+	std::vector<LevelSummary> summaries(levels.size());
+	std::vector<size_t> stale;
+	for (size_t i = 0; i < levels.size(); ++i)
+	{
+		auto it = previous.find(revisions[i]);
+		if (_built && it != previous.end())
+			summaries[i] = _summaries[it->second];
+		else
+			stale.push_back(i);
+	}
+
+	ParallelFor(stale.size(), 8, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t s = begin; s < end; ++s)
+			{
+				size_t i = stale[s];
+				if (levels[i])
+					summaries[i] = SummarizeLevel(*levels[i]);
+			}
+		});
+
+	_summaries = std::move(summaries);
+	_revisions = revisions;
+	_built = true;
+	RebuildDistributions();
+	return (int)stale.size();
+}
+
+void LevelStatTable::Add(const LevelSummary& summary)
+{
+	_spawns.Insert(summary.spawns);
+	_durations.Insert(summary.duration);
+	_waveCounts.Insert((double)summary.waveDurations.size());
+	for (double duration : summary.waveDurations)
+		_waveDurations.Insert(duration);
+}
+
+void LevelStatTable::Remove(const LevelSummary& summary)
+{
+	_spawns.Erase(summary.spawns);
+	_durations.Erase(summary.duration);
+	_waveCounts.Erase((double)summary.waveDurations.size());
+	for (double duration : summary.waveDurations)
+		_waveDurations.Erase(duration);
+}
+
+void LevelStatTable::RebuildDistributions()
+{
+	std::vector<double> spawns, durations, waveCounts, waveDurations;
+	spawns.reserve(_summaries.size());
+	durations.reserve(_summaries.size());
+	waveCounts.reserve(_summaries.size());
+
+	for (const LevelSummary& summary : _summaries)
+	{
+		spawns.push_back(summary.spawns);
+		durations.push_back(summary.duration);
+		waveCounts.push_back((double)summary.waveDurations.size());
+		waveDurations.insert(waveDurations.end(), summary.waveDurations.begin(), summary.waveDurations.end());
+	}
+
+	_spawns.Build(std::move(spawns));
+	_durations.Build(std::move(durations));
+	_waveCounts.Build(std::move(waveCounts));
+	_waveDurations.Build(std::move(waveDurations));
+}
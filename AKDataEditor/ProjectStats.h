@@ -0,0 +1,114 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "GameTables.h"
+#include "Skill.h"
+
+using json = nlohmann::ordered_json;
+
+// 정렬된 값 모음 (NaN 은 넣지 않음)
+// 값 하나 추가/삭제는 이진 탐색 + 이동, 개수/최소/최대/평균/백분위는 바로 읽음
+class StatDistribution
+{
+public:
+	void Build(std::vector<double> values);
+	void Insert(double value);
+	void Erase(double value);
+
+	size_t Count() const { return _sorted.size(); }
+	double Sum() const { return _sum; }
+	double Min() const;
+	double Max() const;
+	double Mean() const;
+	double Percentile(double p) const;		// p = 0 ~ 1, 선형 보간
+
+	// [Min, Max] 를 bins 칸으로 나눈 개수 (값이 바뀌기 전까지 다시 세지 않음)
+	const std::vector<float>& Histogram(int bins) const;
+
+private:
+	std::vector<double> _sorted;
+	double _sum = 0.0;
+
+	mutable std::vector<float> _histogram;
+	mutable int _histogramBins = 0;
+	mutable bool _histogramDirty = true;
+};
+
+// 레코드마다 여러 열의 값을 가진 표의 열별 분포
+// 레코드 하나가 바뀌면 그 레코드의 이전 값만 빼고 새 값을 넣음 (구조가 바뀌면 Build)
+class RecordStatTable
+{
+public:
+	explicit RecordStatTable(std::vector<std::string> columns);
+
+	void Build(const std::vector<std::vector<double>>& rows);	// [레코드][열]
+	void Set(int record, const std::vector<double>& values);
+
+	int RecordCount() const { return _recordCount; }
+	int ColumnCount() const { return (int)_names.size(); }
+	const std::string& ColumnName(int column) const { return _names[column]; }
+	const StatDistribution& Column(int column) const { return _columns[column]; }
+
+private:
+	std::vector<std::string> _names;
+	std::vector<StatDistribution> _columns;
+	std::vector<double> _values;		// [레코드 * 열 수 + 열]
+	int _recordCount = 0;
+};
+
+// 적: 기본 변형 (value[0]) 기준
+std::vector<std::string> EnemyStatColumns();
+std::vector<double> EnemyStatValues(const EnemyStats* stats);
+
+// 오퍼레이터: ParseOperatorStats 기본 (마지막 정예화, 최대 레벨) 기준
+std::vector<std::string> OperatorStatColumns();
+std::vector<double> OperatorStatValues(const OperatorStats* stats);
+
+// 스킬: spData 와 지속 시간
+std::vector<std::string> SkillStatColumns();
+std::vector<double> SkillStatValues(const Skill& skill);
+
+// 레벨 하나 요약 (웨이브 시간은 BuildSpawnEvents 와 같은 규칙, 이벤트는 만들지 않음)
+struct LevelSummary
+{
+	int spawns = 0;						// actionType 0 의 count 합
+	int actions = 0;
+	std::vector<double> waveDurations;	// 웨이브 시작 ~ 마지막 스폰 (preDelay 포함)
+	double duration = 0.0;				// 마지막 스폰 시각
+};
+
+LevelSummary SummarizeLevel(const json& levelData);
+
+// 레벨별 요약과 레벨 간 분포
+// revision 이 바뀐 레벨만 다시 요약하고, 목록이 바뀌면 revision 이 같은 레벨의 요약은 재사용
+class LevelStatTable
+{
+public:
+	// 다시 요약한 레벨 수
+	int Sync(const std::vector<const json*>& levels, const std::vector<uint64_t>& revisions);
+
+	int LevelCount() const { return (int)_summaries.size(); }
+	const LevelSummary& Summary(int level) const { return _summaries[level]; }
+
+	const StatDistribution& Spawns() const { return _spawns; }
+	const StatDistribution& Durations() const { return _durations; }
+	const StatDistribution& WaveCounts() const { return _waveCounts; }
+	const StatDistribution& WaveDurations() const { return _waveDurations; }
+
+private:
+	std::vector<LevelSummary> _summaries;
+	std::vector<uint64_t> _revisions;
+	bool _built = false;
+
+	StatDistribution _spawns;
+	StatDistribution _durations;
+	StatDistribution _waveCounts;
+	StatDistribution _waveDurations;
+
+	void Add(const LevelSummary& summary);
+	void Remove(const LevelSummary& summary);
+	void RebuildDistributions();
+};
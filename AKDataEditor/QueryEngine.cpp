@@ -0,0 +1,2036 @@
+﻿#include "QueryEngine.h"
+#include "GameTables.h"
+#include "DataFiles.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <limits>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	constexpr size_t BLOCK_SIZE = 1024;
+	constexpr size_t MAX_GROUP_KEYS = 8;
+	constexpr size_t MAX_POOL_STRINGS = 1 << 20;
+	constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+	using Clock = std::chrono::steady_clock;
+
+	double ElapsedMs(Clock::time_point from, Clock::time_point to)
+	{
+		return std::chrono::duration<double, std::milli>(to - from).count();
+	}
+
+	// -----------------------------------------------------------------------
+	// 열 정의
+	// -----------------------------------------------------------------------
+
+	// 열 추출에 쓰는 원본 (표마다 쓰는 것만 채움)
+	struct RowSource
+	{
+		const json* records = nullptr;		// enemies[] / operators[]
+		const std::vector<Skill>* skills = nullptr;
+		const std::vector<QueryActionRow>* actions = nullptr;
+		const std::vector<QueryLevel>* levels = nullptr;
+		const std::vector<int>* enemyRows = nullptr;
+		const AttributeBatchResult* attributes = nullptr;	// operators[] 스탯 (마지막 정예화, 최대 레벨)
+	};
+
+	struct Cell
+	{
+		double number = NaN;
+		const std::string* text = nullptr;
+	};
+
+	using RowReader = Cell(*)(const RowSource& src, size_t row);
+	using EnemyReader = Cell(*)(const json& enemy);
+
+	struct ColumnDef
+	{
+		std::string name;
+		bool isString = false;
+		RowReader read = nullptr;
+		EnemyReader enemy = nullptr;	// 적 레코드 기준 (Enemies 표, Actions 의 enemy.* 조인)
+	};
+
+	const json* Member(const json* node, const char* key)
+	{
+		if (!node || !node->is_object())
+			return nullptr;
+
+		auto it = node->find(key);
+		return (it != node->end()) ? &*it : nullptr;
+	}
+
+	const json* Element(const json* node, size_t index)
+	{
+		return (node && node->is_array() && index < node->size()) ? &(*node)[index] : nullptr;
+	}
+
+	// value[0].<path>, { m_defined, m_value } 는 값만
+	const json* EnemyValue(const json& enemy, std::initializer_list<const char*> path)
+	{
+		const json* node = Element(Member(&enemy, "value"), 0);
+		for (const char* token : path)
+			node = Member(node, token);
+
+		if (node && node->is_object())
+			return Member(node, "m_value");
+		return node;
+	}
+
+	// 곡선이 없는 오퍼레이터는 빈 칸
+	Cell OperatorValue(const RowSource& src, size_t row, AttributeField field)
+	{
+		Cell cell;
+		if (row < src.attributes->available.size() && src.attributes->available[row])
+			cell.number = src.attributes->Get((int)row, field);
+		return cell;
+	}
+
+	Cell NumberCell(const json* node)
+	{
+		Cell cell;
+		if (node && node->is_number())
+			cell.number = node->get<double>();
+		else if (node && node->is_boolean())
+			cell.number = node->get<bool>() ? 1.0 : 0.0;
+		return cell;
+	}
+
+	Cell NumberCell(double value)
+	{
+		Cell cell;
+		cell.number = value;
+		return cell;
+	}
+
+	Cell TextCell(const json* node)
+	{
+		Cell cell;
+		if (node && node->is_string())
+			cell.text = &node->get_ref<const std::string&>();
+		return cell;
+	}
+
+	Cell TextCell(const std::string& text)
+	{
+		Cell cell;
+		cell.text = &text;
+		return cell;
+	}
+
+	Cell SizeCell(const json* node)
+	{
+		return NumberCell((node && node->is_array()) ? (double)node->size() : 0.0);
+	}
+
+	const std::vector<ColumnDef>& EnemyFields()
+	{
+		static const std::vector<ColumnDef> fields = {
+			{ "key", true, nullptr, [](const json& e) { return TextCell(Member(&e, "key")); } },
+			{ "name", true, nullptr, [](const json& e) { return TextCell(EnemyValue(e, { "enemyData", "name" })); } },
+			{ "type", true, nullptr, [](const json& e) { return TextCell(EnemyValue(e, { "enemyData", "type" })); } },
+			{ "maxHp", false, nullptr, [](const json& e) { return NumberCell(EnemyValue(e, { "enemyData", "attributes", "maxHp" })); } },
+			{ "atk", false, nullptr, [](const json& e) { return NumberCell(EnemyValue(e, { "enemyData", "attributes", "atk" })); } },
+			{ "def", false, nullptr, [](const json& e) { return NumberCell(EnemyValue(e, { "enemyData", "attributes", "def" })); } },
+			{ "magicResistance", false, nullptr, [](const json& e) { return NumberCell(EnemyValue(e, { "enemyData", "attributes", "magicResistance" })); } },
+			{ "moveSpeed", false, nullptr, [](const json& e) { return NumberCell(EnemyValue(e, { "enemyData", "attributes", "moveSpeed" })); } },
+			{ "baseAttackTime", false, nullptr, [](const json& e) { return NumberCell(EnemyValue(e, { "enemyData", "attributes", "baseAttackTime" })); } },
+			{ "rangeRadius", false, nullptr, [](const json& e) { return NumberCell(EnemyValue(e, { "enemyData", "rangeRadius" })); } },
+			{ "lifePointReduce", false, nullptr, [](const json& e) { return NumberCell(EnemyValue(e, { "enemyData", "lifePointReduce" })); } },
+			{ "variantCount", false, nullptr, [](const json& e) { return SizeCell(Member(&e, "value")); } },
+		};
+		return fields;
+	}
+
+	const std::vector<ColumnDef>& ColumnDefs(QueryTable table)
+	{
+		static const std::vector<ColumnDef> operators = {
+			{ "charId", true, [](const RowSource& s, size_t i) { return TextCell(Member(&(*s.records)[i], "charId")); } },
+			{ "name", true, [](const RowSource& s, size_t i) { return TextCell(Member(&(*s.records)[i], "name")); } },
+			{ "profession", true, [](const RowSource& s, size_t i) { return TextCell(Member(&(*s.records)[i], "profession")); } },
+			{ "position", true, [](const RowSource& s, size_t i) { return TextCell(Member(&(*s.records)[i], "position")); } },
+			{ "rarity", false, [](const RowSource& s, size_t i) { return NumberCell(Member(&(*s.records)[i], "rarity")); } },
+			{ "maxHp", false, [](const RowSource& s, size_t i) { return OperatorValue(s, i, AttributeField::MaxHp); } },
+			{ "atk", false, [](const RowSource& s, size_t i) { return OperatorValue(s, i, AttributeField::Atk); } },
+			{ "def", false, [](const RowSource& s, size_t i) { return OperatorValue(s, i, AttributeField::Def); } },
+			{ "magicResistance", false, [](const RowSource& s, size_t i) { return OperatorValue(s, i, AttributeField::MagicResistance); } },
+			{ "cost", false, [](const RowSource& s, size_t i) { return OperatorValue(s, i, AttributeField::Cost); } },
+			{ "blockCnt", false, [](const RowSource& s, size_t i) { return OperatorValue(s, i, AttributeField::BlockCnt); } },
+			{ "baseAttackTime", false, [](const RowSource& s, size_t i) { return OperatorValue(s, i, AttributeField::BaseAttackTime); } },
+			{ "respawnTime", false, [](const RowSource& s, size_t i) { return OperatorValue(s, i, AttributeField::RespawnTime); } },
+			{ "phaseCount", false, [](const RowSource& s, size_t i) { return SizeCell(Member(&(*s.records)[i], "phases")); } },
+			{ "skillCount", false, [](const RowSource& s, size_t i) { return SizeCell(Member(&(*s.records)[i], "skillIds")); } },
+		};
+
+		static const std::vector<ColumnDef> skills = {
+			{ "skillId", true, [](const RowSource& s, size_t i) { return TextCell((*s.skills)[i].skillId); } },
+			{ "operatorId", true, [](const RowSource& s, size_t i) { return TextCell((*s.skills)[i].operatorId); } },
+			{ "name", true, [](const RowSource& s, size_t i) { return TextCell((*s.skills)[i].name); } },
+			{ "skillType", false, [](const RowSource& s, size_t i) { return NumberCell((double)(*s.skills)[i].skillType); } },
+			{ "duration", false, [](const RowSource& s, size_t i) { return NumberCell((*s.skills)[i].duration); } },
+			{ "spType", false, [](const RowSource& s, size_t i) { return NumberCell((double)(*s.skills)[i].spData.spType); } },
+			{ "spCost", false, [](const RowSource& s, size_t i) { return NumberCell((double)(*s.skills)[i].spData.spCost); } },
+			{ "initSp", false, [](const RowSource& s, size_t i) { return NumberCell((double)(*s.skills)[i].spData.initSp); } },
+			{ "rangeSize", false, [](const RowSource& s, size_t i) { return NumberCell((double)(*s.skills)[i].range.size()); } },
+			{ "blackboardCount", false, [](const RowSource& s, size_t i) { return NumberCell((double)(*s.skills)[i].blackboard.size()); } },
+		};
+
+		static const std::vector<ColumnDef> actions = []()
+			{
+				std::vector<ColumnDef> defs = {
+					{ "levelId", true, [](const RowSource& s, size_t i) { return TextCell((*s.levels)[(*s.actions)[i].level].levelId); } },
+					{ "wave", false, [](const RowSource& s, size_t i) { return NumberCell((double)(*s.actions)[i].wave); } },
+					{ "fragment", false, [](const RowSource& s, size_t i) { return NumberCell((double)(*s.actions)[i].fragment); } },
+					{ "action", false, [](const RowSource& s, size_t i) { return NumberCell((double)(*s.actions)[i].action); } },
+					{ "key", true, [](const RowSource& s, size_t i) { return TextCell(Member((*s.actions)[i].node, "key")); } },
+					{ "count", false, [](const RowSource& s, size_t i) { return NumberCell(Member((*s.actions)[i].node, "count")); } },
+					{ "routeIndex", false, [](const RowSource& s, size_t i) { return NumberCell(Member((*s.actions)[i].node, "routeIndex")); } },
+					{ "actionType", false, [](const RowSource& s, size_t i) { return NumberCell(Member((*s.actions)[i].node, "actionType")); } },
+					{ "preDelay", false, [](const RowSource& s, size_t i) { return NumberCell(Member((*s.actions)[i].node, "preDelay")); } },
+					{ "interval", false, [](const RowSource& s, size_t i) { return NumberCell(Member((*s.actions)[i].node, "interval")); } },
+					{ "fragmentPreDelay", false, [](const RowSource& s, size_t i) { return NumberCell(Member((*s.actions)[i].fragmentNode, "preDelay")); } },
+				};
+
+				// enemy.<필드> 는 key 로 enemies[] 를 찾아 읽음
+				for (const ColumnDef& field : EnemyFields())
+				{
+					if (field.name == "key")
+						continue;
+
+					ColumnDef def = field;
+					def.name = "enemy." + field.name;
+					defs.push_back(def);
+				}
+				return defs;
+			}();
+
+		switch (table)
+		{
+		case QueryTable::Operators: return operators;
+		case QueryTable::Skills: return skills;
+		case QueryTable::Actions: return actions;
+		default: return EnemyFields();
+		}
+	}
+
+	const ColumnDef* FindColumnDef(QueryTable table, const std::string& name)
+	{
+		for (const ColumnDef& def : ColumnDefs(table))
+		{
+			if (def.name == name)
+				return &def;
+		}
+		return nullptr;
+	}
+
+	// -----------------------------------------------------------------------
+	// 파싱 (식은 트리로 남겨 두고 계획 단계에서 행 / 그룹 프로그램으로 나눠 컴파일)
+	// -----------------------------------------------------------------------
+
+	struct QueryError
+	{
+		std::string message;
+	};
+
+	enum class NodeKind { Number, String, Column, Unary, Binary, Call, Aggregate };
+
+	struct Node
+	{
+		NodeKind kind = NodeKind::Number;
+		std::string text;		// 열 / 함수 / 연산자 이름, 문자열 상수
+		double number = 0.0;
+		std::vector<int> args;
+		size_t begin = 0;		// 원문 범위 (표시 이름, 그룹 키 비교용)
+		size_t end = 0;
+	};
+
+	enum class AggregateFunc { Count, Sum, Min, Max, Avg };
+
+	struct SelectItem
+	{
+		int expr = -1;
+		std::string name;
+	};
+
+	struct OrderItem
+	{
+		std::string name;
+		bool descending = false;
+		size_t pos = 0;
+	};
+
+	struct ParsedQuery
+	{
+		QueryTable table = QueryTable::MAX;
+		std::vector<Node> nodes;
+		int where = -1;
+		std::vector<int> groupBy;
+		std::vector<SelectItem> select;
+		bool selectAll = false;
+		int having = -1;
+		std::vector<OrderItem> orderBy;
+		long long limit = -1;
+	};
+
+	bool EqualsIgnoreCase(const std::string& a, const char* b)
+	{
+		size_t length = std::strlen(b);
+		if (a.size() != length)
+			return false;
+
+		for (size_t i = 0; i < length; ++i)
+		{
+			if (std::tolower((unsigned char)a[i]) != b[i])
+				return false;
+		}
+		return true;
+	}
+
+	class QueryParser
+	{
+	public:
+		QueryParser(const std::string& source, ParsedQuery& out)
+			: _src(source), _out(out)
+		{
+		}
+
+		void Parse()
+		{
+			Next();
+			bool seen[7] = {};
+
+			while (_token.kind != TokenKind::End)
+			{
+				if (_token.kind != TokenKind::Ident)
+					Fail("절 (from / where / group by / select / having / order by / limit) 이 필요합니다");
+
+				int clause = -1;
+				static const char* clauses[] = { "from", "where", "group", "select", "having", "order", "limit" };
+				for (int i = 0; i < 7; ++i)
+				{
+					if (EqualsIgnoreCase(_token.text, clauses[i]))
+						clause = i;
+				}
+				if (clause < 0)
+					Fail("알 수 없는 절 '" + _token.text + "'");
+				if (seen[clause])
+					Fail(std::string("'") + clauses[clause] + "' 절이 두 번 있습니다");
+				seen[clause] = true;
+				Next();
+
+				switch (clause)
+				{
+				case 0: ParseFrom(); break;
+				case 1: _out.where = ParseExpr(); break;
+				case 2: ExpectKeyword("by"); _out.groupBy = ParseExprList(); break;
+				case 3: ParseSelect(); break;
+				case 4: _out.having = ParseExpr(); break;
+				case 5: ExpectKeyword("by"); ParseOrderBy(); break;
+				case 6: ParseLimit(); break;
+				}
+			}
+
+			if (_out.table == QueryTable::MAX)
+				throw QueryError{ "from <표> 가 필요합니다 (enemies / operators / skills / actions)" };
+			if (_out.groupBy.size() > MAX_GROUP_KEYS)
+				throw QueryError{ "group by 키는 최대 " + std::to_string(MAX_GROUP_KEYS) + "개입니다" };
+		}
+
+	private:
+		enum class TokenKind { Number, String, Ident, Symbol, End };
+
+		struct Token
+		{
+			TokenKind kind = TokenKind::End;
+			std::string text;
+			double number = 0.0;
+			size_t pos = 0;
+		};
+
+		const std::string& _src;
+		ParsedQuery& _out;
+		size_t _pos = 0;
+		size_t _lastEnd = 0;	// 직전 토큰의 끝
+		Token _token;
+
+		[[noreturn]] void Fail(const std::string& message) const
+		{
+			throw QueryError{ "위치 " + std::to_string(_token.pos + 1) + ": " + message };
+		}
+
+		void Next()
+		{
+			_lastEnd = _pos;
+			while (_pos < _src.size() && std::isspace((unsigned char)_src[_pos]))
+				++_pos;
+
+			_token = Token();
+			_token.pos = _pos;
+
+			if (_pos >= _src.size())
+				return;
+
+			char ch = _src[_pos];
+
+			if (std::isdigit((unsigned char)ch) || (ch == '.' && _pos + 1 < _src.size() && std::isdigit((unsigned char)_src[_pos + 1])))
+			{
+				char* end = nullptr;
+				_token.kind = TokenKind::Number;
+				_token.number = std::strtod(_src.c_str() + _pos, &end);
+				_pos = end - _src.c_str();
+				return;
+			}
+
+			if (std::isalpha((unsigned char)ch) || ch == '_')
+			{
+				size_t start = _pos;
+				while (_pos < _src.size() && (std::isalnum((unsigned char)_src[_pos]) || _src[_pos] == '_' || _src[_pos] == '.'))
+					++_pos;
+
+				_token.kind = TokenKind::Ident;
+				_token.text = _src.substr(start, _pos - start);
+				return;
+			}
+
+			if (ch == '"' || ch == '\'')
+			{
+				size_t end = _src.find(ch, _pos + 1);
+				if (end == std::string::npos)
+					Fail("문자열이 닫히지 않았습니다");
+
+				_token.kind = TokenKind::String;
+				_token.text = _src.substr(_pos + 1, end - _pos - 1);
+				_pos = end + 1;
+				return;
+			}
+
+			static const char* symbols[] = {
+				"==", "!=", "<>", "<=", ">=", "&&", "||",
+				"=", "<", ">", "+", "-", "*", "/", "%", "(", ")", ",", "!"
+			};
+			for (const char* symbol : symbols)
+			{
+				size_t length = std::strlen(symbol);
+				if (_src.compare(_pos, length, symbol) == 0)
+				{
+					_token.kind = TokenKind::Symbol;
+					_token.text = symbol;
+					_pos += length;
+					return;
+				}
+			}
+
+			Fail(std::string("알 수 없는 문자 '") + ch + "'");
+		}
+
+		bool IsSymbol(const char* symbol) const
+		{
+			return _token.kind == TokenKind::Symbol && _token.text == symbol;
+		}
+
+		bool IsKeyword(const char* keyword) const
+		{
+			return _token.kind == TokenKind::Ident && EqualsIgnoreCase(_token.text, keyword);
+		}
+
+		void Expect(const char* symbol)
+		{
+			if (!IsSymbol(symbol))
+				Fail(std::string("'") + symbol + "' 가 필요합니다");
+			Next();
+		}
+
+		void ExpectKeyword(const char* keyword)
+		{
+			if (!IsKeyword(keyword))
+				Fail(std::string("'") + keyword + "' 가 필요합니다");
+			Next();
+		}
+
+		int AddNode(Node node)
+		{
+			_out.nodes.push_back(std::move(node));
+			return (int)_out.nodes.size() - 1;
+		}
+
+		int MakeNode(NodeKind kind, const std::string& text, std::vector<int> args, size_t begin)
+		{
+			Node node;
+			node.kind = kind;
+			node.text = text;
+			node.args = std::move(args);
+			node.begin = begin;
+			node.end = _lastEnd;
+			return AddNode(std::move(node));
+		}
+
+		void ParseFrom()
+		{
+			if (_token.kind != TokenKind::Ident)
+				Fail("표 이름이 필요합니다");
+
+			for (int t = 0; t < (int)QueryTable::MAX; ++t)
+			{
+				if (EqualsIgnoreCase(_token.text, QueryTableName((QueryTable)t)))
+					_out.table = (QueryTable)t;
+			}
+			if (_out.table == QueryTable::MAX)
+				Fail("알 수 없는 표 '" + _token.text + "' (enemies / operators / skills / actions)");
+			Next();
+		}
+
+		std::vector<int> ParseExprList()
+		{
+			std::vector<int> list = { ParseExpr() };
+			while (IsSymbol(","))
+			{
+				Next();
+				list.push_back(ParseExpr());
+			}
+			return list;
+		}
+
+		void ParseSelect()
+		{
+			if (IsSymbol("*"))
+			{
+				Next();
+				_out.selectAll = true;
+				return;
+			}
+
+			do
+			{
+				if (!_out.select.empty())
+					Next();
+
+				SelectItem item;
+				item.expr = ParseExpr();
+				const Node& node = _out.nodes[item.expr];
+				item.name = _src.substr(node.begin, node.end - node.begin);
+				while (!item.name.empty() && std::isspace((unsigned char)item.name.back()))
+					item.name.pop_back();
+
+				if (IsKeyword("as"))
+				{
+					Next();
+					if (_token.kind != TokenKind::Ident && _token.kind != TokenKind::String)
+						Fail("as 다음에 이름이 필요합니다");
+					item.name = _token.text;
+					Next();
+				}
+				_out.select.push_back(item);
+			} while (IsSymbol(","));
+		}
+
+		void ParseOrderBy()
+		{
+			do
+			{
+				if (!_out.orderBy.empty())
+					Next();
+
+				OrderItem item;
+				item.pos = _token.pos;
+				if (_token.kind == TokenKind::Ident || _token.kind == TokenKind::String)
+				{
+					item.name = _token.text;
+					Next();
+				}
+				else
+				{
+					// count(), sum(x) 처럼 select 에 쓴 식 그대로
+					const Node& node = _out.nodes[ParseExpr()];
+					item.name = _src.substr(node.begin, node.end - node.begin);
+					while (!item.name.empty() && std::isspace((unsigned char)item.name.back()))
+						item.name.pop_back();
+				}
+
+				if (IsKeyword("desc"))
+				{
+					item.descending = true;
+					Next();
+				}
+				else if (IsKeyword("asc"))
+				{
+					Next();
+				}
+				_out.orderBy.push_back(item);
+			} while (IsSymbol(","));
+		}
+
+		void ParseLimit()
+		{
+			if (_token.kind != TokenKind::Number || _token.number < 0 || _token.number != std::floor(_token.number))
+				Fail("limit 다음에 0 이상의 정수가 필요합니다");
+			_out.limit = (long long)_token.number;
+			Next();
+		}
+
+		int ParseExpr()
+		{
+			size_t begin = _token.pos;
+			int lhs = ParseAnd();
+			while (IsKeyword("or") || IsSymbol("||"))
+			{
+				Next();
+				int rhs = ParseAnd();
+				lhs = MakeNode(NodeKind::Binary, "or", { lhs, rhs }, begin);
+			}
+			return lhs;
+		}
+
+		int ParseAnd()
+		{
+			size_t begin = _token.pos;
+			int lhs = ParseNot();
+			while (IsKeyword("and") || IsSymbol("&&"))
+			{
+				Next();
+				int rhs = ParseNot();
+				lhs = MakeNode(NodeKind::Binary, "and", { lhs, rhs }, begin);
+			}
+			return lhs;
+		}
+
+		int ParseNot()
+		{
+			size_t begin = _token.pos;
+			if (IsKeyword("not") || IsSymbol("!"))
+			{
+				Next();
+				int operand = ParseNot();
+				return MakeNode(NodeKind::Unary, "not", { operand }, begin);
+			}
+			return ParseCompare();
+		}
+
+		int ParseCompare()
+		{
+			size_t begin = _token.pos;
+			int lhs = ParseAdd();
+
+			// SQL 처럼 = / <> 도 받음
+			static const char* ops[] = { "==", "=", "!=", "<>", "<", "<=", ">", ">=" };
+			static const char* names[] = { "==", "==", "!=", "!=", "<", "<=", ">", ">=" };
+			for (int i = 0; i < 8; ++i)
+			{
+				if (!IsSymbol(ops[i]))
+					continue;
+
+				Next();
+				int rhs = ParseAdd();
+				return MakeNode(NodeKind::Binary, names[i], { lhs, rhs }, begin);
+			}
+			return lhs;
+		}
+
+		int ParseAdd()
+		{
+			size_t begin = _token.pos;
+			int lhs = ParseMul();
+			while (IsSymbol("+") || IsSymbol("-"))
+			{
+				std::string op = _token.text;
+				Next();
+				int rhs = ParseMul();
+				lhs = MakeNode(NodeKind::Binary, op, { lhs, rhs }, begin);
+			}
+			return lhs;
+		}
+
+		int ParseMul()
+		{
+			size_t begin = _token.pos;
+			int lhs = ParseUnary();
+			while (IsSymbol("*") || IsSymbol("/") || IsSymbol("%"))
+			{
+				std::string op = _token.text;
+				Next();
+				int rhs = ParseUnary();
+				lhs = MakeNode(NodeKind::Binary, op, { lhs, rhs }, begin);
+			}
+			return lhs;
+		}
+
+		int ParseUnary()
+		{
+			size_t begin = _token.pos;
+			if (IsSymbol("-"))
+			{
+				Next();
+				int operand = ParseUnary();
+				return MakeNode(NodeKind::Unary, "-", { operand }, begin);
+			}
+			return ParsePrimary();
+		}
+
+		int ParsePrimary()
+		{
+			size_t begin = _token.pos;
+
+			if (_token.kind == TokenKind::Number)
+			{
+				double number = _token.number;
+				Next();
+				int node = MakeNode(NodeKind::Number, "", {}, begin);
+				_out.nodes[node].number = number;
+				return node;
+			}
+
+			if (_token.kind == TokenKind::String)
+			{
+				std::string text = _token.text;
+				Next();
+				return MakeNode(NodeKind::String, text, {}, begin);
+			}
+
+			if (IsSymbol("("))
+			{
+				Next();
+				int inner = ParseExpr();
+				Expect(")");
+
+				// 괄호까지 원문 범위에 포함
+				_out.nodes[inner].begin = begin;
+				_out.nodes[inner].end = _lastEnd;
+				return inner;
+			}
+
+			if (_token.kind != TokenKind::Ident)
+				Fail("값이 필요합니다");
+
+			std::string name = _token.text;
+			Next();
+
+			if (!IsSymbol("("))
+				return MakeNode(NodeKind::Column, name, {}, begin);
+
+			Next();
+			std::vector<int> args;
+			bool star = false;
+			if (IsSymbol("*"))
+			{
+				// count(*)
+				star = true;
+				Next();
+			}
+			else if (!IsSymbol(")"))
+			{
+				args = ParseExprList();
+			}
+			Expect(")");
+
+			// min / max 는 인자가 하나면 집계, 둘이면 일반 함수
+			static const char* aggregates[] = { "count", "sum", "min", "max", "avg" };
+			for (const char* aggregate : aggregates)
+			{
+				if (name != aggregate)
+					continue;
+				if ((name == "min" || name == "max") && args.size() != 1)
+					break;
+				if (name == "count" ? args.size() > 1 : args.size() != 1)
+					Fail("'" + name + "' 의 인자 개수가 맞지 않습니다");
+
+				return MakeNode(NodeKind::Aggregate, name, args, begin);
+			}
+
+			if (star)
+				Fail("'*' 는 count(*) 에서만 쓸 수 있습니다");
+			return MakeNode(NodeKind::Call, name, args, begin);
+		}
+	};
+
+	// -----------------------------------------------------------------------
+	// 블록 단위 식 실행 (일괄 편집과 같은 레지스터 명령)
+	// -----------------------------------------------------------------------
+
+	enum class OpCode
+	{
+		Input, Const,
+		Add, Sub, Mul, Div, Mod, Neg,
+		Eq, Ne, Lt, Le, Gt, Ge,
+		And, Or, Not,
+		Round, Floor, Ceil, Abs, Min, Max, Clamp
+	};
+
+	struct Instruction
+	{
+		OpCode op = OpCode::Const;
+		int dst = 0;
+		int a = -1;
+		int b = -1;
+		int c = -1;
+		double constant = 0.0;
+	};
+
+	struct Program
+	{
+		std::vector<Instruction> code;
+		int registerCount = 0;
+
+		// inputs[i] + begin 부터 n 개를 읽어 registers ([레지스터][BLOCK_SIZE]) 에 계산
+		void Run(const std::vector<const double*>& inputs, size_t begin, size_t n, double* registers) const
+		{
+			auto R = [&](int reg) { return registers + (size_t)reg * BLOCK_SIZE; };
+
+			for (const Instruction& inst : code)
+			{
+				double* d = R(inst.dst);
+				const double* a = (inst.a >= 0 && inst.op != OpCode::Input) ? R(inst.a) : nullptr;
+				const double* b = (inst.b >= 0) ? R(inst.b) : nullptr;
+				const double* c = (inst.c >= 0) ? R(inst.c) : nullptr;
+
+				switch (inst.op)
+				{
+				case OpCode::Input:
+					std::copy(inputs[inst.a] + begin, inputs[inst.a] + begin + n, d);
+					break;
+				case OpCode::Const:
+					std::fill(d, d + n, inst.constant);
+					break;
+				case OpCode::Add: for (size_t i = 0; i < n; ++i) d[i] = a[i] + b[i]; break;
+				case OpCode::Sub: for (size_t i = 0; i < n; ++i) d[i] = a[i] - b[i]; break;
+				case OpCode::Mul: for (size_t i = 0; i < n; ++i) d[i] = a[i] * b[i]; break;
+				case OpCode::Div: for (size_t i = 0; i < n; ++i) d[i] = a[i] / b[i]; break;
+				case OpCode::Mod: for (size_t i = 0; i < n; ++i) d[i] = std::fmod(a[i], b[i]); break;
+				case OpCode::Neg: for (size_t i = 0; i < n; ++i) d[i] = -a[i]; break;
+				case OpCode::Eq: for (size_t i = 0; i < n; ++i) d[i] = (a[i] == b[i]) ? 1.0 : 0.0; break;
+				case OpCode::Ne: for (size_t i = 0; i < n; ++i) d[i] = (a[i] != b[i]) ? 1.0 : 0.0; break;
+				case OpCode::Lt: for (size_t i = 0; i < n; ++i) d[i] = (a[i] < b[i]) ? 1.0 : 0.0; break;
+				case OpCode::Le: for (size_t i = 0; i < n; ++i) d[i] = (a[i] <= b[i]) ? 1.0 : 0.0; break;
+				case OpCode::Gt: for (size_t i = 0; i < n; ++i) d[i] = (a[i] > b[i]) ? 1.0 : 0.0; break;
+				case OpCode::Ge: for (size_t i = 0; i < n; ++i) d[i] = (a[i] >= b[i]) ? 1.0 : 0.0; break;
+				case OpCode::And: for (size_t i = 0; i < n; ++i) d[i] = (a[i] != 0.0 && b[i] != 0.0) ? 1.0 : 0.0; break;
+				case OpCode::Or: for (size_t i = 0; i < n; ++i) d[i] = (a[i] != 0.0 || b[i] != 0.0) ? 1.0 : 0.0; break;
+				case OpCode::Not: for (size_t i = 0; i < n; ++i) d[i] = (a[i] == 0.0) ? 1.0 : 0.0; break;
+				case OpCode::Round: for (size_t i = 0; i < n; ++i) d[i] = std::nearbyint(a[i] / b[i]) * b[i]; break;
+				case OpCode::Floor: for (size_t i = 0; i < n; ++i) d[i] = std::floor(a[i]); break;
+				case OpCode::Ceil: for (size_t i = 0; i < n; ++i) d[i] = std::ceil(a[i]); break;
+				case OpCode::Abs: for (size_t i = 0; i < n; ++i) d[i] = std::fabs(a[i]); break;
+				case OpCode::Min: for (size_t i = 0; i < n; ++i) d[i] = std::min(a[i], b[i]); break;
+				case OpCode::Max: for (size_t i = 0; i < n; ++i) d[i] = std::max(a[i], b[i]); break;
+				case OpCode::Clamp: for (size_t i = 0; i < n; ++i) d[i] = std::min(std::max(a[i], b[i]), c[i]); break;
+				}
+			}
+		}
+	};
+
+	struct Value
+	{
+		int reg = -1;
+		bool isString = false;
+	};
+
+	// 트리 -> 레지스터 명령
+	// leaf 는 열 / 그룹 키 / 집계 노드를 입력 번호로 바꿈 (-1 = 일반 노드, 쓸 수 없는 노드면 예외)
+	class ExprCompiler
+	{
+	public:
+		using Leaf = std::function<int(int node, bool& isString)>;
+		using Intern = std::function<int(const std::string&)>;
+
+		ExprCompiler(const ParsedQuery& query, Program& program, Leaf leaf, Intern intern)
+			: _query(query), _program(program), _leaf(std::move(leaf)), _intern(std::move(intern))
+		{
+		}
+
+		Value Compile(int index)
+		{
+			bool isString = false;
+			int input = _leaf(index, isString);
+			if (input >= 0)
+				return { Emit(OpCode::Input, input), isString };
+
+			const Node& node = _query.nodes[index];
+			switch (node.kind)
+			{
+			case NodeKind::Number:
+				return { Emit(OpCode::Const, -1, -1, -1, node.number), false };
+
+			case NodeKind::String:
+				return { Emit(OpCode::Const, -1, -1, -1, (double)_intern(node.text)), true };
+
+			case NodeKind::Unary:
+			{
+				int operand = RequireNumber(node, Compile(node.args[0]));
+				return { Emit(node.text == "not" ? OpCode::Not : OpCode::Neg, operand), false };
+			}
+
+			case NodeKind::Binary:
+				return CompileBinary(node);
+
+			case NodeKind::Call:
+				return CompileCall(node);
+
+			default:
+				throw QueryError{ "위치 " + std::to_string(node.begin + 1) + ": 여기서는 '" + node.text + "' 를 쓸 수 없습니다" };
+			}
+		}
+
+	private:
+		const ParsedQuery& _query;
+		Program& _program;
+		Leaf _leaf;
+		Intern _intern;
+
+		int Emit(OpCode op, int a = -1, int b = -1, int c = -1, double constant = 0.0)
+		{
+			Instruction inst;
+			inst.op = op;
+			inst.dst = _program.registerCount++;
+			inst.a = a;
+			inst.b = b;
+			inst.c = c;
+			inst.constant = constant;
+			_program.code.push_back(inst);
+			return inst.dst;
+		}
+
+		[[noreturn]] static void Fail(const Node& node, const std::string& message)
+		{
+			throw QueryError{ "위치 " + std::to_string(node.begin + 1) + ": " + message };
+		}
+
+		static int RequireNumber(const Node& node, const Value& value)
+		{
+			if (value.isString)
+				Fail(node, "문자열은 계산식에 쓸 수 없습니다");
+			return value.reg;
+		}
+
+		Value CompileBinary(const Node& node)
+		{
+			Value lhs = Compile(node.args[0]);
+			Value rhs = Compile(node.args[1]);
+
+			struct BinaryOp { const char* name; OpCode op; bool compare; };
+			static const BinaryOp ops[] = {
+				{ "+", OpCode::Add, false }, { "-", OpCode::Sub, false }, { "*", OpCode::Mul, false },
+				{ "/", OpCode::Div, false }, { "%", OpCode::Mod, false },
+				{ "and", OpCode::And, false }, { "or", OpCode::Or, false },
+				{ "==", OpCode::Eq, true }, { "!=", OpCode::Ne, true },
+				{ "<", OpCode::Lt, true }, { "<=", OpCode::Le, true }, { ">", OpCode::Gt, true }, { ">=", OpCode::Ge, true },
+			};
+
+			for (const BinaryOp& op : ops)
+			{
+				if (node.text != op.name)
+					continue;
+
+				if (!op.compare)
+					return { Emit(op.op, RequireNumber(node, lhs), RequireNumber(node, rhs)), false };
+
+				if (lhs.isString != rhs.isString)
+					Fail(node, "문자열과 숫자는 비교할 수 없습니다");
+				if (lhs.isString && op.op != OpCode::Eq && op.op != OpCode::Ne)
+					Fail(node, "문자열은 == / != 로만 비교할 수 있습니다");
+				return { Emit(op.op, lhs.reg, rhs.reg), false };
+			}
+
+			Fail(node, "알 수 없는 연산자 '" + node.text + "'");
+		}
+
+		Value CompileCall(const Node& node)
+		{
+			struct Function { const char* name; OpCode op; size_t minArgs; size_t maxArgs; };
+			static const Function functions[] = {
+				{ "round", OpCode::Round, 1, 2 },
+				{ "floor", OpCode::Floor, 1, 1 },
+				{ "ceil", OpCode::Ceil, 1, 1 },
+				{ "abs", OpCode::Abs, 1, 1 },
+				{ "min", OpCode::Min, 2, 2 },
+				{ "max", OpCode::Max, 2, 2 },
+				{ "clamp", OpCode::Clamp, 3, 3 },
+			};
+
+			for (const Function& function : functions)
+			{
+				if (node.text != function.name)
+					continue;
+
+				if (node.args.size() < function.minArgs || node.args.size() > function.maxArgs)
+					Fail(node, "'" + node.text + "' 의 인자 개수가 맞지 않습니다");
+
+				std::vector<int> args;
+				for (int arg : node.args)
+					args.push_back(RequireNumber(node, Compile(arg)));
+
+				// round(x) 는 round(x, 1)
+				if (function.op == OpCode::Round && args.size() == 1)
+					args.push_back(Emit(OpCode::Const, -1, -1, -1, 1.0));
+
+				args.resize(3, -1);
+				return { Emit(function.op, args[0], args[1], args[2]), false };
+			}
+
+			Fail(node, "알 수 없는 함수 '" + node.text + "'");
+		}
+	};
+
+	// 공백을 뺀 원문 (그룹 키 / 집계 식 비교용, 계획 단계에서 만든 노드는 이름으로)
+	std::string NodeKey(const std::string& source, const Node& node)
+	{
+		if (node.begin >= node.end)
+			return node.kind == NodeKind::Aggregate ? node.text + "()" : node.text;
+
+		std::string key;
+		for (size_t i = node.begin; i < node.end && i < source.size(); ++i)
+		{
+			if (!std::isspace((unsigned char)source[i]))
+				key += source[i];
+		}
+		return key;
+	}
+
+	// having 에서 select 의 별칭을 쓰면 별칭의 식으로 바꿈
+	int ResolveAliases(ParsedQuery& query, int index)
+	{
+		const Node& node = query.nodes[index];
+		if (node.kind == NodeKind::Column)
+		{
+			for (const SelectItem& item : query.select)
+			{
+				if (item.name == node.text && item.expr != index)
+					return item.expr;
+			}
+			return index;
+		}
+
+		for (size_t a = 0; a < query.nodes[index].args.size(); ++a)
+		{
+			int resolved = ResolveAliases(query, query.nodes[index].args[a]);
+			query.nodes[index].args[a] = resolved;
+		}
+		return index;
+	}
+
+	void CollectAggregates(const ParsedQuery& query, int index, std::vector<int>& out)
+	{
+		if (index < 0)
+			return;
+
+		const Node& node = query.nodes[index];
+		if (node.kind == NodeKind::Aggregate)
+		{
+			out.push_back(index);
+			return;
+		}
+		for (int arg : node.args)
+			CollectAggregates(query, arg, out);
+	}
+
+	// -----------------------------------------------------------------------
+	// 그룹 집계
+	// -----------------------------------------------------------------------
+
+	struct AggregateSpec
+	{
+		AggregateFunc func = AggregateFunc::Count;
+		int argReg = -1;		// -1 = count()
+		std::string key;
+	};
+
+	struct AggregateState
+	{
+		double sum = 0.0;
+		double min = std::numeric_limits<double>::infinity();
+		double max = -std::numeric_limits<double>::infinity();
+		int64_t count = 0;
+	};
+
+	struct GroupKey
+	{
+		std::array<double, MAX_GROUP_KEYS> values{};
+
+		bool operator==(const GroupKey& other) const
+		{
+			return std::memcmp(values.data(), other.values.data(), sizeof(values)) == 0;
+		}
+	};
+
+	struct GroupKeyHash
+	{
+		size_t operator()(const GroupKey& key) const
+		{
+			uint64_t hash = 1469598103934665603ull;
+			for (double value : key.values)
+			{
+				uint64_t bits;
+				std::memcpy(&bits, &value, sizeof(bits));
+				hash = (hash ^ bits) * 1099511628211ull;
+				hash ^= hash >> 29;
+			}
+			return (size_t)hash;
+		}
+	};
+
+	// NaN / -0 을 한 가지 비트 패턴으로 (memcmp 비교용)
+	double NormalizeKey(double value)
+	{
+		if (value != value)
+			return NaN;
+		return (value == 0.0) ? 0.0 : value;
+	}
+
+	struct GroupTable
+	{
+		std::unordered_map<GroupKey, int, GroupKeyHash> index;
+		std::vector<GroupKey> keys;
+		std::vector<AggregateState> states;		// [그룹 * 집계 수 + 집계]
+
+		AggregateState* Find(const GroupKey& key, size_t aggregateCount)
+		{
+			auto [it, inserted] = index.emplace(key, (int)keys.size());
+			if (inserted)
+			{
+				keys.push_back(key);
+				states.resize(states.size() + aggregateCount);
+			}
+			return states.data() + (size_t)it->second * aggregateCount;
+		}
+	};
+
+	void Accumulate(AggregateState& state, AggregateFunc func, double value)
+	{
+		if (value != value)
+			return;
+
+		++state.count;
+		if (func == AggregateFunc::Sum || func == AggregateFunc::Avg)
+			state.sum += value;
+		else if (func == AggregateFunc::Min)
+			state.min = std::min(state.min, value);
+		else if (func == AggregateFunc::Max)
+			state.max = std::max(state.max, value);
+	}
+
+	void Merge(AggregateState& into, const AggregateState& from)
+	{
+		into.sum += from.sum;
+		into.min = std::min(into.min, from.min);
+		into.max = std::max(into.max, from.max);
+		into.count += from.count;
+	}
+
+	double Finish(const AggregateState& state, AggregateFunc func)
+	{
+		switch (func)
+		{
+		case AggregateFunc::Count: return (double)state.count;
+		case AggregateFunc::Sum: return state.count > 0 ? state.sum : NaN;
+		case AggregateFunc::Avg: return state.count > 0 ? state.sum / (double)state.count : NaN;
+		case AggregateFunc::Min: return state.count > 0 ? state.min : NaN;
+		case AggregateFunc::Max: return state.count > 0 ? state.max : NaN;
+		}
+		return NaN;
+	}
+
+	AggregateFunc ToAggregateFunc(const std::string& name)
+	{
+		if (name == "sum") return AggregateFunc::Sum;
+		if (name == "min") return AggregateFunc::Min;
+		if (name == "max") return AggregateFunc::Max;
+		if (name == "avg") return AggregateFunc::Avg;
+		return AggregateFunc::Count;
+	}
+
+	std::string FormatNumber(double value)
+	{
+		if (value != value)
+			return "";
+
+		char buffer[64];
+		if (value == std::floor(value) && std::fabs(value) < 1e15)
+			snprintf(buffer, sizeof(buffer), "%lld", (long long)value);
+		else
+			snprintf(buffer, sizeof(buffer), "%.6g", value);
+		return buffer;
+	}
+}
+
+const char* QueryTableName(QueryTable table)
+{
+	switch (table)
+	{
+	case QueryTable::Operators: return "operators";
+	case QueryTable::Skills: return "skills";
+	case QueryTable::Actions: return "actions";
+	default: return "enemies";
+	}
+}
+
+std::vector<std::string> QueryColumnNames(QueryTable table)
+{
+	std::vector<std::string> names;
+	for (const ColumnDef& def : ColumnDefs(table))
+		names.push_back(def.name);
+	return names;
+}
+
+std::string QueryResult::CellText(size_t row, size_t column) const
+{
+	double value = values[column][row];
+	if (!isString[column])
+		return FormatNumber(value);
+
+	return (value == value && (size_t)value < strings.size()) ? strings[(size_t)value] : std::string();
+}
+
+std::string QueryResult::ToTsv() const
+{
+	std::string out;
+	for (size_t c = 0; c < columns.size(); ++c)
+		out += (c > 0 ? "\t" : "") + columns[c];
+	out += '\n';
+
+	for (size_t r = 0; r < rowCount; ++r)
+	{
+		for (size_t c = 0; c < columns.size(); ++c)
+			out += (c > 0 ? "\t" : "") + CellText(r, c);
+		out += '\n';
+	}
+	return out;
+}
+
+// ---------------------------------------------------------------------------
+// 열 캐시
+// ---------------------------------------------------------------------------
+
+int QueryEngine::Intern(const std::string& str)
+{
+	auto it = _stringIds.find(str);
+	if (it != _stringIds.end())
+		return it->second;
+
+	int id = (int)_strings.size();
+	_strings.push_back(str);
+	_stringIds.emplace(str, id);
+	return id;
+}
+
+void QueryEngine::Invalidate()
+{
+	for (TableView& view : _views)
+		view = TableView();
+
+	_strings.clear();
+	_stringIds.clear();
+}
+
+void QueryEngine::PrepareView(QueryTable table, const QueryInput& input)
+{
+	TableView& view = _views[(int)table];
+
+	if (table == QueryTable::Actions)
+	{
+		std::vector<uint64_t> revisions;
+		revisions.reserve(input.levels.size());
+		for (const QueryLevel& level : input.levels)
+			revisions.push_back(level.revision);
+
+		if (!view.built || view.levelRevisions != revisions)
+		{
+			view = TableView();
+			view.levelRevisions = std::move(revisions);
+
+			// 레벨마다 병렬로 펼친 뒤 레벨 순서대로 이어 붙임
+			std::vector<std::vector<QueryActionRow>> perLevel(input.levels.size());
+			ParallelFor(input.levels.size(), 4, [&](size_t begin, size_t end, unsigned)
+				{
+					for (size_t l = begin; l < end; ++l)
+					{
+						const json* waves = Member(input.levels[l].data, "waves");
+						if (!waves || !waves->is_array())
+							continue;
+
+						for (int w = 0; w < (int)waves->size(); ++w)
+						{
+							const json* fragments = Member(&(*waves)[w], "fragments");
+							if (!fragments || !fragments->is_array())
+								continue;
+
+							for (int f = 0; f < (int)fragments->size(); ++f)
+							{
+								const json* fragment = &(*fragments)[f];
+								const json* actions = Member(fragment, "actions");
+								if (!actions || !actions->is_array())
+									continue;
+
+								for (int a = 0; a < (int)actions->size(); ++a)
+									perLevel[l].push_back({ (int)l, w, f, a, fragment, &(*actions)[a] });
+							}
+						}
+					}
+				});
+
+			size_t total = 0;
+			for (const auto& rows : perLevel)
+				total += rows.size();
+
+			view.actions.reserve(total);
+			for (auto& rows : perLevel)
+				view.actions.insert(view.actions.end(), rows.begin(), rows.end());
+
+			view.rowCount = view.actions.size();
+			view.built = true;
+		}
+		return;
+	}
+
+	const void* source = nullptr;
+	uint64_t revision = 0;
+	size_t rowCount = 0;
+	switch (table)
+	{
+	case QueryTable::Operators:
+		source = input.operators;
+		revision = input.operatorRevision;
+		rowCount = (input.operators && input.operators->is_array()) ? input.operators->size() : 0;
+		break;
+	case QueryTable::Skills:
+		source = input.skills;
+		revision = input.skillRevision;
+		rowCount = input.skills ? input.skills->size() : 0;
+		break;
+	default:
+		source = input.enemies;
+		revision = input.enemyRevision;
+		rowCount = (input.enemies && input.enemies->is_array()) ? input.enemies->size() : 0;
+		break;
+	}
+
+	if (!view.built || view.source != source || view.revision != revision || view.rowCount != rowCount)
+	{
+		view = TableView();
+		view.source = source;
+		view.revision = revision;
+		view.rowCount = rowCount;
+		view.built = true;
+	}
+}
+
+const QueryEngine::Column& QueryEngine::GetColumn(QueryTable table, const QueryInput& input, const std::string& name, QueryResult& result)
+{
+	TableView& view = _views[(int)table];
+	const ColumnDef* def = FindColumnDef(table, name);
+
+	// 적 스탯 조인은 행동 열과 별개로 적 revision 이 바뀌면 다시 뽑음
+	if (table == QueryTable::Actions && def->enemy)
+	{
+		if (!view.joinBuilt || view.joinRevision != input.enemyRevision)
+		{
+			for (auto it = view.columns.begin(); it != view.columns.end();)
+			{
+				if (it->first.rfind("enemy.", 0) == 0)
+					it = view.columns.erase(it);
+				else
+					++it;
+			}
+
+			std::unordered_map<std::string, int> enemyIndex;
+			if (input.enemies && input.enemies->is_array())
+			{
+				enemyIndex.reserve(input.enemies->size());
+				for (int e = 0; e < (int)input.enemies->size(); ++e)
+				{
+					const json* key = Member(&(*input.enemies)[e], "key");
+					if (key && key->is_string())
+						enemyIndex.emplace(key->get<std::string>(), e);
+				}
+			}
+
+			view.enemyRows.assign(view.rowCount, -1);
+			for (size_t i = 0; i < view.rowCount; ++i)
+			{
+				const json* key = Member(view.actions[i].node, "key");
+				if (!key || !key->is_string())
+					continue;
+
+				auto it = enemyIndex.find(key->get_ref<const std::string&>());
+				if (it != enemyIndex.end())
+					view.enemyRows[i] = it->second;
+			}
+
+			view.joinRevision = input.enemyRevision;
+			view.joinBuilt = true;
+		}
+	}
+
+	auto cached = view.columns.find(name);
+	if (cached != view.columns.end())
+	{
+		++result.columnsCached;
+		return cached->second;
+	}
+
+	// 오퍼레이터 스탯 열은 첫 열을 뽑을 때 전체를 한 번에 평가 (revision 이 바뀌면 view 와 함께 버림)
+	if (table == QueryTable::Operators && !view.attributesBuilt)
+	{
+		AttributeCurveTable curves;
+		curves.Build(ParseOperatorCurves(input.operators ? *input.operators : json::array()));
+		curves.Evaluate(LAST_PHASE, MAX_LEVEL, view.attributes);
+		view.attributesBuilt = true;
+	}
+
+	RowSource src;
+	src.records = (table == QueryTable::Operators) ? input.operators : input.enemies;
+	src.attributes = &view.attributes;
+	src.skills = input.skills;
+	src.actions = &view.actions;
+	src.levels = &input.levels;
+	src.enemyRows = &view.enemyRows;
+
+	auto read = [&](size_t i) -> Cell
+		{
+			if (!def->enemy)
+				return def->read(src, i);
+
+			if (table == QueryTable::Enemies)
+				return def->enemy((*input.enemies)[i]);
+
+			int enemy = view.enemyRows[i];
+			return (enemy >= 0) ? def->enemy((*input.enemies)[enemy]) : Cell();
+		};
+
+	Column column;
+	column.isString = def->isString;
+	column.values.assign(view.rowCount, NaN);
+
+	if (def->isString)
+	{
+		// 경로 탐색은 병렬, id 부여는 풀을 공유하므로 순차 (같은 문자열이 이어지면 해시 생략)
+		std::vector<const std::string*> texts(view.rowCount, nullptr);
+		ParallelFor(view.rowCount, 2048, [&](size_t begin, size_t end, unsigned)
+			{
+				for (size_t i = begin; i < end; ++i)
+					texts[i] = read(i).text;
+			});
+
+		const std::string* last = nullptr;
+		int lastId = -1;
+		for (size_t i = 0; i < view.rowCount; ++i)
+		{
+			if (!texts[i])
+				continue;
+
+			if (!last || *texts[i] != *last)
+			{
+				last = texts[i];
+				lastId = Intern(*last);
+			}
+			column.values[i] = (double)lastId;
+		}
+	}
+	else
+	{
+		ParallelFor(view.rowCount, 2048, [&](size_t begin, size_t end, unsigned)
+			{
+				for (size_t i = begin; i < end; ++i)
+					column.values[i] = read(i).number;
+			});
+	}
+
+	++result.columnsExtracted;
+	return view.columns.emplace(name, std::move(column)).first->second;
+}
+
+// ---------------------------------------------------------------------------
+// 계획 + 실행
+// ---------------------------------------------------------------------------
+
+QueryResult QueryEngine::Run(const QueryInput& input, const std::string& source)
+{
+	auto start = Clock::now();
+	QueryResult result;
+
+	if (_strings.size() > MAX_POOL_STRINGS)
+		Invalidate();
+
+	ParsedQuery query;
+	Program rowProgram;
+	Program groupProgram;
+	std::vector<std::string> inputNames;		// 행 프로그램 입력 열
+	std::vector<int> selectRegs;
+	std::vector<uint8_t> selectIsString;
+	int filterReg = -1;
+	int havingReg = -1;
+	bool grouped = false;
+
+	std::vector<int> keyRegs;
+	std::vector<uint8_t> keyIsString;
+	std::vector<std::string> keyTexts;
+	std::vector<AggregateSpec> aggregates;
+
+	auto intern = [this](const std::string& str) { return Intern(str); };
+
+	try
+	{
+		QueryParser(source, query).Parse();
+
+		// select * / 생략 시 표의 모든 열
+		if (query.selectAll || (query.select.empty() && query.groupBy.empty()))
+		{
+			std::vector<int> aggregateNodes;
+			CollectAggregates(query, query.having, aggregateNodes);
+			if (!aggregateNodes.empty())
+				throw QueryError{ "select * 와 집계는 함께 쓸 수 없습니다" };
+
+			query.select.clear();
+			for (const ColumnDef& def : ColumnDefs(query.table))
+			{
+				Node node;
+				node.kind = NodeKind::Column;
+				node.text = def.name;
+				query.nodes.push_back(node);
+				query.select.push_back({ (int)query.nodes.size() - 1, def.name });
+			}
+		}
+
+		if (query.having >= 0)
+			query.having = ResolveAliases(query, query.having);
+
+		std::vector<int> aggregateNodes;
+		for (const SelectItem& item : query.select)
+			CollectAggregates(query, item.expr, aggregateNodes);
+		CollectAggregates(query, query.having, aggregateNodes);
+
+		for (int key : query.groupBy)
+		{
+			std::vector<int> nested;
+			CollectAggregates(query, key, nested);
+			if (!nested.empty())
+				throw QueryError{ "group by 에는 집계 함수를 쓸 수 없습니다" };
+		}
+
+		grouped = !query.groupBy.empty() || !aggregateNodes.empty();
+		if (query.having >= 0 && !grouped)
+			throw QueryError{ "having 은 group by 또는 집계와 함께 써야 합니다" };
+
+		// 그룹만 있고 select 가 없으면 키 + count()
+		if (grouped && query.select.empty())
+		{
+			for (int key : query.groupBy)
+			{
+				const Node& node = query.nodes[key];
+				query.select.push_back({ key, source.substr(node.begin, node.end - node.begin) });
+			}
+
+			Node count;
+			count.kind = NodeKind::Aggregate;
+			count.text = "count";
+			query.nodes.push_back(count);
+			query.select.push_back({ (int)query.nodes.size() - 1, "count" });
+			aggregateNodes.push_back((int)query.nodes.size() - 1);
+		}
+
+		// 1) 행 프로그램 : 필터, 그룹 키, 집계 인자 (그룹 없으면 select 식)
+		std::unordered_map<std::string, int> inputSlots;
+		ExprCompiler rowCompiler(query, rowProgram, [&](int index, bool& isString) -> int
+			{
+				const Node& node = query.nodes[index];
+				if (node.kind == NodeKind::Aggregate)
+					throw QueryError{ "위치 " + std::to_string(node.begin + 1) + ": 집계 함수는 select / having 에서만 쓸 수 있습니다" };
+				if (node.kind != NodeKind::Column)
+					return -1;
+
+				const ColumnDef* def = FindColumnDef(query.table, node.text);
+				if (!def)
+					throw QueryError{ "위치 " + std::to_string(node.begin + 1) + ": " + QueryTableName(query.table) + " 에 '" + node.text + "' 열이 없습니다" };
+
+				isString = def->isString;
+				auto it = inputSlots.find(node.text);
+				if (it != inputSlots.end())
+					return it->second;
+
+				int slot = (int)inputNames.size();
+				inputNames.push_back(node.text);
+				inputSlots.emplace(node.text, slot);
+				return slot;
+			}, intern);
+
+		if (query.where >= 0)
+		{
+			Value filter = rowCompiler.Compile(query.where);
+			if (filter.isString)
+				throw QueryError{ "where 조건은 숫자/비교식이어야 합니다" };
+			filterReg = filter.reg;
+		}
+
+		if (!grouped)
+		{
+			for (const SelectItem& item : query.select)
+			{
+				Value value = rowCompiler.Compile(item.expr);
+				selectRegs.push_back(value.reg);
+				selectIsString.push_back(value.isString);
+			}
+		}
+		else
+		{
+			for (int key : query.groupBy)
+			{
+				Value value = rowCompiler.Compile(key);
+				keyRegs.push_back(value.reg);
+				keyIsString.push_back(value.isString);
+				keyTexts.push_back(NodeKey(source, query.nodes[key]));
+			}
+
+			for (int index : aggregateNodes)
+			{
+				const Node& node = query.nodes[index];
+				std::string key = NodeKey(source, node);
+				if (std::any_of(aggregates.begin(), aggregates.end(), [&](const AggregateSpec& a) { return a.key == key; }))
+					continue;
+
+				AggregateSpec spec;
+				spec.func = ToAggregateFunc(node.text);
+				spec.key = key;
+				if (!node.args.empty())
+				{
+					Value arg = rowCompiler.Compile(node.args[0]);
+					if (arg.isString && spec.func != AggregateFunc::Count)
+						throw QueryError{ "위치 " + std::to_string(node.begin + 1) + ": 문자열 열은 " + node.text + " 할 수 없습니다" };
+					spec.argReg = arg.reg;
+				}
+				aggregates.push_back(spec);
+			}
+
+			// 2) 그룹 프로그램 : 입력은 [그룹 키..., 집계 결과...]
+			ExprCompiler groupCompiler(query, groupProgram, [&](int index, bool& isString) -> int
+				{
+					const Node& node = query.nodes[index];
+					if (node.kind == NodeKind::Number || node.kind == NodeKind::String)
+						return -1;
+
+					std::string key = NodeKey(source, node);
+					if (node.kind == NodeKind::Aggregate)
+					{
+						for (size_t a = 0; a < aggregates.size(); ++a)
+						{
+							if (aggregates[a].key == key)
+								return (int)(keyRegs.size() + a);
+						}
+					}
+
+					for (size_t k = 0; k < keyTexts.size(); ++k)
+					{
+						if (keyTexts[k] == key)
+						{
+							isString = keyIsString[k];
+							return (int)k;
+						}
+					}
+
+					if (node.kind == NodeKind::Column)
+						throw QueryError{ "위치 " + std::to_string(node.begin + 1) + ": '" + node.text + "' 는 group by 에 없으므로 집계 함수로 감싸야 합니다" };
+					return -1;
+				}, intern);
+
+			for (const SelectItem& item : query.select)
+			{
+				Value value = groupCompiler.Compile(item.expr);
+				selectRegs.push_back(value.reg);
+				selectIsString.push_back(value.isString);
+			}
+
+			if (query.having >= 0)
+			{
+				Value having = groupCompiler.Compile(query.having);
+				if (having.isString)
+					throw QueryError{ "having 조건은 숫자/비교식이어야 합니다" };
+				havingReg = having.reg;
+			}
+		}
+
+		for (const OrderItem& order : query.orderBy)
+		{
+			if (std::none_of(query.select.begin(), query.select.end(), [&](const SelectItem& item) { return item.name == order.name; }))
+				throw QueryError{ "위치 " + std::to_string(order.pos + 1) + ": order by '" + order.name + "' 가 select 결과 열에 없습니다" };
+		}
+	}
+	catch (const QueryError& e)
+	{
+		result.error = e.message;
+		return result;
+	}
+
+	auto planned = Clock::now();
+	result.parseMs = ElapsedMs(start, planned);
+
+	// 3) 쓰인 열만 뽑기 (캐시에 있으면 그대로)
+	PrepareView(query.table, input);
+	const size_t rowCount = _views[(int)query.table].rowCount;
+	result.scannedRows = rowCount;
+
+	std::vector<const double*> inputs;
+	for (const std::string& name : inputNames)
+		inputs.push_back(GetColumn(query.table, input, name, result).values.data());
+
+	auto extracted = Clock::now();
+	result.extractMs = ElapsedMs(planned, extracted);
+
+	// 4) 블록 단위 스캔
+	const size_t itemCount = query.select.size();
+	const size_t blockCount = (rowCount + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	const size_t aggregateCount = aggregates.size();
+
+	std::vector<size_t> blockMatched(blockCount, 0);
+	std::vector<std::vector<std::vector<double>>> blockRows;		// [블록][열][행] (그룹 없을 때)
+	std::vector<GroupTable> workerGroups;
+	if (grouped)
+		workerGroups.resize(GetWorkerCount());
+	else
+		blockRows.resize(blockCount);
+
+	ParallelFor(rowCount, BLOCK_SIZE, [&](size_t begin, size_t end, unsigned worker)
+		{
+			const size_t n = end - begin;
+			const size_t block = begin / BLOCK_SIZE;
+			std::vector<double> registers((size_t)std::max(1, rowProgram.registerCount) * BLOCK_SIZE);
+			auto R = [&](int reg) { return registers.data() + (size_t)reg * BLOCK_SIZE; };
+
+			rowProgram.Run(inputs, begin, n, registers.data());
+
+			// NaN (없는 필드) 비교는 항상 거짓이므로 조건도 거짓
+			std::vector<uint32_t> selected;
+			selected.reserve(n);
+			if (filterReg >= 0)
+			{
+				const double* filter = R(filterReg);
+				for (size_t i = 0; i < n; ++i)
+				{
+					if (filter[i] != 0.0 && filter[i] == filter[i])
+						selected.push_back((uint32_t)i);
+				}
+			}
+			else
+			{
+				for (size_t i = 0; i < n; ++i)
+					selected.push_back((uint32_t)i);
+			}
+			blockMatched[block] = selected.size();
+
+			if (!grouped)
+			{
+				auto& out = blockRows[block];
+				out.resize(itemCount);
+				for (size_t c = 0; c < itemCount; ++c)
+				{
+					const double* value = R(selectRegs[c]);
+					out[c].reserve(selected.size());
+					for (uint32_t i : selected)
+						out[c].push_back(value[i]);
+				}
+				return;
+			}
+
+			GroupTable& groups = workerGroups[worker];
+			GroupKey key;
+			for (uint32_t i : selected)
+			{
+				for (size_t k = 0; k < keyRegs.size(); ++k)
+					key.values[k] = NormalizeKey(R(keyRegs[k])[i]);
+
+				AggregateState* states = groups.Find(key, aggregateCount);
+				for (size_t a = 0; a < aggregateCount; ++a)
+				{
+					const AggregateSpec& spec = aggregates[a];
+					Accumulate(states[a], spec.func, spec.argReg >= 0 ? R(spec.argReg)[i] : 1.0);
+				}
+			}
+		});
+
+	for (size_t matched : blockMatched)
+		result.matchedRows += matched;
+
+	auto scanned = Clock::now();
+	result.scanMs = ElapsedMs(extracted, scanned);
+
+	// 5) 결과 열 구성
+	std::vector<std::vector<double>> columns(itemCount);
+
+	if (!grouped)
+	{
+		for (size_t c = 0; c < itemCount; ++c)
+		{
+			columns[c].reserve(result.matchedRows);
+			for (const auto& block : blockRows)
+				columns[c].insert(columns[c].end(), block[c].begin(), block[c].end());
+		}
+	}
+	else
+	{
+		GroupTable merged;
+		for (const GroupTable& groups : workerGroups)
+		{
+			for (size_t g = 0; g < groups.keys.size(); ++g)
+			{
+				AggregateState* states = merged.Find(groups.keys[g], aggregateCount);
+				for (size_t a = 0; a < aggregateCount; ++a)
+					Merge(states[a], groups.states[g * aggregateCount + a]);
+			}
+		}
+
+		// 집계만 있고 그룹 키가 없으면 매칭된 행이 없어도 한 행
+		if (query.groupBy.empty() && merged.keys.empty())
+			merged.Find(GroupKey(), aggregateCount);
+
+		// 작업 스레드 분배와 무관하게 키 순서로
+		const size_t groupCount = merged.keys.size();
+		std::vector<int> order(groupCount);
+		for (size_t g = 0; g < groupCount; ++g)
+			order[g] = (int)g;
+
+		std::sort(order.begin(), order.end(), [&](int a, int b)
+			{
+				for (size_t k = 0; k < keyRegs.size(); ++k)
+				{
+					double x = merged.keys[a].values[k];
+					double y = merged.keys[b].values[k];
+					if (x == y || (x != x && y != y))
+						continue;
+					if (x != x || y != y)
+						return y != y;
+					if (keyIsString[k])
+						return _strings[(size_t)x] < _strings[(size_t)y];
+					return x < y;
+				}
+				return false;
+			});
+
+		// [그룹 키..., 집계 결과...] 열
+		std::vector<std::vector<double>> groupInputs(keyRegs.size() + aggregateCount, std::vector<double>(groupCount));
+		for (size_t g = 0; g < groupCount; ++g)
+		{
+			int index = order[g];
+			for (size_t k = 0; k < keyRegs.size(); ++k)
+				groupInputs[k][g] = merged.keys[index].values[k];
+			for (size_t a = 0; a < aggregateCount; ++a)
+				groupInputs[keyRegs.size() + a][g] = Finish(merged.states[(size_t)index * aggregateCount + a], aggregates[a].func);
+		}
+
+		std::vector<const double*> groupInputPtrs;
+		for (const auto& column : groupInputs)
+			groupInputPtrs.push_back(column.data());
+
+		std::vector<double> registers((size_t)std::max(1, groupProgram.registerCount) * BLOCK_SIZE);
+		for (size_t begin = 0; begin < groupCount; begin += BLOCK_SIZE)
+		{
+			size_t n = std::min(BLOCK_SIZE, groupCount - begin);
+			groupProgram.Run(groupInputPtrs, begin, n, registers.data());
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				if (havingReg >= 0)
+				{
+					double pass = registers[(size_t)havingReg * BLOCK_SIZE + i];
+					if (pass == 0.0 || pass != pass)
+						continue;
+				}
+
+				for (size_t c = 0; c < itemCount; ++c)
+					columns[c].push_back(registers[(size_t)selectRegs[c] * BLOCK_SIZE + i]);
+			}
+		}
+
+		result.groupCount = groupCount;
+	}
+
+	size_t outputRows = columns.empty() ? 0 : columns[0].size();
+
+	// 6) order by / limit
+	std::vector<size_t> permutation(outputRows);
+	for (size_t r = 0; r < outputRows; ++r)
+		permutation[r] = r;
+
+	if (!query.orderBy.empty())
+	{
+		std::vector<std::pair<size_t, bool>> sortColumns;
+		for (const OrderItem& order : query.orderBy)
+		{
+			for (size_t c = 0; c < itemCount; ++c)
+			{
+				if (query.select[c].name == order.name)
+				{
+					sortColumns.push_back({ c, order.descending });
+					break;
+				}
+			}
+		}
+
+		// 없는 값 (NaN) 은 방향과 상관없이 맨 뒤
+		std::stable_sort(permutation.begin(), permutation.end(), [&](size_t a, size_t b)
+			{
+				for (const auto& [c, descending] : sortColumns)
+				{
+					double x = columns[c][a];
+					double y = columns[c][b];
+					if (x == y || (x != x && y != y))
+						continue;
+					if (x != x || y != y)
+						return y != y;
+
+					bool less = selectIsString[c] ? _strings[(size_t)x] < _strings[(size_t)y] : x < y;
+					bool greater = selectIsString[c] ? _strings[(size_t)y] < _strings[(size_t)x] : y < x;
+					if (!less && !greater)
+						continue;
+					return descending ? greater : less;
+				}
+				return false;
+			});
+	}
+
+	if (query.limit >= 0 && (size_t)query.limit < permutation.size())
+		permutation.resize((size_t)query.limit);
+
+	// 7) 결과에 쓰인 문자열만 따로 모음
+	std::unordered_map<int, int> stringRemap;
+	result.columns.resize(itemCount);
+	result.isString = selectIsString;
+	result.values.assign(itemCount, std::vector<double>(permutation.size()));
+
+	for (size_t c = 0; c < itemCount; ++c)
+	{
+		result.columns[c] = query.select[c].name;
+		for (size_t r = 0; r < permutation.size(); ++r)
+		{
+			double value = columns[c][permutation[r]];
+			if (selectIsString[c] && value == value)
+			{
+				auto [it, inserted] = stringRemap.emplace((int)value, (int)result.strings.size());
+				if (inserted)
+					result.strings.push_back(_strings[(size_t)value]);
+				value = it->second;
+			}
+			result.values[c][r] = value;
+		}
+	}
+	result.rowCount = permutation.size();
+
+	// 실행 계획 요약
+	std::string plan = "scan " + std::string(QueryTableName(query.table)) + " (" + std::to_string(rowCount) + " rows, " +
+		std::to_string(inputNames.size()) + " columns: " + std::to_string(result.columnsCached) + " cached, " +
+		std::to_string(result.columnsExtracted) + " extracted)";
+	if (filterReg >= 0)
+		plan += " -> filter";
+	if (grouped)
+		plan += " -> hash group (" + std::to_string(keyRegs.size()) + " keys, " + std::to_string(aggregateCount) + " aggregates, " +
+			std::to_string(workerGroups.size()) + " workers)";
+	if (havingReg >= 0)
+		plan += " -> having";
+	if (!query.orderBy.empty())
+		plan += " -> sort";
+	if (query.limit >= 0)
+		plan += " -> limit " + std::to_string(query.limit);
+	plan += " / " + std::to_string(rowProgram.code.size() + groupProgram.code.size()) + " instructions";
+	result.plan = plan;
+
+	auto finished = Clock::now();
+	result.finishMs = ElapsedMs(scanned, finished);
+	result.totalMs = ElapsedMs(start, finished);
+	result.ok = true;
+	return result;
+}
+
+// ---------------------------------------------------------------------------
+// 명령줄용 로드
+// ---------------------------------------------------------------------------
+
+bool QueryProject::Load(const std::string& solutionPath, std::string& error)
+{
+	this->solutionPath = solutionPath;
+
+	// 테이블 세 개 + 레벨 파일을 모두 병렬로 (편집기 로드와 같은 ReadDataFile)
+	std::string levelPath = DataFilePath(solutionPath, Migration::DataType::Level);
+	std::vector<std::string> fileNames = ListLevelFiles(levelPath);
+
+	json skillTable;
+	const Migration::DataType tableTypes[3] = { Migration::DataType::Enemy, Migration::DataType::Operator, Migration::DataType::Skill };
+	json* tables[3] = { &enemyTable, &operatorTable, &skillTable };
+
+	levels.assign(fileNames.size(), Level());
+	std::vector<DataFileStatus> statuses(3 + fileNames.size());
+	std::vector<std::string> errors(statuses.size());
+	ParallelFor(statuses.size(), 1, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				if (i < 3)
+				{
+					statuses[i] = ReadDataFile(tableTypes[i], DataFilePath(solutionPath, tableTypes[i]), *tables[i], errors[i]);
+					continue;
+				}
+
+				Level& level = levels[i - 3];
+				level.fileName = fileNames[i - 3];
+				level.levelId = LevelIdFromFileName(level.fileName);
+				statuses[i] = ReadDataFile(Migration::DataType::Level, levelPath + level.fileName, level.data, errors[i]);
+				level.migrated = statuses[i] == DataFileStatus::Migrated;
+			}
+		});
+
+	for (size_t i = 0; i < statuses.size(); ++i)
+	{
+		if (statuses[i] == DataFileStatus::Missing || statuses[i] == DataFileStatus::ParseError)
+		{
+			std::string fileName = i < 3 ? fs::path(DataFilePath(solutionPath, tableTypes[i])).filename().string() : fileNames[i - 3];
+			error = (i < 3 ? "테이블을 읽을 수 없습니다: " : "레벨을 읽을 수 없습니다: ") + fileName + " (" + errors[i] + ")";
+			return false;
+		}
+	}
+
+	enemyMigrated = statuses[0] == DataFileStatus::Migrated;
+	operatorMigrated = statuses[1] == DataFileStatus::Migrated;
+	skillMigrated = statuses[2] == DataFileStatus::Migrated;
+
+	try
+	{
+		skills.clear();
+		if (skillTable.contains("skills"))
+			skills = skillTable["skills"].get<std::vector<Skill>>();
+	}
+	catch (const json::exception& e)
+	{
+		error = std::string("skills_table.json 형식 오류: ") + e.what();
+		return false;
+	}
+
+	return true;
+}
+
+QueryInput QueryProject::MakeInput() const
+{
+	QueryInput input;
+
+	auto enemies = enemyTable.find("enemies");
+	input.enemies = (enemies != enemyTable.end()) ? &*enemies : nullptr;
+	input.enemyRevision = 1;
+
+	auto operators = operatorTable.find("operators");
+	input.operators = (operators != operatorTable.end()) ? &*operators : nullptr;
+	input.operatorRevision = 1;
+
+	input.skills = &skills;
+	input.skillRevision = 1;
+
+	input.levels.resize(levels.size());
+	for (size_t i = 0; i < levels.size(); ++i)
+	{
+		input.levels[i].levelId = levels[i].levelId;
+		input.levels[i].data = &levels[i].data;
+		input.levels[i].revision = i + 1;
+	}
+	return input;
+}
@@ -0,0 +1,168 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+
+#include "AttributeCurve.h"
+#include "Skill.h"
+
+using json = nlohmann::ordered_json;
+
+// 질의 대상 표
+// Enemies   : enemies[] (value[0] 기본 스탯)
+// Operators : operators[] (스탯은 마지막 정예화의 최대 레벨, AttributeCurveTable 로 한 번에 평가)
+// Skills    : skills[]
+// Actions   : 모든 레벨의 waves[].fragments[].actions[] 를 한 행씩 펼친 것 (enemy.<필드> 로 적 스탯 조인)
+enum class QueryTable
+{
+	Enemies = 0,
+	Operators,
+	Skills,
+	Actions,
+	MAX
+};
+
+const char* QueryTableName(QueryTable table);
+std::vector<std::string> QueryColumnNames(QueryTable table);	// 도움말 표시용
+
+// 레벨 하나 (revision 이 같으면 이전에 펼친 행동 열을 그대로 씀)
+struct QueryLevel
+{
+	std::string levelId;
+	const json* data = nullptr;
+	uint64_t revision = 0;
+};
+
+// 질의 대상 데이터 (각 편집기의 데이터와 revision)
+struct QueryInput
+{
+	const json* enemies = nullptr;			// enemies[]
+	uint64_t enemyRevision = 0;
+	const json* operators = nullptr;		// operators[]
+	uint64_t operatorRevision = 0;
+	const std::vector<Skill>* skills = nullptr;
+	uint64_t skillRevision = 0;
+	std::vector<QueryLevel> levels;
+};
+
+// 행동 표의 한 행
+struct QueryActionRow
+{
+	int level = -1;
+	int wave = -1;
+	int fragment = -1;
+	int action = -1;
+	const json* fragmentNode = nullptr;
+	const json* node = nullptr;
+};
+
+struct QueryResult
+{
+	bool ok = false;
+	std::string error;
+
+	// 열 단위 결과 (문자열 열의 값은 strings 인덱스, 없는 값은 NaN)
+	std::vector<std::string> columns;
+	std::vector<uint8_t> isString;
+	std::vector<std::vector<double>> values;
+	std::vector<std::string> strings;
+	size_t rowCount = 0;
+
+	std::string plan;			// 실행 계획 요약
+	size_t scannedRows = 0;
+	size_t matchedRows = 0;		// where 를 통과한 행
+	size_t groupCount = 0;
+	int columnsExtracted = 0;	// 캐시에 없어 새로 뽑은 열
+	int columnsCached = 0;
+
+	double parseMs = 0.0;		// 파싱 + 계획
+	double extractMs = 0.0;		// JSON -> 열 (캐시 없을 때만)
+	double scanMs = 0.0;		// 필터 / 그룹 집계
+	double finishMs = 0.0;		// 그룹 병합 / having / 정렬
+	double totalMs = 0.0;
+
+	std::string CellText(size_t row, size_t column) const;
+	std::string ToTsv() const;
+};
+
+// 질의 예시
+//   from actions where enemy.type == "FLYING" and routeIndex == 0
+//     group by levelId, wave, fragment select levelId, wave, fragment, sum(count) as flying
+//     having flying > 30 order by flying desc limit 50
+//   from operators where cost <= 10 and atk > 500 select charId, name, cost, atk
+//
+// 절은 from / where / group by / select / having / order by / limit (순서 무관, 각각 한 번)
+// 집계는 count() count(x) sum min max avg, 나머지 식 문법은 일괄 편집과 같음
+//
+// 표마다 쓰인 열만 JSON 에서 double 배열로 뽑아 캐시하고 (revision 이 바뀔 때까지 재사용),
+// 필터/식은 레지스터 명령으로 컴파일해 블록 단위로 열 전체를 한 번에 계산
+// 그룹 집계는 작업 스레드마다 따로 해시 집계한 뒤 한 스레드에서 병합
+class QueryEngine
+{
+public:
+	QueryResult Run(const QueryInput& input, const std::string& query);
+	void Invalidate();		// 캐시한 열을 모두 버림
+
+private:
+	struct Column
+	{
+		std::vector<double> values;
+		bool isString = false;
+	};
+
+	struct TableView
+	{
+		bool built = false;
+		const void* source = nullptr;
+		uint64_t revision = 0;
+		std::vector<uint64_t> levelRevisions;	// Actions
+		uint64_t joinRevision = 0;				// Actions 의 enemy.* 열을 뽑을 때 적 revision
+		bool joinBuilt = false;
+
+		size_t rowCount = 0;
+		std::vector<QueryActionRow> actions;
+		std::vector<int> enemyRows;				// 행동 -> enemies[] 인덱스 (-1 = 없음)
+		AttributeBatchResult attributes;		// Operators 스탯 열 (처음 필요할 때 평가)
+		bool attributesBuilt = false;
+		std::unordered_map<std::string, Column> columns;
+	};
+
+	TableView _views[(int)QueryTable::MAX];
+
+	// 문자열 <-> id (열에는 id 를 double 로 저장, 쌓이기만 하므로 너무 커지면 캐시와 함께 비움)
+	std::vector<std::string> _strings;
+	std::unordered_map<std::string, int> _stringIds;
+
+	int Intern(const std::string& str);
+	void PrepareView(QueryTable table, const QueryInput& input);
+	const Column& GetColumn(QueryTable table, const QueryInput& input, const std::string& name, QueryResult& result);
+};
+
+// 편집기 없이 솔루션 폴더에서 바로 읽은 데이터 (명령줄 도구용)
+// 편집기와 같은 ReadDataFile 로 읽으므로 범위 참조는 펼쳐지고 옛 버전 파일은 메모리에서 마이그레이션됨 (저장은 하지 않음)
+struct QueryProject
+{
+	struct Level
+	{
+		std::string levelId;
+		std::string fileName;
+		json data;
+		bool migrated = false;
+	};
+
+	std::string solutionPath;
+	json enemyTable;
+	json operatorTable;
+	std::vector<Skill> skills;
+	std::vector<Level> levels;
+
+	// 읽으면서 마이그레이션한 테이블 (편집기라면 로드 직후 저장했을 파일)
+	bool enemyMigrated = false;
+	bool operatorMigrated = false;
+	bool skillMigrated = false;
+
+	bool Load(const std::string& solutionPath, std::string& error);
+	QueryInput MakeInput() const;
+};
@@ -0,0 +1,171 @@
+﻿#include "QueryWindow.h"
+#include "EnemyEditor.h"
+#include "OperatorEditor.h"
+#include "SkillEditor.h"
+#include "LevelEditor.h"
+#include <imgui/imgui.h>
+
+#include "Utility.h"
+
+namespace
+{
+	struct QueryExample
+	{
+		const char* label;
+		const char* source;
+	};
+
+	const QueryExample EXAMPLES[] = {
+		{ "fragment 별 비행 적 (경로 0)",
+			"from actions where enemy.type == \"FLYING\" and routeIndex == 0\n"
+			"group by levelId, wave, fragment\n"
+			"select levelId, wave, fragment, sum(count) as flying\n"
+			"having flying > 30 order by flying desc limit 50" },
+		{ "저코스트 고공격 오퍼레이터",
+			"from operators where cost <= 10 and atk > 500\n"
+			"select charId, name, profession, cost, atk order by atk desc" },
+		{ "레벨별 스폰 수 / 평균 체력",
+			"from actions group by levelId\n"
+			"select levelId, sum(count) as spawns, avg(enemy.maxHp) as avgHp order by spawns desc" },
+		{ "쓰이지 않는 적 찾기용 사용 횟수",
+			"from actions group by key select key, count() as uses, sum(count) as spawns order by uses" },
+		{ "SP 소모가 큰 스킬",
+			"from skills where spCost >= 40 select skillId, operatorId, spType, spCost, duration order by spCost desc" },
+	};
+}
+
+QueryInput QueryWindow::BuildInput(EnemyEditor& enemyEditor, OperatorEditor& operatorEditor, SkillEditor& skillEditor, LevelEditor& levelEditor) const
+{
+	QueryInput input;
+
+	const json& enemyData = enemyEditor.GetEnemyData();
+	auto enemies = enemyData.find("enemies");
+	input.enemies = (enemies != enemyData.end()) ? &*enemies : nullptr;
+	input.enemyRevision = enemyEditor.GetRevision();
+
+	const json& operatorData = operatorEditor.GetOperatorData();
+	auto operators = operatorData.find("operators");
+	input.operators = (operators != operatorData.end()) ? &*operators : nullptr;
+	input.operatorRevision = operatorEditor.GetRevision();
+
+	input.skills = &skillEditor.GetSkills();
+	input.skillRevision = skillEditor.GetRevision();
+
+	input.levels.resize(levelEditor.GetLevelCount());
+	for (int i = 0; i < levelEditor.GetLevelCount(); ++i)
+	{
+		input.levels[i].levelId = levelEditor.GetLevelId(i);
+		input.levels[i].data = &levelEditor.GetLevelData(i);
+		input.levels[i].revision = levelEditor.GetLevelRevision(i);
+	}
+
+	return input;
+}
+
+void QueryWindow::RenderGUI(bool* p_open, EnemyEditor& enemyEditor, OperatorEditor& operatorEditor, SkillEditor& skillEditor, LevelEditor& levelEditor)
+{
+	ImGui::SetNextWindowSize(ImVec2(900, 650), ImGuiCond_FirstUseEver);
+	ImGui::Begin("데이터 질의", p_open);
+
+	ImGui::SetNextItemWidth(260);
+	if (ImGui::BeginCombo("예시", "선택하면 질의를 덮어씁니다"))
+	{
+		for (const QueryExample& example : EXAMPLES)
+		{
+			if (ImGui::Selectable(example.label))
+				snprintf(_source, sizeof(_source), "%s", example.source);
+		}
+		ImGui::EndCombo();
+	}
+
+	ImGui::InputTextMultiline("##QuerySource", _source, sizeof(_source), ImVec2(-1, ImGui::GetTextLineHeight() * 6));
+
+	if (ImGui::TreeNode("문법 / 열"))
+	{
+		ImGui::TextWrapped("from <표> [where 조건] [group by 식, ...] [select 식 [as 이름], ...] [having 조건] [order by 이름 [desc], ...] [limit N]");
+		ImGui::TextWrapped("집계: count() count(x) sum min max avg, 함수: round floor ceil abs min(a, b) max(a, b) clamp, 논리: and or not, 문자열은 \"...\"");
+
+		for (int t = 0; t < (int)QueryTable::MAX; ++t)
+		{
+			if (t > 0)
+				ImGui::SameLine();
+			ImGui::RadioButton(QueryTableName((QueryTable)t), &_helpTable, t);
+		}
+
+		std::string columns;
+		for (const std::string& name : QueryColumnNames((QueryTable)_helpTable))
+			columns += (columns.empty() ? "" : ", ") + name;
+		ImGui::TextColored(COLOR_GRAY, "열: %s", columns.c_str());
+		ImGui::TreePop();
+	}
+
+	bool run = ImGui::Button("실행");
+	if (ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) && ImGui::GetIO().KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_Enter))
+		run = true;
+
+	if (run)
+		_result = _engine.Run(BuildInput(enemyEditor, operatorEditor, skillEditor, levelEditor), _source);
+
+	ImGui::SameLine();
+	if (!_result.ok) ImGui::BeginDisabled();
+	if (ImGui::Button("TSV 복사"))
+		ImGui::SetClipboardText(_result.ToTsv().c_str());
+	if (!_result.ok) ImGui::EndDisabled();
+
+	ImGui::SameLine();
+	ImGui::TextColored(COLOR_GRAY, "Ctrl+Enter 로 실행");
+
+	if (!_result.error.empty())
+		ImGui::TextColored(COLOR_RED, "%s", _result.error.c_str());
+
+	ImGui::Separator();
+
+	if (_result.ok)
+		RenderResultTable();
+
+	ImGui::End();
+}
+
+void QueryWindow::RenderResultTable()
+{
+	ImGui::Text("%zu행 스캔, 조건 일치 %zu행", _result.scannedRows, _result.matchedRows);
+	if (_result.groupCount > 0)
+	{
+		ImGui::SameLine();
+		ImGui::Text("/ 그룹 %zu개", _result.groupCount);
+	}
+	ImGui::SameLine();
+	ImGui::Text("-> 결과 %zu행", _result.rowCount);
+
+	ImGui::TextColored(COLOR_GRAY, "계획 %.2f ms / 열 추출 %.2f ms / 스캔 %.2f ms / 마무리 %.2f ms (총 %.2f ms)",
+		_result.parseMs, _result.extractMs, _result.scanMs, _result.finishMs, _result.totalMs);
+	ImGui::TextColored(COLOR_GRAY, "%s", _result.plan.c_str());
+
+	if (_result.rowCount == 0 || _result.columns.empty())
+		return;
+
+	ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_ScrollX | ImGuiTableFlags_Resizable;
+	if (ImGui::BeginTable("QueryResult", (int)_result.columns.size(), flags))
+	{
+		ImGui::TableSetupScrollFreeze(0, 1);
+		for (const std::string& column : _result.columns)
+			ImGui::TableSetupColumn(column.c_str());
+		ImGui::TableHeadersRow();
+
+		ImGuiListClipper clipper;
+		clipper.Begin((int)_result.rowCount);
+		while (clipper.Step())
+		{
+			for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+			{
+				ImGui::TableNextRow();
+				for (size_t column = 0; column < _result.columns.size(); ++column)
+				{
+					ImGui::TableNextColumn();
+					ImGui::Text("%s", _result.CellText(row, column).c_str());
+				}
+			}
+		}
+		ImGui::EndTable();
+	}
+}
@@ -0,0 +1,31 @@
+﻿#pragma once
+#include <string>
+
+#include "QueryEngine.h"
+
+class EnemyEditor;
+class OperatorEditor;
+class SkillEditor;
+class LevelEditor;
+
+// 전체 게임 데이터에 대한 질의 창
+// 엔진이 뽑아 둔 열은 창이 닫혀도 유지되고, 편집기 revision 이 바뀐 표만 다시 뽑음
+class QueryWindow
+{
+public:
+	void RenderGUI(bool* p_open, EnemyEditor& enemyEditor, OperatorEditor& operatorEditor, SkillEditor& skillEditor, LevelEditor& levelEditor);
+
+private:
+	QueryEngine _engine;
+	char _source[2048] =
+		"from actions where enemy.type == \"FLYING\" and routeIndex == 0\n"
+		"group by levelId, wave, fragment\n"
+		"select levelId, wave, fragment, sum(count) as flying\n"
+		"having flying > 30 order by flying desc limit 50";
+	int _helpTable = 0;		// QueryTable
+
+	QueryResult _result;
+
+	QueryInput BuildInput(EnemyEditor& enemyEditor, OperatorEditor& operatorEditor, SkillEditor& skillEditor, LevelEditor& levelEditor) const;
+	void RenderResultTable();
+};
@@ -0,0 +1,308 @@
+﻿#include "RangeBitboard.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <bit>
+#include <unordered_map>
+
+namespace
+{
+	uint64_t MixHash(uint64_t h, uint64_t v)
+	{
+		h ^= v + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+		return h;
+	}
+
+	// 범위 워드를 col 위치로 이동 (비트 COL_BIAS 가 col 에 오도록)
+	uint64_t ShiftToColumn(uint64_t word, int col)
+	{
+		int shift = col - RangeBitboard::COL_BIAS;
+		if (shift >= 64 || shift <= -64)
+			return 0;
+		return shift >= 0 ? word << shift : word >> -shift;
+	}
+}
+
+RangeBitboard RangeBitboard::FromOffsets(const std::vector<GridOffset>& offsets)
+{
+	RangeBitboard board;
+	if (offsets.empty())
+		return board;
+
+	int minRow = offsets.front().row;
+	int maxRow = offsets.front().row;
+	for (const auto& offset : offsets)
+	{
+		minRow = std::min(minRow, offset.row);
+		maxRow = std::max(maxRow, offset.row);
+	}
+
+	board.minRow = minRow;
+	board.rows.assign(maxRow - minRow + 1, 0);
+
+	for (const auto& offset : offsets)
+	{
+		int bit = offset.col + COL_BIAS;
+		if (bit >= 0 && bit < 64)
+			board.rows[offset.row - minRow] |= 1ull << bit;
+	}
+
+	return board;
+}
+
+RangeBitboard RangeBitboard::FromSkillRange(const std::vector<SkillRange>& range)
+{
+	std::vector<GridOffset> offsets;
+	offsets.reserve(range.size());
+	for (const auto& cell : range)
+		offsets.push_back({ cell.row, cell.col });
+	return FromOffsets(offsets);
+}
+
+std::vector<GridOffset> RangeBitboard::ToOffsets() const
+{
+	std::vector<GridOffset> offsets;
+	for (size_t r = 0; r < rows.size(); ++r)
+	{
+		uint64_t word = rows[r];
+		while (word)
+		{
+			int bit = std::countr_zero(word);
+			offsets.push_back({ minRow + (int)r, bit - COL_BIAS });
+			word &= word - 1;
+		}
+	}
+	return offsets;
+}
+
+RangeBitboard RangeBitboard::Rotated(Direction dir) const
+{
+	if (dir == Direction::Right)
+		return *this;
+
+	std::vector<GridOffset> offsets = ToOffsets();
+	for (auto& offset : offsets)
+		offset = RotateOffset(offset, dir);
+	return FromOffsets(offsets);
+}
+
+int RangeBitboard::Count() const
+{
+	int count = 0;
+	for (uint64_t word : rows)
+		count += std::popcount(word);
+	return count;
+}
+
+uint64_t RangeBitboard::Hash() const
+{
+	uint64_t h = MixHash(0, (uint64_t)(int64_t)minRow);
+	for (uint64_t word : rows)
+		h = MixHash(h, word);
+	return h;
+}
+
+LevelBitboard LevelBitboard::FromLevelGrid(const LevelGrid& level)
+{
+	LevelBitboard board;
+	board.rows = level.rows;
+	board.cols = std::min(level.cols, 64);
+	board.path.assign(level.rows, 0);
+	board.ground.assign(level.rows, 0);
+	board.highGround.assign(level.rows, 0);
+
+	for (int row = 0; row < level.rows; ++row)
+	{
+		for (int col = 0; col < board.cols; ++col)
+		{
+			uint8_t type = level.buildable[level.TileIndex(row, col)];
+			if (type == 1)
+				board.ground[row] |= 1ull << col;
+			else if (type == 2)
+				board.highGround[row] |= 1ull << col;
+		}
+	}
+
+	for (const auto& route : level.routes)
+	{
+		for (const auto& tile : route.path)
+		{
+			if (level.InBounds(tile.row, tile.col) && tile.col < 64)
+				board.path[tile.row] |= 1ull << tile.col;
+		}
+	}
+
+	return board;
+}
+
+int CountCoverage(const LevelBitboard& level, const RangeBitboard& range, int row, int col)
+{
+	int count = 0;
+	for (size_t r = 0; r < range.rows.size(); ++r)
+	{
+		int levelRow = row + range.minRow + (int)r;
+		if (levelRow < 0 || levelRow >= level.rows)
+			continue;
+
+		count += std::popcount(level.path[levelRow] & ShiftToColumn(range.rows[r], col));
+	}
+	return count;
+}
+
+void BuildCoverageMask(const LevelBitboard& level, const RangeBitboard& range, int row, int col, uint64_t* out)
+{
+	std::fill(out, out + level.rows, 0ull);
+	for (size_t r = 0; r < range.rows.size(); ++r)
+	{
+		int levelRow = row + range.minRow + (int)r;
+		if (levelRow < 0 || levelRow >= level.rows)
+			continue;
+
+		out[levelRow] = level.path[levelRow] & ShiftToColumn(range.rows[r], col);
+	}
+}
+
+CoverageMap ComputeCoverage(const LevelBitboard& level, const RangeBitboard& range, BuildableFilter filter)
+{
+	CoverageMap map;
+	map.rows = level.rows;
+	map.cols = level.cols;
+
+	const size_t size = (size_t)level.rows * level.cols;
+	for (auto& layer : map.byDirection)
+		layer.assign(size, -1);
+	map.best.assign(size, -1);
+	map.bestDirection.assign(size, 0);
+
+	std::array<RangeBitboard, (int)Direction::MAX> rotations;
+	for (int d = 0; d < (int)Direction::MAX; ++d)
+		rotations[d] = range.Rotated((Direction)d);
+
+	for (int row = 0; row < level.rows; ++row)
+	{
+		uint64_t buildable;
+		switch (filter)
+		{
+		case BuildableFilter::Ground:		buildable = level.ground[row]; break;
+		case BuildableFilter::HighGround:	buildable = level.highGround[row]; break;
+		default:							buildable = level.ground[row] | level.highGround[row]; break;
+		}
+
+		while (buildable)
+		{
+			int col = std::countr_zero(buildable);
+			buildable &= buildable - 1;
+
+			int index = map.Index(row, col);
+			for (int d = 0; d < (int)Direction::MAX; ++d)
+			{
+				int coverage = CountCoverage(level, rotations[d], row, col);
+				map.byDirection[d][index] = (int16_t)coverage;
+
+				if (coverage > map.best[index])
+				{
+					map.best[index] = (int16_t)coverage;
+					map.bestDirection[index] = (uint8_t)d;
+				}
+			}
+			map.maxCoverage = std::max(map.maxCoverage, (int)map.best[index]);
+		}
+	}
+
+	return map;
+}
+
+std::vector<CoverageSweepEntry> RunCoverageSweep(const std::vector<LevelGrid>& levels, const std::vector<OperatorStats>& operators)
+{
+	// (범위 모양, 배치 타입) 중복 제거
+	struct Shape
+	{
+		RangeBitboard range;
+		BuildableFilter filter;
+	};
+
+	std::vector<Shape> shapes;
+	std::vector<int> shapeOf(operators.size());
+	std::unordered_map<uint64_t, std::vector<int>> buckets;
+
+	for (size_t i = 0; i < operators.size(); ++i)
+	{
+		RangeBitboard range = RangeBitboard::FromOffsets(operators[i].range);
+		BuildableFilter filter = operators[i].IsMelee() ? BuildableFilter::Ground : BuildableFilter::HighGround;
+		uint64_t key = range.Hash() ^ (uint64_t)filter;
+
+		int found = -1;
+		for (int candidate : buckets[key])
+		{
+			if (shapes[candidate].filter == filter && shapes[candidate].range == range)
+			{
+				found = candidate;
+				break;
+			}
+		}
+
+		if (found < 0)
+		{
+			found = (int)shapes.size();
+			shapes.push_back({ std::move(range), filter });
+			buckets[key].push_back(found);
+		}
+		shapeOf[i] = found;
+	}
+
+	std::vector<LevelBitboard> boards;
+	boards.reserve(levels.size());
+	for (const auto& level : levels)
+		boards.push_back(LevelBitboard::FromLevelGrid(level));
+
+	// (레벨, 모양) 별 요약
+	std::vector<CoverageSweepEntry> perShape(levels.size() * shapes.size());
+
+	ParallelFor(perShape.size(), 8, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t job = begin; job < end; ++job)
+			{
+				size_t levelIndex = job / shapes.size();
+				size_t shapeIndex = job % shapes.size();
+
+				CoverageMap map = ComputeCoverage(boards[levelIndex], shapes[shapeIndex].range, shapes[shapeIndex].filter);
+
+				CoverageSweepEntry& entry = perShape[job];
+				entry.levelIndex = (int)levelIndex;
+
+				double sum = 0.0;
+				int count = 0;
+				for (int row = 0; row < map.rows; ++row)
+				{
+					for (int col = 0; col < map.cols; ++col)
+					{
+						int value = map.best[map.Index(row, col)];
+						if (value < 0)
+							continue;
+
+						sum += value;
+						++count;
+						if (value > entry.bestCoverage)
+						{
+							entry.bestCoverage = value;
+							entry.bestTile = { row, col };
+							entry.bestDirection = (Direction)map.bestDirection[map.Index(row, col)];
+						}
+					}
+				}
+				entry.meanCoverage = count > 0 ? sum / count : 0.0;
+			}
+		});
+
+	std::vector<CoverageSweepEntry> results;
+	results.reserve(levels.size() * operators.size());
+	for (size_t levelIndex = 0; levelIndex < levels.size(); ++levelIndex)
+	{
+		for (size_t op = 0; op < operators.size(); ++op)
+		{
+			CoverageSweepEntry entry = perShape[levelIndex * shapes.size() + shapeOf[op]];
+			entry.operatorIndex = (int)op;
+			results.push_back(entry);
+		}
+	}
+	return results;
+}
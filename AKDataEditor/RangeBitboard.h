@@ -0,0 +1,85 @@
+﻿#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GameTables.h"
+#include "LevelGrid.h"
+#include "Skill.h"
+
+// 범위 모양 비트보드 (행 오프셋마다 64비트 한 워드, 비트 = col 오프셋 + COL_BIAS)
+struct RangeBitboard
+{
+	static constexpr int COL_BIAS = 31;		// col 오프셋 [-31, 32] 지원
+
+	int minRow = 0;							// rows[0] 의 행 오프셋
+	std::vector<uint64_t> rows;
+
+	static RangeBitboard FromOffsets(const std::vector<GridOffset>& offsets);
+	static RangeBitboard FromSkillRange(const std::vector<SkillRange>& range);
+
+	std::vector<GridOffset> ToOffsets() const;
+	RangeBitboard Rotated(Direction dir) const;
+	int Count() const;
+	bool Empty() const { return rows.empty(); }
+
+	bool operator==(const RangeBitboard& other) const { return minRow == other.minRow && rows == other.rows; }
+	uint64_t Hash() const;
+};
+
+// 레벨 타일 마스크 (게임 행마다 한 워드, 비트 = col)
+struct LevelBitboard
+{
+	int rows = 0;
+	int cols = 0;
+	std::vector<uint64_t> path;				// 경로가 지나가는 타일
+	std::vector<uint64_t> ground;			// buildableType 1 (근거리)
+	std::vector<uint64_t> highGround;		// buildableType 2 (원거리)
+
+	static LevelBitboard FromLevelGrid(const LevelGrid& level);
+
+	bool Test(const std::vector<uint64_t>& mask, int row, int col) const { return (mask[row] >> col) & 1ull; }
+};
+
+// 배치 가능한 타일마다 범위 안에 들어오는 경로 타일 수 (배치 불가 = -1)
+struct CoverageMap
+{
+	int rows = 0;
+	int cols = 0;
+	std::array<std::vector<int16_t>, (int)Direction::MAX> byDirection;
+	std::vector<int16_t> best;				// 네 방향 중 최대
+	std::vector<uint8_t> bestDirection;
+	int maxCoverage = 0;
+
+	int Index(int row, int col) const { return row * cols + col; }
+};
+
+enum class BuildableFilter
+{
+	Any = 0,
+	Ground,
+	HighGround
+};
+
+// 타일 한 칸 + 한 방향 범위의 경로 커버리지 (행마다 shift / AND / popcount 한 번)
+int CountCoverage(const LevelBitboard& level, const RangeBitboard& range, int row, int col);
+
+// 범위 안에 들어오는 경로 타일 마스크를 out[0..level.rows) 에 기록 (합집합 계산용)
+void BuildCoverageMask(const LevelBitboard& level, const RangeBitboard& range, int row, int col, uint64_t* out);
+
+CoverageMap ComputeCoverage(const LevelBitboard& level, const RangeBitboard& range, BuildableFilter filter);
+
+// 프로젝트 전체 스윕 결과 (레벨 × 오퍼레이터)
+struct CoverageSweepEntry
+{
+	int levelIndex = 0;
+	int operatorIndex = 0;
+	int bestCoverage = 0;
+	GridPos bestTile;
+	Direction bestDirection = Direction::Right;
+	double meanCoverage = 0.0;				// 배치 가능한 타일 평균 (최적 방향 기준)
+};
+
+// 같은 범위 모양은 한 번만 계산해 오퍼레이터에 나눠 줌, (레벨, 모양) 쌍을 모든 코어에 분배
+std::vector<CoverageSweepEntry> RunCoverageSweep(const std::vector<LevelGrid>& levels, const std::vector<OperatorStats>& operators);
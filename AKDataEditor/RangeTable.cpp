@@ -0,0 +1,321 @@
+﻿#include "RangeTable.h"
+#include "Utility.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	RangeBitboard BoardFromGrids(const json& grids)
+	{
+		std::vector<GridOffset> offsets;
+		if (grids.is_array())
+		{
+			offsets.reserve(grids.size());
+			for (const auto& cell : grids)
+				offsets.push_back({ cell.value("row", 0), cell.value("col", 0) });
+		}
+		return RangeBitboard::FromOffsets(offsets);
+	}
+
+	json GridsFromBoard(const RangeBitboard& board)
+	{
+		json grids = json::array();
+		for (const auto& offset : board.ToOffsets())
+			grids.push_back({ {"row", offset.row}, {"col", offset.col} });
+		return grids;
+	}
+
+	// 키 하나를 다른 키로 바꿔 같은 자리에 값을 넣음 (ordered_json 키 순서 유지)
+	void ReplaceKey(json& record, const char* oldKey, const char* newKey, json value)
+	{
+		json replaced = json::object();
+		for (auto it = record.begin(); it != record.end(); ++it)
+		{
+			if (it.key() == oldKey)
+				replaced[newKey] = std::move(value);
+			else
+				replaced[it.key()] = std::move(it.value());
+		}
+		record = std::move(replaced);
+	}
+
+	size_t FileSize(const fs::path& path)
+	{
+		std::error_code ec;
+		auto size = fs::file_size(path, ec);
+		return ec ? 0 : (size_t)size;
+	}
+
+	bool WriteJsonFile(const fs::path& path, const json& data)
+	{
+		std::ofstream file(path);
+		if (!file.is_open())
+		{
+			std::cout << "[Range] Failed to save " << path.string() << "\n";
+			return false;
+		}
+		file << data.dump(2);
+		return true;
+	}
+}
+
+std::string RangeTable::PathFor(const std::string& tablePath)
+{
+	return (fs::path(tablePath).parent_path() / "range_table.json").string();
+}
+
+std::string RangeTable::MakeId(uint64_t hash, int salt)
+{
+	char buffer[40];
+	if (salt == 0)
+		snprintf(buffer, sizeof(buffer), "range_%016llx", (unsigned long long)hash);
+	else
+		snprintf(buffer, sizeof(buffer), "range_%016llx_%d", (unsigned long long)hash, salt);
+	return buffer;
+}
+
+void RangeTable::Clear()
+{
+	_entries.clear();
+	_byId.clear();
+	_byHash.clear();
+}
+
+bool RangeTable::Load(const std::string& path)
+{
+	Clear();
+
+	std::ifstream file(path);
+	if (!file.is_open())
+		return true;
+
+	try
+	{
+		json data;
+		file >> data;
+
+		if (!data.contains("ranges"))
+			return true;
+
+		_entries.reserve(data["ranges"].size());
+		for (const auto& range : data["ranges"])
+		{
+			RangeEntry entry;
+			entry.rangeId = range.value("rangeId", "");
+			if (entry.rangeId.empty() || _byId.count(entry.rangeId))
+				continue;
+
+			entry.board = BoardFromGrids(range.value("grids", json::array()));
+			entry.grids = GridsFromBoard(entry.board);
+
+			size_t index = _entries.size();
+			_byId[entry.rangeId] = index;
+			_byHash.emplace(entry.board.Hash(), index);
+			_entries.push_back(std::move(entry));
+		}
+	}
+	catch (const json::exception& e)
+	{
+		std::cout << "[Range] Failed to parse " << path << ": " << e.what() << "\n";
+		Clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool RangeTable::Save(const std::string& path) const
+{
+	json ranges = json::array();
+	for (const auto& entry : _entries)
+		ranges.push_back({ {"rangeId", entry.rangeId}, {"grids", entry.grids} });
+
+	json output;
+	output["version"] = VERSION;
+	output["ranges"] = std::move(ranges);
+
+	fs::create_directories(fs::path(path).parent_path());
+	return WriteJsonFile(path, output);
+}
+
+std::string RangeTable::Intern(const json& grids)
+{
+	RangeBitboard board = BoardFromGrids(grids);
+	uint64_t hash = board.Hash();
+
+	// 해시가 같아도 모양이 다르면 salt 를 붙인 새 id
+	int salt = 0;
+	auto [first, last] = _byHash.equal_range(hash);
+	for (auto it = first; it != last; ++it)
+	{
+		if (_entries[it->second].board == board)
+			return _entries[it->second].rangeId;
+		++salt;
+	}
+
+	RangeEntry entry;
+	entry.rangeId = MakeId(hash, salt);
+	while (_byId.count(entry.rangeId))
+		entry.rangeId = MakeId(hash, ++salt);
+	entry.grids = GridsFromBoard(board);
+	entry.board = std::move(board);
+
+	size_t index = _entries.size();
+	_byId[entry.rangeId] = index;
+	_byHash.emplace(hash, index);
+	_entries.push_back(std::move(entry));
+	return _entries.back().rangeId;
+}
+
+const RangeEntry* RangeTable::Find(const std::string& rangeId) const
+{
+	auto it = _byId.find(rangeId);
+	return (it != _byId.end()) ? &_entries[it->second] : nullptr;
+}
+
+int RangeTable::ExpandRecords(json& records) const
+{
+	if (!records.is_array())
+		return 0;
+
+	int missing = 0;
+	for (auto& record : records)
+	{
+		if (!record.is_object() || !record.contains("rangeId") || !record["rangeId"].is_string())
+			continue;
+
+		const RangeEntry* entry = Find(record["rangeId"].get<std::string>());
+		if (!entry)
+		{
+			std::cout << "[Range] Unknown rangeId: " << record["rangeId"].get<std::string>() << "\n";
+			++missing;
+		}
+
+		ReplaceKey(record, "rangeId", "range", entry ? entry->grids : json::array());
+	}
+	return missing;
+}
+
+void RangeTable::CompactRecords(json& records)
+{
+	if (!records.is_array())
+		return;
+
+	for (auto& record : records)
+	{
+		if (!record.is_object() || !record.contains("range"))
+			continue;
+
+		ReplaceKey(record, "range", "rangeId", Intern(record["range"]));
+	}
+}
+
+int RangeTable::RemoveUnreferenced(const json& operators, const json& skills)
+{
+	std::unordered_map<std::string, bool> used;
+	for (const json* records : { &operators, &skills })
+	{
+		if (!records->is_array())
+			continue;
+		for (const auto& record : *records)
+		{
+			if (record.contains("rangeId") && record["rangeId"].is_string())
+				used[record["rangeId"].get<std::string>()] = true;
+		}
+	}
+
+	std::vector<RangeEntry> kept;
+	kept.reserve(_entries.size());
+	for (auto& entry : _entries)
+	{
+		if (used.count(entry.rangeId))
+			kept.push_back(std::move(entry));
+	}
+
+	int removed = (int)(_entries.size() - kept.size());
+
+	Clear();
+	_entries = std::move(kept);
+	for (size_t i = 0; i < _entries.size(); ++i)
+	{
+		_byId[_entries[i].rangeId] = i;
+		_byHash.emplace(_entries[i].board.Hash(), i);
+	}
+	return removed;
+}
+
+void ExpandRangeReferences(json& table, const char* arrayKey, const std::string& tablePath)
+{
+	if (!table.contains(arrayKey))
+		return;
+
+	RangeTable ranges;
+	if (ranges.Load(RangeTable::PathFor(tablePath)))
+		ranges.ExpandRecords(table[arrayKey]);
+}
+
+RangeTableRebuildReport RebuildRangeTable(const std::string& tablesDir)
+{
+	RangeTableRebuildReport report;
+
+	fs::path dir(tablesDir);
+	fs::path operatorPath = dir / "operators_table.json";
+	fs::path skillPath = dir / "skills_table.json";
+	fs::path rangePath = dir / "range_table.json";
+
+	report.bytesBefore = FileSize(operatorPath) + FileSize(skillPath) + FileSize(rangePath);
+
+	json operators, skills;
+	bool hasOperators = LoadJsonFile(operatorPath.string(), operators) && operators.contains("operators");
+	bool hasSkills = LoadJsonFile(skillPath.string(), skills) && skills.contains("skills");
+	if (!hasOperators && !hasSkills)
+		return report;
+
+	// 기존 id 를 최대한 유지하도록 이전 테이블로 펼친 뒤 같은 테이블에 다시 등록
+	RangeTable ranges;
+	if (!ranges.Load(rangePath.string()))
+		return report;
+
+	int missing = 0;
+	if (hasOperators)
+		missing += ranges.ExpandRecords(operators["operators"]);
+	if (hasSkills)
+		missing += ranges.ExpandRecords(skills["skills"]);
+
+	if (missing > 0)
+	{
+		std::cout << "[Range] Rebuild aborted: " << missing << " unresolved rangeId\n";
+		return report;
+	}
+
+	for (json* records : { hasOperators ? &operators["operators"] : nullptr, hasSkills ? &skills["skills"] : nullptr })
+	{
+		if (!records)
+			continue;
+		for (const auto& record : *records)
+		{
+			if (record.contains("range"))
+				++report.references;
+		}
+		ranges.CompactRecords(*records);
+	}
+
+	report.removed = ranges.RemoveUnreferenced(
+		hasOperators ? operators["operators"] : json::array(),
+		hasSkills ? skills["skills"] : json::array());
+	report.ranges = (int)ranges.Size();
+
+	report.ok = ranges.Save(rangePath.string())
+		&& (!hasOperators || WriteJsonFile(operatorPath, operators))
+		&& (!hasSkills || WriteJsonFile(skillPath, skills));
+
+	report.bytesAfter = FileSize(operatorPath) + FileSize(skillPath) + FileSize(rangePath);
+
+	std::cout << "[Range] Rebuilt: " << report.ranges << " ranges for " << report.references
+		<< " records (" << report.bytesBefore << " -> " << report.bytesAfter << " bytes)\n";
+	return report;
+}
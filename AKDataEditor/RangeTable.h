@@ -0,0 +1,67 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "GameTables.h"
+#include "RangeBitboard.h"
+
+// 공유 범위 테이블의 한 항목 (정규화된 모양 하나)
+struct RangeEntry
+{
+	std::string rangeId;
+	RangeBitboard board;
+	json grids;								// [{row, col}, ...] 정규화 순서 (확장 시 그대로 복사)
+};
+
+// 오퍼레이터/스킬의 range 배열을 모양별로 한 번만 저장하는 테이블 (gamedata/tables/range_table.json)
+// 레코드는 "range" 대신 "rangeId" 로 참조하고, 편집기는 로드 시 다시 "range" 로 펼쳐서 사용
+class RangeTable
+{
+public:
+	// 같은 폴더의 range_table.json 경로
+	static std::string PathFor(const std::string& tablePath);
+
+	// 파일이 없으면 빈 테이블로 시작 (true), 파싱 실패 시 false
+	bool Load(const std::string& path);
+	bool Save(const std::string& path) const;
+
+	// 정규화(행/열 순 정렬, 중복 제거)한 모양을 등록하고 id 반환 (같은 모양은 같은 id)
+	std::string Intern(const json& grids);
+	const RangeEntry* Find(const std::string& rangeId) const;
+
+	// records 의 "rangeId" -> "range" (찾지 못한 참조 수 반환, 해당 레코드는 빈 범위)
+	int ExpandRecords(json& records) const;
+	// records 의 "range" -> "rangeId" (키 순서 유지)
+	void CompactRecords(json& records);
+
+	// 참조되지 않는 항목 제거 (제거한 수 반환)
+	int RemoveUnreferenced(const json& operators, const json& skills);
+
+	size_t Size() const { return _entries.size(); }
+	void Clear();
+
+private:
+	static std::string MakeId(uint64_t hash, int salt);
+
+	std::vector<RangeEntry> _entries;
+	std::unordered_map<std::string, size_t> _byId;
+	std::unordered_multimap<uint64_t, size_t> _byHash;
+};
+
+// 테이블 파일(operators/skills)을 읽은 직후 같은 폴더의 범위 테이블로 rangeId 를 펼침
+void ExpandRangeReferences(json& table, const char* arrayKey, const std::string& tablePath);
+
+struct RangeTableRebuildReport
+{
+	bool ok = false;
+	int ranges = 0;							// 재구성 후 고유 모양 수
+	int references = 0;						// rangeId 로 바꾼 레코드 수
+	int removed = 0;						// 더 이상 쓰이지 않아 지운 항목 수
+	size_t bytesBefore = 0;					// 세 파일 합계
+	size_t bytesAfter = 0;
+};
+
+// 프로젝트 전체(operators + skills)의 범위를 모아 테이블을 새로 만들고 두 테이블을 id 참조로 다시 저장
+RangeTableRebuildReport RebuildRangeTable(const std::string& tablesDir);
@@ -1,11 +1,16 @@
 ﻿#include "SkillEditor.h"
 #include "Migration.h"
+#include "DataFiles.h"
+#include "RangeTable.h"
+#include <unordered_set>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <chrono>
 #include <imgui/imgui.h>
 
 #include "Utility.h"
+#include "Parallel.h"
 #include "ImGuiRAII.h"
 
 namespace fs = std::filesystem;
@@ -21,32 +26,41 @@ SkillEditor::~SkillEditor() {}
 
 void SkillEditor::LoadSkills()
 {
-    std::ifstream file(_jsonPath);
-    if (file.is_open())
+    _revision = NextDataRevision();
+    _statsDirty = true;
+
+    // 마이그레이션 저장은 해시와 관계없이 써야 하므로 저장된 상태를 모름으로 둠
+    _contentHashes.Clear();
+    _contentHashesDirty = true;
+
+    // 읽기 + rangeId 참조를 Skill::range 로 읽을 수 있게 펼침 + 버전 체크 및 마이그레이션 (명령줄 도구와 같은 경로)
+    json j;
+    std::string error;
+    DataFileStatus status = ReadDataFile(Migration::DataType::Skill, _jsonPath, j, error);
+    if (status == DataFileStatus::Missing)
+    {
+        std::cout << "[Skill] File not found, creating new: " << _jsonPath << '\n';
+        _skills.clear();
+    }
+    else if (status == DataFileStatus::ParseError)
+    {
+        std::cout << "[Skill] JSON parse error: " << error << '\n';
+        _skills.clear();
+    }
+    else
     {
         try
         {
-            json j;
-            file >> j;
-
-            // 버전 체크 및 마이그레이션
-            if (Migration::CheckAndMigrate(Migration::DataType::Skill, j))
-            {
-                // 마이그레이션 후 저장 (SaveSkills는 _skills 필요하므로 먼저 로드)
-                if (j.contains("skills"))
-                {
-                    _skills = j["skills"].get<std::vector<Skill>>();
-                }
-                SaveSkills();
-            }
-            else
+            _skills.clear();
+            if (j.contains("skills"))
             {
-                if (j.contains("skills"))
-                {
-                    _skills = j["skills"].get<std::vector<Skill>>();
-                }
+                _skills = j["skills"].get<std::vector<Skill>>();
             }
 
+            // 마이그레이션 후 저장 (SaveSkills는 _skills 필요하므로 먼저 로드)
+            if (status == DataFileStatus::Migrated)
+                SaveSkills();
+
             std::cout << "[Skill] Loaded " << _skills.size() << " skills\n";
         }
         catch (json::exception& e)
@@ -55,28 +69,54 @@ void SkillEditor::LoadSkills()
             _skills.clear();
         }
     }
-    else
-    {
-        std::cout << "[Skill] File not found, creating new: " << _jsonPath << '\n';
-        _skills.clear();
-    }
+
+    _selection.Clear();
+    _lastBulkEdit = BulkEditResult();
+
+    _pristine.Reset(_skills);
+    _fileStamps = { FileStamp::Of(_jsonPath), FileStamp::Of(RangeTable::PathFor(_jsonPath)) };
+    RefreshContentHashes();
+    _contentHashes.MarkSaved();
+
+    // 파일에서 다시 읽으면 이전 편집 기록은 맞지 않음
+    _undoTracker.Invalidate();
+    if (_history)
+        _history->Forget(this);
 }
 
 
 void SkillEditor::SaveSkills()
 {
-    fs::path filePath(_jsonPath);
-    fs::create_directories(filePath.parent_path());
+    // 내용이 저장된 해시와 같고 파일(범위 테이블 포함)도 그대로면 다시 쓰지 않음
+    RefreshContentHashes();
+    if (!_contentHashes.IsDirty() && FilesUnchanged(_fileStamps))
+    {
+        if (_history)
+            _history->MarkSaved(this);
+        _pristine.Commit(_skills);
+        _hasUnsavedChanges = false;
+        std::cout << "[Skill] Unchanged, save skipped\n";
+        return;
+    }
 
     json output;
     output["version"] = VERSION;  // 항상 현재 버전으로 저장
     output["skills"] = _skills;
 
-    std::ofstream file(_jsonPath);
-    if (file.is_open())
+    // 오퍼레이터와 같은 공유 범위 테이블에 범위를 등록하고 id 로 참조
+    // 파일을 닫은 뒤에 저널을 비움 (그 전에 죽으면 저널로 복구)
+    std::string rangePath = RangeTable::PathFor(_jsonPath);
+    if (WriteDataFile(Migration::DataType::Skill, _jsonPath, std::move(output)))
     {
-        file << output.dump(2);
         std::cout << "[Skill] Saved to " << _jsonPath << '\n';
+
+        if (_history)
+            _history->MarkSaved(this);
+
+        _pristine.Commit(_skills);
+        _fileStamps = { FileStamp::Of(_jsonPath), FileStamp::Of(rangePath) };
+        _contentHashes.MarkSaved();
+        _changeSummaryRevision = 0;
     }
     else
     {
@@ -87,6 +127,309 @@ void SkillEditor::SaveSkills()
     _hasUnsavedChanges = false;
 }
 
+void SkillEditor::DiscardChanges()
+{
+    std::vector<int> restored;
+
+    if (_pristine.Restore(_skills, restored))
+    {
+        // 바꾼 스킬만 통계에 다시 반영
+        if (!_statsDirty)
+        {
+            for (int index : restored)
+                _stats.Set(index, SkillStatValues(_skills[index]));
+        }
+        if (!_contentHashesDirty)
+        {
+            for (int index : restored)
+                _contentHashes.Set(index, _skills[index].skillId, HashJson(json(_skills[index])));
+        }
+    }
+    else
+    {
+        _statsDirty = true;
+        _contentHashesDirty = true;
+        _selection.Clear();
+    }
+
+    // 편집 창은 선택한 스킬의 복사본을 들고 있으므로 닫음
+    _showEditWindow = false;
+
+    _revision = NextDataRevision();
+    _hasUnsavedChanges = false;
+    _lastBulkEdit = BulkEditResult();
+
+    _undoTracker.Invalidate();
+    if (_history)
+        _history->Forget(this);
+
+    std::cout << "[Skill] Changes discarded (" << (restored.empty() ? "all" : std::to_string(restored.size())) << " records)\n";
+}
+
+void SkillEditor::RefreshFromDisk()
+{
+    if (FilesUnchanged(_fileStamps))
+        DiscardChanges();
+    else
+        LoadSkills();
+}
+
+void SkillEditor::MarkModified()
+{
+    _hasUnsavedChanges = true;
+    _revision = NextDataRevision();
+    _pristine.MarkAll();
+    _statsDirty = true;
+    _contentHashesDirty = true;
+}
+
+void SkillEditor::MarkSkillModified(int index)
+{
+    _hasUnsavedChanges = true;
+    _revision = NextDataRevision();
+    _pristine.MarkRecord(index);
+    if (!_statsDirty)
+        _stats.Set(index, SkillStatValues(_skills[index]));
+
+    json record = _skills[index];
+    if (!_contentHashesDirty)
+        _contentHashes.Set(index, _skills[index].skillId, HashJson(record));
+
+    _undoTracker.Commit(_history, this, index, record, _revision);
+}
+
+void SkillEditor::RefreshContentHashes()
+{
+    if (!_contentHashesDirty)
+        return;
+
+    std::vector<std::string> keys(_skills.size());
+    std::vector<uint64_t> hashes(_skills.size());
+    ParallelFor(_skills.size(), 256, [&](size_t begin, size_t end, unsigned)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                keys[i] = _skills[i].skillId;
+                hashes[i] = HashJson(json(_skills[i]));
+            }
+        });
+
+    _contentHashes.Build(std::move(keys), std::move(hashes));
+    _contentHashesDirty = false;
+}
+
+bool SkillEditor::HasUnsavedChanges()
+{
+    if (!_hasUnsavedChanges)
+        return false;
+
+    RefreshContentHashes();
+    return _contentHashes.IsDirty();
+}
+
+const RecordChangeSummary& SkillEditor::GetChangeSummary()
+{
+    if (_changeSummaryRevision != _revision)
+    {
+        RefreshContentHashes();
+        _changeSummary = _contentHashes.Diff();
+        _changeSummaryRevision = _revision;
+    }
+    return _changeSummary;
+}
+
+const RecordStatTable& SkillEditor::GetStats()
+{
+    if (_statsDirty)
+    {
+        std::vector<std::vector<double>> rows(_skills.size());
+        for (size_t i = 0; i < _skills.size(); ++i)
+            rows[i] = SkillStatValues(_skills[i]);
+
+        _stats.Build(rows);
+        _statsDirty = false;
+    }
+    return _stats;
+}
+
+bool SkillEditor::ApplyBulkEdit(BulkEditResult edit)
+{
+    json skills = _skills;
+    if (!edit.ok || !edit.Matches(skills, false))
+        return false;
+
+    edit.Apply(skills);
+    _skills = skills.get<std::vector<Skill>>();
+    MarkModified();
+    if (_history)
+        _history->Push(MakeBulkEditCommand(this, edit, false, "스킬 일괄 편집"));
+    _lastBulkEdit = std::move(edit);
+    std::cout << "[Skill] Bulk edit applied: " << _lastBulkEdit.changes.size() << " values\n";
+    return true;
+}
+
+bool SkillEditor::UndoBulkEdit()
+{
+    json skills = _skills;
+    bool ok = _lastBulkEdit.ok && _lastBulkEdit.Matches(skills, true);
+    if (ok)
+    {
+        _lastBulkEdit.Revert(skills);
+        _skills = skills.get<std::vector<Skill>>();
+        MarkModified();
+        if (_history)
+            _history->Push(MakeBulkEditCommand(this, _lastBulkEdit, true, "스킬 일괄 편집 되돌리기"));
+        std::cout << "[Skill] Bulk edit reverted\n";
+    }
+
+    // 이후에 같은 칸을 다시 고쳤으면 되돌릴 수 없음
+    _lastBulkEdit = BulkEditResult();
+    return ok;
+}
+
+std::string SkillEditor::EditRecordLabel(int record) const
+{
+    return (record >= 0 && record < (int)_skills.size()) ? _skills[record].skillId : "#" + std::to_string(record);
+}
+
+std::string SkillEditor::EditRecordKey(int record) const
+{
+    return (record >= 0 && record < (int)_skills.size()) ? _skills[record].skillId : std::string();
+}
+
+uint64_t SkillEditor::EditSourceHash(const std::string& /*source*/) const
+{
+    // 레코드는 스킬 테이블에만 있음 (범위 테이블은 오퍼레이터 저장으로도 바뀌므로 보지 않음)
+    return _fileStamps.empty() ? 0 : _fileStamps[0].hash;
+}
+
+void SkillEditor::SetRecordValue(int record, const json::json_pointer& pointer, const json& value)
+{
+    if (record < 0 || record >= (int)_skills.size())
+        return;
+
+    json skill = _skills[record];
+    SetJsonValue(skill, pointer, value);
+    _skills[record] = skill.get<Skill>();
+    MarkSkillModified(record);
+
+    // 편집 창은 열 때 입력 버퍼로 복사하므로 열려 있으면 닫음 (다시 열면 바뀐 값)
+    if (record == _selectedSkillIndex)
+        _showEditWindow = false;
+}
+
+void SkillEditor::InsertRecords(const std::vector<int>& indices, const std::vector<json>& records)
+{
+    std::vector<Skill> inserted;
+    inserted.reserve(records.size());
+    for (const json& record : records)
+        inserted.push_back(record.get<Skill>());
+
+    std::vector<int> remap = InsertAt(_skills, indices, std::move(inserted));
+
+    _selectedSkillIndex = RemapIndex(remap, _selectedSkillIndex);
+    _deleteTargetIndex = -1;
+    _selection.Remap(remap, _skills.size());
+    _lastBulkEdit = BulkEditResult();
+    MarkModified();
+}
+
+void SkillEditor::RemoveRecords(const std::vector<int>& indices)
+{
+    std::vector<uint8_t> remove(_skills.size(), 0);
+    for (int index : indices)
+    {
+        if (index >= 0 && index < (int)remove.size())
+            remove[index] = 1;
+    }
+    DeleteSkills(remove);
+}
+
+void SkillEditor::DeleteSkills(const std::vector<uint8_t>& remove)
+{
+    auto start = std::chrono::steady_clock::now();
+    size_t before = _skills.size();
+
+    // 지울 스킬만 실행 취소 기록으로 넘김
+    std::vector<int> indices;
+    std::vector<json> removed;
+    for (size_t i = 0; i < _skills.size() && i < remove.size(); ++i)
+    {
+        if (!remove[i])
+            continue;
+        indices.push_back((int)i);
+        removed.push_back(_skills[i]);
+    }
+
+    std::vector<int> remap = CompactRemove(_skills, remove);
+
+    _selectedSkillIndex = RemapIndex(remap, _selectedSkillIndex);
+    if (_selectedSkillIndex < 0)
+    {
+        _showEditWindow = false;
+        _showRangeEditor = false;
+    }
+    _deleteTargetIndex = -1;
+    _selection.Remap(remap, _skills.size());
+    _lastBulkEdit = BulkEditResult();
+    MarkModified();
+
+    if (_history)
+    {
+        std::string label = "스킬 " + std::to_string(indices.size()) + "개 삭제";
+        _history->Push(std::make_unique<RecordStructureCommand>(this, false, std::move(indices), std::move(removed), label));
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[Skill] Deleted " << (before - _skills.size()) << " skills (" << ms << " ms)\n";
+}
+
+void SkillEditor::DuplicateSelected()
+{
+    std::unordered_set<std::string> usedIds;
+    for (const auto& skill : _skills)
+        usedIds.insert(skill.skillId);
+
+    std::vector<int> remap = ::DuplicateSelected(_skills, _selection.Flags(), [&](const Skill& skill)
+        {
+            Skill copy = skill;
+            copy.skillId = MakeUniqueKey(skill.skillId, usedIds);
+            return copy;
+        });
+
+    // 새로 만든 복제본을 선택
+    std::vector<uint8_t> copies(_skills.size(), 0);
+    for (int index : _selection.Indices())
+        copies[remap[index] + 1] = 1;
+
+    int duplicated = _selection.Count();
+    _selection.Resize(_skills.size());
+    _selection.Clear();
+    for (size_t i = 0; i < copies.size(); ++i)
+        _selection.Set((int)i, copies[i]);
+
+    _selectedSkillIndex = RemapIndex(remap, _selectedSkillIndex);
+    _deleteTargetIndex = -1;
+    _lastBulkEdit = BulkEditResult();
+    MarkModified();
+
+    if (_history)
+    {
+        std::vector<int> indices;
+        std::vector<json> inserted;
+        for (size_t i = 0; i < copies.size(); ++i)
+        {
+            if (!copies[i])
+                continue;
+            indices.push_back((int)i);
+            inserted.push_back(_skills[i]);
+        }
+        _history->Push(std::make_unique<RecordStructureCommand>(this, true, std::move(indices), std::move(inserted), "스킬 " + std::to_string(duplicated) + "개 복제"));
+    }
+
+    std::cout << "[Skill] Duplicated " << duplicated << " skills\n";
+}
+
 void SkillEditor::RenderGUI(bool* p_open)
 {
     if (ScopedWindow window("스킬 편집기", p_open); window)
@@ -102,14 +445,19 @@ void SkillEditor::RenderGUI(bool* p_open)
 
     if (_showEditWindow)
         RenderEditWindow();
+
+    if (_showTimelineWindow)
+        RenderTimelineWindow();
 }
 
 void SkillEditor::RenderToolbar()
 {
-    if (_hasUnsavedChanges)
+    if (HasUnsavedChanges())
     {
         SCOPED_COLOR(ImGuiCol_Text, COLOR_YELLOW);
         ImGui::Text("* 저장되지 않은 변경사항");
+        if (ImGui::IsItemHovered())
+            RenderChangeSummaryTooltip(GetChangeSummary());
 
         ImGui::SameLine();
 
@@ -123,7 +471,7 @@ void SkillEditor::RenderToolbar()
 
         if (ImGui::Button("되돌리기"))
         {
-            LoadSkills();
+            DiscardChanges();
             _hasUnsavedChanges = false;
             std::cout << "[Skill] Changes discarded.\n";
         }
@@ -148,9 +496,17 @@ void SkillEditor::RenderToolbar()
 
     if (ImGui::Button("새로고침"))
     {
-        LoadSkills();
+        RefreshFromDisk();
         _hasUnsavedChanges = false;
     }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("가동률 분석"))
+    {
+        _allTimelines = _timelineEngine.EvaluateAll(_skills, _timelineConfig);
+        _showTimelineWindow = true;
+    }
 }
 
 void SkillEditor::RenderSkillList()
@@ -161,13 +517,34 @@ void SkillEditor::RenderSkillList()
         return;
     }
 
+    _selection.Resize(_skills.size());
+
+    switch (RenderBatchToolbar(_selection, true))
+    {
+    case BatchAction::Delete:
+        _showBatchDeleteConfirm = true;
+        break;
+    case BatchAction::Duplicate:
+        DuplicateSelected();
+        break;
+    case BatchAction::SetField:
+        _fieldSetPopup.Open();
+        break;
+    default:
+        break;
+    }
+
+    RenderBatchPopups();
+
     ImGuiTableFlags flags = ImGuiTableFlags_Borders |
         ImGuiTableFlags_RowBg |
         ImGuiTableFlags_Resizable |
         ImGuiTableFlags_ScrollY;
 
-    if (ScopedTable table("SkillTable", 7, flags); table)
+    if (ScopedTable table("SkillTable", 8, flags); table)
     {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("##Select", ImGuiTableColumnFlags_WidthFixed, 24.0f);
         ImGui::TableSetupColumn("ID", ImGuiTableColumnFlags_WidthFixed, 150.0f);
         ImGui::TableSetupColumn("Operator", ImGuiTableColumnFlags_WidthFixed, 120.0f);
         ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthFixed, 150.0f);
@@ -190,6 +567,9 @@ void SkillEditor::RenderSkillList()
 
             ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg0, bg);
 
+            ImGui::TableNextColumn();
+            SelectionCheckbox(_selection, index);
+
             ImGui::TableNextColumn();
             ImGui::Text("%s", skill.skillId.c_str());
 
@@ -250,8 +630,9 @@ void SkillEditor::RenderSkillList()
         {
             if (_deleteTargetIndex >= 0 && _deleteTargetIndex < (int)_skills.size())
             {
-                _skills.erase(_skills.begin() + _deleteTargetIndex);
-                _hasUnsavedChanges = true;
+                std::vector<uint8_t> remove(_skills.size(), 0);
+                remove[_deleteTargetIndex] = 1;
+                DeleteSkills(remove);
                 std::cout << "[Skill] Deleted: " << _deleteTargetName << '\n';
             }
             _deleteTargetIndex = -1;
@@ -331,7 +712,8 @@ void SkillEditor::RenderCreateWindow()
         }
 
         ImGui::SeparatorText("효과 (Blackboard)");
-        RenderEffectListPanel();
+        RenderEffectListPanel((_selectedOperatorIdx >= 0 && _selectedOperatorIdx < (int)_operatorIds.size())
+            ? _operatorIds[_selectedOperatorIdx] : "");
 
         ImGui::Separator();
 
@@ -342,7 +724,13 @@ void SkillEditor::RenderCreateWindow()
                 Skill newSkill = CreateSkillFromBuffer();
                 _skills.push_back(newSkill);
 
-                _hasUnsavedChanges = true;
+                MarkModified();
+
+                if (_history)
+                {
+                    int index = (int)_skills.size() - 1;
+                    _history->Push(std::make_unique<RecordStructureCommand>(this, true, std::vector<int>{ index }, std::vector<json>{ json(newSkill) }, "스킬 생성: " + newSkill.skillId));
+                }
                 _showCreateWindow = false;
 
                 std::cout << "[Skill] Created: " << newSkill.name << '\n';
@@ -379,6 +767,8 @@ void SkillEditor::RenderEditWindow()
     if (ScopedWindow window("스킬 편집", &_showEditWindow); window)
     {
         Skill& skill = _skills[_selectedSkillIndex];
+        if (!_undoTracker.IsTracking(_selectedSkillIndex, _revision))
+            _undoTracker.Reset(_selectedSkillIndex, _revision, json(skill));
 
         ImGui::SeparatorText("기본 정보");
         ImGui::Text("Operators: %s", skill.operatorId.c_str());
@@ -415,7 +805,7 @@ void SkillEditor::RenderEditWindow()
         ImGui::Text("(%d 칸)", rangeCount);
 
         ImGui::SeparatorText("효과 (Blackboard)");
-        RenderEffectListPanel();
+        RenderEffectListPanel(skill.operatorId);
 
         ImGui::Separator();
 
@@ -431,7 +821,7 @@ void SkillEditor::RenderEditWindow()
             skill.range = GridToRangeJson();
             skill.blackboard = _currentEffects;
 
-            _hasUnsavedChanges = true;
+            MarkSkillModified(_selectedSkillIndex);
             _showEditWindow = false;
         }
 
@@ -545,7 +935,7 @@ void SkillEditor::RenderRangeGridEditor()
     }
 }
 
-void SkillEditor::RenderEffectListPanel()
+void SkillEditor::RenderEffectListPanel(const std::string& operatorId)
 {
     if (_currentEffects.empty())
     {
@@ -594,7 +984,7 @@ void SkillEditor::RenderEffectListPanel()
                 if (ImGui::SmallButton("삭제"))
                 {
                     _currentEffects.erase(_currentEffects.begin() + index);
-                    _hasUnsavedChanges = true;
+                    MarkModified();
                     break;
                 }
 
@@ -610,6 +1000,162 @@ void SkillEditor::RenderEffectListPanel()
         _editingEffectIndex = -1;
         _showEffectAddPopup = true;
     }
+
+    RenderSkillTimelinePreview(operatorId);
+}
+
+void SkillEditor::RenderSkillTimelinePreview(const std::string& operatorId)
+{
+    if (!ImGui::CollapsingHeader("가동률 / DPS 미리보기", ImGuiTreeNodeFlags_DefaultOpen))
+        return;
+
+    if (!_timelineEngine.FindOperator(operatorId))
+    {
+        ImGui::TextColored(COLOR_GRAY, "오퍼레이터 스탯을 찾을 수 없습니다: %s", operatorId.c_str());
+        return;
+    }
+
+    // 입력 중인 값으로 바로 계산 (저장 전)
+    Skill preview;
+    preview.operatorId = operatorId;
+    preview.skillType = _inputSkillType;
+    preview.duration = _inputDuration;
+    preview.spData.spType = _inputSpType;
+    preview.spData.spCost = _inputSpCost;
+    preview.spData.initSp = _inputInitSp;
+    preview.blackboard = _currentEffects;
+
+    SkillTimeline timeline = _timelineEngine.Evaluate(preview, _timelineConfig);
+
+    ImGui::Text("기본 DPS %.1f  |  스킬 DPS %.1f  |  평균 DPS %.1f", timeline.baseDps, timeline.skillDps, timeline.averageDps);
+    ImGui::Text("가동률 %.1f%%  |  발동 %d회  |  첫 발동 %.1fs",
+        timeline.uptime * 100.0, timeline.activations, timeline.firstActivation);
+
+    if (!timeline.ignoredKeys.empty())
+    {
+        std::string keys;
+        for (const auto& key : timeline.ignoredKeys)
+            keys += (keys.empty() ? "" : ", ") + key;
+        ImGui::TextColored(COLOR_YELLOW, "계산에 반영되지 않은 키: %s", keys.c_str());
+    }
+
+    float maxDps = 0.0f;
+    for (float v : timeline.dps)
+        maxDps = std::max(maxDps, v);
+
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "0 ~ %.0fs", _timelineConfig.horizon);
+    ImGui::PlotLines("##SkillDps", timeline.dps.data(), (int)timeline.dps.size(), 0, overlay, 0.0f, maxDps * 1.1f, ImVec2(-1, 80));
+}
+
+void SkillEditor::RenderTimelineWindow()
+{
+    ImGui::SetNextWindowSize(ImVec2(700, 500), ImGuiCond_FirstUseEver);
+
+    if (ScopedWindow window("스킬 가동률 분석", &_showTimelineWindow); window)
+    {
+        {
+            SCOPED_ITEM_WIDTH(120);
+            ImGui::InputDouble("계산 구간 (초)", &_timelineConfig.horizon, 10.0, 60.0, "%.0f");
+            ImGui::SameLine();
+            ImGui::InputDouble("피격 간격 (초)", &_timelineConfig.hitInterval, 0.1, 1.0, "%.1f");
+            ImGui::SameLine();
+            ImGui::InputInt("기준 방어력", &_timelineConfig.targetDef);
+        }
+
+        _timelineConfig.horizon = std::max(1.0, _timelineConfig.horizon);
+
+        if (ImGui::Button("다시 계산") || _allTimelines.size() != _skills.size())
+            _allTimelines = _timelineEngine.EvaluateAll(_skills, _timelineConfig);
+
+        ImGui::Separator();
+
+        ImGuiTableFlags flags = ImGuiTableFlags_Borders |
+            ImGuiTableFlags_RowBg |
+            ImGuiTableFlags_ScrollY |
+            ImGuiTableFlags_Sortable;
+
+        if (ScopedTable table("TimelineTable", 6, flags); table)
+        {
+            ImGui::TableSetupColumn("ID");
+            ImGui::TableSetupColumn("Operator");
+            ImGui::TableSetupColumn("가동률");
+            ImGui::TableSetupColumn("평균 DPS");
+            ImGui::TableSetupColumn("스킬 DPS");
+            ImGui::TableSetupColumn("발동");
+            ImGui::TableHeadersRow();
+
+            std::vector<int> order(_skills.size());
+            for (int i = 0; i < (int)order.size(); ++i)
+                order[i] = i;
+
+            if (ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs(); specs && specs->SpecsCount > 0)
+            {
+                const ImGuiTableColumnSortSpecs& spec = specs->Specs[0];
+                bool ascending = spec.SortDirection == ImGuiSortDirection_Ascending;
+
+                auto key = [&](int i) -> double
+                    {
+                        switch (spec.ColumnIndex)
+                        {
+                        case 2: return _allTimelines[i].uptime;
+                        case 3: return _allTimelines[i].averageDps;
+                        case 4: return _allTimelines[i].skillDps;
+                        case 5: return _allTimelines[i].activations;
+                        default: return 0.0;
+                        }
+                    };
+
+                if (spec.ColumnIndex >= 2)
+                {
+                    std::stable_sort(order.begin(), order.end(), [&](int a, int b)
+                        { return ascending ? key(a) < key(b) : key(a) > key(b); });
+                }
+                else if (spec.ColumnIndex == 1)
+                {
+                    std::stable_sort(order.begin(), order.end(), [&](int a, int b)
+                        { return ascending ? _skills[a].operatorId < _skills[b].operatorId : _skills[a].operatorId > _skills[b].operatorId; });
+                }
+                else if (!ascending)
+                {
+                    std::reverse(order.begin(), order.end());
+                }
+            }
+
+            ImGuiListClipper clipper;
+            clipper.Begin((int)order.size());
+            while (clipper.Step())
+            {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+                {
+                    int i = order[row];
+                    const SkillTimeline& timeline = _allTimelines[i];
+
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", _skills[i].skillId.c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", _skills[i].operatorId.c_str());
+
+                    if (!timeline.hasOwner)
+                    {
+                        ImGui::TableNextColumn();
+                        ImGui::TextColored(COLOR_GRAY, "오퍼레이터 없음");
+                        continue;
+                    }
+
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f%%", timeline.uptime * 100.0);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f", timeline.averageDps);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f", timeline.skillDps);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%d", timeline.activations);
+                }
+            }
+        }
+    }
 }
 
 void SkillEditor::RenderEffectAddPopup()
@@ -647,7 +1193,7 @@ void SkillEditor::RenderEffectAddPopup()
                     _currentEffects.push_back(entry);
                 }
 
-                _hasUnsavedChanges = true;
+                MarkModified();
                 ImGui::CloseCurrentPopup();
             }
         }
@@ -771,6 +1317,7 @@ void SkillEditor::LoadOperatorIds()
         {
             json j;
             file >> j;
+            ExpandRangeReferences(j, "operators", _operatorPath);
 
             if (j.contains("operators") && j["operators"].is_array())
             {
@@ -786,6 +1333,8 @@ void SkillEditor::LoadOperatorIds()
 
             std::sort(_operatorIds.begin(), _operatorIds.end());
 
+            _timelineEngine = SkillTimelineEngine(ParseOperatorTable(j));
+
             std::cout << "[SKill] Loaded " << _operatorIds.size() << " operators.\n";
         }
         catch (json::exception e)
@@ -812,6 +1361,56 @@ std::string SkillEditor::GenerateSkillId(const std::string& operatorId, const st
     return skillId;
 }
 
+void SkillEditor::RenderBatchPopups()
+{
+    if (_showBatchDeleteConfirm)
+    {
+        ImGui::OpenPopup("일괄 삭제 확인");
+        _showBatchDeleteConfirm = false;
+    }
+
+    if (ScopedPopupModal popup("일괄 삭제 확인", NULL, ImGuiWindowFlags_AlwaysAutoResize); popup)
+    {
+        ImGui::TextColored(COLOR_RED, "선택한 스킬 %d개를 정말 삭제할까요?", _selection.Count());
+        ImGui::Separator();
+
+        // 앞쪽 몇 개만 표시
+        int shown = 0;
+        for (int index : _selection.Indices())
+        {
+            if (shown++ == 10)
+            {
+                ImGui::TextColored(COLOR_GRAY, "... 외 %d개", _selection.Count() - 10);
+                break;
+            }
+            ImGui::TextColored(COLOR_YELLOW, "%s (%s)", _skills[index].skillId.c_str(), _skills[index].name.c_str());
+        }
+
+        ImGui::Separator();
+
+        if (ImGui::Button("예", ImVec2(120, 0)))
+        {
+            DeleteSkills(_selection.Flags());
+            ImGui::CloseCurrentPopup();
+        }
+
+        ImGui::SameLine();
+
+        if (ImGui::Button("아니요", ImVec2(120, 0)))
+        {
+            ImGui::CloseCurrentPopup();
+        }
+    }
+
+    // 필드 설정 팝업이 열려 있을 때만 스킬 목록을 JSON 으로 변환
+    if (!_fieldSetPopup.IsOpen())
+        return;
+
+    BulkEditResult edit;
+    if (_fieldSetPopup.Render(BulkEditTarget::Skill, GetSkillData(), _selection.Flags(), edit))
+        ApplyBulkEdit(std::move(edit));
+}
+
 std::string SkillEditor::GetOperatorDisplayName(const std::string& operatorId)
 {
     return operatorId;
@@ -1,12 +1,20 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <cstdint>
 #include <nlohmann/json.hpp>
 #include "Skill.h"
+#include "SkillTimeline.h"
+#include "BulkEdit.h"
+#include "BatchWidgets.h"
+#include "ProjectStats.h"
+#include "EditHistory.h"
+#include "PristineSnapshot.h"
+#include "ContentHash.h"
 
 using json = nlohmann::ordered_json;
 
-class SkillEditor
+class SkillEditor : public RecordEditTarget
 {
 public:
 	SkillEditor(std::string jsonPath, std::string operatorPath);
@@ -15,10 +23,39 @@ public:
 	void LoadSkills();
 	void SaveSkills();
 
+	//  аų  · ǵ ( ٽ  ʰ ٲ ų )
+	void DiscardChanges();
+	// ų ̺/ ̺ ٲ  ٽ а, ״θ DiscardChanges
+	void RefreshFromDisk();
+
 	void RenderGUI(bool* p_open);
 
-	bool HasUnsavedChanges() const { return _hasUnsavedChanges; }
+	//  ƴٰ    ؽÿ Ƿ false
+	bool HasUnsavedChanges();
 	void ClearUnsavedFlag() { _hasUnsavedChanges = false; }
+	//  ¿ ٸ skillId 
+	const RecordChangeSummary& GetChangeSummary();
+
+	// ϰ  JSON  (skills[]   )
+	json GetSkillData() const { return json(_skills); }
+	const std::vector<Skill>& GetSkills() const { return _skills; }
+	uint64_t GetRevision() const { return _revision; }
+	const RecordStatTable& GetStats();
+	bool ApplyBulkEdit(BulkEditResult edit);
+	bool UndoBulkEdit();
+	bool CanUndoBulkEdit() const { return _lastBulkEdit.ok; }
+
+	//    (ڵ = skills[]  ų ϳ,  Skill  JSON  ٲ ٷ)
+	void SetEditHistory(EditHistory* history) { _history = history; }
+	const char* EditTargetName() const override { return "ų"; }
+	std::string EditRecordLabel(int record) const override;
+	std::string EditRecordKey(int record) const override;
+	std::string EditRecordKeyPath() const override { return "/skillId"; }
+	uint64_t EditSourceHash(const std::string& source) const override;
+	int EditRecordCount() const override { return (int)_skills.size(); }
+	void SetRecordValue(int record, const json::json_pointer& pointer, const json& value) override;
+	void InsertRecords(const std::vector<int>& indices, const std::vector<json>& records) override;
+	void RemoveRecords(const std::vector<int>& indices) override;
 
 private:
 	std::string _jsonPath;
@@ -31,6 +68,32 @@ private:
 
 	//  
 	bool _hasUnsavedChanges = false;
+	uint64_t _revision = 0;
+
+	void MarkModified();
+	void MarkSkillModified(int index);	// ų ϳ  ٲ
+
+	//  ú   ( ٲ    ٽ )
+	RecordStatTable _stats{ SkillStatColumns() };
+	bool _statsDirty = true;
+
+	//  ϰ  (ǵ)
+	BulkEditResult _lastBulkEdit;
+
+	//  Ϸ   纻  ٲ  
+	EditHistory* _history = nullptr;
+	RecordEditTracker _undoTracker;
+
+	//   纻   ( ̺ )
+	PristineSnapshot<std::vector<Skill>> _pristine;
+	std::vector<FileStamp> _fileStamps;
+
+	// ų  ؽ ( ٲ ش ų,  ٲ    ü ٽ )
+	RecordHashTable _contentHashes;
+	bool _contentHashesDirty = true;
+	RecordChangeSummary _changeSummary;
+	uint64_t _changeSummaryRevision = 0;
+	void RefreshContentHashes();
 
 	// GUI State
 	bool _showCreateWindow = false;
@@ -44,6 +107,14 @@ private:
 	int _deleteTargetIndex = -1;
 	std::string _deleteTargetName = "";
 
+	//    / ϰ ۾
+	MultiSelection _selection;
+	FieldSetPopup _fieldSetPopup;
+	bool _showBatchDeleteConfirm = false;
+
+	void DeleteSkills(const std::vector<uint8_t>& remove);	//  ÷׿  
+	void DuplicateSelected();
+
 	char _inputSkillName[64] = "";
 	char _inputSkillDesc[512] = "";
 	int _inputSkillType = 1;
@@ -63,13 +134,22 @@ private:
 
 	std::vector<BlackboardEntry> _currentEffects;
 
+	// ų  / DPS ŸӶ
+	SkillTimelineEngine _timelineEngine{ {} };
+	SkillTimelineConfig _timelineConfig;
+	std::vector<SkillTimeline> _allTimelines;
+	bool _showTimelineWindow = false;
+
 	// GUI Render
 	void RenderToolbar();
 	void RenderSkillList();
+	void RenderBatchPopups();
 	void RenderCreateWindow();
 	void RenderEditWindow();
 	void RenderRangeGridEditor();
-	void RenderEffectListPanel();
+	void RenderEffectListPanel(const std::string& operatorId);
+	void RenderSkillTimelinePreview(const std::string& operatorId);
+	void RenderTimelineWindow();
 	void RenderEffectAddPopup();
 
 	// 
@@ -0,0 +1,230 @@
+﻿#include "SkillTimeline.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	constexpr double MIN_DAMAGE_RATIO = 0.05;
+	constexpr int MAX_ACTIVATIONS = 100000;
+
+	enum SpType
+	{
+		SP_ATTACK = 1,
+		SP_TIME = 2,
+		SP_HIT = 4
+	};
+
+	enum SkillType
+	{
+		SKILL_PASSIVE = 0,
+		SKILL_MANUAL = 1,
+		SKILL_AUTO = 2
+	};
+
+	// 오퍼레이터 + 수정치로 1회 공격 피해와 공격 간격
+	struct AttackProfile
+	{
+		double hitDamage = 0.0;
+		double interval = 1.0;
+
+		double Dps() const { return hitDamage / interval; }
+	};
+
+	AttackProfile BuildProfile(const OperatorStats& op, const SkillModifiers& mods, const SkillTimelineConfig& config)
+	{
+		double atk = op.atk * (1.0 + mods.atk) * mods.atkScale;
+
+		double damage;
+		if (op.IsHealer())
+			damage = atk;
+		else if (op.DealsArtsDamage())
+			damage = atk * (1.0 - config.targetResistance);
+		else
+			damage = atk - config.targetDef;
+		damage = std::max(damage, atk * MIN_DAMAGE_RATIO);
+
+		// 공격 속도 100 기준 (attack_speed +x 는 간격을 100 / (100 + x) 배)
+		double interval = std::max(0.05, op.baseAttackTime + mods.baseAttackTime);
+		interval *= 100.0 / std::max(10.0, 100.0 + mods.attackSpeed);
+
+		AttackProfile profile;
+		profile.hitDamage = damage * std::max(1, mods.times);
+		profile.interval = interval;
+		return profile;
+	}
+
+	// [from, to) 구간에 rate 를 구간 폭에 비례해 누적
+	void AddRate(std::vector<double>& bins, double binWidth, double from, double to, double rate)
+	{
+		if (to <= from || rate == 0.0)
+			return;
+
+		int first = std::max(0, (int)(from / binWidth));
+		int last = std::min((int)bins.size() - 1, (int)(to / binWidth));
+		for (int b = first; b <= last; ++b)
+		{
+			double lo = std::max(from, b * binWidth);
+			double hi = std::min(to, (b + 1) * binWidth);
+			if (hi > lo)
+				bins[b] += rate * (hi - lo);
+		}
+	}
+
+	void AddBurst(std::vector<double>& bins, double binWidth, double time, double damage)
+	{
+		int b = (int)(time / binWidth);
+		if (b >= 0 && b < (int)bins.size())
+			bins[b] += damage;
+	}
+}
+
+SkillModifiers SkillModifiers::FromBlackboard(const std::vector<BlackboardEntry>& blackboard)
+{
+	SkillModifiers mods;
+
+	for (const auto& entry : blackboard)
+	{
+		if (entry.key == "atk")
+			mods.atk += entry.value;
+		else if (entry.key == "atk_scale")
+			mods.atkScale *= entry.value;
+		else if (entry.key == "attack_speed")
+			mods.attackSpeed += entry.value;
+		else if (entry.key == "base_attack_time")
+			mods.baseAttackTime += entry.value;
+		else if (entry.key == "times" || entry.key == "attack@times")
+			mods.times = std::max(1, (int)std::lround(entry.value));
+		else
+			mods.ignoredKeys.push_back(entry.key);
+	}
+
+	return mods;
+}
+
+SkillTimelineEngine::SkillTimelineEngine(const std::vector<OperatorStats>& operators)
+	: _operators(operators)
+{
+	for (int i = 0; i < (int)_operators.size(); ++i)
+		_lookup[_operators[i].charId] = i;
+}
+
+const OperatorStats* SkillTimelineEngine::FindOperator(const std::string& charId) const
+{
+	auto it = _lookup.find(charId);
+	return (it != _lookup.end()) ? &_operators[it->second] : nullptr;
+}
+
+SkillTimeline SkillTimelineEngine::Evaluate(const Skill& skill, const SkillTimelineConfig& config) const
+{
+	SkillTimeline result;
+
+	SkillModifiers mods = SkillModifiers::FromBlackboard(skill.blackboard);
+	result.ignoredKeys = mods.ignoredKeys;
+
+	const OperatorStats* op = FindOperator(skill.operatorId);
+	if (!op)
+		return result;
+
+	result.hasOwner = true;
+
+	const double horizon = std::max(config.binWidth, config.horizon);
+	const double binWidth = std::max(0.01, config.binWidth);
+	std::vector<double> bins((size_t)std::ceil(horizon / binWidth), 0.0);
+
+	AttackProfile base = BuildProfile(*op, SkillModifiers(), config);
+	AttackProfile active = BuildProfile(*op, mods, config);
+	result.baseDps = base.Dps();
+	result.skillDps = active.Dps();
+
+	double activeTime = 0.0;
+
+	if (skill.skillType == SKILL_PASSIVE)
+	{
+		AddRate(bins, binWidth, 0.0, horizon, active.Dps());
+		activeTime = horizon;
+		result.activations = 1;
+		result.firstActivation = 0.0;
+	}
+	else
+	{
+		// SP 1 당 걸리는 시간 (0 = None 등 충전 방식이 없으면 충전되지 않아 초기 SP 로만 발동)
+		double secondsPerSp;
+		switch (skill.spData.spType)
+		{
+		case SP_ATTACK:	secondsPerSp = base.interval; break;
+		case SP_TIME:	secondsPerSp = 1.0; break;
+		case SP_HIT:	secondsPerSp = std::max(0.01, config.hitInterval); break;
+		default:		secondsPerSp = std::numeric_limits<double>::infinity(); break;
+		}
+
+		double time = 0.0;
+		int sp = std::clamp(skill.spData.initSp, 0, std::max(0, skill.spData.spCost));
+
+		while (time < horizon && result.activations < MAX_ACTIVATIONS)
+		{
+			int needed = std::max(0, skill.spData.spCost - sp);
+			double chargeEnd = (needed > 0) ? time + needed * secondsPerSp : time;
+			AddRate(bins, binWidth, time, std::min(chargeEnd, horizon), base.Dps());
+
+			if (chargeEnd >= horizon)
+				break;
+
+			++result.activations;
+			if (result.firstActivation < 0.0)
+				result.firstActivation = chargeEnd;
+
+			if (skill.duration > 0.0)
+			{
+				double activeEnd = std::min(horizon, chargeEnd + skill.duration);
+				AddRate(bins, binWidth, chargeEnd, activeEnd, active.Dps());
+				activeTime += activeEnd - chargeEnd;
+				time = chargeEnd + skill.duration;
+			}
+			else
+			{
+				// 지속 시간이 없는 스킬은 다음 1회 공격을 강화
+				AddBurst(bins, binWidth, chargeEnd, active.hitDamage - base.hitDamage);
+				time = chargeEnd + base.interval;
+				AddRate(bins, binWidth, chargeEnd, std::min(time, horizon), base.Dps());
+
+				// 코스트 0 인 즉발 스킬은 매 공격 강화와 같음
+				if (skill.spData.spCost <= 0)
+				{
+					AddRate(bins, binWidth, time, horizon, active.Dps());
+					activeTime = horizon;
+					break;
+				}
+			}
+
+			sp = 0;
+		}
+	}
+
+	double total = 0.0;
+	result.dps.resize(bins.size());
+	for (size_t b = 0; b < bins.size(); ++b)
+	{
+		double width = std::min(binWidth, horizon - b * binWidth);
+		result.dps[b] = (float)(width > 0.0 ? bins[b] / width : 0.0);
+		total += bins[b];
+	}
+
+	result.averageDps = total / horizon;
+	result.uptime = std::min(1.0, activeTime / horizon);
+	return result;
+}
+
+std::vector<SkillTimeline> SkillTimelineEngine::EvaluateAll(const std::vector<Skill>& skills, const SkillTimelineConfig& config) const
+{
+	std::vector<SkillTimeline> results(skills.size());
+
+	ParallelFor(skills.size(), 32, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t i = begin; i < end; ++i)
+				results[i] = Evaluate(skills[i], config);
+		});
+
+	return results;
+}
@@ -0,0 +1,61 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "GameTables.h"
+#include "Skill.h"
+
+struct SkillTimelineConfig
+{
+	double horizon = 120.0;			// 계산 구간 (초)
+	double binWidth = 1.0;			// DPS 곡선 구간 폭 (초)
+	double hitInterval = 2.0;		// spType 4 (피격) 일 때 피격 간격
+	int targetDef = 0;				// 기준 적
+	double targetResistance = 0.0;
+};
+
+// 블랙보드 중 계산에 반영되는 값
+struct SkillModifiers
+{
+	double atk = 0.0;				// "atk": 공격력 +비율
+	double atkScale = 1.0;			// "atk_scale": 1회 피해 배율
+	double attackSpeed = 0.0;		// "attack_speed": 공격 속도 +값
+	double baseAttackTime = 0.0;	// "base_attack_time": 공격 간격 +초
+	int times = 1;					// "times" / "attack@times": 1회 공격당 타수
+	std::vector<std::string> ignoredKeys;
+
+	static SkillModifiers FromBlackboard(const std::vector<BlackboardEntry>& blackboard);
+};
+
+struct SkillTimeline
+{
+	bool hasOwner = false;			// operatorId 가 테이블에 있는지
+	std::vector<float> dps;			// binWidth 구간별 평균 DPS (의료는 HPS)
+	double baseDps = 0.0;
+	double skillDps = 0.0;			// 스킬 지속 중 DPS
+	double averageDps = 0.0;
+	double uptime = 0.0;			// 스킬 지속 시간 비율
+	int activations = 0;
+	double firstActivation = -1.0;
+	std::vector<std::string> ignoredKeys;
+};
+
+// SP 충전(spType 1/2/4), 발동, 지속 구간을 사건 단위로 진행해 DPS 곡선을 계산 (그 밖의 spType 은 충전되지 않음)
+// 스킬 지속 중에는 SP 가 차지 않고, 수동 스킬도 충전되는 즉시 사용한다고 가정
+class SkillTimelineEngine
+{
+public:
+	explicit SkillTimelineEngine(const std::vector<OperatorStats>& operators);
+
+	SkillTimeline Evaluate(const Skill& skill, const SkillTimelineConfig& config = SkillTimelineConfig()) const;
+
+	// 스킬 테이블 전체를 모든 코어에서 계산
+	std::vector<SkillTimeline> EvaluateAll(const std::vector<Skill>& skills, const SkillTimelineConfig& config = SkillTimelineConfig()) const;
+
+	const OperatorStats* FindOperator(const std::string& charId) const;
+
+private:
+	std::vector<OperatorStats> _operators;
+	std::unordered_map<std::string, int> _lookup;
+};
@@ -0,0 +1,246 @@
+﻿#include "SpawnDistribution.h"
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+namespace
+{
+	// 값 기준 정렬 후 같은 값의 확률을 합침
+	void Normalize(std::vector<std::pair<double, double>>& points)
+	{
+		std::sort(points.begin(), points.end());
+
+		size_t out = 0;
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			if (out > 0 && points[out - 1].first == points[i].first)
+				points[out - 1].second += points[i].second;
+			else
+				points[out++] = points[i];
+		}
+		points.resize(out);
+	}
+
+	// 점이 maxSupport 개를 넘으면 [min, max] 를 균등 구간으로 나눠 구간별 가중 평균 하나로 합침
+	void Rebin(DiscreteDistribution& dist, size_t maxSupport)
+	{
+		if (maxSupport == 0 || dist.points.size() <= maxSupport)
+			return;
+
+		double lo = dist.points.front().first;
+		double hi = dist.points.back().first;
+		double width = (hi - lo) / maxSupport;
+
+		std::vector<std::pair<double, double>> bins(maxSupport, { 0.0, 0.0 });
+		for (const auto& [value, prob] : dist.points)
+		{
+			size_t bin = std::min(maxSupport - 1, (size_t)((value - lo) / width));
+			bins[bin].first += value * prob;
+			bins[bin].second += prob;
+		}
+
+		dist.points.clear();
+		for (const auto& [weighted, prob] : bins)
+		{
+			if (prob > 0.0)
+				dist.points.push_back({ weighted / prob, prob });
+		}
+		dist.resolution = std::max(dist.resolution, width);
+	}
+
+	// 그룹 옵션 하나가 기여하는 양
+	struct OptionContribution
+	{
+		int count = 0;
+		int hp = 0;
+		double probability = 0.0;
+
+		bool operator<(const OptionContribution& other) const
+		{
+			return std::tie(count, hp, probability) < std::tie(other.count, other.hp, other.probability);
+		}
+	};
+}
+
+double DiscreteDistribution::Mean() const
+{
+	double mean = 0.0;
+	for (const auto& [value, prob] : points)
+		mean += value * prob;
+	return mean;
+}
+
+double DiscreteDistribution::Min() const
+{
+	return points.empty() ? 0.0 : points.front().first;
+}
+
+double DiscreteDistribution::Max() const
+{
+	return points.empty() ? 0.0 : points.back().first;
+}
+
+double DiscreteDistribution::Quantile(double p) const
+{
+	double acc = 0.0;
+	for (const auto& [value, prob] : points)
+	{
+		acc += prob;
+		if (acc >= p - 1e-12)
+			return value;
+	}
+	return Max();
+}
+
+DiscreteDistribution DiscreteDistribution::Constant(double value)
+{
+	DiscreteDistribution dist;
+	dist.points.push_back({ value, 1.0 });
+	return dist;
+}
+
+SpawnDistributionEngine::SpawnDistributionEngine(const std::vector<EnemyStats>& enemies)
+{
+	for (const auto& enemy : enemies)
+		_enemyHp[enemy.key] = enemy.maxHp;
+}
+
+DiscreteDistribution SpawnDistributionEngine::Convolve(const DiscreteDistribution& a, const DiscreteDistribution& b, size_t maxSupport)
+{
+	DiscreteDistribution result;
+	result.resolution = a.resolution + b.resolution;
+	result.points.reserve(a.points.size() * b.points.size());
+
+	for (const auto& [va, pa] : a.points)
+	{
+		for (const auto& [vb, pb] : b.points)
+			result.points.push_back({ va + vb, pa * pb });
+	}
+
+	Normalize(result.points);
+	Rebin(result, maxSupport);
+	return result;
+}
+
+DiscreteDistribution SpawnDistributionEngine::Power(const DiscreteDistribution& base, int exponent, size_t maxSupport)
+{
+	DiscreteDistribution result = DiscreteDistribution::Constant(0.0);
+	DiscreteDistribution square = base;
+
+	while (exponent > 0)
+	{
+		if (exponent & 1)
+			result = Convolve(result, square, maxSupport);
+
+		exponent >>= 1;
+		if (exponent > 0)
+			square = Convolve(square, square, maxSupport);
+	}
+	return result;
+}
+
+LevelSpawnDistribution SpawnDistributionEngine::Compute(const LevelGrid& level) const
+{
+	LevelSpawnDistribution out;
+	out.groupCount = (int)level.randomGroups.size();
+
+	const size_t routeCount = level.routes.size();
+	out.expectedRouteLoad.assign(routeCount, 0.0);
+	out.maxRouteLoad.assign(routeCount, 0);
+
+	auto hpOf = [&](const std::string& key)
+		{
+			auto it = _enemyHp.find(key);
+			return (it != _enemyHp.end()) ? it->second : 0;
+		};
+
+	// 그룹 옵션별 기여량 (count, hp, 경로별 수)
+	std::vector<std::vector<OptionContribution>> options(level.randomGroups.size());
+	std::vector<std::vector<std::vector<int>>> optionRoutes(level.randomGroups.size());
+	for (size_t g = 0; g < level.randomGroups.size(); ++g)
+	{
+		const auto& group = level.randomGroups[g];
+		options[g].resize(group.weights.size());
+		optionRoutes[g].assign(group.weights.size(), std::vector<int>(routeCount, 0));
+
+		for (int o = 0; o < (int)group.weights.size(); ++o)
+			options[g][o].probability = group.Probability(o);
+	}
+
+	int fixedCount = 0;
+	int fixedHp = 0;
+	std::vector<int> fixedRoutes(routeCount, 0);
+
+	for (const auto& spawn : level.spawns)
+	{
+		bool routeOk = spawn.routeIndex >= 0 && spawn.routeIndex < (int)routeCount;
+
+		if (spawn.randomGroup < 0)
+		{
+			++fixedCount;
+			fixedHp += hpOf(spawn.enemyKey);
+			if (routeOk)
+				++fixedRoutes[spawn.routeIndex];
+			continue;
+		}
+
+		OptionContribution& option = options[spawn.randomGroup][spawn.randomOption];
+		++option.count;
+		option.hp += hpOf(spawn.enemyKey);
+		if (routeOk)
+			++optionRoutes[spawn.randomGroup][spawn.randomOption][spawn.routeIndex];
+	}
+
+	// 경로 부하는 기대값/최대값만 필요하므로 그룹별로 선형 누적
+	for (size_t r = 0; r < routeCount; ++r)
+	{
+		out.expectedRouteLoad[r] = fixedRoutes[r];
+		out.maxRouteLoad[r] = fixedRoutes[r];
+	}
+
+	for (size_t g = 0; g < options.size(); ++g)
+	{
+		for (size_t r = 0; r < routeCount; ++r)
+		{
+			int best = 0;
+			for (size_t o = 0; o < options[g].size(); ++o)
+			{
+				out.expectedRouteLoad[r] += options[g][o].probability * optionRoutes[g][o][r];
+				best = std::max(best, optionRoutes[g][o][r]);
+			}
+			out.maxRouteLoad[r] += best;
+		}
+	}
+
+	// 같은 모양(옵션 기여량 집합)의 그룹은 묶어서 거듭제곱으로 처리
+	std::map<std::vector<OptionContribution>, int> shapes;
+	for (auto& groupOptions : options)
+	{
+		std::sort(groupOptions.begin(), groupOptions.end());
+		++shapes[groupOptions];
+	}
+	out.uniqueGroupShapes = (int)shapes.size();
+
+	DiscreteDistribution count = DiscreteDistribution::Constant(fixedCount);
+	DiscreteDistribution hp = DiscreteDistribution::Constant(fixedHp);
+
+	for (const auto& [shape, multiplicity] : shapes)
+	{
+		DiscreteDistribution shapeCount, shapeHp;
+		for (const auto& option : shape)
+		{
+			shapeCount.points.push_back({ (double)option.count, option.probability });
+			shapeHp.points.push_back({ (double)option.hp, option.probability });
+		}
+		Normalize(shapeCount.points);
+		Normalize(shapeHp.points);
+
+		count = Convolve(count, Power(shapeCount, multiplicity, _maxSupport), _maxSupport);
+		hp = Convolve(hp, Power(shapeHp, multiplicity, _maxSupport), _maxSupport);
+	}
+
+	out.enemyCount = std::move(count);
+	out.hpPool = std::move(hp);
+	out.exact = out.enemyCount.resolution == 0.0 && out.hpPool.resolution == 0.0;
+	return out;
+}
@@ -0,0 +1,54 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+
+#include "GameTables.h"
+#include "LevelGrid.h"
+
+// 값 -> 확률 의 이산 분포 (값 오름차순)
+struct DiscreteDistribution
+{
+	std::vector<std::pair<double, double>> points;	// (value, probability)
+	double resolution = 0.0;						// 재구간화로 합쳐진 최대 폭 (0 = 정확)
+
+	double Mean() const;
+	double Min() const;
+	double Max() const;
+	double Quantile(double p) const;
+
+	static DiscreteDistribution Constant(double value);
+};
+
+struct LevelSpawnDistribution
+{
+	DiscreteDistribution enemyCount;		// 스폰되는 적 수
+	DiscreteDistribution hpPool;			// 스폰되는 적 maxHp 합
+	std::vector<double> expectedRouteLoad;	// 경로별 기대 스폰 수
+	std::vector<int> maxRouteLoad;			// 경로별 최대 스폰 수
+	int groupCount = 0;
+	int uniqueGroupShapes = 0;				// 메모이제이션 후 실제로 계산한 그룹 분포 수
+	bool exact = true;
+};
+
+// 랜덤 스폰 그룹의 조합 폭발 없이 레벨 전체 스폰 분포를 계산
+// 그룹은 서로 독립이므로 그룹별 옵션 분포를 합성곱으로 누적하고,
+// 같은 모양의 그룹은 한 번만 계산해 거듭제곱(이진 분할)으로 합침
+class SpawnDistributionEngine
+{
+public:
+	explicit SpawnDistributionEngine(const std::vector<EnemyStats>& enemies);
+
+	// 분포의 점 개수가 이 값을 넘으면 인접한 점을 합쳐 근사 (resolution 에 오차 폭 기록)
+	void SetMaxSupport(size_t maxSupport) { _maxSupport = maxSupport; }
+
+	LevelSpawnDistribution Compute(const LevelGrid& level) const;
+
+	static DiscreteDistribution Convolve(const DiscreteDistribution& a, const DiscreteDistribution& b, size_t maxSupport);
+	static DiscreteDistribution Power(const DiscreteDistribution& base, int exponent, size_t maxSupport);
+
+private:
+	std::unordered_map<std::string, int> _enemyHp;
+	size_t _maxSupport = 1024;
+};
@@ -0,0 +1,199 @@
+﻿#include "StatsDashboardWindow.h"
+#include "EnemyEditor.h"
+#include "OperatorEditor.h"
+#include "SkillEditor.h"
+#include "LevelEditor.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <imgui/imgui.h>
+
+#include "Utility.h"
+
+std::vector<StatsDashboardWindow::StatRow> StatsDashboardWindow::MakeRows(const RecordStatTable& table)
+{
+	std::vector<StatRow> rows(table.ColumnCount());
+	for (int c = 0; c < table.ColumnCount(); ++c)
+		rows[c] = { table.ColumnName(c), &table.Column(c) };
+	return rows;
+}
+
+void StatsDashboardWindow::SyncLevels(LevelEditor& levelEditor)
+{
+	const int count = levelEditor.GetLevelCount();
+	_levelData.resize(count);
+	_levelRevisions.resize(count);
+	for (int i = 0; i < count; ++i)
+	{
+		_levelData[i] = &levelEditor.GetLevelData(i);
+		_levelRevisions[i] = levelEditor.GetLevelRevision(i);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	int summarized = _levels.Sync(_levelData, _levelRevisions);
+	if (summarized > 0)
+	{
+		_lastSyncMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		_lastLevelsSummarized = summarized;
+	}
+}
+
+void StatsDashboardWindow::RenderGUI(bool* p_open, EnemyEditor& enemyEditor, OperatorEditor& operatorEditor, SkillEditor& skillEditor, LevelEditor& levelEditor)
+{
+	SyncLevels(levelEditor);
+
+	const RecordStatTable& enemyStats = enemyEditor.GetStats();
+	const RecordStatTable& operatorStats = operatorEditor.GetStats();
+	const RecordStatTable& skillStats = skillEditor.GetStats();
+
+	ImGui::SetNextWindowSize(ImVec2(820, 560), ImGuiCond_FirstUseEver);
+	ImGui::Begin("통계 대시보드", p_open);
+
+	ImGui::Text("적 %d / 오퍼레이터 %d / 스킬 %d / 레벨 %d | 총 스폰 %.0f, 웨이브 %zu개",
+		enemyStats.RecordCount(), operatorStats.RecordCount(), skillStats.RecordCount(), _levels.LevelCount(),
+		_levels.Spawns().Sum(), _levels.WaveDurations().Count());
+	ImGui::SameLine();
+	ImGui::TextColored(COLOR_GRAY, "| 마지막 레벨 요약 %.2f ms (레벨 %d개)", _lastSyncMs, _lastLevelsSummarized);
+
+	ImGui::SetNextItemWidth(150);
+	ImGui::SliderInt("히스토그램 칸 수", &_bins, 5, 100);
+
+	if (ImGui::BeginTabBar("StatsTabs"))
+	{
+		if (ImGui::BeginTabItem("적"))
+		{
+			RenderStatTable("EnemyStats", MakeRows(enemyStats), _selected[0]);
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("오퍼레이터"))
+		{
+			RenderStatTable("OperatorStats", MakeRows(operatorStats), _selected[1]);
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("스킬"))
+		{
+			RenderStatTable("SkillStats", MakeRows(skillStats), _selected[2]);
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("레벨"))
+		{
+			std::vector<StatRow> rows = {
+				{ "스폰 수", &_levels.Spawns() },
+				{ "레벨 시간 (초)", &_levels.Durations() },
+				{ "웨이브 수", &_levels.WaveCounts() },
+				{ "웨이브 시간 (초)", &_levels.WaveDurations() },
+			};
+			RenderStatTable("LevelStats", rows, _selected[3]);
+			RenderLevelTable(levelEditor);
+			ImGui::EndTabItem();
+		}
+		ImGui::EndTabBar();
+	}
+
+	ImGui::End();
+}
+
+void StatsDashboardWindow::RenderStatTable(const char* id, const std::vector<StatRow>& rows, int& selected)
+{
+	if (rows.empty())
+		return;
+	selected = std::clamp(selected, 0, (int)rows.size() - 1);
+
+	ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+	if (ImGui::BeginTable(id, 8, flags))
+	{
+		ImGui::TableSetupColumn("항목", ImGuiTableColumnFlags_WidthFixed, 140.0f);
+		ImGui::TableSetupColumn("개수");
+		ImGui::TableSetupColumn("최소");
+		ImGui::TableSetupColumn("평균");
+		ImGui::TableSetupColumn("p50");
+		ImGui::TableSetupColumn("p90");
+		ImGui::TableSetupColumn("p99");
+		ImGui::TableSetupColumn("최대");
+		ImGui::TableHeadersRow();
+
+		for (int r = 0; r < (int)rows.size(); ++r)
+		{
+			const StatDistribution& d = *rows[r].distribution;
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			if (ImGui::Selectable(rows[r].name.c_str(), selected == r, ImGuiSelectableFlags_SpanAllColumns))
+				selected = r;
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", d.Count());
+
+			if (d.Count() == 0)
+			{
+				for (int c = 0; c < 6; ++c)
+				{
+					ImGui::TableNextColumn();
+					ImGui::TextColored(COLOR_GRAY, "-");
+				}
+				continue;
+			}
+
+			const double values[6] = { d.Min(), d.Mean(), d.Percentile(0.5), d.Percentile(0.9), d.Percentile(0.99), d.Max() };
+			for (double value : values)
+			{
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", value);
+			}
+		}
+		ImGui::EndTable();
+	}
+
+	// 선택한 항목의 분포 (칸 수나 값이 바뀔 때만 다시 셈)
+	const StatRow& row = rows[selected];
+	const StatDistribution& d = *row.distribution;
+	if (d.Count() == 0)
+	{
+		ImGui::TextColored(COLOR_GRAY, "%s: 값 없음", row.name.c_str());
+		return;
+	}
+
+	const std::vector<float>& histogram = d.Histogram(_bins);
+	char overlay[128];
+	snprintf(overlay, sizeof(overlay), "%s  [%.2f ~ %.2f]", row.name.c_str(), d.Min(), d.Max());
+	ImGui::PlotHistogram("##Histogram", histogram.data(), (int)histogram.size(), 0, overlay, 0.0f, FLT_MAX, ImVec2(-1, 140));
+}
+
+void StatsDashboardWindow::RenderLevelTable(LevelEditor& levelEditor)
+{
+	ImGui::SeparatorText("레벨별");
+
+	ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+	if (ImGui::BeginTable("LevelSummaryTable", 5, flags))
+	{
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("레벨");
+		ImGui::TableSetupColumn("스폰", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+		ImGui::TableSetupColumn("행동", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+		ImGui::TableSetupColumn("웨이브", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+		ImGui::TableSetupColumn("시간 (초)", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+		ImGui::TableHeadersRow();
+
+		ImGuiListClipper clipper;
+		clipper.Begin(_levels.LevelCount());
+		while (clipper.Step())
+		{
+			for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+			{
+				const LevelSummary& summary = _levels.Summary(i);
+
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", levelEditor.GetLevelId(i).c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%d", summary.spawns);
+				ImGui::TableNextColumn();
+				ImGui::Text("%d", summary.actions);
+				ImGui::TableNextColumn();
+				ImGui::Text("%zu", summary.waveDurations.size());
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", summary.duration);
+			}
+		}
+		ImGui::EndTable();
+	}
+}
@@ -0,0 +1,43 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ProjectStats.h"
+
+class EnemyEditor;
+class OperatorEditor;
+class SkillEditor;
+class LevelEditor;
+
+// 프로젝트 전체 통계 대시보드
+// 적/오퍼레이터/스킬 분포는 각 편집기가 수정 시점에 갱신한 것을 읽기만 하고,
+// 레벨 요약은 매 프레임 레벨 revision 만 비교해 바뀐 레벨만 다시 요약
+class StatsDashboardWindow
+{
+public:
+	void RenderGUI(bool* p_open, EnemyEditor& enemyEditor, OperatorEditor& operatorEditor, SkillEditor& skillEditor, LevelEditor& levelEditor);
+
+private:
+	struct StatRow
+	{
+		std::string name;
+		const StatDistribution* distribution = nullptr;
+	};
+
+	LevelStatTable _levels;
+	std::vector<const json*> _levelData;	// Sync 입력 (매 프레임 재할당하지 않도록 보관)
+	std::vector<uint64_t> _levelRevisions;
+
+	int _bins = 30;
+	int _selected[4] = {};			// 탭별 히스토그램으로 볼 행
+
+	// 마지막으로 레벨 요약이 실제로 돌았을 때의 통계
+	double _lastSyncMs = 0.0;
+	int _lastLevelsSummarized = 0;
+
+	static std::vector<StatRow> MakeRows(const RecordStatTable& table);
+	void SyncLevels(LevelEditor& levelEditor);
+	void RenderStatTable(const char* id, const std::vector<StatRow>& rows, int& selected);
+	void RenderLevelTable(LevelEditor& levelEditor);
+};
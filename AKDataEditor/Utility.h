@@ -1,5 +1,9 @@
 ﻿#pragma once
 #include <imgui/imgui.h>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 #define VERSION "2.2"
 
@@ -28,4 +32,49 @@ inline double Snap2(double v) {
 inline double Snap1(double v) {
     long long x = llround(v * 10.0);
     return x / 10.0;
-}
\ No newline at end of file
+}
+
+// 편집기 데이터가 바뀔 때마다 새 값을 받아 감 (편집기 인스턴스가 바뀌어도 겹치지 않음, 병렬 로드에서도 안전)
+inline uint64_t NextDataRevision() {
+    static std::atomic<uint64_t> revision{ 0 };
+    return ++revision;
+}
+
+// 레코드 하나만 바꾼 revision 기록 (분석 창이 바뀐 행/열만 다시 계산할 때 사용)
+// 이전 revision 이 마지막 기록과 이어지지 않으면 (삽입/삭제/전체 변경 등) 기록을 새로 시작
+class RecordChangeLog
+{
+public:
+    void Add(uint64_t fromRevision, uint64_t revision, int index) {
+        if (_changes.empty() ? fromRevision != _base : fromRevision != _changes.back().first) {
+            _base = fromRevision;
+            _changes.clear();
+        }
+        if (_changes.size() >= MAX_CHANGES) {
+            _base = _changes.front().first;
+            _changes.erase(_changes.begin());
+        }
+        _changes.emplace_back(revision, index);
+    }
+
+    // seenRevision 이후 currentRevision 까지 바뀐 레코드 인덱스 (중복 가능)
+    // 그 사이에 기록되지 않은 변경이 있으면 false (전체 다시 계산)
+    bool ChangedSince(uint64_t seenRevision, uint64_t currentRevision, std::vector<int>& indices) const {
+        uint64_t last = _changes.empty() ? _base : _changes.back().first;
+        if (seenRevision < _base || currentRevision != last)
+            return false;
+
+        indices.clear();
+        for (const auto& change : _changes) {
+            if (change.first > seenRevision)
+                indices.push_back(change.second);
+        }
+        return true;
+    }
+
+private:
+    static constexpr size_t MAX_CHANGES = 256;
+
+    uint64_t _base = 0;
+    std::vector<std::pair<uint64_t, int>> _changes;     // (revision, 레코드 인덱스)
+};
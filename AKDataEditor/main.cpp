@@ -19,13 +19,37 @@
 #include "OperatorEditor.h"
 #include "LevelEditor.h"
 #include "SkillEditor.h"
+#include "DamageMatrixWindow.h"
+#include "BalanceOutlierWindow.h"
+#include "BulkEditWindow.h"
+#include "IntegrityWindow.h"
+#include "QueryWindow.h"
+#include "StatsDashboardWindow.h"
+#include "MigrationDryRunWindow.h"
+#include "EditHistory.h"
+#include "EditJournal.h"
 #include "Utility.h"
 
 #include "Migration.h"
+#include "RangeTable.h"
 
 static char solutionPath[512] = "";
 static bool pathInitialized = false;
 static bool showUnsavedWarning = false;
+static bool showDamageMatrix = false;
+static bool showBalanceOutliers = false;
+static bool showBulkEdit = false;
+static bool showIntegrity = false;
+static bool showQuery = false;
+static bool showStatsDashboard = false;
+static bool showMigrationDryRun = false;
+static bool showJournalRecovery = false;
+static RangeTableRebuildReport rangeRebuildReport;
+
+// 모든 편집기가 공유하는 되돌리기 기록 / 저장 전 편집 저널
+static EditHistory editHistory;
+static EditJournal editJournal;
+static JournalReplayReport journalReplayReport;
 
 // Forward declarations of helper functions
 LRESULT WINAPI WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
@@ -56,6 +80,27 @@ std::string BrowseForFolder()
     return "";
 }
 
+// 솔루션의 저널을 열고 이전 세션에서 남은 편집이 있으면 복구 여부를 물음
+void OpenEditJournal()
+{
+    if (strlen(solutionPath) == 0)
+        return;
+
+    editJournal.Open(EditJournal::PathFor(solutionPath));
+    editHistory.SetJournal(&editJournal);
+    journalReplayReport = JournalReplayReport();
+    showJournalRecovery = editJournal.RecoverableCount() > 0;
+}
+
+// 편집기에 되돌리기 기록 연결
+void AttachEditHistory(EnemyEditor* enemyEditor, OperatorEditor* operatorEditor, SkillEditor* skillEditor, LevelEditor* levelEditor)
+{
+    enemyEditor->SetEditHistory(&editHistory);
+    operatorEditor->SetEditHistory(&editHistory);
+    skillEditor->SetEditHistory(&editHistory);
+    levelEditor->SetEditHistory(&editHistory);
+}
+
 // 경로 변경 함수
 void ChangeSolutionPath(const std::string& newPath, EnemyEditor*& enemyEditor, OperatorEditor*& operatorEditor, SkillEditor*& skillEditor, LevelEditor*& levelEditor)
 {
@@ -76,6 +121,11 @@ void ChangeSolutionPath(const std::string& newPath, EnemyEditor*& enemyEditor, O
     skillEditor = new SkillEditor(skillPath, operatorPath);
     levelEditor = new LevelEditor(levelPath, std::string(solutionPath));
 
+    // 이전 편집기를 가리키는 기록은 버림
+    editHistory.Clear();
+    AttachEditHistory(enemyEditor, operatorEditor, skillEditor, levelEditor);
+    OpenEditJournal();
+
     std::cout << "Path set to: " << solutionPath << "\n";
 }
 
@@ -120,6 +170,19 @@ void HandleCtrlS(EnemyEditor* enemyEditor, OperatorEditor* operatorEditor, Skill
     }
 }
 
+// Ctrl+Z / Ctrl+Y (Ctrl+Shift+Z) 단축키 처리 함수 (텍스트 입력 중에는 입력창에 맡김)
+void HandleUndoShortcuts()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    if (!io.KeyCtrl || io.WantTextInput)
+        return;
+
+    if (ImGui::IsKeyPressed(ImGuiKey_Z) && !io.KeyShift)
+        editHistory.Undo();
+    else if (ImGui::IsKeyPressed(ImGuiKey_Y) || (ImGui::IsKeyPressed(ImGuiKey_Z) && io.KeyShift))
+        editHistory.Redo();
+}
+
 // 메인 UI 렌더링 함수
 void RenderMainUI(EnemyEditor*& enemyEditor, OperatorEditor*& operatorEditor, SkillEditor*& skillEditor, LevelEditor*& levelEditor,
     bool& showEnemyEditor, bool& showOperatorEditor, bool& showSkillEditor, bool& showLevelEditor)
@@ -193,6 +256,93 @@ void RenderMainUI(EnemyEditor*& enemyEditor, OperatorEditor*& operatorEditor, Sk
     if (ImGui::Button("레벨 편집기"))
         showLevelEditor = true;
 
+    // === 분석 ===
+    ImGui::SeparatorText("분석");
+
+    if (ImGui::Button("데미지 매트릭스"))
+        showDamageMatrix = true;
+    if (ImGui::Button("밸런스 이상치"))
+        showBalanceOutliers = true;
+    if (ImGui::Button("참조 무결성"))
+        showIntegrity = true;
+    if (ImGui::Button("데이터 질의"))
+        showQuery = true;
+    if (ImGui::Button("통계 대시보드"))
+        showStatsDashboard = true;
+
+    // === 도구 ===
+    ImGui::SeparatorText("도구");
+
+    if (ImGui::Button("일괄 편집"))
+        showBulkEdit = true;
+    if (ImGui::Button("마이그레이션 미리보기"))
+        showMigrationDryRun = true;
+
+    // 실행 취소 / 다시 실행
+    if (!editHistory.CanUndo()) ImGui::BeginDisabled();
+    if (ImGui::Button("실행 취소"))
+        editHistory.Undo();
+    if (!editHistory.CanUndo()) ImGui::EndDisabled();
+    if (editHistory.CanUndo() && ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+        ImGui::SetTooltip("%s", editHistory.UndoLabel().c_str());
+
+    ImGui::SameLine();
+
+    if (!editHistory.CanRedo()) ImGui::BeginDisabled();
+    if (ImGui::Button("다시 실행"))
+        editHistory.Redo();
+    if (!editHistory.CanRedo()) ImGui::EndDisabled();
+    if (editHistory.CanRedo() && ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+        ImGui::SetTooltip("%s", editHistory.RedoLabel().c_str());
+
+    ImGui::SameLine();
+    ImGui::TextColored(COLOR_GRAY, "%d단계 (%.1f KB)", (int)editHistory.UndoCount(), editHistory.ByteSize() / 1024.0);
+
+    if (journalReplayReport.entries > 0)
+        ImGui::TextColored(COLOR_GREEN, "복구: 편집 %d개 적용 (저널 %d개, 건너뜀 %d개, %.1f ms)",
+            journalReplayReport.applied, journalReplayReport.entries, journalReplayReport.skipped, journalReplayReport.ms);
+
+    // 저널을 쓴 뒤 디스크에서 바뀐 파일의 편집은 적용하지 않았음을 알림
+    if (journalReplayReport.stale > 0)
+    {
+        ImGui::TextColored(COLOR_YELLOW, "파일이 바뀌어 복구하지 않은 편집 %d개 (파일 %d개)",
+            journalReplayReport.stale, (int)journalReplayReport.staleFiles.size());
+        if (ImGui::IsItemHovered())
+        {
+            std::string files;
+            for (const std::string& file : journalReplayReport.staleFiles)
+                files += file + "\n";
+            ImGui::SetTooltip("%s", files.c_str());
+        }
+    }
+
+    // 재구성은 파일을 직접 다시 쓰므로 편집 중인 오퍼레이터/스킬이 있으면 막음
+    bool rangeEditing = operatorEditor->HasUnsavedChanges() || skillEditor->HasUnsavedChanges();
+    if (rangeEditing) ImGui::BeginDisabled();
+
+    if (ImGui::Button("범위 테이블 재구성"))
+    {
+        rangeRebuildReport = RebuildRangeTable(std::string(solutionPath) + "/gamedata/tables");
+        if (rangeRebuildReport.ok)
+        {
+            operatorEditor->LoadOperators();
+            skillEditor->LoadSkills();
+        }
+    }
+
+    if (rangeEditing) ImGui::EndDisabled();
+
+    if (rangeEditing)
+    {
+        ImGui::SameLine();
+        ImGui::TextColored(COLOR_YELLOW, "오퍼레이터/스킬을 먼저 저장하세요");
+    }
+    else if (rangeRebuildReport.ok)
+    {
+        ImGui::Text("범위 %d개 / 참조 %d개 (미사용 %d개 삭제)", rangeRebuildReport.ranges, rangeRebuildReport.references, rangeRebuildReport.removed);
+        ImGui::Text("테이블 크기: %zu -> %zu bytes", rangeRebuildReport.bytesBefore, rangeRebuildReport.bytesAfter);
+    }
+
     if (!hasPath) ImGui::EndDisabled();
 
     ImGui::End();
@@ -234,6 +384,39 @@ void RenderUnsavedWarningPopup(EnemyEditor*& enemyEditor, OperatorEditor*& opera
     }
 }
 
+// 이전 세션 편집 복구 팝업
+void RenderJournalRecoveryPopup(EnemyEditor* enemyEditor, OperatorEditor* operatorEditor, SkillEditor* skillEditor, LevelEditor* levelEditor)
+{
+    if (showJournalRecovery)
+    {
+        ImGui::OpenPopup("저장하지 않은 편집 복구");
+        showJournalRecovery = false;
+    }
+
+    if (ImGui::BeginPopupModal("저장하지 않은 편집 복구", NULL, ImGuiWindowFlags_AlwaysAutoResize))
+    {
+        ImGui::Text("이전 세션에서 저장하지 않은 편집 %d개가 남아 있습니다.", editJournal.RecoverableCount());
+        ImGui::Text("복구하면 디스크의 데이터 위에 다시 적용합니다. (저장은 따로 해야 함)");
+        ImGui::Separator();
+
+        if (ImGui::Button("복구", ImVec2(120, 0)))
+        {
+            journalReplayReport = editHistory.ReplayJournal({ enemyEditor, operatorEditor, skillEditor, levelEditor });
+            ImGui::CloseCurrentPopup();
+        }
+
+        ImGui::SameLine();
+
+        if (ImGui::Button("버리기", ImVec2(120, 0)))
+        {
+            editJournal.Discard();
+            ImGui::CloseCurrentPopup();
+        }
+
+        ImGui::EndPopup();
+    }
+}
+
 // 설정 파일에서 경로 로드
 void LoadConfig()
 {
@@ -321,12 +504,22 @@ int main(int, char**)
     OperatorEditor* operatorEditor = new OperatorEditor(operatorPath);
     SkillEditor* skillEditor = new SkillEditor(skillPath, operatorPath);
     LevelEditor* levelEditor = new LevelEditor(levelPath, std::string(solutionPath));
+    AttachEditHistory(enemyEditor, operatorEditor, skillEditor, levelEditor);
+    OpenEditJournal();
 
     bool showEnemyEditor = false;
     bool showOperatorEditor = false;
     bool showSkillEditor = false;
     bool showLevelEditor = false;
 
+    DamageMatrixWindow damageMatrixWindow;
+    BalanceOutlierWindow balanceOutlierWindow;
+    BulkEditWindow bulkEditWindow;
+    IntegrityWindow integrityWindow;
+    QueryWindow queryWindow;
+    StatsDashboardWindow statsDashboardWindow;
+    MigrationDryRunWindow migrationDryRunWindow;
+
     // Main loop
     MSG msg;
     ZeroMemory(&msg, sizeof(msg));
@@ -347,15 +540,19 @@ int main(int, char**)
         // Ctrl+S 처리
         HandleCtrlS(enemyEditor, operatorEditor, skillEditor, levelEditor);
 
+        // Ctrl+Z / Ctrl+Y 처리
+        HandleUndoShortcuts();
+
         // 메인 UI
         RenderMainUI(enemyEditor, operatorEditor, skillEditor, levelEditor, showEnemyEditor, showOperatorEditor, showSkillEditor, showLevelEditor);
 
         // 경고 팝업
         RenderUnsavedWarningPopup(enemyEditor, operatorEditor, skillEditor, levelEditor);
+        RenderJournalRecoveryPopup(enemyEditor, operatorEditor, skillEditor, levelEditor);
 
         // 에디터 윈도우들
         if (showEnemyEditor)
-            enemyEditor->RenderGUI(&showEnemyEditor);
+            enemyEditor->RenderGUI(&showEnemyEditor, &levelEditor->GetEnemyUsage());
 
         if (showOperatorEditor)
             operatorEditor->RenderGUI(&showOperatorEditor);
@@ -364,7 +561,42 @@ int main(int, char**)
             skillEditor->RenderGUI(&showSkillEditor);
 
         if (showLevelEditor)
-            levelEditor->RenderGUI(&showLevelEditor);
+            levelEditor->RenderGUI(&showLevelEditor, *enemyEditor);
+
+        // 분석 윈도우들
+        if (showDamageMatrix)
+            damageMatrixWindow.RenderGUI(&showDamageMatrix, *enemyEditor, *operatorEditor);
+
+        if (showBalanceOutliers)
+            balanceOutlierWindow.RenderGUI(&showBalanceOutliers, *enemyEditor, *operatorEditor);
+
+        if (showIntegrity)
+            integrityWindow.RenderGUI(&showIntegrity, *enemyEditor, *operatorEditor, *skillEditor, *levelEditor);
+
+        if (showQuery)
+            queryWindow.RenderGUI(&showQuery, *enemyEditor, *operatorEditor, *skillEditor, *levelEditor);
+
+        if (showStatsDashboard)
+            statsDashboardWindow.RenderGUI(&showStatsDashboard, *enemyEditor, *operatorEditor, *skillEditor, *levelEditor);
+
+        // 도구 윈도우들
+        if (showBulkEdit)
+            bulkEditWindow.RenderGUI(&showBulkEdit, *enemyEditor, *operatorEditor, *skillEditor);
+
+        if (showMigrationDryRun)
+            migrationDryRunWindow.RenderGUI(&showMigrationDryRun, solutionPath);
+
+        // 드래그/입력이 끝나면 다음 편집은 새 단계로 기록 (한 번의 드래그는 한 단계로 합침)
+        // 키 입력 중에 미뤄 둔 이상치 그룹 재계산도 이때 함
+        if (!ImGui::IsAnyItemActive() && !ImGui::IsMouseDown(ImGuiMouseButton_Left))
+        {
+            editHistory.Seal();
+            enemyEditor->FlushOutliers();
+            operatorEditor->FlushOutliers();
+        }
+
+        // 모아 둔 저널 편집을 묶어서 씀
+        editJournal.Tick();
 
         // Rendering
         ImGui::Render();
@@ -373,6 +605,7 @@ int main(int, char**)
     }
 
     // Cleanup
+    editJournal.Close();
     delete enemyEditor;
     delete operatorEditor;
 